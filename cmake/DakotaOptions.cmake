@@ -32,6 +32,9 @@ endif()
 
 # Testing options
 option(DAKOTA_ENABLE_TESTS "Enable Dakota-specific tests?" ON)
+# Option to build timing benchmarks for performance-sensitive components,
+# registered with CTest under the Benchmark label (ctest -L Benchmark)
+option(DAKOTA_ENABLE_BENCHMARKS "Build Dakota timing benchmarks?" OFF)
 # Option to turn off key DAKOTA TPL tests, default OFF
 # Needs to go before adding the packages subdirectory
 option(DAKOTA_ENABLE_TPL_TESTS "Enable DAKOTA TPL tests?" OFF)
@@ -35,6 +35,38 @@ function(dakota_add_unit_test)
 
 endfunction()
 
+
+# Add a Dakota timing benchmark, with the same arguments as
+# dakota_add_unit_test.  Benchmarks report timings rather than check
+# them, so are only built when DAKOTA_ENABLE_BENCHMARKS is enabled and
+# are labeled Benchmark (not Unit), running one at a time.
+function(dakota_add_benchmark)
+
+  if(NOT DAKOTA_ENABLE_BENCHMARKS)
+    return()
+  endif()
+
+  set(options LINK_DAKOTA_LIBS)
+  set(oneValueArgs NAME)
+  set(multiValueArgs SOURCES LABELS DEPENDS LINK_LIBS)
+  cmake_parse_arguments(DABM
+    "${options}" "${oneValueArgs}" "${multiValueArgs}" ${ARGN})
+
+  set(exe_target ${DABM_NAME})
+  add_executable(${exe_target} ${DABM_SOURCES})
+  if (${DABM_LINK_DAKOTA_LIBS})
+    target_link_libraries(${exe_target}
+      ${Dakota_LIBRARIES} ${Dakota_TPL_LIBRARIES})
+  endif()
+  if (DABM_LINK_LIBS)
+    target_link_libraries(${exe_target} ${DABM_LINK_LIBS})
+  endif()
+  add_test(${DABM_NAME} ${exe_target})
+  set_tests_properties(${DABM_NAME} PROPERTIES
+    LABELS "Benchmark;${DABM_LABELS}" RUN_SERIAL TRUE)
+
+endfunction()
+
   
 
 # Add file to list of unit test dependency files for addition to
@@ -0,0 +1,168 @@
+# -*- coding: utf-8 -*-
+"""Reader and writer for Dakota's binary parameters and results files.
+
+The system and fork interfaces exchange binary files in place of the text
+formats when the ``binary`` interface keyword is given. The layout of the
+records is documented in ``dakota_binary_files.h``; this module is its
+Python counterpart and is used by ``dakota.interfacing`` when it detects a
+binary parameters file.
+"""
+from __future__ import print_function, unicode_literals
+import collections
+import struct
+
+__author__ = 'J. Adam Stephens'
+__copyright__ = 'Copyright 2014-2023 National Technology & Engineering Solutions of Sandia, LLC (NTESS)'
+__license__ = 'GNU Lesser General Public License'
+
+PARAMS_MAGIC = b"DKBP"
+RESULTS_MAGIC = b"DKBR"
+VERSION = 1
+FAILED = 1
+
+_HEADER = struct.Struct("<4sII")
+_U64 = struct.Struct("<Q")
+
+
+class BinaryFormatError(Exception):
+    pass
+
+
+class _Reader(object):
+    """Cursor over the bytes of a binary file"""
+
+    def __init__(self, data):
+        self._data = data
+        self.pos = 0
+
+    def at_end(self):
+        return self.pos >= len(self._data)
+
+    def _take(self, n):
+        if self.pos + n > len(self._data):
+            raise BinaryFormatError("Binary parameters record is truncated.")
+        chunk = self._data[self.pos:self.pos + n]
+        self.pos += n
+        return chunk
+
+    def header(self, magic):
+        sig, version, flags = _HEADER.unpack(self._take(_HEADER.size))
+        if sig != magic:
+            raise BinaryFormatError("Binary signature %r not found." % magic)
+        if version != VERSION:
+            raise BinaryFormatError("Unsupported binary format version %d; "
+                    "expected version %d." % (version, VERSION))
+        return flags
+
+    def u64(self):
+        return _U64.unpack(self._take(8))[0]
+
+    def u64s(self, n):
+        return list(struct.unpack("<%dQ" % n, self._take(8*n)))
+
+    def i64s(self, n):
+        return list(struct.unpack("<%dq" % n, self._take(8*n)))
+
+    def f64s(self, n):
+        return list(struct.unpack("<%dd" % n, self._take(8*n)))
+
+    def u8s(self, n):
+        return list(bytearray(self._take(n)))
+
+    def string(self):
+        return self._take(self.u64()).decode("utf-8")
+
+    def strings(self, n):
+        return [self.string() for i in range(n)]
+
+
+def is_binary_parameters(data):
+    """True if data (bytes) begins with a binary parameters record"""
+    return data[:4] == PARAMS_MAGIC
+
+
+def read_parameters(data):
+    """Parse all parameters records in data (bytes).
+
+    Returns a list with one dict per evaluation, holding the keys
+    'variables' (OrderedDict of descriptor to typed value, ordered
+    continuous, discrete integer, discrete string, discrete real),
+    'responses' (OrderedDict of descriptor to ASV value), 'deriv_vars'
+    (list of derivative variable descriptors), 'an_comps', 'eval_id' and
+    'metadata' (list of metadata labels)."""
+    reader = _Reader(data)
+    records = []
+    while not reader.at_end():
+        reader.header(PARAMS_MAGIC)
+        num_cv, num_div, num_dsv, num_drv = reader.u64s(4)
+        labels = reader.strings(num_cv + num_div + num_dsv + num_drv)
+        values = reader.f64s(num_cv) + reader.i64s(num_div) + \
+                reader.strings(num_dsv) + reader.f64s(num_drv)
+        variables = collections.OrderedDict(zip(labels, values))
+        num_fns = reader.u64()
+        fn_labels = reader.strings(num_fns)
+        responses = collections.OrderedDict(zip(fn_labels, reader.u8s(num_fns)))
+        dvv = reader.u64s(reader.u64())
+        deriv_vars = [labels[p-1] if 0 < p <= num_cv else "" for p in dvv]
+        an_comps = reader.strings(reader.u64())
+        eval_id = reader.string()
+        metadata = reader.strings(reader.u64())
+        records.append({"variables": variables, "responses": responses,
+            "deriv_vars": deriv_vars, "an_comps": an_comps,
+            "eval_id": eval_id, "metadata": metadata})
+    return records
+
+
+def pack_results(responses, num_deriv_vars, metadata):
+    """Pack one results record.
+
+    responses is a sequence of (function, gradient, hessian) tuples with
+    None for data not provided; metadata is a sequence of floats."""
+    contents = bytearray()
+    values, gradients, hessians = [], [], []
+    for function, gradient, hessian in responses:
+        bits = 0
+        if function is not None:
+            bits |= 1
+            values.append(float(function))
+        if gradient is not None:
+            bits |= 2
+            gradients.extend(float(g) for g in gradient)
+        if hessian is not None:
+            bits |= 4
+            for row in hessian:
+                hessians.extend(float(h) for h in row)
+        contents.append(bits)
+    reals = values + gradients + hessians + [float(m) for m in metadata]
+    return b"".join([_HEADER.pack(RESULTS_MAGIC, VERSION, 0),
+        struct.pack("<3Q", len(contents), num_deriv_vars, len(metadata)),
+        bytes(contents), struct.pack("<%dd" % len(reals), *reals)])
+
+
+def pack_failure():
+    """Pack a results record reporting a failed evaluation"""
+    return _HEADER.pack(RESULTS_MAGIC, VERSION, FAILED)
+
+
+def read_results(data):
+    """Parse all results records in data (bytes), for testing and
+    post-processing. Returns a list of dicts with keys 'failed',
+    'functions', 'gradients', 'hessians' (lists indexed by response, with
+    None where absent) and 'metadata'."""
+    reader = _Reader(data)
+    records = []
+    while not reader.at_end():
+        flags = reader.header(RESULTS_MAGIC)
+        if flags & FAILED:
+            records.append({"failed": True})
+            continue
+        nf, nd, nm = reader.u64s(3)
+        contents = reader.u8s(nf)
+        functions = [reader.f64s(1)[0] if c & 1 else None for c in contents]
+        gradients = [reader.f64s(nd) if c & 2 else None for c in contents]
+        hessians = [[reader.f64s(nd) for r in range(nd)] if c & 4 else None
+                    for c in contents]
+        records.append({"failed": False, "functions": functions,
+            "gradients": gradients, "hessians": hessians,
+            "metadata": reader.f64s(nm)})
+    return records
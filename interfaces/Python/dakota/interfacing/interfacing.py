@@ -9,6 +9,7 @@ import re
 import sys
 import copy
 from . import dprepro as dprepro_mod
+from . import binary_files
 
 __author__ = 'J. Adam Stephens'
 __copyright__ = 'Copyright 2014-2023 National Technology & Engineering Solutions of Sandia, LLC (NTESS)'
@@ -362,12 +363,16 @@ class Results(object):
         num_deriv_vars: Number of derivative variables (read-only)
         ignore_asv: If True, response set will be validated against ASV before writing
         results_file: Name of results file that will be written
+        binary_format: Boolean indicating whether the results file will be
+            written in Dakota's binary format (True when the parameters file
+            was binary).
     """
 
     def __init__(self, aprepro_format=None, responses=None, 
             deriv_vars=None, eval_id=None, metadata=None,
-            ignore_asv=False, results_file=None):
+            ignore_asv=False, results_file=None, binary_format=False):
         self.aprepro_format = aprepro_format
+        self.binary_format = binary_format
         self.ignore_asv = ignore_asv
         self._deriv_vars = deriv_vars[:]
         num_deriv_vars = len(deriv_vars)
@@ -393,6 +398,7 @@ class Results(object):
     def format_matches(self, other):
         matches = True
         matches = matches and (self.aprepro_format == other.aprepro_format)
+        matches = matches and (self.binary_format == other.binary_format)
         matches = matches and (self.ignore_asv == other.ignore_asv)
         matches = matches and all(s == o for s, o in 
                                   zip_longest(self._deriv_vars, other._deriv_vars))
@@ -452,6 +458,18 @@ class Results(object):
         for k, v in self.metadata.items():
             print("%24.16E %s" %(v, k), file=stream)
 
+    def _write_binary_results(self, stream, ignore_asv):
+        if self._failed:
+            stream.write(binary_files.pack_failure())
+            return
+        def active(requested, value):
+            return value if (requested or ignore_asv) else None
+        responses = [(active(v.asv.function, v.function),
+                      active(v.asv.gradient, v.gradient),
+                      active(v.asv.hessian, v.hessian))
+                     for v in self._responses.values()]
+        stream.write(binary_files.pack_results(responses, self.num_deriv_vars,
+                                               list(self.metadata.values())))
 
     def write(self, stream=None, ignore_asv=None):
         """Write the results to the Dakota results file.
@@ -502,9 +520,14 @@ class Results(object):
             if self.results_file is None:
                 raise MissingSourceError("No stream specified and no "
                         "results_file provided at construct time.")
+            elif self.binary_format:
+                with open(self.results_file, "wb") as ofp:
+                    self._write_binary_results(ofp, my_ignore_asv)
             else:
                 with open(self.results_file, "w", encoding='utf8') as ofp:
                     self._write_results(ofp, my_ignore_asv)
+        elif self.binary_format:
+            self._write_binary_results(stream, my_ignore_asv)
         else:
             self._write_results(stream, my_ignore_asv)
 
@@ -671,6 +694,7 @@ class BatchResults(object):
                               "file does not appear to be a batch file.")
         self._ignore_asv = self._eval_results[0].ignore_asv
         self._results_file = self._eval_results[0].results_file
+        self._binary_format = self._eval_results[0].binary_format
         for r in self._eval_results:
             r._set_batch(True)
 
@@ -698,6 +722,11 @@ class BatchResults(object):
             if self._results_file is None:
                 raise MissingSourceError("No stream specified and no "
                         "results_file provided at construct time.")
+            elif self._binary_format:
+                # binary records are self-delimiting; no separators
+                with open(self._results_file, "wb") as ofp:
+                    for r in self._eval_results:
+                        self._toggle_batch_write(r, ofp, my_ignore_asv)
             else:
                 with open(self._results_file, "w", encoding='utf8') as ofp:
                     for r in self._eval_results:
@@ -705,7 +734,8 @@ class BatchResults(object):
                         self._toggle_batch_write(r, ofp, my_ignore_asv)
         else:
             for r in self._eval_results:
-                stream.write("#\n")
+                if not self._binary_format:
+                    stream.write("#\n")
                 self._toggle_batch_write(r, stream, my_ignore_asv)
 
     def __len__(self):
@@ -909,6 +939,31 @@ def _read_parameters_stream(stream=None, ignore_asv=False, batch=False,
         return param_sets[0], results_sets[0]
 
 
+def _read_binary_parameters(data, ignore_asv=False, batch=False,
+    results_file=None, types=None):
+    """Extract all evaluations from a binary parameters file"""
+    param_sets = []
+    results_sets = []
+    try:
+        records = binary_files.read_parameters(data)
+    except binary_files.BinaryFormatError as e:
+        raise ParamsFormatError(str(e))
+    for rec in records:
+        # values are already typed by the binary format
+        param_sets.append(Parameters(False, rec["variables"], rec["an_comps"],
+            rec["eval_id"], rec["metadata"], False, types))
+        results_sets.append(Results(False, rec["responses"], rec["deriv_vars"],
+            rec["eval_id"], rec["metadata"], ignore_asv, results_file,
+            binary_format=True))
+    if batch:
+        return BatchParameters(param_sets), BatchResults(results_sets)
+    elif len(param_sets) > 1:
+        raise BatchSettingError("batch is False, but parameters for " +
+                     "multiple evaluations found in parameters file.")
+    else:
+        return param_sets[0], results_sets[0]
+
+
 def read_params_from_dict(parameters=None, results_file=None, 
         ignore_asv=False, batch=False, infer_types=True, types=None):
     """Process parameters and results using Dakota parameters disctionary from python interface driver.
@@ -1024,7 +1079,13 @@ def read_parameters_file(parameters_file=None, results_file=None,
     elif results_file == UNNAMED:
         results_file = ""
 
-    ### Open and parse the parameters file
+    ### Open and parse the parameters file; binary files are detected by
+    ### their signature and answered with a binary results file
+    with open(parameters_file, "rb") as ifp:
+        data = ifp.read()
+    if binary_files.is_binary_parameters(data):
+        return _read_binary_parameters(data, ignore_asv, batch, results_file,
+                                       types)
     with open(parameters_file, "r", encoding='utf8') as ifp:
         return _read_parameters_stream(ifp, ignore_asv, batch, results_file, infer_types, types)
 
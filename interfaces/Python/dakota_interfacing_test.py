@@ -758,6 +758,99 @@ class TestDeepCopy(unittest.TestCase):
         self.assertFalse(cr[0] is r[0])
         self.assertTrue(cr[0].format_matches(r[0]))
 
+class TestBinaryFormat(unittest.TestCase):
+    """Binary parameters and results files (interface keyword 'binary')"""
+
+    @staticmethod
+    def _pack_params(eval_id, asv=7):
+        """Pack a parameters record as Dakota writes it"""
+        import struct
+        def string(s):
+            b = s.encode("utf-8")
+            return struct.pack("<Q", len(b)) + b
+        def strings(l):
+            return b"".join(string(s) for s in l)
+        rec = [struct.pack("<4sII", b"DKBP", 1, 0),
+               struct.pack("<4Q", 2, 1, 1, 0),
+               strings(["x1", "x2", "n", "s"]),
+               struct.pack("<2d", 0.25, -1.5e-300),
+               struct.pack("<q", -3),
+               string("foo bar"),
+               struct.pack("<Q", 2), strings(["obj", "con"]),
+               struct.pack("<2B", asv, 1),
+               struct.pack("<Q", 2), struct.pack("<2Q", 1, 2),
+               struct.pack("<Q", 1), strings(["a b"]),
+               string(eval_id),
+               struct.pack("<Q", 1), strings(["seconds"])]
+        return b"".join(rec)
+
+    def _read(self, data, batch=False):
+        return di.interfacing._read_binary_parameters(data, batch=batch,
+                results_file="results.out")
+
+    def test_read_params(self):
+        """Typed values, ASV, DVV, analysis components and metadata"""
+        p, r = self._read(self._pack_params("1"))
+        self.assertListEqual(p.descriptors, ["x1", "x2", "n", "s"])
+        self.assertEqual(p["x1"], 0.25)
+        self.assertEqual(p["x2"], -1.5e-300)
+        self.assertEqual(p["n"], -3)
+        self.assertEqual(p["s"], "foo bar")
+        self.assertListEqual(p.an_comps, ["a b"])
+        self.assertEqual(p.eval_num, 1)
+        self.assertListEqual(r.deriv_vars, ["x1", "x2"])
+        self.assertTrue(r["obj"].asv.hessian)
+        self.assertFalse(r["con"].asv.gradient)
+        self.assertTrue(r.binary_format)
+
+    def test_write_results(self):
+        """Results round trip exactly through the binary format"""
+        _, r = self._read(self._pack_params("1"))
+        r["obj"].function = 1.0/3.0
+        r["obj"].gradient = [1.0189673084127668E-266, -2.0]
+        r["obj"].hessian = [[1.0, 2.0], [2.0, 3.0]]
+        r["con"].function = -4.5
+        r.metadata["seconds"] = 42.0
+        bio = StringIO.BytesIO()
+        r.write(stream=bio)
+        rec, = di.binary_files.read_results(bio.getvalue())
+        self.assertFalse(rec["failed"])
+        self.assertListEqual(rec["functions"], [1.0/3.0, -4.5])
+        self.assertListEqual(rec["gradients"],
+                             [[1.0189673084127668E-266, -2.0], None])
+        self.assertListEqual(rec["hessians"], [[[1.0, 2.0], [2.0, 3.0]], None])
+        self.assertListEqual(rec["metadata"], [42.0])
+        r.fail()
+        bio = StringIO.BytesIO()
+        r.write(stream=bio)
+        self.assertEqual(bio.getvalue(), di.binary_files.pack_failure())
+
+    def test_batch(self):
+        """Batch files are concatenated records without separators"""
+        data = self._pack_params("1:1", 1) + self._pack_params("1:2", 1)
+        with self.assertRaises(di.BatchSettingError):
+            self._read(data)
+        p, r = self._read(data, batch=True)
+        self.assertEqual(len(p), 2)
+        self.assertEqual(r.batch_id, "1")
+        for i, ri in enumerate(r):
+            ri["obj"].function = float(i)
+            ri["con"].function = 10.0 + i
+            ri.metadata["seconds"] = 0.5
+        bio = StringIO.BytesIO()
+        r.write(stream=bio)
+        recs = di.binary_files.read_results(bio.getvalue())
+        self.assertListEqual([rec["functions"] for rec in recs],
+                             [[0.0, 10.0], [1.0, 11.0]])
+
+    def test_bad_signature(self):
+        """Corrupt or truncated files are reported as format errors"""
+        data = self._pack_params("1")
+        with self.assertRaises(di.ParamsFormatError):
+            self._read(data[:-3])
+        with self.assertRaises(di.ParamsFormatError):
+            self._read(b"DKBQ" + data[4:])
+
 # todo: test iteration, integer access
 
 
@@ -13,11 +13,22 @@
 #include "ProblemDescDB.hpp"
 #include "ParallelLibrary.hpp"
 
+#include <chrono>
+#include <cmath>
+
 //#define DEBUG
 
 namespace Dakota {
 
+/// wall clock time in seconds, for timing evaluations and schedules
+static Real wall_clock_time()
+{
+  typedef std::chrono::duration<Real> seconds;
+  return seconds(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
 extern PRPCache data_pairs;
+extern PRPShardedCache sharded_data_pairs;
 
 ApplicationInterface::
 ApplicationInterface(const ProblemDescDB& problem_db):
@@ -59,6 +70,7 @@ ApplicationInterface(const ProblemDescDB& problem_db):
   headerFlag(true),
   asvControlFlag(problem_db.get_bool("interface.active_set_vector")),
   evalCacheFlag(problem_db.get_bool("interface.evaluation_cache")),
+  evalCacheType(problem_db.get_short("interface.evaluation_cache_type")),
   nearbyDuplicateDetect(
     problem_db.get_bool("interface.nearby_evaluation_cache")),
   nearbyTolerance(
@@ -75,7 +87,15 @@ ApplicationInterface(const ProblemDescDB& problem_db):
   failRetryLimit(problem_db.get_int("interface.failure_capture.retry_limit")),
   failRecoveryFnVals(
     problem_db.get_rv("interface.failure_capture.recovery_fn_vals")),
-  sendBuffers(NULL), recvBuffers(NULL), recvRequests(NULL)
+  sendBuffers(NULL), recvBuffers(NULL), recvRequests(NULL),
+  evalChunking(problem_db.get_bool("interface.evaluation_chunking")),
+  evalChunkMax(problem_db.get_int("interface.evaluation_chunk_max_size")),
+  chunkEvalTime(0.), chunkSendBuffers(NULL), chunkRecvBuffers(NULL),
+  chunkRecvRequests(NULL), numChunkBuffers(0),
+  costAwareScheduling(problem_db.get_bool("interface.cost_aware_scheduling")),
+  schedStartTime(0.), schedBusyTime(0.), schedLongestTime(0.),
+  schedTimedEvals(0), numSchedReports(0), totalMakespan(0.), totalIdealMakespan(0.),
+  totalBusyTime(0.), totalIdleTime(0.)
 {
   // set coreMappings flag based on presence of analysis_drivers specification
   coreMappings = (numAnalysisDrivers > 0);
@@ -84,11 +104,42 @@ ApplicationInterface(const ProblemDescDB& problem_db):
 	 << "ApplicationInterface.\n" << std::endl;
     abort_handler(-1);
   }
+
+  if (evalCacheFlag && evalCacheType == SHARDED_CACHE) {
+    if (nearbyDuplicateDetect) {
+      // tolerance-based lookups require an exhaustive search of an ordered
+      // cache, which the hashed shards do not support
+      Cerr << "\nWarning: sharded evaluation_cache does not support "
+	   << "tolerance-based cache\n         lookups; using multi_index "
+	   << "evaluation_cache." << std::endl;
+      evalCacheType = MULTI_INDEX_CACHE;
+    }
+    else {
+      // the sharded cache is global: the first interface to populate it
+      // determines its partitioning
+      int num_shards = problem_db.get_int("interface.evaluation_cache_shards");
+      if (sharded_data_pairs.empty()) {
+	if (num_shards > 0)
+	  sharded_data_pairs.num_shards(num_shards);
+	int max_entries
+	  = problem_db.get_int("interface.evaluation_cache_max_entries");
+	Real max_mb = problem_db.get_real("interface.evaluation_cache_max_memory");
+	if (max_entries > 0 || max_mb > 0.)
+	  sharded_data_pairs.capacity((size_t)max_entries,
+	    (size_t)(max_mb * 1024. * 1024.),
+	    problem_db.get_string("interface.evaluation_cache_spill_file"));
+      }
+    }
+  }
 }
 
 
 ApplicationInterface::~ApplicationInterface() 
-{ }
+{
+  delete [] chunkSendBuffers;
+  delete [] chunkRecvBuffers;
+  delete [] chunkRecvRequests;
+}
 
 
 void ApplicationInterface::
@@ -507,6 +558,7 @@ void ApplicationInterface::map(const Variables& vars, const ActiveSet& set,
 	//common_input_filtering(vars);
 
 	currEvalId = evalIdCntr;
+	start_evaluation_timer(currEvalId);
 	try { derived_map(vars, core_set, core_resp, currEvalId); }
 
 	catch(const FunctionEvalFailure& fneval_except) {
@@ -514,6 +566,7 @@ void ApplicationInterface::map(const Variables& vars, const ActiveSet& set,
 	  //<< fneval_except.what() << std::endl;
 	  manage_failure(vars, core_set, core_resp, currEvalId);
 	}
+	stop_evaluation_timer(currEvalId, vars);
 
 	//common_output_filtering(core_resp);
 
@@ -521,8 +574,12 @@ void ApplicationInterface::map(const Variables& vars, const ActiveSet& set,
 	  // manage shallow/deep copy of vars/response with evalCacheFlag
 	  ParamResponsePair prp(vars, interfaceId, core_resp, currEvalId,
 				evalCacheFlag);
-	  if (evalCacheFlag)   data_pairs.insert(prp);
-	  if (restartFileFlag) parallelLib.write_restart(prp);
+	  if (evalCacheFlag)   cache_insert(prp);
+	  if (restartFileFlag) {
+	    parallelLib.write_restart(prp);
+	    // a blocking map is complete: commit as at a synchronize()
+	    parallelLib.checkpoint_restart();
+	  }
 	}
       }
     }
@@ -619,6 +676,31 @@ duplication_detect(const Variables& vars, Response& response, bool asynch_flag)
 	{ cache_pr = *ord_it; data_pairs.erase(ord_it); }
     }
   }
+  else if (evalCacheType == SHARDED_CACHE) { // fast, exact, and thread-safe
+    // restart ids are promoted in place within the sharded cache
+    cache_hit = sharded_data_pairs.lookup_and_promote(interfaceId, vars,
+      response.active_set(), evalIdCntr, cache_pr);
+    if (cache_hit)
+      response.update(cache_pr.response(), true); // update metadata
+    else {
+      // records from restart and file import are only loaded into
+      // data_pairs: on a hit, migrate the promoted record to the shards
+      hash_it = lookup_by_val(data_pairs, interfaceId, vars,
+			      response.active_set());
+      cache_hit = (hash_it != data_pairs.get<hashed>().end());
+      if (cache_hit) {
+	sharded_data_pairs.count_restart_hit(); // not a miss of the cache
+	response.update(hash_it->response(), true); // update metadata
+	cache_pr = *hash_it;
+	if (cache_pr.eval_id() <= 0) {
+	  data_pairs.get<hashed>().erase(hash_it);
+	  cache_pr.eval_id(evalIdCntr); // promote
+	  sharded_data_pairs.insert(cache_pr);
+	}
+      }
+    }
+    cache_eval_id = cache_pr.eval_id(); // positive following any promotion
+  }
   else { // fast but requires exact binary match
     hash_it = lookup_by_val(data_pairs, interfaceId, vars,
 			    response.active_set());
@@ -731,6 +813,7 @@ const IntResponseMap& ApplicationInterface::synchronize()
     // Process nonduplicate evaluations for either the message passing or local 
     // asynchronous case.
     if (core_prp_jobs) {
+      begin_schedule_report();
       if (ieMessagePass) { // single or multi-processor servers
 	if (ieDedMasterFlag) master_dynamic_schedule_evaluations();
 	else {
@@ -748,6 +831,9 @@ const IntResponseMap& ApplicationInterface::synchronize()
       }
       else // local to processor
 	asynchronous_local_evaluations(beforeSynchCorePRPQueue);
+      end_schedule_report(core_prp_jobs);
+      // completion of the batch is a restart checkpoint
+      if (restartFileFlag) parallelLib.checkpoint_restart();
     }
   }
   else if (!beforeSynchAlgPRPQueue.empty()) {
@@ -973,6 +1059,9 @@ const IntResponseMap& ApplicationInterface::synchronize_nowait()
     syntax is encapsulated within ParallelLibrary. */
 void ApplicationInterface::master_dynamic_schedule_evaluations()
 {
+  if (chunked_messages())
+    { master_dynamic_schedule_evaluations_chunked(); return; }
+
   int capacity = numEvalServers;
   if (asynchLocalEvalConcurrency > 1) capacity *= asynchLocalEvalConcurrency;
   int num_jobs = beforeSynchCorePRPQueue.size(),
@@ -985,13 +1074,21 @@ void ApplicationInterface::master_dynamic_schedule_evaluations()
   recvBuffers  = new MPIUnpackBuffer [num_sends];
   recvRequests = new MPI_Request     [num_sends];
 
+  // dispatch order: queue order, or longest-predicted-first for cost-aware
+  // scheduling (refined as evaluation times are observed)
+  std::vector<PRPQueueIter> dispatch; dispatch.reserve(num_jobs);
+  PRPQueueIter prp_iter;
+  for (prp_iter  = beforeSynchCorePRPQueue.begin();
+       prp_iter != beforeSynchCorePRPQueue.end(); ++prp_iter)
+    dispatch.push_back(prp_iter);
+  size_t num_obs_ordered = 0;
+  order_pending_jobs(dispatch, 0, num_obs_ordered);
+
   // send data & post receives for 1st set of jobs
   int i, server_id, fn_eval_id;
-  PRPQueueIter prp_iter;
-  for (i=0, prp_iter = beforeSynchCorePRPQueue.begin(); i<num_sends;
-       ++i, ++prp_iter) {
+  for (i=0; i<num_sends; ++i) {
     server_id  = i%numEvalServers + 1; // from 1 to numEvalServers
-    send_evaluation(prp_iter, i, server_id, false); // !peer
+    send_evaluation(dispatch[i], i, server_id, false); // !peer
   }
 
   // schedule remaining jobs
@@ -1015,8 +1112,9 @@ void ApplicationInterface::master_dynamic_schedule_evaluations()
 	return_iter = lookup_by_eval_id(beforeSynchCorePRPQueue, fn_eval_id);
 	receive_evaluation(return_iter, index, server_id, false);  //!peer
         if (send_cntr < num_jobs) {                              
-	  send_evaluation(prp_iter, index, server_id, false); // !peer
-          ++send_cntr; ++prp_iter;
+	  order_pending_jobs(dispatch, send_cntr, num_obs_ordered);
+	  send_evaluation(dispatch[send_cntr], index, server_id, false);//!peer
+          ++send_cntr;
         }
       }
     }
@@ -1028,10 +1126,9 @@ void ApplicationInterface::master_dynamic_schedule_evaluations()
       Cout << "Master dynamic schedule: waiting on all jobs" << std::endl;
     parallelLib.waitall(num_jobs, recvRequests);
     // All buffers received, now generate rawResponseMap
-    for (i=0, prp_iter = beforeSynchCorePRPQueue.begin(); i<num_jobs;
-         ++i, ++prp_iter) {
+    for (i=0; i<num_jobs; ++i) {
       server_id = i%numEvalServers + 1; // from 1 to numEvalServers
-      receive_evaluation(prp_iter, i, server_id, false);
+      receive_evaluation(dispatch[i], i, server_id, false);
     }
   }
   // deallocate MPI & buffer arrays
@@ -1041,6 +1138,138 @@ void ApplicationInterface::master_dynamic_schedule_evaluations()
 }
 
 
+/** Chunked variant of master_dynamic_schedule_evaluations() for fine-grained
+    evaluations, where the latency of one message per evaluation would
+    otherwise make the master the bottleneck.  Each message carries a
+    chunk of evaluations, sized by evaluation_chunk_size() from the
+    average evaluation time observed so far, and each server has up to
+    two chunks outstanding so that its next chunk is already queued when
+    it returns the results of the current one.  The message buffers are
+    retained across invocations.  It matches
+    serve_evaluations_synch_chunked() on the slave servers. */
+void ApplicationInterface::master_dynamic_schedule_evaluations_chunked()
+{
+  typedef std::chrono::steady_clock clock;
+  typedef std::chrono::duration<Real> seconds;
+
+  // two outstanding chunks per server
+  size_t i, num_buffers = 2 * numEvalServers, buff_index,
+    num_jobs = beforeSynchCorePRPQueue.size(), num_chunk,
+    max_chunk = (evalChunkMax > 0) ? evalChunkMax : 64;
+  if (numChunkBuffers != num_buffers) {
+    delete [] chunkSendBuffers;  delete [] chunkRecvBuffers;
+    delete [] chunkRecvRequests;
+    chunkSendBuffers  = new MPIPackBuffer   [num_buffers];
+    chunkRecvBuffers  = new MPIUnpackBuffer [num_buffers];
+    chunkRecvRequests = new MPI_Request     [num_buffers];
+    numChunkBuffers = num_buffers;
+  }
+  int recv_len = max_chunk * lenResponseMessage;
+  for (i=0; i<num_buffers; ++i) {
+    if (chunkRecvBuffers[i].size() != recv_len)
+      chunkRecvBuffers[i].resize(recv_len);
+    chunkRecvRequests[i] = MPI_REQUEST_NULL;
+  }
+  // send_evaluation_chunk() and receive_evaluation() operate on these
+  sendBuffers  = chunkSendBuffers;  recvBuffers = chunkRecvBuffers;
+  recvRequests = chunkRecvRequests;
+
+  // bookkeeping for the chunk held by each buffer
+  std::vector<PRPQueueIter> chunk_begin(num_buffers);
+  SizetArray chunk_size(num_buffers, 0);
+  std::vector<clock::time_point> chunk_sent(num_buffers),
+    server_free(numEvalServers);
+
+  // first pass: up to two chunks per server
+  PRPQueueIter assign_iter = beforeSynchCorePRPQueue.begin();
+  size_t num_assigned = 0, num_returned = 0;
+  int server_id;
+  for (buff_index=0; buff_index<num_buffers && num_assigned<num_jobs;
+       ++buff_index) {
+    server_id = buff_index % numEvalServers + 1; // 1 to numEvalServers
+    num_chunk = evaluation_chunk_size(num_jobs - num_assigned, numEvalServers,
+				      max_chunk, chunkEvalTime);
+    chunk_begin[buff_index] = assign_iter;
+    chunk_size[buff_index]  = num_chunk;
+    chunk_sent[buff_index]  = clock::now();
+    send_evaluation_chunk(assign_iter, num_chunk, buff_index, server_id);
+    num_assigned += num_chunk;
+  }
+  Cout << "Master dynamic schedule: first pass assigning " << num_assigned
+       << " jobs in chunks among " << numEvalServers << " servers\n";
+  for (i=0; i<numEvalServers; ++i)
+    server_free[i] = clock::now();
+
+  // second pass: process returned chunks and backfill their buffers
+  MPI_Status* status_array = new MPI_Status [num_buffers];
+  int* index_array = new int [num_buffers];
+  int out_count;
+  while (num_returned < num_jobs) {
+    if (outputLevel > SILENT_OUTPUT)
+      Cout << "Master dynamic schedule: waiting on completed jobs" <<std::endl;
+    parallelLib.waitsome(num_buffers, recvRequests, out_count, index_array,
+			 status_array);
+    for (i=0; i<out_count; ++i) {
+      buff_index = index_array[i];
+      size_t server_index = buff_index % numEvalServers;
+      server_id = server_index + 1;
+
+      // the server started this chunk once it was both sent and the
+      // server had returned its previous chunk
+      clock::time_point now = clock::now();
+      Real elapsed = seconds(now -
+	std::max(chunk_sent[buff_index], server_free[server_index])).count();
+      server_free[server_index] = now;
+      Real eval_time = elapsed / chunk_size[buff_index];
+      chunkEvalTime = (chunkEvalTime > 0.) ?
+	0.75 * chunkEvalTime + 0.25 * eval_time : eval_time;
+
+      // responses are packed in the order of the chunk
+      PRPQueueIter return_iter = chunk_begin[buff_index];
+      for (num_chunk=0; num_chunk<chunk_size[buff_index];
+	   ++num_chunk, ++return_iter)
+	receive_evaluation(return_iter, buff_index, server_id, false); // !peer
+      num_returned += chunk_size[buff_index];
+      chunk_size[buff_index] = 0;
+
+      if (num_assigned < num_jobs) {
+	num_chunk = evaluation_chunk_size(num_jobs - num_assigned,
+	  numEvalServers, max_chunk, chunkEvalTime);
+	chunk_begin[buff_index] = assign_iter;
+	chunk_size[buff_index]  = num_chunk;
+	chunk_sent[buff_index]  = clock::now();
+	send_evaluation_chunk(assign_iter, num_chunk, buff_index, server_id);
+	num_assigned += num_chunk;
+      }
+    }
+  }
+  delete [] status_array;
+  delete [] index_array;
+
+  // the chunk buffers persist for the next invocation
+  sendBuffers = NULL;  recvBuffers = NULL;  recvRequests = NULL;
+}
+
+
+/** Guided self-scheduling bounds each chunk by half of an even share
+    of the remaining jobs, keeping the final chunks small for load
+    balance.  Within that bound, a chunk holds enough evaluations to
+    take about 10 ms at the observed evaluation time, amortizing the
+    message latency over the chunk, and a single evaluation until the
+    evaluation time has been observed. */
+size_t ApplicationInterface::
+evaluation_chunk_size(size_t num_remaining, size_t num_servers,
+		      size_t max_chunk, Real eval_time)
+{
+  const Real target_chunk_time = 0.01; // seconds
+  size_t chunk = std::max(num_remaining / (2 * std::max(num_servers,
+    (size_t)1)), (size_t)1);
+  size_t timed = (eval_time > 0.) ?
+    (size_t)std::ceil(target_chunk_time / eval_time) : 1;
+  return std::max(std::min(std::min(chunk, timed), max_chunk), (size_t)1);
+}
+
+
 /** This code runs on the iteratorCommRank 0 processor (the iterator) and is
     called from synchronize() in order to manage a static schedule for cases
     where peer 1 must block when evaluating its local job allocation (e.g.,
@@ -1065,27 +1294,59 @@ void ApplicationInterface::peer_static_schedule_evaluations()
   int num_jobs       = beforeSynchCorePRPQueue.size(), 
       num_peer1_jobs = (int)std::floor((Real)num_jobs/numEvalServers),
       num_sends      = num_jobs - num_peer1_jobs;
+  int i, server_id, fn_eval_id;
+
+  // Cost-aware scheduling balances the predicted load of the peers using
+  // the longest-processing-time rule, sending each peer its jobs
+  // longest-predicted-first.
+  std::vector<PRPQueueIter> dispatch; dispatch.reserve(num_jobs);
+  IntArray dispatch_server(num_jobs);
+  PRPQueueIter prp_iter = beforeSynchCorePRPQueue.begin();
+  for (i=1; i<=num_jobs; ++i, ++prp_iter) { // shift by 1 to reduce peer 1 work
+    dispatch.push_back(prp_iter);
+    dispatch_server[i-1] = i%numEvalServers; // 0 to numEvalServers-1
+  }
+  if (costAwareScheduling && runtimePredictor.num_observations()) {
+    RealArray predicted(num_jobs);
+    for (i=0; i<num_jobs; ++i)
+      predicted[i] = predicted_runtime(*dispatch[i]);
+    SizetArray order, assignment;
+    Real makespan = EvaluationRuntimePredictor::
+      balance_static(predicted, numEvalServers, assignment);
+    EvaluationRuntimePredictor::longest_first(predicted, order);
+    std::vector<PRPQueueIter> queue_order(dispatch);
+    num_peer1_jobs = 0;
+    for (i=0; i<num_jobs; ++i) {
+      dispatch[i] = queue_order[order[i]];
+      dispatch_server[i] = assignment[order[i]];
+      if (!dispatch_server[i]) ++num_peer1_jobs;
+    }
+    num_sends = num_jobs - num_peer1_jobs;
+    if (outputLevel > SILENT_OUTPUT)
+      Cout << "Peer static schedule: predicted makespan " << makespan
+	   << " s\n";
+  }
+
   Cout << "Peer static schedule: assigning " << num_jobs << " jobs among " 
        << numEvalServers << " peers\n";
   sendBuffers  = new MPIPackBuffer   [num_sends];
   recvBuffers  = new MPIUnpackBuffer [num_sends];
   recvRequests = new MPI_Request     [num_sends];
-  int i, server_id, fn_eval_id;
 
-  // Assign jobs locally + remotely using a round-robin assignment.  Since
-  // this is a static schedule, all remote job assignments are sent now.  This
-  // assignment is not dependent on the capacity of the other peers (i.e.,
-  // on whether they run serve_evaluation_synch or serve_evaluation_asynch).
-  PRPQueueIter prp_iter = beforeSynchCorePRPQueue.begin();
+  // Assign jobs locally + remotely using a round-robin (or predicted load
+  // balancing) assignment.  Since this is a static schedule, all remote job
+  // assignments are sent now.  This assignment is not dependent on the
+  // capacity of the other peers (i.e., on whether they run
+  // serve_evaluation_synch or serve_evaluation_asynch).
   PRPQueue local_prp_queue; size_t buff_index = 0;
-  for (i=1; i<=num_jobs; ++i, ++prp_iter) { // shift by 1 to reduce peer 1 work
-    server_id = i%numEvalServers; // 0 to numEvalServers-1
+  for (i=0; i<num_jobs; ++i) {
+    server_id = dispatch_server[i]; // 0 to numEvalServers-1
     if (server_id) { // 1 to numEvalServers-1
-      send_evaluation(prp_iter, buff_index, server_id, true); // peer
+      send_evaluation(dispatch[i], buff_index, server_id, true); // peer
       ++buff_index;
     }
     else
-      local_prp_queue.insert(*prp_iter);
+      local_prp_queue.insert(*dispatch[i]);
   }
   // This simple approach is not best for hybrid mode + asynchLocalEvalStatic:
   // Peer 1 retains the first num_peer1_jobs and spreads the rest to peers 2
@@ -1128,11 +1389,11 @@ void ApplicationInterface::peer_static_schedule_evaluations()
     parallelLib.waitall(num_sends, recvRequests);
 
     // All buffers received, now generate rawResponseMap
-    prp_iter = beforeSynchCorePRPQueue.begin(); buff_index = 0;
-    for (i=1; i<=num_jobs; ++i, ++prp_iter) {// shift by 1 to reduce peer 1 work
-      server_id = i%numEvalServers; // 0 to numEvalServers-1
+    buff_index = 0;
+    for (i=0; i<num_jobs; ++i) {
+      server_id = dispatch_server[i]; // 0 to numEvalServers-1
       if (server_id) {
-	receive_evaluation(prp_iter, buff_index, server_id, true); // peer
+	receive_evaluation(dispatch[i], buff_index, server_id, true); // peer
 	++buff_index;
       }
     }
@@ -1246,6 +1507,9 @@ asynchronous_local_evaluations(PRPQueue& local_prp_queue)
     = (asynchLocalEvalStatic && asynchLocalEvalConcurrency > 1);
   if (static_limited)
     static_servers = asynchLocalEvalConcurrency * numEvalServers;
+  else if (costAwareScheduling && !batchEval && asynchLocalEvalConcurrency &&
+	   asynchLocalEvalConcurrency < num_jobs)
+    { asynchronous_local_evaluations_ordered(local_prp_queue); return; }
 
   // Step 1: first pass launching of jobs up to the local server capacity
   Cout << "First pass: initiating ";
@@ -1320,6 +1584,56 @@ asynchronous_local_evaluations(PRPQueue& local_prp_queue)
 }
 
 
+/** Dynamic local scheduling as in asynchronous_local_evaluations(), but
+    launching the jobs longest-predicted-first so that long evaluations
+    do not straggle at the end of the batch.  The order of the pending
+    jobs is refined as evaluation times are observed. */
+void ApplicationInterface::
+asynchronous_local_evaluations_ordered(PRPQueue& local_prp_queue)
+{
+  int num_bcast = local_prp_queue.size();
+  if (multiProcEvalFlag) // match bcast in assign_asynch_local_queue()
+    parallelLib.bcast_e(num_bcast);
+  size_t num_jobs = num_bcast, num_sends
+    = std::min((size_t)asynchLocalEvalConcurrency, num_jobs);
+
+  std::vector<PRPQueueIter> dispatch; dispatch.reserve(num_jobs);
+  for (PRPQueueIter prp_iter = local_prp_queue.begin();
+       prp_iter != local_prp_queue.end(); ++prp_iter)
+    dispatch.push_back(prp_iter);
+  size_t num_obs_ordered = 0;
+  order_pending_jobs(dispatch, 0, num_obs_ordered);
+
+  // Step 1: first pass launching of jobs up to the local server capacity
+  Cout << "First pass: initiating " << num_sends
+       << " local asynchronous jobs in order of predicted cost\n";
+  size_t num_launched;
+  for (num_launched=0; num_launched<num_sends; ++num_launched)
+    launch_asynch_local(dispatch[num_launched]);
+  Cout << "Second pass: scheduling " << num_jobs - num_sends
+       << " remaining local asynchronous jobs\n";
+
+  size_t recv_cntr = 0, completed;
+  while (recv_cntr < num_jobs) {
+    // Step 2: process completed jobs with wait_local_evaluations()
+    if (outputLevel > SILENT_OUTPUT)
+      Cout << "Waiting on completed jobs" << std::endl;
+    completionSet.clear();
+    wait_local_evaluations(asynchLocalActivePRPQueue); // rebuilds completionSet
+    recv_cntr += completed = completionSet.size();
+    for (ISCIter id_iter = completionSet.begin();
+	 id_iter != completionSet.end(); ++id_iter)
+      process_asynch_local(*id_iter);
+
+    // Step 3: backfill completed jobs with the longest pending jobs
+    if (completed && num_launched < num_jobs)
+      order_pending_jobs(dispatch, num_launched, num_obs_ordered);
+    for (size_t i=0; i<completed && num_launched<num_jobs; ++i, ++num_launched)
+      launch_asynch_local(dispatch[num_launched]);
+  }
+}
+
+
 void ApplicationInterface::
 assign_asynch_local_queue(PRPQueue& local_prp_queue,
 			  PRPQueueIter& local_prp_iter)
@@ -2112,11 +2426,13 @@ synchronous_local_evaluations(PRPQueue& local_prp_queue)
     if (multiProcEvalFlag)
       broadcast_evaluation(*local_prp_iter);
 
+    start_evaluation_timer(currEvalId);
     try { derived_map(vars, set, local_response, currEvalId); } // synch. local
 
     catch(const FunctionEvalFailure& fneval_except) {
       manage_failure(vars, set, local_response, currEvalId);
     }
+    stop_evaluation_timer(currEvalId, vars);
 
     process_synch_local(local_prp_iter);
   }
@@ -2168,8 +2484,9 @@ void ApplicationInterface::serve_evaluations()
     else              serve_evaluations_asynch();
   }
   else {
-    if (peer_server1) serve_evaluations_synch_peer();
-    else              serve_evaluations_synch();
+    if (peer_server1)            serve_evaluations_synch_peer();
+    else if (chunked_messages()) serve_evaluations_synch_chunked();
+    else                         serve_evaluations_synch();
   }
 }
 
@@ -2249,6 +2566,64 @@ void ApplicationInterface::serve_evaluations_synch()
 }
 
 
+/** Chunked variant of serve_evaluations_synch(): each message from the
+    master holds a chunk of evaluations, which are performed in order and
+    returned together in one message tagged with the tag of the chunk.
+    The buffers are sized for evalChunkMax evaluations and reused. */
+void ApplicationInterface::serve_evaluations_synch_chunked()
+{
+  int max_chunk = (evalChunkMax > 0) ? evalChunkMax : 64, chunk_tag = 1,
+    num_chunk, i;
+  MPIPackBuffer int_buffer;  int_buffer << chunk_tag;
+  int len_int = int_buffer.size();
+  MPIUnpackBuffer recv_buffer(len_int +
+			      max_chunk * (len_int + lenVarsActSetMessage));
+  MPIPackBuffer send_buffer(max_chunk * lenResponseMessage);
+  MPI_Status status;
+  MPI_Request request = MPI_REQUEST_NULL; // bypass MPI_Wait on first pass
+  currEvalId = 1;
+  while (chunk_tag) {
+    recv_buffer.reset();
+    if (evalCommRank == 0) { // 1-level or local comm. leader in 2-level
+      parallelLib.recv_ie(recv_buffer, 0, MPI_ANY_TAG, status);
+      chunk_tag = status.MPI_TAG;
+    }
+    if (multiProcEvalFlag) { // multilevel must Bcast chunk over evalComm
+      parallelLib.bcast_e(chunk_tag);
+      if (chunk_tag)
+	parallelLib.bcast_e(recv_buffer);
+    }
+    if (!chunk_tag) // termination signal
+      break;
+
+    // the previous chunk of responses must be received before send_buffer
+    // is repacked
+    if (request != MPI_REQUEST_NULL)
+      parallelLib.wait(request, status);
+    send_buffer.reset();
+
+    recv_buffer >> num_chunk;
+    for (i=0; i<num_chunk; ++i) {
+      Variables vars; ActiveSet set;
+      recv_buffer >> currEvalId >> vars >> set;
+      Response local_response(sharedRespData, set); // special constructor
+      try { derived_map(vars, set, local_response, currEvalId); }
+      catch(const FunctionEvalFailure& fneval_except) {
+	manage_failure(vars, set, local_response, currEvalId);
+      }
+      if (evalCommRank == 0)
+	send_buffer << local_response;
+    }
+
+    if (evalCommRank == 0)
+      parallelLib.isend_ie(send_buffer, 0, chunk_tag, request);
+  }
+  if (request != MPI_REQUEST_NULL)
+    parallelLib.wait(request, status);
+  currEvalId = 0;
+}
+
+
 /** This code is invoked by serve_evaluations() to perform a synchronous
     evaluation in coordination with the iteratorCommRank 0 processor
     (the iterator) for static schedules.  The bcast() matches either the
@@ -2740,12 +3115,12 @@ manage_failure(const Variables& vars, const ActiveSet& set, Response& response,
     response.function_values(failRecoveryFnVals);
   }
   else if (failAction == "continuation") {
-    // Compute closest source pt. for continuation from extern data_pairs.
+    // Compute closest source pt. for continuation from the evaluation cache.
     ParamResponsePair source_pair;
     // THIS CODE BLOCK IS A PLACEHOLDER AND IS NOT YET OPERATIONAL
     if (iteratorCommRank) { // if other than master
       // Get source pt. for continuation.  Master calls get_source_point for 
-      // slave (since it has access to data_pairs) and returns result.
+      // slave (since it has access to the cache) and returns result.
       MPIPackBuffer send_buffer(lenVarsMessage);
       send_buffer << vars;
       // master must receive failure message w/i *_schedule_evaluations 
@@ -2776,10 +3151,13 @@ manage_failure(const Variables& vars, const ActiveSet& set, Response& response,
 }
 
 
-const ParamResponsePair& 
+ParamResponsePair
 ApplicationInterface::get_source_pair(const Variables& target_vars)
 {
-  if (data_pairs.size() == 0) {
+  // includes records held by a sharded evaluation cache
+  PRPArray source_prps;
+  evaluation_records(source_prps);
+  if (source_prps.empty()) {
     Cerr << "Failure captured: No points available, aborting" << std::endl;
     abort_handler(-1);
   }
@@ -2792,15 +3170,16 @@ ApplicationInterface::get_source_pair(const Variables& target_vars)
 
   // TO DO: Need to check for same interfaceId as well.  Currently, this is 
   // part of Response -> need to add to Interface.
-  PRPCacheCIter prp_iter, prp_end_iter = data_pairs.end(), best_iter;
-  for (prp_iter = data_pairs.begin(); prp_iter != prp_end_iter; ++prp_iter) {
+  PRPArray::const_iterator prp_iter, prp_end_iter = source_prps.end(),
+    best_iter;
+  for (prp_iter = source_prps.begin(); prp_iter != prp_end_iter; ++prp_iter) {
     //if (interfaceId == prp_iter->interface_id()) {
       const RealVector& xc_source 
 	= prp_iter->variables().continuous_variables();
       Real sum_of_squares = 0.;
       for (i=0; i<num_vars; ++i)
         sum_of_squares += std::pow( xc_source[i] - xc_target[i], 2);
-      if (prp_iter == data_pairs.begin() || sum_of_squares < best_sos) {
+      if (prp_iter == source_prps.begin() || sum_of_squares < best_sos) {
         best_iter = prp_iter;
         best_sos  = sum_of_squares;
       }
@@ -2933,13 +3312,47 @@ receive_evaluation(PRPQueueIter& prp_it, size_t buff_index, int server_id,
   // don't trample raw response sizing with lightweight remote response
   Response raw_response = rawResponseMap[fn_eval_id] = prp_it->response();
   raw_response.update(remote_response, true); // update metadata
+  stop_evaluation_timer(prp_it->eval_id(), prp_it->variables());
 
   // insert into restart and eval cache ASAP
-  if (evalCacheFlag)   data_pairs.insert(*prp_it);
+  if (evalCacheFlag)   cache_insert(*prp_it);
   if (restartFileFlag) parallelLib.write_restart(*prp_it);
 }
 
 
+/** Packs the number of evaluations followed by the id, variables, and
+    active set of each, pre-posts the receive of the chunk of responses
+    (tagged with the first evaluation id), and sends the chunk. */
+void ApplicationInterface::
+send_evaluation_chunk(PRPQueueIter& prp_it, size_t num_chunk,
+		      size_t buff_index, int server_id)
+{
+  MPIPackBuffer& send_buffer = sendBuffers[buff_index];
+  send_buffer.reset();  recvBuffers[buff_index].reset();
+  int chunk_tag = prp_it->eval_id(), num_evals = num_chunk, fn_eval_id;
+  send_buffer << num_evals;
+  for (size_t i=0; i<num_chunk; ++i, ++prp_it) {
+    fn_eval_id = prp_it->eval_id();
+    send_buffer << fn_eval_id << prp_it->variables() << prp_it->active_set();
+    if (outputLevel > SILENT_OUTPUT) {
+      Cout << "Master assigning ";
+      if (!(interfaceId.empty() || interfaceId == "NO_ID"))
+	Cout << interfaceId << ' ';
+      Cout << "evaluation " << fn_eval_id << " to server " << server_id
+	   << '\n';
+    }
+  }
+
+  // pre-post nonblocking receive (to prevent any message buffering)
+  parallelLib.irecv_ie(recvBuffers[buff_index], server_id, chunk_tag,
+		       recvRequests[buff_index]);
+  // nonblocking send: the buffer is not reused until the chunk returns
+  MPI_Request send_request;
+  parallelLib.isend_ie(send_buffer, server_id, chunk_tag, send_request);
+  parallelLib.free(send_request);
+}
+
+
 void ApplicationInterface::process_asynch_local(int fn_eval_id)
 {
   PRPQueueIter prp_it
@@ -2958,8 +3371,9 @@ void ApplicationInterface::process_asynch_local(int fn_eval_id)
     Cout << " has completed\n";
   }
 
+  stop_evaluation_timer(prp_it->eval_id(), prp_it->variables());
   rawResponseMap[fn_eval_id] = prp_it->response();
-  if (evalCacheFlag)   data_pairs.insert(*prp_it);
+  if (evalCacheFlag)   cache_insert(*prp_it);
   if (restartFileFlag) parallelLib.write_restart(*prp_it);
 
   asynchLocalActivePRPQueue.erase(prp_it);
@@ -2980,15 +3394,154 @@ void ApplicationInterface::process_synch_local(PRPQueueIter& prp_it)
     Cout << "evaluation " << fn_eval_id << std::endl;
   }
   rawResponseMap[fn_eval_id] = prp_it->response();
-  if (evalCacheFlag)   data_pairs.insert(*prp_it);
+  if (evalCacheFlag)   cache_insert(*prp_it);
   if (restartFileFlag) parallelLib.write_restart(*prp_it);
 }
 
 
+void ApplicationInterface::start_evaluation_timer(int fn_eval_id)
+{
+  if (costAwareScheduling)
+    evalStartTimes[fn_eval_id] = wall_clock_time();
+}
+
+
+void ApplicationInterface::
+stop_evaluation_timer(int fn_eval_id, const Variables& vars)
+{
+  IntRealMap::iterator it = evalStartTimes.find(fn_eval_id);
+  if (it == evalStartTimes.end())
+    return;
+  Real eval_time = wall_clock_time() - it->second;
+  evalStartTimes.erase(it);
+  runtimePredictor.update(runtime_key(vars), vars.continuous_variables(),
+			  eval_time);
+  schedBusyTime += eval_time;
+  schedLongestTime = std::max(schedLongestTime, eval_time);
+  ++schedTimedEvals;
+}
+
+
+/** Discrete integer and real values, including inactive state
+    variables, commonly select a model fidelity or solution level, so
+    each combination is fit separately. */
+RealArray ApplicationInterface::runtime_key(const Variables& vars)
+{
+  const IntVector&  di_vars = vars.all_discrete_int_variables();
+  const RealVector& dr_vars = vars.all_discrete_real_variables();
+  int i, num_di = di_vars.length(), num_dr = dr_vars.length();
+  RealArray key(num_di + num_dr);
+  for (i=0; i<num_di; ++i)
+    key[i] = (Real)di_vars[i];
+  for (i=0; i<num_dr; ++i)
+    key[num_di + i] = dr_vars[i];
+  return key;
+}
+
+
+Real ApplicationInterface::predicted_runtime(const ParamResponsePair& prp)
+{
+  const Variables& vars = prp.variables();
+  return runtimePredictor.predict(runtime_key(vars),
+				  vars.continuous_variables());
+}
+
+
+/** Reordering only when the observations have doubled bounds the
+    number of reorderings of a batch by the logarithm of its size. */
+void ApplicationInterface::
+order_pending_jobs(std::vector<PRPQueueIter>& jobs, size_t first,
+		   size_t& num_obs_ordered)
+{
+  size_t num_obs = runtimePredictor.num_observations();
+  if (!costAwareScheduling || !num_obs || first + 1 >= jobs.size() ||
+      (num_obs_ordered && num_obs < 2 * num_obs_ordered))
+    return;
+
+  size_t i, num_pending = jobs.size() - first;
+  RealArray predicted(num_pending);
+  for (i=0; i<num_pending; ++i)
+    predicted[i] = predicted_runtime(*jobs[first + i]);
+  SizetArray order;
+  EvaluationRuntimePredictor::longest_first(predicted, order);
+  std::vector<PRPQueueIter> pending(jobs.begin() + first, jobs.end());
+  for (i=0; i<num_pending; ++i)
+    jobs[first + i] = pending[order[i]];
+  num_obs_ordered = num_obs;
+}
+
+
+void ApplicationInterface::begin_schedule_report()
+{
+  if (!costAwareScheduling)
+    return;
+  schedStartTime = wall_clock_time();
+  schedBusyTime = schedLongestTime = 0.;
+  schedTimedEvals = 0;
+}
+
+
+/** The ideal makespan is the larger of the evaluation time spread
+    evenly over the concurrent evaluation capacity and the longest
+    evaluation.  Schedules including evaluations that were not timed
+    (e.g., chunked messages or remote peer jobs) are not reported. */
+void ApplicationInterface::end_schedule_report(size_t num_jobs)
+{
+  if (!costAwareScheduling || schedTimedEvals < num_jobs || !num_jobs)
+    return;
+
+  Real makespan = wall_clock_time() - schedStartTime;
+  size_t server_capacity = (asynchLocalEvalConcurrency > 0) ?
+    asynchLocalEvalConcurrency : ((ieMessagePass) ? 1 : num_jobs);
+  size_t capacity
+    = std::min(num_jobs, std::max(numEvalServers, 1) * server_capacity);
+  Real ideal = std::max(schedBusyTime / capacity, schedLongestTime),
+    idle = std::max(capacity * makespan - schedBusyTime, 0.);
+  if (outputLevel > SILENT_OUTPUT && makespan > 0.)
+    Cout << "Cost-aware schedule: makespan " << makespan << " s, ideal "
+	 << ideal << " s (" << 100. * ideal / makespan << "% efficiency), "
+	 << idle << " s idle server time\n";
+  ++numSchedReports;
+  totalMakespan += makespan;  totalIdealMakespan += ideal;
+  totalBusyTime += schedBusyTime;  totalIdleTime += idle;
+}
+
+
+void ApplicationInterface::print_scheduling_summary(std::ostream& s) const
+{
+  if (!numSchedReports)
+    return;
+  s << "  Cost-aware scheduling: " << numSchedReports << " schedules, "
+    << "makespan " << totalMakespan << " s, ideal " << totalIdealMakespan
+    << " s";
+  if (totalMakespan > 0.)
+    s << " (" << 100. * totalIdealMakespan / totalMakespan << "% efficiency)";
+  s << "\n                         " << totalBusyTime << " s evaluating, "
+    << totalIdleTime << " s idle server time, runtimes predicted from "
+    << runtimePredictor.num_observations() << " evaluations\n";
+}
+
+
 void ApplicationInterface::common_input_filtering(const Variables& vars)
 { } // empty for now
 
 
+void ApplicationInterface::cache_insert(const ParamResponsePair& prp)
+{
+  if (evalCacheType == SHARDED_CACHE) sharded_data_pairs.insert(prp);
+  else                                data_pairs.insert(prp);
+}
+
+
+/** The sharded cache is shared by all interfaces selecting it, such
+    that its counters are cumulative over these interfaces. */
+void ApplicationInterface::print_cache_summary(std::ostream& s) const
+{
+  if (evalCacheFlag && evalCacheType == SHARDED_CACHE)
+    sharded_data_pairs.print_statistics(s);
+}
+
+
 void ApplicationInterface::common_output_filtering(Response& response)
 { } // empty for now
 
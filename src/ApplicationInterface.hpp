@@ -12,6 +12,8 @@
 
 #include "DakotaInterface.hpp"
 #include "PRPMultiIndex.hpp"
+#include "PRPShardedCache.hpp"
+#include "EvaluationRuntimePredictor.hpp"
 #include "ParallelLibrary.hpp"
 #include "DataMethod.hpp"
 
@@ -46,6 +48,17 @@ public:
   ApplicationInterface(const ProblemDescDB& problem_db); ///< constructor
   ~ApplicationInterface();                               ///< destructor
 
+  //
+  //- Heading: Member functions
+  //
+
+  /// number of evaluations to pack into the next chunked message of a
+  /// dedicated master, given the number of jobs not yet assigned, the
+  /// number of servers, the maximum chunk size, and the observed time
+  /// per evaluation (0 if not yet observed)
+  static size_t evaluation_chunk_size(size_t num_remaining, size_t num_servers,
+				      size_t max_chunk, Real eval_time);
+
 protected:
 
   //
@@ -78,6 +91,11 @@ protected:
   /// form and return the final evaluation ID tag, appending iface ID if needed
   String final_eval_id_tag(int fn_eval_id);
 
+  /// print hit/miss/eviction counters for a SHARDED_CACHE
+  void print_cache_summary(std::ostream& s) const;
+  /// print the efficiency of the cost-aware schedules
+  void print_scheduling_summary(std::ostream& s) const;
+
   // Placeholders for external layer of filtering (common I/O operations
   // such as d.v. linking and response time history smoothing)
   //void filter(const Variables& vars);
@@ -275,6 +293,9 @@ private:
   /// using message passing on a dedicated master partition; executes on
   /// iteratorComm master
   void master_dynamic_schedule_evaluations();
+  /// variant of master_dynamic_schedule_evaluations() that packs several
+  /// evaluations into each message, sized by the observed evaluation time
+  void master_dynamic_schedule_evaluations_chunked();
   /// blocking static schedule of all evaluations in beforeSynchCorePRPQueue
   /// using message passing on a peer partition; executes on iteratorComm master
   void peer_static_schedule_evaluations();
@@ -284,6 +305,9 @@ private:
   /// perform all jobs in prp_queue using asynchronous approaches on
   /// the local processor
   void asynchronous_local_evaluations(PRPQueue& prp_queue);
+  /// variant of asynchronous_local_evaluations() launching the jobs
+  /// longest-predicted-first for cost-aware scheduling
+  void asynchronous_local_evaluations_ordered(PRPQueue& prp_queue);
   /// perform all jobs in prp_queue using synchronous approaches on
   /// the local processor
   void synchronous_local_evaluations(PRPQueue& prp_queue);
@@ -313,6 +337,32 @@ private:
   /// helper function for sending sendBuffers[buff_index] to server
   void send_evaluation(PRPQueueIter& prp_it, size_t buff_index, int server_id,
 		       bool peer_flag);
+  /// helper function for sending num_chunk evaluations beginning with
+  /// prp_it to server in one message (advances prp_it)
+  void send_evaluation_chunk(PRPQueueIter& prp_it, size_t num_chunk,
+			     size_t buff_index, int server_id);
+  /// whether evaluation messages between a dedicated master and its
+  /// synchronous servers are chunked
+  bool chunked_messages() const;
+  /// reorder jobs[first,end) longest-predicted-first, if cost-aware
+  /// scheduling is active and the observed evaluations have at least
+  /// doubled since num_obs_ordered (updated) observations were used
+  void order_pending_jobs(std::vector<PRPQueueIter>& jobs, size_t first,
+			  size_t& num_obs_ordered);
+  /// predicted wall time of an evaluation (0 before any observations)
+  Real predicted_runtime(const ParamResponsePair& prp);
+  /// discrete variable values distinguishing the runtime fits
+  static RealArray runtime_key(const Variables& vars);
+  /// record the start of an evaluation for cost-aware scheduling
+  void start_evaluation_timer(int fn_eval_id);
+  /// record the wall time of a completed evaluation, if it was started
+  /// by start_evaluation_timer()
+  void stop_evaluation_timer(int fn_eval_id, const Variables& vars);
+  /// begin measuring the efficiency of a blocking schedule
+  void begin_schedule_report();
+  /// report the efficiency of a blocking schedule of num_jobs jobs
+  void end_schedule_report(size_t num_jobs);
+
   /// helper function for processing recvBuffers[buff_index] within scheduler
   void receive_evaluation(PRPQueueIter& prp_it, size_t buff_index,
 			  int server_id, bool peer_flag);
@@ -346,6 +396,9 @@ private:
   /// serve the evaluation message passing schedulers and perform
   /// one synchronous evaluation at a time
   void serve_evaluations_synch();
+  /// serve chunked messages from master_dynamic_schedule_evaluations_chunked(),
+  /// performing the evaluations of each chunk synchronously
+  void serve_evaluations_synch_chunked();
   /// serve the evaluation message passing schedulers and perform
   /// one synchronous evaluation at a time as part of the 1st peer
   void serve_evaluations_synch_peer();
@@ -376,7 +429,7 @@ private:
   /// convenience function for the continuation approach in
   /// manage_failure() for finding the nearest successful "source"
   /// evaluation to the failed "target"
-  const ParamResponsePair& get_source_pair(const Variables& target_vars);
+  ParamResponsePair get_source_pair(const Variables& target_vars);
   /// performs a 0th order continuation method to step from a
   /// successful "source" evaluation to the failed "target".
   /// Invoked by manage_failure() for failAction == "continuation".
@@ -387,6 +440,10 @@ private:
   /// common input filtering operations, e.g. mesh movement
   void common_input_filtering(const Variables& vars);
 
+  /// insert a completed evaluation into the evaluation cache selected
+  /// by evalCacheType
+  void cache_insert(const ParamResponsePair& prp);
+
   /// common output filtering operations, e.g. data filtering
   void common_output_filtering(Response& response);
 
@@ -473,6 +530,9 @@ private:
   /// used to manage a user request to deactivate the function evaluation
   /// cache (i.e., queries and insertions using the data_pairs cache).
   bool evalCacheFlag;
+  /// evaluation cache implementation: MULTI_INDEX_CACHE (data_pairs) or
+  /// SHARDED_CACHE (sharded_data_pairs)
+  short evalCacheType;
   /// flag indicating optional usage of tolerance-based duplication detection
   /// (less efficient, but helpful when experiencing restart cache misses)
   bool nearbyDuplicateDetect;
@@ -548,6 +608,40 @@ private:
   MPIUnpackBuffer* recvBuffers;
   /// array of requests for nonblocking evaluation receives
   MPI_Request*     recvRequests;
+
+  /// user request for chunked evaluation messages from a dedicated master
+  bool evalChunking;
+  /// maximum number of evaluations per chunked message
+  int evalChunkMax;
+  /// running average of the time per evaluation observed by the chunked
+  /// scheduler (0 until observed), retained across synchronize() calls
+  Real chunkEvalTime;
+  /// pack buffers for chunked messages (two per server), retained across
+  /// synchronize() calls
+  MPIPackBuffer*   chunkSendBuffers;
+  /// unpack buffers for the responses to chunked messages
+  MPIUnpackBuffer* chunkRecvBuffers;
+  /// requests for nonblocking receives of the responses to chunked messages
+  MPI_Request*     chunkRecvRequests;
+  /// number of entries in chunk{Send,Recv}Buffers and chunkRecvRequests
+  size_t numChunkBuffers;
+
+  /// user request for dispatching evaluations longest-predicted-first
+  bool costAwareScheduling;
+  /// predictor of evaluation wall times from the observed evaluations
+  EvaluationRuntimePredictor runtimePredictor;
+  /// start times of the evaluations being timed, by evaluation id
+  IntRealMap evalStartTimes;
+  /// start time, sum of timed evaluation times, and longest timed
+  /// evaluation of the current blocking schedule
+  Real schedStartTime, schedBusyTime, schedLongestTime;
+  /// number of timed evaluations in the current blocking schedule
+  size_t schedTimedEvals;
+  /// number of blocking schedules reported
+  size_t numSchedReports;
+  /// totals over the reported schedules of the makespans, ideal
+  /// makespans, evaluation times and idle server times
+  Real totalMakespan, totalIdealMakespan, totalBusyTime, totalIdleTime;
 };
 
 
@@ -579,6 +673,12 @@ inline void ApplicationInterface::init_serial_analyses()
 // other analysis defaults OK for serial operations
 
 
+/** Servers performing asynchronous local evaluations already overlap
+    their jobs and receive single-evaluation messages. */
+inline bool ApplicationInterface::chunked_messages() const
+{ return evalChunking && ieDedMasterFlag && asynchLocalEvalConcurrency <= 1; }
+
+
 inline int ApplicationInterface::asynch_local_evaluation_concurrency() const
 { return asynchLocalEvalConcurrency; }
 
@@ -655,9 +755,13 @@ send_evaluation(PRPQueueIter& prp_it, size_t buff_index, int server_id,
     //sendBuffers[buff_index].resize(lenVarsActSetMessage); // protected
     recvBuffers[buff_index].resize(lenResponseMessage);
   }
+  int fn_eval_id = prp_it->eval_id();
+  if (!peer_flag && chunked_messages()) { // chunk of one evaluation
+    int num_chunk = 1;
+    sendBuffers[buff_index] << num_chunk << fn_eval_id;
+  }
   sendBuffers[buff_index] << prp_it->variables() << prp_it->active_set();
 
-  int fn_eval_id = prp_it->eval_id();
   if (outputLevel > SILENT_OUTPUT) {
     if (peer_flag) {
       Cout << "Peer 1 assigning ";
@@ -686,6 +790,10 @@ send_evaluation(PRPQueueIter& prp_it, size_t buff_index, int server_id,
   parallelLib.isend_ie(sendBuffers[buff_index], server_id, fn_eval_id,
 		       send_request);
   parallelLib.free(send_request); // no test/wait on send_request
+  // a master sends no more jobs than its servers can start, whereas peer
+  // static schedules queue all jobs at once
+  if (!peer_flag)
+    start_evaluation_timer(fn_eval_id);
 }
 
 
@@ -707,6 +815,7 @@ inline void ApplicationInterface::launch_asynch_local(PRPQueueIter& prp_it)
   if (multiProcEvalFlag)
     broadcast_evaluation(*prp_it);
   // launch non-blocking job
+  start_evaluation_timer(prp_it->eval_id());
   derived_map_asynch(*prp_it);
 
   // Note: for (plug-in) direct interfaces supporting a batch capability,
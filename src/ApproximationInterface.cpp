@@ -293,6 +293,97 @@ map(const Variables& vars, const ActiveSet& set, Response& response,
 }
 
 
+/** Batch mapping is restricted to the core mappings of value and
+    gradient requests with respect to the active continuous variables,
+    for which the result is identical to map() applied per evaluation.
+    Verbose output retains the per-evaluation reporting of map(). */
+bool ApproximationInterface::
+batch_map_available(const Variables& vars, const ActiveSet& set)
+{
+  if (algebraicMappings || !coreMappings || outputLevel > NORMAL_OUTPUT ||
+      vars.view().first != actualModelVars.view().first)
+    return false;
+
+  const ShortArray& asv = set.request_vector();
+  size_t i, num_fns = asv.size();
+  if (num_fns != functionSurfaces.size())
+    return false;
+  bool deriv_flag = false;
+  for (i=0; i<num_fns; ++i)
+    if (asv[i]) {
+      if ( (asv[i] & 4) || !approxFnIndices.count(i) )
+	return false;
+      if (asv[i] & 2)
+	deriv_flag = true;
+    }
+
+  // gradients are evaluated with respect to the active continuous variables
+  if (deriv_flag) {
+    SizetMultiArrayConstView cv_ids = vars.continuous_variable_ids();
+    const SizetArray& dvv = set.derivative_vector();
+    if (dvv.size() != cv_ids.size())
+      return false;
+    for (i=0; i<dvv.size(); ++i)
+      if (dvv[i] != cv_ids[i])
+	return false;
+  }
+  return true;
+}
+
+
+/** Evaluates each requested Approximation over the full batch using
+    its values()/gradients(), which allows vectorized predictors to
+    replace the per-evaluation Variables/Response handling of map().
+    fn_vals is num_fns by num_evals and fn_grads[i] is num_cv by
+    num_evals for each function i with gradient requests.  Evaluation
+    counters are advanced as if map() had been called per column. */
+void ApproximationInterface::
+map_batch(const Variables& vars, const RealMatrix& cv_samples,
+	  const ActiveSet& set, RealMatrix& fn_vals, RealMatrixArray& fn_grads)
+{
+  const ShortArray& asv = set.request_vector();
+  size_t i, num_fns = asv.size();
+  int j, num_cv = cv_samples.numRows(), num_evals = cv_samples.numCols();
+  if (num_fns != functionSurfaces.size() || (size_t)num_cv != vars.cv()) {
+    Cerr << "Error: mismatch in batch dimensions in ApproximationInterface::"
+	 << "map_batch()" << std::endl;
+    abort_handler(-1);
+  }
+
+  if (!evalIdCntr && num_evals)
+    Cout << "Beginning Approximate Fn Evaluations..." << std::endl;
+  evalIdCntr += num_evals; newEvalIdCntr += num_evals;
+  if (fineGrainEvalCounters) { // detailed evaluation reporting
+    init_evaluation_counters(num_fns);
+    for (i=0; i<num_fns; ++i) {
+      short asv_val = asv[i];
+      if (asv_val & 1)
+	{ fnValCounter[i]  += num_evals; newFnValCounter[i]  += num_evals; }
+      if (asv_val & 2)
+	{ fnGradCounter[i] += num_evals; newFnGradCounter[i] += num_evals; }
+    }
+  }
+
+  fn_vals.shape(num_fns, num_evals); // unrequested values are zero
+  fn_grads.resize(num_fns);
+
+  // a single working copy carries the inactive variable values
+  Variables batch_vars = vars.copy();
+  RealVector surf_vals;
+  for (StSIter it=approxFnIndices.begin(); it!=approxFnIndices.end(); ++it) {
+    size_t fn_index = *it;
+    if (asv[fn_index] & 1) {
+      functionSurfaces[fn_index].values(cv_samples, batch_vars, surf_vals);
+      for (j=0; j<num_evals; ++j)
+	fn_vals(fn_index, j) = surf_vals[j];
+    }
+    if (asv[fn_index] & 2)
+      functionSurfaces[fn_index].gradients(cv_samples, batch_vars,
+					   fn_grads[fn_index]);
+  }
+}
+
+
 // Little distinction between blocking and nonblocking synch since all 
 // responses are completed.
 const IntResponseMap& ApproximationInterface::synchronize()
@@ -128,6 +128,11 @@ protected:
 
   const RealVector& approximation_variances(const Variables& vars);
 
+  bool batch_map_available(const Variables& vars, const ActiveSet& set);
+  void map_batch(const Variables& vars, const RealMatrix& cv_samples,
+		 const ActiveSet& set, RealMatrix& fn_vals,
+		 RealMatrixArray& fn_grads);
+
   void discrepancy_emulation_mode(short mode);
 
   bool formulation_updated() const;
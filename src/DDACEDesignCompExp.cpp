@@ -167,7 +167,8 @@ void DDACEDesignCompExp::post_run(std::ostream& s)
                                                         numContinuousVars + numDiscreteIntVars + numDiscreteRealVars,
                                                         numSamples,
                                                         allSamples,
-                                                        allResponses);
+                                                        allResponses,
+                                                        vbdBootstrapSamples);
   }
   else {
     if (mainEffectsFlag) // need allResponses
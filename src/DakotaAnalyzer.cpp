@@ -7,6 +7,7 @@
     For more information, see the README file in the top Dakota directory.
     _______________________________________________________________________ */
 
+#include <algorithm>
 #include <stdexcept>
 #include "dakota_system_defs.hpp"
 #include "dakota_data_io.hpp"
@@ -30,6 +31,8 @@ extern PRPCache data_pairs;
 Analyzer::
 Analyzer(ProblemDescDB& problem_db, Model& model):
   Iterator(BaseConstructor(), problem_db), compactMode(true),
+  streamResponses(false), numLazyParameterSets(0),
+  evaluationWindow(problem_db.get_sizet("method.evaluation_window")),
   numObjFns(0), numLSqTerms(0), // default: no best data tracking
   vbdFlag(problem_db.get_bool("method.variance_based_decomp")),
   writePrecision(problem_db.get_int("environment.output_precision"))
@@ -63,6 +66,7 @@ Analyzer(ProblemDescDB& problem_db, Model& model):
 Analyzer::
 Analyzer(unsigned short method_name, Model& model):
   Iterator(NoDBBaseConstructor(), method_name, model), compactMode(true),
+  streamResponses(false), numLazyParameterSets(0), evaluationWindow(0),
   numObjFns(0), numLSqTerms(0), // default: no best data tracking
   vbdFlag(false), vbdDropTol(-1.),
   writePrecision(0)
@@ -75,6 +79,7 @@ Analyzer::
 Analyzer(unsigned short method_name, Model& model,
 	 const ShortShortPair& view_override):
   Iterator(NoDBBaseConstructor(), method_name, model), compactMode(true),
+  streamResponses(false), numLazyParameterSets(0), evaluationWindow(0),
   numObjFns(0), numLSqTerms(0), // default: no best data tracking
   writePrecision(0)
 {
@@ -86,6 +91,7 @@ Analyzer(unsigned short method_name, Model& model,
 
 Analyzer::Analyzer(unsigned short method_name):
   Iterator(NoDBBaseConstructor(), method_name), compactMode(true),
+  streamResponses(false), numLazyParameterSets(0), evaluationWindow(0),
   numObjFns(0), numLSqTerms(0), // default: no best data tracking
   writePrecision(0)
 { }
@@ -234,25 +240,48 @@ evaluate_parameter_sets(Model& model, bool log_resp_flag, bool log_best_flag)
   // This function does not need an iteratorRep fwd because it is a
   // protected fn only called by letter classes.
 
-  // allVariables or allSamples defines the set of fn evals to be performed
-  size_t i, num_evals
-    = (compactMode) ? allSamples.numCols() : allVariables.size();
+  // allVariables or allSamples defines the set of fn evals to be performed,
+  // unless the parameter sets are generated on demand
+  size_t i, num_evals = num_parameter_sets();
   bool header_flag = (allHeaders.size() == num_evals);
   bool asynch_flag = model.asynch_flag();
 
-  if (!asynch_flag && log_resp_flag) allResponses.clear();
+  // an evaluation window bounds the number of asynchronous evaluations in
+  // flight, and with it the parameter sets and responses held at once;
+  // parameter sets generated on demand are otherwise generated in blocks
+  // only for synchronous evaluation, which is unaffected by the block size
+  size_t block_size = num_evals, block_start = 0,
+    param_start = num_evals; // first parameter set held (on demand)
+  if (asynch_flag) {
+    if (evaluationWindow)
+      block_size = std::min(evaluationWindow, num_evals);
+  }
+  else if (numLazyParameterSets)
+    block_size = std::max((size_t)std::max(model.evaluation_capacity(), 1),
+			  (size_t)1024);
+
+  if (log_resp_flag) allResponses.clear();
+
+  // pure surrogates evaluate blocks of samples with vectorized predictors
+  if (compactMode && !header_flag && samples_active_continuous(model) &&
+      model.batch_evaluation_available(activeSet))
+    { evaluate_sample_batches(model, log_resp_flag, log_best_flag); return; }
+
+  // within an evaluation window, completed evaluations are replaced as
+  // they return rather than as each block completes
+  if (asynch_flag && block_size < num_evals &&
+      nonblocking_synchronize_available(model)) {
+    evaluate_parameter_sets_windowed(model, num_evals, block_size,
+				     log_resp_flag, log_best_flag);
+    return;
+  }
 
   // Loop over parameter sets and compute responses.  Collect data
   // and track best evaluations based on flags.
   for (i=0; i<num_evals; i++) {
-    // output the evaluation header (if present)
-    if (header_flag)
-      Cout << allHeaders[i];
-
-    if (compactMode)
-      update_model_from_sample(model, allSamples[i]);
-    else
-      update_model_from_variables(model, allVariables[i]);
+    // output the evaluation header (if present) and update the model
+    size_t p_index = update_model_from_parameter_set(model, i, num_evals,
+      block_size, param_start, header_flag);
 
     // compute the response
     if (asynch_flag)
@@ -265,35 +294,231 @@ evaluate_parameter_sets(Model& model, bool log_resp_flag, bool log_best_flag)
         update_best(model.current_variables(), eval_id, resp);
       if (log_resp_flag) // log response data
         allResponses[eval_id] = resp.copy();
+      if (streamResponses)
+	accumulate_response(eval_id, resp);
       archive_model_response(resp, i);
     }
 
     archive_model_variables(model, i);
+
+    // synchronize asynchronous evaluations
+    if (asynch_flag &&
+	(i + 1 == num_evals || i + 1 - block_start == block_size)) {
+      process_synchronized_responses(model.synchronize(), block_start,
+				     p_index - (i - block_start), log_resp_flag,
+				     log_best_flag);
+      block_start = i + 1;
+    }
   }
-  // synchronize asynchronous evaluations
-  if (asynch_flag) {
-    const IntResponseMap& resp_map = model.synchronize();
-    if (log_resp_flag) // log response data
-      allResponses = resp_map;
-    if (log_best_flag) { // update best variables/response
-      IntRespMCIter r_cit;
-      if (compactMode)
-        for (i=0, r_cit=resp_map.begin(); r_cit!=resp_map.end(); ++i, ++r_cit)
-          update_best(allSamples[i], r_cit->first, r_cit->second);
-      else
-        for (i=0, r_cit=resp_map.begin(); r_cit!=resp_map.end(); ++i, ++r_cit)
-          update_best(allVariables[i], r_cit->first, r_cit->second);
+}
+
+
+/** Parameter sets are processed in submission order, such that
+    accumulated statistics, best points, and archives are independent
+    of the order of completion: early completions are held until the
+    evaluations submitted before them have returned.  A parameter set
+    occupies a slot of the window until it has been processed, so at
+    most window parameter sets and responses are held at once.  No
+    delay is needed between polls, as the local asynchronous interfaces
+    throttle their nonblocking tests for completions. */
+void Analyzer::
+evaluate_parameter_sets_windowed(Model& model, size_t num_evals, size_t window,
+				 bool log_resp_flag, bool log_best_flag)
+{
+  // pending evaluations keyed by evaluation id, i.e., in submission order;
+  // the parameter set is retained only as needed by update_best()
+  struct PendingEvaluation {
+    size_t index;      ///< index of the parameter set
+    bool complete;     ///< whether the response has been returned
+    Response response; ///< response, once complete
+    RealVector sample; ///< sample for update_best() (compactMode)
+    Variables vars;    ///< variables for update_best() (normal mode)
+  };
+  std::map<int, PendingEvaluation> pending;
+  std::map<int, PendingEvaluation>::iterator p_it;
+  IntRespMCIter r_cit;
+
+  size_t i = 0, num_processed = 0, param_start = num_evals;
+  bool header_flag = (allHeaders.size() == num_evals);
+  while (num_processed < num_evals) {
+    // top up the window
+    for (; i<num_evals && pending.size()<window; ++i) {
+      size_t p_index = update_model_from_parameter_set(model, i, num_evals,
+	window, param_start, header_flag);
+      model.evaluate_nowait(activeSet);
+      PendingEvaluation& pe = pending[model.evaluation_id()];
+      pe.index = i; pe.complete = false;
+      if (log_best_flag) {
+	if (compactMode)
+	  pe.sample = RealVector(Teuchos::Copy, allSamples[p_index],
+				 allSamples.numRows());
+	else
+	  pe.vars = allVariables[p_index].copy();
+      }
+      archive_model_variables(model, i);
+    }
+
+    // collect completions without blocking, buffering those that return
+    // ahead of earlier submissions
+    const IntResponseMap& resp_map = model.synchronize_nowait();
+    for (r_cit=resp_map.begin(); r_cit!=resp_map.end(); ++r_cit) {
+      p_it = pending.find(r_cit->first);
+      if (p_it != pending.end())
+	{ p_it->second.response = r_cit->second; p_it->second.complete = true; }
+    }
+
+    // process completions in submission order, freeing their slots
+    while (!pending.empty() && pending.begin()->second.complete) {
+      p_it = pending.begin();
+      int eval_id = p_it->first;  const PendingEvaluation& pe = p_it->second;
+      if (log_resp_flag) // log response data
+	allResponses[eval_id] = pe.response;
+      if (log_best_flag) { // update best variables/response
+	if (compactMode) update_best(pe.sample.values(), eval_id, pe.response);
+	else             update_best(pe.vars,            eval_id, pe.response);
+      }
+      if (streamResponses)
+	accumulate_response(eval_id, pe.response);
+      if (resultsDB.active())
+	archive_model_response(pe.response, pe.index);
+      pending.erase(p_it); ++num_processed;
+    }
+  }
+}
+
+
+/** Synchronize_nowait() is unavailable with finite difference
+    derivative estimation and for nested models (which synchronize
+    their sub-iterators in blocks); an evaluation window then
+    synchronizes its evaluations in blocks of the window size. */
+bool Analyzer::nonblocking_synchronize_available(Model& model)
+{
+  if (model.derivative_estimation() || model.model_type() == "nested")
+    return false;
+  ModelList& sub_models = model.subordinate_models(true);
+  for (ModelLIter ml_it=sub_models.begin(); ml_it!=sub_models.end(); ++ml_it)
+    if (ml_it->model_type() == "nested")
+      return false;
+  return true;
+}
+
+
+/** When parameter sets are generated on demand, the next block of
+    block_size parameter sets is generated upon reaching its first
+    index; param_start tracks the index of the first parameter set held
+    (num_evals before any are generated).  Returns the position of
+    parameter set i within allSamples or allVariables. */
+size_t Analyzer::
+update_model_from_parameter_set(Model& model, size_t i, size_t num_evals,
+				size_t block_size, size_t& param_start,
+				bool& header_flag)
+{
+  size_t p_index = i;
+  if (numLazyParameterSets) {
+    if (param_start > i || i - param_start >= block_size) {
+      size_t num_block = std::min(block_size, num_evals - i);
+      get_parameter_set_block(model, i, num_block);
+      header_flag = (allHeaders.size() == num_block);
+      param_start = i;
     }
-    if (resultsDB.active()) {
-      IntRespMCIter r_cit;
-      for(r_cit=resp_map.begin(); r_cit!=resp_map.end(); ++r_cit)
-        archive_model_response(r_cit->second,
-			       std::distance(resp_map.begin(), r_cit));
+    p_index = i - param_start;
+  }
+
+  // output the evaluation header (if present)
+  if (header_flag)
+    Cout << allHeaders[p_index];
+
+  if (compactMode)
+    update_model_from_sample(model, allSamples[p_index]);
+  else
+    update_model_from_variables(model, allVariables[p_index]);
+  return p_index;
+}
+
+
+void Analyzer::
+evaluate_sample_batches(Model& model, bool log_resp_flag, bool log_best_flag)
+{
+  // block size bounds the memory of the batch data and predictor workspace
+  const size_t block_size = 4096;
+  size_t i, j, start, num_block, num_evals = num_parameter_sets(),
+    num_cv = allSamples.numRows(), col;
+  const ShortArray& asv = activeSet.request_vector();
+  size_t num_fns = asv.size();
+
+  Response resp = model.current_response().copy();
+  resp.active_set(activeSet);
+  RealMatrix fn_vals;  RealMatrixArray fn_grads;
+  for (start=0; start<num_evals; start+=num_block) {
+    num_block = std::min(block_size, num_evals - start);
+    // parameter sets generated on demand occupy the leading columns
+    col = start;
+    if (numLazyParameterSets)
+      { get_parameter_set_block(model, start, num_block); col = 0; }
+    RealMatrix cv_block(Teuchos::View, allSamples, num_cv, num_block, 0, col);
+    int eval_id = model.evaluation_id();
+    model.evaluate_batch(cv_block, activeSet, fn_vals, fn_grads);
+
+    for (j=0; j<num_block; ++j) {
+      ++eval_id;
+      for (i=0; i<num_fns; ++i) {
+	if (asv[i] & 1)
+	  resp.function_value(fn_vals(i, j), i);
+	if (asv[i] & 2)
+	  resp.function_gradient(
+	    Teuchos::getCol(Teuchos::View, fn_grads[i], (int)j), i);
+      }
+      if (log_best_flag) // update best variables/response
+	update_best(allSamples[col+j], eval_id, resp);
+      if (log_resp_flag) // log response data
+	allResponses[eval_id] = resp.copy();
+      if (streamResponses)
+	accumulate_response(eval_id, resp);
+      archive_model_response(resp, start+j);
     }
   }
 }
 
 
+void Analyzer::
+process_synchronized_responses(const IntResponseMap& resp_map, size_t start,
+			       size_t p_start, bool log_resp_flag,
+			       bool log_best_flag)
+{
+  IntRespMCIter r_cit;
+  size_t i;
+  if (log_resp_flag) // log response data
+    allResponses.insert(resp_map.begin(), resp_map.end());
+  if (log_best_flag) { // update best variables/response
+    if (compactMode)
+      for (i=p_start, r_cit=resp_map.begin(); r_cit!=resp_map.end();
+	   ++i, ++r_cit)
+	update_best(allSamples[i], r_cit->first, r_cit->second);
+    else
+      for (i=p_start, r_cit=resp_map.begin(); r_cit!=resp_map.end();
+	   ++i, ++r_cit)
+	update_best(allVariables[i], r_cit->first, r_cit->second);
+  }
+  if (streamResponses)
+    for (r_cit=resp_map.begin(); r_cit!=resp_map.end(); ++r_cit)
+      accumulate_response(r_cit->first, r_cit->second);
+  if (resultsDB.active())
+    for (i=start, r_cit=resp_map.begin(); r_cit!=resp_map.end(); ++i, ++r_cit)
+      archive_model_response(r_cit->second, i);
+}
+
+
+/** Derived classes that set numLazyParameterSets redefine this to
+    generate their design in blocks. */
+void Analyzer::
+get_parameter_set_block(Model& model, size_t start, size_t num_sets)
+{
+  Cerr << "Error: derived class does not redefine get_parameter_set_block() "
+       << "for parameter sets\n       generated on demand." << std::endl;
+  abort_handler(METHOD_ERROR);
+}
+
+
 void Analyzer::update_model_from_variables(Model& model, const Variables& vars)
 {
   // default implementation is sufficient in current uses, but could
@@ -448,7 +673,7 @@ void Analyzer::pre_output()
     return;
   }
 
-  size_t num_evals = compactMode ? allSamples.numCols() : allVariables.size();
+  size_t num_evals = num_parameter_sets();
   if (num_evals == 0) {
     if (outputLevel > QUIET_OUTPUT)
       Cout << "\nPre-run phase complete: no variables to output.\n"
@@ -483,9 +708,19 @@ void Analyzer::pre_output()
   tabular_file << std::setprecision(write_precision) 
 	       << std::resetiosflags(std::ios::floatfield);
 
+  // parameter sets generated on demand are written in blocks
+  const size_t lazy_block_size = 1024;
   Variables vars = iteratedModel.current_variables().copy();
   for (size_t eval_index = 0; eval_index < num_evals; eval_index++) {
 
+    size_t p_index = eval_index;
+    if (numLazyParameterSets) {
+      p_index = eval_index % lazy_block_size;
+      if (p_index == 0)
+	get_parameter_set_block(iteratedModel, eval_index,
+	  std::min(lazy_block_size, num_evals - eval_index));
+    }
+
     TabularIO::write_leading_columns(tabular_file, eval_index+1, 
 				     iteratedModel.interface_id(),
 				     tabular_format);
@@ -493,11 +728,11 @@ void Analyzer::pre_output()
       // allSamples num_vars x num_evals, so each col becomes tabular file row
       // populate the active discrete variables that aren't in sample_matrix
       size_t num_vars = allSamples.numRows();
-      sample_to_variables(allSamples[eval_index], vars);
+      sample_to_variables(allSamples[p_index], vars);
       vars.write_tabular(tabular_file);
     }
     else
-      allVariables[eval_index].write_tabular(tabular_file);
+      allVariables[p_index].write_tabular(tabular_file);
     // no response data, so terminate the record
     tabular_file << '\n';
   }
@@ -88,11 +88,21 @@ protected:
   virtual void update_model_from_sample(Model& model, const Real* sample_vars);
   /// update model's current variables with data from vars
   virtual void update_model_from_variables(Model& model, const Variables& vars);
+  /// whether each column of allSamples holds exactly the active
+  /// continuous variables of model, permitting Model::evaluate_batch()
+  virtual bool samples_active_continuous(const Model& model) const;
 
   /// convert column of samples array to variables; derived classes
   /// may reimplement for more than active continuous variables
   virtual void sample_to_variables(const Real* sample_vars, Variables& vars);
 
+  /// generate parameter sets [start, start + num_sets) of a design
+  /// generated on demand (see numLazyParameterSets), populating the
+  /// leading num_sets columns of allSamples (compactMode) or entries
+  /// of allVariables (and allHeaders, if used)
+  virtual void get_parameter_set_block(Model& model, size_t start,
+				       size_t num_sets);
+
   //
   //- Heading: Virtual member function redefinitions
   //
@@ -132,6 +142,9 @@ protected:
   /// generate replicate parameter sets for use in variance-based decomposition
   void get_vbd_parameter_sets(Model& model, size_t num_samples);
 
+  /// number of parameter sets evaluated by evaluate_parameter_sets()
+  size_t num_parameter_sets() const;
+
   /// archive model evaluation points
   virtual void archive_model_variables(const Model&, size_t idx) const
     { /* no-op */ }
@@ -140,6 +153,11 @@ protected:
   virtual void archive_model_response(const Response&, size_t idx) const
     { /* no-op */ }
 
+  /// accumulate statistics from a completed evaluation (used when
+  /// streamResponses is set)
+  virtual void accumulate_response(int eval_id, const Response& resp)
+    { /* no-op */ }
+
   /// convenience function for reading variables/responses (used in
   /// derived classes post_input)
   void read_variables_responses(int num_evals, size_t num_vars);
@@ -176,6 +194,17 @@ protected:
   IntResponseMap allResponses;
   /// array of headers to insert into output while evaluating allVariables
   StringArray allHeaders;
+  /// pass each response to accumulate_response() as evaluations complete
+  /// (in submission order), in place of retaining allResponses
+  bool streamResponses;
+  /// number of parameter sets generated in blocks by
+  /// get_parameter_set_block() as evaluate_parameter_sets() proceeds, in
+  /// place of populating allSamples/allVariables up front (0 if unused)
+  size_t numLazyParameterSets;
+  /// maximum number of asynchronous evaluations in flight within
+  /// evaluate_parameter_sets(), which replaces each as it completes
+  /// (from the evaluation_window specification; 0 if unbounded)
+  size_t evaluationWindow;
 
   // Data needed for update_best() so that param studies can be used in
   // strategies such as MultilevelOptStrategy
@@ -203,6 +232,33 @@ private:
   /// layer a RecastModel on top of iteratedModel to enact a view override
   void recast_model_view(const ShortShortPair& view_override);
 
+  /// evaluate allSamples in blocks using Model::evaluate_batch(), with
+  /// the same logging, accumulation and archiving as per-point evaluation
+  void evaluate_sample_batches(Model& model, bool log_resp_flag,
+			       bool log_best_flag);
+
+  /// evaluate parameter sets asynchronously, keeping at most window of
+  /// them in flight and refilling via Model::synchronize_nowait()
+  void evaluate_parameter_sets_windowed(Model& model, size_t num_evals,
+					size_t window, bool log_resp_flag,
+					bool log_best_flag);
+  /// whether model supports Model::synchronize_nowait()
+  bool nonblocking_synchronize_available(Model& model);
+  /// output the header of parameter set i and update model with it,
+  /// generating parameter sets on demand; returns its position within
+  /// allSamples or allVariables
+  size_t update_model_from_parameter_set(Model& model, size_t i,
+					 size_t num_evals, size_t block_size,
+					 size_t& param_start,
+					 bool& header_flag);
+
+  /// log, accumulate, and archive a block of synchronized responses
+  /// corresponding to parameter sets [start, start + resp_map.size()),
+  /// held from position p_start of allSamples or allVariables
+  void process_synchronized_responses(const IntResponseMap& resp_map,
+				      size_t start, size_t p_start,
+				      bool log_resp_flag, bool log_best_flag);
+
   /// compares current evaluation to best evaluation and updates best
   void compute_best_metrics(const Response& response,
 			    std::pair<Real,Real>& metrics);
@@ -222,13 +278,26 @@ private:
 };
 
 
-inline Analyzer::Analyzer()
+inline Analyzer::Analyzer(): numLazyParameterSets(0)
 { }
 
 
 inline Analyzer::~Analyzer() { }
 
 
+/** Only samplers that map samples directly to the active continuous
+    variables redefine this to enable batch evaluation. */
+inline bool Analyzer::samples_active_continuous(const Model& model) const
+{ return false; }
+
+
+inline size_t Analyzer::num_parameter_sets() const
+{
+  if (numLazyParameterSets) return numLazyParameterSets;
+  return (compactMode) ? allSamples.numCols() : allVariables.size();
+}
+
+
 /** Return current number of evaluation points.  Since the calculation
     of samples, collocation points, etc. might be costly, provide a default
     implementation here that backs out from the maxEvalConcurrency. */
@@ -823,6 +823,47 @@ Real Approximation::prediction_variance(const RealVector& c_vars)
 }
 
 
+/** Default implementation evaluates value() point by point, reusing
+    vars; letters with vectorized predictors redefine it. */
+void Approximation::
+values(const RealMatrix& cv_points, Variables& vars, RealVector& vals)
+{
+  if (approxRep)
+    { approxRep->values(cv_points, vars, vals); return; }
+
+  int j, num_cv = cv_points.numRows(), num_pts = cv_points.numCols();
+  if (vals.length() != num_pts)
+    vals.sizeUninitialized(num_pts);
+  for (j=0; j<num_pts; ++j) {
+    RealVector cv_j(Teuchos::View, const_cast<Real*>(cv_points[j]), num_cv);
+    vars.continuous_variables(cv_j);
+    vals[j] = value(vars);
+  }
+}
+
+
+/** Default implementation evaluates gradient() point by point, reusing
+    vars; letters with vectorized predictors redefine it. */
+void Approximation::
+gradients(const RealMatrix& cv_points, Variables& vars, RealMatrix& grads)
+{
+  if (approxRep)
+    { approxRep->gradients(cv_points, vars, grads); return; }
+
+  int i, j, num_cv = cv_points.numRows(), num_pts = cv_points.numCols();
+  if (grads.numRows() != num_cv || grads.numCols() != num_pts)
+    grads.shapeUninitialized(num_cv, num_pts);
+  for (j=0; j<num_pts; ++j) {
+    RealVector cv_j(Teuchos::View, const_cast<Real*>(cv_points[j]), num_cv);
+    vars.continuous_variables(cv_j);
+    const RealVector& grad_j = gradient(vars);
+    Real* grads_j = grads[j];
+    for (i=0; i<num_cv; ++i)
+      grads_j[i] = grad_j[i];
+  }
+}
+
+
 bool Approximation::advancement_available()
 {
   if (approxRep) return approxRep->advancement_available();
@@ -127,6 +127,16 @@ public:
   /// retrieve the variance of the predicted value for a given parameter vector
   virtual Real prediction_variance(const RealVector& c_vars);
 
+  /// retrieve the approximate function values for a batch of points, each
+  /// column of cv_points defining the active continuous variables; vars
+  /// supplies the remaining variable values and is updated in the process
+  virtual void values(const RealMatrix& cv_points, Variables& vars,
+		      RealVector& vals);
+  /// retrieve the approximate function gradients (one column per point)
+  /// for a batch of points defined as in values()
+  virtual void gradients(const RealMatrix& cv_points, Variables& vars,
+			 RealMatrix& grads);
+
   /// return the mean of the expansion, where all active vars are random
   virtual Real mean();
   /// return the mean of the expansion for a given parameter vector,
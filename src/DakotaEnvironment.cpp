@@ -14,6 +14,7 @@
 #include "ProblemDescDB.hpp"
 #include "IteratorScheduler.hpp"
 #include "dakota_preproc_util.hpp"
+#include "WorkStealingThreadPool.hpp"
 
 static const char rcsId[]="@(#) $Id: DakotaEnvironment.cpp 6749 2010-05-03 17:11:57Z briadam $";
 
@@ -302,6 +303,9 @@ void Environment::construct()
   // user might have requested output/error redirection in environment block;
   // check and update redirects
   outputManager.parse(programOptions, probDescDB);
+  // threads shared by the threaded numerical kernels (serial by default)
+  dakota::util::WorkStealingThreadPool::
+    kernel_concurrency(probDescDB.get_int("environment.kernel_threads"));
 
   // With respect to Environment interaction with the probDescDB linked lists,
   // the current design allows the user to either fully specify the method to
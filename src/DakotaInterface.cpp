@@ -478,10 +478,30 @@ print_evaluation_summary(std::ostream& s, bool minimal_header,
 	  << t_h << " Hess (" << n_h << " n, " << t_h - n_h << " d)\n";
       }
     }
+
+    // cache, scheduling, and staging statistics, if tracked by the
+    // derived interface
+    if (!minimal_header) {
+      print_cache_summary(s);
+      print_scheduling_summary(s);
+      print_workdir_summary(s);
+    }
   }
 }
 
 
+void Interface::print_cache_summary(std::ostream& s) const
+{ } // default: no cache statistics
+
+
+void Interface::print_scheduling_summary(std::ostream& s) const
+{ } // default: no scheduling statistics
+
+
+void Interface::print_workdir_summary(std::ostream& s) const
+{ } // default: no work directory staging statistics
+
+
 /// default implementation just sets the list of eval ID tags;
 /// derived classes containing additional models or interfaces should
 /// override (currently no use cases)
@@ -1454,6 +1474,31 @@ const RealVector& Interface::approximation_variances(const Variables& vars)
 }
 
 
+bool Interface::batch_map_available(const Variables& vars, const ActiveSet& set)
+{
+  if (interfaceRep) // envelope fwd to letter
+    return interfaceRep->batch_map_available(vars, set);
+  else // default if no letter redefinition of virtual fn.
+    return false;
+}
+
+
+void Interface::
+map_batch(const Variables& vars, const RealMatrix& cv_samples,
+	  const ActiveSet& set, RealMatrix& fn_vals, RealMatrixArray& fn_grads)
+{
+  if (!interfaceRep) { // letter lacking redefinition of virtual fn.
+    Cerr << "Error: Letter lacking redefinition of virtual map_batch function."
+	 << "\n       This interface does not support batch evaluation."
+	 << std::endl;
+    abort_handler(-1);
+  }
+
+  // envelope fwd to letter
+  interfaceRep->map_batch(vars, cv_samples, set, fn_vals, fn_grads);
+}
+
+
 const StringArray& Interface::analysis_drivers() const
 {
   if (!interfaceRep) { // letter lacking redefinition of virtual fn.
@@ -232,6 +232,17 @@ public:
   /// within an ApproximationInterface
   virtual const RealVector& approximation_variances(const Variables& vars);
 
+  /// whether map_batch() can evaluate the ActiveSet over batches of
+  /// active continuous variable values for vars
+  virtual bool batch_map_available(const Variables& vars,
+				   const ActiveSet& set);
+  /// map a batch of active continuous variable values (one column of
+  /// cv_samples per evaluation) to function values (one column per
+  /// evaluation) and gradients (one matrix per function) in a single call
+  virtual void map_batch(const Variables& vars, const RealMatrix& cv_samples,
+			 const ActiveSet& set, RealMatrix& fn_vals,
+			 RealMatrixArray& fn_grads);
+
   /// retrieve the analysis drivers specification for application interfaces
   virtual const StringArray& analysis_drivers() const;
   /// retrieve the analysis components, if available
@@ -352,6 +363,16 @@ protected:
   /// form and return the final evaluation ID tag, appending iface ID if needed
   virtual String final_eval_id_tag(int fn_eval_id);
 
+  /// print evaluation cache statistics as part of
+  /// print_evaluation_summary(); default is no output
+  virtual void print_cache_summary(std::ostream& s) const;
+  /// print evaluation scheduling statistics as part of
+  /// print_evaluation_summary(); default is no output
+  virtual void print_scheduling_summary(std::ostream& s) const;
+  /// print work directory staging statistics as part of
+  /// print_evaluation_summary(); default is no output
+  virtual void print_workdir_summary(std::ostream& s) const;
+
   //
   //- Heading: Data
   //
@@ -1082,6 +1082,7 @@ void Iterator::run()
     if (summaryOutputFlag)
       Cout << "\n<<<<< Iterator " << method_string <<" completed.\n";
     finalize_run();
+    evaluationsDB.flush(); // commit buffered evaluations ahead of file flush
     resultsDB.flush();
   }
 }
@@ -21,6 +21,7 @@
 #include "ScalingModel.hpp"
 #include "Teuchos_SerialDenseHelpers.hpp"
 #include "ExperimentData.hpp"
+#include "PRPShardedCache.hpp"
 
 #ifdef __SUNPRO_CC
 #include <math.h>  // for std::log
@@ -31,8 +32,6 @@ static const char rcsId[]="@(#) $Id: DakotaMinimizer.cpp 7029 2010-10-22 00:17:0
 
 namespace Dakota {
 
-extern PRPCache data_pairs; // global container
-
 // initialization of static needed by RecastModel
 Minimizer* Minimizer::minimizerInstance(NULL);
 
@@ -697,8 +696,8 @@ objective_hessian(const RealVector& fn_vals, size_t num_fns,
 /** Lookup evaluation id where best occurred.  This cannot be
     catalogued directly because the optimizers track the best iterate
     internally and return the best results after iteration completion.
-    Therfore, perform a search in data_pairs to extract the evalId for
-    the best fn eval. */
+    Therfore, perform a search in the evaluation cache to extract the
+    evalId for the best fn eval. */
 void Minimizer::print_best_eval_ids(const String& search_interface_id,
 				    const Variables& search_vars,
 				    const ActiveSet& search_set,
@@ -713,23 +712,18 @@ void Minimizer::print_best_eval_ids(const String& search_interface_id,
     id_full_na = "<<<<< Best evaluation ID (full match) not available\n",
     id_warning = "(This warning may occur when the best iterate is comprised of multiple interface\nevaluations or arises from a composite, surrogate, or transformation model.)\n";
 
-  PRPCacheHIter cache_it =
-    lookup_by_val(data_pairs, search_interface_id, search_vars, search_set);
-  if (cache_it == data_pairs.get<hashed>().end()) {
+  ParamResponsePair cache_pr;
+  if (!lookup_evaluation(search_interface_id, search_vars, search_set,
+			 cache_pr)) {
 
     // no exact match; try to match only vars/interface ID via hash
     // (don't check search_set)
-    Response search_resp(SIMULATION_RESPONSE, search_set);
-    ParamResponsePair search_pr(search_vars, search_interface_id, search_resp);
-    PRPCacheHIter prp_hash_it0, prp_hash_it1;
-    boost::tuples::tie(prp_hash_it0, prp_hash_it1)
-      = data_pairs.get<hashed>().equal_range(search_pr);
+    PRPArray partial_prps;
+    lookup_evaluations(search_interface_id, search_vars, partial_prps);
 
     std::set<int> sorted_eval_ids; // in case hash isn't in eval ID order
-    while (prp_hash_it0 != prp_hash_it1) {
-      sorted_eval_ids.insert(prp_hash_it0->eval_id());
-      ++prp_hash_it0;
-    }
+    for (size_t i=0; i<partial_prps.size(); ++i)
+      sorted_eval_ids.insert(partial_prps[i].eval_id());
 
     if (sorted_eval_ids.empty())
       s << id_na << id_warning;
@@ -747,7 +741,7 @@ void Minimizer::print_best_eval_ids(const String& search_interface_id,
     }
   }
   else {
-    int eval_id = cache_it->eval_id();
+    int eval_id = cache_pr.eval_id();
     if (eval_id > 0)
       s << best_id << eval_id << '\n';
     else // should not occur
@@ -1195,15 +1189,12 @@ void Minimizer::archive_best_results()
   for(i=0; i < num_best; ++i) {
     // lookup evaluation id where best occurred.  This cannot be catalogued
     // directly because the optimizers track the best iterate internally and
-    // return the best results after iteration completion.  Therfore, perform a
-    // search in data_pairs to extract the evalId for the best fn eval.
+    // return the best results after iteration completion.  Therfore, search
+    // the evaluation cache to extract the evalId for the best fn eval.
     const Variables& best_vars = bestVariablesArray[i];
-    PRPCacheHIter cache_it = lookup_by_val(data_pairs, interface_id,
-                                           best_vars, search_set);
-    if (cache_it == data_pairs.get<hashed>().end()) 
-      eval_id = 0;
-    else 
-      eval_id = cache_it->eval_id();
+    ParamResponsePair cache_pr;
+    eval_id = (lookup_evaluation(interface_id, best_vars, search_set, cache_pr))
+      ? cache_pr.eval_id() : 0;
     AttributeArray attrs = {ResultAttribute<int>("evaluation_id", eval_id)};
     if(num_best > 1) {
       location[0] = set_string+std::to_string(i+1);
@@ -1215,7 +1206,7 @@ void Minimizer::archive_best_results()
 
 
 /** Retrieve a MOO/NLS response based on the data returned by a single
-    objective optimizer by performing a data_pairs search. This may
+    objective optimizer by performing an evaluation cache search. This may
     get called even for a single user-specified function, since we may
     be recasting a single NLS residual into a squared
     objective. Always returns best data in the space of the original
@@ -1226,14 +1217,14 @@ local_recast_retrieve(const Variables& vars, Response& response) const
   // TODO: could omit constraints for solvers populating them (there
   // may not exist a single DB eval with both functions, constraints)
   ActiveSet lookup_set(response.active_set());
-  PRPCacheHIter cache_it
-    = lookup_by_val(data_pairs, iteratedModel.interface_id(), vars, lookup_set);
-  if (cache_it == data_pairs.get<hashed>().end()) {
+  ParamResponsePair cache_pr;
+  if (!lookup_evaluation(iteratedModel.interface_id(), vars, lookup_set,
+			 cache_pr)) {
     Cerr << "Warning: failure in recovery of final values for locally recast "
 	 << "optimization." << std::endl;
     return false;
   }    
-  response.update(cache_it->response());
+  response.update(cache_pr.response());
   return true;
 }
 
@@ -10,7 +10,7 @@
 #include "dakota_system_defs.hpp"
 #include "DakotaModel.hpp"
 #include "ParamResponsePair.hpp"
-#include "PRPMultiIndex.hpp"
+#include "PRPShardedCache.hpp"
 #include "ParallelLibrary.hpp"
 #include "ProblemDescDB.hpp"
 #include "SimulationModel.hpp"
@@ -30,7 +30,6 @@ static const char rcsId[]="@(#) $Id: DakotaModel.cpp 7029 2010-10-22 00:17:02Z m
 
 namespace Dakota 
 {
-extern PRPCache        data_pairs;
 extern EvaluationStore evaluation_store_db; // defined in dakota_global_defs.cpp
 
 // These globals defined here rather than in dakota_global_defs.cpp in order to
@@ -1729,7 +1728,7 @@ estimate_derivatives(const ShortArray& map_asv, const ShortArray& fd_grad_asv,
   ActiveSet new_set(map_asv, orig_dvv);
   Response initial_map_response(currentResponse.shared_data(), new_set);
 
-  // The logic for incurring an additional data_pairs search (beyond the
+  // The logic for incurring an additional evaluation cache search (beyond the
   // existing duplicate detection) is that a data request contained in
   // orig_asv is most likely not a duplicate, but there is a good chance
   // that an augmented data reqmt (appears in map_asv but not in orig_asv)
@@ -4423,6 +4422,31 @@ const RealVector& Model::approximation_variances(const Variables& vars)
 }
 
 
+bool Model::batch_evaluation_available(const ActiveSet& set)
+{
+  if (modelRep) // envelope fwd to letter
+    return modelRep->batch_evaluation_available(set);
+  else // default if no letter redefinition of virtual fn.
+    return false;
+}
+
+
+void Model::
+evaluate_batch(const RealMatrix& cv_samples, const ActiveSet& set,
+	       RealMatrix& fn_vals, RealMatrixArray& fn_grads)
+{
+  if (!modelRep) { // letter lacking redefinition of virtual fn.
+    Cerr << "Error: Letter lacking redefinition of virtual evaluate_batch"
+	 << "() function.\nThis model does not support batch evaluation."
+	 << std::endl;
+    abort_handler(MODEL_ERROR);
+  }
+
+  // envelope fwd to letter
+  modelRep->evaluate_batch(cv_samples, set, fn_vals, fn_grads);
+}
+
+
 const RealVector& Model::error_estimates()
 {
   if (!modelRep) { // letter lacking redefinition of virtual fn.
@@ -6034,11 +6058,10 @@ bool Model::db_lookup(const Variables& search_vars, const ActiveSet& search_set,
     // cases where response is generated by a single non-approximate interface
     // at this level.  For Nested and Surrogate models, duplication detection
     // must occur at a lower level.
-    PRPCacheHIter cache_it
-      = lookup_by_val(data_pairs, interface_id(), search_vars, search_set);
-    if (cache_it != data_pairs.get<hashed>().end()) {
+    ParamResponsePair cache_pr;
+    if (lookup_evaluation(interface_id(), search_vars, search_set, cache_pr)) {
       found_resp.active_set(search_set);
-      found_resp.update(cache_it->response(), true); // update metadata
+      found_resp.update(cache_pr.response(), true); // update metadata
       return true;
     }
     return false;
@@ -6130,6 +6153,18 @@ void Model::evaluate(const RealMatrix& samples_matrix,
 {
   // TODO: option for setting its active or inactive variables
 
+  // pure surrogate models may evaluate all columns in one batch
+  if ( (size_t)samples_matrix.numRows() == model.cv() && !model.div() &&
+       !model.dsv() && !model.drv() ) {
+    ActiveSet set = model.current_response().active_set(); // copy
+    set.request_values(1); // function values only, as in evaluate()
+    if (model.batch_evaluation_available(set)) {
+      RealMatrixArray fn_grads;
+      model.evaluate_batch(samples_matrix, set, resp_matrix, fn_grads);
+      return;
+    }
+  }
+
   RealMatrix::ordinalType i, num_evals = samples_matrix.numCols();
   resp_matrix.shape(model.response_size(), num_evals);
 
@@ -389,6 +389,17 @@ public:
   /// a DataFitSurrModel
   virtual const RealVector& approximation_variances(const Variables& vars);
 
+  /// whether evaluate_batch() can compute the ActiveSet over batches of
+  /// active continuous variable values, bypassing per-point evaluate()
+  virtual bool batch_evaluation_available(const ActiveSet& set);
+  /// evaluate the Model at each column of cv_samples (active continuous
+  /// variables, with the remaining variables from currentVariables),
+  /// returning function values as columns of fn_vals and gradients
+  /// (num_cv by num_evals) per function in fn_grads
+  virtual void evaluate_batch(const RealMatrix& cv_samples,
+			      const ActiveSet& set, RealMatrix& fn_vals,
+			      RealMatrixArray& fn_grads);
+
   /// set response computation mode used in SurrogateModels for
   /// forming currentResponse
   virtual void surrogate_response_mode(short mode);
@@ -27,7 +27,8 @@ PStudyDACE::PStudyDACE(ProblemDescDB& problem_db, Model& model):
   Analyzer(problem_db, model),
   volQualityFlag(probDescDB.get_bool("method.quality_metrics")),
   vbdViaSamplingMethod(probDescDB.get_ushort("method.vbd_via_sampling_method")),
-  vbdViaSamplingNumBins(probDescDB.get_int("method.vbd_via_sampling_num_bins"))
+  vbdViaSamplingNumBins(probDescDB.get_int("method.vbd_via_sampling_num_bins")),
+  vbdBootstrapSamples(probDescDB.get_int("method.vbd_bootstrap_samples"))
 {
   // Check for discrete variable types
   if ( (numDiscreteIntVars || numDiscreteRealVars) &&
@@ -74,6 +74,10 @@ protected:
   /// number of bins for using with the Mahadevan sampling method for computing variance-based decomposition indices
   int vbdViaSamplingNumBins;
 
+  /// number of bootstrap resamples for confidence intervals on
+  /// pick-and-freeze variance-based decomposition indices
+  int vbdBootstrapSamples;
+
 private:
 
   //
@@ -13,7 +13,10 @@
 #include "DakotaVariables.hpp"
 #include "ProblemDescDB.hpp"
 #include "dakota_data_io.hpp"
+#include "ResultsFileTokenizer.hpp"
+#include "dakota_binary_files.h"
 #include <algorithm>
+#include <cctype>
 #include <sstream>
 #include <boost/archive/binary_oarchive.hpp>
 #include <boost/archive/binary_iarchive.hpp>
@@ -363,12 +366,31 @@ void Response::copy_rep(std::shared_ptr<Response> source_resp_rep)
 
 /** ASCII version of read needs capabilities for capturing data omissions or
     formatting errors (resulting from user error or asynch race condition) and
-    analysis failures (resulting from nonconvergence, instability, etc.). */
+    analysis failures (resulting from nonconvergence, instability, etc.).
+    The remainder of the stream is transferred to memory in one bulk read
+    and parsed there. */
 void Response::read(std::istream& s, const unsigned short format)
+{
+  String buffer;
+  ResultsFileTokenizer::slurp(s, buffer);
+  read(buffer, format);
+}
+
+
+/** Parses results file content held in memory.  Tokens are not copied
+    and values are converted in place, so that the cost of reading large
+    field responses and their gradients is dominated by the number
+    conversions rather than by per-token allocations. */
+void Response::read(const String& buffer, const unsigned short format)
 {
   // if envelope, forward to letter
   if (responseRep)
-    { responseRep->read(s,format); return; }
+    { responseRep->read(buffer,format); return; }
+
+  if (format == BINARY_RESULTS)
+    { read_binary(buffer); return; }
+
+  ResultsFileTokenizer s(buffer);
 
   // If a failure is detected, throw an error
   if (failure_reported(s)) 
@@ -387,11 +409,11 @@ void Response::read(std::istream& s, const unsigned short format)
 }
 
 
-void Response::read_core(std::istream& s, const unsigned short format,
+void Response::read_core(ResultsFileTokenizer& s, const unsigned short format,
 			 std::ostringstream& errors)
 {
   // std::function is overkill, but perhaps clearer than bind or lambda
-  std::function<void(Response&, std::istream& s, const ShortArray &asv,
+  std::function<void(Response&, ResultsFileTokenizer& s, const ShortArray &asv,
 		     size_t, std::ostringstream &errors)> value_reader;
   switch(format) { // future formats go here
     case FLEXIBLE_RESULTS:
@@ -429,25 +451,46 @@ bool Response::expect_derivatives(const ShortArray& asv){
 }
 
 
-void Response::read_labeled_fn_vals(std::istream& s, const ShortArray &asv, 
-          size_t num_metadata, std::ostringstream &errors) {
-  const StringArray fn_labels = sharedRespData.function_labels();
+void Response::read_labeled_fn_vals(ResultsFileTokenizer& s,
+          const ShortArray &asv, size_t num_metadata,
+          std::ostringstream &errors) {
+  const StringArray& fn_labels = sharedRespData.function_labels();
+  const StringArray& md_labels = sharedRespData.metadata_labels();
   const size_t nf = asv.size();
-  // "metadata" for each expected response. First item is the index
-  // in asv; second item is whether response has been encountered in s
-  typedef std::pair<size_t, bool> Rmeta;
-  // Initialize map of expected_responses and their metadata 
-  std::map<String,Rmeta> expected_responses;
+  // "metadata" for each expected response: its label, its index in asv
+  // (metadata follow the functions), and whether it has been encountered in s
+  struct Rmeta {
+    const String* label;
+    size_t index;
+    bool found;
+  };
+  std::vector<Rmeta> expected_responses;
+  expected_responses.reserve(nf + num_metadata);
   for(size_t i=0; i<nf; ++i) {
     if(asv[i] & 1)
-      expected_responses[fn_labels[i]] = Rmeta(i, false);
+      expected_responses.push_back(Rmeta{&fn_labels[i], i, false});
   }
   for(size_t i=0; i<num_metadata; ++i)
-    expected_responses[shared_data().metadata_labels()[i]] = Rmeta(nf+i, false);
-  // Use std::map.find() to learn whether a token extracted from s is an
-  // expected label. find() returns an iterator to the first matching item.
-  // If no match was found, the iterator refers to the end.
-  std::map<String,Rmeta>::const_iterator ere = expected_responses.end();
+    expected_responses.push_back(Rmeta{&md_labels[i], nf+i, false});
+  // Sort by label for lookup of the tokens extracted from s. For a label
+  // appearing more than once, the last occurrence defines the response.
+  std::stable_sort(expected_responses.begin(), expected_responses.end(),
+    [](const Rmeta& a, const Rmeta& b) { return *a.label < *b.label; });
+  size_t num_unique = 0;
+  for(size_t i=0; i<expected_responses.size(); ++i)
+    if(i+1 == expected_responses.size() ||
+       *expected_responses[i+1].label != *expected_responses[i].label)
+      expected_responses[num_unique++] = expected_responses[i];
+  expected_responses.resize(num_unique);
+  // Returns the expected response labeled token, or NULL if there is none
+  auto find_expected = [&expected_responses](const ResultsToken& token) {
+    std::vector<Rmeta>::iterator it =
+      std::lower_bound(expected_responses.begin(), expected_responses.end(),
+        token, [](const Rmeta& a, const ResultsToken& t)
+        { return a.label->compare(0, String::npos, t.first, t.length) < 0; });
+    return (it != expected_responses.end() && token.equals(*it->label)) ?
+      &*it : (Rmeta*)NULL;
+  };
   // lists of responses for which there were errors
   StringArray missing_values, repeated_labels, missing_responses;
   // max asv index encountered so far. bookkeeping to detect out-of-order
@@ -456,11 +499,12 @@ void Response::read_labeled_fn_vals(std::istream& s, const ShortArray &asv,
   bool out_of_order = false; // error flag for out of order responses
   size_t num_found = 0; //number of resps found, used only for error reporting
   size_t pos1, pos2;
-  String token1, token2;
-  pos1 = s.tellg();
-  s >> token1;
-  pos2 = s.tellg();
-  s >> token2;
+  ResultsToken token1, token2;
+  Rmeta *resp1, *resp2;
+  pos1 = s.tell();
+  token1 = s.next_token();
+  pos2 = s.tell();
+  token2 = s.next_token();
   // Extract pairs of tokens. 
   // o If the first token is a floating point value and the second is an
   //   expected label then record the value
@@ -468,53 +512,51 @@ void Response::read_labeled_fn_vals(std::istream& s, const ShortArray &asv,
   //   record a "missing value" error.
   // o Otherwise, there is some unhandled formatting issue. Throw an
   //   exception.
-  while(!token1.empty() && token1[0] != '[') { //loop until EOF or gradient found
-    if(isfloat(token1) &&  
-                expected_responses.find(token2) != ere) { //valid format
-      if(expected_responses[token2].second)
-        repeated_labels.push_back("\"" + token2 + "\"");
-      if(expected_responses[token2].first < max_index) 
+  while(!token1.empty() && token1.front() != '[') { //loop until EOF or gradient found
+    if(ResultsFileTokenizer::is_float(token1) &&
+       (resp2 = find_expected(token2))) { //valid format
+      if(resp2->found)
+        repeated_labels.push_back("\"" + *resp2->label + "\"");
+      if(resp2->index < max_index) 
         out_of_order = true;
       else
-        max_index = expected_responses[token2].first;
-      expected_responses[token2].second = true;
+        max_index = resp2->index;
+      resp2->found = true;
       num_found++;
-      if (expected_responses[token2].first < nf)
-	functionValues[expected_responses[token2].first] = std::stod(token1);
+      if (resp2->index < nf)
+	functionValues[resp2->index] = ResultsFileTokenizer::to_real(token1);
       else
-	metaData[expected_responses[token2].first - nf] = std::stod(token1);
-      token1.clear(); token2.clear();
-      pos1 = s.tellg();
-      s >> token1;
-      pos2 = s.tellg();
-      s >> token2;
-    } else if(expected_responses.find(token1) != ere) { // missing value
-      missing_values.push_back("\"" + token1 + "\"");
-      if(expected_responses[token1].second) // may also be repeated label
-        repeated_labels.push_back("\"" + token1 + "\"");
-      if(expected_responses[token1].first < max_index) // also check for order
+	metaData[resp2->index - nf] = ResultsFileTokenizer::to_real(token1);
+      pos1 = s.tell();
+      token1 = s.next_token();
+      pos2 = s.tell();
+      token2 = s.next_token();
+    } else if((resp1 = find_expected(token1))) { // missing value
+      missing_values.push_back("\"" + *resp1->label + "\"");
+      if(resp1->found) // may also be repeated label
+        repeated_labels.push_back("\"" + *resp1->label + "\"");
+      if(resp1->index < max_index) // also check for order
         out_of_order = true;
       else
-        max_index = expected_responses[token1].first;
-      expected_responses[token1].second = true;
+        max_index = resp1->index;
+      resp1->found = true;
       num_found++;
       // read the next token
       pos1 = pos2;
       token1 = token2;
-      pos2 = s.tellg();
-      token2.clear();
-      s >> token2;
+      pos2 = s.tell();
+      token2 = s.next_token();
     } else { // unrecognized format problem
       throw ResultsFileError("Unexpected data found after reading " +
 			     std::to_string(num_found) + " function value(s).");
     }
   }
-  s.seekg(pos1); //rewind to (potentially) before [
+  s.seek(pos1); //rewind to (potentially) before [
   // Any responses missing?
-  for(std::map<String,Rmeta>::iterator mi = expected_responses.begin();
-      mi != expected_responses.end(); ++mi) {
-    if(!mi->second.second)
-      missing_responses.push_back("\"" + mi->first + "\"");
+  for(std::vector<Rmeta>::const_iterator ri = expected_responses.begin();
+      ri != expected_responses.end(); ++ri) {
+    if(!ri->found)
+      missing_responses.push_back("\"" + *ri->label + "\"");
   }
   // Add error messages to errors as needed
   if(out_of_order) {
@@ -543,9 +585,10 @@ void Response::read_labeled_fn_vals(std::istream& s, const ShortArray &asv,
 }
 
 
-void Response::read_flexible_fn_vals(std::istream& s, const ShortArray &asv, 
-          size_t num_metadata, std::ostringstream &errors) {
-  String token1, token2;
+void Response::read_flexible_fn_vals(ResultsFileTokenizer& s,
+          const ShortArray &asv, size_t num_metadata,
+          std::ostringstream &errors) {
+  ResultsToken token1, token2;
   size_t pos1, pos2;
   size_t nf = asv.size();
   size_t num_expected = 0, num_found = 0;
@@ -555,45 +598,43 @@ void Response::read_flexible_fn_vals(std::istream& s, const ShortArray &asv,
 
   size_t asv_idx = 0; //functionValues/asv index; advanced as fn vals are stored
   size_t md_idx = 0;
-  pos1 = s.tellg();
-  s >> token1;
-  pos2 = s.tellg();
-  s >> token2;
+  pos1 = s.tell();
+  token1 = s.next_token();
+  pos2 = s.tell();
+  token2 = s.next_token();
   // Keep reading until we run out of function values, indicated by empty token
   // or '['. Two tokens must be read to get the value and (potentially) the label.
-  while(!token1.empty() && token1[0] != '[') {
+  while(!token1.empty() && token1.front() != '[') {
     // Advance asv_idx to index of the next requested fn val.
     while(asv_idx < nf && !(asv[asv_idx] & 1)) asv_idx++;
 
-    if(isfloat(token1)) {
+    if(ResultsFileTokenizer::is_float(token1)) {
       ++num_found;
       if(num_found <= num_expected) {
 	if(asv_idx < nf)
-	  functionValues[asv_idx] = std::stod(token1);
+	  functionValues[asv_idx] = ResultsFileTokenizer::to_real(token1);
 	else
-	  metaData[md_idx++] = std::stod(token1);
+	  metaData[md_idx++] = ResultsFileTokenizer::to_real(token1);
       }
     } else {
-      throw ResultsFileError("Item \"" + token1 + "\" found while reading "
-          "function values is not a valid floating point number.");
+      throw ResultsFileError("Item \"" + token1.str() + "\" found while "
+          "reading function values is not a valid floating point number.");
     }
-    if(!token2.empty() && (isfloat(token2) || token2[0] == '[')) {
-        token1=token2;
+    if(!token2.empty() && (ResultsFileTokenizer::is_float(token2) ||
+			   token2.front() == '[')) {
+        token1 = token2;
         pos1 = pos2;
-        pos2 = s.tellg();
-        token2.clear();
-        s >> token2;
+        pos2 = s.tell();
+        token2 = s.next_token();
     } else { // token2 contains a label
-      token1.clear(); token2.clear();
-      pos1 = s.tellg();
-      s >> token1;
-      pos2 = s.tellg();
-      s >> token2;
+      pos1 = s.tell();
+      token1 = s.next_token();
+      pos2 = s.tell();
+      token2 = s.next_token();
     }
     asv_idx++; // not necessary once asv_idx >= nf, but harmless
   }
-  s.seekg(pos1); // rewind to just before the [. If EOF was set,
-                 // future reads will still "fail".
+  s.seek(pos1); // rewind to just before the [
   // Report an error if needed
   if(num_found != num_expected) {
     if(!errors.str().empty())
@@ -646,7 +687,7 @@ void Response::read_flexible_fn_vals(std::istream& s, const ShortArray &asv,
   }
 }
 */
-void Response::read_gradients(std::istream& s, const ShortArray &asv,
+void Response::read_gradients(ResultsFileTokenizer& s, const ShortArray &asv,
 			      bool expect_metadata, std::ostringstream &errors)
 {
   size_t nf = asv.size();
@@ -662,39 +703,38 @@ void Response::read_gradients(std::istream& s, const ShortArray &asv,
   char l_bracket1 = '\0', l_bracket2 = '\0', r_bracket = '\0';
   size_t pos1, pos2;
   size_t asv_idx = 0;
-  pos1 = s.tellg();
-  s >> l_bracket1;
-  pos2 = s.tellg();
-  s >> l_bracket2;
+  int num_rows = functionGradients.numRows();
+  pos1 = s.tell();
+  l_bracket1 = s.next_char();
+  pos2 = s.tell();
+  l_bracket2 = s.next_char();
   // Keep reading until we run out of file or encounter a hessian. Determine 
   // the actual number of gradients in the file; if this is more or less
   // than what was expected, report as an error.
  
   while(l_bracket1 == '[' && l_bracket2 != '[') {
-    s.seekg(pos2);
+    s.seek(pos2);
     while(asv_idx < nf && !(asv[asv_idx] & 2)) asv_idx++;
     num_found++;
-    if(num_found <= num_expected) {
-      read_col_vector_trans(s, (int)asv_idx, functionGradients); // fault tolerant
-    } else { // get and discard 
-      s.ignore(std::numeric_limits<int>::max(),']');
-      s.putback(']'); // doesn't clear EOF
-    }
-    r_bracket = '\0';
-    s >> r_bracket;
+    if(num_found <= num_expected) { // fault tolerant
+      Real* grad = functionGradients[(int)asv_idx];
+      for(int row=0; row<num_rows; ++row)
+	grad[row] = s.next_real();
+    } else // get and discard 
+      s.skip_to(']');
+    r_bracket = s.next_char();
     if(r_bracket != ']') {
       throw ResultsFileError("Closing bracket ']' not found in " 
 			     "expected position for function gradient " +
 			     std::to_string(num_found) + ".");
     }
     asv_idx++;
-    l_bracket1 = '\0'; l_bracket2 = '\0';
-    pos1 = s.tellg();
-    s >> l_bracket1;
-    pos2 = s.tellg();
-    s >> l_bracket2;
+    pos1 = s.tell();
+    l_bracket1 = s.next_char();
+    pos2 = s.tell();
+    l_bracket2 = s.next_char();
   }
-  s.seekg(pos1);
+  s.seek(pos1);
   // l_bracket1 and 2 are expected to both contain [ (start of hessian) or  \0 
   // (eof). If they don't, there was unexpected junk following the last 
   // gradient. The case of no gradients + unexpected junk following the last 
@@ -716,7 +756,7 @@ void Response::read_gradients(std::istream& s, const ShortArray &asv,
   }
 }
 
-void Response::read_hessians(std::istream& s, const ShortArray &asv,
+void Response::read_hessians(ResultsFileTokenizer& s, const ShortArray &asv,
 			     bool expect_metadata, std::ostringstream &errors)
 {
   size_t nf = asv.size();
@@ -732,33 +772,33 @@ void Response::read_hessians(std::istream& s, const ShortArray &asv,
   
   char l_bracket[2] = {'\0','\0'};
   char r_bracket[2] = {'\0','\0'};
-  size_t pos1 = s.tellg();
+  size_t pos1 = s.tell();
   size_t asv_idx = 0;
-  s >> l_bracket[0] >> l_bracket[1];
+  l_bracket[0] = s.next_char(); l_bracket[1] = s.next_char();
   // Keep reading until we run out of Hessians 
   while(l_bracket[0]  == '[' && l_bracket[1] == '[') {
     // advance asv_idx to the next response for which Hessian is required
     while(asv_idx < nf && !(asv[asv_idx] & 4)) asv_idx++;
     num_found++;
-    if(num_found <= num_expected) {
-      Dakota::read_data(s, functionHessians[asv_idx]); // fault tolerant
-    } else { // get and discard 
-      s.ignore(std::numeric_limits<int>::max(),']');
-      s.putback(']');
-    }
-    r_bracket[0] = '\0'; r_bracket[1] = '\0';
-    s >> r_bracket[0] >> r_bracket[1];
+    if(num_found <= num_expected) { // fault tolerant; reads full matrix
+      RealSymMatrix& hess = functionHessians[asv_idx];
+      int num_rows = hess.numRows();
+      for(int i=0; i<num_rows; ++i)
+	for(int j=0; j<num_rows; ++j)
+	  hess(i,j) = s.next_real();
+    } else // get and discard 
+      s.skip_to(']');
+    r_bracket[0] = s.next_char(); r_bracket[1] = s.next_char();
     if( !(r_bracket[0] == ']' && r_bracket[1] == ']') ) {
       throw ResultsFileError("Closing brackets ']]' not found in expected "
 			     "position for function Hessian "
 			     + std::to_string(num_found) + "." );
     }
     asv_idx++;
-    l_bracket[0] = '\0'; l_bracket[1] = '\0';
-    pos1 = s.tellg();
-    s >> l_bracket[0] >> l_bracket[1];
+    pos1 = s.tell();
+    l_bracket[0] = s.next_char(); l_bracket[1] = s.next_char();
   }
-  s.seekg(pos1);
+  s.seek(pos1);
   bool at_eof = (l_bracket[0] == '\0');
   if( ! (at_eof || expect_metadata) )
     throw ResultsFileError("Unexpected data found after reading " +
@@ -774,23 +814,125 @@ void Response::read_hessians(std::istream& s, const ShortArray &asv,
 }
 
 
-bool Response::failure_reported(std::istream& s) {
-  char fail_char;
-  std::string fail_string("fail");
-  s >> fail_char; // advance to first char
-  if(s)
-    s.putback(fail_char);
-  for (size_t i=0; i<4; i++) {
-    fail_char = '\0';
-    s.get(fail_char);
-    if (tolower(fail_char) != fail_string[i]) { // FAIL, Fail, fail, etc.
-      s.seekg(0); // Reset stream to beginning
-      return false; // exit for loop
+/** Reads one binary results record (see dakota_binary_files.h).  The
+    record is self-describing, so that the checks mirror those of the
+    text readers: the data present for each function must match the
+    ASV, and the function, derivative variable and metadata counts must
+    match those of this response. */
+void Response::read_binary(const String& buffer)
+{
+  dakota_bin_reader r;
+  dakota_bin_reader_init(&r, buffer.data(), buffer.size());
+  uint32_t flags = 0;
+  switch (dakota_bin_read_header(&r, DAKOTA_BIN_RESULTS_MAGIC, &flags)) {
+  case -1:
+    throw ResultsFileError("-- Binary results signature \"" 
+			   DAKOTA_BIN_RESULTS_MAGIC "\" not found.");
+  case -2:
+    throw ResultsFileError("-- Unsupported binary results version; "
+			   "expected version " +
+			   std::to_string(DAKOTA_BIN_VERSION) + ".");
+  }
+  if (flags & DAKOTA_BIN_FAILED)
+    throw FunctionEvalFailure(String("failure captured"));
+
+  reset();
+
+  const ShortArray& asv = responseActiveSet.request_vector();
+  const size_t nf = asv.size(),
+    nd = responseActiveSet.derivative_vector().size(), nm = metaData.size();
+  uint64_t num_fns = dakota_bin_read_u64(&r),
+    num_deriv_vars = dakota_bin_read_u64(&r),
+    num_metadata = dakota_bin_read_u64(&r);
+  const unsigned char* contents = dakota_bin_take(&r, num_fns);
+  if (r.error)
+    throw ResultsFileError("-- Binary results record is truncated.");
+  // the layout of the record cannot be interpreted for other counts
+  std::ostringstream errors;
+  if (num_fns != nf)
+    errors << "-- Expected " << nf << " function(s) but found " << num_fns
+	   << ".";
+  if (num_deriv_vars != nd) {
+    if(!errors.str().empty()) errors << "\n";
+    errors << "-- Expected " << nd << " derivative variable(s) but found "
+	   << num_deriv_vars << ".";
+  }
+  if (num_metadata != nm) {
+    if(!errors.str().empty()) errors << "\n";
+    errors << "-- Expected " << nm << " metadata value(s) but found "
+	   << num_metadata << ".";
+  }
+  if (!errors.str().empty())
+    throw ResultsFileError(errors.str());
+
+  // value/gradient/Hessian counts, and whether they are for other functions
+  size_t i, num_expected[3] = {0, 0, 0}, num_found[3] = {0, 0, 0};
+  bool misplaced[3] = {false, false, false};
+  for (i=0; i<nf; ++i)
+    for (size_t b=0; b<3; ++b) {
+      short mask = 1 << b;
+      if (asv[i] & mask)        ++num_expected[b];
+      if (contents[i] & mask)   ++num_found[b];
+      if ((asv[i] ^ contents[i]) & mask) misplaced[b] = true;
+    }
+
+  for (i=0; i<nf; ++i)
+    if (contents[i] & 1) {
+      Real val = dakota_bin_read_f64(&r);
+      if (asv[i] & 1)
+	functionValues[i] = val;
     }
+  for (i=0; i<nf; ++i)
+    if (contents[i] & 2)
+      dakota_bin_read_f64_array(&r, (asv[i] & 2) ?
+				functionGradients[(int)i] : NULL, nd);
+  for (i=0; i<nf; ++i)
+    if (contents[i] & 4) {
+      if (asv[i] & 4) {
+	RealSymMatrix& hess = functionHessians[i];
+	for (size_t j=0; j<nd; ++j)
+	  for (size_t k=0; k<nd; ++k)
+	    hess(j,k) = dakota_bin_read_f64(&r);
+      }
+      else
+	dakota_bin_read_f64_array(&r, NULL, nd*nd);
+    }
+  if (nm)
+    dakota_bin_read_f64_array(&r, &metaData[0], nm);
+  if (r.error)
+    throw ResultsFileError("-- Binary results record is truncated.");
+  if (r.pos != r.end)
+    throw ResultsFileError("Unexpected data found after binary results "
+			   "record.");
+
+  const char* kinds[3] = {"function value(s)", "gradients", "Hessians"};
+  for (size_t b=0; b<3; ++b) {
+    if (!misplaced[b])
+      continue;
+    if(!errors.str().empty()) errors << "\n";
+    if (num_found[b] != num_expected[b])
+      errors << "-- Expected " << num_expected[b] << ' ' << kinds[b]
+	     << " but found " << num_found[b] << ".";
+    else
+      errors << "-- The " << kinds[b] << " provided do not match the "
+	     << "active set vector.";
   }
-  return true;
+  if (!errors.str().empty())
+    throw ResultsFileError(errors.str());
+}
+
+
+bool Response::failure_reported(ResultsFileTokenizer& s) {
+  // FAIL, Fail, fail, etc. leading the first token
+  const char* fail_string = "fail";
+  ResultsToken token = s.next_token();
+  bool failed = (token.length >= 4);
+  for (size_t i=0; failed && i<4; i++)
+    failed = (std::tolower(static_cast<unsigned char>(token.first[i]))
+	      == fail_string[i]);
+  s.seek(0); // Reset to beginning
+  return failed;
 }
- 
 
 
 /** ASCII version of write. */
@@ -18,6 +18,7 @@
 namespace Dakota {
 
 class ProblemDescDB;
+class ResultsFileTokenizer;
 using RespMetadataT = double;
 
 
@@ -247,6 +248,10 @@ public:
 
   /// read a response object of specified format from a std::istream 
   void read(std::istream& s, const unsigned short format = FLEXIBLE_RESULTS);
+  /// read a response object of specified format from results file
+  /// content held in memory
+  void read(const String& buffer,
+	    const unsigned short format = FLEXIBLE_RESULTS);
  
   /// write a response object to a std::ostream
   void write(std::ostream& s) const;
@@ -478,29 +483,29 @@ private:
   /// reshape function{Gradients,Hessians} if needed to sync with DVV
   void reshape_active_derivs(size_t num_deriv_vars);
 
-  void read_core(std::istream& s, const unsigned short formats,
+  void read_core(ResultsFileTokenizer& s, const unsigned short formats,
 		 std::ostringstream& errors);
 
   bool expect_derivatives(const ShortArray& asv);
 
   /// Read gradients from a freeform stream. Insert error messages
   // into errors stream.
-  void read_gradients(std::istream& s, const ShortArray &asv,
+  void read_gradients(ResultsFileTokenizer& s, const ShortArray &asv,
 		      bool expect_metadata, std::ostringstream &error);
 
   /// Read Hessians from a freeform stream. Insert error messages
   // into errors stream.
-  void read_hessians(std::istream& s, const ShortArray &asv,
+  void read_hessians(ResultsFileTokenizer& s, const ShortArray &asv,
 		     bool expect_metadata, std::ostringstream &error);
 
   /// Read function values from an annotated stream. Insert error messages
   // into errors stream. 
-  void read_labeled_fn_vals(std::istream &s, const ShortArray &asv,
+  void read_labeled_fn_vals(ResultsFileTokenizer& s, const ShortArray &asv,
 			    size_t num_metadata, std::ostringstream &errors);
 
   /// Read function values from a stream in a "flexible" way -- ignoring 
   /// any labels. Insert error messages into errors stream.
-  void read_flexible_fn_vals(std::istream &s, const ShortArray &asv,
+  void read_flexible_fn_vals(ResultsFileTokenizer& s, const ShortArray &asv,
 			    size_t num_metadata, std::ostringstream &errors);
 
 /*  /// Read function values from a freeform stream. Insert error messages
@@ -509,8 +514,11 @@ private:
       std::ostringstream &error);
 */
 
+  /// Read a binary results record; throws for failures and format errors
+  void read_binary(const String& buffer);
+
   /// Check for FAIL in stream
-  bool failure_reported(std::istream &s);
+  bool failure_reported(ResultsFileTokenizer& s);
 
   //
   //- Heading: Private data members
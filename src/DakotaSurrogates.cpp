@@ -252,6 +252,70 @@ const RealVector& SurrogatesBaseApprox::gradient(const RealVector& c_vars)
 }
 
 
+void SurrogatesBaseApprox::
+map_eval_points(const RealMatrix& cv_points, Variables& vars,
+		MatrixXd& eval_pts)
+{
+  int j, num_cv = cv_points.numRows(), num_pts = cv_points.numCols();
+  size_t i, num_features = sharedDataRep->numVars;
+  eval_pts.resize(num_pts, num_features);
+  for (j=0; j<num_pts; ++j) {
+    RealVector cv_j(Teuchos::View, const_cast<Real*>(cv_points[j]), num_cv);
+    vars.continuous_variables(cv_j);
+    RealVector surr_vars = map_eval_vars(vars);
+    for (i=0; i<num_features; ++i)
+      eval_pts(j,i) = surr_vars[i];
+  }
+}
+
+
+void SurrogatesBaseApprox::
+values(const RealMatrix& cv_points, Variables& vars, RealVector& vals)
+{
+  if (!model) {
+    Cerr << "Error: surface is null in SurrogatesBaseApprox::values()"
+	 << std::endl;
+    abort_handler(-1);
+  }
+
+  MatrixXd eval_pts;
+  map_eval_points(cv_points, vars, eval_pts);
+  // one call to the vectorized predictor for the whole batch
+  VectorXd pred_vals = model->value(eval_pts);
+
+  int j, num_pts = cv_points.numCols();
+  if (vals.length() != num_pts)
+    vals.sizeUninitialized(num_pts);
+  for (j=0; j<num_pts; ++j)
+    vals[j] = pred_vals(j);
+}
+
+
+void SurrogatesBaseApprox::
+gradients(const RealMatrix& cv_points, Variables& vars, RealMatrix& grads)
+{
+  if (!model) {
+    Cerr << "Error: surface is null in SurrogatesBaseApprox::gradients()"
+	 << std::endl;
+    abort_handler(-1);
+  }
+
+  MatrixXd eval_pts;
+  map_eval_points(cv_points, vars, eval_pts);
+  MatrixXd pred_grads = model->gradient(eval_pts); // num_pts by num_features
+
+  // continuous variables lead the surrogate features, as in gradient()
+  int i, j, num_cv = cv_points.numRows(), num_pts = cv_points.numCols();
+  if (grads.numRows() != num_cv || grads.numCols() != num_pts)
+    grads.shapeUninitialized(num_cv, num_pts);
+  for (j=0; j<num_pts; ++j) {
+    Real* grads_j = grads[j];
+    for (i=0; i<num_cv; ++i)
+      grads_j[i] = pred_grads(j,i);
+  }
+}
+
+
 void SurrogatesBaseApprox::
 import_model(const ProblemDescDB& problem_db)
 {
@@ -77,6 +77,17 @@ protected:
 
   const RealVector& gradient(const RealVector& c_vars) override;
 
+  void values(const RealMatrix& cv_points, Variables& vars,
+	      RealVector& vals) override;
+
+  void gradients(const RealMatrix& cv_points, Variables& vars,
+		 RealMatrix& grads) override;
+
+  /// assemble the surrogate inputs for a batch of points (num_pts by
+  /// num_features) for a single call to the vectorized predictors
+  void map_eval_points(const RealMatrix& cv_points, Variables& vars,
+		       dakota::MatrixXd& eval_pts);
+
   /// set the surrogate's verbosity level according to Dakota's verbosity
   void set_verbosity();
 
@@ -136,6 +136,8 @@ SurrogatesGPApprox::build()
 
   MatrixXd vars, resp;
   convert_surrogate_data(vars, resp);
+  builtVars = vars;
+  builtResp = resp;
 
   /* DTS: Should also consider the case when we want config options to change
    * over the course of EG*-type algorithms */
@@ -168,6 +170,38 @@ SurrogatesGPApprox::build()
   */
 }
 
+void
+SurrogatesGPApprox::rebuild()
+{
+  // Incremental updates are opt-in through the "Append" options (e.g.,
+  // in an advanced options file), as a full build also refits the data
+  // scaling and hyperparameters
+  auto gp_model =
+    std::dynamic_pointer_cast<dakota::surrogates::GaussianProcess>(model);
+  if (gp_model && !modelIsImported) {
+    dakota::ParameterList gp_opts;
+    gp_model->get_options(gp_opts);
+    MatrixXd vars, resp;
+    convert_surrogate_data(vars, resp);
+    // append only when the data grew by new points after unchanged build
+    // points; other updates (e.g., a constant liar response replaced by
+    // the truth, or points removed) require a full build
+    int num_old = builtVars.rows(), num_new = vars.rows() - num_old;
+    if (gp_opts.isSublist("Append") &&
+	gp_opts.sublist("Append").get<int>("frozen updates") > 0 &&
+	num_new > 0 && num_old == gp_model->get_num_samples() &&
+	vars.cols() == builtVars.cols() && resp.cols() == builtResp.cols() &&
+	vars.topRows(num_old) == builtVars &&
+	resp.topRows(num_old) == builtResp) {
+      gp_model->append(vars.bottomRows(num_new), resp.bottomRows(num_new));
+      builtVars = vars;
+      builtResp = resp;
+      return;
+    }
+  }
+  build();
+}
+
 Real SurrogatesGPApprox::prediction_variance(const Variables& vars)
 {
   return prediction_variance(map_eval_vars(vars));
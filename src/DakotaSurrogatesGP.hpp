@@ -47,10 +47,26 @@ protected:
   ///  Do the build
   void build() override;
 
+  /// append new build data to the GP when its "Append" options freeze
+  /// hyperparameters (else do a full build)
+  void rebuild() override;
+
   Real prediction_variance(const Variables& vars) override;
 
   Real prediction_variance(const RealVector& c_vars) override;
 
+private:
+
+  //
+  //- Heading: Data
+  //
+
+  /// build points of the GaussianProcess (one per row), in the order
+  /// they were built or appended
+  dakota::MatrixXd builtVars;
+  /// build responses of the GaussianProcess, corresponding to builtVars
+  dakota::MatrixXd builtResp;
+
 };
 
 // free function for setting up experimental GPs with an
@@ -17,15 +17,19 @@ namespace Dakota {
 
 // Default constructor:
 DataEnvironmentRep::DataEnvironmentRep():
-  checkFlag(false), stopRestart(0), 
+  checkFlag(false), stopRestart(0), writeRestartIndexed(false),
+  writeRestartCommit(RESTART_COMMIT_EVERY_EVAL), writeRestartCommitEvals(0),
+  writeRestartCommitSeconds(0), writeRestartFsync(false),
   preRunFlag(false), runFlag(false), postRunFlag(false),
   preRunOutputFormat(TABULAR_ANNOTATED), postRunInputFormat(TABULAR_ANNOTATED),
   graphicsFlag(false), tabularDataFlag(false), 
   tabularDataFile("dakota_tabular.dat"), tabularFormat(TABULAR_ANNOTATED), 
-  outputPrecision(0), 
+  outputPrecision(0), kernelThreads(1),
   resultsOutputFlag(false), resultsOutputFile("dakota_results"),
   resultsOutputFormat(0), modelEvalsSelection(MODEL_EVAL_STORE_TOP_METHOD),
-  interfEvalsSelection(INTERF_EVAL_STORE_SIMULATION)
+  interfEvalsSelection(INTERF_EVAL_STORE_SIMULATION),
+  resultsOutputBufferSize(0), resultsOutputFlushSeconds(10),
+  resultsOutputCompression(0)
 { }
 
 
@@ -33,13 +37,17 @@ void DataEnvironmentRep::write(MPIPackBuffer& s) const
 {
   s << checkFlag 
     << outputFile << errorFile << readRestart << stopRestart << writeRestart
+    << writeRestartIndexed << writeRestartCommit << writeRestartCommitEvals
+    << writeRestartCommitSeconds << writeRestartFsync
     << preRunFlag << runFlag << postRunFlag << preRunInput << preRunOutput
     << runInput << runOutput << postRunInput << postRunOutput
     << preRunOutputFormat << postRunInputFormat
     << graphicsFlag << tabularDataFlag << tabularDataFile << tabularFormat 
-    << outputPrecision << resultsOutputFlag << resultsOutputFile 
+    << outputPrecision << kernelThreads
+    << resultsOutputFlag << resultsOutputFile 
     << resultsOutputFormat << modelEvalsSelection << interfEvalsSelection
-    << topMethodPointer;
+    << resultsOutputBufferSize << resultsOutputFlushSeconds
+    << resultsOutputCompression << topMethodPointer;
 }
 
 
@@ -47,13 +55,17 @@ void DataEnvironmentRep::read(MPIUnpackBuffer& s)
 {
   s >> checkFlag 
     >> outputFile >> errorFile >> readRestart >> stopRestart >> writeRestart
+    >> writeRestartIndexed >> writeRestartCommit >> writeRestartCommitEvals
+    >> writeRestartCommitSeconds >> writeRestartFsync
     >> preRunFlag >> runFlag >> postRunFlag >> preRunInput >> preRunOutput
     >> runInput >> runOutput >> postRunInput >> postRunOutput
     >> preRunOutputFormat >> postRunInputFormat
     >> graphicsFlag >> tabularDataFlag >> tabularDataFile >> tabularFormat 
-    >> outputPrecision
+    >> outputPrecision >> kernelThreads
     >> resultsOutputFlag >> resultsOutputFile >> resultsOutputFormat 
-    >> modelEvalsSelection >> interfEvalsSelection >> topMethodPointer;
+    >> modelEvalsSelection >> interfEvalsSelection
+    >> resultsOutputBufferSize >> resultsOutputFlushSeconds
+    >> resultsOutputCompression >> topMethodPointer;
 }
 
 
@@ -61,13 +73,17 @@ void DataEnvironmentRep::write(std::ostream& s) const
 {
   s << checkFlag 
     << outputFile << errorFile << readRestart << stopRestart << writeRestart
+    << writeRestartIndexed << writeRestartCommit << writeRestartCommitEvals
+    << writeRestartCommitSeconds << writeRestartFsync
     << preRunFlag << runFlag << postRunFlag << preRunInput << preRunOutput
     << runInput << runOutput << postRunInput << postRunOutput
     << preRunOutputFormat << postRunInputFormat
     << graphicsFlag << tabularDataFlag << tabularDataFile << tabularFormat 
-    << outputPrecision
+    << outputPrecision << kernelThreads
     << resultsOutputFlag << resultsOutputFile << resultsOutputFormat 
-    << modelEvalsSelection << interfEvalsSelection << topMethodPointer;
+    << modelEvalsSelection << interfEvalsSelection
+    << resultsOutputBufferSize << resultsOutputFlushSeconds
+    << resultsOutputCompression << topMethodPointer;
 }
 
 
@@ -55,6 +55,18 @@ public:
   int stopRestart;
   /// file name for restart write (overrides command-line)
   String writeRestart;
+  /// whether to write the restart file in the indexed format
+  bool writeRestartIndexed;
+  /// policy for committing restart records (RESTART_COMMIT_EVERY_EVAL
+  /// or RESTART_COMMIT_CHECKPOINT; see also writeRestartCommitEvals and
+  /// writeRestartCommitSeconds)
+  unsigned short writeRestartCommit;
+  /// number of evaluations between restart commits (0 = unused)
+  int writeRestartCommitEvals;
+  /// number of seconds between restart commits (0 = unused)
+  int writeRestartCommitSeconds;
+  /// whether restart commits also synchronize the file to disk (fsync)
+  bool writeRestartFsync;
 
   bool preRunFlag;      ///< flags invocation with command line option -pre_run
   bool runFlag;         ///< flags invocation with command line option -run
@@ -84,6 +96,9 @@ public:
 
   /// output precision for tabular and screen output
   int outputPrecision;
+  /// number of threads applied by threaded numerical kernels (sample
+  /// generation, restart loading, correlations, surrogate builds)
+  int kernelThreads;
 
   /// flags use of results output to default file
   bool resultsOutputFlag;
@@ -95,6 +110,13 @@ public:
   unsigned short modelEvalsSelection;
   /// Interface selection for eval storage
   unsigned short interfEvalsSelection;
+  /// number of evaluations buffered per model/interface before an HDF5
+  /// write (0 = sized from a memory budget)
+  int resultsOutputBufferSize;
+  /// maximum seconds buffered evaluations are held before an HDF5 write
+  int resultsOutputFlushSeconds;
+  /// deflate level (0-9) of HDF5 evaluation datasets (0 = uncompressed)
+  int resultsOutputCompression;
   /// method identifier for the environment (from the \c top_method_pointer
   /// specification
   String topMethodPointer;
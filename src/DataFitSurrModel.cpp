@@ -13,6 +13,7 @@
 #include "ParamResponsePair.hpp"
 #include "ProblemDescDB.hpp"
 #include "PRPMultiIndex.hpp"
+#include "PRPShardedCache.hpp"
 #include "dakota_data_io.hpp"
 #include "dakota_tabular_io.hpp"
 #include <boost/accumulators/accumulators.hpp>
@@ -1132,7 +1133,7 @@ void DataFitSurrModel::build_global()
   // conversions and allow pass-by-reference.
 
   // **************************************************************************
-  // Check data_pairs and importPointsFile for any existing evaluations to reuse
+  // Check evaluation cache and importPointsFile for existing evaluations to reuse
   // **************************************************************************
   size_t i, j, reuse_points = 0;
   int fn_index = *surrogateFnIndices.begin();
@@ -1153,19 +1154,22 @@ void DataFitSurrModel::build_global()
       num_dr_vars = actualModel.drv();
     }
 
-    // Process PRPCache using default iterators (index 0 = ordered_non_unique).
+    // Process the evaluation cache in evaluation id order (as for the
+    // ordered_non_unique index of PRPCache, including any sharded cache).
     // This includes evals from current run, evals imported from restart, and 
     // evals imported from a tabular file (DataFitSurrModel::import_points()).
-    // Each of these data_pairs sources is in "user-space" (e.g., generated by
+    // Each of these cache sources is in "user-space" (e.g., generated by
     // an ApplicationInterface).  To compare with DataFitSurrModel values and
     // bounds, any recastings within the model recursion must be managed.
     String am_interface_id;
     if (!actualModel.is_null())  am_interface_id = actualModel.interface_id();
     if (am_interface_id.empty()) am_interface_id = "NO_ID";
-    ModelLRevIter ml_rit; PRPCacheCIter prp_iter;
+    ModelLRevIter ml_rit; PRPArray db_records;
+    PRPArray::const_iterator prp_iter;
     Variables db_vars; Response db_resp;
     bool map_to_iter_space = recastings();
-    for (prp_iter=data_pairs.begin(); prp_iter!=data_pairs.end(); ++prp_iter) {
+    evaluation_records(db_records);
+    for (prp_iter=db_records.begin(); prp_iter!=db_records.end(); ++prp_iter) {
 
       const Variables& prp_vars = prp_iter->variables();
       const Response&  prp_resp = prp_iter->response();
@@ -1720,6 +1724,73 @@ void DataFitSurrModel::derived_evaluate(const ActiveSet& set)
 }
 
 
+/** The per-evaluation bookkeeping of derived_evaluate() that a batch
+    bypasses (corrections, point exports, graphics, evaluation storage
+    and finite difference derivative estimation) must be inactive. */
+bool DataFitSurrModel::batch_evaluation_available(const ActiveSet& set)
+{
+  switch (responseMode) {
+  case UNCORRECTED_SURROGATE:                    break;
+  case AUTO_CORRECTED_SURROGATE:
+    if (corrType) return false;                  break;
+  default:                      return false;    break;
+  }
+  if (!exportPointsFile.empty() || !exportVarianceFile.empty() ||
+      modelAutoGraphicsFlag || evaluationsDB.active())
+    return false;
+
+  // all requests must be satisfied by approxInterface
+  const ShortArray& asv = set.request_vector();
+  size_t i, num_fns = asv.size();
+  bool mixed = !actualModel.is_null() && surrogateFnIndices.size() != numFns;
+  for (i=0; i<num_fns; ++i)
+    if (asv[i]) {
+      if (mixed && !surrogateFnIndices.count(i))
+	return false;
+      if ( (asv[i] & 2) && supportsEstimDerivs && gradientType != "analytic" )
+	return false;
+    }
+
+  return approxInterface.batch_map_available(currentVariables, set);
+}
+
+
+/** Equivalent to evaluate(set) for each column of cv_samples: the
+    approximation is (re)built if needed and the evaluation counters
+    advance by the batch size.  On return, currentVariables and
+    currentResponse reflect the last evaluation in the batch. */
+void DataFitSurrModel::
+evaluate_batch(const RealMatrix& cv_samples, const ActiveSet& set,
+	       RealMatrix& fn_vals, RealMatrixArray& fn_grads)
+{
+  int num_evals = cv_samples.numCols();
+  if (!num_evals)
+    return;
+
+  if (!approxBuilds || force_rebuild())
+    build_approximation();
+
+  modelEvalCntr += num_evals; surrModelEvalCntr += num_evals;
+  approxInterface.map_batch(currentVariables, cv_samples, set, fn_vals,
+			    fn_grads);
+
+  int last = num_evals - 1;
+  RealVector last_cv(Teuchos::View, const_cast<Real*>(cv_samples[last]),
+		     cv_samples.numRows());
+  currentVariables.continuous_variables(last_cv);
+  currentResponse.active_set(set);
+  const ShortArray& asv = set.request_vector();
+  size_t i, num_fns = asv.size();
+  for (i=0; i<num_fns; ++i) {
+    if (asv[i] & 1)
+      currentResponse.function_value(fn_vals(i, last), i);
+    if (asv[i] & 2)
+      currentResponse.function_gradient(
+	Teuchos::getCol(Teuchos::View, fn_grads[i], last), i);
+  }
+}
+
+
 /** Compute the response asynchronously using actualModel,
     approxInterface, or both (mixed case).  For the approxInterface
     portion, build the approximation if needed and evaluate the
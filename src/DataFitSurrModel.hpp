@@ -267,6 +267,13 @@ protected:
   /// return the approximation variance from each Approximation
   /// (request forwarded to approxInterface)
   const RealVector& approximation_variances(const Variables& vars);
+  /// batch evaluation is available for surrogate-only requests without
+  /// corrections, data exports, graphics or evaluation storage
+  bool batch_evaluation_available(const ActiveSet& set);
+  /// evaluate the approximations over a batch of active continuous
+  /// variable values (request forwarded to approxInterface.map_batch())
+  void evaluate_batch(const RealMatrix& cv_samples, const ActiveSet& set,
+		      RealMatrix& fn_vals, RealMatrixArray& fn_grads);
   /// return the approximation data from a particular Approximation
   /// (request forwarded to approxInterface)
   const Pecos::SurrogateData& approximation_data(size_t fn_index);
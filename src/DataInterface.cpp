@@ -16,18 +16,24 @@ namespace Dakota {
 
 DataInterfaceRep::DataInterfaceRep():
   interfaceType(DEFAULT_INTERFACE),
-  allowExistingResultsFlag(false), verbatimFlag(false), apreproFlag(false),
+  allowExistingResultsFlag(false), verbatimFlag(false),
+  processLauncherFlag(false), apreproFlag(false),
   resultsFileFormat(FLEXIBLE_RESULTS), fileTagFlag(false), fileSaveFlag(false),
   batchEvalFlag(false), asynchFlag(false),
   asynchLocalEvalConcurrency(0), asynchLocalEvalScheduling(DEFAULT_SCHEDULING),
   asynchLocalAnalysisConcurrency(0), evalServers(0),
-  evalScheduling(DEFAULT_SCHEDULING), procsPerEval(0), analysisServers(0),
+  evalScheduling(DEFAULT_SCHEDULING), evalChunkingFlag(false),
+  evalChunkMax(0), costAwareSchedFlag(false), procsPerEval(0), analysisServers(0),
   analysisScheduling(DEFAULT_SCHEDULING), procsPerAnalysis(0),
   failAction("abort"), retryLimit(1), activeSetVectorFlag(true),
   evalCacheFlag(true), nearbyEvalCacheFlag(false),
   nearbyEvalCacheTol(DBL_EPSILON), // default relative tolerance is tight
+  evalCacheType(MULTI_INDEX_CACHE), evalCacheShards(0),
+  evalCacheMaxEntries(0), evalCacheMaxMemory(0.),
   restartFileFlag(true), useWorkdir(false), dirTag(false),
-  dirSave(false), templateReplace(false), numpyFlag(false)
+  dirSave(false), templateReplace(false), stageWorkdir(false),
+  stageHardlinks(false), stagePoolSize(-1), numpyFlag(false),
+  columnarFlag(false)
   // asynchLocal{Eval,Analysis}Concurrency, procsPer{Eval,Analysis} and
   // {eval,analysis}Servers default to zero in order to allow detection of
   // user overrides > 0
@@ -38,16 +44,22 @@ void DataInterfaceRep::write(MPIPackBuffer& s) const
 {
   s << idInterface << interfaceType << algebraicMappings << analysisDrivers
     << analysisComponents << inputFilter << outputFilter << parametersFile
-    << resultsFile << allowExistingResultsFlag  << verbatimFlag << apreproFlag 
+    << resultsFile << allowExistingResultsFlag  << verbatimFlag
+    << processLauncherFlag << apreproFlag 
     << resultsFileFormat << fileTagFlag << fileSaveFlag //<< gridHostNames << gridProcsPerHost
     << batchEvalFlag << asynchFlag << asynchLocalEvalConcurrency
     << asynchLocalEvalScheduling << asynchLocalAnalysisConcurrency
-    << evalServers << evalScheduling << procsPerEval << analysisServers
+    << evalServers << evalScheduling << evalChunkingFlag << evalChunkMax
+    << costAwareSchedFlag << procsPerEval << analysisServers
     << analysisScheduling << procsPerAnalysis << failAction << retryLimit
     << recoveryFnVals << activeSetVectorFlag << evalCacheFlag
-    << nearbyEvalCacheFlag << nearbyEvalCacheTol << restartFileFlag
+    << nearbyEvalCacheFlag << nearbyEvalCacheTol << evalCacheType
+    << evalCacheShards << evalCacheMaxEntries << evalCacheMaxMemory
+    << evalCacheSpillFile << restartFileFlag
     << useWorkdir << workDir << dirTag << dirSave << linkFiles
-    << copyFiles << templateReplace << pluginLibraryPath << numpyFlag;
+    << copyFiles << templateReplace << stageWorkdir << stageHardlinks
+    << stagePoolSize << pluginLibraryPath << numpyFlag
+    << columnarFlag;
 }
 
 
@@ -55,16 +67,22 @@ void DataInterfaceRep::read(MPIUnpackBuffer& s)
 {
   s >> idInterface >> interfaceType >> algebraicMappings >> analysisDrivers
     >> analysisComponents >> inputFilter >> outputFilter >> parametersFile
-    >> resultsFile >> allowExistingResultsFlag  >> verbatimFlag >> apreproFlag 
+    >> resultsFile >> allowExistingResultsFlag  >> verbatimFlag
+    >> processLauncherFlag >> apreproFlag 
     >> resultsFileFormat >> fileTagFlag >> fileSaveFlag //>> gridHostNames >> gridProcsPerHost
     >> batchEvalFlag >> asynchFlag >> asynchLocalEvalConcurrency
     >> asynchLocalEvalScheduling >> asynchLocalAnalysisConcurrency
-    >> evalServers >> evalScheduling >> procsPerEval >> analysisServers
+    >> evalServers >> evalScheduling >> evalChunkingFlag >> evalChunkMax
+    >> costAwareSchedFlag >> procsPerEval >> analysisServers
     >> analysisScheduling >> procsPerAnalysis >> failAction >> retryLimit
     >> recoveryFnVals >> activeSetVectorFlag >> evalCacheFlag
-    >> nearbyEvalCacheFlag >> nearbyEvalCacheTol >> restartFileFlag
+    >> nearbyEvalCacheFlag >> nearbyEvalCacheTol >> evalCacheType
+    >> evalCacheShards >> evalCacheMaxEntries >> evalCacheMaxMemory
+    >> evalCacheSpillFile >> restartFileFlag
     >> useWorkdir >> workDir >> dirTag >> dirSave >> linkFiles
-    >> copyFiles >> templateReplace >> pluginLibraryPath >> numpyFlag;
+    >> copyFiles >> templateReplace >> stageWorkdir >> stageHardlinks
+    >> stagePoolSize >> pluginLibraryPath >> numpyFlag
+    >> columnarFlag;
 }
 
 
@@ -72,16 +90,22 @@ void DataInterfaceRep::write(std::ostream& s) const
 {
   s << idInterface << interfaceType << algebraicMappings << analysisDrivers
     << analysisComponents << inputFilter << outputFilter << parametersFile
-    << resultsFile << allowExistingResultsFlag  << verbatimFlag << apreproFlag 
+    << resultsFile << allowExistingResultsFlag  << verbatimFlag
+    << processLauncherFlag << apreproFlag 
     << resultsFileFormat << fileTagFlag << fileSaveFlag //<< gridHostNames << gridProcsPerHost
     << batchEvalFlag << asynchFlag << asynchLocalEvalConcurrency
     << asynchLocalEvalScheduling << asynchLocalAnalysisConcurrency
-    << evalServers << evalScheduling << procsPerEval << analysisServers
+    << evalServers << evalScheduling << evalChunkingFlag << evalChunkMax
+    << costAwareSchedFlag << procsPerEval << analysisServers
     << analysisScheduling << procsPerAnalysis << failAction << retryLimit
     << recoveryFnVals << activeSetVectorFlag << evalCacheFlag
-    << nearbyEvalCacheFlag << nearbyEvalCacheTol << restartFileFlag
+    << nearbyEvalCacheFlag << nearbyEvalCacheTol << evalCacheType
+    << evalCacheShards << evalCacheMaxEntries << evalCacheMaxMemory
+    << evalCacheSpillFile << restartFileFlag
     << useWorkdir << workDir << dirTag << dirSave << linkFiles
-    << copyFiles << templateReplace << pluginLibraryPath << numpyFlag;
+    << copyFiles << templateReplace << stageWorkdir << stageHardlinks
+    << stagePoolSize << pluginLibraryPath << numpyFlag
+    << columnarFlag;
 }
 
 
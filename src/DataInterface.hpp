@@ -60,6 +60,9 @@ inline String interface_enum_to_string(unsigned short interface_type)
 /// interface synchronization types 
 enum { SYNCHRONOUS_INTERFACE, ASYNCHRONOUS_INTERFACE };
 
+/// evaluation cache implementations used for duplicate detection
+enum { MULTI_INDEX_CACHE, SHARDED_CACHE };
+
 /// define algebraic function types
 enum { OBJECTIVE, INEQUALITY_CONSTRAINT, EQUALITY_CONSTRAINT };
 
@@ -127,6 +130,10 @@ public:
   /// analysis_drivers/input_filter/output_filter syntax (from the \c
   /// verbatim specification in \ref InterfApplicSC and \ref InterfApplicF)
   bool verbatimFlag;
+  /// flag for starting fork interface programs through a persistent
+  /// launcher process (from the \c process_launcher specification in
+  /// \ref InterfApplicF)
+  bool processLauncherFlag;
   /// flag for aprepro format usage in the parameters file for
   /// system call and fork interfaces (from the \c aprepro
   /// specification in \ref InterfApplicSC and \ref InterfApplicF)
@@ -170,6 +177,17 @@ public:
   /// within an iterator: {DEFAULT,MASTER,PEER_DYNAMIC,PEER_STATIC}_SCHEDULING 
   /// (from the \c evaluation_scheduling specification in \ref InterfIndControl)
   short evalScheduling;
+  /// flag for packing several evaluations into each message sent by a
+  /// dedicated master to its synchronous evaluation servers (from the
+  /// \c chunk_evaluations specification in \ref InterfIndControl)
+  bool evalChunkingFlag;
+  /// maximum number of evaluations per chunked message (from the
+  /// \c max_chunk_size specification in \ref InterfIndControl)
+  int evalChunkMax;
+  /// flag for dispatching evaluations longest-predicted-first, using
+  /// wall times observed by the interface (from the
+  /// \c cost_aware_scheduling specification in \ref InterfIndControl)
+  bool costAwareSchedFlag;
   /// processors per parallel evaluation within the parallel configuration
   /// (from the \c processors_per_evaluation spec in \ref InterfIndControl)
   int procsPerEval;
@@ -208,6 +226,22 @@ public:
   bool nearbyEvalCacheFlag;
   /// numerical tolerance for nearby evaluation cache lookups
   Real nearbyEvalCacheTol;
+  /// evaluation cache implementation: MULTI_INDEX_CACHE (default) or
+  /// SHARDED_CACHE (from the \c evaluation_cache specification in
+  /// \ref InterfIndControl)
+  short evalCacheType;
+  /// number of shards for a SHARDED_CACHE (from the \c shards
+  /// specification in \ref InterfIndControl)
+  int evalCacheShards;
+  /// maximum number of resident records for a SHARDED_CACHE (from the
+  /// \c max_entries specification in \ref InterfIndControl)
+  int evalCacheMaxEntries;
+  /// maximum resident memory (MB) for a SHARDED_CACHE (from the
+  /// \c max_memory specification in \ref InterfIndControl)
+  Real evalCacheMaxMemory;
+  /// file receiving records evicted from a SHARDED_CACHE (from the
+  /// \c spill_file specification in \ref InterfIndControl)
+  String evalCacheSpillFile;
   /// function evaluation cache: 1=active (all new evaluations written to
   /// restart), 0=inactive (no records written to restart) (from the
   /// \c deactivate \c restart_file specification in \ref InterfIndControl)
@@ -226,10 +260,22 @@ public:
   StringArray copyFiles;
   /// whether to replace / overwrite existing files
   bool templateReplace;
+  /// whether to stage work directories from a snapshot of the link_files
+  /// and copy_files (from the \c staged specification)
+  bool stageWorkdir;
+  /// whether staged files are hardlinks to the snapshot (from the \c
+  /// hardlinks specification)
+  bool stageHardlinks;
+  /// maximum number of removed work directories kept for reuse (from
+  /// the \c pool_size specification)
+  int stagePoolSize;
   /// path to plugin to runtime load
   String pluginLibraryPath;
   /// Python interface: use NumPy data structures (default is list data)
   bool numpyFlag;
+  /// Python interface: pass batches as one dict of NumPy arrays
+  /// (default is a list of per-evaluation dicts)
+  bool columnarFlag;
 
 private:
 
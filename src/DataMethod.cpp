@@ -22,6 +22,7 @@ DataMethodRep::DataMethodRep():
   maxRefineIterations(SZ_MAX), maxSolverIterations(SZ_MAX),
   maxFunctionEvals(SZ_MAX), speculativeFlag(false), methodUseDerivsFlag(false),
   constraintTolerance(0.), methodScaling(false), numFinalSolutions(0),
+  evaluationWindow(0),
   convergenceTolerance(-std::numeric_limits<double>::max()),
   relativeConvMetric(true), statsMetricMode(Pecos::DEFAULT_EXPANSION_STATS),
   methodName(DEFAULT_METHOD), subMethod(SUBMETHOD_DEFAULT),
@@ -124,11 +125,13 @@ DataMethodRep::DataMethodRep():
   fixedSequenceFlag(false), //default is variable sampling patterns
   vbdFlag(false),vbdDropTolerance(-1.),
   vbdViaSamplingMethod(VBD_PICK_AND_FREEZE),vbdViaSamplingNumBins(-1),
+  vbdBootstrapSamples(0),
   backfillFlag(false), pcaFlag(false),
   percentVarianceExplained(0.95), wilksFlag(false), wilksOrder(1),
   wilksConfidenceLevel(0.95), wilksSidedInterval(ONE_SIDED_UPPER),
   // NonD
   toleranceIntervalsFlag(false), tiCoverage(0.95), tiConfidenceLevel(0.90),
+  streamingStatsFlag(false), quantileSketchSize(4096),
   stdRegressionCoeffs(false),
   respScalingFlag(false), vbdOrder(0), covarianceControl(DEFAULT_COVARIANCE),
   rngName("mt19937"), refinementType(Pecos::NO_REFINEMENT),
@@ -208,6 +211,7 @@ void DataMethodRep::write(MPIPackBuffer& s) const
     << maxIterations << maxRefineIterations << maxSolverIterations
     << maxFunctionEvals << speculativeFlag << methodUseDerivsFlag
     << constraintTolerance << methodScaling << numFinalSolutions
+    << evaluationWindow
     << convergenceTolerance << relativeConvMetric << statsMetricMode
     << methodName << subMethod << subMethodName << subModelPointer
     << subMethodPointer;
@@ -300,13 +304,14 @@ void DataMethodRep::write(MPIPackBuffer& s) const
   // NonD & DACE
   s << numSamples << fixedSeedFlag << fixedSequenceFlag
     << vbdFlag << vbdDropTolerance
-    << vbdViaSamplingMethod << vbdViaSamplingNumBins
+    << vbdViaSamplingMethod << vbdViaSamplingNumBins << vbdBootstrapSamples
     << backfillFlag << pcaFlag
     << percentVarianceExplained << wilksFlag << wilksOrder
     << wilksConfidenceLevel << wilksSidedInterval;
 
   // NonD
   s << toleranceIntervalsFlag << tiCoverage << tiConfidenceLevel
+    << streamingStatsFlag << quantileSketchSize
     << stdRegressionCoeffs << respScalingFlag << vbdOrder << covarianceControl << rngName
     << refinementType << refinementControl << nestingOverride << growthOverride
     << expansionType << piecewiseBasis << expansionBasisType
@@ -385,6 +390,7 @@ void DataMethodRep::read(MPIUnpackBuffer& s)
     >> maxIterations >> maxRefineIterations >> maxSolverIterations
     >> maxFunctionEvals >> speculativeFlag >> methodUseDerivsFlag
     >> constraintTolerance >> methodScaling >> numFinalSolutions
+    >> evaluationWindow
     >> convergenceTolerance >> relativeConvMetric >> statsMetricMode
     >> methodName >> subMethod >> subMethodName >> subModelPointer
     >> subMethodPointer;
@@ -477,13 +483,14 @@ void DataMethodRep::read(MPIUnpackBuffer& s)
   // NonD & DACE
   s >> numSamples >> fixedSeedFlag >> fixedSequenceFlag
     >> vbdFlag >> vbdDropTolerance
-    >> vbdViaSamplingMethod >> vbdViaSamplingNumBins
+    >> vbdViaSamplingMethod >> vbdViaSamplingNumBins >> vbdBootstrapSamples
     >> backfillFlag >> pcaFlag
     >> percentVarianceExplained >> wilksFlag >> wilksOrder
     >> wilksConfidenceLevel >> wilksSidedInterval;
 
   // NonD
   s >> toleranceIntervalsFlag >> tiCoverage >> tiConfidenceLevel
+    >> streamingStatsFlag >> quantileSketchSize
     >> stdRegressionCoeffs >> respScalingFlag >> vbdOrder >> covarianceControl >> rngName
     >> refinementType >> refinementControl >> nestingOverride >> growthOverride
     >> expansionType >> piecewiseBasis >> expansionBasisType
@@ -562,6 +569,7 @@ void DataMethodRep::write(std::ostream& s) const
     << maxIterations << maxRefineIterations << maxSolverIterations
     << maxFunctionEvals << speculativeFlag << methodUseDerivsFlag
     << constraintTolerance << methodScaling << numFinalSolutions
+    << evaluationWindow
     << convergenceTolerance << relativeConvMetric << statsMetricMode
     << methodName << subMethod << subMethodName << subModelPointer
     << subMethodPointer;
@@ -654,13 +662,14 @@ void DataMethodRep::write(std::ostream& s) const
   // NonD & DACE
   s << numSamples << fixedSeedFlag << fixedSequenceFlag
     << vbdFlag << vbdDropTolerance
-    << vbdViaSamplingMethod << vbdViaSamplingNumBins
+    << vbdViaSamplingMethod << vbdViaSamplingNumBins << vbdBootstrapSamples
     << backfillFlag << pcaFlag
     << percentVarianceExplained << wilksFlag << wilksOrder
     << wilksConfidenceLevel << wilksSidedInterval;
 
   // NonD
   s << toleranceIntervalsFlag << tiCoverage << tiConfidenceLevel
+    << streamingStatsFlag << quantileSketchSize
     << stdRegressionCoeffs << respScalingFlag << vbdOrder << covarianceControl << rngName
     << refinementType << refinementControl << nestingOverride << growthOverride
     << expansionType << piecewiseBasis << expansionBasisType
@@ -339,6 +339,10 @@ public:
   bool methodScaling;
   /// number of final solutions returned from the iterator
   size_t numFinalSolutions;
+  /// maximum number of asynchronous evaluations an Analyzer holds in
+  /// flight, if nonzero (from the \c evaluation_window specification in
+  /// \ref MethodIndControl)
+  size_t evaluationWindow;
 
   /// iteration convergence tolerance for the method (from the \c
   /// convergence_tolerance specification in \ref MethodIndControl)
@@ -868,6 +872,9 @@ public:
   unsigned short vbdViaSamplingMethod;
   /// Number of bins to use in case the Mahadevan method is selected (default is the square root of the number of samples)
   int vbdViaSamplingNumBins;
+  /// Number of bootstrap resamples for confidence intervals on the
+  /// pick-and-freeze indices (default 0: no intervals)
+  int vbdBootstrapSamples;
   /// the \c backfill option allows one to augment in LHS sample
   /// by enforcing the addition of unique discrete variables to the sample
   bool backfillFlag;
@@ -937,6 +944,13 @@ public:
   /// Confidence level parameter for the calculation of double sided tolerance interval equivalent normal
   Real tiConfidenceLevel;
 
+  /// flag to accumulate sampling statistics in a single pass as
+  /// evaluations complete, without storing the sampled responses
+  bool streamingStatsFlag;
+  /// number of items retained per level of the quantile sketches used
+  /// for streaming probability level mappings
+  size_t quantileSketchSize;
+
   /// flag to indicate bounds-based scaling of current response data set
   /// prior to build in surrogate-based methods; important for ML/MF data fits
   /// of decaying discrepancy data using regression with absolute tolerances
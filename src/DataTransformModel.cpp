@@ -10,14 +10,13 @@
 #include "DataTransformModel.hpp"
 #include "ExperimentData.hpp"
 #include "DakotaMinimizer.hpp"
-#include "PRPMultiIndex.hpp"
+#include "PRPShardedCache.hpp"
 #include "ResultsManager.hpp"
 
 static const char rcsId[]="@(#) $Id$";
 
 namespace Dakota {
 
-extern PRPCache data_pairs; // global container
 
 /// initialization of static needed by RecastModel
 DataTransformModel* DataTransformModel::dtModelInstance(NULL);
@@ -1173,10 +1172,10 @@ recover_submodel_responses(std::ostream& s,
     bool lookup_failure = false;
     // BMA: why is this necessary?  Should have a reference to same object as PRP
     lookup_pr.variables(lookup_vars);
-    PRPCacheHIter cache_it = lookup_by_val(data_pairs, lookup_pr);
+    ParamResponsePair cache_pr;
 
     // TODO: allow exact or partial match...
-    if (cache_it == data_pairs.get<hashed>().end()) {
+    if (!lookup_evaluation(lookup_pr, cache_pr)) {
 
       // If model is a data fit surrogate, re-evaluate it if needed.
       // Didn't use != "ensemble" in case other surrogate types are added.
@@ -1203,7 +1202,7 @@ recover_submodel_responses(std::ostream& s,
       }
     }
     else {
-      model_resp = cache_it->response();
+      model_resp = cache_pr.response();
     }
 
     if (lookup_failure) {
@@ -1317,8 +1316,8 @@ archive_submodel_responses(const ResultsManager &results_db,
     bool lookup_failure = false;
     // BMA: why is this necessary?  Should have a reference to same object as PRP
     lookup_pr.variables(lookup_vars);
-    PRPCacheHIter cache_it = lookup_by_val(data_pairs, lookup_pr);
-    if (cache_it == data_pairs.get<hashed>().end()) {
+    ParamResponsePair cache_pr;
+    if (!lookup_evaluation(lookup_pr, cache_pr)) {
 
       // If model is a data fit surrogate, re-evaluate it if needed.
       // Didn't use != "ensemble" in case other surrogate types are added.
@@ -1339,7 +1338,7 @@ archive_submodel_responses(const ResultsManager &results_db,
       }
     }
     else {
-      model_resp = cache_it->response();
+      model_resp = cache_pr.response();
     }
 
     if (!lookup_failure) {
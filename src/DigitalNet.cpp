@@ -703,6 +703,8 @@ void DigitalNet::bitreverse_generating_matrices()
 /// This function will store the points in-place in the matrix `points`
 /// Each column of `points` contains a `dimension`-dimensional point
 /// where `dimension` is equal to the number of rows of `points`
+/// NOTE: the points are generated in blocks of consecutive indices, one
+/// block per thread, see `generate_points`
 void DigitalNet::unsafe_get_points(
   const size_t nMin,
   const size_t nMax, 
@@ -717,50 +719,80 @@ void DigitalNet::unsafe_get_points(
     abort_handler(METHOD_ERROR);
   }
 
-  /// Iterativey generate all points up to `nMin-1`
-  UInt64Vector current_point(points.numRows()); /// Set to 0 by default
-  for ( size_t k = 0; k < nMin; k++ )
-  {
-    next(k, current_point);
-  }
-
   /// Generate points between `nMin` and `nMax`
-  int digits = std::numeric_limits<UInt64>::digits;
-  double oneOnPow2tScramble = 1 / Real(UInt64(1) << digits - 1) / 2; /// 1 / 2^(-tMax)
-  for ( UInt64 k = nMin; k < nMax; ++k ) /// Loop over all points
-  {
-    next(k, current_point); /// Generate the next point as UInt64Vector
-    auto idx = (this->*reorder)(k);
-    for ( int j = 0; j < points.numRows(); j++ ) /// Loop over all dimensions
+  generate_in_parallel(nMin, nMax, points.numRows(),
+    [this, nMin, &points](size_t first, size_t last)
     {
-      points(j, idx - nMin) = 
-        (current_point[j] ^ digitalShift[j]) * oneOnPow2tScramble; // apply digital shift
+      generate_points(first, last, nMin, points);
     }
-  }
+  );
 }
 
-/// Get the next point of the sequence represented as an unsigned integer
-/// vector
+/// Generates the digital net points with index `first`, `first` + 1, ...,
+/// `last` - 1 and stores them in the columns of `points` offset by `nMin`
 /// NOTE: Uses the Antonov & Saleev (1979) iterative construction:
-/// knowing the current point with index `k`, the next point with index `k + 1`
+/// knowing the current point with index `k - 1`, the point with index `k`
 /// is obtained by XOR'ing the current point with the `n`-th column of the 
 /// `j`-th generating matrix, i.e.,
 ///
-///                   x_{k+1}[j] = x_{k}[j] ^ C[j][n]
+///                   x_{k}[j] = x_{k-1}[j] ^ C[j][n]
 ///
-/// where `n` is the rightmost zero-bit of `k` (= the position of the bit that 
-/// will change from `k` to `k+1` in Gray code)
-void DigitalNet::next(
-  int k,
-  UInt64Vector& current_point
+/// where `n` is the rightmost one-bit of `k` (= the position of the bit that 
+/// changes from `k - 1` to `k` in Gray code)
+/// Unrolling the recursion, the point with index `first` is the XOR of the
+/// columns of the generating matrices at the one-bits of the Gray code of
+/// `first`, so that each block can start at an arbitrary index
+/// The generating matrices are stored by column, so each update is an XOR
+/// of two contiguous arrays over all dimensions, fused with the digital
+/// shift and the conversion to [0, 1)
+void DigitalNet::generate_points(
+  const UInt64 first,
+  const UInt64 last,
+  const size_t nMin,
+  RealMatrix& points
 )
 {
-  if ( k == 0 )
-    return;
-  auto n = count_consecutive_trailing_zero_bits(k); // From "dakota_bit_utils"
-  for ( size_t j = 0; j < current_point.length(); j++ ) // Loop over dimensions
+  int dimension = points.numRows();
+  int digits = std::numeric_limits<UInt64>::digits;
+  double oneOnPow2tScramble = 1 / Real(UInt64(1) << digits - 1) / 2; /// 1 / 2^(-tMax)
+  const UInt64* shift = digitalShift.values();
+
+  /// Skip ahead to the point with index `first`
+  std::vector<UInt64> current_point(dimension, 0);
+  UInt64* x = current_point.data();
+  UInt64 gray = binary2gray(first);
+  for ( int n = 0; gray; ++n, gray >>= 1 )
   {
-    current_point[j] ^= scrambledGeneratingMatrices(j, n); // ^ is xor
+    if ( gray & 1 )
+    {
+      const UInt64* column = &scrambledGeneratingMatrices(0, n);
+      for ( int j = 0; j < dimension; ++j )
+      {
+        x[j] ^= column[j];
+      }
+    }
+  }
+
+  for ( UInt64 k = first; k < last; ++k ) /// Loop over all points
+  {
+    Real* point = points[(this->*reorder)(k) - nMin];
+    if ( k == first )
+    {
+      for ( int j = 0; j < dimension; ++j )
+      {
+        point[j] = (x[j] ^ shift[j]) * oneOnPow2tScramble; // apply digital shift
+      }
+    }
+    else
+    {
+      auto n = count_consecutive_trailing_zero_bits(k); // From "dakota_bit_utils"
+      const UInt64* column = &scrambledGeneratingMatrices(0, n);
+      for ( int j = 0; j < dimension; ++j ) /// Loop over all dimensions
+      {
+        x[j] ^= column[j]; // ^ is xor
+        point[j] = (x[j] ^ shift[j]) * oneOnPow2tScramble; // apply digital shift
+      }
+    }
   }
 }
 
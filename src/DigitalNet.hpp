@@ -91,6 +91,10 @@ public:
   /// Do not apply linear matrix scramble to this digital net
   void no_scrambling() { scramble(-1); }
 
+  /// Natural ordering requires a power of 2 number of points per request
+  bool consecutive_blocks() const
+    { return ordering != DIGITAL_NET_NATURAL_ORDERING; }
+
 private:
 
   /// Generating matrices of this digital net
@@ -170,11 +174,13 @@ private:
     RealMatrix& points
   );
 
-  /// Get the next point of the sequence represented as an unsigned integer
-  /// vector
-  void next(
-    int n,
-    UInt64Vector& current_point
+  /// Generates the digital net points with index `first`, `first` + 1,
+  /// ..., `last` - 1, starting from the Gray code of `first`
+  void generate_points(
+    const UInt64 first,
+    const UInt64 last,
+    const size_t nMin,
+    RealMatrix& points
   );
 
   /// Position of the `k`th digital net point in DIGITAL_NET_NATURAL_ORDERING
@@ -12,6 +12,7 @@
 #include "ProblemDescDB.hpp"
 #include "ParallelLibrary.hpp"
 #include <algorithm>
+#include <chrono>
 
 namespace Dakota {
 
@@ -56,7 +57,10 @@ DirectApplicInterface(const ProblemDescDB& problem_db):
 
 
 DirectApplicInterface::~DirectApplicInterface()
-{ }
+{
+  // join the workers prior to destruction of the completion bookkeeping
+  threadPool.reset();
+}
 
 
 void DirectApplicInterface::
@@ -274,68 +278,148 @@ int DirectApplicInterface::derived_map_of(const String& of_name)
 }
 
 
+void DirectApplicInterface::
+derived_map_reentrant(const Variables& vars, const ActiveSet& set,
+		      Response& response, int fn_eval_id)
+{
+  Cerr << "Error: no reentrant evaluation is available for the analysis "
+       << "drivers of\nDirectApplicInterface." << std::endl;
+  abort_handler(INTERFACE_ERROR);
+}
+
+
+/** For interfaces supporting reentrant evaluations, the job is queued
+    on a work-stealing thread pool sized by the asynchronous local
+    evaluation concurrency (the schedulers in ApplicationInterface
+    bound the number of jobs in flight).  The PRP shares its Response
+    representation with the queued job, such that results are written
+    in place and need no copy upon completion. */
 void DirectApplicInterface::derived_map_asynch(const ParamResponsePair& pair)
 {
-  Cerr << "Error: asynchronous capability (multiple threads) not installed in"
-       << "\nDirectApplicInterface." << std::endl;
-  abort_handler(-1);
-
-  //pthread_create/thr_create(derived_map(...)) launches a new thread
-  //threadIdMap[tid] = fn_eval_id;
-
-  // Design note, 10/2013: the heavy fork() approach that already exists in
-  // ProcessHandleApplicInterface::create_evaluation_process() would be a
-  // quick and easy substitute for POSIX threads.  While this would work
-  // nicely for managing job concurrency with code that's already in hand
-  // (assuming sufficient memory for the required heavy fork() concurrency),
-  // there is no simple way to get response results back to the parent
-  // process from the child.  Short of resorting to the file system, there
-  // are examples of using pipes to accomplish this, but this moves the
-  // idea away from the state of low risk / high payoff.
+  // batch jobs are deferred until synchronization (see launch_asynch_local())
+  if (batchEval)
+    return;
+
+  if (!reentrant_map()) {
+    Cerr << "Error: asynchronous capability (multiple threads) not available "
+	 << "for the\nanalysis drivers of DirectApplicInterface." << std::endl;
+    abort_handler(-1);
+  }
+
+  if (!threadPool) {
+    // 0 (unlimited) defers to the hardware concurrency
+    size_t num_threads = (asynchLocalEvalConcurrency > 0) ?
+      asynchLocalEvalConcurrency :
+      std::max(1u, std::thread::hardware_concurrency());
+    threadPool.reset(new dakota::util::WorkStealingThreadPool(num_threads));
+    if (outputLevel >= VERBOSE_OUTPUT)
+      Cout << "Direct interface: evaluating asynchronously on "
+	   << threadPool->num_threads() << " threads." << std::endl;
+  }
+
+  // shallow copies share representations with the queued PRP; capture
+  // them here since the PRP may not be accessed from the workers
+  int fn_eval_id = pair.eval_id();
+  Variables vars = pair.variables();  Response response = pair.response();
+  ActiveSet set = response.active_set();
+  threadPool->submit([this, vars, set, response, fn_eval_id]() mutable {
+    std::exception_ptr error;
+    try { derived_map_reentrant(vars, set, response, fn_eval_id); }
+    catch (...) { error = std::current_exception(); }
+    {
+      std::lock_guard<std::mutex> lock(threadMutex);
+      threadCompletions[fn_eval_id] = error;
+    }
+    threadCond.notify_one();
+  });
 }
 
 
 void DirectApplicInterface::wait_local_evaluations(PRPQueue& prp_queue)
 {
-  Cerr << "Error: asynchronous capability (multiple threads) not installed in"
-       << "\nDirectApplicInterface." << std::endl;
-  abort_handler(-1);
-
-  /*
-  PRPQueueIter queue_it = lookup_by_eval_id(prp_queue, fn_eval_id);
-  if (queue_it == prp_queue.end()) {
-    Cerr << "Error: failure in queue lookup within DirectApplicInterface::"
-	 << "wait_local_evaluations()." << std::endl;
-    abort_handler(-1);
+  if (batchEval) {
+    derived_map_batch(prp_queue);
+    for (PRPQueueIter it=prp_queue.begin(); it!=prp_queue.end(); ++it)
+      completionSet.insert(it->eval_id());
   }
-  int fail_code = 0, id = queue_it->eval_id();
-  Variables    vars = queue_it->variables(); // shallow copy
-  Response response = queue_it->response();  // shallow copy
-
-  // pthread_join/thr_join(target_thread, ..., status) recovers threads.
-  // status provides a mechanism to return failure codes from analyses.
-  // The Solaris thr_join allows completion of any thread in the set if 
-  // target_thread is set to 0; unfortunately, this does not appear to be part
-  // of the POSIX standard (pthread_join must complete a valid target_thread).
-
-  // Possible better solution: look at OpenMP ??
-
-  // For the asynch case, Direct (unlike SysCall) can manage failures w/o 
-  // throwing exceptions.  See ApplicationInterface::manage_failure for notes.
-  if (fail_code)
-    manage_failure(vars, response.active_set(), response, id);
-
-  Cout << "Thread for evaluation " << id << " captured.\n";
-  queue_it->response(response);
-  */
+  else
+    harvest_thread_completions(prp_queue, true);
 }
 
 
+/** A batch completes within the call, as for wait_local_evaluations(). */
 void DirectApplicInterface::test_local_evaluations(PRPQueue& prp_queue)
 {
-  Cerr << "Error: asynchronous capability (multiple threads) not installed in"
-       << "\nDirectApplicInterface." << std::endl;
-  abort_handler(-1);
+  if (batchEval)
+    wait_local_evaluations(prp_queue);
+  else
+    harvest_thread_completions(prp_queue, false);
+}
+
+
+void DirectApplicInterface::derived_map_batch(PRPQueue& prp_queue)
+{
+  for (PRPQueueIter it=prp_queue.begin(); it!=prp_queue.end(); ++it) {
+    Response response = it->response(); // shallow copy
+    try {
+      derived_map(it->variables(), response.active_set(), response,
+		  it->eval_id());
+    }
+    catch (const FunctionEvalFailure& fneval_except) {
+      manage_failure(it->variables(), response.active_set(), response,
+		     it->eval_id());
+    }
+  }
+}
+
+
+void DirectApplicInterface::
+harvest_thread_completions(PRPQueue& prp_queue, bool block)
+{
+  if (!threadPool) {
+    Cerr << "Error: asynchronous capability (multiple threads) not available "
+	 << "for the\nanalysis drivers of DirectApplicInterface." << std::endl;
+    abort_handler(-1);
+  }
+
+  std::map<int, std::exception_ptr> completed;
+  {
+    std::unique_lock<std::mutex> lock(threadMutex);
+    auto any_complete = [this]() { return !threadCompletions.empty(); };
+    if (block)
+      threadCond.wait(lock, any_complete);
+    else // as for Fork and System, reduce processor load from testing
+      threadCond.wait_for(lock, std::chrono::milliseconds(1), any_complete);
+    completed.swap(threadCompletions);
+  }
+
+  // Failures are processed on the calling thread: as for the Fork and
+  // System asynch cases, FunctionEvalFailure is managed (recover, retry,
+  // etc.) without unwinding the scheduler.
+  for (std::map<int, std::exception_ptr>::iterator it = completed.begin();
+       it != completed.end(); ++it) {
+    int fn_eval_id = it->first;
+    if (it->second) {
+      PRPQueueIter queue_it = lookup_by_eval_id(prp_queue, fn_eval_id);
+      if (queue_it == prp_queue.end()) {
+	Cerr << "Error: failure in queue lookup within DirectApplicInterface::"
+	     << "harvest_thread_completions()." << std::endl;
+	abort_handler(-1);
+      }
+      Response response = queue_it->response(); // shallow copy
+      try { std::rethrow_exception(it->second); }
+      catch (const FunctionEvalFailure& fneval_except) {
+	manage_failure(queue_it->variables(), response.active_set(), response,
+		       fn_eval_id);
+      }
+      catch (const std::exception& e) {
+	Cerr << "Error: threaded evaluation " << fn_eval_id << " failed:\n"
+	     << e.what() << std::endl;
+	abort_handler(INTERFACE_ERROR);
+      }
+    }
+    completionSet.insert(fn_eval_id);
+  }
 }
 
 
@@ -11,9 +11,11 @@
 #define DIRECT_APPLIC_INTERFACE_H
 
 #include "ApplicationInterface.hpp"
-//#ifndef OSF
-//#include <pthread.h>
-//#endif
+#include "WorkStealingThreadPool.hpp"
+
+#include <condition_variable>
+#include <exception>
+#include <mutex>
 
 namespace Dakota {
 
@@ -113,6 +115,19 @@ protected:
   /// execute the output filter portion of a direct evaluation invocation
   virtual int derived_map_of(const Dakota::String& of_name);
 
+  /// whether derived_map_reentrant() supports the analysis drivers, in
+  /// which case asynchronous local evaluations execute on a thread pool
+  virtual bool reentrant_map() const;
+  /// perform a complete evaluation without use of the class-scope
+  /// evaluation data (xC, fnVals, etc.), such that concurrent invocations
+  /// from the thread pool are safe; failures are reported by throwing
+  virtual void derived_map_reentrant(const Variables& vars,
+				     const ActiveSet& set, Response& response,
+				     int fn_eval_id);
+  /// evaluate all jobs of prp_queue as one batch (batch interface mode);
+  /// default evaluates the jobs in turn using derived_map()
+  virtual void derived_map_batch(PRPQueue& prp_queue);
+
   //
   //- Heading: Methods
   //
@@ -135,6 +150,10 @@ protected:
   /// response contributions from multiple analyses using MPI_Reduce
   void overlay_response(Response& response);
 
+  /// move evaluations completed by threadPool into completionSet,
+  /// optionally blocking until at least one is available
+  void harvest_thread_completions(PRPQueue& prp_queue, bool block);
+
   //
   //- Heading: Data
   //
@@ -144,8 +163,16 @@ protected:
   driver_t iFilterType; ///< enum type of the direct function input filter
   driver_t oFilterType; ///< enum type of the direct function output filter
 
-  // map of pthread id's to function evaluation id's for asynch evaluations
-  //std::map<pthread_t, int> threadIdMap;
+  /// thread pool executing asynchronous local evaluations (constructed
+  /// on first use, sized by the asynchronous evaluation concurrency)
+  std::unique_ptr<dakota::util::WorkStealingThreadPool> threadPool;
+  /// protects threadCompletions
+  std::mutex threadMutex;
+  /// signaled when an entry is added to threadCompletions
+  std::condition_variable threadCond;
+  /// evaluations completed on threadPool and not yet harvested, with any
+  /// exception thrown by derived_map_reentrant()
+  std::map<int, std::exception_ptr> threadCompletions;
 
   // data used by direct fns is class scope to allow common utility usage
   bool gradFlag;  ///< signals use of fnGrads in direct simulator functions
@@ -258,7 +285,8 @@ inline void DirectApplicInterface::
 init_communicators_checks(int max_eval_concurrency)
 {
   bool warn = true;
-  check_asynchronous(warn, max_eval_concurrency);
+  if (!batchEval && !reentrant_map()) // else batched or threaded
+    check_asynchronous(warn, max_eval_concurrency);
   check_multiprocessor_asynchronous(warn, max_eval_concurrency);
 }
 
@@ -267,13 +295,19 @@ init_communicators_checks(int max_eval_concurrency)
 inline void DirectApplicInterface::
 set_communicators_checks(int max_eval_concurrency)
 {
-  bool warn = false,  mp1 = check_asynchronous(warn, max_eval_concurrency),
+  bool warn = false,
+       mp1 = (!batchEval && !reentrant_map() &&
+	      check_asynchronous(warn, max_eval_concurrency)),
        mp2 = check_multiprocessor_asynchronous(warn, max_eval_concurrency);
   if (mp1 || mp2)
     abort_handler(-1);
 }
 
 
+inline bool DirectApplicInterface::reentrant_map() const
+{ return false; }
+
+
 //inline void DirectApplicInterface::clear_bookkeeping()
 //{ threadIdMap.clear(); }
 
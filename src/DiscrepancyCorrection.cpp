@@ -11,7 +11,7 @@
 #include "dakota_data_io.hpp"
 #include "DiscrepancyCorrection.hpp"
 #include "ParamResponsePair.hpp"
-#include "PRPMultiIndex.hpp"
+#include "PRPShardedCache.hpp"
 #include "SurrogateData.hpp"
 #include "DataMethod.hpp"
 
@@ -22,7 +22,6 @@ static const char rcsId[]="@(#) $Id: DiscrepancyCorrection.cpp 7024 2010-10-16 0
 
 namespace Dakota {
 
-extern PRPCache data_pairs; // global container
 
 void DiscrepancyCorrection::
 initialize(Model& surr_model, const SizetSet& surr_fn_indices,
@@ -834,34 +833,33 @@ compute_variance(const VariablesArray& vars_array, RealMatrix& approx_variance,
 }
 
 
-const Response& DiscrepancyCorrection::
+Response DiscrepancyCorrection::
 search_db(const Variables& search_vars, const ShortArray& search_asv)
 {
   // Retrieve missing uncorrected approximate data for use in derivative
   // multiplicative corrections.  The correct approach is to retrieve the
   // missing data for the current point in parameter space, and this approach
   // is when data is either available directly as indicated by the asv, can be
-  // retrieved via a data_pairs search, or can be recomputed).  A final fallback
+  // retrieved via an evaluation cache search, or can be recomputed).  A final fallback
   // is to employ approx center data; this approach is used when surrModel has
   // not been initialized (see apply_multiplicative()).  Recomputation can occur
   // either for ApproximationInterface data in DataFitSurrModels or low fidelity
   // data in EnsembleSurrModels that involves additional model recursions, since
   // neither of these data sets are catalogued in data_pairs.
 
-  // query data_pairs to extract the response at the current pt
+  // query the evaluation cache to extract the response at the current pt
   ActiveSet search_set = surrModel.current_response().active_set(); // copy
   search_set.request_vector(search_asv);
-  PRPCacheHIter cache_it = lookup_by_val(data_pairs, surrModel.interface_id(),
-					 search_vars, search_set);
-
-  if (cache_it == data_pairs.get<hashed>().end()) {
+  ParamResponsePair cache_pr;
+  if (!lookup_evaluation(surrModel.interface_id(), search_vars, search_set,
+			 cache_pr)) {
     // perform approx fn eval to retrieve missing data
     surrModel.active_variables(search_vars);
     surrModel.evaluate(search_set);
     return surrModel.current_response();
   }
   else
-    return cache_it->response();
+    return cache_pr.response();
 }
 
 } // namespace Dakota
@@ -182,9 +182,9 @@ private:
   /// to a set of response functions
   void apply_multiplicative(const Variables& vars, RealVector& approx_fns);
 
-  /// search data_pairs for missing approximation data
-  const Response& search_db(const  Variables& search_vars,
-			    const ShortArray& search_asv);
+  /// search the evaluation cache for missing approximation data
+  Response search_db(const  Variables& search_vars,
+		     const ShortArray& search_asv);
 
   //
   //- Heading: Data
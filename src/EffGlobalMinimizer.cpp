@@ -42,8 +42,18 @@ EffGlobalMinimizer(ProblemDescDB& problem_db, Model& model):
   batchSizeExploration(probDescDB.get_int("method.batch_size.exploration")),
   dataOrder(1), batchEvalId(1),
   batchAsynch(probDescDB.get_short("method.synchronization") ==
-	      NONBLOCKING_SYNCHRONIZATION)
+	      NONBLOCKING_SYNCHRONIZATION), lipschitzConstant(0.)
 {
+  // batch_selection is shared with adaptive_sampling, where the default is
+  // "naive"; for EGO, anything else than the specializations is a believer
+  const String& batch_sel = probDescDB.get_string("method.batch_selection");
+  if (batch_sel == "cl")
+    batchSelection = CONSTANT_LIAR_BATCH;
+  else if (batch_sel == "local_penalization")
+    batchSelection = LOCAL_PENALIZATION_BATCH;
+  else
+    batchSelection = KRIGING_BELIEVER_BATCH;
+
   // substract the total batchSize from batchSizeExploration
   batchSizeAcquisition = batchSize - batchSizeExploration;
 
@@ -106,7 +116,8 @@ EffGlobalMinimizer(Model& model, const String& approx_type, int samples,
   SurrBasedMinimizer(model, max_iter, max_eval, conv_tol,
 		     std::shared_ptr<TraitsBase>(new EffGlobalTraits())),
   batchSize(1), batchSizeExploration(0), dataOrder(1), batchEvalId(1),
-  batchAsynch(false)
+  batchAsynch(false), batchSelection(KRIGING_BELIEVER_BATCH),
+  lipschitzConstant(0.)
 {
   methodName = EFFICIENT_GLOBAL;
 
@@ -402,6 +413,9 @@ construct_batch_acquisition(size_t new_acq, size_t new_batch)
 
     // determine meritFnStar for use in EIF
     compute_best_sample();
+    // penalize the neighborhoods of pending jobs in lieu of liar responses
+    if (parallelFlag && batchSelection == LOCAL_PENALIZATION_BATCH)
+      update_local_penalizers();
 
     // execute GLOBAL search and retrieve results
     ParLevLIter pl_iter = methodPCIter->mi_parallel_level_iterator(miPLIndex);
@@ -423,7 +437,7 @@ construct_batch_acquisition(size_t new_acq, size_t new_batch)
     // approx sub-problem solve (cost does not justify increased complexity in
     // replace/pop logic).  But do suppress an unnecessary rebuild if last
     // look-ahead before truth synchronization, since this can be expensive.
-    if (parallelFlag) {
+    if (liar_batch()) {
       bool rebuild = (new_batch > new_acq || i+1 < new_acq);
       append_liar(vars_star, batchEvalId, rebuild);
     }
@@ -458,7 +472,11 @@ construct_batch_exploration(size_t new_expl, size_t new_batch)
 
     Cout << "\n>>>>> Initiating global iteration " << ++globalIterCount
 	 << " (exploration batch " << i+1 << ")\n";
-    
+
+    // penalize the neighborhoods of pending jobs in lieu of liar responses
+    if (parallelFlag && batchSelection == LOCAL_PENALIZATION_BATCH)
+      { compute_best_sample(); update_local_penalizers(); }
+
     // execute GLOBAL search and retrieve results
     ParLevLIter pl_iter = methodPCIter->mi_parallel_level_iterator(miPLIndex);
     approxSubProbMinimizer.reset();
@@ -484,7 +502,7 @@ construct_batch_exploration(size_t new_expl, size_t new_batch)
     // approx sub-problem solve (cost does not justify increased complexity in
     // replace/pop logic).  But do suppress an unnecessary rebuild if last
     // look-ahead before truth synchronization, since this can be expensive.
-    if (parallelFlag) {
+    if (liar_batch()) {
       bool rebuild = (i+1 < new_expl);
       append_liar(vars_star, batchEvalId, rebuild);
     }
@@ -508,13 +526,22 @@ append_liar(const Variables& vars_star, int liar_id, bool rebuild)
 	 << augmented_lagrangian(fhat_resp_star.function_values())
 	 << " [approx merit]\n";
 
+  // constant liar (CL-min): the liar takes the best QoI values among the
+  // build data rather than the GP prediction (kriging believer)
+  Response liar_resp = fhat_resp_star;
+  if (batchSelection == CONSTANT_LIAR_BATCH) {
+    liar_resp = fhat_resp_star.copy();
+    RealVector liar_fns = liar_resp.function_values_view();
+    extract_qoi_build_data(best_sample_index(), liar_fns);
+  }
+
   // update GP by appending constant liar to fHatModel (aka heuristic liar)
   // > Do not update constraint penalties/multipliers based on liar data, as
   //   these accumulate increments --> only accumulate once for truth data
   if (outputLevel >= DEBUG_OUTPUT)
     Cout << "\nParallel EGO: appending liar response for evaluation "
 	 << liar_id << ".\n";
-  IntResponsePair liar_resp_pr(liar_id, fhat_resp_star);
+  IntResponsePair liar_resp_pr(liar_id, liar_resp);
   fHatModel.append_approximation(vars_star, liar_resp_pr, rebuild);
   //numDataPts = fHatModel.approximation_data(0).points(); // updated count
 }
@@ -654,7 +681,22 @@ process_truth_response_map(const IntResponseMap& truth_resp_map, bool rebuild)
   if (truth_resp_map.empty()) return;
 
   // Process completions: replace liar resp w/ new truth resp based on eval ids
-  fHatModel.replace_approximation(truth_resp_map, rebuild);
+  if (liar_batch())
+    fHatModel.replace_approximation(truth_resp_map, rebuild);
+  else {
+    // no liars to replace: append truth data for the completed jobs
+    IntVariablesMap vars_map;  IntVarsMCIter a_cit, e_cit;
+    for (IntRespMCIter r_cit=truth_resp_map.begin();
+	 r_cit!=truth_resp_map.end(); ++r_cit) {
+      a_cit = varsAcquisitionMap.find(r_cit->first);
+      if (a_cit != varsAcquisitionMap.end())
+	vars_map.insert(*a_cit);
+      else if ((e_cit = varsExplorationMap.find(r_cit->first)) !=
+	       varsExplorationMap.end())
+	vars_map.insert(*e_cit);
+    }
+    fHatModel.append_approximation(vars_map, truth_resp_map, rebuild);
+  }
   // update constraints (truth resp only, not for liar resp)
   if (numNonlinearConstraints)
     update_constraints(truth_resp_map);
@@ -732,9 +774,22 @@ void EffGlobalMinimizer::extract_best_sample()
 {
   // pull the samples and responses from data used to build latest GP
   // to determine final cVarsStar and truthFnStar
+  size_t index_star = best_sample_index();
 
-  const Pecos::SurrogateData& gp_data_0 = fHatModel.approximation_data(0);
-  size_t i, index_star = 0, num_data_pts = gp_data_0.points();
+  // update best{Variables,Response}Array from index_star
+  const Pecos::SDVArray& sdv_array_0
+    = fHatModel.approximation_data(0).variables_data();
+  const RealVector& cv_star = sdv_array_0[index_star].continuous_variables();
+  bestVariablesArray.front().continuous_variables(cv_star);
+  RealVector fn_star = bestResponseArray.front().function_values_view();
+  extract_qoi_build_data(index_star, fn_star);
+}
+
+
+size_t EffGlobalMinimizer::best_sample_index()
+{
+  size_t i, index_star = 0,
+    num_data_pts = fHatModel.approximation_data(0).points();
   Real merit_fn, merit_fn_star = DBL_MAX;
   RealVector fn_sample(numFunctions);
   for (i=0; i<num_data_pts; ++i) {
@@ -750,13 +805,114 @@ void EffGlobalMinimizer::extract_best_sample()
     if (merit_fn < merit_fn_star)
       { index_star = i; merit_fn_star = merit_fn; }
   }
+  return index_star;
+}
 
-  // update best{Variables,Response}Array from index_star
-  const Pecos::SDVArray& sdv_array_0 = gp_data_0.variables_data();
-  const RealVector& cv_star = sdv_array_0[index_star].continuous_variables();
-  bestVariablesArray.front().continuous_variables(cv_star);
-  RealVector fn_star = bestResponseArray.front().function_values_view();
-  extract_qoi_build_data(index_star, fn_star);
+
+/** Local penalization (Gonzalez et al., 2016): in lieu of liar data,
+    the acquisition is multiplied by a penalizer for each pending job
+    x_j, the probability that x lies outside the ball around x_j which
+    cannot contain the minimizer given a Lipschitz constant L for the
+    merit function: Phi((L ||x - x_j|| - mu_j + meritFnStar) / sigma_j).
+    L is estimated from the build data.  Requires meritFnStar. */
+void EffGlobalMinimizer::update_local_penalizers()
+{
+  // estimate the Lipschitz constant from finite differences of the merit
+  // function among the truth build data
+  const Pecos::SurrogateData& gp_data_0 = fHatModel.approximation_data(0);
+  const Pecos::SDVArray&    sdv_array_0 = gp_data_0.variables_data();
+  size_t i, j, k, num_data_pts = gp_data_0.points();
+  RealVector fn_sample(numFunctions), merit(num_data_pts, false);
+  for (i=0; i<num_data_pts; ++i) {
+    extract_qoi_build_data(i, fn_sample);
+    merit[i] = augmented_lagrangian(fn_sample);
+  }
+  Real dist, diff;  lipschitzConstant = 0.;
+  for (i=0; i<num_data_pts; ++i) {
+    const RealVector& cv_i = sdv_array_0[i].continuous_variables();
+    for (j=i+1; j<num_data_pts; ++j) {
+      const RealVector& cv_j = sdv_array_0[j].continuous_variables();
+      dist = 0.;
+      for (k=0; k<numContinuousVars; ++k)
+	{ diff = cv_i[k] - cv_j[k]; dist += diff * diff; }
+      if (dist > 0.)
+	lipschitzConstant = std::max(lipschitzConstant,
+	  std::abs(merit[i] - merit[j]) / std::sqrt(dist));
+    }
+  }
+  if (lipschitzConstant <= 0.) lipschitzConstant = 1.e-7; // flat data
+
+  // penalizer for each job selected but not yet completed
+  size_t num_pending = varsAcquisitionMap.size() + varsExplorationMap.size();
+  penaltyCenters.resize(num_pending);
+  penaltyGaps.sizeUninitialized(num_pending);
+  penaltyStdevs.sizeUninitialized(num_pending);
+  if (num_pending) {
+    // the GP predictions below move fHatModel; restore it afterwards so that
+    // the caller's variables and response remain consistent
+    Variables fhat_vars = fHatModel.current_variables().copy();
+    IntVarsMCIter v_cit = varsAcquisitionMap.begin();
+    for (i=0; i<num_pending; ++i, ++v_cit) {
+      if (v_cit == varsAcquisitionMap.end())
+	v_cit = varsExplorationMap.begin();
+      const Variables& vars_j = v_cit->second;
+      copy_data(vars_j.continuous_variables(), penaltyCenters[i]);
+      fHatModel.active_variables(vars_j);
+      fHatModel.evaluate();
+      const RealVector& mean = fHatModel.current_response().function_values();
+      penaltyGaps[i] = augmented_lagrangian(mean) - meritFnStar;
+      penaltyStdevs[i] = std::sqrt(augmented_lagrangian_variance(mean,
+	fHatModel.approximation_variances(vars_j)));
+    }
+    fHatModel.active_variables(fhat_vars);
+    fHatModel.evaluate();
+  }
+
+  if (outputLevel >= DEBUG_OUTPUT)
+    Cout << "\nParallel EGO: local penalization of " << num_pending
+	 << " pending evaluations with Lipschitz constant " << lipschitzConstant
+	 << ".\n";
+}
+
+
+/** The penalizer scales the merit gap mu_j - meritFnStar, so its spread
+    must be that of the merit function rather than of the objective alone:
+    var(M) ~= sum_i (dM/df_i)^2 var(f_i), with the sensitivities of the
+    augmented Lagrangian estimated by forward differences at the mean. */
+Real EffGlobalMinimizer::
+augmented_lagrangian_variance(const RealVector& mean,
+			      const RealVector& variance)
+{
+  Real merit = augmented_lagrangian(mean), merit_var = 0., h, dm_df;
+  RealVector mean_h(mean);
+  for (size_t i=0; i<numFunctions; ++i) {
+    if (variance[i] <= 0.) continue;
+    h = 1.e-6 * std::max(1., std::abs(mean[i]));
+    mean_h[i] += h;
+    dm_df = (augmented_lagrangian(mean_h) - merit) / h;
+    mean_h[i]  = mean[i];
+    merit_var += dm_df * dm_df * variance[i];
+  }
+  return merit_var;
+}
+
+
+Real EffGlobalMinimizer::local_penalty(const RealVector& c_vars) const
+{
+  Real penalty = 1., dist, diff;
+  size_t j, k, num_pending = penaltyCenters.size();
+  for (j=0; j<num_pending; ++j) {
+    const RealVector& center = penaltyCenters[j];
+    dist = 0.;
+    for (k=0; k<numContinuousVars; ++k)
+      { diff = c_vars[k] - center[k]; dist += diff * diff; }
+    Real z = lipschitzConstant * std::sqrt(dist) - penaltyGaps[j];
+    // degenerate variance: penalizer reduces to a hard exclusion ball
+    penalty *= (penaltyStdevs[j] > 0.) ?
+      Pecos::NormalRandomVariable::std_cdf(z / penaltyStdevs[j]) :
+      ((z >= 0.) ? 1. : 0.);
+  }
+  return penalty;
 }
 
 
@@ -906,6 +1062,9 @@ PIF_objective_eval(const Variables& sub_model_vars,
   if (recast_asv[0] & 1) { // return -EI since we are maximizing
     Real neg_pi
       = - effGlobalInstance->compute_probability_improvement(means, variances);
+    if (!effGlobalInstance->penaltyCenters.empty())
+      neg_pi *= effGlobalInstance->
+	local_penalty(recast_vars.continuous_variables());
     recast_response.function_value(neg_pi, 0);
   }
 }
@@ -929,6 +1088,9 @@ EIF_objective_eval(const Variables& sub_model_vars,
   if (recast_asv[0] & 1) { // return -EI since we are maximizing
     Real neg_ei
       = - effGlobalInstance->compute_expected_improvement(means, variances);
+    if (!effGlobalInstance->penaltyCenters.empty())
+      neg_ei *= effGlobalInstance->
+	local_penalty(recast_vars.continuous_variables());
     recast_response.function_value(neg_ei, 0);
   }
 }
@@ -974,6 +1136,9 @@ Variances_objective_eval(const Variables& sub_model_vars,
 
   if (recast_asv[0] & 1) { // return -EI since we are maximizing
     Real neg_var = - effGlobalInstance->compute_variances(variances);
+    if (!effGlobalInstance->penaltyCenters.empty())
+      neg_var *= effGlobalInstance->
+	local_penalty(recast_vars.continuous_variables());
     recast_response.function_value(neg_var, 0);
   }
 }
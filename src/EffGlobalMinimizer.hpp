@@ -17,6 +17,10 @@
 
 namespace Dakota {
 
+/// strategies for defining multiple points per cycle in parallel EGO
+enum { KRIGING_BELIEVER_BATCH=0, CONSTANT_LIAR_BATCH,
+       LOCAL_PENALIZATION_BATCH };
+
 
 /// Implementation of Efficient Global Optimization/Least Squares algorithms
 
@@ -166,6 +170,13 @@ private:
   //void pop_liar_response(int liar_id);
   /// evaluate and append a liar response
   void append_liar(const Variables& vars_star, int liar_id, bool rebuild);
+  /// whether batch points are separated by appending liar responses
+  bool liar_batch() const;
+
+  /// update the local penalizers for the queued (pending) jobs
+  void update_local_penalizers();
+  /// product of the local penalizers of the pending jobs at c_vars
+  Real local_penalty(const RealVector& c_vars) const;
 
   /// manage special value when iterator has advanced to end
   int extract_id(IntVarsMCIter it, const IntVariablesMap& map);
@@ -174,11 +185,17 @@ private:
   void compute_best_sample();
   /// extract best solution from among the GP build data for final results
   void extract_best_sample();
+  /// index of the GP build data with the best merit function
+  size_t best_sample_index();
   /// extra response function build data from across the set of QoI
   void extract_qoi_build_data(size_t data_index, RealVector& fn_vals);
 
   /// helper for evaluating the value of the augmented Lagrangian merit fn
   Real augmented_lagrangian(const RealVector& mean);
+  /// first-order (delta method) variance of the augmented Lagrangian
+  /// merit fn, propagated from the GP variances of each response fn
+  Real augmented_lagrangian_variance(const RealVector& mean,
+				     const RealVector& variance);
   /// update constraint penalties and multipliers for a single response
   void update_constraints(const RealVector& fn_vals);
   /// update constraint penalties and multipliers for a set of responses
@@ -307,6 +324,18 @@ private:
   bool parallelFlag;
   /// algorithm option for fully asynchronous batch updating of the GP
   bool batchAsynch;
+  /// strategy for multiple points per cycle: KRIGING_BELIEVER_BATCH,
+  /// CONSTANT_LIAR_BATCH, or LOCAL_PENALIZATION_BATCH
+  short batchSelection;
+
+  /// continuous variables of the pending jobs penalized in the acquisition
+  RealVectorArray penaltyCenters;
+  /// GP merit mean at each penalty center less meritFnStar
+  RealVector penaltyGaps;
+  /// GP standard deviation at each penalty center
+  RealVector penaltyStdevs;
+  /// estimated Lipschitz constant of the merit function
+  Real lipschitzConstant;
 
   // convergence checkers
 
@@ -405,8 +434,14 @@ extract_id(IntVarsMCIter cit, const IntVariablesMap& map)
 { return (cit == map.end()) ? INT_MAX : cit->first; }
 
 
+inline bool EffGlobalMinimizer::liar_batch() const
+{ return (parallelFlag && batchSelection != LOCAL_PENALIZATION_BATCH); }
+
+
 inline void EffGlobalMinimizer::pop_liar_responses()
 {
+  if (!liar_batch()) return; // no liars appended
+
   // Pop counts are 1 for append_approximation() calls in append_liar()
   // (only {evaluate/query}_batch() appends multiple in truth_resp_map),
   // so here we call pop_approximation() repeatedly for each liar.
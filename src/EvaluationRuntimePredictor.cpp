@@ -0,0 +1,180 @@
+/*  _______________________________________________________________________
+
+    Dakota: Explore and predict with confidence.
+    Copyright 2014-2023
+    National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Dakota directory.
+    _______________________________________________________________________ */
+
+#include "EvaluationRuntimePredictor.hpp"
+#include "Teuchos_SerialSpdDenseSolver.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+using Teuchos::rcp;
+
+
+namespace Dakota {
+
+typedef Teuchos::SerialSpdDenseSolver<int, Real> RealSpdSolver;
+
+/// shortest wall time recorded, so that the log time is finite
+static const Real MIN_EVAL_TIME = 1.e-9;
+
+const Real EvaluationRuntimePredictor::ridgePenalty = 1.e-2;
+
+
+void EvaluationRuntimePredictor::
+update(const RealArray& key, const RealVector& c_vars, Real time)
+{
+  Real log_time = std::log(std::max(time, MIN_EVAL_TIME));
+  accumulate(keyFits[key], c_vars, log_time);
+  accumulate(pooledFit, c_vars, log_time);
+}
+
+
+Real EvaluationRuntimePredictor::
+predict(const RealArray& key, const RealVector& c_vars)
+{
+  std::map<RealArray, RuntimeFit>::iterator it = keyFits.find(key);
+  RuntimeFit& fit = (it != keyFits.end()) ? it->second : pooledFit;
+  if (!fit.count)
+    return 0.;
+  if (fit.dirty)
+    refit(fit);
+  return std::exp(evaluate(fit, c_vars));
+}
+
+
+void EvaluationRuntimePredictor::
+longest_first(const RealArray& predicted, SizetArray& order)
+{
+  order.resize(predicted.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(),
+    [&predicted](size_t a, size_t b) { return predicted[a] > predicted[b]; });
+}
+
+
+/** The longest processing time rule of Graham (1969), whose makespan
+    is within 4/3 of the optimum. */
+Real EvaluationRuntimePredictor::
+balance_static(const RealArray& predicted, size_t num_servers,
+	       SizetArray& server_assignment)
+{
+  SizetArray order;
+  longest_first(predicted, order);
+  RealArray loads(std::max(num_servers, (size_t)1), 0.);
+  server_assignment.resize(predicted.size());
+  for (size_t i=0; i<order.size(); ++i) {
+    size_t job = order[i], server
+      = std::min_element(loads.begin(), loads.end()) - loads.begin();
+    server_assignment[job] = server;
+    loads[server] += predicted[job];
+  }
+  return *std::max_element(loads.begin(), loads.end());
+}
+
+
+void EvaluationRuntimePredictor::
+accumulate(RuntimeFit& fit, const RealVector& c_vars, Real log_time)
+{
+  int i, j, num_v = c_vars.length();
+  if (fit.count && fit.shiftVars.length() != num_v)
+    fit = RuntimeFit(); // the variables have changed: discard the history
+  if (!fit.count) {
+    fit.shiftVars = c_vars;  fit.shiftLogTime = log_time;
+    fit.sumVars.size(num_v);  fit.sumVarsLogTime.size(num_v);
+    fit.sumVarsVars.shape(num_v);
+    fit.minLogTime = fit.maxLogTime = log_time;
+  }
+
+  Real dy = log_time - fit.shiftLogTime;
+  RealVector dx(num_v, false);
+  for (i=0; i<num_v; ++i)
+    dx[i] = c_vars[i] - fit.shiftVars[i];
+  for (i=0; i<num_v; ++i) {
+    fit.sumVars[i] += dx[i];
+    fit.sumVarsLogTime[i] += dx[i] * dy;
+    for (j=0; j<=i; ++j)
+      fit.sumVarsVars(i,j) += dx[i] * dx[j];
+  }
+  fit.sumLogTime += dy;
+  fit.minLogTime = std::min(fit.minLogTime, log_time);
+  fit.maxLogTime = std::max(fit.maxLogTime, log_time);
+  ++fit.count;  fit.dirty = true;
+}
+
+
+/** Solves (R + lambda I) b = r for the correlations R of the variables
+    and the correlations r of the variables with the log time, scaled by
+    the standard deviation of the log time.  Variables that have not
+    varied are excluded. */
+void EvaluationRuntimePredictor::refit(RuntimeFit& fit)
+{
+  int i, j, num_v = fit.shiftVars.length();
+  Real n = (Real)fit.count, mean_dy = fit.sumLogTime / n;
+  fit.meanLogTime = fit.shiftLogTime + mean_dy;
+  fit.meanVars.size(num_v);  fit.scaleVars.size(num_v);
+  fit.coeffs.size(num_v);
+  fit.dirty = false;
+
+  RealVector mean_dx(num_v, false);
+  IntArray active;
+  for (i=0; i<num_v; ++i) {
+    mean_dx[i] = fit.sumVars[i] / n;
+    fit.meanVars[i] = fit.shiftVars[i] + mean_dx[i];
+    Real var = fit.sumVarsVars(i,i) / n - mean_dx[i] * mean_dx[i];
+    fit.scaleVars[i] = (var > 0.) ? std::sqrt(var) : 0.;
+    // variation below roundoff of the sums is treated as constant
+    if (fit.scaleVars[i] > 1.e-12 * (std::abs(fit.meanVars[i]) + 1.))
+      active.push_back(i);
+  }
+  int num_a = active.size();
+  if (fit.count < 2 || !num_a)
+    return;
+
+  RealSymMatrix corr(num_a);
+  RealVector rhs(num_a, false), soln(num_a, false);
+  for (i=0; i<num_a; ++i) {
+    int vi = active[i];
+    Real si = fit.scaleVars[vi];
+    for (j=0; j<=i; ++j) {
+      int vj = active[j];
+      corr(i,j) = (fit.sumVarsVars(vi,vj) / n - mean_dx[vi] * mean_dx[vj])
+	/ (si * fit.scaleVars[vj]);
+    }
+    corr(i,i) += ridgePenalty;
+    rhs[i] = (fit.sumVarsLogTime[vi] / n - mean_dx[vi] * mean_dy) / si;
+  }
+
+  RealSpdSolver solver;
+  solver.setMatrix(rcp(&corr, false));
+  solver.setVectors(rcp(&soln, false), rcp(&rhs, false));
+  if (solver.factor() || solver.solve())
+    return; // retain the mean prediction
+  for (i=0; i<num_a; ++i)
+    fit.coeffs[active[i]] = soln[i];
+}
+
+
+Real EvaluationRuntimePredictor::
+evaluate(const RuntimeFit& fit, const RealVector& c_vars)
+{
+  Real log_time = fit.meanLogTime;
+  int num_v = fit.coeffs.length();
+  if (c_vars.length() == num_v)
+    for (int i=0; i<num_v; ++i)
+      if (fit.coeffs[i] != 0.)
+	log_time += fit.coeffs[i] * (c_vars[i] - fit.meanVars[i])
+	  / fit.scaleVars[i];
+  // extrapolate at most a factor of 2 beyond the observed times
+  const Real ln2 = std::log(2.);
+  return std::min(std::max(log_time, fit.minLogTime - ln2),
+		  fit.maxLogTime + ln2);
+}
+
+} // namespace Dakota
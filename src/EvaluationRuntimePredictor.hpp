@@ -0,0 +1,130 @@
+/*  _______________________________________________________________________
+
+    Dakota: Explore and predict with confidence.
+    Copyright 2014-2023
+    National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Dakota directory.
+    _______________________________________________________________________ */
+
+#ifndef EVALUATION_RUNTIME_PREDICTOR_H
+#define EVALUATION_RUNTIME_PREDICTOR_H
+
+#include "dakota_data_types.hpp"
+
+#include <map>
+
+namespace Dakota {
+
+/// Online prediction of evaluation wall times for cost-aware scheduling
+
+/** Fits the logarithm of the observed wall time of an evaluation as a
+    linear function of its continuous variables by ridge regression on
+    standardized variables, separately for each key of discrete
+    variable values (e.g., a model fidelity or solution level).  The
+    fits are refreshed from accumulated sums only when a prediction
+    follows new observations, so an update costs O(n^2) for n
+    variables.  A key without its own observations is predicted by the
+    fit pooled over all keys. */
+class EvaluationRuntimePredictor
+{
+public:
+
+  //
+  //- Heading: Constructors and destructor
+  //
+
+  /// default constructor
+  EvaluationRuntimePredictor();
+
+  //
+  //- Heading: Member functions
+  //
+
+  /// record the wall time in seconds of an evaluation at the given
+  /// discrete key and continuous variables
+  void update(const RealArray& key, const RealVector& c_vars, Real time);
+
+  /// predicted wall time in seconds of an evaluation at the given
+  /// discrete key and continuous variables (0 if nothing is observed)
+  Real predict(const RealArray& key, const RealVector& c_vars);
+
+  /// number of evaluations observed
+  size_t num_observations() const;
+
+  /// order the jobs with the given predicted times longest first
+  /// (stable, so that equal predictions retain the original order)
+  static void longest_first(const RealArray& predicted, SizetArray& order);
+
+  /// assign the jobs with the given predicted times to num_servers
+  /// servers, each in turn to the least loaded server in longest-first
+  /// order; returns the predicted makespan
+  static Real balance_static(const RealArray& predicted, size_t num_servers,
+			     SizetArray& server_assignment);
+
+private:
+
+  /// accumulated sums and current fit for one key
+  struct RuntimeFit
+  {
+    RuntimeFit(): count(0), dirty(false), shiftLogTime(0.), sumLogTime(0.),
+      minLogTime(0.), maxLogTime(0.), meanLogTime(0.) { }
+
+    /// number of observations
+    size_t count;
+    /// whether observations have been added since the fit
+    bool dirty;
+    /// variables and log time of the first observation, about which the
+    /// sums are taken
+    RealVector shiftVars;
+    Real shiftLogTime;
+    /// sums of shifted variables, their products, log times, and cross
+    /// products of variables with log times
+    RealVector sumVars, sumVarsLogTime;
+    RealSymMatrix sumVarsVars;
+    Real sumLogTime;
+    /// range of the observed log times, which bounds the predictions
+    Real minLogTime, maxLogTime;
+
+    /// fit: mean log time, means and scales of variables, and
+    /// coefficients of the standardized variables
+    Real meanLogTime;
+    RealVector meanVars, scaleVars, coeffs;
+  };
+
+  //
+  //- Heading: Convenience functions
+  //
+
+  /// accumulate an observation into fit
+  static void accumulate(RuntimeFit& fit, const RealVector& c_vars,
+			 Real log_time);
+  /// refresh the fit from the sums
+  static void refit(RuntimeFit& fit);
+  /// predicted log time from fit
+  static Real evaluate(const RuntimeFit& fit, const RealVector& c_vars);
+
+  //
+  //- Heading: Data
+  //
+
+  /// ridge penalty relative to the unit variance of standardized variables
+  static const Real ridgePenalty;
+
+  /// fits for each discrete key
+  std::map<RealArray, RuntimeFit> keyFits;
+  /// fit pooled over all keys
+  RuntimeFit pooledFit;
+};
+
+
+inline EvaluationRuntimePredictor::EvaluationRuntimePredictor()
+{ }
+
+
+inline size_t EvaluationRuntimePredictor::num_observations() const
+{ return pooledFit.count; }
+
+} // namespace Dakota
+
+#endif // EVALUATION_RUNTIME_PREDICTOR_H
@@ -12,6 +12,8 @@
 //- Owner:        J. Adam Stephens
 #include <memory>
 #include <algorithm>
+#include <functional>
+#include <numeric>
 #include <tuple>
 #include <cmath>
 #include "EvaluationStore.hpp"
@@ -43,13 +45,181 @@ DefaultSet::DefaultSet(const ActiveSet &in_set, const size_t num_metadata) : set
 }
 
 
+/// Copy matrix m into the row-major layout of its transpose, as written by
+/// HDF5IOHelper::set_matrix() with transpose = true
+static void copy_transposed(const RealMatrix &m, Real *dest) {
+  const int num_rows = m.numRows(), num_cols = m.numCols();
+  for(int j = 0; j < num_cols; ++j, dest += num_rows)
+    std::copy(m[j], m[j] + num_rows, dest);
+}
+
+/// Pointer to layer offset of the named entry of a map of LayerBuffers, or
+/// NULL if the dataset is not buffered
+template <typename T, typename LayerMap>
+static T* find_layer(LayerMap &layer_map, const String &dset_name, const int &offset) {
+  auto l_it = layer_map.find(dset_name);
+  return (l_it == layer_map.end()) ? NULL :
+    l_it->second.data.data() + offset*l_it->second.layerSize;
+}
+
+
 const int HDF5_CHUNK_SIZE = 40000;
+/// memory budget (bytes) of an evaluation buffer sized automatically
+const size_t EVAL_BUFFER_BYTES = 4*1024*1024;
+/// maximum number of evaluations in an evaluation buffer sized automatically
+const int EVAL_BUFFER_MAX_EVALS = 1024;
 #ifdef DAKOTA_HAVE_HDF5
 void EvaluationStore::set_database(std::shared_ptr<HDF5IOHelper> db_ptr) {
+  // complete the previous database, if any
+  flush();
+  evaluationBuffers.clear();
   hdf5Stream = db_ptr;
 }
 #endif
 
+void EvaluationStore::buffer_policy(const int &buffer_size,
+    const int &flush_seconds, const int &compression_level) {
+  bufferSize = buffer_size;
+  flushSeconds = flush_seconds;
+  compressionLevel = compression_level;
+}
+
+void EvaluationStore::flush() {
+#ifdef DAKOTA_HAVE_HDF5
+  if(!active())
+    return;
+  for(auto &b : evaluationBuffers)
+    flush_buffer(b.first);
+#else
+  return;
+#endif
+}
+
+void EvaluationStore::allocate_buffer(const String &root_group,
+    const Variables &variables, const DefaultSet &set_s) {
+  // the datasets of root_group are new
+  EvaluationBuffer &buffer = evaluationBuffers[root_group] = EvaluationBuffer();
+  if(bufferSize > 0) {
+    buffer.capacity = bufferSize;
+    return;
+  }
+  // Fit the buffer to the memory budget using the bytes per evaluation of
+  // the buffered datasets
+  const size_t num_functions = set_s.numFunctions;
+  const size_t num_deriv_vars = set_s.set.derivative_vector().size();
+  size_t eval_bytes = sizeof(int)*(1 + variables.adiv() + num_functions) +
+    sizeof(Real)*(variables.acv() + variables.adrv() + num_functions +
+                  set_s.numMetadata);
+  if(set_s.numGradients || set_s.numHessians)
+    eval_bytes += sizeof(int)*num_deriv_vars + sizeof(Real)*num_deriv_vars*
+      (set_s.numGradients + set_s.numHessians*num_deriv_vars);
+  buffer.capacity = std::max(1, std::min(EVAL_BUFFER_MAX_EVALS,
+                                         int(EVAL_BUFFER_BYTES/eval_bytes)));
+}
+
+void EvaluationStore::create_evaluation_dataset(const String &root_group,
+    const String &dset_name, const IntArray &dims,
+    ResultsOutputType stored_type, const void *fill_val) {
+#ifdef DAKOTA_HAVE_HDF5
+  EvaluationBuffer &buffer = evaluationBuffers[root_group];
+  // chunks hold one buffer of layers, so that each write fills a chunk
+  const int chunk_rows = (buffer.capacity > 1) ? buffer.capacity : 0;
+  hdf5Stream->create_empty_dataset(dset_name, dims, stored_type,
+      HDF5_CHUNK_SIZE, fill_val, chunk_rows, compressionLevel);
+  const size_t layer_size = std::accumulate(dims.begin() + 1, dims.end(),
+      size_t(1), std::multiplies<size_t>());
+  if(stored_type == ResultsOutputType::REAL) {
+    LayerBuffer<Real> &layers = buffer.realLayers[dset_name];
+    layers.layerSize = layer_size;
+    // unset elements of unbuffered layers read as the HDF5 default fill, 0
+    layers.fillValue = (fill_val) ? *static_cast<const Real*>(fill_val) : 0.;
+    layers.data.reserve(layer_size*buffer.capacity);
+  } else if(stored_type == ResultsOutputType::INTEGER) {
+    LayerBuffer<int> &layers = buffer.intLayers[dset_name];
+    layers.layerSize = layer_size;
+    layers.fillValue = (fill_val) ? *static_cast<const int*>(fill_val) : 0;
+    layers.data.reserve(layer_size*buffer.capacity);
+  }
+#else
+  return;
+#endif
+}
+
+int EvaluationStore::append_buffered_evaluation(const String &root_group) {
+  check_buffer_ages();
+  EvaluationBuffer &buffer = evaluationBuffers[root_group];
+  // Write a full buffer when the next evaluation arrives rather than when
+  // it fills, which gives the response of the last evaluation a chance to
+  // join its layers
+  if(buffer.numEvals >= buffer.capacity)
+    flush_buffer(root_group);
+  if(buffer.numEvals == 0)
+    buffer.firstStored = std::chrono::steady_clock::now();
+  for(auto &l : buffer.realLayers)
+    l.second.data.resize(l.second.data.size() + l.second.layerSize,
+                         l.second.fillValue);
+  for(auto &l : buffer.intLayers)
+    l.second.data.resize(l.second.data.size() + l.second.layerSize,
+                         l.second.fillValue);
+  return buffer.firstIndex + buffer.numEvals++;
+}
+
+template <>
+Real* EvaluationStore::buffered_layer<Real>(const String &root_group,
+    const String &dset_name, const int &index) {
+  EvaluationBuffer &buffer = evaluationBuffers[root_group];
+  if(index < buffer.firstIndex)
+    return NULL;
+  return find_layer<Real>(buffer.realLayers, dset_name, index - buffer.firstIndex);
+}
+
+template <>
+int* EvaluationStore::buffered_layer<int>(const String &root_group,
+    const String &dset_name, const int &index) {
+  EvaluationBuffer &buffer = evaluationBuffers[root_group];
+  if(index < buffer.firstIndex)
+    return NULL;
+  return find_layer<int>(buffer.intLayers, dset_name, index - buffer.firstIndex);
+}
+
+void EvaluationStore::flush_buffer(const String &root_group) {
+#ifdef DAKOTA_HAVE_HDF5
+  EvaluationBuffer &buffer = evaluationBuffers[root_group];
+  if(!buffer.numEvals)
+    return;
+  for(auto &l : buffer.realLayers) {
+    hdf5Stream->append_layers(l.first, l.second.data.data(), buffer.numEvals);
+    l.second.data.clear();
+  }
+  for(auto &l : buffer.intLayers) {
+    hdf5Stream->append_layers(l.first, l.second.data.data(), buffer.numEvals);
+    l.second.data.clear();
+  }
+  buffer.firstIndex += buffer.numEvals;
+  buffer.numEvals = 0;
+#else
+  return;
+#endif
+}
+
+void EvaluationStore::check_buffer_ages() {
+#ifdef DAKOTA_HAVE_HDF5
+  const auto now = std::chrono::steady_clock::now();
+  const std::chrono::seconds max_age(flushSeconds);
+  bool flushed = false;
+  for(auto &b : evaluationBuffers)
+    if(b.second.numEvals && now - b.second.firstStored >= max_age) {
+      flush_buffer(b.first);
+      flushed = true;
+    }
+  // make the evaluations visible to readers of the file
+  if(flushed)
+    hdf5Stream->flush();
+#else
+  return;
+#endif
+}
+
 bool EvaluationStore::active() {
   #ifdef DAKOTA_HAVE_HDF5
   return bool(hdf5Stream);
@@ -194,10 +364,11 @@ EvaluationsDBState EvaluationStore::model_allocate(const String &model_id, const
   const DefaultSet &default_set = (*ds_pair.first).second;
   String root_group = create_model_root(model_id, model_type);
   String scale_root = create_scale_root(root_group);
+  allocate_buffer(root_group, variables, default_set);
   // Create evaluation ID dataset, which is attached as a scale to many datasets
   String eval_ids_scale = scale_root + "evaluation_ids";
-  hdf5Stream->create_empty_dataset(eval_ids_scale, {0}, 
-      ResultsOutputType::INTEGER, HDF5_CHUNK_SIZE);
+  create_evaluation_dataset(root_group, eval_ids_scale, {0},
+      ResultsOutputType::INTEGER);
   
   std::shared_ptr<Pecos::MarginalsCorrDistribution> mvd_rep =
     std::static_pointer_cast<Pecos::MarginalsCorrDistribution>
@@ -226,10 +397,11 @@ EvaluationsDBState EvaluationStore::interface_allocate(const String &model_id, c
   const DefaultSet &default_set = (*ds_pair.first).second;
   String root_group = create_interface_root(model_id, interface_id);
   String scale_root = create_scale_root(root_group);
+  allocate_buffer(root_group, variables, default_set);
   // Create evaluation ID dataset, which is attached as a scale to many datasets
   String eval_ids_scale = scale_root + "evaluation_ids";
-  hdf5Stream->create_empty_dataset(eval_ids_scale, {0}, 
-      ResultsOutputType::INTEGER, HDF5_CHUNK_SIZE);
+  create_evaluation_dataset(root_group, eval_ids_scale, {0},
+      ResultsOutputType::INTEGER);
   
   allocate_variables(root_group, variables);
   allocate_response(root_group, response, default_set);
@@ -261,21 +433,14 @@ void EvaluationStore::store_model_variables(const String &model_id, const String
   resizedModels.erase(model_id);
   String root_group = create_model_root(model_id, model_type);
   String scale_root = create_scale_root(root_group);
-  // Create evaluation ID dataset, which is attached as a scale to many datasets
+  // Layers for this evaluation in all datasets, including the response
+  // datasets, which are filled in by store_model_response()
+  int resp_idx = append_buffered_evaluation(root_group);
   String eval_ids_scale = scale_root + "evaluation_ids";
-  hdf5Stream->append_scalar(eval_ids_scale, eval_id);
-  store_variables(root_group, variables);
-  store_properties(root_group, set, default_set_s);
- 
+  *buffered_layer<int>(root_group, eval_ids_scale, resp_idx) = eval_id;
+  store_variables(root_group, resp_idx, variables);
+  store_properties(root_group, resp_idx, set, default_set_s);
 
-  int resp_idx = hdf5Stream->append_empty(root_group + "responses/functions");
-  const ShortArray &default_asv = default_set_s.set.request_vector();
-  if( default_set_s.numGradients )
-    hdf5Stream->append_empty(root_group + "responses/gradients");
-  if( default_set_s.numHessians ) 
-    hdf5Stream->append_empty(root_group + "responses/hessians");
-  if( default_set_s.numMetadata)
-    hdf5Stream->append_empty(root_group + "metadata");
   modelResponseIndexCache.emplace(std::make_tuple(model_id, eval_id), resp_idx);
 #else
   return;
@@ -298,6 +463,7 @@ void EvaluationStore::store_model_response(const String &model_id, const String
   store_metadata(root_group, response_index, response);
   auto cache_entry = modelResponseIndexCache.find(key);
   modelResponseIndexCache.erase(cache_entry);
+  check_buffer_ages();
 #else
   return;
 #endif
@@ -313,19 +479,14 @@ void EvaluationStore::store_interface_variables(const String &model_id, const St
   String scale_root = create_scale_root(root_group);
   const auto set_key = std::make_pair(model_id, interface_id);
   const DefaultSet &default_set_s = interfaceDefaultSets[set_key];
-  // Create evaluation ID dataset, which is attached as a scale to many datasets
+  // Layers for this evaluation in all datasets, including the response
+  // datasets, which are filled in by store_interface_response()
+  int resp_idx = append_buffered_evaluation(root_group);
   String eval_ids_scale = scale_root + "evaluation_ids";
-  hdf5Stream->append_scalar(eval_ids_scale, eval_id);
-  store_variables(root_group, variables);
-  store_properties(root_group, set, default_set_s);
-  
-  int resp_idx = hdf5Stream->append_empty(root_group + "responses/functions");
-  if( default_set_s.numGradients) 
-    hdf5Stream->append_empty(root_group + "responses/gradients");
-  if( default_set_s.numHessians) 
-    hdf5Stream->append_empty(root_group + "responses/hessians");
-  if( default_set_s.numMetadata)
-    hdf5Stream->append_empty(root_group + "metadata");
+  *buffered_layer<int>(root_group, eval_ids_scale, resp_idx) = eval_id;
+  store_variables(root_group, resp_idx, variables);
+  store_properties(root_group, resp_idx, set, default_set_s);
+
   interfaceResponseIndexCache.emplace(std::make_tuple(model_id, interface_id, eval_id), resp_idx);
 #else
   return;
@@ -345,6 +506,7 @@ void EvaluationStore::store_interface_response(const String &model_id, const Str
   store_metadata(root_group, response_index, response);
   auto cache_entry = interfaceResponseIndexCache.find(key);
   interfaceResponseIndexCache.erase(cache_entry);
+  check_buffer_ages();
 #else
   return;
 #endif
@@ -381,8 +543,8 @@ void EvaluationStore::allocate_variables(const String &root_group, const Variabl
     String ids_name = variables_scale_root + "continuous_ids";
     String types_name = variables_scale_root + "continuous_types";
 
-    hdf5Stream->create_empty_dataset(data_name, {0, int(variables.acv())}, 
-        ResultsOutputType::REAL, HDF5_CHUNK_SIZE);
+    create_evaluation_dataset(root_group, data_name,
+        {0, int(variables.acv())}, ResultsOutputType::REAL);
     hdf5Stream->store_vector(labels_name,
                              variables.all_continuous_variable_labels());
     hdf5Stream->attach_scale(data_name, eval_ids, "evaluation_ids", 0);
@@ -404,8 +566,8 @@ void EvaluationStore::allocate_variables(const String &root_group, const Variabl
     String ids_name = variables_scale_root + "discrete_integer_ids";
     String types_name = variables_scale_root + "discrete_integer_types";
     
-    hdf5Stream->create_empty_dataset(data_name, {0, int(variables.adiv())}, 
-        ResultsOutputType::INTEGER, HDF5_CHUNK_SIZE);
+    create_evaluation_dataset(root_group, data_name,
+        {0, int(variables.adiv())}, ResultsOutputType::INTEGER);
     hdf5Stream->store_vector(labels_name,
                              variables.all_discrete_int_variable_labels());
     hdf5Stream->attach_scale(data_name, eval_ids, "evaluation_ids", 0);
@@ -427,8 +589,8 @@ void EvaluationStore::allocate_variables(const String &root_group, const Variabl
     String ids_name = variables_scale_root + "discrete_string_ids";
     String types_name = variables_scale_root + "discrete_string_types";
 
-    hdf5Stream->create_empty_dataset(data_name, {0, int(variables.adsv())}, 
-        ResultsOutputType::STRING, HDF5_CHUNK_SIZE);
+    create_evaluation_dataset(root_group, data_name,
+        {0, int(variables.adsv())}, ResultsOutputType::STRING);
     hdf5Stream->store_vector(labels_name,
                              variables.all_discrete_string_variable_labels());
     hdf5Stream->attach_scale(data_name, eval_ids, "evaluation_ids", 0);
@@ -450,8 +612,8 @@ void EvaluationStore::allocate_variables(const String &root_group, const Variabl
     String ids_name = variables_scale_root + "discrete_real_ids";
     String types_name = variables_scale_root + "discrete_real_types";
 
-    hdf5Stream->create_empty_dataset(data_name, {0, int(variables.adrv())}, 
-        ResultsOutputType::REAL, HDF5_CHUNK_SIZE);
+    create_evaluation_dataset(root_group, data_name,
+        {0, int(variables.adrv())}, ResultsOutputType::REAL);
     hdf5Stream->store_vector(labels_name,
                              variables.all_discrete_real_variable_labels());
     hdf5Stream->attach_scale(data_name, eval_ids, "evaluation_ids", 0);
@@ -1808,8 +1970,8 @@ void EvaluationStore::allocate_response(const String &root_group, const Response
   hdf5Stream->store_vector(function_labels_name, response.function_labels());
   // Create functions dataset
   String functions_name = response_root_group + "functions";
-  hdf5Stream->create_empty_dataset(functions_name, {0, num_functions}, 
-      ResultsOutputType::REAL, HDF5_CHUNK_SIZE, &REAL_DSET_FILL_VAL);
+  create_evaluation_dataset(root_group, functions_name, {0, num_functions},
+      ResultsOutputType::REAL, &REAL_DSET_FILL_VAL);
   hdf5Stream->attach_scale(functions_name, eval_ids, "evaluation_ids", 0);
   hdf5Stream->attach_scale(functions_name, function_labels_name, "responses", 1);
   // Create gradients dataset, if needed
@@ -1819,8 +1981,9 @@ void EvaluationStore::allocate_response(const String &root_group, const Response
   if(num_gradients) {
     int dvv_length = set_s.set.derivative_vector().size();
     String gradients_name = response_root_group + "gradients";
-    hdf5Stream->create_empty_dataset(gradients_name, {0, num_gradients, dvv_length},
-      ResultsOutputType::REAL, HDF5_CHUNK_SIZE, &REAL_DSET_FILL_VAL);
+    create_evaluation_dataset(root_group, gradients_name,
+      {0, num_gradients, dvv_length}, ResultsOutputType::REAL,
+      &REAL_DSET_FILL_VAL);
     hdf5Stream->attach_scale(gradients_name, eval_ids, "evaluation_ids", 0);
     if(num_gradients == num_functions)
       hdf5Stream->attach_scale(gradients_name, function_labels_name, "resposnes", 1);
@@ -1838,8 +2001,9 @@ void EvaluationStore::allocate_response(const String &root_group, const Response
   if(num_hessians) {
     int dvv_length = set_s.set.derivative_vector().size();
     String hessians_name = response_root_group + "hessians";
-    hdf5Stream->create_empty_dataset(hessians_name, {0, num_hessians, dvv_length, dvv_length},
-      ResultsOutputType::REAL, HDF5_CHUNK_SIZE, &REAL_DSET_FILL_VAL);
+    create_evaluation_dataset(root_group, hessians_name,
+      {0, num_hessians, dvv_length, dvv_length}, ResultsOutputType::REAL,
+      &REAL_DSET_FILL_VAL);
     hdf5Stream->attach_scale(hessians_name, eval_ids, "evaluation_ids", 0);
     if(num_hessians == num_functions)
       hdf5Stream->attach_scale(hessians_name, function_labels_name, "resposnes", 1);
@@ -1872,7 +2036,8 @@ void EvaluationStore::allocate_properties(const String &root_group, const Variab
   int num_deriv_vars = dvv.size();
   // ASV
   String asv_name = properties_root + "active_set_vector";
-  hdf5Stream->create_empty_dataset(asv_name, {0, num_functions}, ResultsOutputType::INTEGER, HDF5_CHUNK_SIZE);
+  create_evaluation_dataset(root_group, asv_name, {0, num_functions},
+      ResultsOutputType::INTEGER);
   hdf5Stream->attach_scale(asv_name, eval_ids, "evaluation_ids", 0);
   hdf5Stream->attach_scale(asv_name, scale_root+"responses/function_descriptors", "responses", 1);
   hdf5Stream->store_vector(properties_scale_root + "default_asv", asv);
@@ -1882,7 +2047,8 @@ void EvaluationStore::allocate_properties(const String &root_group, const Variab
 
   if(set_s.numGradients || set_s.numHessians) {
     String dvv_name = properties_root + "derivative_variables_vector";
-    hdf5Stream->create_empty_dataset(dvv_name, {0, num_deriv_vars}, ResultsOutputType::INTEGER,  HDF5_CHUNK_SIZE);
+    create_evaluation_dataset(root_group, dvv_name, {0, num_deriv_vars},
+        ResultsOutputType::INTEGER);
     hdf5Stream->attach_scale(dvv_name, eval_ids, "evaluation_ids", 0);
     // The ids are 1-based, not 0-based
     StringMultiArrayConstView cont_labels = variables.all_continuous_variable_labels();
@@ -1920,7 +2086,8 @@ void EvaluationStore::allocate_metadata(const String &root_group, const Response
   hdf5Stream->store_vector(metadata_labels_name, metadata_labels);
 
   String metadata_name = metadata_root + "metadata";
-  hdf5Stream->create_empty_dataset(metadata_name, {0, num_metadata}, ResultsOutputType::REAL, HDF5_CHUNK_SIZE);
+  create_evaluation_dataset(root_group, metadata_name, {0, num_metadata},
+      ResultsOutputType::REAL);
   hdf5Stream->attach_scale(metadata_name, eval_ids, "evaluation_ids", 0);
   hdf5Stream->attach_scale(metadata_name, metadata_labels_name, "metadata", 1);
 #else
@@ -1928,21 +2095,30 @@ void EvaluationStore::allocate_metadata(const String &root_group, const Response
 #endif
 }
 
-void EvaluationStore::store_variables(const String &root_group, const Variables &variables) {
+void EvaluationStore::store_variables(const String &root_group, const int &resp_idx,
+    const Variables &variables) {
 #ifdef DAKOTA_HAVE_HDF5
   String variables_root = root_group + "variables/";
-  if(variables.acv())
-    hdf5Stream->append_vector(variables_root+"continuous",
-        variables.all_continuous_variables());
-  if(variables.adiv())
-    hdf5Stream->append_vector(variables_root+"discrete_integer",
-        variables.all_discrete_int_variables());
+  if(variables.acv()) {
+    const RealVector &acv = variables.all_continuous_variables();
+    std::copy(acv.values(), acv.values() + acv.length(),
+        buffered_layer<Real>(root_group, variables_root+"continuous", resp_idx));
+  }
+  if(variables.adiv()) {
+    const IntVector &adiv = variables.all_discrete_int_variables();
+    std::copy(adiv.values(), adiv.values() + adiv.length(),
+        buffered_layer<int>(root_group, variables_root+"discrete_integer", resp_idx));
+  }
+  // strings are variable length and are not buffered; the appended row
+  // has index resp_idx because rows are appended in evaluation order
   if(variables.adsv())
     hdf5Stream->append_vector(variables_root+"discrete_string",
         variables.all_discrete_string_variables());
-  if(variables.adrv())
-    hdf5Stream->append_vector(variables_root+"discrete_real",
-        variables.all_discrete_real_variables());
+  if(variables.adrv()) {
+    const RealVector &adrv = variables.all_discrete_real_variables();
+    std::copy(adrv.values(), adrv.values() + adrv.length(),
+        buffered_layer<Real>(root_group, variables_root+"discrete_real", resp_idx));
+  }
 #else
   return;
 #endif
@@ -1970,7 +2146,12 @@ void EvaluationStore::store_response(const String &root_group, const int &resp_i
     // fill values.
     const RealVector &f = response.function_values();
     int num1 = std::count_if(asv.begin(), asv.end(), [](const short &a){return a & 1;});
-    if(num1 == num_functions) {
+    // a buffered layer is pre-filled with NaN, so only set values are copied
+    Real *f_layer = buffered_layer<Real>(root_group, functions_name, resp_idx);
+    if(f_layer) {
+      for(int i = 0; i < num_functions; ++i)
+        if(asv[i] & 1) f_layer[i] = f[i];
+    } else if(num1 == num_functions) {
       hdf5Stream->set_vector(functions_name, f, resp_idx);
     } else if(num1 > 0) {
       RealVector f_copy(num_functions, false /*don't zero out */);
@@ -1994,7 +2175,11 @@ void EvaluationStore::store_response(const String &root_group, const int &resp_i
   if(num_gradients && std::any_of(asv.begin(), asv.end(), [](const short &a){return a & 2;})) {
     // First do the simple case where the dvv is the same length as default dvv and gradients are 
     // not mixed.
+    Real *g_layer = buffered_layer<Real>(root_group, gradients_name, resp_idx);
     if(dvv.size() == num_default_deriv_vars && num_gradients == num_functions) {
+      if(g_layer)
+        copy_transposed(response.function_gradients(), g_layer);
+      else
         hdf5Stream->set_matrix(gradients_name, response.function_gradients(), resp_idx, true /*transpose*/);
     } else {
       // Need to grab the gradients only for the subset of responses that can have them, and then
@@ -2015,7 +2200,10 @@ void EvaluationStore::store_response(const String &root_group, const int &resp_i
           full_gradients(dvv_idx[j], i) = col(j);
         }
       }
-      hdf5Stream->set_matrix(gradients_name, full_gradients, resp_idx, true /*transpose */);
+      if(g_layer)
+        copy_transposed(full_gradients, g_layer);
+      else
+        hdf5Stream->set_matrix(gradients_name, full_gradients, resp_idx, true /*transpose */);
     }
   } 
   // Hessians. Same bookkeeping needs to be done here as for gradients. Addditionally, the
@@ -2024,6 +2212,8 @@ void EvaluationStore::store_response(const String &root_group, const int &resp_i
   const int &num_hessians = default_set_s.numHessians;
   String hessians_name = response_root + "hessians";
   if(num_hessians && std::any_of(asv.begin(), asv.end(), [](const short &a){return a & 4;})) {
+    Real *h_layer = buffered_layer<Real>(root_group, hessians_name, resp_idx);
+    const size_t h_size = num_default_deriv_vars*num_default_deriv_vars;
     // First do the simple case where the dvv is the same length as default dvv, and
     // hessians are not mixed.
     if(dvv.size() == num_default_deriv_vars && num_hessians == num_functions) {
@@ -2038,7 +2228,11 @@ void EvaluationStore::store_response(const String &root_group, const int &resp_i
         }
         full_hessians.push_back(full_hessian);
       }
-      hdf5Stream->set_vector_matrix(hessians_name, full_hessians, resp_idx, true /*transpose (for efficiency)*/);
+      if(h_layer)
+        for(size_t mi = 0; mi < full_hessians.size(); ++mi)
+          copy_transposed(full_hessians[mi], h_layer + mi*h_size);
+      else
+        hdf5Stream->set_vector_matrix(hessians_name, full_hessians, resp_idx, true /*transpose (for efficiency)*/);
     } else {
       IntArray hessian_idxs; // Indexes of responses that can have hessians
       for(int i = 0; i < num_functions; ++i)
@@ -2065,7 +2259,11 @@ void EvaluationStore::store_response(const String &root_group, const int &resp_i
         }
         full_hessians.push_back(full_hessian);
       }
-      hdf5Stream->set_vector_matrix(hessians_name, full_hessians, resp_idx, true /*transpose */);
+      if(h_layer)
+        for(size_t mi = 0; mi < full_hessians.size(); ++mi)
+          copy_transposed(full_hessians[mi], h_layer + mi*h_size);
+      else
+        hdf5Stream->set_vector_matrix(hessians_name, full_hessians, resp_idx, true /*transpose */);
     }
   } 
 #else
@@ -2073,11 +2271,13 @@ void EvaluationStore::store_response(const String &root_group, const int &resp_i
 #endif
 }
 
-void EvaluationStore::store_properties(const String &root_group, const ActiveSet &set, 
-        const DefaultSet &default_set_s) {
+void EvaluationStore::store_properties(const String &root_group, const int &resp_idx,
+        const ActiveSet &set, const DefaultSet &default_set_s) {
 #ifdef DAKOTA_HAVE_HDF5
   String properties_root = root_group + "properties/";
-  hdf5Stream->append_vector(properties_root + "active_set_vector", set.request_vector());
+  const ShortArray &asv = set.request_vector();
+  std::copy(asv.begin(), asv.end(),
+      buffered_layer<int>(root_group, properties_root + "active_set_vector", resp_idx));
   // DVV. The dvv in set may be shorter than the default one, and so it has to be properties  // by ID.
   const SizetArray &default_dvv = default_set_s.set.derivative_vector();
   const ShortArray &default_asv = default_set_s.set.request_vector();
@@ -2106,7 +2306,9 @@ void EvaluationStore::store_properties(const String &root_group, const ActiveSet
         }
       }
     }
-    hdf5Stream->append_vector(properties_root + "derivative_variables_vector", dvv_row);
+    std::copy(dvv_row.begin(), dvv_row.end(),
+        buffered_layer<int>(root_group, properties_root + "derivative_variables_vector",
+                            resp_idx));
   }
   return;
 #endif
@@ -2120,7 +2322,11 @@ void EvaluationStore::store_metadata(const String &root_group, const int &resp_i
   const size_t num_metadata = metadata.size();
   String metadata_name = root_group + "metadata";
   
-  hdf5Stream->set_vector(metadata_name, metadata, resp_idx);
+  Real *md_layer = buffered_layer<Real>(root_group, metadata_name, resp_idx);
+  if(md_layer)
+    std::copy(metadata.begin(), metadata.end(), md_layer);
+  else
+    hdf5Stream->set_vector(metadata_name, metadata, resp_idx);
 #else
   return;
 #endif
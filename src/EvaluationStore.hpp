@@ -10,10 +10,12 @@
 #ifndef EVALUATION_STORE_H
 #define EVALUATION_STORE_H
 
+#include <chrono>
 #include <memory>
 #include <set>
 #include "DakotaActiveSet.hpp"
 #include "dakota_data_types.hpp"
+#include "dakota_results_types.hpp"
 #include "MultivariateDistribution.hpp"
 #include "MarginalsCorrDistribution.hpp"
 
@@ -57,6 +59,16 @@ class EvaluationStore {
 
     /// Provide interface selection
     void interface_selection(const unsigned short &selection);
+
+    /// Set the write-behind policy: evaluations buffered per model or
+    /// interface before a write (0: sized from a memory budget; 1: write
+    /// each evaluation when the next one is stored), the maximum seconds
+    /// an evaluation is held, and the deflate level of evaluation datasets
+    void buffer_policy(const int &buffer_size, const int &flush_seconds,
+                       const int &compression_level);
+
+    /// Write all buffered evaluations
+    void flush();
     /// Declare a source for the mdoel or iterator. 
     void declare_source(const String &owner_id, const String &owner_type,
                         const String &source_id, const String &source_type);
@@ -90,6 +102,36 @@ class EvaluationStore {
 
   private:
 
+    /// Layers of one evaluation dataset awaiting a write, stored contiguously
+    template <typename T>
+    struct LayerBuffer {
+      /// number of elements per layer (product of the trailing dimensions)
+      size_t layerSize;
+      /// value of unassigned elements; matches the dataset fill value
+      T fillValue;
+      /// buffered layers
+      std::vector<T> data;
+    };
+
+    /// Evaluations of one model or interface+model pair awaiting a write.
+    /// Evaluation i occupies layer i of every evaluation dataset; buffered
+    /// layers are appended to the datasets together, one hyperslab per
+    /// dataset, and datasets are chunked to hold capacity layers.
+    struct EvaluationBuffer {
+      /// dataset index of the first buffered evaluation
+      int firstIndex = 0;
+      /// number of buffered evaluations
+      int numEvals = 0;
+      /// number of evaluations buffered before a write
+      int capacity = 1;
+      /// when the first buffered evaluation was stored
+      std::chrono::steady_clock::time_point firstStored;
+      /// buffered layers of Real datasets, by dataset name
+      std::map<String, LayerBuffer<Real> > realLayers;
+      /// buffered layers of integer datasets, by dataset name
+      std::map<String, LayerBuffer<int> > intLayers;
+    };
+
     /// Create the mapping from variable type to description
     static std::map<unsigned short, String> create_variable_type_map();
 
@@ -186,16 +228,18 @@ class EvaluationStore {
     /// Allocate storage for metadata
     void allocate_metadata(const String &root_group, const Response &response);
 
-    /// Store variables
-    void store_variables(const String &root_group, const Variables &variables);
+    /// Store variables in the layer at resp_idx
+    void store_variables(const String &root_group, const int &resp_idx,
+        const Variables &variables);
 
     /// Store response
     void store_response(const String &root_group, const int &resp_idx, 
         const Response &response, const DefaultSet &default_set_s);
 
     /// Store properties information (ASV, DVV, analysis components, distribution parameters)
-    void store_properties(const String &root_group, const ActiveSet &set, 
-        const DefaultSet &default_set_s);
+    /// in the layer at resp_idx
+    void store_properties(const String &root_group, const int &resp_idx,
+        const ActiveSet &set, const DefaultSet &default_set_s);
 
     /// Store metadata
     void store_metadata(const String &root_group, const int &resp_idx, const Response &response);
@@ -206,6 +250,33 @@ class EvaluationStore {
     /// Return true if the interface is active
     bool interface_active(const String &model_id);
 
+    /// Size the evaluation buffer of a model or interface+model root group
+    void allocate_buffer(const String &root_group, const Variables &variables,
+        const DefaultSet &set_s);
+
+    /// Create an unlimited evaluation dataset chunked for the buffer of
+    /// root_group; Real and integer datasets are buffered
+    void create_evaluation_dataset(const String &root_group,
+        const String &dset_name, const IntArray &dims,
+        ResultsOutputType stored_type, const void *fill_val = NULL);
+
+    /// Add a layer for a new evaluation to the buffer of root_group and
+    /// return its dataset index
+    int append_buffered_evaluation(const String &root_group);
+
+    /// Pointer to the buffered layer at dataset index of dset_name, or
+    /// NULL if the layer has been written (or the dataset is unbuffered)
+    template <typename T>
+    T* buffered_layer(const String &root_group, const String &dset_name,
+        const int &index);
+
+    /// Write the evaluations buffered for root_group
+    void flush_buffer(const String &root_group);
+
+    /// Write the buffered evaluations of any model or interface+model pair
+    /// that have been held longer than flushSeconds
+    void check_buffer_ages();
+
     /// Choice of interfaces to store
     unsigned short interfaceSelection;
     /// Choice of models to store
@@ -242,6 +313,15 @@ class EvaluationStore {
 
     /// Map from variable type enum to string description
     static const std::map<unsigned short, String> variableTypes;
+
+    /// Buffered evaluations, by model or interface+model root group
+    std::map<String, EvaluationBuffer> evaluationBuffers;
+    /// Requested evaluations per buffer (0: sized from a memory budget)
+    int bufferSize = 0;
+    /// Maximum seconds evaluations are held in a buffer
+    int flushSeconds = 10;
+    /// Deflate level of evaluation datasets (0: uncompressed)
+    int compressionLevel = 0;
     
 }; // class EvaluationStore
 
@@ -20,10 +20,20 @@
 
 namespace Dakota {
 
+/** The process launcher is started here, while Dakota's memory
+    footprint is still small, and is shared by all fork interfaces of
+    this process. */
 ForkApplicInterface::
 ForkApplicInterface(const ProblemDescDB& problem_db):
   ProcessHandleApplicInterface(problem_db)
-{ }
+{
+  if (problem_db.get_bool("interface.application.process_launcher")) {
+    processLauncher = ProcessLauncher::instance();
+    if (!processLauncher)
+      Cerr << "Warning: process_launcher could not be started; analyses "
+	   << "will be forked directly." << std::endl;
+  }
+}
 
 
 void ForkApplicInterface::wait_local_evaluation_sequence(PRPQueue& prp_queue)
@@ -136,6 +146,24 @@ create_analysis_process(bool block_flag, bool new_group)
   int status = 0;
   pid_t pid = 0;
 
+  if (launcher_active()) {
+    StringArray argv(driver_and_args);
+    if (commandLineArgs)
+      { argv.push_back(argList[1]);  argv.push_back(argList[2]); }
+    pid = processLauncher->launch(argv);
+    if (pid == -1) {
+      Cerr << "\nCould not launch " << argv[0] << "; error code " << errno
+	   << " (" << std::strerror(errno) << ")" << std::endl;
+      abort_handler(-1);
+    }
+    if (block_flag)
+      check_wait(pid, processLauncher->wait(pid));
+    else if (new_group)
+      analysisProcGroupId = pid; // no group: identifies the first analysis
+    reset_process_environment();
+    return pid;
+  }
+
   // Ideally fork() should always be used since it is considered best
   // practice on modern computers/OS's.  However, we have observed (1)
   // unreliable fork on HPC platforms with infiniband, and (2)
@@ -201,12 +229,65 @@ create_analysis_process(bool block_flag, bool new_group)
 }
 
 
+/** The analyses and filters run serially in a helper of the launcher,
+    whose exit status is -1 if any of them fails as check_wait() would
+    detect. */
+pid_t ForkApplicInterface::create_evaluation_sequence(bool new_group)
+{
+  if (!launcher_active())
+    return 0;
+
+  std::vector<StringArray> commands;
+  StringArray argv;
+  if (!iFilterName.empty()) {
+    ifilter_argument_list();
+    command_line(argv);  commands.push_back(argv);
+  }
+  for (int i=1; i<=numAnalysisDrivers; ++i) {
+    driver_argument_list(i);
+    command_line(argv);  commands.push_back(argv);
+  }
+  if (!oFilterName.empty()) {
+    ofilter_argument_list();
+    command_line(argv);  commands.push_back(argv);
+  }
+
+  prepare_process_environment();
+  pid_t pid = processLauncher->launch(commands);
+  if (pid == -1) {
+    Cerr << "\nCould not launch evaluation sequence; error code " << errno
+	 << " (" << std::strerror(errno) << ")" << std::endl;
+    abort_handler(-1);
+  }
+  reset_process_environment();
+  return pid;
+}
+
+
+void ForkApplicInterface::command_line(StringArray& argv)
+{
+  boost::shared_array<const char*> av;
+  StringArray driver_and_args;
+  create_command_arguments(av, driver_and_args);
+  argv = driver_and_args;
+  if (commandLineArgs)
+    { argv.push_back(argList[1]);  argv.push_back(argList[2]); }
+}
+
+
 pid_t ForkApplicInterface::
 wait(pid_t process_group_id, std::map<pid_t, int>& process_id_map,
      bool block_flag)
 {
   int status;
 
+  // the launcher reaps its children and reports their statuses
+  if (launcher_active()) {
+    pid_t pid = processLauncher->wait(process_id_map, block_flag, status);
+    check_wait(pid, status);
+    return pid;
+  }
+
   // wait/test for any completion within the process group.  We prefer this
   // approach for the blocking wait case since it can utilize a system-optimized
   // wait facility that avoids a "busy wait."  But if the last child in the
@@ -11,6 +11,7 @@
 #define FORK_APPLIC_INTERFACE_H
 
 #include "ProcessHandleApplicInterface.hpp"
+#include "ProcessLauncher.hpp"
 
 
 namespace Dakota {
@@ -19,7 +20,10 @@ namespace Dakota {
 /// using fork/execvp/waitpid.
 
 /** ForkApplicInterface is used on Unix systems and is a peer to
-    SpawnApplicInterface for Windows systems. */
+    SpawnApplicInterface for Windows systems.  With the \c
+    process_launcher specification, programs are instead started by a
+    ProcessLauncher daemon using posix_spawn(), which reports the same
+    process ids and wait statuses to the bookkeeping. */
 
 class ForkApplicInterface: public ProcessHandleApplicInterface
 {
@@ -48,6 +52,10 @@ protected:
   /// using waitpid() if block_flag is true
   pid_t create_analysis_process(bool block_flag, bool new_group);
 
+  /// launch the input filter, analysis drivers and output filter of a
+  /// nonblocking evaluation as one sequence through the process launcher
+  pid_t create_evaluation_sequence(bool new_group);
+
   size_t wait_local_analyses();
   size_t test_local_analyses_send(int analysis_id);
 
@@ -86,6 +94,12 @@ private:
   /// core code used by join_{evaluation,analysis}_process_group()
   void join_process_group(pid_t& process_group_id, bool new_group);
 
+  /// whether programs are started by processLauncher (false in an
+  /// intermediate process forked from this one)
+  bool launcher_active() const;
+  /// command line of the program in argList, as passed to execvp
+  void command_line(StringArray& argv);
+
   //
   //- Heading: Data
   //
@@ -98,6 +112,10 @@ private:
   /// used by this interface instance (to distinguish from other interface
   /// instances that could be running at the same time)
   pid_t analysisProcGroupId;
+
+  /// daemon starting programs on behalf of this process (from the \c
+  /// process_launcher specification); empty when forking directly
+  std::shared_ptr<ProcessLauncher> processLauncher;
 };
 
 
@@ -136,6 +154,10 @@ inline void ForkApplicInterface::analysis_process_group_id(pid_t pgid)
 inline pid_t ForkApplicInterface::analysis_process_group_id() const
 { return analysisProcGroupId; }
 
+
+inline bool ForkApplicInterface::launcher_active() const
+{ return processLauncher && processLauncher->active(); }
+
 } // namespace Dakota
 
 #endif
@@ -21,6 +21,7 @@
 #include "H5CompType.h"
 #include <iostream>
 #include <limits>
+#include <algorithm>
 #include <memory>
 #include <cmath>
 #include <string>
@@ -359,7 +360,7 @@ H5::Group HDF5IOHelper::create_group(const H5::H5Location &loc, const std::strin
 void HDF5IOHelper::
 create_empty_dataset(const String &dset_name, const IntArray &dims, 
                   ResultsOutputType stored_type, int chunk_size, 
-                  const void* fill_val) 
+                  const void* fill_val, int chunk_rows, int deflate_level) 
 {
   create_groups(dset_name);
   H5::DataType h5_type = h5_file_dtype(stored_type);
@@ -404,7 +405,7 @@ create_empty_dataset(const String &dset_name, const IntArray &dims,
 	maxdims[0] = H5S_UNLIMITED;
     int num_layer_elements = std::accumulate(++dims.begin(), dims.end(), 1, std::multiplies<int>() );
     int layer_size = element_size*num_layer_elements;
-    int chunk0 = chunk_size/layer_size;
+    int chunk0 = (chunk_rows > 0) ? chunk_rows : chunk_size/layer_size;
     chunks[0] = (chunk0) ? chunk0 : 1;
     int actual_chunksize = element_size * std::accumulate(&chunks[0], &chunks[rank], 1, 
                                                           std::multiplies<int>() );
@@ -413,6 +414,8 @@ create_empty_dataset(const String &dset_name, const IntArray &dims,
     create_plist.setChunk(rank, chunks.get());
     if(fill_val)
       create_plist.setFillValue(fill_type, fill_val);
+    if(deflate_level > 0)
+      create_plist.setDeflate(std::min(deflate_level, 9));
     H5::DSetAccPropList access_plist;
     // See the C API documentation for H5P_set_chunk_cache for guidance
     const size_t cache_size = 20*actual_chunksize;
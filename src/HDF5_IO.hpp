@@ -28,6 +28,7 @@
 #include "H5Opublic.h"  
 #include <iostream>
 #include <limits>
+#include <algorithm>
 #include <memory>
 #include <cmath>
 #include <string>
@@ -379,6 +380,11 @@ class HDF5IOHelper
   void append_vector_matrix(const String &dset_name, 
                      const std::vector<Teuchos::SerialDenseMatrix<int, T> > &data,
                      const bool &transpose = false);
+  /// Append num_layers "layers" to the 0th dimension of a dataset of any rank
+  /// in a single write. data holds the layers contiguously in row-major order.
+  template<typename T>
+  void append_layers(const String &dset_name, const T *data,
+                     const int &num_layers);
 
   /// Read scalar data from a dataset
   template <typename T>
@@ -416,10 +422,14 @@ class HDF5IOHelper
   void report_num_open();
   /// Create an empty dataset. Setting the first element of dims to 0 makes
   /// the dataset unlimited in that dimension. DSs unlimited in other dimensions
-  /// currently are unsupported.
+  /// currently are unsupported. The chunks of an unlimited dataset hold
+  /// chunk_rows layers along the 0th dimension, or if chunk_rows is 0, as
+  /// many as fit in chunk_size bytes. A positive deflate_level (1-9)
+  /// compresses the chunks.
   void create_empty_dataset(const String &dset_name, const IntArray &dims, 
                          ResultsOutputType stored_type, int chunk_size=0, 
-                         const void *fill_val = NULL);
+                         const void *fill_val = NULL, int chunk_rows = 0,
+                         int deflate_level = 0);
 
   /// Create a dataset with compound type
   void create_empty_dataset(const String &dset_name, const IntArray &dims, 
@@ -1148,6 +1158,41 @@ void HDF5IOHelper::append_vector_matrix(const String &dset_name,
   set_vector_matrix(dset_name, ds, data, dims[0]-1, transpose);
 }
 
+/// Append num_layers "layers" to the 0th dimension of a dataset of any rank
+/// in a single write. data holds the layers contiguously in row-major order.
+template<typename T>
+void HDF5IOHelper::append_layers(const String &dset_name, const T *data,
+                   const int &num_layers) {
+  // 1. open the dataset
+  // 2. discover the rank and dimensions
+  // 3. Raise an error if the dataset can't be extended
+  // 4. Extend by num_layers
+  // 5. Write the new layers as one hyperslab
+  if(num_layers <= 0)
+    return;
+  H5::DataSet &ds = datasetCache[dset_name];
+  H5::DataSpace f_space = ds.getSpace();
+  int rank = f_space.getSimpleExtentNdims();
+  std::unique_ptr<hsize_t[]> dims(new hsize_t[rank]), maxdims(new hsize_t[rank]),
+    f_start(new hsize_t[rank]);
+  f_space.getSimpleExtentDims(dims.get(), maxdims.get());
+  if(maxdims[0] != H5S_UNLIMITED) {
+    flush();
+    throw std::runtime_error(String("Attempt to append layers to ") + 
+                               dset_name + " failed; dimensions are fixed.");
+  }
+  f_start[0] = dims[0];
+  std::fill(&f_start[1], &f_start[rank], 0);
+  dims[0] += num_layers;
+  ds.extend(dims.get());
+  // the memory and file selections share the trailing dimensions
+  dims[0] = num_layers;
+  H5::DataSpace m_space(rank, dims.get());
+  f_space = ds.getSpace();
+  f_space.selectHyperslab(H5S_SELECT_SET, dims.get(), f_start.get());
+  ds.write(data, h5_mem_dtype(data[0]), m_space, f_space);
+}
+
 /// Read scalar data from a dataset
 template <typename T>
 void HDF5IOHelper::read_scalar(const std::string& dset_name, T& val) {
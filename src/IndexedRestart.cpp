@@ -0,0 +1,369 @@
+/*  _______________________________________________________________________
+
+    Dakota: Explore and predict with confidence.
+    Copyright 2014-2023
+    National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Dakota directory.
+    _______________________________________________________________________ */
+
+#include "dakota_global_defs.hpp"
+#include "IndexedRestart.hpp"
+#include "WorkStealingThreadPool.hpp"
+
+#include <boost/archive/binary_oarchive.hpp>
+#include <boost/archive/binary_iarchive.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+#include <streambuf>
+
+#ifdef HAVE_SYS_MMAN_H
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+
+namespace Dakota {
+
+static_assert(sizeof(RestartRecordHeader) == 24 &&
+	      sizeof(RestartIndexEntry)   == 32 &&
+	      sizeof(RestartIndexFooter)  == 32,
+	      "indexed restart structures must have a fixed layout");
+
+namespace {
+
+/// read-only streambuf over a contiguous range of memory, allowing Boost
+/// archives to deserialize directly from the mapped file
+class MemoryStreambuf: public std::streambuf
+{
+public:
+  MemoryStreambuf(const char* data, size_t len)
+  {
+    char* begin = const_cast<char*>(data);
+    setg(begin, begin, begin + len);
+  }
+
+  /// offset of the next character to be read
+  size_t position() const
+  { return gptr() - eback(); }
+};
+
+
+/// deserialize a record payload of len bytes at data into prp
+void read_payload(const char* data, size_t len, ParamResponsePair& prp)
+{
+  MemoryStreambuf sb(data, len);
+  boost::archive::binary_iarchive
+    record_archive(sb, boost::archive::no_header);
+  record_archive & prp;
+}
+
+
+/// 64-bit FNV-1a over explicitly little-endian fields, which depends on
+/// neither the platform nor the library versions
+class StableHash
+{
+public:
+  StableHash(): hashValue(0xcbf29ce484222325ULL)
+  { }
+
+  void add(UInt64 value)
+  {
+    for (size_t b=0; b<8; ++b, value >>= 8)
+      { hashValue ^= (value & 0xff); hashValue *= 0x100000001b3ULL; }
+  }
+
+  void add(Real value)
+  {
+    UInt64 bits = 0;
+    if (value != 0.) // +0 for -0, which compares equal
+      std::memcpy(&bits, &value, sizeof(bits));
+    add(bits);
+  }
+
+  void add(const String& value)
+  {
+    add(static_cast<UInt64>(value.size()));
+    for (size_t i=0; i<value.size(); ++i)
+      { hashValue ^= (unsigned char)value[i]; hashValue *= 0x100000001b3ULL; }
+  }
+
+  /// finalized (splitmix64) hash
+  UInt64 value() const
+  {
+    UInt64 key = hashValue;
+    key ^= key >> 30; key *= 0xbf58476d1ce4e5b9ULL;
+    key ^= key >> 27; key *= 0x94d049bb133111ebULL;
+    key ^= key >> 31;
+    return key;
+  }
+
+private:
+  UInt64 hashValue;
+};
+
+} // anonymous namespace
+
+
+namespace IndexedRestart {
+
+UInt64 record_key(const String& interface_id, const Variables& vars)
+{
+  StableHash hash;
+  hash.add(interface_id);
+  const RealVector& acv = vars.all_continuous_variables();
+  hash.add(static_cast<UInt64>(acv.length()));
+  for (int i=0; i<acv.length(); ++i)
+    hash.add(acv[i]);
+  const IntVector& adiv = vars.all_discrete_int_variables();
+  hash.add(static_cast<UInt64>(adiv.length()));
+  for (int i=0; i<adiv.length(); ++i)
+    hash.add(static_cast<UInt64>(static_cast<long long>(adiv[i])));
+  StringMultiArrayConstView adsv = vars.all_discrete_string_variables();
+  hash.add(static_cast<UInt64>(adsv.size()));
+  for (size_t i=0; i<adsv.size(); ++i)
+    hash.add(adsv[i]);
+  const RealVector& adrv = vars.all_discrete_real_variables();
+  hash.add(static_cast<UInt64>(adrv.length()));
+  for (int i=0; i<adrv.length(); ++i)
+    hash.add(adrv[i]);
+  return hash.value();
+}
+
+
+RestartIndexEntry write_record(std::ostream& os, const ParamResponsePair& prp)
+{
+  // serialize first to learn the payload length for the fixed header
+  std::ostringstream payload(std::ios::binary);
+  {
+    boost::archive::binary_oarchive
+      record_archive(payload, boost::archive::no_header);
+    record_archive & prp;
+  }
+  const std::string& bytes = payload.str();
+
+  RestartIndexEntry entry;
+  entry.offset  = static_cast<UInt64>(os.tellp());
+  entry.length  = bytes.size();
+  entry.varsKey = record_key(prp.interface_id(), prp.variables());
+  entry.evalId  = prp.eval_id();
+  entry.padding = 0;
+
+  RestartRecordHeader header;
+  header.length  = entry.length;
+  header.varsKey = entry.varsKey;
+  header.evalId  = entry.evalId;
+  header.padding = 0;
+  os.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  os.write(bytes.data(), bytes.size());
+  return entry;
+}
+
+
+void write_index(std::ostream& os, const std::vector<RestartIndexEntry>& index,
+		 UInt64 data_offset)
+{
+  RestartIndexFooter footer;
+  footer.indexOffset = static_cast<UInt64>(os.tellp());
+  footer.numRecords  = index.size();
+  footer.dataOffset  = data_offset;
+  footer.magic       = footerMagic;
+  if (!index.empty())
+    os.write(reinterpret_cast<const char*>(index.data()),
+	     index.size() * sizeof(RestartIndexEntry));
+  os.write(reinterpret_cast<const char*>(&footer), sizeof(footer));
+}
+
+} // namespace IndexedRestart
+
+
+IndexedRestartReader::IndexedRestartReader(const String& read_restart_filename):
+  restartFilename(read_restart_filename), fileData(NULL), fileSize(0),
+  fileMapped(false), indexRecovered(false)
+{
+  map_file();
+  read_index();
+}
+
+
+IndexedRestartReader::~IndexedRestartReader()
+{
+#ifdef HAVE_SYS_MMAN_H
+  if (fileMapped)
+    munmap(const_cast<char*>(fileData), fileSize);
+#endif
+}
+
+
+void IndexedRestartReader::map_file()
+{
+#ifdef HAVE_SYS_MMAN_H
+  int fd = open(restartFilename.c_str(), O_RDONLY);
+  struct stat file_stat;
+  if (fd >= 0 && fstat(fd, &file_stat) == 0 && file_stat.st_size > 0) {
+    fileSize = file_stat.st_size;
+    void* addr = mmap(NULL, fileSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (addr != MAP_FAILED) {
+      fileData = static_cast<const char*>(addr);
+      fileMapped = true;
+      // records are visited in file order for bulk loads
+      madvise(addr, fileSize, MADV_SEQUENTIAL);
+    }
+  }
+  if (fd >= 0)
+    close(fd);
+  if (fileMapped)
+    return;
+#endif
+
+  // fall back to reading the whole file
+  std::ifstream restart_input_fs(restartFilename.c_str(),
+				 std::ios::binary | std::ios::ate);
+  if (!restart_input_fs.good()) {
+    Cerr << "\nError: could not open restart file '" << restartFilename
+	 << "' for reading." << std::endl;
+    abort_handler(IO_ERROR);
+  }
+  fileSize = restart_input_fs.tellg();
+  fileBuffer.resize(fileSize);
+  restart_input_fs.seekg(0);
+  restart_input_fs.read(fileBuffer.data(), fileSize);
+  fileData = fileBuffer.data();
+}
+
+
+void IndexedRestartReader::read_index()
+{
+  // re-read the version from the archive header (validated by the caller
+  // via RestartVersion::check_restart_version())
+  MemoryStreambuf sb(fileData, fileSize);
+  {
+    boost::archive::binary_iarchive restart_input_archive(sb);
+    restart_input_archive & restartVersion;
+  }
+  UInt64 data_offset = sb.position();
+  if (!restartVersion.indexed_format()) {
+    Cerr << "\nError: restart file '" << restartFilename << "' is not in "
+	 << "indexed format." << std::endl;
+    abort_handler(IO_ERROR);
+  }
+
+  // a complete file ends with a consistent footer
+  RestartIndexFooter footer;
+  std::memset(&footer, 0, sizeof(footer));
+  if (fileSize >= data_offset + sizeof(footer))
+    std::memcpy(&footer, fileData + fileSize - sizeof(footer), sizeof(footer));
+  if (footer.magic == IndexedRestart::footerMagic &&
+      footer.indexOffset + footer.numRecords * sizeof(RestartIndexEntry)
+        + sizeof(footer) == fileSize) {
+    recordIndex.resize(footer.numRecords);
+    if (footer.numRecords)
+      std::memcpy(recordIndex.data(), fileData + footer.indexOffset,
+		  footer.numRecords * sizeof(RestartIndexEntry));
+    return;
+  }
+
+  // otherwise recover the complete records preceding any truncation
+  indexRecovered = true;
+  UInt64 offset = data_offset;
+  RestartRecordHeader header;
+  while (offset + sizeof(header) <= fileSize) {
+    std::memcpy(&header, fileData + offset, sizeof(header));
+    if (offset + sizeof(header) + header.length > fileSize)
+      break;
+    RestartIndexEntry entry;
+    entry.offset  = offset;
+    entry.length  = header.length;
+    entry.varsKey = header.varsKey;
+    entry.evalId  = header.evalId;
+    entry.padding = 0;
+    recordIndex.push_back(entry);
+    offset += sizeof(header) + header.length;
+  }
+  Cout << "Warning: restart file '" << restartFilename << "' has no valid "
+       << "index; recovered " << recordIndex.size() << " records by scan."
+       << std::endl;
+}
+
+
+void IndexedRestartReader::read_record(size_t i, ParamResponsePair& prp) const
+{
+  const RestartIndexEntry& entry = recordIndex[i];
+  read_payload(fileData + entry.offset + sizeof(RestartRecordHeader),
+	       entry.length, prp);
+}
+
+
+void IndexedRestartReader::read_records(size_t num_recs, PRPArray& prps) const
+{
+  num_recs = std::min(num_recs, recordIndex.size());
+  prps.resize(num_recs);
+  // each task deserializes a contiguous block into preallocated slots, so
+  // the result is in file order independent of the number of threads;
+  // blocks of at least 64 records amortize the task overhead
+  size_t num_blocks = std::max<size_t>(1, std::min(num_recs / 64,
+    dakota::util::WorkStealingThreadPool::kernel_concurrency())),
+    block = (num_recs + num_blocks - 1) / num_blocks;
+  dakota::util::WorkStealingThreadPool::parallel_for(num_blocks, [&](size_t b) {
+    size_t begin = b * block, end = std::min(num_recs, begin + block);
+    for (size_t i=begin; i<end; ++i)
+      read_record(i, prps[i]);
+  });
+}
+
+
+bool IndexedRestartReader::find_eval_id(int eval_id, ParamResponsePair& prp)
+{
+  if (evalIdOrder.size() != recordIndex.size()) {
+    evalIdOrder.resize(recordIndex.size());
+    for (size_t i=0; i<evalIdOrder.size(); ++i)
+      evalIdOrder[i] = i;
+    std::stable_sort(evalIdOrder.begin(), evalIdOrder.end(),
+		     [this](size_t a, size_t b)
+		     { return recordIndex[a].evalId < recordIndex[b].evalId; });
+  }
+
+  auto first = std::lower_bound(evalIdOrder.begin(), evalIdOrder.end(),
+    eval_id, [this](size_t pos, int id) { return recordIndex[pos].evalId < id; });
+  auto last  = std::upper_bound(first, evalIdOrder.end(),
+    eval_id, [this](int id, size_t pos) { return id < recordIndex[pos].evalId; });
+  if (first == last)
+    return false;
+  // stable ordering: the last of equal ids was written last
+  read_record(*(last - 1), prp);
+  return true;
+}
+
+
+bool IndexedRestartReader::
+find(const String& interface_id, const Variables& vars, ParamResponsePair& prp)
+{
+  if (keyIndex.size() != recordIndex.size()) {
+    keyIndex.clear();
+    keyIndex.reserve(recordIndex.size());
+    for (size_t i=0; i<recordIndex.size(); ++i)
+      keyIndex.insert(std::make_pair(recordIndex[i].varsKey, i));
+  }
+
+  // keys admit collisions: decode candidates and confirm, preferring the
+  // last written match
+  UInt64 key = IndexedRestart::record_key(interface_id, vars);
+  auto range = keyIndex.equal_range(key);
+  size_t found = _NPOS;
+  for (auto it = range.first; it != range.second; ++it) {
+    if (found != _NPOS && it->second < found)
+      continue;
+    ParamResponsePair candidate;
+    read_record(it->second, candidate);
+    if (candidate.interface_id() == interface_id &&
+	candidate.variables()    == vars)
+      { found = it->second; prp = candidate; }
+  }
+  return (found != _NPOS);
+}
+
+} // namespace Dakota
@@ -0,0 +1,214 @@
+/*  _______________________________________________________________________
+
+    Dakota: Explore and predict with confidence.
+    Copyright 2014-2023
+    National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Dakota directory.
+    _______________________________________________________________________ */
+
+#ifndef DAKOTA_INDEXED_RESTART_H
+#define DAKOTA_INDEXED_RESTART_H
+
+#include "dakota_system_defs.hpp"
+#include "dakota_data_types.hpp"
+#include "ParamResponsePair.hpp"
+#include "RestartVersion.hpp"
+
+#include <unordered_map>
+
+namespace Dakota {
+
+/// Fixed-layout header preceding each record of an indexed restart file
+
+/** The header duplicates the identifying data of the record, such
+    that the index can be rebuilt by a scan over headers alone (e.g.,
+    for a file truncated by an abort before its index was written). */
+struct RestartRecordHeader
+{
+  /// bytes of the serialized ParamResponsePair following the header
+  UInt64 length;
+  /// IndexedRestart::record_key() of the interface id and variables
+  UInt64 varsKey;
+  /// evaluation id of the record
+  int evalId;
+  /// reserved; zero
+  unsigned int padding;
+};
+
+/// Fixed-layout entry of the trailing index of an indexed restart file
+struct RestartIndexEntry
+{
+  /// file offset of the record header
+  UInt64 offset;
+  /// bytes of the serialized ParamResponsePair
+  UInt64 length;
+  /// IndexedRestart::record_key() of the interface id and variables
+  UInt64 varsKey;
+  /// evaluation id of the record
+  int evalId;
+  /// reserved; zero
+  unsigned int padding;
+};
+
+/// Fixed-layout trailer of an indexed restart file
+struct RestartIndexFooter
+{
+  /// file offset of the first RestartIndexEntry
+  UInt64 indexOffset;
+  /// number of records (and index entries)
+  UInt64 numRecords;
+  /// file offset of the first record header
+  UInt64 dataOffset;
+  /// identifies a complete indexed restart file
+  UInt64 magic;
+};
+
+
+/// Low-level writer/reader functions for the indexed restart format
+
+/** An indexed restart file begins with the same Boost archive header
+    and RestartVersion as a sequential restart file, such that
+    RestartVersion::check_restart_version() identifies either format.
+    Records follow as a RestartRecordHeader and a self-contained
+    (headerless) binary archive of one ParamResponsePair, permitting
+    any record to be deserialized independently of the others.  A
+    table of RestartIndexEntry in file order and a RestartIndexFooter
+    conclude the file.  Numeric fields are in native byte order; as
+    for sequential restart files, neutral files are the portable
+    format. */
+namespace IndexedRestart {
+
+/// magic number identifying a complete index ("DAKIRST1")
+const UInt64 footerMagic = 0x3154535249414b44ULL;
+
+/// key of the interface id and variable values (those compared by
+/// Variables operator==) stored with each record; defined here rather
+/// than by boost::hash, whose output varies between Boost versions, so
+/// that keys written by one build remain valid in another
+UInt64 record_key(const String& interface_id, const Variables& vars);
+
+/// append a record for prp at the current put position of os and
+/// return its index entry
+RestartIndexEntry write_record(std::ostream& os, const ParamResponsePair& prp);
+
+/// append the index and footer at the current put position of os
+void write_index(std::ostream& os, const std::vector<RestartIndexEntry>& index,
+		 UInt64 data_offset);
+
+} // namespace IndexedRestart
+
+
+/// Random-access reader for indexed restart files
+
+/** The file is memory mapped where supported (read into memory
+    otherwise) and records are deserialized only on request, allowing
+    O(1) access to any record by position or (interface id,
+    variables) and O(log n) access by evaluation id.  Bulk loads
+    deserialize records concurrently.  A file lacking a valid index
+    (e.g., after an abort) is recovered by scanning record headers. */
+class IndexedRestartReader
+{
+public:
+
+  //
+  //- Heading: Constructors and destructor
+  //
+
+  /// open and map read_restart_filename, reading its version and index
+  IndexedRestartReader(const String& read_restart_filename);
+  /// destructor; unmaps the file
+  ~IndexedRestartReader();
+
+  //
+  //- Heading: Member functions
+  //
+
+  /// version information from the file header
+  const RestartVersion& version() const;
+  /// number of records
+  size_t num_records() const;
+  /// index entry of the i-th record (in file order)
+  const RestartIndexEntry& entry(size_t i) const;
+  /// whether the index was recovered by a scan of record headers
+  bool index_recovered() const;
+
+  /// deserialize the i-th record into prp
+  void read_record(size_t i, ParamResponsePair& prp) const;
+  /// address of the serialized i-th record, including its header
+  const char* record_data(size_t i) const;
+
+  /// deserialize records [0, num_recs) into prps (in file order),
+  /// concurrently on the shared kernel threads (see kernel_threads)
+  void read_records(size_t num_recs, PRPArray& prps) const;
+
+  /// find the (last written) record with the given evaluation id
+  bool find_eval_id(int eval_id, ParamResponsePair& prp);
+  /// find the (last written) record matching the interface id and
+  /// variables exactly
+  bool find(const String& interface_id, const Variables& vars,
+	    ParamResponsePair& prp);
+
+private:
+
+  //
+  //- Heading: Convenience functions
+  //
+
+  /// map (or read) the file into fileData
+  void map_file();
+  /// read the trailing index, or rebuild it by scanning record headers
+  void read_index();
+
+  //
+  //- Heading: Data
+  //
+
+  /// name of the restart file
+  String restartFilename;
+  /// version read from the file header
+  RestartVersion restartVersion;
+
+  /// start of the file contents
+  const char* fileData;
+  /// bytes in the file
+  size_t fileSize;
+  /// true if fileData is a memory mapping (else owned by fileBuffer)
+  bool fileMapped;
+  /// file contents when memory mapping is unavailable
+  std::vector<char> fileBuffer;
+
+  /// copy of (or rebuilt) index entries, in file order
+  std::vector<RestartIndexEntry> recordIndex;
+  /// whether recordIndex was rebuilt from record headers
+  bool indexRecovered;
+
+  /// positions into recordIndex ordered by evaluation id (built on demand)
+  std::vector<size_t> evalIdOrder;
+  /// positions into recordIndex keyed by varsKey (built on demand)
+  std::unordered_multimap<UInt64, size_t> keyIndex;
+};
+
+
+inline const RestartVersion& IndexedRestartReader::version() const
+{ return restartVersion; }
+
+
+inline size_t IndexedRestartReader::num_records() const
+{ return recordIndex.size(); }
+
+
+inline const RestartIndexEntry& IndexedRestartReader::entry(size_t i) const
+{ return recordIndex[i]; }
+
+
+inline bool IndexedRestartReader::index_recovered() const
+{ return indexRecovered; }
+
+
+inline const char* IndexedRestartReader::record_data(size_t i) const
+{ return fileData + recordIndex[i].offset; }
+
+} // namespace Dakota
+
+#endif // DAKOTA_INDEXED_RESTART_H
@@ -12,8 +12,12 @@
 
 #include "dakota_data_types.hpp"
 #include "dakota_stat_util.hpp"
+#include "WorkStealingThreadPool.hpp"
 // #include "ProblemDescDB.hpp"
 
+#include <algorithm>
+#include <vector>
+
 namespace Dakota {
 
 /// Abstract class for low-discrepancy sequences
@@ -111,6 +115,13 @@ public:
   /// generating unique samples
   virtual void randomize() = 0;
 
+  /// Returns true if the points with index `nMin`, `nMin` + 1, ..., `nMax` - 1
+  /// can be generated in consecutive blocks, i.e., if the position of each
+  /// point does not depend on the range of points requested
+  /// NOTE: required for generating samples on demand in
+  /// `NonDLowDiscrepancySampling`
+  virtual bool consecutive_blocks() const { return true; }
+
 protected:
 
   /// Maximum dimension of this low-discrepancy sequence
@@ -182,6 +193,38 @@ protected:
       RealMatrix& points
   ) = 0;
 
+  /// Split the points with index `nMin`, `nMin` + 1, ..., `nMax` - 1 into
+  /// consecutive ranges and call `generate(first, last)` for each range on
+  /// the threads shared by Dakota's numerical kernels (see `kernel_threads`)
+  /// Each range gets at least `minEntriesPerRange` point entries, so small
+  /// requests are generated in a single call
+  /// NOTE: `generate` must produce the same points for any split of the
+  /// ranges
+  template<typename Generator>
+  void generate_in_parallel(
+    const size_t nMin,
+    const size_t nMax,
+    const size_t dimension,
+    Generator generate
+  )
+  {
+    const size_t minEntriesPerRange = 1 << 16;
+    size_t numPoints = nMax - nMin;
+    size_t numEntries = numPoints * std::max(dimension, size_t(1));
+    size_t numRanges = std::max<size_t>(1, std::min<size_t>(
+      dakota::util::WorkStealingThreadPool::kernel_concurrency(),
+      numEntries / minEntriesPerRange
+    ));
+
+    dakota::util::WorkStealingThreadPool::parallel_for(numRanges,
+      [&](size_t r)
+      {
+        generate(nMin + numPoints * r / numRanges,
+          nMin + numPoints * (r + 1) / numRanges);
+      }
+    );
+  }
+
 private:
 
   /// Perform checks on dMax
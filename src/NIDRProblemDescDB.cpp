@@ -6524,7 +6524,9 @@ static Iface_mp_type
 	MP2s(evalScheduling,PEER_DYNAMIC_SCHEDULING),
 	MP2s(evalScheduling,PEER_STATIC_SCHEDULING),
 	MP2s(asynchLocalEvalScheduling,DYNAMIC_SCHEDULING),
-        MP2s(asynchLocalEvalScheduling,STATIC_SCHEDULING);
+        MP2s(asynchLocalEvalScheduling,STATIC_SCHEDULING),
+	MP2s(evalCacheType,MULTI_INDEX_CACHE),
+	MP2s(evalCacheType,SHARDED_CACHE);
 
 static Iface_mp_utype
 	MP2s(interfaceType,TEST_INTERFACE),
@@ -6537,10 +6539,12 @@ static Iface_mp_utype
 	MP2s(interfaceType,SCILAB_INTERFACE),
 	MP2s(interfaceType,SYSTEM_INTERFACE),
 	//MP2s(resultsFileFormat,FLEXIBLE_RESULTS), // re-enable when more formats added?
-	MP2s(resultsFileFormat,LABELED_RESULTS);
+	MP2s(resultsFileFormat,LABELED_RESULTS),
+	MP2s(resultsFileFormat,BINARY_RESULTS);
 
 static String
 	MP_(algebraicMappings),
+	MP_(evalCacheSpillFile),
 	MP_(idInterface),
 	MP_(inputFilter),
 	MP_(outputFilter),
@@ -6563,14 +6567,20 @@ static bool
 	MP_(apreproFlag),
 	MP_(asynchFlag),
 	MP_(batchEvalFlag),
+	MP_(columnarFlag),
+	MP_(costAwareSchedFlag),
 	MP_(dirSave),
 	MP_(dirTag),
 	MP_(evalCacheFlag),
+	MP_(evalChunkingFlag),
 	MP_(fileSaveFlag),
 	MP_(fileTagFlag),
 	MP_(nearbyEvalCacheFlag),
 	MP_(numpyFlag),
+	MP_(processLauncherFlag),
 	MP_(restartFileFlag),
+	MP_(stageHardlinks),
+	MP_(stageWorkdir),
 	MP_(templateReplace),
 	MP_(useWorkdir),
 	MP_(verbatimFlag);
@@ -6579,11 +6589,16 @@ static int
 	MP_(analysisServers),
 	MP_(asynchLocalAnalysisConcurrency),
 	MP_(asynchLocalEvalConcurrency),
+	MP_(evalCacheMaxEntries),
+	MP_(evalCacheShards),
+	MP_(evalChunkMax),
 	MP_(evalServers),
 	MP_(procsPerAnalysis),
-	MP_(procsPerEval);
+	MP_(procsPerEval),
+	MP_(stagePoolSize);
 
 static Real
+	MP_(evalCacheMaxMemory),
 	MP_(nearbyEvalCacheTol);
 
 #undef MP3
@@ -6630,6 +6645,8 @@ static Method_mp_lit
 	MP2(batchSelectionType,distance),
 	MP2(batchSelectionType,topology),
 	MP2(batchSelectionType,cl),
+	MP2(batchSelectionType,kriging_believer),
+	MP2(batchSelectionType,local_penalization),
 	MP2(boxDivision,all_dimensions),
 	MP2(boxDivision,major_dimension),
 	MP2(convergenceType,average_fitness_tracker),
@@ -6940,6 +6957,7 @@ static bool
 	MP_(speculativeFlag),
 	MP_(standardizedSpace),
         MP_(stdRegressionCoeffs),
+        MP_(streamingStatsFlag),
         MP_(toleranceIntervalsFlag),
 	MP_(surrBasedGlobalReplacePts),
 	MP_(surrBasedLocalLayerBypass),
@@ -7012,12 +7030,14 @@ static int
 	MP_(totalPatternSize),
 	MP_(verifyLevel),
 	MP_(vbdViaSamplingNumBins),
+	MP_(vbdBootstrapSamples),
   MP_(log2MaxPoints),
   MP_(numberOfBits),
   MP_(scrambleSize);
 
 static size_t
 	MP_(collocationPoints),
+	MP_(evaluationWindow),
         MP_(expansionSamples),
         MP_(kickRank),
         MP_(maxCVRankCandidates),
@@ -7034,6 +7054,7 @@ static size_t
 	MP_(numOffspring),
 	MP_(numParents),
 	MP_(numPredConfigs),
+	MP_(quantileSketchSize),
   //MP_(startOrder),
   MP_(startRank);
 
@@ -7738,6 +7759,8 @@ static Env_mp_utype
         MP2s(tabularFormat,TABULAR_EVAL_ID),
         MP2s(tabularFormat,TABULAR_IFACE_ID),
         MP2s(tabularFormat,TABULAR_ANNOTATED),
+        MP2s(writeRestartCommit,RESTART_COMMIT_EVERY_EVAL),
+        MP2s(writeRestartCommit,RESTART_COMMIT_CHECKPOINT),
         MP2s(resultsOutputFormat,RESULTS_OUTPUT_TEXT),
         MP2s(resultsOutputFormat,RESULTS_OUTPUT_HDF5),
         MP2s(modelEvalsSelection,MODEL_EVAL_STORE_TOP_METHOD),
@@ -7770,11 +7793,19 @@ static bool
 	MP_(preRunFlag),
         MP_(resultsOutputFlag),
 	MP_(runFlag),
-	MP_(tabularDataFlag);
+	MP_(tabularDataFlag),
+	MP_(writeRestartFsync),
+	MP_(writeRestartIndexed);
 
 static int
+        MP_(kernelThreads),
         MP_(outputPrecision),
-        MP_(stopRestart);
+        MP_(resultsOutputBufferSize),
+        MP_(resultsOutputCompression),
+        MP_(resultsOutputFlushSeconds),
+        MP_(stopRestart),
+        MP_(writeRestartCommitEvals),
+        MP_(writeRestartCommitSeconds);
 
 //#undef MP2
 #undef MP2s
@@ -10,7 +10,7 @@
 #include "NonDDREAMBayesCalibration.hpp"
 #include "ProblemDescDB.hpp"
 #include "DakotaModel.hpp"
-#include "PRPMultiIndex.hpp"
+#include "PRPShardedCache.hpp"
 
 // BMA TODO: remove this header
 // for uniform PDF and samples
@@ -77,7 +77,6 @@ double sample_likelihood (int par_num, double zp[])
 
 namespace Dakota {
 
-extern PRPCache data_pairs; // global container
 
 //initialization of statics
 NonDDREAMBayesCalibration* NonDDREAMBayesCalibration::nonDDREAMInstance(NULL);
@@ -502,8 +501,8 @@ void NonDDREAMBayesCalibration::archive_acceptance_chain()
     }
     else {
       lookup_pr.variables(lookup_vars);
-      PRPCacheHIter cache_it = lookup_by_val(data_pairs, lookup_pr);
-      if (cache_it == data_pairs.get<hashed>().end()) {
+      ParamResponsePair cache_pr;
+      if (!lookup_evaluation(lookup_pr, cache_pr)) {
 	++lookup_failures;
 	// Set NaN in the chain points to avoid misleading the user
 	RealVector nan_fn_vals(mcmcModel.current_response().function_values().length());
@@ -511,7 +510,7 @@ void NonDDREAMBayesCalibration::archive_acceptance_chain()
 	Teuchos::setCol(nan_fn_vals, sample_index, acceptedFnVals);
       }
       else {
-	const RealVector& fn_vals = cache_it->response().function_values();
+	const RealVector& fn_vals = cache_pr.response().function_values();
 	Teuchos::setCol(fn_vals, sample_index, acceptedFnVals);
       }
     }
@@ -51,6 +51,7 @@ NonDLHSSampling::NonDLHSSampling(ProblemDescDB& problem_db, Model& model):
   pcaFlag(probDescDB.get_bool("method.principal_components")),
   vbdViaSamplingMethod(probDescDB.get_ushort("method.vbd_via_sampling_method")),
   vbdViaSamplingNumBins(probDescDB.get_int("method.vbd_via_sampling_num_bins")),
+  vbdBootstrapSamples(probDescDB.get_int("method.vbd_bootstrap_samples")),
   percentVarianceExplained(
     probDescDB.get_real("method.percent_variance_explained"))
 {
@@ -70,6 +71,13 @@ NonDLHSSampling::NonDLHSSampling(ProblemDescDB& problem_db, Model& model):
         abort_handler(METHOD_ERROR); 
   }
 
+  if (streamingStats && (refineSamples.length() || pcaFlag)) {
+    Cerr << "\nError: streaming_statistics does not retain the sampled "
+	 << "responses required by\n       refinement_samples or "
+	 << "principal_components.\n";
+    abort_handler(METHOD_ERROR);
+  }
+
   if (dOptimal) {
     const SharedVariablesData& svd = model.current_variables().shared_data();
     const SizetArray& ac_totals = svd.active_components_totals();
@@ -661,8 +669,16 @@ void NonDLHSSampling::post_input()
     statistics on the set of responses if statsFlag is set. */
 void NonDLHSSampling::core_run()
 {
-  bool log_resp_flag = (allDataFlag || statsFlag);
+  // streamed statistics do not require allResponses
+  bool log_resp_flag = (streamingStats) ? allDataFlag :
+    (allDataFlag || statsFlag);
   bool log_best_flag = !numResponseFunctions; // DACE mode w/ opt or NLS
+  if (streamingStats && vbdFlag)
+    nonDSampCorr.initialize_pick_and_freeze(numFunctions,
+      numContinuousVars + numDiscreteIntVars + numDiscreteRealVars +
+      numDiscreteStringVars, numSamples, vbdBootstrapSamples);
+  else if (streamingStats)
+    initialize_streaming_statistics();
   evaluate_parameter_sets(iteratedModel, log_resp_flag, log_best_flag);
 
   //Needed if we want to do bootstrapping for covariance of 
@@ -670,6 +686,17 @@ void NonDLHSSampling::core_run()
   //store_evaluations(); 
 }
 
+/** With VBD, streamed responses feed the pick-and-freeze estimators
+    in place of the moment and level statistics. */
+void NonDLHSSampling::accumulate_response(int eval_id, const Response& resp)
+{
+  if (vbdFlag)
+    nonDSampCorr.accumulate_pick_and_freeze(resp.function_values());
+  else
+    NonDSampling::accumulate_response(eval_id, resp);
+}
+
+
 void NonDLHSSampling::store_evaluations(){
   int eval_index = 0; //qoiSamplesMatrix.numCols(); //old size
   qoiSamplesMatrix.reshape(numFunctions, numSamples);
@@ -737,7 +764,8 @@ void NonDLHSSampling::post_run(std::ostream& s)
                                                   numContinuousVars + numDiscreteIntVars + numDiscreteRealVars + numDiscreteStringVars,
                                                   numSamples,
                                                   allSamples,
-                                                  allResponses);
+                                                  allResponses,
+                                                  vbdBootstrapSamples);
       nonDSampCorr.archive_sobol_indices(run_identifier(),
                                          resultsDB,
                                          iteratedModel.ordered_labels(),
@@ -1039,7 +1067,7 @@ void NonDLHSSampling::print_results(std::ostream& s, short results_state)
     if(refineSamples.length() == 0) {
       compute_statistics(allSamples, allResponses);
       archive_results(numSamples);
-      int actual_samples = allSamples.numCols();
+      int actual_samples = num_parameter_sets();
       print_header_and_statistics(s, actual_samples);
     } else {  // iterate over refinement_samples to generate incremental stats
       // assume that the keys (eval ids) of allResponses are consecutive
@@ -1096,7 +1124,7 @@ void NonDLHSSampling::archive_results(int num_samples, size_t inc_id) {
   }
 
   // Archive correlations
-  if (!subIteratorFlag) {
+  if (!subIteratorFlag && !streamingStats) {
     nonDSampCorr.archive_correlations(run_identifier(), resultsDB, iteratedModel.ordered_labels(),
                                       iteratedModel.response_labels(),inc_id);
   }
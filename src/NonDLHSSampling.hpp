@@ -87,6 +87,10 @@ protected:
   /// generate statistics for LHS runs in non-VBD cases
   void post_run(std::ostream& s);
 
+  /// accumulate a streamed response into the statistics or, with
+  /// VBD, into the pick-and-freeze estimators
+  void accumulate_response(int eval_id, const Response& resp);
+
   void post_input();
 
   /// update finalStatistics and (if MC sampling) finalStatErrors
@@ -173,6 +177,10 @@ private:
   /// number of bins for using with the Mahadevan sampling method for computing variance-based decomposition indices
   int vbdViaSamplingNumBins;
 
+  /// number of bootstrap resamples for confidence intervals on
+  /// pick-and-freeze variance-based decomposition indices
+  int vbdBootstrapSamples;
+
   /// flag to specify the calculation of principal components
   bool pcaFlag;
   /// Threshold to keep number of principal components that explain 
@@ -10,7 +10,7 @@
 #include "dakota_system_defs.hpp"
 #include "DakotaResponse.hpp"
 #include "ParamResponsePair.hpp"
-#include "PRPMultiIndex.hpp"
+#include "PRPShardedCache.hpp"
 #include "ProblemDescDB.hpp"
 #include "DakotaGraphics.hpp"
 #include "NonDLocalReliability.hpp"
@@ -38,7 +38,6 @@ static const char rcsId[] = "@(#) $Id: NonDLocalReliability.cpp 4058 2006-10-25
 
 namespace Dakota {
 
-extern PRPCache data_pairs; // global container
 
 // initialization of statics
 NonDLocalReliability* NonDLocalReliability::nondLocRelInstance(NULL);
@@ -1599,7 +1598,7 @@ update_mpp_search_data(const Variables& vars_star, const Response& resp_star)
     if ( integrationOrder == 2 ) {// apply 2nd-order integr in all RIA/PMA cases
       mode |= 4;
       // RecastModel::transform_set() normally handles this, but we are
-      // bypassing the Recast and pulling iteratedModel data from data_pairs
+      // bypassing the Recast and pulling iteratedModel data from the cache
       std::shared_ptr<RecastModel> pt_model_rep =
 	std::static_pointer_cast<RecastModel>(uSpaceModel.model_rep());
       if (pt_model_rep->nonlinear_variables_mapping())
@@ -1611,16 +1610,16 @@ update_mpp_search_data(const Variables& vars_star, const Response& resp_star)
       uSpaceModel.trans_U_to_X(mostProbPointU, mostProbPointX);
     // retrieve previously evaluated gradient information, if possible
     if (mode & 2) { // avail in all RIA/PMA cases (exception: numerical grads)
-      // query data_pairs to retrieve the fn gradient at the MPP
+      // query the evaluation cache to retrieve the fn gradient at the MPP
       Variables search_vars = iteratedModel.current_variables().copy();
       search_vars.continuous_variables(mostProbPointX);
       ActiveSet search_set = resp_star.active_set();
       ShortArray search_asv(numFunctions, 0);  search_asv[respFnCount] = 2;
       search_set.request_vector(search_asv);
-      PRPCacheHIter cache_it = lookup_by_val(data_pairs,
-	iteratedModel.interface_id(), search_vars, search_set);
-      if (cache_it != data_pairs.get<hashed>().end()) {
-	fnGradX = cache_it->response().function_gradient_copy(respFnCount);
+      ParamResponsePair cache_pr;
+      if (lookup_evaluation(iteratedModel.interface_id(), search_vars,
+			    search_set, cache_pr)) {
+	fnGradX = cache_pr.response().function_gradient_copy(respFnCount);
 	uSpaceModel.trans_grad_X_to_U(fnGradX, fnGradU, mostProbPointX);
 	found_mode |= 2;
       }
@@ -1631,16 +1630,16 @@ update_mpp_search_data(const Variables& vars_star, const Response& resp_star)
     if ( ( mode & 4 ) && !ria_flag &&
 	 ( levelCount <  rl_len + pl_len ||
 	   levelCount >= rl_len + pl_len + bl_len ) ) {
-      // query data_pairs to retrieve the fn Hessian at the MPP
+      // query the evaluation cache to retrieve the fn Hessian at the MPP
       Variables search_vars = iteratedModel.current_variables().copy();
       search_vars.continuous_variables(mostProbPointX);
       ActiveSet search_set = resp_star.active_set();
       ShortArray search_asv(numFunctions, 0);  search_asv[respFnCount] = 4;
       search_set.request_vector(search_asv);
-      PRPCacheHIter cache_it = lookup_by_val(data_pairs,
-	iteratedModel.interface_id(), search_vars, search_set);
-      if (cache_it != data_pairs.get<hashed>().end()) {
-        fnHessX = cache_it->response().function_hessian(respFnCount);
+      ParamResponsePair cache_pr;
+      if (lookup_evaluation(iteratedModel.interface_id(), search_vars,
+			    search_set, cache_pr)) {
+        fnHessX = cache_pr.response().function_hessian(respFnCount);
 	uSpaceModel.trans_hess_X_to_U(fnHessX, fnHessU, mostProbPointX,fnGradX);
 	curvatureDataAvailable = true; kappaUpdated = false;
 	found_mode |= 4;
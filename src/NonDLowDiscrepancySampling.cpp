@@ -207,6 +207,67 @@ void NonDLowDiscrepancySampling::get_parameter_sets(
     colPtr += num_samples;
 }
 
+/// Generate the samples on demand when they are not needed after the run
+/// NOTE: this requires streamed statistics, a sampling mode that transforms
+/// the points to the marginal distributions, and no refinement samples,
+/// 'unique' samples or results that need the samples after the run; the
+/// samples are then generated in blocks by `get_parameter_set_block` as
+/// `evaluate_parameter_sets` proceeds, and are identical to the samples
+/// generated up front
+void NonDLowDiscrepancySampling::pre_run()
+{
+  numLazyParameterSets = 0;
+  bool transform_mode = samplingVarsMode == ACTIVE ||
+    samplingVarsMode == DESIGN || samplingVarsMode == ALEATORY_UNCERTAIN ||
+    samplingVarsMode == EPISTEMIC_UNCERTAIN ||
+    samplingVarsMode == UNCERTAIN || samplingVarsMode == STATE ||
+    samplingVarsMode == ALL;
+  if ( !streamingStats || vbdFlag || subIteratorFlag || allDataFlag ||
+    stdRegressionCoeffs || pcaFlag || backfillDuplicates || dOptimal ||
+    !refineSamples.empty() || !transform_mode ||
+    !sequence->consecutive_blocks() )
+  {
+    NonDLHSSampling::pre_run();
+    return;
+  }
+
+  NonDSampling::pre_run();
+  resize_final_statistics_gradients(); // finalStats ASV available at run time
+
+  /// Check if low-discrepancy sampling supports the random variables 
+  /// associated with this model
+  check_support(iteratedModel.multivariate_distribution());
+
+  /// Only the number of parameters is needed up front
+  size_t cv_start, num_cv, div_start, num_div, dsv_start, num_dsv,
+    drv_start, num_drv;
+  mode_counts(iteratedModel.current_variables(), cv_start, num_cv, div_start,
+    num_div, dsv_start, num_dsv, drv_start, num_drv);
+  allSamples.shape(num_cv + num_div + num_dsv + num_drv, 0);
+  numLazyParameterSets = numSamples;
+}
+
+/// Generate the samples with index `start`, `start` + 1, ...,
+/// `start` + `num_sets` - 1 in the leading columns of `allSamples`
+void NonDLowDiscrepancySampling::get_parameter_set_block(
+  Model& model,
+  size_t start,
+  size_t num_sets
+)
+{
+  if ( allSamples.numCols() != num_sets )
+  {
+    allSamples.reshape(allSamples.numRows(), num_sets);
+  }
+
+  /// Generate points from the low-discrepancy sequence
+  sequence->get_points(colPtr + start, colPtr + start + num_sets, allSamples);
+
+  /// Transform points from [0, 1) to the marginal distributions given in
+  /// the model
+  transform(model, allSamples);
+}
+
 /// Generate a set of rank-1 lattice points using the given lower and upper
 /// bounds and store the results in `allSamples`
 void NonDLowDiscrepancySampling::get_parameter_sets(
@@ -241,60 +302,71 @@ void NonDLowDiscrepancySampling::get_parameter_sets(
 /// Function to transform a given sample matrix from [0, 1) to the probability
 /// density functions given in the model
 /// Assumes that the sample matrix has shape `numParams` x `numSamples`
+/// NOTE: the scaling to [-1, 1) and the inverse CDF transformation(s) are
+/// fused into a single pass over the samples, so that each sample is
+/// transformed while it is in cache; the results are identical to scaling
+/// all samples first and then calling `transform_samples`
 void NonDLowDiscrepancySampling::transform(
   Model& model,
   RealMatrix& sample_matrix
 )
 {
-  /// Transform the samples to [-1, 1]
   auto numParams = sample_matrix.numRows();
-  RealVector lower(numParams);
-  RealVector upper(numParams);
-  lower = -1.0;
-  upper = 1.0;
-  scale(lower, upper, sample_matrix); // transform from [0, 1) to [-1, 1)
-
-  /// If correlated, tranform samples to standard normal first
-  if ( model.multivariate_distribution().correlation() )
+  auto numSamples = sample_matrix.numCols();
+  SizetMultiArrayConstView cv_ids = model.continuous_variable_ids();
+  bool correlated = model.multivariate_distribution().correlation();
+
+  /// vSpaceModel has uncorrelated standard normal random variables and 
+  /// uSpaceModel has uncorrelated standard uniform random variables
+  /// If correlated, samples are tranformed to standard normal first
+  Model vSpaceModel, uSpaceModel;
+  if ( correlated )
   {
-    /// vSpaceModel has uncorrelated standard normal random variables
-    Model vSpaceModel;
     vSpaceModel.assign_rep(
       std::make_shared<ProbabilityTransformModel>(model, STD_NORMAL_U)
     );
-
-    /// uSpaceModel has uncorrelated standard uniform random variables
-    Model uSpaceModel;
     uSpaceModel.assign_rep(
       std::make_shared<ProbabilityTransformModel>(vSpaceModel, STD_UNIFORM_U)
     );
-
-    /// First transform from standard uniform to standard normal
-    Pecos::ProbabilityTransformation& uNataf = 
-      uSpaceModel.probability_transformation();
-    transform_samples(uNataf, sample_matrix, model.continuous_variable_ids(), 
-      model.continuous_variable_ids(), false);
-
-    // Then transform from standard normal to actual model
-    Pecos::ProbabilityTransformation& vNataf = 
-      vSpaceModel.probability_transformation();
-    transform_samples(vNataf, sample_matrix, model.continuous_variable_ids(), 
-      model.continuous_variable_ids(), false);
   }
   else // If uncorrelated, directly apply the transform
   {
-    /// uSpaceModel has uncorrelated standard uniform random variables
-    Model uSpaceModel;
     uSpaceModel.assign_rep(
       std::make_shared<ProbabilityTransformModel>(model, STD_UNIFORM_U)
     );
+  }
+  Pecos::ProbabilityTransformation& uNataf = 
+    uSpaceModel.probability_transformation();
 
-    /// Transform samples using Nataf transformation (component-wise inverse CDF)
-    Pecos::ProbabilityTransformation& uNataf = 
-      uSpaceModel.probability_transformation();
-    transform_samples(uNataf, sample_matrix, model.continuous_variable_ids(), 
-      model.continuous_variable_ids(), false);
-  } 
+  RealVector u_samp(numContinuousVars);
+  RealVector z_samp(correlated ? numContinuousVars : 0);
+  for ( size_t col = 0; col < numSamples; col++ )
+  {
+    /// Transform the sample to [-1, 1)
+    Real* sample = sample_matrix[col];
+    for ( size_t row = 0; row < numParams; row++ )
+    {
+      sample[row] = sample[row]*(1.0 - -1.0) + -1.0;
+    }
+    std::copy(sample, sample + numContinuousVars, u_samp.values());
+
+    /// Transform the sample using Nataf transformation(s) (component-wise
+    /// inverse CDF)
+    RealVector x_samp(Teuchos::View, sample, numContinuousVars);
+    if ( correlated )
+    {
+      /// First transform from standard uniform to standard normal, then
+      /// from standard normal to actual model
+      uNataf.trans_U_to_X(u_samp, cv_ids, z_samp, cv_ids);
+      vSpaceModel.probability_transformation().trans_U_to_X(
+        z_samp, cv_ids, x_samp, cv_ids
+      );
+    }
+    else
+    {
+      uNataf.trans_U_to_X(u_samp, cv_ids, x_samp, cv_ids);
+    }
+  }
 }
 
 /// Function to scale a given sample matrix from [0, 1) to the given lower and
@@ -93,6 +93,18 @@ protected:
     RealSymMatrix& correl
   );
 
+  /// Generate the samples on demand when they are not needed after the
+  /// run, otherwise generate all samples as in `NonDLHSSampling`
+  void pre_run();
+
+  /// Generate the samples with index `start`, `start` + 1, ...,
+  /// `start` + `num_sets` - 1 in the leading columns of `allSamples`
+  void get_parameter_set_block(
+    Model& model,
+    size_t start,
+    size_t num_sets
+  );
+
   // 
   // - Heading: Member functions
   // 
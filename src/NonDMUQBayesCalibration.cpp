@@ -14,7 +14,7 @@
 #include "DakotaModel.hpp"
 #include "ProbabilityTransformation.hpp"
 #include "NonDSampling.hpp"
-#include "PRPMultiIndex.hpp"
+#include "PRPShardedCache.hpp"
 #include "MUQ/Utilities/RandomGenerator.h"
 #include "MUQ/Utilities/AnyHelpers.h"
 #include "MUQ/SamplingAlgorithms/MHProposal.h"
@@ -28,7 +28,6 @@
 
 namespace Dakota {
 
-extern PRPCache data_pairs; // global container
 
 
 // initialization of statics, not being used yet
@@ -465,8 +464,8 @@ void NonDMUQBayesCalibration::cache_chain()
     }
     else {
       lookup_pr.variables(lookup_vars);
-      PRPCacheHIter cache_it = lookup_by_val(data_pairs, lookup_pr);
-      if (cache_it == data_pairs.get<hashed>().end()) {
+      ParamResponsePair cache_pr;
+      if (!lookup_evaluation(lookup_pr, cache_pr)) {
   ++lookup_failures;
   // Set NaN in the chain points to avoid misleading the user
   RealVector nan_fn_vals(mcmcModel.current_response().function_values().length());
@@ -474,7 +473,7 @@ void NonDMUQBayesCalibration::cache_chain()
   Teuchos::setCol(nan_fn_vals, i, acceptedFnVals);
       }
       else {
-  const RealVector& fn_vals = cache_it->response().function_values();
+  const RealVector& fn_vals = cache_pr.response().function_values();
   Teuchos::setCol(fn_vals, i, acceptedFnVals);
       }
     }
@@ -44,11 +44,15 @@ static const char rcsId[] = "@(#) $Id: NonDPOFDart.cpp 6080 2009-09-08 19:03:20Z
 
 namespace Dakota {
 
+bool NonDPOFDarts::bruteForceDefault(false);
+
+
 NonDPOFDarts::NonDPOFDarts(ProblemDescDB& problem_db, Model& model):
   NonD(problem_db, model), seed(probDescDB.get_int("method.random_seed")),
   emulatorSamples(probDescDB.get_int("method.nond.samples_on_emulator")),
   lipschitzType(probDescDB.get_string("method.lipschitz")),
-  samples(probDescDB.get_int("method.build_samples"))
+  samples(probDescDB.get_int("method.build_samples")),
+  _brute_force_queries(bruteForceDefault)
 {
     // any initialization is done here.   For now, you should just specify
     // the number of samples, but eventually we will get that from the input spec
@@ -85,6 +89,10 @@ NonDPOFDarts::NonDPOFDarts(ProblemDescDB& problem_db, Model& model):
 }
     
 
+void NonDPOFDarts::brute_force_queries(bool flag)
+{ bruteForceDefault = flag; }
+
+
 NonDPOFDarts::~NonDPOFDarts()
 { }
 
@@ -263,6 +271,8 @@ void NonDPOFDarts::core_run()
         _max_num_successive_misses = ceil(1.0 / p); // successive missed for the line darts algorithm
         
         _sample_points = new double*[_total_budget];
+        _point_index.reset(_n_dim);
+        _point_index.reserve(_total_budget);
         _sample_neighbors = new size_t*[_total_budget];
         _sample_vsize = new double[_total_budget];
         _dart = new double[_n_dim];
@@ -560,6 +570,8 @@ void NonDPOFDarts::core_run()
 
     bool NonDPOFDarts::valid_dart(double* x)
     {
+        if (!_brute_force_queries) return !_point_index.covered(x);
+        
         for (size_t index = 0; index < _num_inserted_points; index++)
         {
             double dd(0.0);
@@ -576,8 +588,15 @@ void NonDPOFDarts::core_run()
     
     bool NonDPOFDarts::valid_line_flat(size_t flat_dim, double* flat_dart)
     {
-        for (size_t index = 0; index < _num_inserted_points; index++)
+        // spheres intersecting the line, in index order
+        SizetArray candidates;
+        if (!_brute_force_queries) _point_index.covering(flat_dart, candidates, flat_dim);
+        size_t num_candidates = (_brute_force_queries) ? _num_inserted_points : candidates.size();
+        
+        for (size_t icandidate = 0; icandidate < num_candidates; icandidate++)
         {
+            size_t index = (_brute_force_queries) ? icandidate : candidates[icandidate];
+            
             double hh(0.0);
             for (size_t idim = 0; idim < _n_dim; idim++)
             {
@@ -668,6 +687,7 @@ void NonDPOFDarts::core_run()
         _sample_neighbors[_num_inserted_points][0] = 0;
         
         for (size_t idim = 0; idim < _n_dim; idim++) _sample_points[_num_inserted_points][idim] = x[idim];
+        _point_index.insert(x); // radius assigned below
         
         double* x_actual = new double[_n_dim];
         for (size_t idim = 0; idim < _n_dim; idim++) x_actual[idim] = _xmin[idim] + x[idim] * (_xmax[idim] - _xmin[idim]);
@@ -820,7 +840,8 @@ void NonDPOFDarts::core_run()
             
             // trim spoke using Voronoi faces
             size_t ineighbor(ipoint);
-            for (size_t jpoint = 0; jpoint < _num_inserted_points; jpoint++)
+            if (!_brute_force_queries) ineighbor = _point_index.trim_to_voronoi_cell(ipoint, tmp_pnt);
+            else for (size_t jpoint = 0; jpoint < _num_inserted_points; jpoint++)
             {
                 if (jpoint == ipoint) continue;
                 
@@ -948,7 +969,8 @@ void NonDPOFDarts::core_run()
             
             // trim spoke using Voronoi faces
             size_t ineighbor(ipoint);
-            for (size_t jpoint = 0; jpoint < _num_inserted_points; jpoint++)
+            if (!_brute_force_queries) ineighbor = _point_index.trim_to_voronoi_cell(ipoint, tmp_pnt);
+            else for (size_t jpoint = 0; jpoint < _num_inserted_points; jpoint++)
             {
                 if (jpoint == ipoint) continue;
                 
@@ -1056,8 +1078,7 @@ void NonDPOFDarts::core_run()
         
         if (L > 1E-10) r = fabs(_fval[_active_response_function][isample]  - _failure_threshold) / L; // radius based on Lipschitz
         
-        _sample_points[isample][_n_dim] = r * r;
-        if (_fval[_active_response_function][isample] < _failure_threshold) _sample_points[isample][_n_dim] = - _sample_points[isample][_n_dim];
+        assign_sphere_radius_sq(isample, r * r);
         
         if (_use_local_L)
         {
@@ -1065,8 +1086,16 @@ void NonDPOFDarts::core_run()
             
             // A sphere shouldn't contain a sample point that is not its neighbor
             
-            for (size_t jsample = 0; jsample < _num_inserted_points; jsample++)
+            // spheres overlapping the initial sphere of isample, in index order; radii
+            // only shrink below, so this superset is re-checked with current radii
+            SizetArray candidates;
+            if (!_brute_force_queries) _point_index.overlapping(_sample_points[isample], std::sqrt(fabs(_sample_points[isample][_n_dim])), candidates);
+            size_t num_candidates = (_brute_force_queries) ? _num_inserted_points : candidates.size();
+            
+            for (size_t icandidate = 0; icandidate < num_candidates; icandidate++)
             {
+                size_t jsample = (_brute_force_queries) ? icandidate : candidates[icandidate];
+                
                 //if (_sample_points[isample][_n_dim] * _sample_points[jsample][_n_dim] > 0.0) continue; // same color
                 
                 if (isample == jsample) continue;
@@ -1087,16 +1116,8 @@ void NonDPOFDarts::core_run()
                     L = fabs(_fval[_active_response_function][isample] - _fval[_active_response_function][jsample]) / dst;
                     double r_i_new = fabs(_fval[_active_response_function][isample] - _failure_threshold) / L;
                     double r_j_new = fabs(_fval[_active_response_function][jsample] - _failure_threshold) / L;
-                    if (r_i_new < r_i)
-                    {
-                        _sample_points[isample][_n_dim] = r_i_new * r_i_new;
-                        if (_fval[_active_response_function][isample] < _failure_threshold) _sample_points[isample][_n_dim] = - _sample_points[isample][_n_dim];
-                    }
-                    if (r_j_new < r_j)
-                    {
-                        _sample_points[jsample][_n_dim] = r_j_new * r_j_new;
-                        if (_fval[_active_response_function][jsample] < _failure_threshold) _sample_points[jsample][_n_dim] = - _sample_points[jsample][_n_dim];
-                    }
+                    if (r_i_new < r_i) assign_sphere_radius_sq(isample, r_i_new * r_i_new);
+                    if (r_j_new < r_j) assign_sphere_radius_sq(jsample, r_j_new * r_j_new);
                 }
             }
         }
@@ -1116,9 +1137,17 @@ void NonDPOFDarts::core_run()
         for (size_t isample = 0; isample < _num_inserted_points; isample++)
         {
             if (fabs(_sample_points[isample][_n_dim]) > 0.95 * 0.95 * rr_max) _sample_points[isample][_n_dim] *= (0.95 * 0.95);
+            _point_index.radius_sq(isample, fabs(_sample_points[isample][_n_dim]));
         }
     }
     
+    void NonDPOFDarts::assign_sphere_radius_sq(size_t isample, double r_sq)
+    {
+        _sample_points[isample][_n_dim] = r_sq;
+        if (_fval[_active_response_function][isample] < _failure_threshold) _sample_points[isample][_n_dim] = - r_sq;
+        _point_index.radius_sq(isample, r_sq);
+    }
+    
  
     double NonDPOFDarts::area_triangle(double x1, double y1, double x2, double y2, double x3, double y3)
     {
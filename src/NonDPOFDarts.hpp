@@ -15,6 +15,7 @@
 #include "DakotaNonD.hpp"
 #include "DakotaApproximation.hpp"
 #include "VPSApproximation.hpp"
+#include "SpatialIndex.hpp"
 
 
 
@@ -46,6 +47,10 @@ public:
   NonDPOFDarts(ProblemDescDB& problem_db, Model& model); ///< constructor
   ~NonDPOFDarts();                                       ///< destructor
 
+  /// scan all sample points instead of querying the spatial index in
+  /// subsequently constructed instances (validation of the index, e.g. in tests)
+  static void brute_force_queries(bool flag);
+
   //
   //- Heading: Virtual member function redefinitions
   //
@@ -110,6 +115,8 @@ protected:
     
     void  shrink_big_spheres(); // shrink all disks by 90% to allow more sampling
     
+    void assign_sphere_radius_sq(size_t isample, double r_sq); // signed by failure, mirrored in _point_index
+    
     double area_triangle(double x1, double y1, double x2, double y2, double x3, double y3);
    
     //////////////////////////////////////////////////////////////
@@ -194,6 +201,10 @@ protected:
     double*  _sample_vsize;
     double   _max_vsize; // size of biggest Voronoi cell
     
+    SpatialIndex _point_index; // k-d tree over sample points and sphere radii
+    bool _brute_force_queries; // scan all points instead of querying _point_index (validation)
+    static bool bruteForceDefault; // initial _brute_force_queries for new instances
+    
     // Darts
     double* _dart; // a dart for inserting a new sample point
     
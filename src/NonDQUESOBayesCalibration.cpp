@@ -13,7 +13,7 @@
 #include "ProblemDescDB.hpp"
 #include "ParallelLibrary.hpp"
 #include "DakotaModel.hpp"
-#include "PRPMultiIndex.hpp"
+#include "PRPShardedCache.hpp"
 // Dakota/QUESO interfaces
 #include "QUESOImpl.hpp"
 // finally list additional QUESO headers
@@ -25,7 +25,6 @@ static const char rcsId[]="@(#) $Id$";
 
 namespace Dakota {
 
-extern PRPCache data_pairs; // global container
 
 /// Static registration of RW TK with the QUESO TK factory
 TKFactoryDIPC tk_factory_dipc("dakota_dipc_tk");
@@ -512,8 +511,8 @@ void NonDQUESOBayesCalibration::cache_chain()
     }
     else {
       lookup_pr.variables(lookup_vars);
-      PRPCacheHIter cache_it = lookup_by_val(data_pairs, lookup_pr);
-      if (cache_it == data_pairs.get<hashed>().end()) {
+      ParamResponsePair cache_pr;
+      if (!lookup_evaluation(lookup_pr, cache_pr)) {
 	++lookup_failures;
 	// Set NaN in the chain points to avoid misleading the user
 	RealVector nan_fn_vals(mcmcModel.current_response().function_values().length());
@@ -521,7 +520,7 @@ void NonDQUESOBayesCalibration::cache_chain()
 	Teuchos::setCol(nan_fn_vals, i, acceptedFnVals);
       }
       else {
-	const RealVector& fn_vals = cache_it->response().function_values();
+	const RealVector& fn_vals = cache_pr.response().function_values();
 	Teuchos::setCol(fn_vals, i, acceptedFnVals);
       }
     }
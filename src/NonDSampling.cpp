@@ -40,7 +40,10 @@ NonDSampling::NonDSampling(ProblemDescDB& problem_db, Model& model):
   sampleType(probDescDB.get_ushort("method.sample_type")), samplesIncrement(0),
   stdRegressionCoeffs(probDescDB.get_bool("method.std_regression_coeffs")),
   toleranceIntervalsFlag(probDescDB.get_bool("method.tolerance_intervals")),
-  statsFlag(true), allDataFlag(false), samplingVarsMode(ACTIVE),
+  statsFlag(true), allDataFlag(false),
+  streamingStats(probDescDB.get_bool("method.streaming_statistics")),
+  quantileSketchSize(probDescDB.get_sizet("method.nond.quantile_sketch_size")),
+  samplingVarsMode(ACTIVE),
   sampleRanksMode(IGNORE_RANKS),
   varyPattern(!probDescDB.get_bool("method.fixed_seed")), 
   backfillDuplicates(probDescDB.get_bool("method.backfill")),
@@ -115,6 +118,21 @@ NonDSampling::NonDSampling(ProblemDescDB& problem_db, Model& model):
     tiNumValidSamples = 0;
   }
 
+  if (streamingStats) {
+    // these options require the full set of sampled responses; the
+    // pick-and-freeze VBD estimators are accumulated as they arrive
+    if (stdRegressionCoeffs || toleranceIntervalsFlag || wilksFlag ||
+	(vbdFlag && probDescDB.get_ushort("method.vbd_via_sampling_method")
+	 != VBD_PICK_AND_FREEZE)) {
+      Cerr << "\nError: streaming_statistics does not retain the sampled "
+	   << "responses required by\n       std_regression_coeffs, "
+	   << "tolerance_intervals, wilks, or binned variance_based_decomp."
+	   << std::endl;
+      abort_handler(METHOD_ERROR);
+    }
+    streamResponses = true;
+  }
+
   // update concurrency
   if (numSamples) // samples is optional (default = 0)
     maxEvalConcurrency *= numSamples;
@@ -131,7 +149,8 @@ NonDSampling(unsigned short method_name, Model& model,
   samplesSpec(samples), samplesRef(samples), numSamples(samples), rngName(rng),
   sampleType(sample_type), wilksFlag(false), samplesIncrement(0), stdRegressionCoeffs(false),
   toleranceIntervalsFlag(false),
-  statsFlag(false), allDataFlag(true), samplingVarsMode(sampling_vars_mode),
+  statsFlag(false), allDataFlag(true), streamingStats(false),
+  quantileSketchSize(4096), samplingVarsMode(sampling_vars_mode),
   sampleRanksMode(IGNORE_RANKS), varyPattern(vary_pattern),
   backfillDuplicates(false), numLHSRuns(0)
 {
@@ -167,7 +186,8 @@ NonDSampling(unsigned short sample_type, size_t samples, int seed,
   numSamples(samples), rngName(rng), sampleType(sample_type), wilksFlag(false),
   samplesIncrement(0), stdRegressionCoeffs(false),
   toleranceIntervalsFlag(false),
-  statsFlag(false), allDataFlag(true),
+  statsFlag(false), allDataFlag(true), streamingStats(false),
+  quantileSketchSize(4096),
   samplingVarsMode(ACTIVE_UNIFORM), sampleRanksMode(IGNORE_RANKS),
   varyPattern(true), backfillDuplicates(false), numLHSRuns(0)
 {
@@ -195,7 +215,8 @@ NonDSampling(unsigned short sample_type, size_t samples, int seed,
   numSamples(samples), rngName(rng), sampleType(sample_type), wilksFlag(false),
   samplesIncrement(0), stdRegressionCoeffs(false),
   toleranceIntervalsFlag(false),
-  statsFlag(false), allDataFlag(true),
+  statsFlag(false), allDataFlag(true), streamingStats(false),
+  quantileSketchSize(4096),
   samplingVarsMode(ACTIVE), sampleRanksMode(IGNORE_RANKS), varyPattern(true),
   backfillDuplicates(false), numLHSRuns(0)
 {
@@ -219,7 +240,8 @@ NonDSampling(Model& model, const RealMatrix& sample_matrix):
   samplesSpec(sample_matrix.numCols()), sampleType(SUBMETHOD_DEFAULT),
   wilksFlag(false), samplesIncrement(0), stdRegressionCoeffs(false),
   toleranceIntervalsFlag(false),
-  statsFlag(true), allDataFlag(true),
+  statsFlag(true), allDataFlag(true), streamingStats(false),
+  quantileSketchSize(4096),
   samplingVarsMode(ACTIVE), sampleRanksMode(IGNORE_RANKS),
   varyPattern(false), backfillDuplicates(false), numLHSRuns(0)
 {
@@ -400,6 +422,21 @@ get_parameter_sets(const RealVector& means, const RealVector& std_devs,
 }
 
 
+/** In the ACTIVE modes, sample_to_variables() assigns each sample to
+    the active variables in order, so for a mixed view without active
+    discrete variables a sample is exactly the active continuous
+    variable vector.  Relaxed views are excluded since their continuous
+    variables interleave relaxed discrete variables. */
+bool NonDSampling::samples_active_continuous(const Model& model) const
+{
+  short active_view = model.current_variables().view().first;
+  return ( samplingVarsMode == ACTIVE || samplingVarsMode == ACTIVE_UNIFORM )
+    && ( active_view == MIXED_ALL || active_view >= MIXED_DESIGN )
+    && (size_t)allSamples.numRows() == model.cv() && !model.div()
+    && !model.dsv() && !model.drv();
+}
+
+
 // Map the active variables from vars to sample_vars (a column in allSamples)
 void NonDSampling::
 sample_to_variables(const Real* sample_vars, Variables& vars, Model& model)
@@ -962,11 +999,38 @@ void NonDSampling::active_set_mapping()
     or allVariables. */
 void NonDSampling::core_run()
 {
-  bool log_resp_flag = (allDataFlag || statsFlag), log_best_flag = false;
+  // streamed statistics do not require allResponses
+  bool log_resp_flag = (streamingStats) ? allDataFlag :
+    (allDataFlag || statsFlag), log_best_flag = false;
+  if (streamingStats)
+    initialize_streaming_statistics();
   evaluate_parameter_sets(iteratedModel, log_resp_flag, log_best_flag);
 }
 
 
+/** Bins are accumulated for z -> p/beta* mappings and quantile sketches
+    for p/beta* -> z mappings; z -> beta and beta -> z mappings are
+    projected from the moments. */
+void NonDSampling::initialize_streaming_statistics()
+{
+  RealVectorArray bin_levels(numFunctions);
+  BoolDeque sketch_fns(numFunctions, false);
+  if (!epistemicStats)
+    for (size_t i=0; i<numFunctions; ++i) {
+      if (respLevelTarget != RELIABILITIES)
+	bin_levels[i] = requestedRespLevels[i];
+      sketch_fns[i] = ( !requestedProbLevels[i].empty() ||
+			!requestedGenRelLevels[i].empty() );
+    }
+  streamStats.initialize(numFunctions, bin_levels, sketch_fns,
+			 quantileSketchSize);
+}
+
+
+void NonDSampling::accumulate_response(int eval_id, const Response& resp)
+{ streamStats.update(resp.function_values()); }
+
+
 void NonDSampling::
 compute_statistics(const RealMatrix&     vars_samples,
 		   const IntResponseMap& resp_samples)
@@ -1015,7 +1079,8 @@ compute_statistics(const RealMatrix&     vars_samples,
       compute_level_mappings(resp_samples);
   }
 
-  if (!subIteratorFlag) {
+  // correlations require the stored response samples
+  if (!subIteratorFlag && !streamingStats) {
     nonDSampCorr.compute_correlations(vars_samples, resp_samples);
   }
 
@@ -1049,18 +1114,25 @@ compute_intervals(RealRealPairArray& extreme_fns, const IntResponseMap& samples)
   const StringArray& resp_labels = iteratedModel.response_labels();
 
   extreme_fns.resize(numFunctions);
+  if (streamingStats)
+    num_obs = streamStats.num_observations();
   IntRespMCIter it;
   for (i=0; i<numFunctions; ++i) {
     num_samp = 0;
     Real min = DBL_MAX, max = -DBL_MAX;
-    for (it=samples.begin(); it!=samples.end(); ++it) {
-      Real sample = it->second.function_value(i);
-      if (std::isfinite(sample)) { // neither NaN nor +/-Inf
-	if (sample < min) min = sample;
-	if (sample > max) max = sample;
-	++num_samp;
-      }
+    if (streamingStats) {
+      min = streamStats.minimum(i); max = streamStats.maximum(i);
+      num_samp = streamStats.count(i);
     }
+    else
+      for (it=samples.begin(); it!=samples.end(); ++it) {
+	Real sample = it->second.function_value(i);
+	if (std::isfinite(sample)) { // neither NaN nor +/-Inf
+	  if (sample < min) min = sample;
+	  if (sample > max) max = sample;
+	  ++num_samp;
+	}
+      }
     extreme_fns[i].first  = min;
     extreme_fns[i].second = max;
     if (num_samp != num_obs)
@@ -1123,8 +1195,37 @@ compute_moments(const IntResponseMap& samples, RealMatrix& moment_stats,
   if (!mom_fns && !mom_grads)
     return;
 
-  RealVectorArray fn_samples(num_obs);
   SizetArray sample_counts;
+  if (streamingStats) {
+    if (mom_grads) {
+      Cerr << "Error: moment gradients require stored response samples and "
+	   << "are not supported\n       by streaming_statistics." << std::endl;
+      abort_handler(METHOD_ERROR);
+    }
+    num_obs = streamStats.num_observations();
+    if (moment_stats.empty())
+      moment_stats.shapeUninitialized(4, numFunctions);
+    sample_counts.resize(numFunctions);
+    for (i=0; i<numFunctions; ++i) {
+      size_t num_samp = sample_counts[i] = streamStats.count(i);
+      if (num_samp != num_obs)
+	Cerr << "Warning: sampling statistics for " << labels[i] << " omit "
+	     << num_obs-num_samp << " failed evaluations out of " << num_obs
+	     << " samples.\n";
+      if (!num_samp)
+	Cerr << "Warning: Number of samples for " << labels[i]
+	     << " must be nonzero for moment calculation in NonDSampling::"
+	     << "compute_moments().\n";
+      streamStats.moments(i, moments_type == Pecos::CENTRAL_MOMENTS,
+			  moment_stats[i]);
+    }
+    compute_moment_confidence_intervals(moment_stats, moment_conf_ints,
+					sample_counts, moments_type);
+    functionMomentsComputed = true;
+    return;
+  }
+
+  RealVectorArray fn_samples(num_obs);
   IntRespMCIter it;
   for (it=samples.begin(), i=0; it!=samples.end(); ++it, ++i)
     fn_samples[i] = it->second.function_values_view();
@@ -1578,7 +1679,7 @@ void NonDSampling::compute_level_mappings(const IntResponseMap& samples)
   // > CDF/CCDF mappings of probability/reliability levels to response levels
   size_t i, j, k, num_obs = samples.size(), num_samp, bin_accumulator;
   const StringArray& resp_labels = iteratedModel.response_labels();
-  std::multiset<Real> sorted_samples; // STL-based array for sorting
+  RealArray sorted_samples; // finite samples in ascending order
   SizetArray bins; Real min, max, sample;
 
   // check if moments are required, and if so, compute them now
@@ -1604,7 +1705,7 @@ void NonDSampling::compute_level_mappings(const IntResponseMap& samples)
   }
 
   if (pdfOutput) extremeValues.resize(numFunctions);
-  IntRespMCIter s_it; std::multiset<Real>::iterator ss_it;
+  IntRespMCIter s_it; RealArray::const_iterator ss_it;
   const ShortArray& final_asv = finalStatistics.active_set_request_vector();
   bool extrapolated_mappings = false,
     central_mom = (finalMomentsType == Pecos::CENTRAL_MOMENTS);
@@ -1624,16 +1725,33 @@ void NonDSampling::compute_level_mappings(const IntResponseMap& samples)
     // Preliminaries: define finite subset, sort (if needed), and bin samples
     // ----------------------------------------------------------------------
     num_samp = 0;
-    if (pl_len || gl_len) { // sort samples array for p/beta* -> z mappings
+    if (streamingStats) {
+      // counts, extremes, and bins were accumulated as evaluations completed
+      num_samp = streamStats.count(i);
+      if (pdfOutput)
+	{ min = streamStats.minimum(i); max = streamStats.maximum(i); }
+      if (rl_len && respLevelTarget != RELIABILITIES)
+	bins = streamStats.bins(i);
+      if ((pl_len || gl_len) && outputLevel >= VERBOSE_OUTPUT &&
+	  !streamStats.sketch(i).exact())
+	Cout << "Quantile sketch for " << resp_labels[i] << ": rank error <= "
+	     << streamStats.rank_error_bound(i) << " of " << num_samp
+	     << " samples (probability error <= "
+	     << (Real)streamStats.rank_error_bound(i) / (Real)num_samp
+	     << ").\n";
+    }
+    else if (pl_len || gl_len) { // sort samples array for p/beta* -> z maps
       sorted_samples.clear();
       for (s_it=samples.begin(); s_it!=samples.end(); ++s_it) {
         sample = s_it->second.function_value(i);
 	if (std::isfinite(sample))
-	  { ++num_samp; sorted_samples.insert(sample); }
+	  sorted_samples.push_back(sample);
       }
+      num_samp = sorted_samples.size();
       // sort in ascending order
+      std::sort(sorted_samples.begin(), sorted_samples.end());
       if (pdfOutput)
-        { min = *sorted_samples.begin(); max = *(--sorted_samples.end()); }
+        { min = sorted_samples.front(); max = sorted_samples.back(); }
       // in case of rl_len mixed with pl_len/gl_len, bin using sorted array.
       if (rl_len && respLevelTarget != RELIABILITIES) {
 	const RealVector& req_rl_i = requestedRespLevels[i];
@@ -1641,7 +1759,7 @@ void NonDSampling::compute_level_mappings(const IntResponseMap& samples)
 	for (j=0; j<rl_len; ++j)
 	  while (ss_it!=sorted_samples.end() && *ss_it <= req_rl_i[j])// p(g<=z)
 	    { ++bins[j]; ++ss_it; }
-	bins[rl_len] += std::distance(ss_it, sorted_samples.end());
+	bins[rl_len] += std::distance(ss_it, sorted_samples.cend());
       }
     }
     else if (rl_len && respLevelTarget != RELIABILITIES) {
@@ -1743,20 +1861,19 @@ void NonDSampling::compute_level_mappings(const IntResponseMap& samples)
       //   --> PDF estimation based only on z->p binning or p->z interpolation
       //       within the sample bounds.
       Real cdf_incr_id = p_cdf * (Real)num_samp, lo_id;
-      ss_it = sorted_samples.begin();
       if (cdf_incr_id < 1.) { // extrapolate left of min sample using 1st slope
 	lo_id = 1.; extrapolated_mappings = true;
 	Cerr << "Warning: extrapolation required for response " << i+1;
 	if (j<pl_len) Cerr <<    " for probability level " << j+1       <<".\n";
 	else Cerr << " for generalized reliability level " << j+1-pl_len<<".\n";
       }
-      else { // linear interpolation between closest neighbors in sequence
+      else // linear interpolation between closest neighbors in sequence
         lo_id = std::floor(cdf_incr_id);
-	std::advance(ss_it, (size_t)lo_id - 1);
-      }
-      Real z, z_lo = *ss_it; ++ss_it;
-      if (ss_it == sorted_samples.end()) z = z_lo;
-      else          z = z_lo + (cdf_incr_id - lo_id) * (*ss_it - z_lo);
+      size_t lo_rank = (size_t)lo_id;
+      Real z, z_lo = order_statistic(i, lo_rank, sorted_samples);
+      if (lo_rank >= num_samp) z = z_lo;
+      else z = z_lo + (cdf_incr_id - lo_id)
+	     * (order_statistic(i, lo_rank+1, sorted_samples) - z_lo);
       if (j<pl_len) computedRespLevels[i][j] = z;
       else          computedRespLevels[i][j+bl_len] = z;
     }
@@ -1830,7 +1947,7 @@ void NonDSampling::print_statistics(std::ostream& s) const
     }
   }
 
-  if (!subIteratorFlag) {
+  if (!subIteratorFlag && !streamingStats) {
     nonDSampCorr.print_correlations(s, iteratedModel.ordered_labels(), iteratedModel.response_labels());
   }
 
@@ -14,6 +14,7 @@
 #include "DakotaNonD.hpp"
 #include "LHSDriver.hpp"
 #include "SensAnalysisGlobal.hpp"
+#include "StreamingStatistics.hpp"
 
 namespace Dakota {
 
@@ -259,6 +260,11 @@ protected:
 
   /// Override default update of continuous vars only
   void update_model_from_sample(Model& model, const Real* sample_vars);
+  /// samples in an active view with only continuous variables map
+  /// directly to the active continuous variables
+  bool samples_active_continuous(const Model& model) const;
+  /// update streamStats from a completed evaluation
+  void accumulate_response(int eval_id, const Response& resp);
   /// override default mapping of continuous variables only
   void sample_to_variables(const Real* sample_vars, Variables& vars);
   /// override default mapping of continuous variables only
@@ -295,6 +301,10 @@ protected:
   void mode_bits(const Variables& vars, BitArray& active_vars,
 		 BitArray& active_corr) const;
 
+  /// size streamStats for the requested level mappings and discard
+  /// statistics from any previous run
+  void initialize_streaming_statistics();
+
   //
   //- Heading: Data members
   //
@@ -347,6 +357,15 @@ protected:
   bool allDataFlag; ///< flags update of allResponses
                     ///< (allVariables or allSamples already defined)
 
+  /// flags single-pass accumulation of statistics in streamStats as
+  /// evaluations complete, in place of computation from allResponses
+  bool streamingStats;
+  /// number of items per level in the quantile sketches of streamStats
+  size_t quantileSketchSize;
+  /// moments, extreme values, bins and quantile sketches accumulated
+  /// when streamingStats is set
+  StreamingStatistics streamStats;
+
   /// the sampling mode: ALEATORY_UNCERTAIN{,_UNIFORM},
   /// EPISTEMIC_UNCERTAIN{,_UNIFORM}, UNCERTAIN{,_UNIFORM},
   /// ACTIVE{,_UNIFORM}, or ALL{,_UNIFORM}.  This is a secondary control
@@ -414,6 +433,11 @@ private:
   void sample_to_drv(const Real* sample_vars, Variables& vars,
 		     size_t& adrv_index, size_t num_adrv, size_t& samp_index);
 
+  /// r-th smallest finite sample of response function fn_index, from
+  /// sorted_samples or from streamStats
+  Real order_statistic(size_t fn_index, size_t r,
+		       const RealArray& sorted_samples) const;
+
   //
   //- Heading: Data
   //
@@ -463,6 +487,15 @@ inline void NonDSampling::compute_intervals(const IntResponseMap& samples)
 { compute_intervals(extremeValues, samples); }
 
 
+inline Real NonDSampling::
+order_statistic(size_t fn_index, size_t r,
+		const RealArray& sorted_samples) const
+{
+  return (streamingStats) ? streamStats.order_statistic(fn_index, r)
+                          : sorted_samples[r-1];
+}
+
+
 inline void NonDSampling::print_intervals(std::ostream& s) const
 { print_intervals(s, "response function", iteratedModel.response_labels()); }
 
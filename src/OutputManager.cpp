@@ -7,6 +7,7 @@
     For more information, see the README file in the top Dakota directory.
     _______________________________________________________________________ */
 
+#include <chrono>
 #include <memory>
 #include <utility>
 #include <boost/algorithm/string/predicate.hpp>
@@ -24,6 +25,11 @@
 #include "ResultsDBAny.hpp"
 #include "EvaluationStore.hpp"
 
+#ifdef HAVE_UNISTD_H
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
 #ifdef DAKOTA_HAVE_HDF5
 #include "HDF5_IO.hpp"
 #include "ResultsDBHDF5.hpp"
@@ -45,9 +51,11 @@ void start_dakota_heartbeat(int);
 
 OutputManager::OutputManager():
   graph2DFlag(false), tabularDataFlag(false), resultsOutputFlag(false), 
+  evalsBufferSize(0), evalsFlushSeconds(10), evalsCompression(0),
   worldRank(0), mpirunFlag(false), 
   coutRedirector(dakota_cout, &std::cout), 
   cerrRedirector(dakota_cerr, &std::cerr),
+  closedRestartRecords(0), closedRestartIOTime(0.),
   tabularFormat(TABULAR_ANNOTATED),
   graphicsCntr(1), tabularCntrLabel("eval_id"),
   tabularInterfLabel("interface"), outputLevel(NORMAL_OUTPUT)
@@ -60,9 +68,11 @@ OutputManager::
 OutputManager(const ProgramOptions& prog_opts, int dakota_world_rank,
 	      bool dakota_mpirun_flag):
   graph2DFlag(false), tabularDataFlag(false), resultsOutputFlag(false),
+  evalsBufferSize(0), evalsFlushSeconds(10), evalsCompression(0),
   worldRank(dakota_world_rank), mpirunFlag(dakota_mpirun_flag), 
   coutRedirector(dakota_cout, &std::cout), 
   cerrRedirector(dakota_cerr, &std::cerr),
+  closedRestartRecords(0), closedRestartIOTime(0.),
   graphicsCntr(1), tabularCntrLabel("eval_id"),
   tabularInterfLabel("interface"), outputLevel(NORMAL_OUTPUT)
 {
@@ -219,7 +229,9 @@ void OutputManager::close_streams()
 {
   // cout/cerr will be restored to default when the redirector is destroyed
 
-  // any remaining restart files will be closed at the destructor...
+  // any remaining restart files will be closed at the destructor, but
+  // commit queued records now in case of abort
+  flush_restart();
   //restartDestinations.clear();
 
   // After completion of timings in ParallelLibrary... 
@@ -254,6 +266,11 @@ void OutputManager::parse(const ProgramOptions& prog_opts,
   resultsOutputFile = problem_db.get_string("environment.results_output_file");
   modelEvalsSelection = problem_db.get_ushort("environment.model_evals_selection");
   interfEvalsSelection = problem_db.get_ushort("environment.interface_evals_selection");
+  evalsBufferSize = problem_db.get_int("environment.results_output_buffer_size");
+  evalsFlushSeconds
+    = problem_db.get_int("environment.results_output_flush_seconds");
+  evalsCompression
+    = problem_db.get_int("environment.results_output_compression");
   tabularFormat = problem_db.get_ushort("environment.tabular_format");
   resultsOutputFormat = problem_db.get_ushort("environment.results_output_format");
   if(resultsOutputFlag && resultsOutputFormat == 0)
@@ -312,7 +329,11 @@ push_output_tag(const String& iterator_tag, const ProgramOptions& prog_opts,
   read_write_restart(force_rst_redirect, read_restart_flag, 
 		     prog_opts.read_restart_file() + file_tag,
 		     prog_opts.stop_restart_evals(),
-		     prog_opts.write_restart_file() + file_tag);
+		     prog_opts.write_restart_file() + file_tag,
+		     prog_opts.write_restart_indexed(),
+		     prog_opts.write_restart_commit(),
+		     prog_opts.write_restart_interval(),
+		     prog_opts.write_restart_fsync());
 }
 
 
@@ -345,8 +366,15 @@ void OutputManager::pop_output_tag()
   if (restartDestinations.empty())
     Cout << "\nWarning: Attempt to pop non-existent restart destination!"
 	 << std::endl;
-  else
+  else {
+    std::shared_ptr<RestartWriter>& rst_writer = restartDestinations.back();
+    if (rst_writer.use_count() == 1) {
+      rst_writer->close();
+      closedRestartRecords += rst_writer->records_written();
+      closedRestartIOTime  += rst_writer->io_time();
+    }
     restartDestinations.pop_back();
+  }
 }
 
 
@@ -406,8 +434,52 @@ void OutputManager::append_restart(const ParamResponsePair& prp)
   }
   std::shared_ptr<RestartWriter> rst_writer = restartDestinations.back();
   rst_writer->append_prp(prp);
-  // flush is critical so we have a complete restart record should Dakota abort
-  rst_writer->flush();
+  // flush is critical so we have a complete restart record should Dakota
+  // abort; other policies commit queued records in the background
+  if (rst_writer->commit_policy() == RESTART_COMMIT_EVERY_EVAL)
+    rst_writer->flush();
+}
+
+
+void OutputManager::checkpoint_restart()
+{
+  if (!restartDestinations.empty())
+    restartDestinations.back()->checkpoint();
+}
+
+
+void OutputManager::flush_restart()
+{
+  // destinations may be shared among levels; flushing again is harmless
+  for (size_t i=0; i<restartDestinations.size(); ++i)
+    restartDestinations[i]->flush();
+}
+
+
+void OutputManager::abort_restart()
+{
+  for (size_t i=0; i<restartDestinations.size(); ++i)
+    restartDestinations[i]->abort();
+}
+
+
+size_t OutputManager::restart_records() const
+{
+  size_t num_records = closedRestartRecords;
+  for (size_t i=0; i<restartDestinations.size(); ++i)
+    if (i == 0 || restartDestinations[i] != restartDestinations[i-1])
+      num_records += restartDestinations[i]->records_written();
+  return num_records;
+}
+
+
+Real OutputManager::restart_io_time() const
+{
+  Real io_time = closedRestartIOTime;
+  for (size_t i=0; i<restartDestinations.size(); ++i)
+    if (i == 0 || restartDestinations[i] != restartDestinations[i-1])
+      io_time += restartDestinations[i]->io_time();
+  return io_time;
 }
 
 
@@ -652,6 +724,8 @@ void OutputManager::init_results_db()
     evaluation_store_db.set_database(hdf5_helper_ptr);
     evaluation_store_db.model_selection(modelEvalsSelection);
     evaluation_store_db.interface_selection(interfEvalsSelection);
+    evaluation_store_db.buffer_policy(evalsBufferSize, evalsFlushSeconds,
+                                      evalsCompression);
   #else
     Cerr << "WARNING: HDF5 results output was requested, but is not available in this build.\n";
   #endif
@@ -688,7 +762,11 @@ void OutputManager::read_write_restart(bool restart_requested,
 				       bool read_restart_flag,
 				       const String& read_restart_filename,
 				       size_t stop_restart_evals,
-				       const String& write_restart_filename)
+				       const String& write_restart_filename,
+				       bool write_restart_indexed,
+				       unsigned short write_restart_commit,
+				       int write_restart_interval,
+				       bool write_restart_fsync)
 {
   // If no restart requested, push back a level that doesn't open
   // files so we can later pop it
@@ -719,71 +797,80 @@ void OutputManager::read_write_restart(bool restart_requested,
       RestartVersion rst_ver =
 	RestartVersion::check_restart_version(read_restart_filename);
 
-      std::ifstream restart_input_fs(read_restart_filename.c_str(),
-				     std::ios::binary);
-      if (!restart_input_fs.good()) {
-	Cerr << "\nError: could not open restart file '"
-	     << read_restart_filename << "' for reading."<< std::endl;
-	abort_handler(IO_ERROR);
+      if (rst_ver.indexed_format()) {
+	PRPArray rst_prps;
+	read_indexed_restart(read_restart_filename, stop_restart_evals,
+			     rst_prps);
+	for (size_t i=0; i<rst_prps.size(); ++i)
+	  read_pairs.insert(rst_prps[i]);
       }
-      boost::archive::binary_iarchive restart_input_archive(restart_input_fs);
-
-      Cout << "Reading restart file '" << read_restart_filename << "'.\n"
-	   << "  Any unexpected errors may indicate a corrupt restart file; "
-	   << "using -stop_restart\n  to truncate the read may help."
-	   << std::endl;
-
-      // re-read the full, correct version info from the new stream
-      if (RestartVersion::restartFirstVersionNumber <= rst_ver.restartVersion)
-	restart_input_archive & rst_ver;
-
-      // The -stop_restart input for restricting the number of
-      // evaluations read in from the restart file is very useful when
-      // the last few evaluations in a run were corrupted.  Note that
-      // the desired -stop_restart setting may differ from the
-      // evaluation number in the previous run since detected
-      // duplicates are included in Interface::evalIdCntr, but are not
-      // written to the restart file!
-      if (stop_restart_evals)// cmd_line_handler rtns 0 if no setting
-	Cout << "Stopping restart file processing at "
-	     << stop_restart_evals << " evaluations." << std::endl;
-
-      int cntr = 0;
-      restart_input_fs.peek(); // peek to force EOF if the last record was read
-      while ( restart_input_fs.good() && !restart_input_fs.eof() &&
-	      (!stop_restart_evals ||
-	       cntr < stop_restart_evals) ) {
-	// Use default ctor; relies on Variables and Response reads to size them
-	ParamResponsePair current_pair;
-	try {
-	  // this reads vars (svd, vars), iface, resp, eval_id
-	  // Would like to catch bad reads before bad allocs / segfaults...
-	  restart_input_archive & current_pair;
-	}
-	// TODO: should it be the default to truncate and warn when bad?!?
-	catch(const boost::archive::archive_exception& e) {
-	  Cerr << "\nError reading restart file '" << read_restart_filename
-	       << "'.\nYou may be able to recover the first " << cntr
-	       << " evaluations with -stop_restart " << cntr
-	       << ".\nDetails (boost::archive exception): "
-	       << e.what() << std::endl;
+      else {
+	std::ifstream restart_input_fs(read_restart_filename.c_str(),
+				       std::ios::binary);
+	if (!restart_input_fs.good()) {
+	  Cerr << "\nError: could not open restart file '"
+	       << read_restart_filename << "' for reading."<< std::endl;
 	  abort_handler(IO_ERROR);
 	}
-
-	read_pairs.insert(current_pair);
-	++cntr;
-	Cout << "\n------------------------------------------\nRestart record "
-	     << std::setw(4) << cntr << "  (evaluation id " << std::setw(4)
-	     << current_pair.eval_id() << "):"
-	     << "\n------------------------------------------\n"
-	     << current_pair;
-	// Note: interface id printed in ParamResponsePair::write(ostream&)
-
-	restart_input_fs.peek(); // peek to force EOF if last record was read
+	boost::archive::binary_iarchive restart_input_archive(restart_input_fs);
+
+	Cout << "Reading restart file '" << read_restart_filename << "'.\n"
+	     << "  Any unexpected errors may indicate a corrupt restart file; "
+	     << "using -stop_restart\n  to truncate the read may help."
+	     << std::endl;
+
+	// re-read the full, correct version info from the new stream
+	if (RestartVersion::restartFirstVersionNumber <= rst_ver.restartVersion)
+	  restart_input_archive & rst_ver;
+
+	// The -stop_restart input for restricting the number of
+	// evaluations read in from the restart file is very useful when
+	// the last few evaluations in a run were corrupted.  Note that
+	// the desired -stop_restart setting may differ from the
+	// evaluation number in the previous run since detected
+	// duplicates are included in Interface::evalIdCntr, but are not
+	// written to the restart file!
+	if (stop_restart_evals)// cmd_line_handler rtns 0 if no setting
+	  Cout << "Stopping restart file processing at "
+	       << stop_restart_evals << " evaluations." << std::endl;
+
+	int cntr = 0;
+	restart_input_fs.peek(); // peek to force EOF if the last record was read
+	while ( restart_input_fs.good() && !restart_input_fs.eof() &&
+		(!stop_restart_evals ||
+		 cntr < stop_restart_evals) ) {
+	  // Use default ctor; relies on Variables and Response reads to size them
+	  ParamResponsePair current_pair;
+	  try {
+	    // this reads vars (svd, vars), iface, resp, eval_id
+	    // Would like to catch bad reads before bad allocs / segfaults...
+	    restart_input_archive & current_pair;
+	  }
+	  // TODO: should it be the default to truncate and warn when bad?!?
+	  catch(const boost::archive::archive_exception& e) {
+	    Cerr << "\nError reading restart file '" << read_restart_filename
+		 << "'.\nYou may be able to recover the first " << cntr
+		 << " evaluations with -stop_restart " << cntr
+		 << ".\nDetails (boost::archive exception): "
+		 << e.what() << std::endl;
+	    abort_handler(IO_ERROR);
+	  }
+
+	  read_pairs.insert(current_pair);
+	  ++cntr;
+	  Cout << "\n------------------------------------------\nRestart record "
+	       << std::setw(4) << cntr << "  (evaluation id " << std::setw(4)
+	       << current_pair.eval_id() << "):"
+	       << "\n------------------------------------------\n"
+	       << current_pair;
+	  // Note: interface id printed in ParamResponsePair::write(ostream&)
+
+	  restart_input_fs.peek(); // peek to force EOF if last record was read
+	}
+	restart_input_fs.close();
+	Cout << "Restart file processing completed: " << cntr
+	     << " evaluations retrieved.\n";
       }
-      restart_input_fs.close();
-      Cout << "Restart file processing completed: " << cntr
-	   << " evaluations retrieved.\n";
     }
     catch (const boost::archive::archive_exception& e) {
       // primarily to catch invalid_signature error or an immediately bum stream
@@ -829,8 +916,14 @@ void OutputManager::read_write_restart(bool restart_requested,
   try {
 
     // create a new restart destination
-    std::shared_ptr<RestartWriter>
-      rst_writer(new RestartWriter(write_restart_filename));
+    std::shared_ptr<RestartWriter> rst_writer;
+    if (write_restart_indexed)
+      rst_writer.reset(new RestartWriter(write_restart_filename,
+	RestartVersion(DakotaBuildInfo::get_release_num(),
+		       DakotaBuildInfo::get_rev_number(),
+		       RestartVersion::indexedRestartVersionDelta)));
+    else
+      rst_writer.reset(new RestartWriter(write_restart_filename));
     restartDestinations.push_back(rst_writer);
 
     // Write any processed records from the old restart file to the new file.
@@ -869,6 +962,9 @@ void OutputManager::read_write_restart(bool restart_requested,
       rst_writer->flush();
     }
 
+    // the policy applies to records of this execution
+    rst_writer->commit_policy(write_restart_commit, write_restart_interval,
+			      write_restart_fsync);
   }
   catch (const boost::archive::archive_exception& e) {
     if (outputLevel > SILENT_OUTPUT)
@@ -882,6 +978,45 @@ void OutputManager::read_write_restart(bool restart_requested,
 }
 
 
+/** Records are located through the trailing index of the file and
+    deserialized concurrently, then inserted in file order. */
+void OutputManager::read_indexed_restart(const String& read_restart_filename,
+					 size_t stop_restart_evals,
+					 PRPArray& rst_prps)
+{
+  Cout << "Reading indexed restart file '" << read_restart_filename << "'."
+       << std::endl;
+
+  IndexedRestartReader rst_reader(read_restart_filename);
+  size_t num_recs = rst_reader.num_records();
+  if (stop_restart_evals && stop_restart_evals < num_recs) {
+    Cout << "Stopping restart file processing at " << stop_restart_evals
+	 << " evaluations." << std::endl;
+    num_recs = stop_restart_evals;
+  }
+
+  try {
+    rst_reader.read_records(num_recs, rst_prps);
+  }
+  catch (const boost::archive::archive_exception& e) {
+    Cerr << "\nError reading restart file '" << read_restart_filename
+	 << "'.\nDetails (boost::archive exception): " << e.what() << std::endl;
+    abort_handler(IO_ERROR);
+  }
+
+  for (size_t i=0; i<num_recs; ++i) {
+    const ParamResponsePair& current_pair = rst_prps[i];
+    Cout << "\n------------------------------------------\nRestart record "
+	 << std::setw(4) << i+1 << "  (evaluation id " << std::setw(4)
+	 << current_pair.eval_id() << "):"
+	 << "\n------------------------------------------\n"
+	 << current_pair;
+  }
+  Cout << "Restart file processing completed: " << num_recs
+       << " evaluations retrieved.\n";
+}
+
+
 OutputWriter::OutputWriter(std::ostream* output_stream)
 { outputStream = output_stream; }
 
@@ -1004,14 +1139,22 @@ void ConsoleRedirector::pop_back()
 }
 
 
-RestartWriter::RestartWriter()
+RestartWriter::RestartWriter():
+  indexedFormat(false), dataOffset(0), commitPolicy(RESTART_COMMIT_EVERY_EVAL),
+  commitInterval(0), fsyncFlag(false), fsyncDescriptor(-1), flushRequests(0),
+  flushesCompleted(0), stopWriter(false), abortWriter(false),
+  streamOwner(STREAM_FREE), numRecords(0), ioTime(0.)
 {  /* empty ctor */  }
 
 
 RestartWriter::RestartWriter(const String& write_restart_filename,
 			     bool write_version):
   restartOutputFilename(write_restart_filename),
-  restartOutputFS(restartOutputFilename.c_str(), std::ios::binary)
+  restartOutputFS(restartOutputFilename.c_str(), std::ios::binary),
+  indexedFormat(false), dataOffset(0), commitPolicy(RESTART_COMMIT_EVERY_EVAL),
+  commitInterval(0), fsyncFlag(false), fsyncDescriptor(-1), flushRequests(0),
+  flushesCompleted(0), stopWriter(false), abortWriter(false),
+  streamOwner(STREAM_FREE), numRecords(0), ioTime(0.)
 {
   if (!restartOutputFS.good()) {
     Cerr << "\nError: could not open restart file '"
@@ -1019,20 +1162,22 @@ RestartWriter::RestartWriter(const String& write_restart_filename,
     abort_handler(IO_ERROR);
   }
 
-  restartOutputArchive.reset(new boost::archive::binary_oarchive(restartOutputFS));
-
-  if (write_version) {
-    RestartVersion rst_version(DakotaBuildInfo::get_release_num(),
-			       DakotaBuildInfo::get_rev_number());
-    restartOutputArchive->operator&(rst_version);
-  }
+  if (write_version)
+    init_archive(RestartVersion(DakotaBuildInfo::get_release_num(),
+				DakotaBuildInfo::get_rev_number()));
+  else
+    restartOutputArchive.reset(new boost::archive::binary_oarchive(restartOutputFS));
 }
 
 
 RestartWriter::RestartWriter(const String& write_restart_filename,
 			     const RestartVersion& rst_version):
   restartOutputFilename(write_restart_filename),
-  restartOutputFS(restartOutputFilename.c_str(), std::ios::binary)
+  restartOutputFS(restartOutputFilename.c_str(), std::ios::binary),
+  indexedFormat(false), dataOffset(0), commitPolicy(RESTART_COMMIT_EVERY_EVAL),
+  commitInterval(0), fsyncFlag(false), fsyncDescriptor(-1), flushRequests(0),
+  flushesCompleted(0), stopWriter(false), abortWriter(false),
+  streamOwner(STREAM_FREE), numRecords(0), ioTime(0.)
 {
   if (!restartOutputFS.good()) {
     Cerr << "\nError: could not open restart file '"
@@ -1040,14 +1185,16 @@ RestartWriter::RestartWriter(const String& write_restart_filename,
     abort_handler(IO_ERROR);
   }
 
-  restartOutputArchive.reset(new boost::archive::binary_oarchive(restartOutputFS));
-
-  restartOutputArchive->operator&(rst_version);
+  init_archive(rst_version);
 }
 
 
 RestartWriter::RestartWriter(std::ostream& write_restart_ostream):
-  restartOutputArchive(new boost::archive::binary_oarchive(write_restart_ostream))
+  restartOutputArchive(new boost::archive::binary_oarchive(write_restart_ostream)),
+  indexedFormat(false), dataOffset(0), commitPolicy(RESTART_COMMIT_EVERY_EVAL),
+  commitInterval(0), fsyncFlag(false), fsyncDescriptor(-1), flushRequests(0),
+  flushesCompleted(0), stopWriter(false), abortWriter(false),
+  streamOwner(STREAM_FREE), numRecords(0), ioTime(0.)
 {
   RestartVersion rst_version(DakotaBuildInfo::get_release_num(),
 			     DakotaBuildInfo::get_rev_number());
@@ -1055,13 +1202,62 @@ RestartWriter::RestartWriter(std::ostream& write_restart_ostream):
 }
 
 
+RestartWriter::~RestartWriter()
+{ close(); }
+
+
+void RestartWriter::init_archive(const RestartVersion& rst_version)
+{
+  restartOutputArchive.reset(new boost::archive::binary_oarchive(restartOutputFS));
+  restartOutputArchive->operator&(rst_version);
+
+  // indexed records bypass the archive, each being serialized independently
+  // following the version header
+  indexedFormat = rst_version.indexed_format();
+  if (indexedFormat) {
+    restartOutputFS.flush();
+    dataOffset = static_cast<UInt64>(restartOutputFS.tellp());
+  }
+}
+
+
 const String& RestartWriter::filename()
 { return restartOutputFilename; }
 
 
 void RestartWriter::append_prp(const ParamResponsePair& prp_in)
+{
+  if (abortWriter)
+    return;
+  if (writerThread.joinable()) {
+    // deep copy outside the lock, as the caller may subsequently update
+    // the shared variables/response representations
+    ParamResponsePair prp_copy(prp_in.variables(), prp_in.interface_id(),
+			       prp_in.response(), prp_in.eval_id());
+    std::unique_lock<std::mutex> lock(queueMutex);
+    queueDrained.wait(lock, [this]() {
+      return recordQueue.size() < queueCapacity; });
+    recordQueue.push_back(prp_copy);
+    lock.unlock();
+    queueChanged.notify_one();
+    return;
+  }
+
+  std::chrono::steady_clock::time_point start
+    = std::chrono::steady_clock::now();
+  write_prp(prp_in);
+  ioTime += std::chrono::duration<Real>(std::chrono::steady_clock::now()
+					- start).count();
+  ++numRecords;
+}
+
+
+void RestartWriter::write_prp(const ParamResponsePair& prp_in)
 { 
-  if (restartOutputArchive)  // equivalent to NULL check
+  if (indexedFormat)
+    restartIndex.push_back(IndexedRestart::write_record(restartOutputFS,
+							prp_in));
+  else if (restartOutputArchive)  // equivalent to NULL check
     restartOutputArchive->operator&(prp_in);
   else {
     Cerr << "\nError: attempt to write to invalid restart file." << std::endl;
@@ -1069,8 +1265,206 @@ void RestartWriter::append_prp(const ParamResponsePair& prp_in)
   }
 }
 
+
 void RestartWriter::flush()
-{ restartOutputFS.flush(); }
+{
+  // after abort() the writer may have exited: never wait on it
+  if (abortWriter)
+    return;
+  if (writerThread.joinable()) {
+    if (on_writer_thread()) // abort during a write: commit what is written
+      commit();
+    else {
+      std::unique_lock<std::mutex> lock(queueMutex);
+      size_t request = ++flushRequests;
+      queueChanged.notify_one();
+      queueDrained.wait(lock, [this, request]() {
+	return flushesCompleted >= request; });
+    }
+    return;
+  }
+
+  std::chrono::steady_clock::time_point start
+    = std::chrono::steady_clock::now();
+  commit();
+  ioTime += std::chrono::duration<Real>(std::chrono::steady_clock::now()
+					- start).count();
+}
+
+
+void RestartWriter::commit()
+{
+  restartOutputFS.flush();
+#ifdef HAVE_UNISTD_H
+  if (fsyncDescriptor >= 0)
+    fsync(fsyncDescriptor);
+#endif
+}
+
+
+void RestartWriter::
+commit_policy(unsigned short policy, int interval, bool fsync_flag)
+{
+  // a background writer cannot change policy
+  if (writerThread.joinable()) {
+    Cerr << "\nError: restart commit policy may only be set once."
+	 << std::endl;
+    abort_handler(-1);
+  }
+  commitPolicy = policy;
+  commitInterval = interval;
+  fsyncFlag = fsync_flag;
+#ifdef HAVE_UNISTD_H
+  // any descriptor for the file synchronizes its data; std::ofstream does
+  // not expose its own, so open one for the lifetime of the file
+  if (fsyncFlag && fsyncDescriptor < 0 && restartOutputFS.is_open()) {
+    fsyncDescriptor = ::open(restartOutputFilename.c_str(), O_WRONLY);
+    if (fsyncDescriptor < 0)
+      Cerr << "\nWarning: could not open restart file '"
+	   << restartOutputFilename << "' for fsync." << std::endl;
+  }
+#endif
+  if (commitPolicy != RESTART_COMMIT_EVERY_EVAL && restartOutputFS.is_open())
+    writerThread = std::thread(&RestartWriter::writer_loop, this);
+}
+
+
+void RestartWriter::checkpoint()
+{
+  if (commitPolicy == RESTART_COMMIT_CHECKPOINT)
+    flush();
+}
+
+
+void RestartWriter::close()
+{
+  if (writerThread.joinable()) {
+    // an abort on the writer thread relies on its own flush
+    if (on_writer_thread())
+      return;
+    {
+      std::lock_guard<std::mutex> lock(queueMutex);
+      stopWriter = true;
+    }
+    queueChanged.notify_one();
+    writerThread.join();
+  }
+
+  if (!restartOutputFS.is_open())
+    return;
+  // without the index (e.g., on abort), readers recover by scanning records
+  if (indexedFormat)
+    IndexedRestart::write_index(restartOutputFS, restartIndex, dataOffset);
+  restartOutputArchive.reset();
+  commit();
+  restartOutputFS.close();
+#ifdef HAVE_UNISTD_H
+  if (fsyncDescriptor >= 0)
+    { ::close(fsyncDescriptor); fsyncDescriptor = -1; }
+#endif
+}
+
+
+void RestartWriter::abort()
+{
+  // neither lock queueMutex nor wait: the interrupted code may hold it
+  if (abortWriter.exchange(true))
+    return;
+  if (!writerThread.joinable() || on_writer_thread())
+    { commit(); return; }
+  // commit here if the writer is idle; otherwise it commits on seeing
+  // abortWriter and gives up the stream for good
+  int no_owner = STREAM_FREE;
+  if (streamOwner.compare_exchange_strong(no_owner, STREAM_ABORT))
+    commit();
+}
+
+
+bool RestartWriter::on_writer_thread() const
+{ return std::this_thread::get_id() == writerThread.get_id(); }
+
+
+/** Records are written as they arrive; the file is committed per
+    commitPolicy, upon request (flush()), and before exiting. */
+void RestartWriter::writer_loop()
+{
+  typedef std::chrono::steady_clock clock;
+  clock::time_point last_commit = clock::now();
+  std::chrono::seconds commit_seconds(commitInterval);
+  size_t uncommitted = 0;
+  std::deque<ParamResponsePair> batch;
+
+  std::unique_lock<std::mutex> lock(queueMutex);
+  for (;;) {
+    auto ready = [this]() { return !recordQueue.empty() || stopWriter ||
+			    flushRequests > flushesCompleted; };
+    if (commitPolicy == RESTART_COMMIT_SECONDS && uncommitted)
+      queueChanged.wait_until(lock, last_commit + commit_seconds, ready);
+    else
+      queueChanged.wait(lock, ready);
+
+    // group all pending records into one write
+    batch.swap(recordQueue);
+    size_t flush_request = flushRequests;
+    bool stop = stopWriter;
+    lock.unlock();
+    queueDrained.notify_all();
+
+    // abort() has claimed the stream and committed it
+    int no_owner = STREAM_FREE;
+    if (!streamOwner.compare_exchange_strong(no_owner, STREAM_WRITER))
+      return;
+    clock::time_point start = clock::now();
+    size_t num_written = 0;
+    for (std::deque<ParamResponsePair>::const_iterator it = batch.begin();
+	 it != batch.end() && !abortWriter; ++it, ++num_written)
+      write_prp(*it);
+    uncommitted += num_written;
+    batch.clear();
+
+    clock::time_point now = clock::now();
+    bool commit_now = abortWriter || stop ||
+      flush_request > flushesCompleted ||
+      (commitPolicy == RESTART_COMMIT_EVALS &&
+       uncommitted >= (size_t)commitInterval) ||
+      (commitPolicy == RESTART_COMMIT_SECONDS &&
+       now - last_commit >= commit_seconds);
+    if (commit_now) {
+      if (uncommitted)
+	commit();
+      uncommitted = 0;
+      last_commit = clock::now();
+    }
+    if (abortWriter)
+      return; // keep the stream claimed
+    streamOwner = STREAM_FREE;
+    Real elapsed = std::chrono::duration<Real>(clock::now() - start).count();
+
+    lock.lock();
+    numRecords += num_written;
+    ioTime += elapsed;
+    if (commit_now) {
+      flushesCompleted = flush_request;
+      queueDrained.notify_all();
+    }
+    if (stop && recordQueue.empty())
+      break;
+  }
+}
+
+
+size_t RestartWriter::records_written() const
+{
+  std::lock_guard<std::mutex> lock(queueMutex);
+  return numRecords;
+}
+
+
+Real RestartWriter::io_time() const
+{
+  std::lock_guard<std::mutex> lock(queueMutex);
+  return ioTime;
+}
 
 
 #ifdef Want_Heartbeat /*{*/
@@ -17,7 +17,13 @@
 #include "dakota_tabular_io.hpp"
 #include "DakotaGraphics.hpp"
 #include "RestartVersion.hpp"
+#include "IndexedRestart.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
 #include <memory>
+#include <mutex>
+#include <thread>
 
 
 namespace Dakota {
@@ -114,7 +120,11 @@ private:
 
 
 /** Component for writing restart files.  Creation and destruction of
-    archive and associated stream are managed here. */
+    archive and associated stream are managed here.  By default each
+    record is written synchronously; other commit policies hand
+    records to a background thread through a bounded queue, which
+    writes them in groups and commits (flushes) the file per the
+    policy. */
 class RestartWriter {
 
 public:
@@ -125,14 +135,18 @@ public:
   RestartWriter(const String& write_restart_filename,
 		bool write_version = true);
 
-  /// alternate ctor taking non-default version info, helpful for testing
+  /// alternate ctor taking non-default version info; the version
+  /// selects the sequential or indexed restart format
   RestartWriter(const String& write_restart_filename,
 		const RestartVersion& rst_version);
 
   /// alternate ctor taking a stream, helpful for testing; assumes
   /// client manages the output stream
   RestartWriter(std::ostream& write_restart_stream);
-  
+
+  /// destructor; writes any queued records and completes the file (close())
+  ~RestartWriter();
+
   /// output filename for this writer
   const String& filename();
 
@@ -145,10 +159,54 @@ public:
   void append_prp(const ParamResponsePair& prp_in);
 
   /// flush the restart stream so we have a complete restart record
-  /// should Dakota abort
+  /// should Dakota abort; waits for any queued records to be committed
   void flush();
 
+  /// select when records are committed (RESTART_COMMIT_*), with the
+  /// evaluations or seconds between commits and whether a commit
+  /// synchronizes the file to disk; policies other than
+  /// RESTART_COMMIT_EVERY_EVAL start the background writer
+  void commit_policy(unsigned short policy, int interval = 0,
+		     bool fsync_flag = false);
+  /// the policy for committing records
+  unsigned short commit_policy() const;
+
+  /// commit written records at a checkpoint if the policy is
+  /// RESTART_COMMIT_CHECKPOINT
+  void checkpoint();
+
+  /// write any queued records, stop the background writer, complete
+  /// an indexed restart file by writing its index, and close the file
+  void close();
+
+  /// stop writing on abort without blocking, as from a signal handler
+  /// that may have interrupted append_prp() or flush(): commit the
+  /// written records unless the background writer holds the stream, in
+  /// which case it commits them and exits; later records are discarded
+  void abort();
+
+  /// whether records are written in the indexed restart format
+  bool indexed_format() const;
+
+  /// number of records written
+  size_t records_written() const;
+  /// cumulative seconds spent writing and committing records
+  Real io_time() const;
+
 private:
+
+  /// initialize the output archive and write the version header
+  void init_archive(const RestartVersion& rst_version);
+
+  /// serialize prp_in to the file
+  void write_prp(const ParamResponsePair& prp_in);
+  /// flush the stream and optionally synchronize the file to disk
+  void commit();
+  /// body of the background writer thread
+  void writer_loop();
+  /// whether called from the background writer thread
+  bool on_writer_thread() const;
+
   /// copy constructor is disallowed due to file stream
   RestartWriter(const RestartWriter&);
   /// assignment is disallowed due to file stream
@@ -164,9 +222,66 @@ private:
   /// default ctor for oarchive and may not be initialized); 
   std::unique_ptr<boost::archive::binary_oarchive> restartOutputArchive;
 
+  /// whether records are written in the indexed format (see IndexedRestart)
+  bool indexedFormat;
+  /// file offset of the first record in the indexed format
+  UInt64 dataOffset;
+  /// index entries of the records written in the indexed format
+  std::vector<RestartIndexEntry> restartIndex;
+
+  /// maximum number of records queued for the background writer
+  static const size_t queueCapacity = 1024;
+
+  /// when records are committed (RESTART_COMMIT_*)
+  unsigned short commitPolicy;
+  /// evaluations or seconds between commits, per commitPolicy
+  int commitInterval;
+  /// whether a commit synchronizes the file to disk (fsync)
+  bool fsyncFlag;
+  /// descriptor held open for fsync while fsyncFlag is set (-1 if none)
+  int fsyncDescriptor;
+
+  /// background writer for policies other than RESTART_COMMIT_EVERY_EVAL
+  std::thread writerThread;
+  /// protects the queue, the flush counters, and the statistics
+  mutable std::mutex queueMutex;
+  /// signals the writer of new records or requests
+  std::condition_variable queueChanged;
+  /// signals producers of free queue capacity or completed commits
+  std::condition_variable queueDrained;
+  /// deep copies of records awaiting the writer
+  std::deque<ParamResponsePair> recordQueue;
+  /// number of commits requested by flush() / checkpoint()
+  size_t flushRequests;
+  /// number of requested commits completed by the writer
+  size_t flushesCompleted;
+  /// requests the writer to drain the queue and exit
+  bool stopWriter;
+
+  /// the thread permitted to use restartOutputFS while the background
+  /// writer is active; claimed by compare-and-swap so abort() never waits
+  enum { STREAM_FREE = 0, STREAM_WRITER, STREAM_ABORT };
+  /// requests the writer to stop at once, set by abort()
+  std::atomic<bool> abortWriter;
+  /// current STREAM_* claim on restartOutputFS
+  std::atomic<int> streamOwner;
+
+  /// number of records written
+  size_t numRecords;
+  /// cumulative seconds spent writing and committing records
+  Real ioTime;
+
 };  // class RestartWriter
 
 
+inline bool RestartWriter::indexed_format() const
+{ return indexedFormat; }
+
+
+inline unsigned short RestartWriter::commit_policy() const
+{ return commitPolicy; }
+
+
 
 // TODO: tagging for pre/run/post I/O files
 // TODO: consider a map of redirections with arbitrary rebinding
@@ -241,6 +356,21 @@ public:
   /// append a parameter/response set to the restart file
   void append_restart(const ParamResponsePair& prp);
 
+  /// commit the active restart file at a checkpoint (e.g., completion
+  /// of a batch of evaluations), per its commit policy
+  void checkpoint_restart();
+
+  /// commit all queued restart records, e.g., prior to an abort
+  void flush_restart();
+  /// stop all restart writers without blocking, committing what is
+  /// written (abort path, including signal handlers)
+  void abort_restart();
+
+  /// number of restart records written by this process
+  size_t restart_records() const;
+  /// seconds spent writing and committing restart records
+  Real restart_io_time() const;
+
 
   // -----
   // Graphics and tabular output
@@ -364,6 +494,12 @@ public:
   unsigned short modelEvalsSelection;
   /// Interfaces selected to store their evaluations
   unsigned short interfEvalsSelection;
+  /// Evaluations buffered per model/interface before an HDF5 write
+  int evalsBufferSize;
+  /// Maximum seconds buffered evaluations are held
+  int evalsFlushSeconds;
+  /// Deflate level of evaluation datasets
+  int evalsCompression;
 
 private:
 
@@ -375,7 +511,15 @@ private:
   void read_write_restart(bool restart_requested, bool read_restart_flag,
 			  const String& read_restart_filename,
 			  size_t stop_restart_eval,
-			  const String& write_restart_filename);
+			  const String& write_restart_filename,
+			  bool write_restart_indexed,
+			  unsigned short write_restart_commit,
+			  int write_restart_interval, bool write_restart_fsync);
+
+  /// read up to stop_restart_evals records of an indexed restart file
+  /// into rst_prps (in file order)
+  void read_indexed_restart(const String& read_restart_filename,
+			    size_t stop_restart_evals, PRPArray& rst_prps);
 
   // -----
   // Data
@@ -403,6 +547,11 @@ private:
   /// redirection. All remain open until popped or destroyed.
   std::vector<std::shared_ptr<RestartWriter> > restartDestinations;
 
+  /// restart records written by closed restart destinations
+  size_t closedRestartRecords;
+  /// restart I/O seconds of closed restart destinations
+  Real closedRestartIOTime;
+
   /// message to print at startup when proceeding to instantiate objects
   String startupMessage;
 
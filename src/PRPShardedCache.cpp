@@ -0,0 +1,481 @@
+/*  _______________________________________________________________________
+
+    Dakota: Explore and predict with confidence.
+    Copyright 2014-2023
+    National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Dakota directory.
+    _______________________________________________________________________ */
+
+#include "PRPShardedCache.hpp"
+#include "PRPMultiIndex.hpp" // set_compare()
+
+#include <boost/archive/binary_oarchive.hpp>
+#include <boost/archive/binary_iarchive.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <iterator>
+
+
+namespace Dakota {
+
+extern PRPCache data_pairs;
+extern PRPShardedCache sharded_data_pairs;
+
+PRPShardedCache::PRPShardedCache(size_t num_shards):
+  numShards(0), shardShift(64), shardMaxEntries(0), shardMaxBytes(0),
+  hitCount(0), spillHitCount(0), restartHitCount(0), missCount(0),
+  evictionCount(0)
+{ this->num_shards(num_shards); }
+
+
+PRPShardedCache::~PRPShardedCache()
+{
+  // the spill file only backs this run's cache: remove it
+  if (spillStream.is_open()) {
+    spillStream.close();
+    std::remove(spillFile.c_str());
+  }
+}
+
+
+void PRPShardedCache::num_shards(size_t num_shards)
+{
+  if (shardArray && !empty()) {
+    Cerr << "Error: number of shards cannot be changed in a populated "
+	 << "PRPShardedCache." << std::endl;
+    abort_handler(-1);
+  }
+
+  // a fixed default keeps the cache independent of the host: contention
+  // is bounded by the (opt-in) evaluation concurrency, not the core count
+  if (num_shards == 0)
+    num_shards = DEFAULT_SHARDS;
+
+  // round up to a power of two so that shards are indexed by the high bits
+  // of the key (the low bits also select the bucket within a shard)
+  size_t pow2 = 1; unsigned short log2 = 0;
+  while (pow2 < num_shards) { pow2 <<= 1; ++log2; }
+
+  if (pow2 != numShards) {
+    // per-shard budgets are derived from the totals last passed to capacity()
+    size_t max_entries = shardMaxEntries * numShards,
+           max_bytes   = shardMaxBytes   * numShards;
+    numShards  = pow2;
+    shardShift = 64 - log2; // 64 for a single shard (see shard())
+    shardArray.reset(new Shard[numShards]);
+    shardMaxEntries = (max_entries) ? std::max<size_t>(1, max_entries/numShards) : 0;
+    shardMaxBytes   = (max_bytes)   ? std::max<size_t>(1, max_bytes/numShards)   : 0;
+  }
+}
+
+
+void PRPShardedCache::
+capacity(size_t max_entries, size_t max_bytes, const String& spill_file)
+{
+  if (!empty()) {
+    Cerr << "Error: capacity cannot be changed in a populated PRPShardedCache."
+	 << std::endl;
+    abort_handler(-1);
+  }
+
+  // the budget is divided evenly over the shards, such that eviction is a
+  // shard-local decision; keys are well mixed, so shards fill uniformly
+  shardMaxEntries = (max_entries) ? std::max<size_t>(1, max_entries/numShards) : 0;
+  shardMaxBytes   = (max_bytes)   ? std::max<size_t>(1, max_bytes/numShards)   : 0;
+
+  std::lock_guard<std::mutex> lock(spillMutex);
+  if (spillStream.is_open()) {
+    spillStream.close();
+    std::remove(spillFile.c_str());
+  }
+  spillFile = spill_file;
+}
+
+
+UInt64 PRPShardedCache::
+hash_key(const String& interface_id, const Variables& vars)
+{
+  // consistent with hash_value(ParamResponsePair) in PRPMultiIndex.hpp
+  std::size_t seed = 0;
+  boost::hash_combine(seed, interface_id);
+  boost::hash_combine(seed, vars);
+
+  // widen and finalize (splitmix64) so that the high bits used for shard
+  // selection are well mixed, even for 32-bit size_t
+  UInt64 key = static_cast<UInt64>(seed);
+  key ^= key >> 30; key *= 0xbf58476d1ce4e5b9ULL;
+  key ^= key >> 27; key *= 0x94d049bb133111ebULL;
+  key ^= key >> 31;
+  return key;
+}
+
+
+size_t PRPShardedCache::payload_bytes(const ParamResponsePair& prp)
+{
+  // estimate from the dominant arrays; labels and ActiveSets are shared
+  // or small relative to these for the problems where a bound matters
+  const Variables& vars = prp.variables();
+  const Response&  resp = prp.response();
+  size_t bytes = sizeof(ParamResponsePair) + prp.interface_id().size()
+    + (vars.acv() + vars.adrv()) * sizeof(Real) + vars.adiv() * sizeof(int)
+    + vars.adsv() * sizeof(String);
+  const RealMatrix& grads = resp.function_gradients();
+  const RealSymMatrixArray& hessians = resp.function_hessians();
+  bytes += resp.num_functions() * sizeof(Real)
+    + grads.numRows() * grads.numCols() * sizeof(Real);
+  for (size_t i=0; i<hessians.size(); ++i)
+    bytes += hessians[i].numRows() * hessians[i].numRows() * sizeof(Real);
+  return bytes;
+}
+
+
+void PRPShardedCache::insert(const ParamResponsePair& prp)
+{
+  UInt64 key = hash_key(prp.interface_id(), prp.variables());
+  Shard& s = shard(key);
+  std::lock_guard<std::mutex> lock(s.shardMutex);
+  insert(s, key, prp);
+}
+
+
+void PRPShardedCache::
+insert(Shard& s, UInt64 key, const ParamResponsePair& prp)
+{
+  Record rec = { key, prp, payload_bytes(prp) };
+  s.lruList.push_front(rec);
+  s.index.insert(std::make_pair(key, s.lruList.begin()));
+  s.bytes += rec.bytes;
+  enforce_budget(s);
+}
+
+
+void PRPShardedCache::enforce_budget(Shard& s)
+{
+  // always retain the most recent record, even if it alone exceeds the budget
+  while (s.lruList.size() > 1 &&
+	 ( (shardMaxEntries && s.lruList.size() > shardMaxEntries) ||
+	   (shardMaxBytes   && s.bytes          > shardMaxBytes) ) ) {
+    RecordList::iterator victim = std::prev(s.lruList.end());
+    auto range = s.index.equal_range(victim->key);
+    for (auto it = range.first; it != range.second; ++it)
+      if (it->second == victim) { s.index.erase(it); break; }
+    if (!spillFile.empty())
+      spill(victim->key, victim->prp);
+    s.bytes -= victim->bytes;
+    s.lruList.erase(victim);
+    ++evictionCount;
+  }
+}
+
+
+PRPShardedCache::RecordList::iterator PRPShardedCache::
+find_record(Shard& s, UInt64 key, const String& search_interface_id,
+	    const Variables& search_vars, const ActiveSet& search_set)
+{
+  // the key match admits hash collisions: confirm with exact id/vars equality
+  // and apply the ActiveSet subset logic as in lookup_by_val(PRPCache&)
+  auto range = s.index.equal_range(key);
+  for (auto it = range.first; it != range.second; ++it) {
+    RecordList::iterator rec = it->second;
+    const ParamResponsePair& prp = rec->prp;
+    if (prp.interface_id() == search_interface_id &&
+	prp.variables()    == search_vars         &&
+	set_compare(prp, search_set)) {
+      // mark as most recently used; list iterators remain valid
+      s.lruList.splice(s.lruList.begin(), s.lruList, rec);
+      return rec;
+    }
+  }
+  return s.lruList.end();
+}
+
+
+bool PRPShardedCache::
+lookup(const String& search_interface_id, const Variables& search_vars,
+       const ActiveSet& search_set, int new_eval_id,
+       ParamResponsePair& found_pr)
+{
+  UInt64 key = hash_key(search_interface_id, search_vars);
+  Shard& s = shard(key);
+  std::lock_guard<std::mutex> lock(s.shardMutex);
+  RecordList::iterator rec
+    = find_record(s, key, search_interface_id, search_vars, search_set);
+  if (rec != s.lruList.end())
+    ++hitCount;
+  else if (!spillFile.empty() &&
+	   unspill(key, search_interface_id, search_vars, search_set,
+		   found_pr)) {
+    // a spilled hit is made resident again (and may evict another record)
+    ++spillHitCount;
+    insert(s, key, found_pr);
+    rec = s.lruList.begin();
+  }
+  else {
+    ++missCount;
+    return false;
+  }
+
+  // eval id is record data (not a key), so promotion is an in-place update
+  if (new_eval_id && rec->prp.eval_id() <= 0)
+    rec->prp.eval_id(new_eval_id);
+  found_pr = rec->prp;
+  return true;
+}
+
+
+void PRPShardedCache::spill(UInt64 key, const ParamResponsePair& prp)
+{
+  std::lock_guard<std::mutex> lock(spillMutex);
+  if (!spillStream.is_open()) {
+    spillStream.open(spillFile.c_str(), std::ios::in | std::ios::out |
+		     std::ios::trunc | std::ios::binary);
+    if (!spillStream.good()) {
+      Cerr << "Error: could not open evaluation cache spill file '"
+	   << spillFile << "'." << std::endl;
+      abort_handler(IO_ERROR);
+    }
+  }
+
+  // each record is a self-contained archive so that it can be read back
+  // from its offset alone
+  spillStream.seekp(0, std::ios::end);
+  std::streamoff offset = spillStream.tellp();
+  {
+    boost::archive::binary_oarchive
+      spill_archive(spillStream, boost::archive::no_header);
+    spill_archive & prp;
+  }
+  spillIndex.insert(std::make_pair(key, offset));
+}
+
+
+void PRPShardedCache::
+read_spilled(std::streamoff offset, ParamResponsePair& prp) const
+{
+  spillStream.seekg(offset);
+  boost::archive::binary_iarchive
+    spill_archive(spillStream, boost::archive::no_header);
+  spill_archive & prp;
+}
+
+
+bool PRPShardedCache::
+unspill(UInt64 key, const String& search_interface_id,
+	const Variables& search_vars, const ActiveSet& search_set,
+	ParamResponsePair& found_pr)
+{
+  std::lock_guard<std::mutex> lock(spillMutex);
+  auto range = spillIndex.equal_range(key);
+  for (auto it = range.first; it != range.second; ++it) {
+    ParamResponsePair prp;
+    read_spilled(it->second, prp);
+    if (prp.interface_id() == search_interface_id &&
+	prp.variables()    == search_vars         &&
+	set_compare(prp, search_set)) {
+      // the file region is abandoned; the record is resident again
+      spillIndex.erase(it);
+      found_pr = prp;
+      return true;
+    }
+  }
+  return false;
+}
+
+
+void PRPShardedCache::
+lookup_all(const String& search_interface_id, const Variables& search_vars,
+	   PRPArray& found_prps) const
+{
+  UInt64 key = hash_key(search_interface_id, search_vars);
+  Shard& s = shard(key);
+  std::lock_guard<std::mutex> lock(s.shardMutex);
+  auto range = s.index.equal_range(key);
+  for (auto it = range.first; it != range.second; ++it) {
+    const ParamResponsePair& prp = it->second->prp;
+    if (prp.interface_id() == search_interface_id &&
+	prp.variables()    == search_vars)
+      found_prps.push_back(prp);
+  }
+
+  // spilled records are read without being made resident
+  std::lock_guard<std::mutex> spill_lock(spillMutex);
+  auto spill_range = spillIndex.equal_range(key);
+  for (auto it = spill_range.first; it != spill_range.second; ++it) {
+    ParamResponsePair prp;
+    read_spilled(it->second, prp);
+    if (prp.interface_id() == search_interface_id &&
+	prp.variables()    == search_vars)
+      found_prps.push_back(prp);
+  }
+}
+
+
+void PRPShardedCache::records(PRPArray& prps) const
+{
+  for (size_t i=0; i<numShards; ++i) {
+    std::lock_guard<std::mutex> lock(shardArray[i].shardMutex);
+    const RecordList& recs = shardArray[i].lruList;
+    for (RecordList::const_iterator it=recs.begin(); it!=recs.end(); ++it)
+      prps.push_back(it->prp);
+  }
+
+  std::lock_guard<std::mutex> lock(spillMutex);
+  for (auto it=spillIndex.begin(); it!=spillIndex.end(); ++it) {
+    ParamResponsePair prp;
+    read_spilled(it->second, prp);
+    prps.push_back(prp);
+  }
+}
+
+
+size_t PRPShardedCache::size() const
+{
+  size_t count = 0;
+  for (size_t i=0; i<numShards; ++i) {
+    std::lock_guard<std::mutex> lock(shardArray[i].shardMutex);
+    count += shardArray[i].lruList.size();
+  }
+  return count;
+}
+
+
+bool PRPShardedCache::empty() const
+{ return size() == 0 && spilled() == 0; }
+
+
+size_t PRPShardedCache::spilled() const
+{
+  std::lock_guard<std::mutex> lock(spillMutex);
+  return spillIndex.size();
+}
+
+
+void PRPShardedCache::clear()
+{
+  for (size_t i=0; i<numShards; ++i) {
+    std::lock_guard<std::mutex> lock(shardArray[i].shardMutex);
+    shardArray[i].lruList.clear();
+    shardArray[i].index.clear();
+    shardArray[i].bytes = 0;
+  }
+  {
+    std::lock_guard<std::mutex> lock(spillMutex);
+    spillIndex.clear();
+    if (spillStream.is_open()) {
+      spillStream.close();
+      std::remove(spillFile.c_str());
+    }
+  }
+  hitCount = spillHitCount = restartHitCount = missCount = evictionCount = 0;
+}
+
+
+size_t PRPShardedCache::index_bytes() const
+{
+  // list node = two pointers + Record (PRP handle; shared reps not counted);
+  // index node = next pointer + key + list iterator; one pointer per bucket
+  typedef std::pair<const UInt64, RecordList::iterator> value_type;
+  size_t bytes = numShards * sizeof(Shard);
+  for (size_t i=0; i<numShards; ++i) {
+    std::lock_guard<std::mutex> lock(shardArray[i].shardMutex);
+    const Shard& s = shardArray[i];
+    bytes += s.lruList.size() * (2*sizeof(void*) + sizeof(Record))
+      + s.index.size() * (sizeof(void*) + sizeof(value_type))
+      + s.index.bucket_count() * sizeof(void*);
+  }
+  return bytes;
+}
+
+
+size_t PRPShardedCache::resident_bytes() const
+{
+  size_t bytes = 0;
+  for (size_t i=0; i<numShards; ++i) {
+    std::lock_guard<std::mutex> lock(shardArray[i].shardMutex);
+    bytes += shardArray[i].bytes;
+  }
+  return bytes;
+}
+
+
+void PRPShardedCache::print_statistics(std::ostream& s) const
+{
+  size_t num_hits = hitCount, num_spill_hits = spillHitCount,
+    num_restart_hits = restartHitCount,
+    num_lookups = num_hits + num_spill_hits + num_restart_hits + missCount;
+  s << "  Evaluation cache: " << size() << " resident records ("
+    << resident_bytes() + index_bytes() << " bytes), " << spilled()
+    << " spilled records\n                    " << num_lookups
+    << " lookups: " << num_hits << " hits, " << num_spill_hits
+    << " spill hits, " << num_restart_hits << " restart hits, " << missCount
+    << " misses, " << evictionCount << " evictions\n";
+}
+
+
+bool lookup_evaluation(const String& search_interface_id,
+		       const Variables& search_vars,
+		       const ActiveSet& search_set,
+		       ParamResponsePair& found_pr)
+{
+  PRPCacheHIter prp_it
+    = lookup_by_val(data_pairs, search_interface_id, search_vars, search_set);
+  if (prp_it != data_pairs.get<hashed>().end())
+    { found_pr = *prp_it; return true; }
+  if (sharded_data_pairs.empty())
+    return false;
+
+  PRPArray found_prps;
+  sharded_data_pairs.lookup_all(search_interface_id, search_vars, found_prps);
+  for (size_t i=0; i<found_prps.size(); ++i)
+    if (set_compare(found_prps[i], search_set))
+      { found_pr = found_prps[i]; return true; }
+  return false;
+}
+
+
+bool lookup_evaluation(const ParamResponsePair& search_pr,
+		       ParamResponsePair& found_pr)
+{
+  return lookup_evaluation(search_pr.interface_id(), search_pr.variables(),
+			   search_pr.active_set(), found_pr);
+}
+
+
+void lookup_evaluations(const String& search_interface_id,
+			const Variables& search_vars, PRPArray& found_prps)
+{
+  if (!data_pairs.empty()) {
+    // the hashed index compares only the interface id and variables
+    Response search_resp;
+    ParamResponsePair search_pr(search_vars, search_interface_id, search_resp);
+    PRPCacheHIter prp_it0, prp_it1;
+    boost::tuples::tie(prp_it0, prp_it1)
+      = data_pairs.get<hashed>().equal_range(search_pr);
+    for (; prp_it0 != prp_it1; ++prp_it0)
+      found_prps.push_back(*prp_it0);
+  }
+  if (!sharded_data_pairs.empty())
+    sharded_data_pairs.lookup_all(search_interface_id, search_vars, found_prps);
+}
+
+
+void evaluation_records(PRPArray& prps)
+{
+  prps.assign(data_pairs.begin(), data_pairs.end());
+  if (sharded_data_pairs.empty())
+    return;
+
+  // shards have no ordered index: sort their records and merge them with
+  // the (already ordered) data_pairs records
+  size_t num_ordered = prps.size();
+  sharded_data_pairs.records(prps);
+  auto ids_less = [](const ParamResponsePair& a, const ParamResponsePair& b)
+    { return a.eval_interface_ids() < b.eval_interface_ids(); };
+  std::sort(prps.begin() + num_ordered, prps.end(), ids_less);
+  std::inplace_merge(prps.begin(), prps.begin() + num_ordered, prps.end(),
+		     ids_less);
+}
+
+} // namespace Dakota
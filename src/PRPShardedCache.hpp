@@ -0,0 +1,326 @@
+/*  _______________________________________________________________________
+
+    Dakota: Explore and predict with confidence.
+    Copyright 2014-2023
+    National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Dakota directory.
+    _______________________________________________________________________ */
+
+#ifndef PRP_SHARDED_CACHE_H
+#define PRP_SHARDED_CACHE_H
+
+#include "dakota_system_defs.hpp"
+#include "dakota_data_types.hpp"
+#include "ParamResponsePair.hpp"
+
+#include <atomic>
+#include <fstream>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace Dakota {
+
+/// Thread-safe, sharded evaluation cache for ParamResponsePairs
+
+/** PRPShardedCache is an alternative to the boost::multi_index
+    PRPMultiIndexCache for duplicate detection in ApplicationInterface.
+    Each record is keyed by a precomputed 64-bit hash of the interface
+    id and variables, so that a lookup hashes the search key once and
+    compares full Variables only for colliding records.  Records are
+    partitioned over independently locked shards (selected from the
+    high bits of the key), allowing concurrent lookups and insertions
+    from threaded map() invocations to proceed without serializing on
+    a single container.  Stored ParamResponsePairs are shallow copies
+    that share the Variables/Response representations of the record
+    written to restart, such that the cache adds only a key and node
+    overhead per evaluation.
+
+    Unlike PRPMultiIndexCache, there is no ordered index over
+    evaluation ids: evaluation ids are record data rather than keys,
+    which allows restart/import ids to be promoted in place.
+
+    The resident records may be bounded in count and/or (estimated)
+    bytes, in which case the least recently used records of a shard
+    are evicted once its share of the budget is exceeded.  Evicted
+    records are optionally spilled to a file and remain available for
+    duplicate detection: a hit on a spilled record reloads it. */
+class PRPShardedCache
+{
+public:
+
+  //
+  //- Heading: Constructors and destructor
+  //
+
+  /// constructor; num_shards = 0 selects DEFAULT_SHARDS
+  PRPShardedCache(size_t num_shards = 0);
+  /// destructor
+  ~PRPShardedCache();
+
+  //
+  //- Heading: Member functions
+  //
+
+  /// reset the number of shards; only permitted while the cache is empty
+  void num_shards(size_t num_shards);
+  /// return the number of shards
+  size_t num_shards() const;
+
+  /// bound the resident records by count and/or estimated bytes (0 =
+  /// unbounded) and, if spill_file is non-empty, spill evicted records
+  /// to it; only permitted while the cache is empty
+  void capacity(size_t max_entries, size_t max_bytes,
+		const String& spill_file = String());
+
+  /// insert a shallow copy of prp
+  void insert(const ParamResponsePair& prp);
+
+  /// find a record matching the interface id and variables exactly and
+  /// whose ActiveSet is a superset of search_set; on success, assign a
+  /// shallow copy to found_pr
+  bool lookup_by_val(const String& search_interface_id,
+		     const Variables& search_vars, const ActiveSet& search_set,
+		     ParamResponsePair& found_pr);
+
+  /// as lookup_by_val(), but atomically promote a non-positive
+  /// (restart or file import) evaluation id of the matching record to
+  /// new_eval_id
+  bool lookup_and_promote(const String& search_interface_id,
+			  const Variables& search_vars,
+			  const ActiveSet& search_set, int new_eval_id,
+			  ParamResponsePair& found_pr);
+
+  /// append shallow copies of all records (resident and spilled)
+  /// matching the interface id and variables exactly, regardless of
+  /// their ActiveSets; neither the LRU order nor the statistics change
+  void lookup_all(const String& search_interface_id,
+		  const Variables& search_vars, PRPArray& found_prps) const;
+  /// append shallow copies of all records (resident and spilled) in
+  /// unspecified order; neither the LRU order nor the statistics change
+  void records(PRPArray& prps) const;
+
+  /// reclassify the preceding miss of a lookup as satisfied by a
+  /// record held outside the cache (restart or file import records
+  /// remaining in data_pairs)
+  void count_restart_hit();
+
+  /// number of resident records over all shards
+  size_t size() const;
+  /// true if no shard contains a record and none have been spilled
+  bool empty() const;
+  /// remove all records (resident and spilled) and reset statistics
+  void clear();
+
+  /// approximate memory held by the cache index (excluding the shared
+  /// Variables/Response payloads), in bytes
+  size_t index_bytes() const;
+  /// estimated bytes of the resident Variables/Response payloads
+  size_t resident_bytes() const;
+
+  /// number of lookups satisfied by a resident record
+  size_t hits() const;
+  /// number of lookups satisfied by a spilled record
+  size_t spill_hits() const;
+  /// number of lookups satisfied by a restart or file import record
+  size_t restart_hits() const;
+  /// number of lookups not satisfied
+  size_t misses() const;
+  /// number of records evicted from memory
+  size_t evictions() const;
+  /// number of records currently spilled
+  size_t spilled() const;
+
+  /// print cache counters in the style of the evaluation summary
+  void print_statistics(std::ostream& s) const;
+
+  /// 64-bit key combining the interface id and the Variables hash_value
+  static UInt64 hash_key(const String& interface_id, const Variables& vars);
+  /// estimated bytes of the Variables/Response payload of prp
+  static size_t payload_bytes(const ParamResponsePair& prp);
+
+  /// number of shards used when none is specified
+  static const size_t DEFAULT_SHARDS = 16;
+
+private:
+
+  //
+  //- Heading: Convenience functions
+  //
+
+  /// identity functor for precomputed keys
+  struct KeyHash {
+    std::size_t operator()(UInt64 key) const
+    { return static_cast<std::size_t>(key); }
+  };
+
+  /// a resident record with its key and estimated payload size
+  struct Record {
+    UInt64 key;
+    ParamResponsePair prp;
+    size_t bytes;
+  };
+  typedef std::list<Record> RecordList;
+
+  /// records and lock for one partition of the key space
+  struct Shard {
+    /// guards the shard contents
+    std::mutex shardMutex;
+    /// records in most- to least-recently used order
+    RecordList lruList;
+    /// records keyed by hash_key(); non-unique since records may differ
+    /// only in their ActiveSet (or collide on the key)
+    std::unordered_multimap<UInt64, RecordList::iterator, KeyHash> index;
+    /// estimated payload bytes of lruList
+    size_t bytes = 0;
+  };
+
+  /// return the shard owning key
+  Shard& shard(UInt64 key) const;
+
+  /// locate a matching resident record within a locked shard and mark
+  /// it most recently used
+  static RecordList::iterator find_record(Shard& s, UInt64 key,
+					  const String& search_interface_id,
+					  const Variables& search_vars,
+					  const ActiveSet& search_set);
+
+  /// shared implementation of lookup_by_val()/lookup_and_promote()
+  bool lookup(const String& search_interface_id, const Variables& search_vars,
+	      const ActiveSet& search_set, int new_eval_id,
+	      ParamResponsePair& found_pr);
+
+  /// insert into a locked shard and enforce its budget
+  void insert(Shard& s, UInt64 key, const ParamResponsePair& prp);
+
+  /// evict least recently used records of a locked shard while over budget
+  void enforce_budget(Shard& s);
+
+  /// append an evicted record to the spill file
+  void spill(UInt64 key, const ParamResponsePair& prp);
+  /// read the spilled record at offset (spillMutex must be held)
+  void read_spilled(std::streamoff offset, ParamResponsePair& prp) const;
+  /// find (and remove from the spill index) a spilled record
+  bool unspill(UInt64 key, const String& search_interface_id,
+	       const Variables& search_vars, const ActiveSet& search_set,
+	       ParamResponsePair& found_pr);
+
+  //
+  //- Heading: Data
+  //
+
+  /// number of shards (a power of two)
+  size_t numShards;
+  /// right shift applied to a key to obtain its shard index
+  unsigned short shardShift;
+  /// array of numShards shards
+  std::unique_ptr<Shard[]> shardArray;
+
+  /// resident record limit per shard (0 = unbounded)
+  size_t shardMaxEntries;
+  /// resident payload byte limit per shard (0 = unbounded)
+  size_t shardMaxBytes;
+
+  /// name of the spill file (empty = evicted records are discarded)
+  String spillFile;
+  /// spill file stream, opened on first eviction
+  mutable std::fstream spillStream;
+  /// offsets of spilled records within spillFile, keyed by hash_key()
+  std::unordered_multimap<UInt64, std::streamoff, KeyHash> spillIndex;
+  /// guards spillStream and spillIndex (acquired after a shard lock)
+  mutable std::mutex spillMutex;
+
+  /// lookups satisfied in memory
+  std::atomic<size_t> hitCount;
+  /// lookups satisfied from the spill file
+  std::atomic<size_t> spillHitCount;
+  /// lookups satisfied by restart or file import records
+  std::atomic<size_t> restartHitCount;
+  /// unsatisfied lookups
+  std::atomic<size_t> missCount;
+  /// evicted records
+  std::atomic<size_t> evictionCount;
+};
+
+
+/// find a record of the global evaluation cache matching the interface
+/// id and variables exactly and whose ActiveSet is a superset of
+/// search_set, regardless of the evaluation_cache type in use
+
+/** Searches data_pairs, then sharded_data_pairs, without promoting
+    evaluation ids or updating cache statistics.  Iterators and
+    post-processing that require only data_pairs should use this (or
+    lookup_evaluations()/evaluation_records()) so that evaluations held
+    by a sharded cache remain visible. */
+bool lookup_evaluation(const String& search_interface_id,
+		       const Variables& search_vars,
+		       const ActiveSet& search_set,
+		       ParamResponsePair& found_pr);
+
+/// lookup_evaluation() for the interface id, variables, and ActiveSet
+/// of search_pr
+bool lookup_evaluation(const ParamResponsePair& search_pr,
+		       ParamResponsePair& found_pr);
+
+/// append all records of the global evaluation cache matching the
+/// interface id and variables exactly, regardless of their ActiveSets
+void lookup_evaluations(const String& search_interface_id,
+			const Variables& search_vars, PRPArray& found_prps);
+
+/// all records of the global evaluation cache, ordered by evaluation
+/// and interface ids as for iteration over data_pairs
+void evaluation_records(PRPArray& prps);
+
+
+inline size_t PRPShardedCache::num_shards() const
+{ return numShards; }
+
+
+inline size_t PRPShardedCache::hits() const
+{ return hitCount; }
+
+
+inline size_t PRPShardedCache::spill_hits() const
+{ return spillHitCount; }
+
+
+inline size_t PRPShardedCache::restart_hits() const
+{ return restartHitCount; }
+
+
+inline size_t PRPShardedCache::misses() const
+{ return missCount; }
+
+
+inline void PRPShardedCache::count_restart_hit()
+{ --missCount; ++restartHitCount; }
+
+
+inline size_t PRPShardedCache::evictions() const
+{ return evictionCount; }
+
+
+inline bool PRPShardedCache::
+lookup_by_val(const String& search_interface_id, const Variables& search_vars,
+	      const ActiveSet& search_set, ParamResponsePair& found_pr)
+{ return lookup(search_interface_id, search_vars, search_set, 0, found_pr); }
+
+
+inline bool PRPShardedCache::
+lookup_and_promote(const String& search_interface_id,
+		   const Variables& search_vars, const ActiveSet& search_set,
+		   int new_eval_id, ParamResponsePair& found_pr)
+{
+  return lookup(search_interface_id, search_vars, search_set, new_eval_id,
+		found_pr);
+}
+
+
+inline PRPShardedCache::Shard& PRPShardedCache::shard(UInt64 key) const
+{ return shardArray[(shardShift < 64) ? (key >> shardShift) : 0]; }
+
+} // namespace Dakota
+
+#endif // PRP_SHARDED_CACHE_H
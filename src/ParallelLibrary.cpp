@@ -1146,6 +1146,10 @@ void ParallelLibrary::write_restart(const ParamResponsePair& prp)
 }
 
 
+void ParallelLibrary::checkpoint_restart()
+{ outputManager.checkpoint_restart(); }
+
+
 /** Close streams associated with manage_outputs and manage_restart
     and terminate any additional services that may be active. */
 void ParallelLibrary::terminate_modelcenter()
@@ -1178,7 +1182,9 @@ void ParallelLibrary::terminate_modelcenter()
 
 
 void ParallelLibrary::abort_helper(int code) {
-  
+
+  // a signal may interrupt restart I/O: stop it without blocking first
+  outputManager.abort_restart();
   outputManager.close_streams();
 
   // Abort the process(es)
@@ -1294,6 +1300,18 @@ void ParallelLibrary::output_timers()
       Cout << std::endl;
 #endif // DAKOTA_UTILIB
   }
+
+  // restart I/O is performed by iterator masters (including rank 0);
+  // commit any queued records so that their writes are included
+  outputManager.flush_restart();
+  size_t rst_records = outputManager.restart_records();
+  if (rst_records && mpiManager.world_rank() == 0) {
+    Real rst_io_time = outputManager.restart_io_time();
+    Cout << "  Restart I/O      = " << std::setw(10) << rst_io_time
+	 << " [records = " << rst_records << "]" << std::endl;
+    time_attrs.push_back(ResultAttribute<Real>("restart_io_time",
+					       rst_io_time));
+  }
   iterator_results_db.add_metadata_to_study(time_attrs);
 }
 
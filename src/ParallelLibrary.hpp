@@ -668,6 +668,8 @@ public:
 
   /// write a parameter/response set to the restart file
   void write_restart(const ParamResponsePair& prp);
+  /// commit restart records at a checkpoint, per the restart commit policy
+  void checkpoint_restart();
 
   /// return programOptions reference
   ProgramOptions& program_options();
@@ -172,16 +172,15 @@ void ParamStudy::pre_run()
     copy_data(vars.discrete_real_variables(),   initialDRVPoint); // copy
   }
 
-  size_t av_size = allVariables.size();
-  if (av_size != numEvals) {
-    allVariables.resize(numEvals);
-    for (size_t i=av_size; i<numEvals; ++i)
-      allVariables[i] = vars.copy();
-    if ( outputLevel > SILENT_OUTPUT &&
-	 ( methodName == VECTOR_PARAMETER_STUDY ||
-	   methodName == CENTERED_PARAMETER_STUDY ) )
-      allHeaders.resize(numEvals);
-  }
+  // a long top-level vector study is generated in blocks as it is
+  // evaluated, bounding the number of parameter sets held at once when
+  // evaluating synchronously or within an evaluation window (sub-iterators
+  // and the other studies retain allVariables for use after the run)
+  const size_t lazy_threshold = 1024;
+  numLazyParameterSets = (methodName == VECTOR_PARAMETER_STUDY &&
+    !subIteratorFlag && numEvals > lazy_threshold) ? numEvals : 0;
+  if (!numLazyParameterSets)
+    allocate_parameter_sets(numEvals);
 
   switch (methodName) {
   case LIST_PARAMETER_STUDY:
@@ -218,7 +217,8 @@ void ParamStudy::pre_run()
       if (numSteps) // define step vectors from initial, final, & num steps
 	final_point_to_step_vector();
     }
-    vector_loop();
+    if (!numLazyParameterSets)
+      vector_loop(0, numEvals);
     break;
   case CENTERED_PARAMETER_STUDY:
     if (outputLevel > SILENT_OUTPUT) {
@@ -323,7 +323,7 @@ void ParamStudy::archive_allocate_sets() const
 {
   if(resultsDB.active())
   {
-    size_t num_evals = (compactMode) ? allSamples.numCols() : allVariables.size();
+    size_t num_evals = num_parameter_sets();
 
     StringMultiArrayConstView cv_labels
                 = iteratedModel.continuous_variable_labels();
@@ -434,7 +434,33 @@ void ParamStudy::sample()
 }
 
 
-void ParamStudy::vector_loop()
+/** Parameter sets of a vector study are independent of one another, so
+    any block of steps may be generated on demand. */
+void ParamStudy::
+get_parameter_set_block(Model& model, size_t start, size_t num_sets)
+{
+  allocate_parameter_sets(num_sets);
+  vector_loop(start, num_sets);
+}
+
+
+void ParamStudy::allocate_parameter_sets(size_t num_sets)
+{
+  size_t av_size = allVariables.size();
+  if (av_size != num_sets) {
+    allVariables.resize(num_sets);
+    const Variables& vars = iteratedModel.current_variables();
+    for (size_t i=av_size; i<num_sets; ++i)
+      allVariables[i] = vars.copy();
+    if ( outputLevel > SILENT_OUTPUT &&
+	 ( methodName == VECTOR_PARAMETER_STUDY ||
+	   methodName == CENTERED_PARAMETER_STUDY ) )
+      allHeaders.resize(num_sets);
+  }
+}
+
+
+void ParamStudy::vector_loop(size_t start, size_t num_sets)
 {
   // Steps along a n-dimensional vector through numSteps additions of
   // continuous/discrete step vectors.  The step is an absolute step defining
@@ -445,27 +471,28 @@ void ParamStudy::vector_loop()
   const IntSetArray&    dsi_values = iteratedModel.discrete_set_int_values();
   const StringSetArray& dss_values = iteratedModel.discrete_set_string_values();
   const RealSetArray&   dsr_values = iteratedModel.discrete_set_real_values();
-  size_t i, j, dsi_cntr;
+  size_t i, j, dsi_cntr, step;
 
-  for (i=0; i<=numSteps; ++i) {
+  for (i=0; i<num_sets; ++i) {
     Variables& vars = allVariables[i];
+    step = start + i;
 
     // active continuous
     for (j=0; j<numContinuousVars; ++j)
-      c_step(j, i, vars);
+      c_step(j, step, vars);
 
     // active discrete int: ranges and sets
     for (j=0, dsi_cntr=0; j<numDiscreteIntVars; ++j)
-      if (di_set_bits[j]) dsi_step(j, i, dsi_values[dsi_cntr++], vars);
-      else                dri_step(j, i, vars);
+      if (di_set_bits[j]) dsi_step(j, step, dsi_values[dsi_cntr++], vars);
+      else                dri_step(j, step, vars);
 
     // active discrete string: sets only
     for (j=0; j<numDiscreteStringVars; ++j)
-      dss_step(j, i, dss_values[j], vars);
+      dss_step(j, step, dss_values[j], vars);
 
     // active discrete real: sets only
     for (j=0; j<numDiscreteRealVars; ++j)
-      dsr_step(j, i, dsr_values[j], vars);
+      dsr_step(j, step, dsr_values[j], vars);
 
     // store each output header in allHeaders
     if (outputLevel > SILENT_OUTPUT) {
@@ -476,7 +503,7 @@ void ParamStudy::vector_loop()
       if (numSteps == 0) // Allow numSteps == 0 case
 	h_string += ">>>>> Initial_point only (no steps)\n";
       h_string += ">>>>> Vector parameter study evaluation for ";
-      h_string += std::to_string(i*100./numSteps);
+      h_string += std::to_string(step*100./numSteps);
       h_string += "% along vector\n";
     }
   }
@@ -60,6 +60,11 @@ public:
 protected:
   /// Allocate space to archive parameters and responses
   void archive_allocate_sets() const;
+
+  /// generate steps [start, start + num_sets) of a vector parameter
+  /// study generated on demand
+  void get_parameter_set_block(Model& model, size_t start, size_t num_sets);
+
 private:
 
   //
@@ -70,8 +75,11 @@ private:
   void sample();
   /// performs the parameter study by sampling along a vector, starting from
   /// an initial point followed by numSteps increments along continous/discrete
-  /// step vectors
-  void vector_loop();
+  /// step vectors; populates allVariables (and allHeaders) with the
+  /// num_sets steps beginning with step start
+  void vector_loop(size_t start, size_t num_sets);
+  /// size allVariables (and allHeaders, if used) for num_sets parameter sets
+  void allocate_parameter_sets(size_t num_sets);
   /// performs a number of plus and minus offsets for each parameter
   /// centered about an initial point
   void centered_loop();
@@ -290,6 +290,10 @@ protected:
   /// retrieve the approximate function Hessian for a given parameter vector
   const Pecos::RealSymMatrix& hessian(const Variables& vars);
 
+  void values(const RealMatrix& cv_points, Variables& vars, RealVector& vals);
+  void gradients(const RealMatrix& cv_points, Variables& vars,
+		 RealMatrix& grads);
+
   int min_coefficients() const;
   //int num_constraints() const; // use default implementation
 
@@ -749,6 +753,39 @@ hessian(const Variables& vars)
 }
 
 
+/** Evaluates the expansion directly at each column of cv_points,
+    bypassing the Variables update (discrete variables are ignored as
+    in value(const Variables&)). */
+inline void PecosApproximation::
+values(const RealMatrix& cv_points, Variables& vars, RealVector& vals)
+{
+  int j, num_cv = cv_points.numRows(), num_pts = cv_points.numCols();
+  if (vals.length() != num_pts)
+    vals.sizeUninitialized(num_pts);
+  for (j=0; j<num_pts; ++j) {
+    RealVector cv_j(Teuchos::View, const_cast<Real*>(cv_points[j]), num_cv);
+    vals[j] = pecosBasisApprox.value(cv_j);
+  }
+}
+
+
+inline void PecosApproximation::
+gradients(const RealMatrix& cv_points, Variables& vars, RealMatrix& grads)
+{
+  int i, j, num_cv = cv_points.numRows(), num_pts = cv_points.numCols();
+  if (grads.numRows() != num_cv || grads.numCols() != num_pts)
+    grads.shapeUninitialized(num_cv, num_pts);
+  for (j=0; j<num_pts; ++j) {
+    RealVector cv_j(Teuchos::View, const_cast<Real*>(cv_points[j]), num_cv);
+    const Pecos::RealVector& grad_j
+      = polyApproxRep->gradient_basis_variables(cv_j);
+    Real* grads_j = grads[j];
+    for (i=0; i<num_cv; ++i)
+      grads_j[i] = grad_j[i];
+  }
+}
+
+
 inline int PecosApproximation::min_coefficients() const
 { return pecosBasisApprox.min_coefficients(); }
 
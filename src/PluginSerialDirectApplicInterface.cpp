@@ -60,6 +60,11 @@ int SerialDirectApplicInterface::derived_map_ac(const Dakota::String& ac_name)
 void SerialDirectApplicInterface::
 wait_local_evaluations(Dakota::PRPQueue& prp_queue)
 {
+  if (reentrant_map()) {
+    Dakota::DirectApplicInterface::wait_local_evaluations(prp_queue);
+    return;
+  }
+
   if (multiProcAnalysisFlag) {
     Cerr << "Error: plugin serial direct fn does not support multiprocessor "
 	 << "analyses." << std::endl;
@@ -77,18 +82,11 @@ wait_local_evaluations(Dakota::PRPQueue& prp_queue)
       Cout << "SerialDirectApplicInterface:: evaluating function evaluation "
 	   << fn_eval_id << " in batch mode." << std::endl;
     Dakota::RealVector fn_grad; Dakota::RealSymMatrix fn_hess;
-    //if (ac_name == "plugin_rosenbrock") { // not provided in this API
-      short asv = set.request_vector()[0];
-      Dakota::Real& fn_val = resp.function_value_view(0);
-      if (asv & 2) fn_grad = resp.function_gradient_view(0);
-      if (asv & 4) fn_hess = resp.function_hessian_view(0);
-      rosenbrock(vars.continuous_variables(), asv, fn_val, fn_grad, fn_hess);
-    //}
-    //else {
-    //  Cerr << ac_name << " is not available as an analysis within "
-    //       << "SIM::SerialDirectApplicInterface." << std::endl;
-    //  Dakota::abort_handler(Dakota::INTERFACE_ERROR);
-    //}
+    short asv = set.request_vector()[0];
+    Dakota::Real& fn_val = resp.function_value_view(0);
+    if (asv & 2) fn_grad = resp.function_gradient_view(0);
+    if (asv & 4) fn_hess = resp.function_hessian_view(0);
+    rosenbrock(vars.continuous_variables(), asv, fn_val, fn_grad, fn_hess);
 
     // indicate completion of job to ApplicationInterface schedulers
     completionSet.insert(fn_eval_id);
@@ -96,6 +94,31 @@ wait_local_evaluations(Dakota::PRPQueue& prp_queue)
 }
 
 
+/** Invoked concurrently from the DirectApplicInterface thread pool for
+    asynchronous local evaluations: only the passed data is accessed. */
+void SerialDirectApplicInterface::
+derived_map_reentrant(const Dakota::Variables& vars,
+		      const Dakota::ActiveSet& set, Dakota::Response& response,
+		      int fn_eval_id)
+{
+  const Dakota::RealVector& c_vars = vars.continuous_variables();
+  if (c_vars.length() != 2)
+    throw std::runtime_error("Bad number of variables in rosenbrock direct "
+			     "fn.");
+
+  short asv = set.request_vector()[0];
+  Dakota::Real& fn_val = response.function_value_view(0);
+  Dakota::RealVector fn_grad; Dakota::RealSymMatrix fn_hess;
+  if (asv & 2) fn_grad = response.function_gradient_view(0);
+  if (asv & 4) fn_hess = response.function_hessian_view(0);
+  if (rosenbrock(c_vars, asv, fn_val, fn_grad, fn_hess)) {
+    std::string err_msg("Error evaluating plugin analysis_driver ");
+    err_msg += "plugin_rosenbrock";
+    throw Dakota::FunctionEvalFailure(err_msg);
+  }
+}
+
+
 int SerialDirectApplicInterface::
 rosenbrock(const Dakota::RealVector& c_vars, short asv, Dakota::Real& fn_val, 
 	   Dakota::RealVector& fn_grad, Dakota::RealSymMatrix& fn_hess)
@@ -122,7 +145,7 @@ rosenbrock(const Dakota::RealVector& c_vars, short asv, Dakota::Real& fn_val,
   if (asv & 4) {
     Dakota::Real fx = x2 - 3.*x1*x1;
     fn_hess(0,0) = -400.*fx + 2.;
-    fn_hess(0,1) = fnHessians[0](1,0) = -400.*x1;
+    fn_hess(0,1) = -400.*x1; // symmetric storage
     fn_hess(1,1) =  200.;
   }
 
@@ -58,13 +58,24 @@ protected:
   // execute the output filter portion of a direct evaluation invocation
   //int derived_map_of(const Dakota::String& of_name);
 
-  /// no-op hides base error; job batching occurs within
+  /// the plug-in Rosenbrock function is stateless, permitting
+  /// asynchronous local evaluations on the base class thread pool
+  bool reentrant_map() const;
+  /// evaluate plugin_rosenbrock directly into response
+  void derived_map_reentrant(const Dakota::Variables& vars,
+			     const Dakota::ActiveSet& set,
+			     Dakota::Response& response, int fn_eval_id);
+
+  /// queues the job on the base class thread pool when reentrant_map();
+  /// otherwise a no-op, with job batching occurring within
   /// wait_local_evaluations()
   void derived_map_asynch(const Dakota::ParamResponsePair& pair);
 
-  /// evaluate the batch of jobs contained in prp_queue
+  /// harvest the thread pool when reentrant_map(); otherwise evaluate
+  /// the batch of jobs contained in prp_queue
   void wait_local_evaluations(Dakota::PRPQueue& prp_queue);
-  /// invokes wait_local_evaluations() (no special nowait support)
+  /// test the thread pool when reentrant_map(); otherwise invokes
+  /// wait_local_evaluations() (no special nowait support)
   void test_local_evaluations(Dakota::PRPQueue& prp_queue);
 
   /// no-op hides default run-time error checks at DirectApplicInterface level
@@ -98,12 +109,21 @@ inline SerialDirectApplicInterface::~SerialDirectApplicInterface()
 { }
 
 
+inline bool SerialDirectApplicInterface::reentrant_map() const
+{
+  return ( numAnalysisDrivers == 1 && !multiProcAnalysisFlag &&
+	   analysisDrivers[0] == "plugin_rosenbrock" );
+}
+
+
 inline void SerialDirectApplicInterface::
 derived_map_asynch(const Dakota::ParamResponsePair& pair)
 {
-  // no-op (just hides base class error throw). Jobs are run exclusively within
+  // Jobs for other analysis drivers are run exclusively within
   // wait_local_evaluations(), prior to there existing true batch processing
   // facilities.
+  if (reentrant_map())
+    Dakota::DirectApplicInterface::derived_map_asynch(pair);
 }
 
 
@@ -114,7 +134,12 @@ derived_map_asynch(const Dakota::ParamResponsePair& pair)
     --> ApplicationInterface::serve_evaluations_asynch()). */
 inline void SerialDirectApplicInterface::
 test_local_evaluations(Dakota::PRPQueue& prp_queue)
-{ wait_local_evaluations(prp_queue); }
+{
+  if (reentrant_map())
+    Dakota::DirectApplicInterface::test_local_evaluations(prp_queue);
+  else
+    wait_local_evaluations(prp_queue);
+}
 
 
 // Hide default run-time error checks at DirectApplicInterface level
@@ -2136,6 +2136,7 @@ const String& ProblemDescDB::get_string(const String& entry_name) const
       {"application.output_filter", P_INT outputFilter},
       {"application.parameters_file", P_INT parametersFile},
       {"application.results_file", P_INT resultsFile},
+      {"evaluation_cache_spill_file", P_INT evalCacheSpillFile},
       {"failure_capture.action", P_INT failAction},
       {"id", P_INT idInterface},
       {"plugin_library_path", P_INT pluginLibraryPath},
@@ -2246,6 +2247,7 @@ const Real& ProblemDescDB::get_real(const String& entry_name) const
     },
     { /* variables */ },
     { /* interface */
+      {"evaluation_cache_max_memory", P_INT evalCacheMaxMemory},
       {"nearby_evaluation_cache_tolerance", P_INT nearbyEvalCacheTol}
     },
     { /* responses */ },
@@ -2258,8 +2260,14 @@ int ProblemDescDB::get_int(const String& entry_name) const
   return get<int>
   ( "get_int()",
     { /* environment */
+      {"kernel_threads", P_ENV kernelThreads},
       {"output_precision", P_ENV outputPrecision},
-      {"stop_restart", P_ENV stopRestart}
+      {"results_output_buffer_size", P_ENV resultsOutputBufferSize},
+      {"results_output_compression", P_ENV resultsOutputCompression},
+      {"results_output_flush_seconds", P_ENV resultsOutputFlushSeconds},
+      {"stop_restart", P_ENV stopRestart},
+      {"write_restart_commit_evaluations", P_ENV writeRestartCommitEvals},
+      {"write_restart_commit_seconds", P_ENV writeRestartCommitSeconds}
     },
     { /* method */
       {"batch_size", P_MET batchSize},
@@ -2298,6 +2306,7 @@ int ProblemDescDB::get_int(const String& entry_name) const
       {"samples", P_MET numSamples},
       {"sub_sampling_period", P_MET subSamplingPeriod},
       {"symbols", P_MET numSymbols},
+      {"vbd_bootstrap_samples", P_MET vbdBootstrapSamples},
       {"vbd_via_sampling_num_bins", P_MET vbdViaSamplingNumBins},
       {"m_max", P_MET log2MaxPoints},
       {"t_max", P_MET numberOfBits},
@@ -2325,9 +2334,13 @@ int ProblemDescDB::get_int(const String& entry_name) const
       {"asynch_local_analysis_concurrency", P_INT asynchLocalAnalysisConcurrency},
       {"asynch_local_evaluation_concurrency", P_INT asynchLocalEvalConcurrency},
       {"direct.processors_per_analysis", P_INT procsPerAnalysis},
+      {"evaluation_cache_max_entries", P_INT evalCacheMaxEntries},
+      {"evaluation_cache_shards", P_INT evalCacheShards},
+      {"evaluation_chunk_max_size", P_INT evalChunkMax},
       {"evaluation_servers", P_INT evalServers},
       {"failure_capture.retry_limit", P_INT retryLimit},
-      {"processors_per_evaluation", P_INT procsPerEval}
+      {"processors_per_evaluation", P_INT procsPerEval},
+      {"stagePoolSize", P_INT stagePoolSize}
     },
     { /* responses */ },
     entry_name, dbRep);
@@ -2406,6 +2419,7 @@ short ProblemDescDB::get_short(const String& entry_name) const
     },
     { /* interface */
       {"analysis_scheduling", P_INT analysisScheduling},
+      {"evaluation_cache_type", P_INT evalCacheType},
       {"evaluation_scheduling", P_INT evalScheduling},
       {"local_evaluation_scheduling", P_INT asynchLocalEvalScheduling}
     },
@@ -2424,7 +2438,8 @@ unsigned short ProblemDescDB::get_ushort(const String& entry_name) const
       {"post_run_input_format", P_ENV postRunInputFormat},
       {"pre_run_output_format", P_ENV preRunOutputFormat},
       {"results_output_format", P_ENV resultsOutputFormat},
-      {"tabular_format", P_ENV tabularFormat}
+      {"tabular_format", P_ENV tabularFormat},
+      {"write_restart_commit", P_ENV writeRestartCommit}
     },
     { /* method */
       {"algorithm", P_MET methodName},
@@ -2533,6 +2548,7 @@ size_t ProblemDescDB::get_sizet(const String& entry_name) const
   ( "get_sizet()",
     { /* environment */ },
     { /* method */
+      {"evaluation_window", P_MET evaluationWindow},
       {"final_solutions", P_MET numFinalSolutions},
       {"jega.num_cross_points", P_MET numCrossPoints},
       {"jega.num_designs", P_MET numDesigns},
@@ -2549,6 +2565,7 @@ size_t ProblemDescDB::get_sizet(const String& entry_name) const
       {"nond.expansion_samples", P_MET expansionSamples},
       {"nond.max_refinement_iterations", P_MET maxRefineIterations},
       {"nond.max_solver_iterations", P_MET maxSolverIterations},
+      {"nond.quantile_sketch_size", P_MET quantileSketchSize},
       {"num_candidate_designs", P_MET numCandidateDesigns},
       {"num_candidates", P_MET numCandidates},
       {"num_prediction_configs", P_MET numPredConfigs}
@@ -2641,7 +2658,9 @@ bool ProblemDescDB::get_bool(const String& entry_name) const
       {"pre_run", P_ENV preRunFlag},
       {"results_output", P_ENV resultsOutputFlag},
       {"run", P_ENV runFlag},
-      {"tabular_graphics_data", P_ENV tabularDataFlag}
+      {"tabular_graphics_data", P_ENV tabularDataFlag},
+      {"write_restart_fsync", P_ENV writeRestartFsync},
+      {"write_restart_indexed", P_ENV writeRestartIndexed}
     },
     { /* method */
       {"backfill", P_MET backfillFlag},
@@ -2699,6 +2718,7 @@ bool ProblemDescDB::get_bool(const String& entry_name) const
       {"scaling", P_MET methodScaling},
       {"speculative", P_MET speculativeFlag},
       {"std_regression_coeffs", P_MET stdRegressionCoeffs},
+      {"streaming_statistics", P_MET streamingStatsFlag},
       {"tolerance_intervals", P_MET toleranceIntervalsFlag},
       {"variance_based_decomp", P_MET vbdFlag},
       {"wilks", P_MET wilksFlag},
@@ -2753,15 +2773,21 @@ bool ProblemDescDB::get_bool(const String& entry_name) const
       {"application.aprepro", P_INT apreproFlag},
       {"application.file_save", P_INT fileSaveFlag},
       {"application.file_tag", P_INT fileTagFlag},
+      {"application.process_launcher", P_INT processLauncherFlag},
       {"application.verbatim", P_INT verbatimFlag},
       {"asynch", P_INT asynchFlag},
       {"batch", P_INT batchEvalFlag},
+      {"cost_aware_scheduling", P_INT costAwareSchedFlag},
       {"dirSave", P_INT dirSave},
       {"dirTag", P_INT dirTag},
       {"evaluation_cache", P_INT evalCacheFlag},
+      {"evaluation_chunking", P_INT evalChunkingFlag},
       {"nearby_evaluation_cache", P_INT nearbyEvalCacheFlag},
+      {"python.columnar", P_INT columnarFlag},
       {"python.numpy", P_INT numpyFlag},
       {"restart_file", P_INT restartFileFlag},
+      {"stageHardlinks", P_INT stageHardlinks},
+      {"stageWorkdir", P_INT stageWorkdir},
       {"templateReplace", P_INT templateReplace},
       {"useWorkdir", P_INT useWorkdir}
     },
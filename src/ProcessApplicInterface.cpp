@@ -13,7 +13,11 @@
 #include "ProblemDescDB.hpp"
 #include "ParallelLibrary.hpp"
 #include "WorkdirHelper.hpp"
+#include "WorkdirStager.hpp"
+#include "ResultsFileTokenizer.hpp"
+#include "dakota_binary_files.h"
 #include <algorithm>
+#include <cstdio>
 #include <boost/filesystem/fstream.hpp>
 
 /* 
@@ -138,12 +142,27 @@ ProcessApplicInterface(const ProblemDescDB& problem_db):
 	  outputLevel >= DEBUG_OUTPUT)
 	Cout << "Adjusted relative analysis_driver to absolute path:\n  " 
 	     << *pn_it << std::endl;
+
+    if (problem_db.get_bool("interface.stageWorkdir")) {
+      // by default, pool as many directories as evaluations run concurrently
+      int pool_size = problem_db.get_int("interface.stagePoolSize");
+      if (pool_size < 0)
+	pool_size = std::max(1, asynchLocalEvalConcSpec);
+      workdirStager = std::make_shared<WorkdirStager>(linkFiles, copyFiles,
+	problem_db.get_bool("interface.stageHardlinks"), pool_size);
+    }
   }
 
   size_t num_programs = programNames.size();
   if (num_programs > 1 && !analysisComponents.empty())
     multipleParamsFiles = true;
 
+  if (resultsFileFormat == BINARY_RESULTS && apreproFlag) {
+    Cout << "\nWarning: aprepro parameters file format is not used with "
+	 << "binary files." << std::endl;
+    apreproFlag = false;
+  }
+
   // RATIONALE: While a user might truly want concurrent evaluations
   // with non-unique work_directory and/or parameters/results files,
   // it could too easily lead to errors or surprising results.
@@ -325,33 +344,44 @@ void ProcessApplicInterface::wait_local_evaluation_batch(PRPQueue& prp_queue)
   // prp_queue. Probably not a very robust way of doing things, but for purposes
   // of prototyping, it'll do.
   
-  bfs::ifstream results_file(resultsFileWritten);
+  std::ios::openmode mode = (resultsFileFormat == BINARY_RESULTS) ?
+    std::ios::in | std::ios::binary : std::ios::in;
+  bfs::ifstream results_file(resultsFileWritten, mode);
   if (!results_file) {
     Cerr << "\nError: cannot open results file " << resultsFileWritten
 	 << " for batch " << std::to_string(batchIdCntr) << std::endl;
     abort_handler(INTERFACE_ERROR); // will clean up files unless file_save was specified
   }
+  if (resultsFileFormat == BINARY_RESULTS) {
+    // binary records are self-delimiting and follow prp_queue order
+    read_binary_results_batch(prp_queue, results_file);
+    results_file.close();
+    file_and_workdir_cleanup(paramsFileWritten, resultsFileWritten, createdDir,
+			     batch_id_tag);
+    return;
+  }
   Response response;
+  String eval_buffer, eval_content;
   for(auto & pair : prp_queue) {
-    std::stringstream eval_ss;
+    eval_content.clear();
     while(true) {
-      String eval_buffer;
       std::getline(results_file, eval_buffer);
       if(results_file.eof())
         break;
       if(eval_buffer[0] == '#') {
-        if(eval_ss.str().empty())
+        if(eval_content.empty())
           continue;
         else
           break;
       } else {
-        eval_ss << eval_buffer << std::endl;
+        eval_content.append(eval_buffer);
+        eval_content.push_back('\n');
       }
     }
     response = pair.response();
     // the read operation errors out for improperly formatted data
     try {
-      response.read(eval_ss, resultsFileFormat);
+      response.read(eval_content, resultsFileFormat);
     }
     catch(const FunctionEvalFailure & fneval_except) {
       manage_failure(pair.variables(), response.active_set(), response, pair.eval_id());
@@ -368,6 +398,37 @@ void ProcessApplicInterface::wait_local_evaluation_batch(PRPQueue& prp_queue)
 
 }
 
+
+void ProcessApplicInterface::
+read_binary_results_batch(PRPQueue& prp_queue, std::istream& results_file)
+{
+  String content;
+  ResultsFileTokenizer::slurp(results_file, content);
+  size_t offset = 0;
+  Response response;
+  for(auto & pair : prp_queue) {
+    size_t record_size = dakota_bin_results_record_size(content.data() + offset,
+							 content.size() - offset);
+    response = pair.response();
+    try {
+      if (record_size == 0)
+	throw ResultsFileError("-- Binary results record is missing or "
+			       "truncated.");
+      response.read(content.substr(offset, record_size), BINARY_RESULTS);
+    }
+    catch(const FunctionEvalFailure & fneval_except) {
+      manage_failure(pair.variables(), response.active_set(), response, pair.eval_id());
+    }
+    catch(const FileReadException& fr_except) {
+      throw FileReadException("Error(s) encountered reading batch results file " +
+          resultsFileWritten + " for Evaluation " + std::to_string(pair.eval_id())
+          + ":\n" + fr_except.what()); 
+    }
+    offset += record_size;
+    completionSet.insert(pair.eval_id());
+  }
+}
+
 void ProcessApplicInterface::test_local_evaluation_batch(PRPQueue& prp_queue)
 { wait_local_evaluation_batch(prp_queue); }
 
@@ -416,11 +477,21 @@ void ProcessApplicInterface::define_filenames(const String& eval_id_tag)
     if (useWorkdir) {
       // curWorkdir is used by Fork/SysCall arg_adjust
       curWorkdir = get_workdir_name();
-      // TODO: Create with 0700 mask?
-      wd_created = WorkdirHelper::create_directory(curWorkdir, DIR_PERSIST);
-      // copy/link tolerate empty items
-      WorkdirHelper::copy_items(copyFiles, curWorkdir, templateReplace);
-      WorkdirHelper::link_items(linkFiles, curWorkdir, templateReplace);
+      if (workdirStager) {
+	wd_created = workdirStager->stage(curWorkdir, templateReplace);
+	if (outputLevel >= VERBOSE_OUTPUT)
+	  Cout << "Staged work_directory " << curWorkdir << " in "
+	       << workdirStager->last_stage_time() << " s"
+	       << (workdirStager->last_stage_reused() ? " (recycled)" : "")
+	       << std::endl;
+      }
+      else {
+	// TODO: Create with 0700 mask?
+	wd_created = WorkdirHelper::create_directory(curWorkdir, DIR_PERSIST);
+	// copy/link tolerate empty items
+	WorkdirHelper::copy_items(copyFiles, curWorkdir, templateReplace);
+	WorkdirHelper::link_items(linkFiles, curWorkdir, templateReplace);
+      }
     }
 
     // non-empty createdDir communicates to write_parameters_files that
@@ -612,6 +683,12 @@ write_parameters_file(const Variables& vars, const ActiveSet& set,
                       const std::string& params_fname,
                       const bool file_mode_out)
 {
+  if (resultsFileFormat == BINARY_RESULTS) {
+    write_binary_parameters_file(vars, set, response, an_comps, params_fname,
+				 file_mode_out);
+    return;
+  }
+
   // Write the parameters file
   std::ofstream parameter_stream;
   if(file_mode_out) // params for one evaluation per file
@@ -707,6 +784,91 @@ write_parameters_file(const Variables& vars, const ActiveSet& set,
 }
 
 
+/** Variables are written by type (continuous, discrete integer, discrete
+    string, discrete real) in the "all" view ordering, and the derivative
+    variables as positions within the continuous variables, so that
+    drivers need no id lookups.  Real data are written without decimal
+    conversion. */
+void ProcessApplicInterface::
+write_binary_parameters_file(const Variables& vars, const ActiveSet& set,
+			     const Response& response,
+			     const std::vector<String>& an_comps,
+			     const std::string& params_fname,
+			     const bool file_mode_out)
+{
+  std::FILE* f = std::fopen(params_fname.c_str(), file_mode_out ? "wb" : "ab");
+  if (!f) {
+    Cerr << "\nError: cannot create parameters file " << params_fname
+         << std::endl;
+    abort_handler(IO_ERROR);
+  }
+
+  const RealVector& acv = vars.all_continuous_variables();
+  const IntVector&  adiv = vars.all_discrete_int_variables();
+  StringMultiArrayConstView adsv = vars.all_discrete_string_variables();
+  const RealVector& adrv = vars.all_discrete_real_variables();
+  SizetMultiArrayConstView acv_ids = vars.all_continuous_variable_ids();
+  const ShortArray&  asv = set.request_vector();
+  const SizetArray&  dvv = set.derivative_vector();
+  const StringArray& resp_labels = response.function_labels();
+  const StringArray& md_labels = response.shared_data().metadata_labels();
+  size_t i, num_acv = acv.length(), num_adiv = adiv.length(),
+    num_adsv = adsv.size(), num_adrv = adrv.length(), num_fns = asv.size(),
+    num_dvv = dvv.size();
+
+  int err = dakota_bin_write_header(f, DAKOTA_BIN_PARAMS_MAGIC, 0);
+  err |= dakota_bin_write_u64(f, num_acv)  | dakota_bin_write_u64(f, num_adiv)
+    |    dakota_bin_write_u64(f, num_adsv) | dakota_bin_write_u64(f, num_adrv);
+  StringMultiArrayView labels[4] = { vars.all_continuous_variable_labels(),
+    vars.all_discrete_int_variable_labels(),
+    vars.all_discrete_string_variable_labels(),
+    vars.all_discrete_real_variable_labels() };
+  for (size_t t=0; t<4; ++t)
+    for (i=0; i<labels[t].size(); ++i)
+      err |= dakota_bin_write_string(f, labels[t][i].data(),
+				     labels[t][i].size());
+  err |= dakota_bin_write_f64_array(f, acv.values(), num_acv);
+  for (i=0; i<num_adiv; ++i)
+    err |= dakota_bin_write_u64(f, (uint64_t)(int64_t)adiv[i]);
+  for (i=0; i<num_adsv; ++i)
+    err |= dakota_bin_write_string(f, adsv[i].data(), adsv[i].size());
+  err |= dakota_bin_write_f64_array(f, adrv.values(), num_adrv);
+
+  err |= dakota_bin_write_u64(f, num_fns);
+  for (i=0; i<num_fns; ++i)
+    err |= dakota_bin_write_string(f, resp_labels[i].data(),
+				   resp_labels[i].size());
+  for (i=0; i<num_fns; ++i) {
+    unsigned char a = (unsigned char)asv[i];
+    err |= (std::fwrite(&a, 1, 1, f) == 1) ? 0 : -1;
+  }
+  err |= dakota_bin_write_u64(f, num_dvv);
+  for (i=0; i<num_dvv; ++i) {
+    size_t acv_index = find_index(acv_ids, dvv[i]);
+    err |= dakota_bin_write_u64(f, (acv_index == _NPOS) ? 0 : acv_index+1);
+  }
+  err |= dakota_bin_write_u64(f, an_comps.size());
+  for (i=0; i<an_comps.size(); ++i)
+    err |= dakota_bin_write_string(f, an_comps[i].data(), an_comps[i].size());
+  // full eval ID tag, without leading period, converting . to :
+  String full_eval_id(fullEvalId);
+  full_eval_id.erase(0,1); 
+  boost::algorithm::replace_all(full_eval_id, String("."), String(":"));
+  err |= dakota_bin_write_string(f, full_eval_id.data(), full_eval_id.size());
+  err |= dakota_bin_write_u64(f, md_labels.size());
+  for (i=0; i<md_labels.size(); ++i)
+    err |= dakota_bin_write_string(f, md_labels[i].data(),
+				   md_labels[i].size());
+
+  // close before any filter or driver reads the file
+  if (std::fclose(f) != 0 || err) {
+    Cerr << "\nError: cannot write parameters file " << params_fname
+         << std::endl;
+    abort_handler(IO_ERROR);
+  }
+}
+
+
 void ProcessApplicInterface::
 read_results_files(Response& response, const int id, const String& eval_id_tag)
 {
@@ -756,7 +918,9 @@ void ProcessApplicInterface::read_results_file(Response &response,
     const int id) {
   /// Helper for read_results_files that opens the results file at 
   /// results_path and reads it, handling various errors/exceptions.
-  bfs::ifstream recovery_stream(results_path);
+  std::ios::openmode mode = (resultsFileFormat == BINARY_RESULTS) ?
+    std::ios::in | std::ios::binary : std::ios::in;
+  bfs::ifstream recovery_stream(results_path, mode);
   if (!recovery_stream) {
     Cerr << "\nError: cannot open results file " << results_path
 	 << " for evaluation " << std::to_string(id) << std::endl;
@@ -887,9 +1051,13 @@ remove_params_results_files(const bfs::path& params_path,
 }
 
 
-/** Remove any files and directories still referenced in the fileNameMap */
+/** Remove any files and directories still referenced in the
+    fileNameMap, and any work directory staging area */
 void ProcessApplicInterface::file_cleanup() const
 {
+  if (workdirStager)
+    workdirStager->remove_staging_area();
+
   if (fileSaveFlag && dirSave)
     return;
 
@@ -1038,9 +1206,19 @@ file_and_workdir_cleanup(const bfs::path &params_path,
   if (removing_workdir) {
     if (outputLevel > NORMAL_OUTPUT)
       Cout << "Removing work_directory " << workdir_path << std::endl;
-    WorkdirHelper::recursive_remove(workdir_path, FILEOP_ERROR);
+    if (workdirStager) // keep for reuse by a later evaluation
+      workdirStager->recycle(workdir_path);
+    else
+      WorkdirHelper::recursive_remove(workdir_path, FILEOP_ERROR);
   }
 
 }
 
+
+void ProcessApplicInterface::print_workdir_summary(std::ostream& s) const
+{
+  if (workdirStager)
+    workdirStager->print_summary(s);
+}
+
 } // namespace Dakota
@@ -21,6 +21,8 @@ namespace bfs = boost::filesystem;
 
 namespace Dakota {
 
+class WorkdirStager;
+
 
 /// Substitute parameters and results file names into driver strings
 String substitute_params_and_results(const String &driver, const String &params, const String &results);
@@ -66,6 +68,9 @@ protected:
 
   void file_cleanup() const;
 
+  /// print the work directory staging statistics
+  void print_workdir_summary(std::ostream& s) const;
+
   void file_and_workdir_cleanup(const bfs::path &params_path,
       const bfs::path &results_path,
       const bfs::path &workdir_path,
@@ -113,6 +118,10 @@ protected:
   void wait_local_evaluation_batch(PRPQueue& prp_queue);
   /// batch version of test_local_evaluations()
   void test_local_evaluation_batch(PRPQueue& prp_queue);
+  /// read the consecutive binary results records of a batch, in
+  /// prp_queue order
+  void read_binary_results_batch(PRPQueue& prp_queue,
+				 std::istream& results_file);
 
 /// execute analyses synchronously on the local processor
   void synchronous_local_analyses(int start, int end, int step);
@@ -230,6 +239,9 @@ protected:
   StringArray copyFiles;
   /// whether to replace existing files
   bool templateReplace;
+  /// stages work directories from a snapshot of the template files (from
+  /// the staged specification); empty when linking and copying directly
+  std::shared_ptr<WorkdirStager> workdirStager;
 
 private:
 
@@ -245,6 +257,14 @@ private:
 			     const std::vector<String>& an_comps,
 			     const std::string& params_fname,
                              const bool file_mode_out = true);
+  /// write the parameters file content of write_parameters_file() as a
+  /// binary record (see dakota_binary_files.h)
+  void write_binary_parameters_file(const Variables& vars,
+				    const ActiveSet& set,
+				    const Response& response,
+				    const std::vector<String>& an_comps,
+				    const std::string& params_fname,
+				    const bool file_mode_out);
 
   /// Open and read the results file at path, properly handling errors
   void read_results_file(Response &response, const bfs::path &path, 
@@ -223,6 +223,16 @@ pid_t ProcessHandleApplicInterface::create_evaluation_process(bool block_flag)
     // o_filter with ()'s and ;'s, but this is not supported by the exec family
     // of functions (see exec man pages).
 
+    // A derived class may launch serial analyses as a single sequence
+    // without the intermediate process (see ProcessLauncher).
+    bool new_group = evalProcessIdMap.empty();
+    if (!block_flag && !asynchLocalAnalysisFlag &&
+	(pid = create_evaluation_sequence(new_group)) > 0) {
+      if (new_group)
+	evaluation_process_group_id(pid);
+      return pid;
+    }
+
     // Since we want this intermediate process to be able to execute
     // concurrently with the parent dakota and other asynch processes,
     // fork() should be used here since there is no matching exec().
@@ -239,7 +249,6 @@ pid_t ProcessHandleApplicInterface::create_evaluation_process(bool block_flag)
 #endif
     }
 
-    bool new_group = evalProcessIdMap.empty();
     if (block_flag || pid == 0) {
       // if nonblocking, then this is the intermediate (1st level child)
       // process.  If blocking, then no fork has yet been performed, and
@@ -491,6 +500,10 @@ void ProcessHandleApplicInterface::check_wait(pid_t pid, int status)
 }
 
 
+pid_t ProcessHandleApplicInterface::create_evaluation_sequence(bool new_group)
+{ return 0; } // not supported
+
+
 void ProcessHandleApplicInterface::join_evaluation_process_group(bool new_group)
 { } // no-op
 
@@ -58,6 +58,11 @@ protected:
   /// spawn a child process for an analysis component within an evaluation
   virtual pid_t create_analysis_process(bool block_flag, bool new_group) = 0;
 
+  /// spawn the filters and analyses of a nonblocking evaluation as one
+  /// process without forking an intermediate copy of this process;
+  /// returns 0 if not supported
+  virtual pid_t create_evaluation_sequence(bool new_group);
+
   /// wait for asynchronous analyses on the local processor, completing
   /// at least one job
   virtual size_t wait_local_analyses() = 0;
@@ -0,0 +1,454 @@
+/*  _______________________________________________________________________
+
+    Dakota: Explore and predict with confidence.
+    Copyright 2014-2023
+    National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Dakota directory.
+    _______________________________________________________________________ */
+
+#include "ProcessLauncher.hpp"
+#include "dakota_global_defs.hpp"
+
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#ifdef HAVE_POSIX_SPAWN
+#include <spawn.h>
+#endif
+
+#ifdef __APPLE__
+#include <crt_externs.h>
+#define environ (*_NSGetEnviron())
+#else
+extern char** environ;
+#endif
+
+#ifdef MSG_NOSIGNAL
+#define LAUNCHER_SEND_FLAGS MSG_NOSIGNAL // a lost peer is an error, not SIGPIPE
+#else
+#define LAUNCHER_SEND_FLAGS 0
+#endif
+
+
+namespace Dakota {
+
+namespace {
+
+/// types of the replies of the daemon
+enum { LAUNCHED = 1, EXITED = 2 };
+
+/// fixed part of a launch request, followed by numCommands argument
+/// counts and numBytes of null-terminated strings: the working
+/// directory, numEnv environment entries and the arguments of each
+/// command
+struct LaunchRequest
+{
+  int32_t numCommands;
+  int32_t numEnv;
+  int64_t numBytes;
+};
+
+/// reply of the daemon: LAUNCHED with the process id (or -1 and errno
+/// in value), or EXITED with the waitpid() status in value
+struct LaunchReply
+{
+  int32_t type;
+  int32_t pid;
+  int32_t value;
+};
+
+/// write end of the pipe by which SIGCHLD wakes the daemon
+int childPipeWrite = -1;
+
+} // anonymous namespace
+
+
+static bool write_fully(int fd, const void* data, size_t num_bytes)
+{
+  const char* ptr = (const char*)data;
+  while (num_bytes) {
+    ssize_t count = send(fd, ptr, num_bytes, LAUNCHER_SEND_FLAGS);
+    if (count < 0) {
+      if (errno == EINTR) continue;
+      return false;
+    }
+    ptr += count;  num_bytes -= count;
+  }
+  return true;
+}
+
+
+static bool read_fully(int fd, void* data, size_t num_bytes)
+{
+  char* ptr = (char*)data;
+  while (num_bytes) {
+    ssize_t count = recv(fd, ptr, num_bytes, 0);
+    if (count < 0 && errno == EINTR) continue;
+    if (count <= 0) // closed by the peer
+      return false;
+    ptr += count;  num_bytes -= count;
+  }
+  return true;
+}
+
+
+static void set_descriptor_flags(int fd, bool nonblocking)
+{
+  fcntl(fd, F_SETFD, fcntl(fd, F_GETFD) | FD_CLOEXEC);
+  if (nonblocking)
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+}
+
+
+static void child_signal_handler(int)
+{
+  int saved_errno = errno;
+  char c = 0;
+  ssize_t count = write(childPipeWrite, &c, 1);
+  (void)count; // a full pipe has already woken the daemon
+  errno = saved_errno;
+}
+
+
+/** Search the PATH of the launch environment the way execvp() does, so
+    that PATH changes for work directories take effect. */
+static bool resolve_program(const char* name, char* const* envp,
+			    String& program)
+{
+  if (std::strchr(name, '/'))
+    { program = name; return true; }
+
+  const char* path = "/usr/bin:/bin";
+  for (char* const* e = envp; *e; ++e)
+    if (!std::strncmp(*e, "PATH=", 5))
+      { path = *e + 5; break; }
+
+  struct stat file_stat;
+  for (const char* dir = path; ; ++dir) {
+    const char* end = std::strchr(dir, ':');
+    size_t len = (end) ? end - dir : std::strlen(dir);
+    program.assign(dir, len);
+    program = (program.empty()) ? String(name) : program + '/' + name;
+    if (!access(program.c_str(), X_OK) && !stat(program.c_str(), &file_stat)
+	&& S_ISREG(file_stat.st_mode))
+      return true;
+    if (!end)
+      return false;
+    dir = end;
+  }
+}
+
+
+static pid_t spawn_program(char* const* argv, char* const* envp, int& error)
+{
+#ifdef HAVE_POSIX_SPAWN
+  String program;
+  if (!resolve_program(argv[0], envp, program))
+    { error = ENOENT; return -1; }
+  pid_t pid;
+  error = posix_spawn(&pid, program.c_str(), NULL, NULL, argv, envp);
+  return (error) ? -1 : pid;
+#else
+  error = ENOSYS;
+  return -1;
+#endif
+}
+
+
+/** The status test matches ProcessHandleApplicInterface::check_wait(). */
+static bool abnormal_exit(int status)
+{ return !WIFEXITED(status) || (signed char)WEXITSTATUS(status) == -1; }
+
+
+/** Unpacks a request and starts it from its working directory: a single
+    program directly, a sequence from a helper forked from the (small)
+    daemon. */
+static pid_t spawn_request(const LaunchRequest& request,
+			   const std::vector<int32_t>& arg_counts,
+			   std::vector<char>& strings, int& error)
+{
+  char* ptr = strings.data();
+  const char* cwd = ptr;  ptr += std::strlen(ptr) + 1;
+  std::vector<char*> envp(request.numEnv + 1, (char*)NULL);
+  for (int32_t i=0; i<request.numEnv; ++i)
+    { envp[i] = ptr;  ptr += std::strlen(ptr) + 1; }
+  std::vector<std::vector<char*> > commands(request.numCommands);
+  for (int32_t c=0; c<request.numCommands; ++c) {
+    commands[c].assign(arg_counts[c] + 1, (char*)NULL);
+    for (int32_t i=0; i<arg_counts[c]; ++i)
+      { commands[c][i] = ptr;  ptr += std::strlen(ptr) + 1; }
+  }
+
+  if (commands.empty() || commands[0].size() < 2)
+    { error = EINVAL; return -1; }
+  if (chdir(cwd))
+    { error = errno; return -1; }
+  if (commands.size() == 1)
+    return spawn_program(commands[0].data(), envp.data(), error);
+
+  pid_t pid = fork();
+  if (pid < 0)
+    { error = errno; return -1; }
+  if (pid == 0) { // helper: run the sequence and report through its status
+    signal(SIGCHLD, SIG_DFL);
+    for (size_t c=0; c<commands.size(); ++c) {
+      int status, spawn_error;
+      pid_t child = spawn_program(commands[c].data(), envp.data(), spawn_error);
+      if (child < 0 || waitpid(child, &status, 0) < 0 || abnormal_exit(status))
+	_exit(-1);
+    }
+    _exit(0);
+  }
+  return pid;
+}
+
+
+std::shared_ptr<ProcessLauncher> ProcessLauncher::instance()
+{
+  static std::weak_ptr<ProcessLauncher> shared_launcher;
+  std::shared_ptr<ProcessLauncher> launcher = shared_launcher.lock();
+  if (!launcher || !launcher->active()) {
+    launcher.reset(new ProcessLauncher());
+    if (!launcher->start())
+      launcher.reset();
+    shared_launcher = launcher;
+  }
+  return launcher;
+}
+
+
+bool ProcessLauncher::start()
+{
+#if defined(HAVE_POSIX_SPAWN) && defined(HAVE_WORKING_FORK)
+  if (active())
+    return true;
+  int fds[2];
+  if (socketpair(AF_UNIX, SOCK_STREAM, 0, fds))
+    return false;
+  set_descriptor_flags(fds[0], false);
+  set_descriptor_flags(fds[1], false);
+
+  // flush so that the daemon does not inherit buffered output
+  Cout << std::flush;
+  pid_t pid = fork();
+  if (pid < 0)
+    { close(fds[0]); close(fds[1]); return false; }
+  if (pid == 0) {
+    close(fds[0]);
+    serve(fds[1]); // does not return
+  }
+  close(fds[1]);
+  socketFd = fds[0];  daemonPid = pid;  ownerPid = getpid();
+  return true;
+#else
+  return false;
+#endif
+}
+
+
+void ProcessLauncher::stop()
+{
+  if (socketFd < 0)
+    return;
+  close(socketFd); // the daemon exits at end of file
+  socketFd = -1;
+  if (ownerPid == getpid()) {
+    int status;
+    while (waitpid(daemonPid, &status, 0) < 0 && errno == EINTR)
+      ;
+  }
+  exitedProcesses.clear();
+}
+
+
+bool ProcessLauncher::active() const
+{ return socketFd >= 0 && ownerPid == getpid(); }
+
+
+pid_t ProcessLauncher::launch(const std::vector<StringArray>& commands)
+{
+  if (!active())
+    { errno = ECHILD; return -1; }
+
+  // the working directory and environment were set up by the caller
+  // (see ProcessApplicInterface::prepare_process_environment())
+  std::vector<char> cwd(256);
+  while (!getcwd(cwd.data(), cwd.size())) {
+    if (errno != ERANGE)
+      return -1;
+    cwd.resize(2 * cwd.size());
+  }
+  String strings(cwd.data());  strings.push_back('\0');
+  LaunchRequest request;
+  request.numCommands = commands.size();  request.numEnv = 0;
+  for (char** e = environ; *e; ++e, ++request.numEnv)
+    { strings.append(*e);  strings.push_back('\0'); }
+  std::vector<int32_t> arg_counts(commands.size());
+  for (size_t c=0; c<commands.size(); ++c) {
+    arg_counts[c] = commands[c].size();
+    for (size_t i=0; i<commands[c].size(); ++i)
+      { strings.append(commands[c][i]);  strings.push_back('\0'); }
+  }
+  request.numBytes = strings.size();
+
+  if (!write_fully(socketFd, &request, sizeof(request)) ||
+      !write_fully(socketFd, arg_counts.data(),
+		   arg_counts.size() * sizeof(int32_t)) ||
+      !write_fully(socketFd, strings.data(), strings.size()))
+    lost_daemon();
+
+  // completions of earlier launches may precede the reply
+  int type, value;  pid_t pid;
+  while (receive(true, type, pid, value) && type == EXITED)
+    store_exit(pid, value);
+  if (pid < 0)
+    errno = value;
+  return pid;
+}
+
+
+int ProcessLauncher::wait(pid_t pid)
+{
+  std::map<pid_t, int> process_id_map;
+  process_id_map[pid] = 0;
+  int status;
+  wait(process_id_map, true, status);
+  return status;
+}
+
+
+pid_t ProcessLauncher::
+wait(const std::map<pid_t, int>& process_id_map, bool block_flag,
+     int& status)
+{
+  std::map<pid_t, int>::iterator ex_it;
+  for (ex_it=exitedProcesses.begin(); ex_it!=exitedProcesses.end(); ++ex_it)
+    if (process_id_map.find(ex_it->first) != process_id_map.end()) {
+      pid_t pid = ex_it->first;  status = ex_it->second;
+      exitedProcesses.erase(ex_it);
+      return pid;
+    }
+
+  int type, value;  pid_t pid;
+  while (receive(block_flag, type, pid, value)) {
+    if (type != EXITED) {
+      Cerr << "Error: unexpected reply from process launcher in "
+	   << "ProcessLauncher::wait()." << std::endl;
+      abort_handler(-1);
+    }
+    if (process_id_map.find(pid) != process_id_map.end())
+      { status = value;  return pid; }
+    store_exit(pid, value);
+  }
+  return 0;
+}
+
+
+bool ProcessLauncher::
+receive(bool block_flag, int& type, pid_t& pid, int& value)
+{
+  if (!block_flag) {
+    struct pollfd pfd = { socketFd, POLLIN, 0 };
+    int ready;
+    while ((ready = poll(&pfd, 1, 0)) < 0 && errno == EINTR)
+      ;
+    if (ready <= 0)
+      return false;
+  }
+  LaunchReply reply;
+  if (!read_fully(socketFd, &reply, sizeof(reply)))
+    lost_daemon();
+  type = reply.type;  pid = reply.pid;  value = reply.value;
+  return true;
+}
+
+
+void ProcessLauncher::store_exit(pid_t pid, int status)
+{ exitedProcesses[pid] = status; }
+
+
+void ProcessLauncher::lost_daemon() const
+{
+  Cerr << "Error: lost connection to process launcher " << daemonPid
+       << " in ProcessLauncher." << std::endl;
+  abort_handler(-1);
+}
+
+
+/** Completions are reaped after a SIGCHLD, which arrives through a
+    pipe so that poll() watches requests and completions together.  A
+    child's LAUNCHED reply always precedes its EXITED reply, since
+    children are only reaped between requests. */
+void ProcessLauncher::serve(int sock)
+{
+  int child_pipe[2];
+  if (pipe(child_pipe))
+    _exit(1);
+  set_descriptor_flags(child_pipe[0], true);
+  set_descriptor_flags(child_pipe[1], true);
+  childPipeWrite = child_pipe[1];
+
+  struct sigaction action;
+  std::memset(&action, 0, sizeof(action));
+  action.sa_handler = child_signal_handler;
+  sigemptyset(&action.sa_mask);
+  action.sa_flags = SA_RESTART | SA_NOCLDSTOP;
+  sigaction(SIGCHLD, &action, NULL);
+  sigset_t child_set;
+  sigemptyset(&child_set);  sigaddset(&child_set, SIGCHLD);
+  sigprocmask(SIG_UNBLOCK, &child_set, NULL);
+
+  std::vector<int32_t> arg_counts;
+  std::vector<char> strings;
+  struct pollfd fds[2] = { { sock, POLLIN, 0 }, { child_pipe[0], POLLIN, 0 } };
+  for (;;) {
+    if (poll(fds, 2, -1) < 0) {
+      if (errno == EINTR) continue;
+      break;
+    }
+
+    if (fds[1].revents & POLLIN) {
+      char drain[64];
+      while (read(child_pipe[0], drain, sizeof(drain)) > 0)
+	;
+      LaunchReply reply = { EXITED, 0, 0 };
+      int status;  pid_t pid;
+      bool sent = true;
+      while ((pid = waitpid(-1, &status, WNOHANG)) > 0 && sent) {
+	reply.pid = pid;  reply.value = status;
+	sent = write_fully(sock, &reply, sizeof(reply));
+      }
+      if (!sent)
+	break;
+    }
+
+    if (fds[0].revents & (POLLIN | POLLHUP | POLLERR)) {
+      LaunchRequest request;
+      if (!read_fully(sock, &request, sizeof(request)))
+	break; // closed by Dakota
+      arg_counts.resize(request.numCommands);
+      strings.resize(request.numBytes);
+      if (!read_fully(sock, arg_counts.data(),
+		      arg_counts.size() * sizeof(int32_t)) ||
+	  !read_fully(sock, strings.data(), strings.size()))
+	break;
+      LaunchReply reply = { LAUNCHED, 0, 0 };
+      int error = 0;
+      reply.pid = spawn_request(request, arg_counts, strings, error);
+      reply.value = error;
+      if (!write_fully(sock, &reply, sizeof(reply)))
+	break;
+    }
+  }
+  _exit(0);
+}
+
+} // namespace Dakota
@@ -0,0 +1,129 @@
+/*  _______________________________________________________________________
+
+    Dakota: Explore and predict with confidence.
+    Copyright 2014-2023
+    National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Dakota directory.
+    _______________________________________________________________________ */
+
+#ifndef PROCESS_LAUNCHER_H
+#define PROCESS_LAUNCHER_H
+
+#include "dakota_data_types.hpp"
+
+#include <sys/types.h>
+#include <map>
+#include <memory>
+
+namespace Dakota {
+
+/// Persistent helper process that launches analysis programs
+
+/** The launcher forks a small daemon once, typically before the Dakota
+    process has grown, and then has the daemon start each program with
+    posix_spawn().  start() remains a single fork of the Dakota process,
+    which may already be MPI-initialized when the first fork interface
+    calls instance(); later launches neither copy the page tables of a
+    large Dakota process (fork) nor suspend it (vfork).  Requests travel
+    over a Unix socket pair and carry the working directory and
+    environment of the caller at the time of the launch.  A request
+    names either a single program or a sequence of programs run one
+    after another (input filter, analysis drivers, output filter), for
+    which the daemon forks a small helper.  The daemon reaps its
+    children and reports every waitpid() status, so callers see the same
+    (pid, status) pairs as when waiting on their own children.  The
+    daemon exits when its socket is closed. */
+class ProcessLauncher
+{
+public:
+
+  //
+  //- Heading: Constructors and destructor
+  //
+
+  /// default constructor (the daemon is not started)
+  ProcessLauncher();
+  /// destructor: stops the daemon
+  ~ProcessLauncher();
+
+  //
+  //- Heading: Member functions
+  //
+
+  /// launcher shared by the interfaces of this process, started on
+  /// first use; empty if the daemon could not be started
+  static std::shared_ptr<ProcessLauncher> instance();
+
+  /// fork the daemon; returns false if it could not be started
+  bool start();
+  /// close the socket and, if owned by this process, reap the daemon
+  void stop();
+  /// whether the daemon is running and owned by this process (false
+  /// in children forked from the owner)
+  bool active() const;
+
+  /// start argv[0] with arguments argv in the current working directory
+  /// and environment; returns the process id, or -1 with errno set
+  pid_t launch(const StringArray& argv);
+  /// start a sequence of programs that run one after another, ending at
+  /// the first one that terminates abnormally or with status -1; the
+  /// sequence then exits with status -1, otherwise with 0
+  pid_t launch(const std::vector<StringArray>& commands);
+
+  /// block for the completion of process pid and return its status
+  int wait(pid_t pid);
+  /// block (block_flag) or test for the completion of any process in
+  /// the keys of process_id_map; returns its pid with status set, or 0
+  /// if none has completed when not blocking
+  pid_t wait(const std::map<pid_t, int>& process_id_map, bool block_flag,
+	     int& status);
+
+private:
+
+  //
+  //- Heading: Convenience functions
+  //
+
+  /// request loop of the daemon on socket sock; does not return
+  static void serve(int sock);
+
+  /// read the next reply from the daemon, blocking if block_flag;
+  /// returns false if none is available when not blocking
+  bool receive(bool block_flag, int& type, pid_t& pid, int& value);
+  /// record a completion that is not yet claimed by a wait
+  void store_exit(pid_t pid, int status);
+  /// abort after losing the connection to the daemon
+  void lost_daemon() const;
+
+  //
+  //- Heading: Data
+  //
+
+  /// Dakota's end of the socket pair (-1 if not started)
+  int socketFd;
+  /// process id of the daemon
+  pid_t daemonPid;
+  /// process that started the daemon and may exchange messages with it
+  pid_t ownerPid;
+
+  /// wait statuses reported by the daemon and not yet claimed, by pid
+  std::map<pid_t, int> exitedProcesses;
+};
+
+
+inline ProcessLauncher::ProcessLauncher():
+  socketFd(-1), daemonPid(0), ownerPid(0)
+{ }
+
+
+inline ProcessLauncher::~ProcessLauncher()
+{ stop(); }
+
+
+inline pid_t ProcessLauncher::launch(const StringArray& argv)
+{ return launch(std::vector<StringArray>(1, argv)); }
+
+} // namespace Dakota
+
+#endif // PROCESS_LAUNCHER_H
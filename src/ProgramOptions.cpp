@@ -27,6 +27,8 @@ namespace Dakota {
 ProgramOptions::ProgramOptions():
   worldRank(0),
   echoInput(true), preprocInput(false), stopRestartEvals(0),
+  writeRestartIndexed(false), writeRestartCommit(RESTART_COMMIT_EVERY_EVAL),
+  writeRestartInterval(0), writeRestartFsync(false),
   helpFlag(false), versionFlag(false), checkFlag(false), 
   preRunFlag(false), runFlag(false), postRunFlag(false), userModesFlag(false),
   preRunOutputFormat(TABULAR_ANNOTATED), postRunInputFormat(TABULAR_ANNOTATED)
@@ -39,6 +41,8 @@ ProgramOptions::ProgramOptions():
 ProgramOptions::ProgramOptions(int world_rank):
   worldRank(world_rank),
   echoInput(true), preprocInput(false), stopRestartEvals(0),
+  writeRestartIndexed(false), writeRestartCommit(RESTART_COMMIT_EVERY_EVAL),
+  writeRestartInterval(0), writeRestartFsync(false),
   helpFlag(false), versionFlag(false), checkFlag(false), 
   preRunFlag(false), runFlag(false), postRunFlag(false), userModesFlag(false),
   preRunOutputFormat(TABULAR_ANNOTATED), postRunInputFormat(TABULAR_ANNOTATED)
@@ -51,6 +55,8 @@ ProgramOptions::ProgramOptions(int world_rank):
 ProgramOptions::ProgramOptions(int argc, char* argv[], int world_rank):
   worldRank(world_rank),
   echoInput(true), preprocInput(false), stopRestartEvals(0),
+  writeRestartIndexed(false), writeRestartCommit(RESTART_COMMIT_EVERY_EVAL),
+  writeRestartInterval(0), writeRestartFsync(false),
   helpFlag(false), versionFlag(false), checkFlag(false), 
   preRunFlag(false), runFlag(false), postRunFlag(false), userModesFlag(false),
   preRunOutputFormat(TABULAR_ANNOTATED), postRunInputFormat(TABULAR_ANNOTATED)
@@ -148,6 +154,18 @@ size_t ProgramOptions::stop_restart_evals() const
 String ProgramOptions::write_restart_file() const
 { return writeRestartFile.empty() ? "dakota.rst" : writeRestartFile; }
 
+bool ProgramOptions::write_restart_indexed() const
+{ return writeRestartIndexed; }
+
+unsigned short ProgramOptions::write_restart_commit() const
+{ return writeRestartCommit; }
+
+int ProgramOptions::write_restart_interval() const
+{ return writeRestartInterval; }
+
+bool ProgramOptions::write_restart_fsync() const
+{ return writeRestartFsync; }
+
 
 bool ProgramOptions::help() const
 { return helpFlag; }
@@ -280,6 +298,16 @@ void ProgramOptions::stop_restart_evals(size_t stop_rst)
 void ProgramOptions::write_restart_file(const String& write_rst)
 { writeRestartFile = write_rst; }
 
+void ProgramOptions::write_restart_indexed(bool indexed_rst)
+{ writeRestartIndexed = indexed_rst; }
+
+void ProgramOptions::
+write_restart_commit(unsigned short commit_policy, int commit_interval)
+{ writeRestartCommit = commit_policy; writeRestartInterval = commit_interval; }
+
+void ProgramOptions::write_restart_fsync(bool fsync_rst)
+{ writeRestartFsync = fsync_rst; }
+
 
 void ProgramOptions::help(bool help_flag)
 { helpFlag = help_flag; }
@@ -343,6 +371,24 @@ void ProgramOptions::parse(const ProblemDescDB& problem_db)
   }
 
   set_option(problem_db, "write_restart", writeRestartFile);
+  // only override if non-default, no need to warn
+  if (problem_db.get_bool("environment.write_restart_indexed"))
+    writeRestartIndexed = true;
+  // commit intervals imply their policy; only override if non-default
+  int commit_evals
+    = problem_db.get_int("environment.write_restart_commit_evaluations");
+  int commit_secs
+    = problem_db.get_int("environment.write_restart_commit_seconds");
+  unsigned short commit_policy
+    = problem_db.get_ushort("environment.write_restart_commit");
+  if (commit_evals > 0)
+    write_restart_commit(RESTART_COMMIT_EVALS, commit_evals);
+  else if (commit_secs > 0)
+    write_restart_commit(RESTART_COMMIT_SECONDS, commit_secs);
+  else if (commit_policy != RESTART_COMMIT_EVERY_EVAL)
+    write_restart_commit(commit_policy);
+  if (problem_db.get_bool("environment.write_restart_fsync"))
+    writeRestartFsync = true;
 
   // only override if non-default, no need to warn
   const bool& check_flag = problem_db.get_bool("environment.check");
@@ -395,7 +441,9 @@ void ProgramOptions::read(MPIUnpackBuffer& s)
   // core files and options
   s >> inputFile >> inputString >> echoInput >> parserOptions 
     >> outputFile >> errorFile 
-    >> readRestartFile >> stopRestartEvals >> writeRestartFile;
+    >> readRestartFile >> stopRestartEvals >> writeRestartFile
+    >> writeRestartIndexed >> writeRestartCommit >> writeRestartInterval
+    >> writeRestartFsync;
   // run mode controls
   s >> helpFlag >> versionFlag >> checkFlag >> preRunFlag >> runFlag 
     >> postRunFlag >> userModesFlag;
@@ -412,7 +460,9 @@ void ProgramOptions::write(MPIPackBuffer& s) const
   // core files and options
   s << inputFile << inputString << echoInput << parserOptions 
     << outputFile << errorFile 
-    << readRestartFile << stopRestartEvals << writeRestartFile;
+    << readRestartFile << stopRestartEvals << writeRestartFile
+    << writeRestartIndexed << writeRestartCommit << writeRestartInterval
+    << writeRestartFsync;
   // run mode controls
   s << helpFlag << versionFlag << checkFlag << preRunFlag << runFlag 
     << postRunFlag << userModesFlag;
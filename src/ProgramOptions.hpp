@@ -79,6 +79,14 @@ public:
   size_t stop_restart_evals() const;
   /// write retart (user-provided or default) file base name (no tag)
   String write_restart_file() const;
+  /// whether to write the restart file in the indexed format
+  bool write_restart_indexed() const;
+  /// policy for committing restart records (RESTART_COMMIT_*)
+  unsigned short write_restart_commit() const;
+  /// evaluations or seconds between restart commits, per the policy
+  int write_restart_interval() const;
+  /// whether restart commits synchronize the file to disk
+  bool write_restart_fsync() const;
 
   /// is help mode active?
   bool help() const;
@@ -156,6 +164,13 @@ public:
   void stop_restart_evals(size_t stop_rst);
   /// set base file name for restart file to write
   void write_restart_file(const String& write_rst);
+  /// set whether to write the restart file in the indexed format
+  void write_restart_indexed(bool indexed_rst);
+  /// set the policy and interval for committing restart records
+  void write_restart_commit(unsigned short commit_policy,
+			    int commit_interval = 0);
+  /// set whether restart commits synchronize the file to disk
+  void write_restart_fsync(bool fsync_rst);
 
   /// set true to print help information and exit
   void help(bool help_flag);
@@ -241,6 +256,10 @@ private:
   String readRestartFile;    ///< e.g., "dakota.old.rst"
   size_t stopRestartEvals;   ///< eval number at which to stop restart read
   String writeRestartFile;   ///< e.g., "dakota.new.rst"
+  bool writeRestartIndexed;  ///< write restart in the indexed format
+  unsigned short writeRestartCommit; ///< restart commit policy
+  int writeRestartInterval;  ///< evaluations/seconds between restart commits
+  bool writeRestartFsync;    ///< fsync the restart file on commit
 
   // Run mode flags; intially only valid on rank 0.
   // Could condense flags into a bit-wise short, but using bool for
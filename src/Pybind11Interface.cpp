@@ -22,6 +22,7 @@ namespace Dakota {
 Pybind11Interface::Pybind11Interface(const ProblemDescDB& problem_db)
   : DirectApplicInterface(problem_db),
     userNumpyFlag(problem_db.get_bool("interface.python.numpy")),
+    columnarFlag(problem_db.get_bool("interface.python.columnar")),
     ownPython(false),
     py11Active(false)
 {
@@ -60,6 +61,19 @@ Pybind11Interface::Pybind11Interface(const ProblemDescDB& problem_db)
     abort_handler(-1);
 #endif
   }
+  if (columnarFlag) {
+#ifndef DAKOTA_PYTHON_NUMPY
+    Cerr << "\nError: Direct Python interface 'columnar' option requested, "
+	 << "but Dakota was not built with numpy support enabled."
+         << std::endl;
+    abort_handler(-1);
+#endif
+    if (!batchEval) {
+      Cerr << "\nError: interface > python > columnar requires the batch "
+	   << "option.\n";
+      abort_handler(INTERFACE_ERROR);
+    }
+  }
 
   // prepend sys.path (env PYTHONPATH) with empty string to find module in pwd
   // This assumes any directory changing in the driver is reversed
@@ -126,6 +140,11 @@ void Pybind11Interface::wait_local_evaluations(PRPQueue& prp_queue)
 
   initialize_driver(analysisDrivers[0]);
 
+  if (columnarFlag) {
+    columnar_batch_evaluations(prp_queue);
+    return;
+  }
+
   // in this case the user's python function is to be called with
   // list<dict>, one list entry per eval
 
@@ -161,6 +180,192 @@ void Pybind11Interface::test_local_evaluations(PRPQueue& prp_queue)
 }
 
 
+/** The user's python function is called once with a dict of NumPy
+    arrays holding a row per evaluation and returns a dict of arrays
+    with a row per evaluation.  This avoids the per-evaluation dict
+    construction and unpacking of the list-of-dicts convention. */
+void Pybind11Interface::columnar_batch_evaluations(PRPQueue& prp_queue)
+{
+  if (prp_queue.empty())
+    return;
+
+  py::dict py_response = py11CallBack(columnar_params_to_dict(prp_queue));
+  unpack_columnar_response(py_response, prp_queue);
+
+  for (const auto& prp : prp_queue)
+    completionSet.insert(prp.eval_id());
+}
+
+
+py::dict Pybind11Interface::columnar_params_to_dict(const PRPQueue& prp_queue)
+{
+  // labels, counts and DVV are shared by the batch: take them from the
+  // first evaluation
+  const ParamResponsePair& first = *prp_queue.begin();
+  set_local_data(first.variables(), first.active_set(), first.response());
+
+  const size_t num_evals = prp_queue.size(), num_cv = numACV,
+    num_div = numADIV, num_dsv = numADSV, num_drv = numADRV;
+  const SizetArray dvv = directFnDVV;
+
+  py::array_t<double> cv({num_evals, num_cv}), drv({num_evals, num_drv});
+  py::array_t<int> div({num_evals, num_div}), asv({num_evals, numFns}),
+    eval_ids(static_cast<py::ssize_t>(num_evals));
+  py::list dsv;
+  double *cv_row = cv.mutable_data(), *drv_row = drv.mutable_data();
+  int *div_row = div.mutable_data(), *asv_row = asv.mutable_data(),
+    *id = eval_ids.mutable_data();
+  size_t i;
+  for (const auto& prp : prp_queue) {
+    const Variables& vars = prp.variables();
+    const ActiveSet& set = prp.active_set();
+    if (vars.acv() != num_cv || vars.adiv() != num_div ||
+	vars.adsv() != num_dsv || vars.adrv() != num_drv ||
+	set.request_vector().size() != numFns ||
+	set.derivative_vector() != dvv) {
+      Cerr << "\nError: interface > python > columnar requires the "
+	   << "evaluations in a batch\nto share their variables and "
+	   << "derivative variables.\n";
+      abort_handler(INTERFACE_ERROR);
+    }
+
+    const RealVector& acv  = vars.all_continuous_variables();
+    const IntVector&  adiv = vars.all_discrete_int_variables();
+    const RealVector& adrv = vars.all_discrete_real_variables();
+    StringMultiArrayConstView adsv = vars.all_discrete_string_variables();
+    const ShortArray& eval_asv = set.request_vector();
+    for (i=0; i<num_cv;  ++i) *cv_row++  = acv[i];
+    for (i=0; i<num_div; ++i) *div_row++ = adiv[i];
+    for (i=0; i<num_drv; ++i) *drv_row++ = adrv[i];
+    for (i=0; i<numFns;  ++i) *asv_row++ = eval_asv[i];
+    py::list dsv_row;
+    for (i=0; i<num_dsv; ++i)
+      dsv_row.append(adsv[i]);
+    dsv.append(dsv_row);
+    *id++ = prp.eval_id();
+  }
+
+  py::list all_var_labels = copy_array_to_pybind11<py::list,StringArray,String>(xAllLabels);
+  py::list cv_labels  = copy_array_to_pybind11<py::list,StringMultiArray,String>(xCLabels);
+  py::list div_labels = copy_array_to_pybind11<py::list,StringMultiArray,String>(xDILabels);
+  py::list dsv_labels = copy_array_to_pybind11<py::list,StringMultiArray,String>(xDSLabels);
+  py::list drv_labels = copy_array_to_pybind11<py::list,StringMultiArray,String>(xDRLabels);
+  py::array dvv_array = copy_array_to_pybind11<py::array,SizetArray,size_t>(dvv);
+  py::list an_comps   = (analysisComponents.size() > 0)
+                      ? copy_array_to_pybind11<py::list,StringArray,String>(analysisComponents[analysisDriverIndex])
+                      : py::list();
+  py::list fn_labels  = copy_array_to_pybind11<py::list,StringArray,String>(fnLabels);
+  py::list md_labels  = copy_array_to_pybind11<py::list,StringArray,String>(metaDataLabels);
+
+  return py::dict(
+      "batch_size"_a            = num_evals,
+      "variables"_a             = numVars,
+      "functions"_a             = numFns,
+      "metadata"_a              = metaData.size(),
+      "variable_labels"_a       = all_var_labels,
+      "function_labels"_a       = fn_labels,
+      "metadata_labels"_a       = md_labels,
+      "cv"_a                    = cv,
+      "cv_labels"_a             = cv_labels,
+      "div"_a                   = div,
+      "div_labels"_a            = div_labels,
+      "dsv"_a                   = dsv,
+      "dsv_labels"_a            = dsv_labels,
+      "drv"_a                   = drv,
+      "drv_labels"_a            = drv_labels,
+      "asv"_a                   = asv,
+      "dvv"_a                   = dvv_array,
+      "analysis_components"_a   = an_comps,
+      "eval_ids"_a              = eval_ids);
+}
+
+
+namespace {
+
+typedef py::array_t<double, py::array::c_style | py::array::forcecast>
+  ColumnarArray;
+
+/// extract py_response[key] as a C-contiguous float64 array of the given
+/// shape; arrays already in this form are used in place
+ColumnarArray columnar_array(const py::dict& py_response, const char* key,
+			     const std::vector<size_t>& shape)
+{
+  if (!py_response.contains(key))
+    throw(std::runtime_error(std::string("Pybind11 Direct Interface: "
+      "required key [\"") + key + "\"] absent in dict returned to Dakota"));
+  ColumnarArray array = ColumnarArray::ensure(py_response[key]);
+  bool shape_ok = array && (size_t)array.ndim() == shape.size();
+  for (size_t d=0; shape_ok && d<shape.size(); ++d)
+    shape_ok = ((size_t)array.shape(d) == shape[d]);
+  if (!shape_ok) {
+    std::string expected("(");
+    for (size_t d=0; d<shape.size(); ++d)
+      expected += (d ? ", " : "") + std::to_string(shape[d]);
+    throw(std::runtime_error(std::string("Pybind11 Direct Interface [\"") +
+      key + "\"]: expected an array of shape " + expected + ")"));
+  }
+  return array;
+}
+
+} // anonymous namespace
+
+
+void Pybind11Interface::unpack_columnar_response(const py::dict& py_response,
+						 PRPQueue& prp_queue)
+{
+  const size_t num_evals = prp_queue.size(), num_fns = numFns,
+    num_derivs = directFnDVV.size(), num_md = metaData.size();
+  bool values = false, grads = false, hessians = false;
+  for (const auto& prp : prp_queue) {
+    const ShortArray& asv = prp.active_set().request_vector();
+    values   |= expect_derivative(asv, 1);
+    grads    |= expect_derivative(asv, 2);
+    hessians |= expect_derivative(asv, 4);
+  }
+
+  ColumnarArray fns, fn_grads, fn_hessians, md;
+  if (values)
+    fns = columnar_array(py_response, "fns", {num_evals, num_fns});
+  if (grads)
+    fn_grads = columnar_array(py_response, "fnGrads",
+			      {num_evals, num_fns, num_derivs});
+  if (hessians)
+    fn_hessians = columnar_array(py_response, "fnHessians",
+				 {num_evals, num_fns, num_derivs, num_derivs});
+  if (num_md)
+    md = columnar_array(py_response, "metadata", {num_evals, num_md});
+
+  // copy only the active entries, directly into the (shared) Responses
+  size_t e = 0, i, j, k;
+  for (auto& prp : prp_queue) {
+    Response resp = prp.response();
+    const ShortArray& asv = prp.active_set().request_vector();
+    for (i=0; i<num_fns; ++i) {
+      if (asv[i] & 1)
+	resp.function_value_view(i) = fns.data()[e*num_fns + i];
+      if (asv[i] & 2) {
+	const double* src = fn_grads.data() + (e*num_fns + i)*num_derivs;
+	RealVector grad = resp.function_gradient_view(i);
+	std::copy(src, src + num_derivs, grad.values());
+      }
+      if (asv[i] & 4) {
+	const double* src
+	  = fn_hessians.data() + (e*num_fns + i)*num_derivs*num_derivs;
+	RealSymMatrix hess = resp.function_hessian_view(i);
+	for (j=0; j<num_derivs; ++j)
+	  for (k=0; k<=j; ++k)
+	    hess(j,k) = src[j*num_derivs + k];
+      }
+    }
+    if (num_md) {
+      const double* src = md.data() + e*num_md;
+      resp.metadata(std::vector<RespMetadataT>(src, src + num_md));
+    }
+    ++e;
+  }
+}
+
+
 void Pybind11Interface::initialize_driver(const String& ac_name)
 {
   // If a python callback has not yet been registered (eg via
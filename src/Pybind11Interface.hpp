@@ -65,6 +65,9 @@ class Pybind11Interface: public DirectApplicInterface
 
     /// whether the user requested numpy data structures in the input file
     bool userNumpyFlag;
+    /// whether batches are exchanged as one dict of NumPy arrays with a
+    /// row per evaluation (columnar) instead of a list of dicts
+    bool columnarFlag;
     /// true if this class created the interpreter instance
     bool ownPython;
     /// callback function for analysis driver
@@ -96,6 +99,19 @@ class Pybind11Interface: public DirectApplicInterface
      RealMatrix& gradients, RealSymMatrixArray& hessians,
      RealArray& metadata);
 
+    /// evaluate the batch in prp_queue with a single call exchanging
+    /// NumPy arrays with a row per evaluation
+    void columnar_batch_evaluations(PRPQueue& prp_queue);
+
+    /// pack the variables and active sets of prp_queue into the columnar
+    /// batch dictionary
+    py::dict columnar_params_to_dict(const PRPQueue& prp_queue);
+
+    /// write the columnar batch response arrays directly into the
+    /// Responses of prp_queue
+    void unpack_columnar_response(const py::dict& py_response,
+				  PRPQueue& prp_queue);
+
     /// return true if the passed asv value is requested for any function
     bool expect_derivative(const ShortArray& asv, const short deriv_type) const;
 };
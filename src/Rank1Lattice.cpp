@@ -425,21 +425,36 @@ void Rank1Lattice::random_shift(
 /// This function will store the points in-place in the matrix `points`
 /// Each column of `points` contains a `dimension`-dimensional point
 /// where `dimension` is equal to the number of rows of `points`
+/// NOTE: the lattice points are independent of each other, so they are
+/// generated in blocks of consecutive indices, one block per thread
 void Rank1Lattice::unsafe_get_points(
   const size_t nMin,
   const size_t nMax, 
   RealMatrix& points
 )
 {
-  for ( UInt32 k = nMin; k < nMax; ++k ) /// Loop over all points
-  {
-    Real phik = (this->*reorder)(k) * scale; /// phi(k)
-    for ( int j = 0; j < points.numRows(); ++j ) /// Loop over all dimensions
+  /// Convert the generating vector once, so that the loop over dimensions
+  /// only reads contiguous arrays of reals
+  int dimension = points.numRows();
+  std::vector<Real> z(generatingVector.values(),
+    generatingVector.values() + dimension);
+  const Real* shift = randomShift.values();
+
+  generate_in_parallel(nMin, nMax, dimension,
+    [&](size_t first, size_t last)
     {
-      Real point = phik * generatingVector[j] + randomShift[j];
-      points[k - nMin][j] = point - std::floor(point); /// Map to [0, 1)
+      for ( UInt32 k = first; k < last; ++k ) /// Loop over all points
+      {
+        Real phik = (this->*reorder)(k) * scale; /// phi(k)
+        Real* point = points[k - nMin];
+        for ( int j = 0; j < dimension; ++j ) /// Loop over all dimensions
+        {
+          Real x = phik * z[j] + shift[j];
+          point[j] = x - std::floor(x); /// Map to [0, 1)
+        }
+      }
     }
-  }
+  );
 }
 
 /// Position of the `k`th lattice point in RANK_1_LATTICE_NATURAL_ORDERING
@@ -38,9 +38,16 @@ public:
   /// version number when putting version in a file.
   /** Increment this to increment the actual restart version when one
       or more underlying (or this RestartVersion) class version
-      changes. This is also the version of this class for Boost
-      purposes. Dakota 6.17.0 ==> versionDelta = 1 */
-  static const unsigned int latestRestartVersionDelta = 1;
+      changes. Dakota 6.17.0 ==> versionDelta = 1; indexed restart
+      format ==> versionDelta = 2 */
+  static const unsigned int latestRestartVersionDelta = 2;
+
+  /// restart version delta of the sequential format (a stream of
+  /// ParamResponsePairs following the RestartVersion)
+  static const unsigned int sequentialRestartVersionDelta = 1;
+  /// restart version delta of the indexed format (independently
+  /// serialized records followed by an index; see IndexedRestart)
+  static const unsigned int indexedRestartVersionDelta = 2;
 
   /// The latest restart version (that supported by the current source code)
   static const unsigned int latestRestartVersion =
@@ -54,10 +61,12 @@ public:
   /// default ctor used for reading a RestartVersion
   RestartVersion() { /* empty ctor */ };
 
-  /// constructor used for emitting restart version information to file
+  /// constructor used for emitting restart version information to
+  /// file; the version delta selects the sequential or indexed format
   RestartVersion(const std::string& dakota_release_ver,
-		 const std::string& dakota_release_sha1):
-    restartVersion(latestRestartVersion),
+		 const std::string& dakota_release_sha1,
+		 unsigned int version_delta = sequentialRestartVersionDelta):
+    restartVersion(restartFirstVersionNumber + version_delta),
     dakotaRelease(dakota_release_ver), dakotaSHA1(dakota_release_sha1)
   { /* empty ctor */ }
 	
@@ -68,6 +77,10 @@ public:
       restartVersion - restartFirstVersionNumber;
   }
 
+  /// whether *this describes a file in the indexed restart format
+  bool indexed_format() const
+  { return friendly_rst_version() == indexedRestartVersionDelta; }
+
   /// check the read rst_filename's version and issue diagnostic info
   /// vs. current Dakota version
   static RestartVersion check_restart_version(const std::string& rst_filename);
@@ -117,7 +130,9 @@ operator<<(std::ostream& os, const Dakota::RestartVersion& rst_ver)
 }
 
 
+// The serialized layout of RestartVersion is unchanged by the indexed
+// format, so retain the class version that prior releases can read
 BOOST_CLASS_VERSION(Dakota::RestartVersion,
-		    Dakota::RestartVersion::latestRestartVersionDelta)
+		    Dakota::RestartVersion::sequentialRestartVersionDelta)
 
 #endif
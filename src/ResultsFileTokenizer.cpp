@@ -0,0 +1,111 @@
+/*  _______________________________________________________________________
+
+    Dakota: Explore and predict with confidence.
+    Copyright 2014-2023
+    National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Dakota directory.
+    _______________________________________________________________________ */
+
+#include "ResultsFileTokenizer.hpp"
+
+#include <cctype>
+#include <cstdlib>
+#include <iterator>
+
+
+namespace Dakota {
+
+namespace {
+
+/// case-insensitive comparison of [b, b+len) to the lower case word
+bool equals_nocase(const char* b, size_t len, const char* word)
+{
+  size_t i = 0;
+  for ( ; i<len && word[i] != '\0'; ++i)
+    if (std::tolower(static_cast<unsigned char>(b[i])) != word[i])
+      return false;
+  return (i == len && word[i] == '\0');
+}
+
+inline bool is_digit(char c)
+{ return c >= '0' && c <= '9'; }
+
+} // anonymous namespace
+
+
+/** Hand-coded equivalent of the isfloat() regular expression
+      [+-]?[0-9]*\.?[0-9]+\.?[0-9]*[eEdD]?[+-]?[0-9]* | nan | [+-]?inf(inity)?
+    (case-insensitive words).  The mantissa is the maximal run of digits
+    and dots: with no dot it needs a digit, with one dot a digit on
+    either side, and with two dots a digit between them.  The optional
+    exponent marker, sign and digits may then follow independently. */
+bool ResultsFileTokenizer::is_float(const ResultsToken& token)
+{
+  const char *p = token.first, *e = token.first + token.length;
+  if (p == e)
+    return false;
+  if (equals_nocase(p, token.length, "nan"))
+    return true;
+
+  if (*p == '+' || *p == '-')
+    ++p;
+  size_t rem = e - p;
+  if (equals_nocase(p, rem, "inf") || equals_nocase(p, rem, "infinity"))
+    return true;
+
+  // mantissa: count digits before, between and after up to two dots
+  size_t digits[3] = {0, 0, 0}, num_dots = 0;
+  for ( ; p != e; ++p) {
+    if (is_digit(*p))
+      ++digits[num_dots];
+    else if (*p == '.' && num_dots < 2)
+      ++num_dots;
+    else
+      break;
+  }
+  switch (num_dots) {
+  case 0:  if (!digits[0])               return false; break;
+  case 1:  if (!digits[0] && !digits[1]) return false; break;
+  default: if (!digits[1])               return false; break;
+  }
+
+  // exponent: [eEdD]?[+-]?[0-9]*
+  if (p != e && (*p == 'e' || *p == 'E' || *p == 'd' || *p == 'D'))
+    ++p;
+  if (p != e && (*p == '+' || *p == '-'))
+    ++p;
+  while (p != e && is_digit(*p))
+    ++p;
+  return p == e;
+}
+
+
+/** Tokens end at whitespace or at the NUL terminating the buffer, both
+    of which stop std::strtod(), so the conversion never extends past
+    the token and matches std::atof() of the token as a string. */
+Real ResultsFileTokenizer::to_real(const ResultsToken& token)
+{ return (token.empty()) ? 0. : std::strtod(token.first, NULL); }
+
+
+void ResultsFileTokenizer::slurp(std::istream& s, String& buffer)
+{
+  buffer.clear();
+  // size the buffer in one step when the stream is seekable
+  std::istream::pos_type start = s.tellg();
+  if (start != std::istream::pos_type(-1)) {
+    s.seekg(0, std::ios::end);
+    std::istream::pos_type end = s.tellg();
+    s.seekg(start);
+    if (end != std::istream::pos_type(-1) && end > start) {
+      buffer.resize(static_cast<size_t>(end - start));
+      s.read(&buffer[0], buffer.size());
+      buffer.resize(static_cast<size_t>(s.gcount()));
+      return;
+    }
+  }
+  buffer.assign(std::istreambuf_iterator<char>(s),
+		std::istreambuf_iterator<char>());
+}
+
+} // namespace Dakota
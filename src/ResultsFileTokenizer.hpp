@@ -0,0 +1,177 @@
+/*  _______________________________________________________________________
+
+    Dakota: Explore and predict with confidence.
+    Copyright 2014-2023
+    National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Dakota directory.
+    _______________________________________________________________________ */
+
+#ifndef RESULTS_FILE_TOKENIZER_H
+#define RESULTS_FILE_TOKENIZER_H
+
+#include "dakota_data_types.hpp"
+
+#include <cstring>
+#include <istream>
+
+namespace Dakota {
+
+/// Non-owning view of a whitespace-delimited token within a results buffer
+struct ResultsToken
+{
+  /// default constructor: empty token
+  ResultsToken(): first(NULL), length(0) { }
+  /// constructor from a character range
+  ResultsToken(const char* b, size_t len): first(b), length(len) { }
+
+  /// whether the token is empty (end of buffer reached)
+  bool empty() const { return length == 0; }
+  /// first character of the token; '\0' when empty
+  char front() const { return length ? *first : '\0'; }
+  /// whether the token equals str
+  bool equals(const String& str) const
+  { return str.size() == length && std::memcmp(str.data(), first, length) == 0; }
+  /// copy into a String (for error reporting only)
+  String str() const { return String(first, length); }
+
+  /// start of the token
+  const char* first;
+  /// number of characters in the token
+  size_t length;
+};
+
+
+/// Cursor over an in-memory results file
+
+/** Tokenizes a NUL-terminated buffer holding the results file content
+    without copying: tokens are views into the buffer and values are
+    converted in place, so that parsing allocates nothing per token.
+    The member functions mirror the std::istream extractions previously
+    used by the Response readers (operator>> into a std::string or a
+    char, tellg/seekg, ignore), which preserves the grammar of the
+    results file and the errors reported for malformed files. */
+class ResultsFileTokenizer
+{
+public:
+
+  //
+  //- Heading: Constructors and destructor
+  //
+
+  /// constructor over the buffer [b, e); *e must be '\0'
+  ResultsFileTokenizer(const char* b, const char* e);
+  /// constructor over the content of buffer
+  ResultsFileTokenizer(const String& buffer);
+
+  //
+  //- Heading: Member functions
+  //
+
+  /// extract the next whitespace-delimited token (empty at end of buffer)
+  ResultsToken next_token();
+  /// extract the next non-whitespace character ('\0' at end of buffer)
+  char next_char();
+  /// extract the next token and convert it as std::atof() would
+  Real next_real();
+
+  /// current offset into the buffer
+  size_t tell() const;
+  /// move to an offset previously returned by tell()
+  void seek(size_t pos);
+
+  /// advance to (but not past) the next occurrence of delim, or to the end
+  void skip_to(char delim);
+
+  /// advance past leading whitespace
+  void skip_whitespace();
+  /// whether the remaining buffer holds only whitespace
+  bool at_end();
+
+  /// match a token against the floating point syntax accepted by
+  /// results files (equivalent to isfloat() without its allocations)
+  static bool is_float(const ResultsToken& token);
+  /// convert a token already known to begin a number
+  static Real to_real(const ResultsToken& token);
+
+  /// read the remainder of s into buffer in a single bulk transfer
+  static void slurp(std::istream& s, String& buffer);
+
+private:
+
+  /// whitespace as classified by operator>> in the "C" locale
+  static bool is_space(char c);
+
+  //
+  //- Heading: Data
+  //
+
+  /// start of the buffer
+  const char* bufferBegin;
+  /// end of the buffer
+  const char* bufferEnd;
+  /// current position
+  const char* cursor;
+};
+
+
+inline ResultsFileTokenizer::ResultsFileTokenizer(const char* b, const char* e):
+  bufferBegin(b), bufferEnd(e), cursor(b)
+{ }
+
+
+inline ResultsFileTokenizer::ResultsFileTokenizer(const String& buffer):
+  bufferBegin(buffer.c_str()), bufferEnd(buffer.c_str() + buffer.size()),
+  cursor(buffer.c_str())
+{ }
+
+
+inline bool ResultsFileTokenizer::is_space(char c)
+{ return c == ' ' || (c >= '\t' && c <= '\r'); }
+
+
+inline void ResultsFileTokenizer::skip_whitespace()
+{ while (cursor != bufferEnd && is_space(*cursor)) ++cursor; }
+
+
+inline bool ResultsFileTokenizer::at_end()
+{ skip_whitespace(); return cursor == bufferEnd; }
+
+
+inline ResultsToken ResultsFileTokenizer::next_token()
+{
+  skip_whitespace();
+  const char* b = cursor;
+  while (cursor != bufferEnd && !is_space(*cursor)) ++cursor;
+  return ResultsToken(b, cursor - b);
+}
+
+
+inline char ResultsFileTokenizer::next_char()
+{
+  skip_whitespace();
+  return (cursor == bufferEnd) ? '\0' : *cursor++;
+}
+
+
+inline Real ResultsFileTokenizer::next_real()
+{ return to_real(next_token()); }
+
+
+inline size_t ResultsFileTokenizer::tell() const
+{ return cursor - bufferBegin; }
+
+
+inline void ResultsFileTokenizer::seek(size_t pos)
+{ cursor = bufferBegin + pos; }
+
+
+inline void ResultsFileTokenizer::skip_to(char delim)
+{
+  const void* found = std::memchr(cursor, delim, bufferEnd - cursor);
+  cursor = (found) ? static_cast<const char*>(found) : bufferEnd;
+}
+
+} // namespace Dakota
+
+#endif // RESULTS_FILE_TOKENIZER_H
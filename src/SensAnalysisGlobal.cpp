@@ -16,11 +16,122 @@
 #include <algorithm>
 #include <boost/iterator/counting_iterator.hpp>
 #include "DataMethod.hpp" 
+#include "Teuchos_LAPACK.hpp"
+#include "WorkStealingThreadPool.hpp"
 
 static const char rcsId[]="@(#) $Id: SensAnalysisGlobal.cpp 6170 2009-10-06 22:42:15Z lpswile $";
 
 namespace Dakota {
 
+namespace {
+
+/// rows (factors) ranked or standardized per task; a multiple of a
+/// cache line of Reals so that tasks don't share lines of a column
+const int CORR_ROW_BLOCK = 64;
+/// rows and columns of each tile of a correlation matrix product
+const int CORR_TILE = 128;
+/// observations accumulated per pass over a tile, keeping both factor
+/// blocks of the tile in cache
+const int CORR_OBS_BLOCK = 512;
+/// below this many multiply-adds, products are formed in a single call
+const double CORR_TILED_MIN_WORK = 67108864.; // 2^26
+
+/// apply task(t) for t in [0, num_tasks) on the threads shared by the
+/// numerical kernels (serial unless the environment sets kernel_threads)
+template <typename TaskFn>
+void parallel_tasks(size_t num_tasks, TaskFn task)
+{ dakota::util::WorkStealingThreadPool::parallel_for(num_tasks, task); }
+
+/// center each row (factor) of data by its mean and scale it to unit
+/// norm; sweeps the columns (observations) contiguously and performs
+/// the same operations per entry as a sweep along each row
+void standardize_rows(RealMatrix& data)
+{
+  int num_rows = data.numRows(), num_cols = data.numCols();
+  size_t num_blocks = (num_rows + CORR_ROW_BLOCK - 1) / CORR_ROW_BLOCK;
+  parallel_tasks(num_blocks, [&](size_t b) {
+    int i, j, row_begin = b * CORR_ROW_BLOCK,
+      num_block_rows = std::min(CORR_ROW_BLOCK, num_rows - row_begin);
+    RealArray row_mean(num_block_rows, 0.), row_sumsq(num_block_rows, 0.);
+    for (j=0; j<num_cols; ++j) {
+      const Real* col = data[j] + row_begin;
+      for (i=0; i<num_block_rows; ++i)
+	row_mean[i] += col[i];
+    }
+    for (i=0; i<num_block_rows; ++i)
+      row_mean[i] /= (Real)num_cols;
+    for (j=0; j<num_cols; ++j) {
+      Real* col = data[j] + row_begin;
+      for (i=0; i<num_block_rows; ++i) {
+	col[i] -= row_mean[i];
+	row_sumsq[i] += col[i]*col[i];
+      }
+    }
+    for (i=0; i<num_block_rows; ++i)
+      row_sumsq[i] = std::sqrt(row_sumsq[i]);
+    for (j=0; j<num_cols; ++j) {
+      Real* col = data[j] + row_begin;
+      for (i=0; i<num_block_rows; ++i)
+	col[i] /= row_sumsq[i];
+    }
+  });
+}
+
+/** Form prod = left * right' for factors stored by row (observations
+    by column).  Large products are computed by tile of prod in
+    parallel, each tile accumulating over blocks of observations; when
+    symmetric (left and right are the same factors), only the tiles on
+    and below the diagonal are computed and the upper triangle is
+    mirrored from the lower. */
+void correlation_product(const RealMatrix& left, const RealMatrix& right,
+			 bool symmetric, RealMatrix& prod)
+{
+  int num_left = left.numRows(), num_right = right.numRows(),
+    num_obs = left.numCols();
+  if ((double)num_left * num_right * num_obs < CORR_TILED_MIN_WORK) {
+    if (prod.multiply(Teuchos::NO_TRANS, Teuchos::TRANS, 1.0, left, right,
+		      0.0)) {
+      Cerr << "\nError (correlation_product): multiplying incompatible "
+	   << "matrices.\n";
+      abort_handler(-1);
+    }
+    return;
+  }
+
+  size_t i, j, left_tiles = (num_left + CORR_TILE - 1) / CORR_TILE,
+    right_tiles = (num_right + CORR_TILE - 1) / CORR_TILE;
+  std::vector<std::pair<size_t, size_t> > tiles;
+  for (j=0; j<right_tiles; ++j)
+    for (i=(symmetric) ? j : 0; i<left_tiles; ++i)
+      tiles.push_back(std::make_pair(i, j));
+
+  parallel_tasks(tiles.size(), [&](size_t t) {
+    int row_begin = tiles[t].first * CORR_TILE,
+      col_begin = tiles[t].second * CORR_TILE,
+      num_tile_rows = std::min(CORR_TILE, num_left  - row_begin),
+      num_tile_cols = std::min(CORR_TILE, num_right - col_begin);
+    RealMatrix prod_tile(Teuchos::View, prod, num_tile_rows, num_tile_cols,
+			 row_begin, col_begin);
+    for (int k=0; k<num_obs; k+=CORR_OBS_BLOCK) {
+      int num_block_obs = std::min(CORR_OBS_BLOCK, num_obs - k);
+      RealMatrix left_block(Teuchos::View, left, num_tile_rows,
+			    num_block_obs, row_begin, k),
+	right_block(Teuchos::View, right, num_tile_cols, num_block_obs,
+		    col_begin, k);
+      prod_tile.multiply(Teuchos::NO_TRANS, Teuchos::TRANS, 1.0, left_block,
+			 right_block, (k) ? 1.0 : 0.0);
+    }
+  });
+
+  if (symmetric)
+    for (int c=1; c<num_right; ++c)
+      for (int r=0; r<c; ++r)
+	prod(r, c) = prod(c, r);
+}
+
+}
+
+
 RealArray SensAnalysisGlobal::rawData = RealArray();
 
 
@@ -93,37 +204,42 @@ valid_sample_matrix(const RealMatrix&     vars_samples,
     }
 }
 
-/** When converting values to ranks, uses the average ranks of any tied values */
+/** When converting values to ranks, uses the average ranks of any
+    tied values.  Factors (rows) are ranked independently in parallel,
+    by a sort of sample indices on a contiguous copy of each row. */
 void SensAnalysisGlobal::values_to_ranks(RealMatrix& valid_data)
 {
   int num_corr = valid_data.numRows(), num_valid_samples = valid_data.numCols();
-  // for each var/resp
-  for (int i=0; i<num_corr; ++i) {
-    // create a multimap from value to array index (so it is sorted by value and
-    // the ranks are given by the map order); don't need a stable sort as we are
-    // replacing the tied values by their average rank
-    RealIntMultiMap vals_inds;
-    for (int j=0; j<num_valid_samples; ++j)
-      vals_inds.insert(std::make_pair(valid_data(i,j), j));
-
-    // iterate for each unique value and find tied values
-    RealIntMultiMap::const_iterator vi_it = vals_inds.begin();
-    RealIntMultiMap::const_iterator vi_end = vals_inds.end();
-    for (int rank=0; vi_it != vi_end; ) {
-      // find a range of tied values
-      double value = vi_it->first;
-      std::pair<RealIntMultiMap::const_iterator, RealIntMultiMap::const_iterator>
-	tied_range = vals_inds.equal_range(value); 
-      int num_ties = std::distance(tied_range.first, tied_range.second);
-      double avg_rank = (rank + rank+num_ties-1) / 2.0;
-      // all tied values get assigned the average rank
-      for ( ; tied_range.first != tied_range.second; ++tied_range.first)
-	valid_data(i, tied_range.first->second) = avg_rank;
-      // increment to the next unequal value
-      vi_it = tied_range.second;
-      rank += num_ties;
+  size_t num_blocks = (num_corr + CORR_ROW_BLOCK - 1) / CORR_ROW_BLOCK;
+  parallel_tasks(num_blocks, [&](size_t b) {
+    int row_begin = b * CORR_ROW_BLOCK,
+      row_end = std::min(num_corr, row_begin + CORR_ROW_BLOCK);
+    RealArray values(num_valid_samples);
+    IntArray order(num_valid_samples);
+    // for each var/resp
+    for (int i=row_begin; i<row_end; ++i) {
+      for (int j=0; j<num_valid_samples; ++j)
+	{ values[j] = valid_data(i,j); order[j] = j; }
+      // sample indices sorted by value give the ranks
+      std::stable_sort(order.begin(), order.end(),
+		       [&values](int x, int y) { return values[x] < values[y]; });
+
+      // iterate for each unique value and find tied values
+      for (int rank=0; rank<num_valid_samples; ) {
+	// find a range of tied values
+	int num_ties = 1;
+	while (rank + num_ties < num_valid_samples &&
+	       values[order[rank + num_ties]] == values[order[rank]])
+	  ++num_ties;
+	double avg_rank = (rank + rank+num_ties-1) / 2.0;
+	// all tied values get assigned the average rank
+	for (int t=rank; t<rank+num_ties; ++t)
+	  valid_data(i, order[t]) = avg_rank;
+	// increment to the next unequal value
+	rank += num_ties;
+      }
     }
-  }
+  });
 }
 
 void SensAnalysisGlobal::correl_adjust(Real& corr_value)
@@ -163,10 +279,14 @@ compute_correlations(const VariablesArray& vars_samples,
                       valid_data);
   simple_corr(valid_data, num_corr, simpleCorr);
 
-  // calculate partial correlation coeff
-  valid_sample_matrix(vars_samples, resp_samples, dss_vals, is_valid_sample, 
-                      valid_data);
-  partial_corr(valid_data, numVars, simpleCorr, partialCorr, numericalIssuesRaw);
+  // calculate partial correlation coeff (from the samples only when
+  // the simple correlations don't suffice)
+  if (!partial_corr_from_simple(numVars, simpleCorr, partialCorr,
+                                numericalIssuesRaw)) {
+    valid_sample_matrix(vars_samples, resp_samples, dss_vals, is_valid_sample, 
+                        valid_data);
+    partial_corr(valid_data, numVars, simpleCorr, partialCorr, numericalIssuesRaw);
+  }
 
   // calculate simple rank correlation coeff
   valid_sample_matrix(vars_samples, resp_samples, dss_vals, is_valid_sample, 
@@ -175,11 +295,14 @@ compute_correlations(const VariablesArray& vars_samples,
   simple_corr(valid_data, num_corr, simpleRankCorr);
 
   // calculate partial rank correlation coeff
-  valid_sample_matrix(vars_samples, resp_samples, dss_vals, is_valid_sample, 
-                      valid_data);
-  values_to_ranks(valid_data);
-  partial_corr(valid_data, numVars, simpleRankCorr, partialRankCorr, 
-               numericalIssuesRank);
+  if (!partial_corr_from_simple(numVars, simpleRankCorr, partialRankCorr,
+                                numericalIssuesRank)) {
+    valid_sample_matrix(vars_samples, resp_samples, dss_vals, is_valid_sample, 
+                        valid_data);
+    values_to_ranks(valid_data);
+    partial_corr(valid_data, numVars, simpleRankCorr, partialRankCorr, 
+                 numericalIssuesRank);
+  }
 
   corrComputed = true;
 }
@@ -237,9 +360,13 @@ compute_correlations(const RealMatrix&     vars_samples,
   valid_sample_matrix(vars_samples, resp_samples, is_valid_sample, valid_data);
   simple_corr(valid_data, num_corr, simpleCorr);
 
-  // calculate partial correlation coeff
-  valid_sample_matrix(vars_samples, resp_samples, is_valid_sample, valid_data);
-  partial_corr(valid_data, numVars, simpleCorr, partialCorr, numericalIssuesRaw);
+  // calculate partial correlation coeff (from the samples only when
+  // the simple correlations don't suffice)
+  if (!partial_corr_from_simple(numVars, simpleCorr, partialCorr,
+                                numericalIssuesRaw)) {
+    valid_sample_matrix(vars_samples, resp_samples, is_valid_sample, valid_data);
+    partial_corr(valid_data, numVars, simpleCorr, partialCorr, numericalIssuesRaw);
+  }
 
   // calculate simple rank correlation coeff
   valid_sample_matrix(vars_samples, resp_samples, is_valid_sample, valid_data);
@@ -247,10 +374,13 @@ compute_correlations(const RealMatrix&     vars_samples,
   simple_corr(valid_data, num_corr, simpleRankCorr);
 
   // calculate partial rank correlation coeff
-  valid_sample_matrix(vars_samples, resp_samples, is_valid_sample, valid_data);
-  values_to_ranks(valid_data);
-  partial_corr(valid_data, numVars, simpleRankCorr, partialRankCorr, 
-               numericalIssuesRank);
+  if (!partial_corr_from_simple(numVars, simpleRankCorr, partialRankCorr,
+                                numericalIssuesRank)) {
+    valid_sample_matrix(vars_samples, resp_samples, is_valid_sample, valid_data);
+    values_to_ranks(valid_data);
+    partial_corr(valid_data, numVars, simpleRankCorr, partialRankCorr, 
+                 numericalIssuesRank);
+  }
 
   corrComputed = true;
 }
@@ -267,18 +397,8 @@ simple_corr(RealMatrix& total_data, const int& num_in, RealMatrix& corr_matrix)
 {
   int num_corr = total_data.numRows(), num_obs = total_data.numCols();
 
-  center_matrix_rows(total_data);
-
-  for (int i=0; i<num_corr; i++) {
-    // calculate sum of squares for each factor (row)
-    Real row_sumsq = 0.0;
-    for (int j=0; j<num_obs; j++)
-      row_sumsq += total_data(i,j)*total_data(i,j);
-    row_sumsq = std::sqrt(row_sumsq);
-    // normalize the rows with the sumsquare term
-    for (int j=0; j<num_obs; j++)
-      total_data(i,j) /= row_sumsq;
-  }
+  // center the rows and normalize them with the sumsquare term
+  standardize_rows(total_data);
 
   // calculate matrix of simple correlation coefficients
   if (num_corr == num_in) {
@@ -287,8 +407,7 @@ simple_corr(RealMatrix& total_data, const int& num_in, RealMatrix& corr_matrix)
     if (num_obs <= 1)
       corr_matrix.putScalar(std::numeric_limits<double>::quiet_NaN());
     else {
-      corr_matrix.multiply(Teuchos::NO_TRANS, Teuchos::TRANS, 1.0, 
-			   total_data, total_data, 0.0);
+      correlation_product(total_data, total_data, true, corr_matrix);
       for (int i=0; i<num_corr; ++i) {
 	// set finite diagonal values to 1.0
 	if (std::isfinite(corr_matrix(i,i)))
@@ -311,8 +430,7 @@ simple_corr(RealMatrix& total_data, const int& num_in, RealMatrix& corr_matrix)
       RealMatrix total_data_in(Teuchos::View, total_data, num_in, num_obs, 0, 0);
       RealMatrix total_data_out(Teuchos::View, total_data, num_out, num_obs, 
 				num_in, 0);
-      corr_matrix.multiply(Teuchos::NO_TRANS, Teuchos::TRANS, 1.0, 
-			   total_data_in, total_data_out, 0.0);
+      correlation_product(total_data_in, total_data_out, false, corr_matrix);
       // snap all finite values to [-1.0, 1.0]
       for (int i=0; i<num_in; ++i)
 	for (int j=0; j<num_out; ++j)
@@ -462,6 +580,92 @@ partial_corr(RealMatrix& total_data, const int num_in,
       correl_adjust(corr_matrix(i,j));
 }
 
+/** Calculates partial correlation coefficients between num_in inputs
+    and the outputs from the all-to-all simple correlations C.  The
+    partial correlation of input i and output k controlling for the
+    other inputs is w_ik / sqrt(d_k A_ii + w_ik^2), where A = inv(C_vv)
+    for the input block C_vv of C, w_k = A c_k for the input-output
+    correlations c_k, and d_k = 1 - c_k' w_k is the fraction of the
+    variance of output k not explained by the inputs.  One Cholesky
+    factorization of C_vv serves all outputs, solved in parallel by
+    blocks of outputs.  This is the same quantity partial_corr()
+    computes by regression on the samples; returns false (leaving the
+    samples-based calculation to partial_corr()) for a single input,
+    non-finite correlations, ill-conditioned C_vv (e.g., fewer samples
+    than inputs) or an output nearly linear in the inputs. */
+bool SensAnalysisGlobal::
+partial_corr_from_simple(const int num_in, const RealMatrix& simple_corr_mat,
+                         RealMatrix& corr_matrix, bool& numerical_issues)
+{
+  int num_corr = simple_corr_mat.numRows(), num_out = num_corr - num_in;
+  // with fewer than 1/min_conditioning of the variance of C_vv or of an
+  // output left to resolve, the result would lose more than ~10 digits
+  const Real min_conditioning = 1.e-6;
+  if (num_in <= 1 || num_out < 1 || simple_corr_mat.numCols() != num_corr ||
+      has_nan_or_inf(simple_corr_mat))
+    return false;
+
+  // factor C_vv = U'U and estimate its reciprocal condition number
+  Teuchos::LAPACK<int, Real> la;
+  RealMatrix factor(Teuchos::Copy, simple_corr_mat, num_in, num_in);
+  Real anorm = factor.normOne(), rcond = 0.;
+  int info = 0;
+  la.POTRF('U', num_in, factor.values(), factor.stride(), &info);
+  if (info != 0)
+    return false;
+  RealVector work(3*num_in);
+  IntArray iwork(num_in);
+  la.POCON('U', num_in, factor.values(), factor.stride(), anorm, &rcond,
+	   work.values(), &iwork[0], &info);
+  if (info != 0 || !(rcond >= min_conditioning))
+    return false;
+
+  // W = inv(C_vv) C_vr, solving for blocks of outputs in parallel
+  RealMatrix weights(Teuchos::Copy, simple_corr_mat, num_in, num_out, 0,
+		     num_in);
+  size_t num_blocks = (num_out + CORR_TILE - 1) / CORR_TILE;
+  IntArray solve_info(num_blocks, 0);
+  parallel_tasks(num_blocks, [&](size_t b) {
+    int col_begin = b * CORR_TILE,
+      num_block_cols = std::min(CORR_TILE, num_out - col_begin);
+    RealMatrix weights_block(Teuchos::View, weights, num_in, num_block_cols,
+			     0, col_begin);
+    Teuchos::LAPACK<int, Real> block_la;
+    block_la.POTRS('U', num_in, num_block_cols, factor.values(),
+		   factor.stride(), weights_block.values(),
+		   weights_block.stride(), &solve_info[b]);
+  });
+  for (size_t b=0; b<num_blocks; ++b)
+    if (solve_info[b] != 0)
+      return false;
+
+  // overwrite the factor with A = inv(C_vv) for its diagonal
+  la.POTRI('U', num_in, factor.values(), factor.stride(), &info);
+  if (info != 0)
+    return false;
+
+  corr_matrix.reshape(num_in, num_out);
+  for (int k=0; k<num_out; ++k) {
+    Real unexplained = 1.;
+    for (int i=0; i<num_in; ++i)
+      unexplained -= simple_corr_mat(i, num_in+k) * weights(i, k);
+    if (!(unexplained >= min_conditioning))
+      return false;
+    for (int i=0; i<num_in; ++i) {
+      Real w_ik = weights(i, k);
+      corr_matrix(i, k)
+	= w_ik / std::sqrt(unexplained * factor(i, i) + w_ik * w_ik);
+    }
+  }
+
+  // snap all finite values to [-1.0, 1.0]
+  for (int i=0; i<num_in; ++i)
+    for (int j=0; j<num_out; ++j)
+      correl_adjust(corr_matrix(i,j));
+  numerical_issues = false;
+  return true;
+}
+
 // Return true if any correlation coefficient is NaN or Inf, false otherwise
 bool SensAnalysisGlobal::has_nan_or_inf(const RealMatrix &corr) const {
   int num_rows = corr.numRows(), num_cols = corr.numCols();
@@ -810,6 +1014,7 @@ void SensAnalysisGlobal::compute_vbd_stats_via_sampling( const unsigned short
                                                        , const size_t           num_samples
                                                        , const RealMatrix &     vars_samples
                                                        , const IntResponseMap & resp_samples
+                                                       , const size_t           num_bootstrap
                                                        )
 {
 
@@ -827,49 +1032,69 @@ void SensAnalysisGlobal::compute_vbd_stats_via_sampling( const unsigned short
                                            , num_vars
                                            , num_samples
                                            , resp_samples
+                                           , num_bootstrap
                                            );
   }
 }
 
+void SensAnalysisGlobal::initialize_pick_and_freeze( const size_t numFunctions
+                                                   , const size_t num_vars
+                                                   , const size_t num_samples
+                                                   , const size_t num_bootstrap
+                                                   )
+{
+  pickFreezeIndices.initialize(numFunctions, num_vars, num_samples,
+                               num_bootstrap);
+}
+
+void SensAnalysisGlobal::accumulate_pick_and_freeze(const RealVector& fn_vals)
+{ pickFreezeIndices.update(fn_vals); }
+
+/** The responses are either accumulated beforehand through
+    accumulate_pick_and_freeze() or taken from resp_samples, which is
+    assumed ordered as allSamples from Analyzer::get_vbd_parameter_sets()
+    (all samples of A, then B, then each A_B^i).  Only the A and B
+    responses are retained; each A_B^i replicate is reduced as it is
+    passed to the accumulator. */
 void SensAnalysisGlobal::compute_pick_and_freeze_vbd_stats( const size_t           numFunctions
                                                           , const size_t           num_vars
                                                           , const size_t           num_samples
                                                           , const IntResponseMap & resp_samples
+                                                          , const size_t           num_bootstrap
                                                           )
 {
-  if (resp_samples.size() != num_samples * (num_vars+2)) {
-    Cerr << "\nError in Analyzer::compute_vbd_stats_with_Saltelli()"
-         << ": expected " << num_samples * (num_vars+2) << " responses"
-         << "; received " << resp_samples.size()
-         << std::endl;
-    abort_handler(METHOD_ERROR);
-  }
-  
-  // BMA: for now copy the data to previous data structure 
-  //      total_fn_vals[respFn][replicate][sample]
-  // This is making the assumption that the responses are ordered as allSamples
-  // BMA TODO: compute statistics on finite samples only
-  boost::multi_array<Real,3> total_fn_vals(boost::extents[numFunctions][num_vars+2][num_samples]); // [k][i][j]
-  IntRespMCIter r_it = resp_samples.begin();
-  for (size_t i(0); i < (num_vars+2); ++i) {
-    for (size_t j(0); j < num_samples; ++r_it, ++j) {
-      for (size_t k(0); k < numFunctions; ++k) {
-        total_fn_vals[k][i][j] = r_it->second.function_value(k);
-      }
+  size_t num_evals = num_samples * (num_vars+2);
+  if (pickFreezeIndices.num_evaluations() == 0) {
+    if (resp_samples.size() != num_evals) {
+      Cerr << "\nError in Analyzer::compute_vbd_stats_with_Saltelli()"
+           << ": expected " << num_evals << " responses"
+           << "; received " << resp_samples.size()
+           << std::endl;
+      abort_handler(METHOD_ERROR);
     }
-  }
-
-#ifdef DEBUG
-  //Cout << "allSamples:\n" << allSamples << '\n';
-  for (size_t k(0); k < numFunctions; ++k) {
-    for (size_t i(0); i < num_vars+2; ++i) {
-      for (size_t j(0); j < num_samples; ++j) {
-        Cout << "Response " << k << " for replicate " << i << ", sample " << j
-             << ": " << total_fn_vals[k][i][j] << '\n';
+    // BMA TODO: compute statistics on finite samples only
+    pickFreezeIndices.initialize(numFunctions, num_vars, num_samples,
+                                 num_bootstrap);
+    RealArray replicate_vals(num_samples * numFunctions);
+    IntRespMCIter r_it = resp_samples.begin();
+    for (size_t i(0); i < (num_vars+2); ++i) {
+      for (size_t j(0); j < num_samples; ++r_it, ++j) {
+        const RealVector& fn_vals = r_it->second.function_values();
+        std::copy(fn_vals.values(), fn_vals.values() + numFunctions,
+                  &replicate_vals[j * numFunctions]);
       }
+      pickFreezeIndices.update(&replicate_vals[0], num_samples);
     }
   }
-#endif
+  else if (!pickFreezeIndices.complete() ||
+           pickFreezeIndices.num_functions() != numFunctions ||
+           pickFreezeIndices.num_variables() != num_vars) {
+    Cerr << "\nError in Analyzer::compute_vbd_stats_with_Saltelli()"
+         << ": expected " << num_evals << " accumulated responses"
+         << "; received " << pickFreezeIndices.num_evaluations()
+         << std::endl;
+    abort_handler(METHOD_ERROR);
+  }
 
   // We compute variables indexSi and indexTi according to the following paper:
   // - A. Saltelli, P. Annoni, I. Azzini, F. Campolongo, M. Ratto, S. Tarantola,
@@ -883,71 +1108,17 @@ void SensAnalysisGlobal::compute_pick_and_freeze_vbd_stats( const size_t
   // - V. Weirs, J. Kamm, L. Swiler, S. Tarantola, M. Ratto, B. Adams, W. Rider,
   //   M. Eldred, "Sensitivity analysis techniques applied to a system of
   //   hyperbolic conservation laws", RESS, 107, pp. 157--170, Nov. 2012.
+  pickFreezeIndices.indices(indexSi, indexTi);
 
-  indexSi.resize(numFunctions, RealVector(num_vars));
-  indexTi.resize(numFunctions, RealVector(num_vars));
-
-  boost::multi_array<Real,3> total_norm_vals(boost::extents[numFunctions][num_vars+2][num_samples]); // [k][i][j]
-
-  Real dNumSamples( static_cast<Real>(num_samples) );
-
-  // Obtain sensitivity indices for each function
-  for (size_t k(0); k < numFunctions; ++k) {
-    Real mean_C(0.);
-    {
-      Real mean_hatY(0.);
-      for (size_t j(0); j < num_samples; ++j) {
-        mean_hatY += total_fn_vals[k][0][j];
-      }
-      mean_hatY /= dNumSamples;
-
-      Real mean_hatB(0.); 
-      for (size_t j(0); j < num_samples; ++j) {
-        mean_hatB += total_fn_vals[k][1][j];
-      }
-      mean_hatB /= dNumSamples;
-
-      Real overall_mean(0.);
-      for (size_t j(0); j < num_samples; ++j) {
-        for(size_t i(0); i < (num_vars+2); ++i) { 
-          total_norm_vals[k][i][j]  = total_fn_vals[k][i][j];
-          overall_mean             += total_norm_vals[k][i][j];
-        } 
-      }
-      overall_mean /= static_cast<Real>( num_samples * (num_vars+2) );
-      for (size_t j(0); j < num_samples; ++j) {
-        for(size_t i(0); i < (num_vars+2); ++i) {
-          total_norm_vals[k][i][j] -= overall_mean;
-        }
-      }
-
-      mean_C = (mean_hatB + mean_hatY) / 2.;
-    }
-
-    Real var_hatYC(0.);
-    for (size_t j(0); j < num_samples; ++j) {
-      var_hatYC += std::pow(total_fn_vals[k][0][j],2);
-    }
-    for (size_t j(0); j < num_samples; ++j) {
-      var_hatYC += std::pow(total_fn_vals[k][1][j],2);
-    }
-    var_hatYC = var_hatYC / (2. * dNumSamples)
-              - mean_C * mean_C;
-
-    // calculate first order sensitivity indices and first order total indices
-    for (size_t i(0); i < num_vars; ++i) {
-      Real sum_S(0.);
-      Real sum_T(0.);
-      for (size_t j(0); j < num_samples; ++j) {
-        Real diff(total_norm_vals[k][i+2][j] - total_norm_vals[k][1][j]);
-        sum_S += total_norm_vals[k][0][j] * diff;
-        sum_T += std::pow(diff, 2);
-      }
-
-      indexSi[k][i] = (sum_S /       dNumSamples ) / var_hatYC;
-      indexTi[k][i] = (sum_T / (2. * dNumSamples)) / var_hatYC;
-    }
-  } // for k
+  // 95% percentile intervals over the bootstrap resamples
+  if (pickFreezeIndices.num_bootstrap())
+    pickFreezeIndices.confidence_intervals(0.95, indexSiLower, indexSiUpper,
+                                           indexTiLower, indexTiUpper);
+  else {
+    indexSiLower.clear();  indexSiUpper.clear();
+    indexTiLower.clear();  indexTiUpper.clear();
+  }
+  pickFreezeIndices.clear();
 }
 
 void SensAnalysisGlobal::compute_binned_vbd_stats( const int              numBins
@@ -1023,14 +1194,24 @@ void SensAnalysisGlobal::print_main_and_total_effects_indices( std::ostream
 {
   for (size_t k(0); k < resp_labels.size(); ++k) {
     s << resp_labels[k] << " Sobol' indices:\n"; 
-    s << std::setw(38) << "Main" << std::setw(19) << "Total\n";
+    bool print_ci = !indexSiLower.empty();
+    s << std::setw(38) << "Main" << std::setw(18) << "Total";
+    if (print_ci)
+      s << std::setw(43) << "Main 95% CI" << std::setw(42) << "Total 95% CI";
+    s << '\n';
     for (size_t i(0); i < var_labels.size(); ++i) {
       Real main  = indexSi[k][i];
       Real total = indexTi[k][i];
       if (std::abs(main) > dropTol || std::abs(total) > dropTol) {
         s << "                     " << std::setw(write_precision+7) << main
-          << ' ' << std::setw(write_precision+7) << total << ' '
-          << var_labels[i] << '\n';
+          << ' ' << std::setw(write_precision+7) << total << ' ';
+        if (print_ci)
+          s << "  [ " << std::setw(write_precision+7) << indexSiLower[k][i]
+            << ", " << std::setw(write_precision+7) << indexSiUpper[k][i]
+            << " ]  [ " << std::setw(write_precision+7) << indexTiLower[k][i]
+            << ", " << std::setw(write_precision+7) << indexTiUpper[k][i]
+            << " ] ";
+        s << var_labels[i] << '\n';
       }
     }
   }
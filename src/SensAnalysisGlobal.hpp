@@ -16,6 +16,7 @@
 #include "DakotaResponse.hpp"
 #include "dakota_global_defs.hpp"
 #include "dakota_results_types.hpp"
+#include "StreamingSobolIndices.hpp"
 namespace Dakota {
 
 class ResultsManager;
@@ -72,6 +73,16 @@ public:
   /// has been invoked
   bool correlations_computed() const;
 
+  /// returns the simple (rank = false) or simple rank (rank = true)
+  /// correlations computed in compute_correlations()
+  const RealMatrix& simple_correlations(bool rank = false) const;
+  /// returns the partial (rank = false) or partial rank (rank = true)
+  /// correlations computed in compute_correlations()
+  const RealMatrix& partial_correlations(bool rank = false) const;
+  /// returns whether numerical issues were encountered in the partial
+  /// (rank = false) or partial rank (rank = true) correlations
+  bool partial_correlation_issues(bool rank = false) const;
+
   /// prints the correlations computed in compute_correlations()
   void print_correlations(std::ostream& s, const StringArray& var_labels,
 			  const StringArray& resp_labels) const;
@@ -94,8 +105,21 @@ public:
                                      , const size_t           num_samples
                                      , const RealMatrix &     vars_samples
                                      , const IntResponseMap & resp_samples
+                                     , const size_t           num_bootstrap = 0
                                      );
 
+  /// prepare to accumulate pick-and-freeze VBD evaluations as they
+  /// complete, in place of passing resp_samples to
+  /// compute_vbd_stats_via_sampling()
+  void initialize_pick_and_freeze( const size_t numFunctions
+                                 , const size_t num_vars
+                                 , const size_t num_samples
+                                 , const size_t num_bootstrap = 0
+                                 );
+
+  /// accumulate the response of the next pick-and-freeze evaluation
+  void accumulate_pick_and_freeze(const RealVector& fn_vals);
+
   /// Printing of VBD results
   void print_sobol_indices( std::ostream      & s
                           , const StringArray & var_labels
@@ -163,6 +187,13 @@ private:
   void partial_corr(RealMatrix& total_data, const int num_in, 
                     const RealMatrix& simple_corr_mat,
                     RealMatrix& corr_matrix, bool& numerical_issues);
+  /// computes partial correlations from all-to-all simple correlations
+  /// using a single factorization, if well-conditioned; returns false
+  /// if the samples are needed (see partial_corr())
+  bool partial_corr_from_simple(const int num_in,
+                                const RealMatrix& simple_corr_mat,
+                                RealMatrix& corr_matrix,
+                                bool& numerical_issues);
 
   /// Return true if there are any NaN or Inf entries in the matrix
   bool has_nan_or_inf(const RealMatrix &corr) const;
@@ -197,6 +228,7 @@ private:
                                         , const size_t           num_vars
                                         , const size_t           num_samples
                                         , const IntResponseMap & resp_samples
+                                        , const size_t           num_bootstrap
                                         );
 
   void compute_binned_vbd_stats( const int              numBins
@@ -294,6 +326,15 @@ protected:
 
   /// VBD total effect indices
   RealVectorArray indexTi;
+
+  /// lower and upper bootstrap confidence limits for indexSi (empty
+  /// unless bootstrap resamples are requested)
+  RealVectorArray indexSiLower, indexSiUpper;
+  /// lower and upper bootstrap confidence limits for indexTi
+  RealVectorArray indexTiLower, indexTiUpper;
+
+  /// accumulator for the pick-and-freeze VBD estimators
+  StreamingSobolIndices pickFreezeIndices;
 };
 
 
@@ -308,6 +349,20 @@ inline SensAnalysisGlobal::~SensAnalysisGlobal()
 inline bool SensAnalysisGlobal::correlations_computed() const
 { return corrComputed; }
 
+
+inline const RealMatrix& SensAnalysisGlobal::
+simple_correlations(bool rank) const
+{ return (rank) ? simpleRankCorr : simpleCorr; }
+
+
+inline const RealMatrix& SensAnalysisGlobal::
+partial_correlations(bool rank) const
+{ return (rank) ? partialRankCorr : partialCorr; }
+
+
+inline bool SensAnalysisGlobal::partial_correlation_issues(bool rank) const
+{ return (rank) ? numericalIssuesRank : numericalIssuesRaw; }
+
 } // namespace Dakota
 
 #endif
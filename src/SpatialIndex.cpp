@@ -0,0 +1,424 @@
+/*  _______________________________________________________________________
+
+    Dakota: Explore and predict with confidence.
+    Copyright 2014-2023
+    National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Dakota directory.
+    _______________________________________________________________________ */
+
+#include "SpatialIndex.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+
+namespace Dakota {
+
+/// relative slack applied to cell distances before pruning, so that
+/// roundoff in the incremental offsets never discards a point that a
+/// direct distance computation would accept
+static const Real PRUNE_SLACK = 1. + 1.e-12;
+
+const size_t SpatialIndex::npos;
+
+
+void SpatialIndex::reset(size_t num_dim)
+{
+  numDim = num_dim;  rootNode = npos;
+  pointCoords.clear();  radiusSq.clear();  subtreeMaxRadiusSq.clear();
+  splitDim.clear();  lowerChild.clear();  upperChild.clear();
+  parentNode.clear();
+}
+
+
+void SpatialIndex::reserve(size_t num_pts)
+{
+  pointCoords.reserve(num_pts*numDim);
+  radiusSq.reserve(num_pts);  subtreeMaxRadiusSq.reserve(num_pts);
+  splitDim.reserve(num_pts);  lowerChild.reserve(num_pts);
+  upperChild.reserve(num_pts);  parentNode.reserve(num_pts);
+}
+
+
+void SpatialIndex::build(const Real* points, size_t num_pts)
+{
+  reset(numDim);
+  pointCoords.assign(points, points + num_pts*numDim);
+  radiusSq.assign(num_pts, 0.);  subtreeMaxRadiusSq.assign(num_pts, 0.);
+  splitDim.assign(num_pts, 0);   lowerChild.assign(num_pts, npos);
+  upperChild.assign(num_pts, npos);  parentNode.assign(num_pts, npos);
+  SizetArray ids(num_pts);
+  for (size_t i=0; i<num_pts; ++i)
+    ids[i] = i;
+  rootNode = build(ids.begin(), ids.end(), npos, 0);
+}
+
+
+/** Points tied with the median coordinate go to the upper subtree, as
+    for incremental insertion. */
+size_t SpatialIndex::
+build(SizetArray::iterator first, SizetArray::iterator last, size_t parent,
+      size_t split_dim)
+{
+  if (first == last)
+    return npos;
+  const Real* coords = &pointCoords[split_dim];
+  size_t nd = numDim;
+  SizetArray::iterator mid = first + (last - first) / 2;
+  std::nth_element(first, mid, last, [coords, nd](size_t a, size_t b)
+		   { return coords[a*nd] < coords[b*nd]; });
+  Real split = coords[*mid * nd];
+  SizetArray::iterator node = std::partition(first, mid,
+    [coords, nd, split](size_t a) { return coords[a*nd] < split; });
+  std::iter_swap(node, mid);
+
+  size_t i = *node, child_dim = (split_dim + 1) % numDim;
+  splitDim[i] = split_dim;  parentNode[i] = parent;
+  lowerChild[i] = build(first, node, i, child_dim);
+  upperChild[i] = build(node + 1, last, i, child_dim);
+  return i;
+}
+
+
+size_t SpatialIndex::insert(const Real* x, Real radius_sq)
+{
+  size_t i = size(), parent = npos, node = rootNode;
+  bool lower = false;
+  while (node != npos) {
+    parent = node;
+    lower  = (x[splitDim[node]] < pointCoords[node*numDim + splitDim[node]]);
+    node   = (lower) ? lowerChild[node] : upperChild[node];
+  }
+
+  pointCoords.insert(pointCoords.end(), x, x + numDim);
+  radiusSq.push_back(radius_sq);
+  subtreeMaxRadiusSq.push_back(radius_sq);
+  splitDim.push_back((parent == npos) ? 0 : (splitDim[parent] + 1) % numDim);
+  lowerChild.push_back(npos);  upperChild.push_back(npos);
+  parentNode.push_back(parent);
+  if (parent == npos)
+    rootNode = i;
+  else {
+    ((lower) ? lowerChild[parent] : upperChild[parent]) = i;
+    update_subtree_radius(parent);
+  }
+  return i;
+}
+
+
+void SpatialIndex::radius_sq(size_t i, Real r_sq)
+{
+  radiusSq[i] = r_sq;
+  update_subtree_radius(i);
+}
+
+
+/** Radii may grow or shrink, so each ancestor is recomputed from its
+    children; the walk stops as soon as a subtree maximum is unchanged. */
+void SpatialIndex::update_subtree_radius(size_t i)
+{
+  for (size_t node=i; node!=npos; node=parentNode[node]) {
+    Real max_r_sq = radiusSq[node];
+    size_t lo = lowerChild[node], up = upperChild[node];
+    if (lo != npos && subtreeMaxRadiusSq[lo] > max_r_sq)
+      max_r_sq = subtreeMaxRadiusSq[lo];
+    if (up != npos && subtreeMaxRadiusSq[up] > max_r_sq)
+      max_r_sq = subtreeMaxRadiusSq[up];
+    if (node != i && subtreeMaxRadiusSq[node] == max_r_sq)
+      break;
+    subtreeMaxRadiusSq[node] = max_r_sq;
+  }
+}
+
+
+size_t SpatialIndex::nearest(const Real* x, Real& dist_sq) const
+{
+  size_t best = npos;
+  dist_sq = std::numeric_limits<Real>::infinity();
+  if (scan_preferred())
+    for (size_t i=0; i<size(); ++i) {
+      Real d_sq = distance_sq(x, i);
+      if (d_sq < dist_sq)
+	{ best = i; dist_sq = d_sq; }
+    }
+  else if (size()) {
+    queryOffsets.assign(numDim, 0.);
+    nearest(rootNode, x, &queryOffsets[0], 0., best, dist_sq);
+  }
+  return best;
+}
+
+
+void SpatialIndex::
+nearest(size_t node, const Real* x, Real* offsets, Real cell_dist_sq,
+	size_t& best, Real& best_dist_sq) const
+{
+  Real d_sq = distance_sq(x, node);
+  if (d_sq < best_dist_sq || (d_sq == best_dist_sq && node < best))
+    { best = node; best_dist_sq = d_sq; }
+
+  size_t s = splitDim[node];
+  Real diff = x[s] - pointCoords[node*numDim + s];
+  size_t near_child = (diff < 0.) ? lowerChild[node] : upperChild[node],
+          far_child = (diff < 0.) ? upperChild[node] : lowerChild[node];
+  if (near_child != npos)
+    nearest(near_child, x, offsets, cell_dist_sq, best, best_dist_sq);
+  if (far_child != npos) {
+    Real old_off = offsets[s],
+      far_dist_sq = cell_dist_sq - old_off*old_off + diff*diff;
+    if (far_dist_sq <= best_dist_sq * PRUNE_SLACK) {
+      offsets[s] = diff;
+      nearest(far_child, x, offsets, far_dist_sq, best, best_dist_sq);
+      offsets[s] = old_off;
+    }
+  }
+}
+
+
+void SpatialIndex::
+nearest(const Real* x, size_t k, SizetArray& indices, RealArray& dists_sq) const
+{
+  std::vector<std::pair<Real, size_t> > heap;
+  if (k && scan_preferred()) {
+    heap.reserve(k + 1);
+    for (size_t i=0; i<size(); ++i) {
+      std::pair<Real, size_t> cand(distance_sq(x, i), i);
+      if (heap.size() < k || cand < heap.front()) {
+	heap.push_back(cand);
+	std::push_heap(heap.begin(), heap.end());
+	if (heap.size() > k)
+	  { std::pop_heap(heap.begin(), heap.end()); heap.pop_back(); }
+      }
+    }
+  }
+  else if (k && size()) {
+    heap.reserve(k + 1);
+    queryOffsets.assign(numDim, 0.);
+    nearest(rootNode, x, &queryOffsets[0], 0., k, heap);
+  }
+  std::sort_heap(heap.begin(), heap.end());
+  size_t i, num_found = heap.size();
+  indices.resize(num_found);  dists_sq.resize(num_found);
+  for (i=0; i<num_found; ++i)
+    { dists_sq[i] = heap[i].first; indices[i] = heap[i].second; }
+}
+
+
+void SpatialIndex::
+nearest(size_t node, const Real* x, Real* offsets, Real cell_dist_sq,
+	size_t k, std::vector<std::pair<Real, size_t> >& heap) const
+{
+  std::pair<Real, size_t> cand(distance_sq(x, node), node);
+  if (heap.size() < k || cand < heap.front()) {
+    heap.push_back(cand);
+    std::push_heap(heap.begin(), heap.end());
+    if (heap.size() > k)
+      { std::pop_heap(heap.begin(), heap.end()); heap.pop_back(); }
+  }
+
+  size_t s = splitDim[node];
+  Real diff = x[s] - pointCoords[node*numDim + s];
+  size_t near_child = (diff < 0.) ? lowerChild[node] : upperChild[node],
+          far_child = (diff < 0.) ? upperChild[node] : lowerChild[node];
+  if (near_child != npos)
+    nearest(near_child, x, offsets, cell_dist_sq, k, heap);
+  if (far_child != npos) {
+    Real old_off = offsets[s],
+      far_dist_sq = cell_dist_sq - old_off*old_off + diff*diff;
+    if (heap.size() < k || far_dist_sq <= heap.front().first * PRUNE_SLACK) {
+      offsets[s] = diff;
+      nearest(far_child, x, offsets, far_dist_sq, k, heap);
+      offsets[s] = old_off;
+    }
+  }
+}
+
+
+void SpatialIndex::within(const Real* x, Real r, SizetArray& indices) const
+{
+  indices.clear();
+  if (scan_preferred()) {
+    for (size_t i=0; i<size(); ++i)
+      if (distance_sq(x, i) < r*r)
+	indices.push_back(i);
+  }
+  else if (size()) {
+    queryOffsets.assign(numDim, 0.);
+    within(rootNode, x, &queryOffsets[0], 0., r*r, indices);
+    std::sort(indices.begin(), indices.end());
+  }
+}
+
+
+void SpatialIndex::
+within(size_t node, const Real* x, Real* offsets, Real cell_dist_sq,
+       Real r_sq, SizetArray& indices) const
+{
+  if (distance_sq(x, node) < r_sq)
+    indices.push_back(node);
+
+  size_t s = splitDim[node];
+  Real diff = x[s] - pointCoords[node*numDim + s];
+  size_t near_child = (diff < 0.) ? lowerChild[node] : upperChild[node],
+          far_child = (diff < 0.) ? upperChild[node] : lowerChild[node];
+  if (near_child != npos)
+    within(near_child, x, offsets, cell_dist_sq, r_sq, indices);
+  if (far_child != npos) {
+    Real old_off = offsets[s],
+      far_dist_sq = cell_dist_sq - old_off*old_off + diff*diff;
+    if (far_dist_sq < r_sq * PRUNE_SLACK) {
+      offsets[s] = diff;
+      within(far_child, x, offsets, far_dist_sq, r_sq, indices);
+      offsets[s] = old_off;
+    }
+  }
+}
+
+
+bool SpatialIndex::covered(const Real* x, size_t excluded_dim) const
+{
+  if (scan_preferred()) {
+    for (size_t i=0; i<size(); ++i)
+      if (distance_sq(x, i, excluded_dim) < radiusSq[i])
+	return true;
+    return false;
+  }
+  if (!size())
+    return false;
+  queryOffsets.assign(numDim, 0.);
+  return covering(rootNode, x, &queryOffsets[0], 0., excluded_dim, NULL);
+}
+
+
+void SpatialIndex::
+covering(const Real* x, SizetArray& indices, size_t excluded_dim) const
+{
+  indices.clear();
+  if (scan_preferred()) {
+    for (size_t i=0; i<size(); ++i)
+      if (distance_sq(x, i, excluded_dim) < radiusSq[i])
+	indices.push_back(i);
+  }
+  else if (size()) {
+    queryOffsets.assign(numDim, 0.);
+    covering(rootNode, x, &queryOffsets[0], 0., excluded_dim, &indices);
+    std::sort(indices.begin(), indices.end());
+  }
+}
+
+
+/** Offsets along the excluded dimension stay zero, so both children
+    of a node split on it are reached at the parent cell distance. */
+bool SpatialIndex::
+covering(size_t node, const Real* x, Real* offsets, Real cell_dist_sq,
+	 size_t excluded_dim, SizetArray* indices) const
+{
+  if (cell_dist_sq >= subtreeMaxRadiusSq[node] * PRUNE_SLACK)
+    return false;
+  if (distance_sq(x, node, excluded_dim) < radiusSq[node]) {
+    if (!indices)
+      return true;
+    indices->push_back(node);
+  }
+
+  size_t s = splitDim[node];
+  Real diff = (s == excluded_dim) ? 0. : x[s] - pointCoords[node*numDim + s];
+  size_t near_child = (diff < 0.) ? lowerChild[node] : upperChild[node],
+          far_child = (diff < 0.) ? upperChild[node] : lowerChild[node];
+  if (near_child != npos &&
+      covering(near_child, x, offsets, cell_dist_sq, excluded_dim, indices))
+    return true;
+  if (far_child != npos) {
+    Real old_off = offsets[s],
+      far_dist_sq = cell_dist_sq - old_off*old_off + diff*diff;
+    offsets[s] = diff;
+    bool found
+      = covering(far_child, x, offsets, far_dist_sq, excluded_dim, indices);
+    offsets[s] = old_off;
+    return found;
+  }
+  return false;
+}
+
+
+void SpatialIndex::
+overlapping(const Real* x, Real r, SizetArray& indices) const
+{
+  indices.clear();
+  if (scan_preferred()) {
+    for (size_t i=0; i<size(); ++i)
+      if (r + std::sqrt(radiusSq[i]) > std::sqrt(distance_sq(x, i)))
+	indices.push_back(i);
+  }
+  else if (size()) {
+    queryOffsets.assign(numDim, 0.);
+    overlapping(rootNode, x, &queryOffsets[0], 0., r, indices);
+    std::sort(indices.begin(), indices.end());
+  }
+}
+
+
+void SpatialIndex::
+overlapping(size_t node, const Real* x, Real* offsets, Real cell_dist_sq,
+	    Real r, SizetArray& indices) const
+{
+  Real reach = r + std::sqrt(subtreeMaxRadiusSq[node]);
+  if (cell_dist_sq >= reach * reach * PRUNE_SLACK)
+    return;
+  if (r + std::sqrt(radiusSq[node]) > std::sqrt(distance_sq(x, node)))
+    indices.push_back(node);
+
+  size_t s = splitDim[node];
+  Real diff = x[s] - pointCoords[node*numDim + s];
+  size_t near_child = (diff < 0.) ? lowerChild[node] : upperChild[node],
+          far_child = (diff < 0.) ? upperChild[node] : lowerChild[node];
+  if (near_child != npos)
+    overlapping(near_child, x, offsets, cell_dist_sq, r, indices);
+  if (far_child != npos) {
+    Real old_off = offsets[s];
+    offsets[s] = diff;
+    overlapping(far_child, x, offsets,
+		cell_dist_sq - old_off*old_off + diff*diff, r, indices);
+    offsets[s] = old_off;
+  }
+}
+
+
+/** Walks the spoke end toward point i: while some other point is
+    closer to the end than point i, the end is trimmed back to the
+    bisector of the two.  Each trim only shortens the spoke, so the end
+    settles on the first Voronoi face crossed, which is where trimming
+    against every bisector in turn would leave it.  The parallel-face
+    tolerance matches trim_line_using_Hyperplane() in the darts
+    methods. */
+size_t SpatialIndex::trim_to_voronoi_cell(size_t i, Real* end) const
+{
+  const Real* x_i = point(i);
+  size_t d, iter, num_pts = size(), neighbor = i;
+  for (iter=0; iter<num_pts; ++iter) {
+    Real q_dist_sq;
+    size_t q = nearest(end, q_dist_sq);
+    if (q == i || q_dist_sq >= distance_sq(end, i))
+      break;
+    const Real* x_q = point(q);
+    Real dotv = 0., dote = 0., norm_sq = 0.;
+    for (d=0; d<numDim; ++d) {
+      Real n_d = x_q[d] - x_i[d];
+      dotv += 0.5 * n_d * n_d;
+      dote += (end[d] - x_i[d]) * n_d;
+      norm_sq += n_d * n_d;
+    }
+    if (dote < 1.e-10 * std::sqrt(norm_sq))
+      break;
+    Real u = dotv / dote;
+    if (!(u > 0. && u < 1.))
+      break;
+    for (d=0; d<numDim; ++d)
+      end[d] = x_i[d] + u * (end[d] - x_i[d]);
+    neighbor = q;
+  }
+  return neighbor;
+}
+
+} // namespace Dakota
@@ -0,0 +1,206 @@
+/*  _______________________________________________________________________
+
+    Dakota: Explore and predict with confidence.
+    Copyright 2014-2023
+    National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Dakota directory.
+    _______________________________________________________________________ */
+
+#ifndef SPATIAL_INDEX_H
+#define SPATIAL_INDEX_H
+
+#include "dakota_data_types.hpp"
+
+#include <limits>
+
+namespace Dakota {
+
+/// Incremental k-d tree over points carrying sphere radii
+
+/** Each inserted point is a node of an unbalanced k-d tree, split on
+    the dimension following that of its parent.  Points are indexed in
+    insertion order and stored contiguously.  Every point may carry a
+    squared sphere radius; each node tracks the largest radius in its
+    subtree so that sphere coverage and overlap queries prune subtrees
+    that no sphere can reach.  Descent maintains the per-dimension
+    offsets of the query from the current cell (Arya and Mount), which
+    gives the exact distance from the query to each cell visited.
+
+    The tree is not rebalanced: depth is O(log n) in expectation for
+    points inserted in random order, as in the darts methods, but
+    degrades for sorted insertions.  A set of points known in advance
+    may instead be indexed by build(), which splits at medians.  Queries returning index sets
+    return them in ascending order so that callers may process them in
+    the same order as a scan over all points.  While there are fewer
+    than 2^numDim points, few cells can be pruned and queries scan the
+    points directly instead of descending the tree.
+
+    An excluded dimension may be passed to the coverage queries, in
+    which case distances are measured in the remaining dimensions
+    (distance from a line parallel to that axis). */
+class SpatialIndex
+{
+public:
+
+  //
+  //- Heading: Constructors and destructor
+  //
+
+  /// constructor
+  SpatialIndex(size_t num_dim = 0);
+
+  //
+  //- Heading: Member functions
+  //
+
+  /// discard all points and set the number of dimensions
+  void reset(size_t num_dim);
+  /// reserve storage for num_pts points
+  void reserve(size_t num_pts);
+  /// replace the contents with a balanced tree over num_pts points
+  /// stored contiguously, with zero radii
+  void build(const Real* points, size_t num_pts);
+
+  /// add a point with an optional squared sphere radius; returns its index
+  size_t insert(const Real* x, Real radius_sq = 0.);
+  /// update the squared sphere radius of point i
+  void radius_sq(size_t i, Real r_sq);
+  /// return the squared sphere radius of point i
+  Real radius_sq(size_t i) const;
+
+  /// number of points
+  size_t size() const;
+  /// number of dimensions
+  size_t num_dimensions() const;
+  /// coordinates of point i
+  const Real* point(size_t i) const;
+
+  /// index of the point nearest to x (lowest index among ties), or
+  /// npos if empty; dist_sq returns its squared distance
+  size_t nearest(const Real* x, Real& dist_sq) const;
+  /// indices of the (up to) k nearest points to x and their squared
+  /// distances, ordered by increasing distance
+  void nearest(const Real* x, size_t k, SizetArray& indices,
+	       RealArray& dists_sq) const;
+  /// indices of points strictly within distance r of x
+  void within(const Real* x, Real r, SizetArray& indices) const;
+
+  /// whether x lies strictly inside any sphere
+  bool covered(const Real* x, size_t excluded_dim = npos) const;
+  /// indices of spheres strictly containing x
+  void covering(const Real* x, SizetArray& indices,
+		size_t excluded_dim = npos) const;
+  /// indices of spheres overlapping the sphere of radius r about x
+  /// (r + r_j > |x - x_j|)
+  void overlapping(const Real* x, Real r, SizetArray& indices) const;
+
+  /// trim the segment from point i to end at the boundary of the
+  /// Voronoi cell of point i; returns the index of the point sharing
+  /// the trimming face, or i if end lies within the cell
+  size_t trim_to_voronoi_cell(size_t i, Real* end) const;
+
+  /// flag for no point or no excluded dimension
+  static const size_t npos = std::numeric_limits<size_t>::max();
+
+private:
+
+  //
+  //- Heading: Convenience functions
+  //
+
+  /// squared distance from x to point i, skipping excluded_dim
+  Real distance_sq(const Real* x, size_t i, size_t excluded_dim = npos) const;
+  /// recompute subtreeMaxRadiusSq from node i up to the root
+  void update_subtree_radius(size_t i);
+  /// whether a scan over all points is expected to beat tree descent
+  bool scan_preferred() const;
+  /// link the points in [first, last) into a subtree split first on
+  /// split_dim; returns its root
+  size_t build(SizetArray::iterator first, SizetArray::iterator last,
+	       size_t parent, size_t split_dim);
+
+  /// recursive nearest neighbor search
+  void nearest(size_t node, const Real* x, Real* offsets, Real cell_dist_sq,
+	       size_t& best, Real& best_dist_sq) const;
+  /// recursive k-nearest neighbor search on a max-heap of candidates
+  void nearest(size_t node, const Real* x, Real* offsets, Real cell_dist_sq,
+	       size_t k, std::vector<std::pair<Real, size_t> >& heap) const;
+  /// recursive ball search
+  void within(size_t node, const Real* x, Real* offsets, Real cell_dist_sq,
+	      Real r_sq, SizetArray& indices) const;
+  /// recursive sphere coverage search; stops at the first sphere found
+  /// when indices is NULL
+  bool covering(size_t node, const Real* x, Real* offsets,
+		Real cell_dist_sq, size_t excluded_dim,
+		SizetArray* indices) const;
+  /// recursive sphere overlap search
+  void overlapping(size_t node, const Real* x, Real* offsets,
+		   Real cell_dist_sq, Real r, SizetArray& indices) const;
+
+  //
+  //- Heading: Data
+  //
+
+  /// number of dimensions
+  size_t numDim;
+  /// root of the tree, or npos if empty
+  size_t rootNode;
+  /// point coordinates, numDim per point in insertion order
+  RealArray pointCoords;
+  /// squared sphere radius per point
+  RealArray radiusSq;
+  /// largest squared sphere radius in the subtree rooted at each point
+  RealArray subtreeMaxRadiusSq;
+  /// dimension split by each node
+  SizetArray splitDim;
+  /// lower (coordinate below the split) child of each node, or npos
+  SizetArray lowerChild;
+  /// upper child of each node, or npos
+  SizetArray upperChild;
+  /// parent of each node, or npos for the root
+  SizetArray parentNode;
+  /// scratch offsets of the query from the current cell
+  mutable RealArray queryOffsets;
+};
+
+
+inline SpatialIndex::SpatialIndex(size_t num_dim):
+  numDim(num_dim), rootNode(npos)
+{ }
+
+
+inline size_t SpatialIndex::size() const
+{ return radiusSq.size(); }
+
+
+inline size_t SpatialIndex::num_dimensions() const
+{ return numDim; }
+
+
+inline const Real* SpatialIndex::point(size_t i) const
+{ return &pointCoords[i*numDim]; }
+
+
+inline Real SpatialIndex::radius_sq(size_t i) const
+{ return radiusSq[i]; }
+
+
+inline bool SpatialIndex::scan_preferred() const
+{ return numDim < 64 && size() < (size_t(1) << numDim); }
+
+
+inline Real SpatialIndex::
+distance_sq(const Real* x, size_t i, size_t excluded_dim) const
+{
+  const Real* x_i = &pointCoords[i*numDim];
+  Real dist_sq = 0.;
+  for (size_t d=0; d<numDim; ++d)
+    if (d != excluded_dim)
+      { Real dx = x[d] - x_i[d]; dist_sq += dx*dx; }
+  return dist_sq;
+}
+
+} // namespace Dakota
+
+#endif
@@ -0,0 +1,324 @@
+/*  _______________________________________________________________________
+
+    Dakota: Explore and predict with confidence.
+    Copyright 2014-2023
+    National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Dakota directory.
+    _______________________________________________________________________ */
+
+#include "StreamingSobolIndices.hpp"
+#include "WorkStealingThreadPool.hpp"
+#include "dakota_global_defs.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+
+namespace Dakota {
+
+namespace {
+
+/// evaluations buffered by update() before a block reduction
+const size_t SOBOL_BLOCK_EVALS = 4096;
+/// resamples reduced per task
+const size_t SOBOL_RESAMPLE_GROUP = 16;
+/// response functions reduced per task
+const size_t SOBOL_FN_GROUP = 32;
+/// length of the Poisson(1) distribution function table; larger
+/// counts have probability below 1e-19
+const size_t POISSON_TABLE_SIZE = 20;
+
+/// splitmix64 finalizer, a bijective mixing of 64-bit integers
+uint64_t mix_bits(uint64_t z)
+{
+  z += 0x9E3779B97F4A7C15ULL;
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+  return z ^ (z >> 31);
+}
+
+/// Poisson(1) distribution function at 0, 1, ..., POISSON_TABLE_SIZE-1
+struct PoissonTable
+{
+  PoissonTable()
+  {
+    Real pmf = std::exp(-1.);
+    cdf[0] = pmf;
+    for (size_t k=1; k<POISSON_TABLE_SIZE; ++k)
+      { pmf /= (Real)k; cdf[k] = cdf[k-1] + pmf; }
+  }
+  Real cdf[POISSON_TABLE_SIZE];
+};
+
+const PoissonTable poissonTable;
+
+}
+
+
+void StreamingSobolIndices::
+initialize(size_t num_fns, size_t num_vars, size_t num_samples,
+	   size_t num_bootstrap, unsigned int seed)
+{
+  numFns = num_fns;  numVars = num_vars;  numSamples = num_samples;
+  numBootstrap = num_bootstrap;  bootstrapSeed = seed;
+  numReduced = numPending = 0;
+  pendingVals.assign(SOBOL_BLOCK_EVALS * numFns, 0.);
+  samplesA.assign(numSamples * numFns, 0.);
+  samplesB.assign(numSamples * numFns, 0.);
+  fnShift.assign(numFns, 0.);
+
+  ResampleSums init_sums;
+  init_sums.weight = init_sums.sumA = init_sums.sumB = init_sums.sumSqA
+    = init_sums.sumSqB = 0.;
+  init_sums.sumY.assign(numVars, 0.);  init_sums.sumAD.assign(numVars, 0.);
+  init_sums.sumD.assign(numVars, 0.);  init_sums.sumSqD.assign(numVars, 0.);
+  resampleSums.assign((numBootstrap + 1) * numFns, init_sums);
+}
+
+
+void StreamingSobolIndices::clear()
+{
+  numFns = numVars = numSamples = numBootstrap = 0;
+  numReduced = numPending = 0;
+  RealArray().swap(pendingVals);
+  RealArray().swap(samplesA);
+  RealArray().swap(samplesB);
+  RealArray().swap(fnShift);
+  std::vector<ResampleSums>().swap(resampleSums);
+}
+
+
+void StreamingSobolIndices::update(const Real* fn_vals)
+{
+  if (num_evaluations() >= (numVars + 2) * numSamples) {
+    Cerr << "Error: more evaluations than the pick-and-freeze design in "
+	 << "StreamingSobolIndices::update()." << std::endl;
+    abort_handler(METHOD_ERROR);
+  }
+  std::copy(fn_vals, fn_vals + numFns, &pendingVals[numPending * numFns]);
+  if (++numPending == SOBOL_BLOCK_EVALS || complete())
+    flush();
+}
+
+
+void StreamingSobolIndices::update(const Real* fn_vals, size_t num_evals)
+{
+  if (num_evaluations() + num_evals > (numVars + 2) * numSamples) {
+    Cerr << "Error: more evaluations than the pick-and-freeze design in "
+	 << "StreamingSobolIndices::update()." << std::endl;
+    abort_handler(METHOD_ERROR);
+  }
+  flush();
+  reduce(fn_vals, numReduced, num_evals);
+  numReduced += num_evals;
+}
+
+
+void StreamingSobolIndices::flush()
+{
+  if (!numPending)
+    return;
+  reduce(&pendingVals[0], numReduced, numPending);
+  numReduced += numPending;
+  numPending = 0;
+}
+
+
+/** Inversion of the Poisson(1) distribution function at a uniform
+    variate hashed from (bootstrapSeed, b, j). */
+Real StreamingSobolIndices::resample_weight(size_t b, size_t j) const
+{
+  if (!b)
+    return 1.;
+  uint64_t bits = mix_bits(mix_bits(mix_bits(bootstrapSeed) + b) + j);
+  Real u = (Real)(bits >> 11) / 9007199254740992.; // [0,1) with 53 bits
+  size_t count = 0;
+  while (count < POISSON_TABLE_SIZE - 1 && u >= poissonTable.cdf[count])
+    ++count;
+  return (Real)count;
+}
+
+
+void StreamingSobolIndices::
+run_tasks(size_t num_tasks, const std::function<void(size_t)>& task)
+{ dakota::util::WorkStealingThreadPool::parallel_for(num_tasks, task); }
+
+
+/** Evaluations are split into runs of a single replicate.  A and B
+    values are stored first (the shifts are set from the first run of
+    A); the sums of each run, group of functions and group of resamples
+    are then disjoint and are reduced as independent tasks. */
+void StreamingSobolIndices::
+reduce(const Real* fn_vals, size_t first_eval, size_t num_evals)
+{
+  struct ReplicateRun
+  { size_t replicate, firstSample, numRunSamples; const Real* runVals; };
+  std::vector<ReplicateRun> runs;
+  size_t e, j, k;
+  for (e=0; e<num_evals; ) {
+    ReplicateRun run;
+    run.replicate     = (first_eval + e) / numSamples;
+    run.firstSample   = (first_eval + e) % numSamples;
+    run.numRunSamples = std::min(numSamples - run.firstSample, num_evals - e);
+    run.runVals       = fn_vals + e * numFns;
+    runs.push_back(run);
+    e += run.numRunSamples;
+  }
+
+  for (size_t r=0; r<runs.size(); ++r) {
+    const ReplicateRun& run = runs[r];
+    if (run.replicate >= 2)
+      continue;
+    if (run.replicate == 0 && run.firstSample == 0)
+      for (k=0; k<numFns; ++k) {
+	Real sum = 0.;
+	for (j=0; j<run.numRunSamples; ++j)
+	  sum += run.runVals[j * numFns + k];
+	fnShift[k] = sum / (Real)run.numRunSamples;
+      }
+    RealArray& samples = (run.replicate) ? samplesB : samplesA;
+    std::copy(run.runVals, run.runVals + run.numRunSamples * numFns,
+	      &samples[run.firstSample * numFns]);
+  }
+
+  // each weight is computed once per sample for a group of functions
+  size_t num_b_groups
+    = (numBootstrap + SOBOL_RESAMPLE_GROUP) / SOBOL_RESAMPLE_GROUP,
+    num_fn_groups = (numFns + SOBOL_FN_GROUP - 1) / SOBOL_FN_GROUP,
+    num_runs = runs.size();
+  run_tasks(num_runs * num_fn_groups * num_b_groups, [&](size_t t) {
+    const ReplicateRun& run = runs[t % num_runs];
+    size_t fn_group = (t / num_runs) % num_fn_groups,
+      b_group = t / (num_runs * num_fn_groups),
+      fn_start = fn_group * SOBOL_FN_GROUP,
+      fn_end = std::min(numFns, fn_start + SOBOL_FN_GROUP),
+      b_end = std::min(numBootstrap + 1, (b_group + 1) * SOBOL_RESAMPLE_GROUP),
+      i = run.replicate - 2, fn;
+    for (size_t b=b_group*SOBOL_RESAMPLE_GROUP; b<b_end; ++b) {
+      ResampleSums* sums = &resampleSums[b * numFns];
+      for (size_t s=0; s<run.numRunSamples; ++s) {
+	size_t sample = run.firstSample + s;
+	Real w = resample_weight(b, sample);
+	if (w == 0.)
+	  continue;
+	const Real* y = run.runVals + s * numFns;
+	if (run.replicate == 0)
+	  for (fn=fn_start; fn<fn_end; ++fn) {
+	    Real a = y[fn] - fnShift[fn];
+	    sums[fn].weight += w;  sums[fn].sumA += w * a;
+	    sums[fn].sumSqA += w * a * a;
+	  }
+	else if (run.replicate == 1)
+	  for (fn=fn_start; fn<fn_end; ++fn) {
+	    Real bv = y[fn] - fnShift[fn];
+	    sums[fn].sumB += w * bv;  sums[fn].sumSqB += w * bv * bv;
+	  }
+	else {
+	  const Real *a_vals = &samplesA[sample * numFns],
+	    *b_vals = &samplesB[sample * numFns];
+	  for (fn=fn_start; fn<fn_end; ++fn) {
+	    Real a = a_vals[fn] - fnShift[fn], diff = y[fn] - b_vals[fn];
+	    ResampleSums& fn_sums = sums[fn];
+	    fn_sums.sumY[i]   += w * (y[fn] - fnShift[fn]);
+	    fn_sums.sumAD[i]  += w * a * diff;
+	    fn_sums.sumD[i]   += w * diff;
+	    fn_sums.sumSqD[i] += w * diff * diff;
+	  }
+	}
+      }
+    }
+  });
+}
+
+
+/** The estimators of SensAnalysisGlobal (Saltelli et al. 2010, with
+    the variance of the A and B samples and the main effect centered on
+    the overall mean), with each sum weighted and about the shift. */
+void StreamingSobolIndices::
+estimate(const ResampleSums& sums, Real* main, Real* total) const
+{
+  Real w = sums.weight, mean_AB = (sums.sumA + sums.sumB) / (2. * w),
+    var = (sums.sumSqA + sums.sumSqB) / (2. * w) - mean_AB * mean_AB,
+    sum_all = sums.sumA + sums.sumB;
+  for (size_t i=0; i<numVars; ++i)
+    sum_all += sums.sumY[i];
+  Real overall_mean = sum_all / (w * (Real)(numVars + 2));
+  for (size_t i=0; i<numVars; ++i) {
+    main[i]  = ((sums.sumAD[i] - overall_mean * sums.sumD[i]) / w) / var;
+    total[i] = (sums.sumSqD[i] / (2. * w)) / var;
+  }
+}
+
+
+void StreamingSobolIndices::
+indices(RealVectorArray& main_effects, RealVectorArray& total_effects)
+{
+  flush();
+  main_effects.assign(numFns, RealVector(numVars));
+  total_effects.assign(numFns, RealVector(numVars));
+  RealArray main(numVars), total(numVars);
+  for (size_t k=0; k<numFns; ++k) {
+    estimate(resampleSums[k], &main[0], &total[0]);
+    for (size_t i=0; i<numVars; ++i)
+      { main_effects[k][i] = main[i]; total_effects[k][i] = total[i]; }
+  }
+}
+
+
+void StreamingSobolIndices::all_estimates(std::vector<RealArray>& estimates)
+{
+  flush();
+  size_t num_slots = (numBootstrap + 1) * numFns;
+  estimates.assign(num_slots, RealArray(2 * numVars));
+  run_tasks(num_slots, [&](size_t s) {
+    estimate(resampleSums[s], &estimates[s][0], &estimates[s][numVars]);
+  });
+}
+
+
+/** Percentile intervals over the bootstrap resamples, interpolating
+    between order statistics; resamples with no weight are omitted. */
+void StreamingSobolIndices::
+confidence_intervals(Real level, RealVectorArray& main_lower,
+		     RealVectorArray& main_upper, RealVectorArray& total_lower,
+		     RealVectorArray& total_upper)
+{
+  std::vector<RealArray> estimates;
+  all_estimates(estimates);
+  main_lower.assign(numFns, RealVector(numVars));
+  main_upper.assign(numFns, RealVector(numVars));
+  total_lower.assign(numFns, RealVector(numVars));
+  total_upper.assign(numFns, RealVector(numVars));
+
+  Real tail = (1. - level) / 2.;
+  run_tasks(numFns, [&](size_t k) {
+    RealArray values;
+    for (size_t v=0; v<2*numVars; ++v) {
+      values.clear();
+      for (size_t b=1; b<=numBootstrap; ++b)
+	if (resampleSums[b * numFns + k].weight > 0.)
+	  values.push_back(estimates[b * numFns + k][v]);
+      Real lower = std::numeric_limits<Real>::quiet_NaN(), upper = lower;
+      if (!values.empty()) {
+	std::sort(values.begin(), values.end());
+	Real pos_lo = tail * (Real)(values.size() - 1),
+	  pos_hi = (1. - tail) * (Real)(values.size() - 1);
+	size_t lo = (size_t)pos_lo, hi = (size_t)pos_hi;
+	lower = values[lo];  upper = values[hi];
+	if (lo + 1 < values.size())
+	  lower += (pos_lo - lo) * (values[lo + 1] - values[lo]);
+	if (hi + 1 < values.size())
+	  upper += (pos_hi - hi) * (values[hi + 1] - values[hi]);
+      }
+      if (v < numVars)
+	{ main_lower[k][v] = lower; main_upper[k][v] = upper; }
+      else
+	{ total_lower[k][v-numVars] = lower; total_upper[k][v-numVars] = upper; }
+    }
+  });
+}
+
+} // namespace Dakota
@@ -0,0 +1,182 @@
+/*  _______________________________________________________________________
+
+    Dakota: Explore and predict with confidence.
+    Copyright 2014-2023
+    National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Dakota directory.
+    _______________________________________________________________________ */
+
+#ifndef STREAMING_SOBOL_INDICES_H
+#define STREAMING_SOBOL_INDICES_H
+
+#include "dakota_data_types.hpp"
+
+#include <functional>
+
+namespace Dakota {
+
+/// Streaming pick-and-freeze estimation of Sobol' indices
+
+/** Accumulates the main and total effect estimators of Saltelli et
+    al. (2010) used by SensAnalysisGlobal as the evaluations of a
+    pick-and-freeze design complete, in the order generated by
+    Analyzer::get_vbd_parameter_sets(): numSamples evaluations of
+    sample matrix A, then numSamples of B, then numSamples of each A_B^i
+    (B with row i taken from A).  Only the A and B evaluations are
+    retained; each A_B^i evaluation is reduced into sums for input i
+    as it arrives.  Sums are taken about a shift per function (the mean
+    of its first block of A evaluations), so that centering on the
+    overall mean at the end loses no precision.
+
+    Bootstrap resamples weight each sample by a Poisson(1) count that
+    is a deterministic function of the seed, resample and sample index,
+    so every replicate of a sample carries the same weight without the
+    resamples being stored.  Evaluations are buffered into blocks, each
+    reduced in parallel over runs of one replicate (A, B or an input),
+    groups of functions and groups of resamples. */
+class StreamingSobolIndices
+{
+public:
+
+  //
+  //- Heading: Constructors and destructor
+  //
+
+  /// default constructor
+  StreamingSobolIndices();
+
+  //
+  //- Heading: Member functions
+  //
+
+  /// size the accumulators for num_samples samples per replicate and
+  /// num_bootstrap resamples, discarding previous data
+  void initialize(size_t num_fns, size_t num_vars, size_t num_samples,
+		  size_t num_bootstrap = 0, unsigned int seed = 1);
+  /// discard all data and release storage
+  void clear();
+
+  /// accumulate the function values of the next evaluation
+  void update(const RealVector& fn_vals);
+  /// accumulate the function values of the next evaluation
+  void update(const Real* fn_vals);
+  /// accumulate the next num_evals evaluations, whose function values
+  /// are stored contiguously by evaluation
+  void update(const Real* fn_vals, size_t num_evals);
+  /// reduce any buffered evaluations
+  void flush();
+
+  /// number of response functions
+  size_t num_functions() const;
+  /// number of input variables
+  size_t num_variables() const;
+  /// number of bootstrap resamples
+  size_t num_bootstrap() const;
+  /// number of evaluations accumulated
+  size_t num_evaluations() const;
+  /// whether all (num_vars + 2) * num_samples evaluations are accumulated
+  bool complete() const;
+
+  /// main and total effect indices, indexed [function][variable]
+  void indices(RealVectorArray& main_effects, RealVectorArray& total_effects);
+  /// bootstrap percentile intervals for the indices at the given
+  /// confidence level, indexed [function][variable]
+  void confidence_intervals(Real level, RealVectorArray& main_lower,
+			    RealVectorArray& main_upper,
+			    RealVectorArray& total_lower,
+			    RealVectorArray& total_upper);
+
+private:
+
+  /// weighted sums for one function and resample, about fnShift
+  struct ResampleSums
+  {
+    /// total sample weight
+    Real weight;
+    /// sums of shifted A and B values and of their squares
+    Real sumA, sumB, sumSqA, sumSqB;
+    /// per input i: sums of shifted A_B^i values, of (A - shift) times
+    /// the difference d = A_B^i - B, of d, and of d^2
+    RealArray sumY, sumAD, sumD, sumSqD;
+  };
+
+  //
+  //- Heading: Convenience functions
+  //
+
+  /// Poisson(1) weight of sample j in resample b (1 for b = 0)
+  Real resample_weight(size_t b, size_t j) const;
+  /// reduce num_evals evaluations starting from evaluation first_eval
+  void reduce(const Real* fn_vals, size_t first_eval, size_t num_evals);
+  /// apply task(t) for t in [0, num_tasks) on the shared kernel pool
+  void run_tasks(size_t num_tasks, const std::function<void(size_t)>& task);
+  /// main and total effect estimates (numVars each) from sums
+  void estimate(const ResampleSums& sums, Real* main, Real* total) const;
+  /// estimates for every resample, indexed [resample][function] with
+  /// numVars main then numVars total effects each
+  void all_estimates(std::vector<RealArray>& estimates);
+
+  //
+  //- Heading: Data
+  //
+
+  /// number of response functions
+  size_t numFns;
+  /// number of input variables
+  size_t numVars;
+  /// number of samples per replicate
+  size_t numSamples;
+  /// number of bootstrap resamples
+  size_t numBootstrap;
+  /// seed of the resample weights
+  unsigned int bootstrapSeed;
+
+  /// number of evaluations reduced into resampleSums
+  size_t numReduced;
+  /// function values of buffered evaluations
+  RealArray pendingVals;
+  /// number of buffered evaluations
+  size_t numPending;
+
+  /// function values of the A and B samples, numFns per sample
+  RealArray samplesA, samplesB;
+  /// shift of each function's values in the sums
+  RealArray fnShift;
+  /// sums indexed [resample][function]; resample 0 is unweighted
+  std::vector<ResampleSums> resampleSums;
+};
+
+
+inline StreamingSobolIndices::StreamingSobolIndices():
+  numFns(0), numVars(0), numSamples(0), numBootstrap(0), bootstrapSeed(1),
+  numReduced(0), numPending(0)
+{ }
+
+
+inline void StreamingSobolIndices::update(const RealVector& fn_vals)
+{ update(fn_vals.values()); }
+
+
+inline size_t StreamingSobolIndices::num_functions() const
+{ return numFns; }
+
+
+inline size_t StreamingSobolIndices::num_variables() const
+{ return numVars; }
+
+
+inline size_t StreamingSobolIndices::num_bootstrap() const
+{ return numBootstrap; }
+
+
+inline size_t StreamingSobolIndices::num_evaluations() const
+{ return numReduced + numPending; }
+
+
+inline bool StreamingSobolIndices::complete() const
+{ return numFns && num_evaluations() == (numVars + 2) * numSamples; }
+
+} // namespace Dakota
+
+#endif // STREAMING_SOBOL_INDICES_H
@@ -0,0 +1,306 @@
+/*  _______________________________________________________________________
+
+    Dakota: Explore and predict with confidence.
+    Copyright 2014-2023
+    National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Dakota directory.
+    _______________________________________________________________________ */
+
+#include "StreamingStatistics.hpp"
+#include "dakota_global_defs.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+
+namespace Dakota {
+
+QuantileSketch::QuantileSketch(size_t capacity, unsigned int seed):
+  levelCapacity(std::max<size_t>(2, capacity + capacity % 2)),
+  levelItems(1), numSamples(0), maxRankError(0), offsetRNG(seed),
+  sortedCurrent(false)
+{ }
+
+
+void QuantileSketch::insert(Real x)
+{
+  levelItems[0].push_back(x);
+  ++numSamples;
+  sortedCurrent = false;
+  if (levelItems[0].size() >= levelCapacity)
+    compact_full_levels();
+}
+
+
+void QuantileSketch::merge(const QuantileSketch& other)
+{
+  size_t h, num_levels = other.levelItems.size();
+  if (levelItems.size() < num_levels)
+    levelItems.resize(num_levels);
+  for (h=0; h<num_levels; ++h)
+    levelItems[h].insert(levelItems[h].end(), other.levelItems[h].begin(),
+			 other.levelItems[h].end());
+  numSamples   += other.numSamples;
+  maxRankError += other.maxRankError;
+  sortedCurrent = false;
+  compact_full_levels();
+}
+
+
+void QuantileSketch::clear()
+{
+  levelItems.assign(1, RealArray());
+  numSamples = maxRankError = 0;
+  sortedCurrent = false;
+}
+
+
+size_t QuantileSketch::num_retained() const
+{
+  size_t num_items = 0;
+  for (size_t h=0; h<levelItems.size(); ++h)
+    num_items += levelItems[h].size();
+  return num_items;
+}
+
+
+void QuantileSketch::compact_full_levels()
+{
+  // compacting level h may fill level h+1, which is checked next
+  for (size_t h=0; h<levelItems.size(); ++h)
+    if (levelItems[h].size() >= levelCapacity)
+      compact(h);
+}
+
+
+/** Promotes every other item of the sorted level.  Each promoted item
+    carries the weight of the item skipped, so for any value y the
+    weight at or below y changes by at most the item weight 2^h.  An
+    odd item out is held back at level h to conserve total weight. */
+void QuantileSketch::compact(size_t h)
+{
+  if (levelItems.size() == h + 1)
+    levelItems.push_back(RealArray());
+  RealArray& items = levelItems[h];
+  RealArray& promoted = levelItems[h+1];
+
+  std::sort(items.begin(), items.end());
+  size_t k, num_items = items.size();
+  bool hold_back = (num_items % 2 == 1);
+  Real held;
+  if (hold_back)
+    { held = items.back(); --num_items; }
+
+  size_t offset = offsetRNG() & 1u;
+  for (k=offset; k<num_items; k+=2)
+    promoted.push_back(items[k]);
+
+  items.clear();
+  if (hold_back)
+    items.push_back(held);
+  maxRankError += size_t(1) << h;
+}
+
+
+void QuantileSketch::update_sorted() const
+{
+  std::vector<std::pair<Real, size_t> > weighted;
+  weighted.reserve(num_retained());
+  size_t h, k, weight;
+  for (h=0, weight=1; h<levelItems.size(); ++h, weight *= 2)
+    for (k=0; k<levelItems[h].size(); ++k)
+      weighted.push_back(std::make_pair(levelItems[h][k], weight));
+  std::sort(weighted.begin(), weighted.end());
+
+  size_t num_items = weighted.size(), cum_weight = 0;
+  sortedItems.resize(num_items);
+  cumulativeWeights.resize(num_items);
+  for (k=0; k<num_items; ++k) {
+    sortedItems[k] = weighted[k].first;
+    cumulativeWeights[k] = cum_weight += weighted[k].second;
+  }
+  sortedCurrent = true;
+}
+
+
+/** Returns the first retained item whose cumulative weight reaches r.
+    Without compactions every weight is one and this is the r-th entry
+    of the sorted samples. */
+Real QuantileSketch::order_statistic(size_t r) const
+{
+  if (!numSamples)
+    return std::numeric_limits<Real>::quiet_NaN();
+  if (!sortedCurrent)
+    update_sorted();
+  SizetArray::const_iterator it = std::lower_bound(cumulativeWeights.begin(),
+    cumulativeWeights.end(), std::max<size_t>(r, 1));
+  return (it == cumulativeWeights.end()) ? sortedItems.back() :
+    sortedItems[it - cumulativeWeights.begin()];
+}
+
+
+void StreamingStatistics::
+initialize(size_t num_fns, const RealVectorArray& bin_levels,
+	   const BoolDeque& sketch_fns, size_t sketch_size, unsigned int seed)
+{
+  fnAccumulators.assign(num_fns, FunctionAccumulator());
+  numObservations = 0;
+  for (size_t i=0; i<num_fns; ++i) {
+    FunctionAccumulator& acc = fnAccumulators[i];
+    if (i < bin_levels.size() && bin_levels[i].length()) {
+      const RealVector& levels_i = bin_levels[i];
+      acc.binLevels.assign(levels_i.values(),
+			   levels_i.values() + levels_i.length());
+      acc.binCounts.assign(acc.binLevels.size() + 1, 0);
+    }
+    if (i < sketch_fns.size() && sketch_fns[i]) {
+      acc.hasSketch = true;
+      acc.quantileSketch = QuantileSketch(sketch_size, seed + i);
+    }
+  }
+}
+
+
+void StreamingStatistics::update(const Real* fn_vals)
+{
+  ++numObservations;
+  size_t i, num_fns = fnAccumulators.size();
+  for (i=0; i<num_fns; ++i)
+    if (std::isfinite(fn_vals[i])) // neither NaN nor +/-Inf
+      accumulate(fnAccumulators[i], fn_vals[i]);
+}
+
+
+/** One-pass update of the mean and central moment sums (Terriberry's
+    extension of Welford's algorithm). */
+void StreamingStatistics::accumulate(FunctionAccumulator& acc, Real x)
+{
+  Real n1 = (Real)acc.numSamples, n = n1 + 1.,
+    delta = x - acc.mean, delta_n = delta / n, delta_n2 = delta_n * delta_n,
+    term1 = delta * delta_n * n1;
+  acc.mean += delta_n;
+  acc.m4 += term1 * delta_n2 * (n * n - 3. * n + 3.)
+    + 6. * delta_n2 * acc.m2 - 4. * delta_n * acc.m3;
+  acc.m3 += term1 * delta_n * (n - 2.) - 3. * delta_n * acc.m2;
+  acc.m2 += term1;
+  ++acc.numSamples;
+
+  if (x < acc.minimum) acc.minimum = x;
+  if (x > acc.maximum) acc.maximum = x;
+
+  // 1st bin from -inf to 1st level; last bin from last level to +inf
+  if (!acc.binCounts.empty()) {
+    size_t k, num_levels = acc.binLevels.size();
+    for (k=0; k<num_levels; ++k)
+      if (x <= acc.binLevels[k]) // cumulative p(g<=z)
+	break;
+    ++acc.binCounts[k];
+  }
+
+  if (acc.hasSketch)
+    acc.quantileSketch.insert(x);
+}
+
+
+/** Pairwise combination of moment sums (Pebay, SAND2008-6212). */
+void StreamingStatistics::merge(const StreamingStatistics& other)
+{
+  size_t i, k, num_fns = fnAccumulators.size();
+  if (other.fnAccumulators.size() != num_fns) {
+    Cerr << "Error: inconsistent number of functions in StreamingStatistics::"
+	 << "merge()." << std::endl;
+    abort_handler(METHOD_ERROR);
+  }
+
+  numObservations += other.numObservations;
+  for (i=0; i<num_fns; ++i) {
+    FunctionAccumulator& a = fnAccumulators[i];
+    const FunctionAccumulator& b = other.fnAccumulators[i];
+    if (a.binCounts.size() != b.binCounts.size() ||
+	a.hasSketch != b.hasSketch) {
+      Cerr << "Error: inconsistent accumulators in StreamingStatistics::"
+	   << "merge()." << std::endl;
+      abort_handler(METHOD_ERROR);
+    }
+    if (!b.numSamples)
+      continue;
+
+    if (!a.numSamples) {
+      a.mean = b.mean; a.m2 = b.m2; a.m3 = b.m3; a.m4 = b.m4;
+    }
+    else {
+      Real na = (Real)a.numSamples, nb = (Real)b.numSamples, n = na + nb,
+	delta = b.mean - a.mean, delta2 = delta * delta, na_nb = na * nb;
+      a.m4 += b.m4 + delta2 * delta2 * na_nb * (na * na - na_nb + nb * nb)
+	/ (n * n * n)
+	+ 6. * delta2 * (na * na * b.m2 + nb * nb * a.m2) / (n * n)
+	+ 4. * delta * (na * b.m3 - nb * a.m3) / n;
+      a.m3 += b.m3 + delta2 * delta * na_nb * (na - nb) / (n * n)
+	+ 3. * delta * (na * b.m2 - nb * a.m2) / n;
+      a.m2 += b.m2 + delta2 * na_nb / n;
+      a.mean += delta * nb / n;
+    }
+    a.numSamples += b.numSamples;
+
+    if (b.minimum < a.minimum) a.minimum = b.minimum;
+    if (b.maximum > a.maximum) a.maximum = b.maximum;
+    for (k=0; k<b.binCounts.size(); ++k)
+      a.binCounts[k] += b.binCounts[k];
+    if (a.hasSketch)
+      a.quantileSketch.merge(b.quantileSketch);
+  }
+}
+
+
+/** Central moments apply the bias corrections for an estimated mean
+    used by NonDEnsembleSampling::uncentered_to_centered().  Standardized
+    moments use the adjusted Fisher-Pearson skewness and the unbiased
+    excess kurtosis (sample-size corrected G1 and G2). */
+void StreamingStatistics::
+moments(size_t i, bool central, Real* moments_i) const
+{
+  const FunctionAccumulator& acc = fnAccumulators[i];
+  Real qnan = std::numeric_limits<Real>::quiet_NaN();
+  if (!acc.numSamples) {
+    for (size_t j=0; j<4; ++j)
+      moments_i[j] = qnan;
+    return;
+  }
+
+  Real ns = (Real)acc.numSamples, nm1 = ns - 1., nm2 = ns - 2.,
+    var = (acc.numSamples > 1) ? acc.m2 / nm1 : 0.;
+  moments_i[0] = acc.mean;
+  if (central) {
+    Real cm2 = acc.m2 / ns, cm3 = acc.m3 / ns, cm4 = acc.m4 / ns;
+    if (acc.numSamples > 3) {
+      Real n_sq = ns * ns;
+      cm2 = var;
+      cm3 *= n_sq / (nm1 * nm2);
+      cm4 = ( n_sq * ns * cm4 / nm1 - (6. * ns - 9.) * (n_sq - ns)
+	      / (n_sq - 2. * ns + 3) * cm2 * cm2 )
+	  / ( (n_sq - 3. * ns + 3.) - (6. * ns - 9.) * (n_sq - ns)
+	      / (ns * (n_sq - 2. * ns + 3.)) );
+    }
+    moments_i[1] = cm2; moments_i[2] = cm3; moments_i[3] = cm4;
+  }
+  else {
+    moments_i[1] = std::sqrt(var);
+    if (acc.m2 > 0. && acc.numSamples > 2) {
+      // G1 = g1 sqrt(n(n-1))/(n-2), g1 = (m3/n) / (m2/n)^1.5
+      Real cm2 = acc.m2 / ns;
+      moments_i[2] = acc.m3 / ns / std::pow(cm2, 1.5)
+	* std::sqrt(ns * nm1) / nm2;
+      // G2 = (n-1)/((n-2)(n-3)) ((n+1) g2 + 6), g2 = n m4 / m2^2 - 3
+      moments_i[3] = (acc.numSamples > 3) ?
+	nm1 / (nm2 * (ns - 3.))
+	* ( (ns + 1.) * ns * acc.m4 / (acc.m2 * acc.m2) - 3. * nm1 ) : qnan;
+    }
+    else
+      moments_i[2] = moments_i[3] = qnan;
+  }
+}
+
+} // namespace Dakota
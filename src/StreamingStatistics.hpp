@@ -0,0 +1,279 @@
+/*  _______________________________________________________________________
+
+    Dakota: Explore and predict with confidence.
+    Copyright 2014-2023
+    National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Dakota directory.
+    _______________________________________________________________________ */
+
+#ifndef STREAMING_STATISTICS_H
+#define STREAMING_STATISTICS_H
+
+#include "dakota_data_types.hpp"
+
+#include <cfloat>
+#include <boost/random/mersenne_twister.hpp>
+
+namespace Dakota {
+
+/// Mergeable quantile sketch with a guaranteed rank error bound
+
+/** Maintains a hierarchy of compactors: level h holds at most
+    levelCapacity items, each representing 2^h samples.  When a level
+    fills, it is sorted and every other item (starting at a random
+    offset) is promoted to the next level.  A compaction at level h
+    shifts the rank of any value by at most 2^h, so the accumulated
+    maxRankError is a deterministic bound on the rank error of every
+    order statistic returned.  Until the first compaction the sketch
+    holds every sample and order statistics are exact.  Memory is
+    O(levelCapacity * log2(n / levelCapacity)). */
+class QuantileSketch
+{
+public:
+
+  //
+  //- Heading: Constructors and destructor
+  //
+
+  /// constructor; capacity (rounded up to an even number >= 2) bounds
+  /// the number of items retained per level
+  QuantileSketch(size_t capacity = 4096, unsigned int seed = 1);
+
+  //
+  //- Heading: Member functions
+  //
+
+  /// add a sample
+  void insert(Real x);
+  /// combine with a sketch of another portion of the same population
+  void merge(const QuantileSketch& other);
+  /// discard all samples
+  void clear();
+
+  /// number of samples inserted
+  size_t count() const;
+  /// number of items currently retained
+  size_t num_retained() const;
+  /// bound on the rank error of any order statistic
+  size_t rank_error_bound() const;
+  /// whether order statistics are exact (no compaction has occurred)
+  bool exact() const;
+
+  /// r-th smallest sample (1 <= r <= count()), within rank_error_bound()
+  Real order_statistic(size_t r) const;
+
+private:
+
+  //
+  //- Heading: Convenience functions
+  //
+
+  /// halve level h into level h+1
+  void compact(size_t h);
+  /// compact every level that has reached capacity
+  void compact_full_levels();
+  /// assemble the retained items in sorted order with cumulative weights
+  void update_sorted() const;
+
+  //
+  //- Heading: Data
+  //
+
+  /// maximum number of items retained per level
+  size_t levelCapacity;
+  /// items per level; an item at level h represents 2^h samples
+  std::vector<RealArray> levelItems;
+  /// number of samples inserted
+  size_t numSamples;
+  /// accumulated rank error bound from all compactions
+  size_t maxRankError;
+  /// source of random compaction offsets
+  boost::mt19937 offsetRNG;
+
+  /// whether sortedItems/cumulativeWeights reflect the current levels
+  mutable bool sortedCurrent;
+  /// retained items in ascending order
+  mutable RealArray sortedItems;
+  /// cumulative sample weight through each of sortedItems
+  mutable SizetArray cumulativeWeights;
+};
+
+
+inline size_t QuantileSketch::count() const
+{ return numSamples; }
+
+
+inline size_t QuantileSketch::rank_error_bound() const
+{ return maxRankError; }
+
+
+inline bool QuantileSketch::exact() const
+{ return maxRankError == 0; }
+
+
+/// Single-pass accumulation of sampling statistics
+
+/** Updates the moments, extreme values, response level bins and
+    (optionally) a QuantileSketch for each response function as
+    evaluations complete, so that sampling statistics are available
+    without storing the sampled responses.  Non-finite function values
+    are treated as failed evaluations and omitted, consistent with the
+    stored-sample statistics in NonDSampling.  Moments use the one-pass
+    updates of Welford/Terriberry and the pairwise merge of Pebay
+    (Sandia report SAND2008-6212), which are numerically equivalent to
+    two-pass accumulation. */
+class StreamingStatistics
+{
+public:
+
+  //
+  //- Heading: Constructors and destructor
+  //
+
+  /// default constructor
+  StreamingStatistics();
+
+  //
+  //- Heading: Member functions
+  //
+
+  /// size the accumulators and discard previous data; bin_levels[i]
+  /// (possibly empty) defines the bins for function i and sketch_fns[i]
+  /// whether to maintain a quantile sketch for it
+  void initialize(size_t num_fns, const RealVectorArray& bin_levels,
+		  const BoolDeque& sketch_fns, size_t sketch_size = 4096,
+		  unsigned int seed = 1);
+
+  /// accumulate the function values from one evaluation
+  void update(const RealVector& fn_vals);
+  /// accumulate the function values from one evaluation
+  void update(const Real* fn_vals);
+  /// combine with statistics accumulated over other evaluations
+  void merge(const StreamingStatistics& other);
+
+  /// number of response functions
+  size_t num_functions() const;
+  /// number of evaluations accumulated (including failures)
+  size_t num_observations() const;
+  /// number of finite samples accumulated for function i
+  size_t count(size_t i) const;
+
+  /// smallest finite sample of function i
+  Real minimum(size_t i) const;
+  /// largest finite sample of function i
+  Real maximum(size_t i) const;
+
+  /// mean, variance and unbiased 3rd/4th central moments of function i
+  /// (central) or mean, standard deviation, skewness and excess
+  /// kurtosis (standardized)
+  void moments(size_t i, bool central, Real* moments_i) const;
+
+  /// counts of samples of function i in (-inf, z_0], (z_0, z_1], ...,
+  /// (z_last, inf) for its bin levels z (first match)
+  const SizetArray& bins(size_t i) const;
+
+  /// whether a quantile sketch is maintained for function i
+  bool has_sketch(size_t i) const;
+  /// r-th smallest finite sample of function i
+  Real order_statistic(size_t i, size_t r) const;
+  /// bound on the rank error of order_statistic(i, r)
+  size_t rank_error_bound(size_t i) const;
+  /// quantile sketch for function i
+  const QuantileSketch& sketch(size_t i) const;
+
+private:
+
+  /// running statistics for one response function
+  struct FunctionAccumulator
+  {
+    FunctionAccumulator(): numSamples(0), mean(0.), m2(0.), m3(0.), m4(0.),
+      minimum(DBL_MAX), maximum(-DBL_MAX), hasSketch(false)
+    { }
+
+    /// number of finite samples
+    size_t numSamples;
+    /// running mean
+    Real mean;
+    /// sums of 2nd, 3rd and 4th powers of deviations from the mean
+    Real m2, m3, m4;
+    /// extreme values
+    Real minimum, maximum;
+    /// response levels defining the bins
+    RealArray binLevels;
+    /// sample counts per bin (binLevels.size() + 1 entries when binning)
+    SizetArray binCounts;
+    /// whether quantileSketch is active
+    bool hasSketch;
+    /// order statistics for probability level mappings
+    QuantileSketch quantileSketch;
+  };
+
+  //
+  //- Heading: Convenience functions
+  //
+
+  /// add one finite sample to acc
+  static void accumulate(FunctionAccumulator& acc, Real x);
+
+  //
+  //- Heading: Data
+  //
+
+  /// per-function accumulators
+  std::vector<FunctionAccumulator> fnAccumulators;
+  /// number of evaluations accumulated
+  size_t numObservations;
+};
+
+
+inline StreamingStatistics::StreamingStatistics(): numObservations(0)
+{ }
+
+
+inline void StreamingStatistics::update(const RealVector& fn_vals)
+{ update(fn_vals.values()); }
+
+
+inline size_t StreamingStatistics::num_functions() const
+{ return fnAccumulators.size(); }
+
+
+inline size_t StreamingStatistics::num_observations() const
+{ return numObservations; }
+
+
+inline size_t StreamingStatistics::count(size_t i) const
+{ return fnAccumulators[i].numSamples; }
+
+
+inline Real StreamingStatistics::minimum(size_t i) const
+{ return fnAccumulators[i].minimum; }
+
+
+inline Real StreamingStatistics::maximum(size_t i) const
+{ return fnAccumulators[i].maximum; }
+
+
+inline const SizetArray& StreamingStatistics::bins(size_t i) const
+{ return fnAccumulators[i].binCounts; }
+
+
+inline bool StreamingStatistics::has_sketch(size_t i) const
+{ return fnAccumulators[i].hasSketch; }
+
+
+inline Real StreamingStatistics::order_statistic(size_t i, size_t r) const
+{ return fnAccumulators[i].quantileSketch.order_statistic(r); }
+
+
+inline size_t StreamingStatistics::rank_error_bound(size_t i) const
+{ return fnAccumulators[i].quantileSketch.rank_error_bound(); }
+
+
+inline const QuantileSketch& StreamingStatistics::sketch(size_t i) const
+{ return fnAccumulators[i].quantileSketch; }
+
+} // namespace Dakota
+
+#endif // STREAMING_STATISTICS_H
@@ -14,7 +14,7 @@
 #include "ProblemDescDB.hpp"
 #include "ParallelLibrary.hpp"
 #include "ParamResponsePair.hpp"
-#include "PRPMultiIndex.hpp"
+#include "PRPShardedCache.hpp"
 #include "DakotaGraphics.hpp"
 #include "RecastModel.hpp"
 #include "DiscrepancyCorrection.hpp"
@@ -29,8 +29,6 @@ static const char rcsId[]="@(#) $Id: SurrBasedLocalMinimizer.cpp 7031 2010-10-22
 
 namespace Dakota {
 
-extern PRPCache data_pairs;
-
 // initialization of statics
 SurrBasedLocalMinimizer* SurrBasedLocalMinimizer::sblmInstance(NULL);
 
@@ -1296,23 +1294,19 @@ find_response(const Variables& search_vars, Response& search_resp,
   // be different fn evals
   ActiveSet search_set = search_resp.active_set(); // copy
   search_set.request_values(1);
-  PRPCacheHIter cache_it
-    = lookup_by_val(data_pairs, search_id, search_vars, search_set);
-  if (cache_it != data_pairs.get<hashed>().end()) {
-    search_resp.function_values(cache_it->response().function_values());
+  ParamResponsePair cache_pr;
+  if (lookup_evaluation(search_id, search_vars, search_set, cache_pr)) {
+    search_resp.function_values(cache_pr.response().function_values());
     if (set_request & 2) {
       search_set.request_values(2);
-      cache_it = lookup_by_val(data_pairs, search_id, search_vars, search_set);
-      if (cache_it != data_pairs.get<hashed>().end()) {
+      if (lookup_evaluation(search_id, search_vars, search_set, cache_pr)) {
 	search_resp.function_gradients(
-	  cache_it->response().function_gradients());
+	  cache_pr.response().function_gradients());
 	if (set_request & 4) {
 	  search_set.request_values(4);
-	  cache_it
-	    = lookup_by_val(data_pairs, search_id, search_vars, search_set);
-	  if (cache_it != data_pairs.get<hashed>().end()) {
+	  if (lookup_evaluation(search_id, search_vars, search_set, cache_pr)) {
 	    search_resp.function_hessians(
-	      cache_it->response().function_hessians());
+	      cache_pr.response().function_hessians());
 	    found = true;
 	  }
 	}
@@ -0,0 +1,265 @@
+/*  _______________________________________________________________________
+
+    Dakota: Explore and predict with confidence.
+    Copyright 2014-2023
+    National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Dakota directory.
+    _______________________________________________________________________ */
+
+#include "TestDriverBatch.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+
+namespace Dakota {
+
+namespace {
+
+/// text_book exponent offset; must match TestDriverInterface
+const Real POW_VAL = 1.0;
+
+// Row accessors for the structure-of-arrays blocks
+inline const Real* row(const Real* a, size_t i, size_t num_pts)
+{ return a + i*num_pts; }
+
+inline Real* row(Real* a, size_t i, size_t num_pts)
+{ return a + i*num_pts; }
+
+
+/// text_book: f = sum (x_i - POW_VAL)^4, c1 = x1^2 - x2/2, c2 = x2^2 - x1/2
+void text_book(size_t num_vars, size_t num_pts, const Real* x,
+	       size_t num_fns, Real* f)
+{
+  size_t i, p;
+  Real* f0 = row(f, 0, num_pts);
+  std::fill(f0, f0 + num_pts, 0.);
+  for (i=0; i<num_vars; ++i) {
+    const Real* x_i = row(x, i, num_pts);
+    for (p=0; p<num_pts; ++p)
+      f0[p] += std::pow(x_i[p]-POW_VAL, 4);
+  }
+
+  const Real* x0 = row(x, 0, num_pts);
+  const Real* x1 = (num_vars > 1) ? row(x, 1, num_pts) : NULL;
+  if (num_fns > 1) {
+    Real* c1 = row(f, 1, num_pts);
+    for (p=0; p<num_pts; ++p)
+      c1[p] = 0. + x0[p]*x0[p];
+    if (x1)
+      for (p=0; p<num_pts; ++p)
+	c1[p] -= 0.5*x1[p];
+  }
+  if (num_fns > 2) {
+    Real* c2 = row(f, 2, num_pts);
+    for (p=0; p<num_pts; ++p)
+      c2[p] = 0. - 0.5*x0[p];
+    if (x1)
+      for (p=0; p<num_pts; ++p)
+	c2[p] += x1[p]*x1[p];
+  }
+}
+
+
+/// overlay of 2D Rosenbrock problems over the variable pairs (a, a+1),
+/// a = 0, stride, 2*stride, ...; pair k defines residuals 2k and 2k+1
+void rosenbrock_pairs(size_t num_pairs, size_t stride, size_t num_pts,
+		      const Real* x, size_t num_fns, Real* f)
+{
+  size_t k, p;
+  bool least_sq_flag = (num_fns > 1);
+  Real* f0 = row(f, 0, num_pts);
+  if (!least_sq_flag)
+    std::fill(f0, f0 + num_pts, 0.);
+  for (k=0; k<num_pairs; ++k) {
+    const Real* x_a = row(x, k*stride,   num_pts);
+    const Real* x_b = row(x, k*stride+1, num_pts);
+    if (least_sq_flag) {
+      Real* r1 = row(f, 2*k,   num_pts);
+      Real* r2 = row(f, 2*k+1, num_pts);
+      for (p=0; p<num_pts; ++p) {
+	r1[p] = 10.*(x_b[p] - x_a[p]*x_a[p]);
+	r2[p] = 1. - x_a[p];
+      }
+    }
+    else
+      for (p=0; p<num_pts; ++p) {
+	Real f1 = x_b[p] - x_a[p]*x_a[p], f2 = 1. - x_a[p];
+	f0[p] += 100.*f1*f1 + f2*f2;
+      }
+  }
+}
+
+
+/// 2D Rosenbrock (labeled variables x1, x2)
+void rosenbrock(size_t num_pts, const Real* x, size_t num_fns, Real* f)
+{
+  const Real* x1 = row(x, 0, num_pts);
+  const Real* x2 = row(x, 1, num_pts);
+  Real* f0 = row(f, 0, num_pts);
+  if (num_fns > 1) {
+    Real* f1 = row(f, 1, num_pts);
+    for (size_t p=0; p<num_pts; ++p) {
+      f0[p] = 10.*(x2[p]-x1[p]*x1[p]);
+      f1[p] = 1.-x1[p];
+    }
+  }
+  else
+    for (size_t p=0; p<num_pts; ++p) {
+      Real a = x2[p]-x1[p]*x1[p], b = 1.-x1[p];
+      f0[p] = 100.*a*a+b*b;
+    }
+}
+
+
+/// product over variables of a 1D function w, scaled by mult
+template <typename Fn1D>
+void separable_product(Real mult, size_t num_vars, size_t num_pts,
+		       const Real* x, Real* f, Fn1D w)
+{
+  Real* f0 = row(f, 0, num_pts);
+  std::fill(f0, f0 + num_pts, mult);
+  for (size_t i=0; i<num_vars; ++i) {
+    const Real* x_i = row(x, i, num_pts);
+    for (size_t p=0; p<num_pts; ++p)
+      f0[p] *= w(x_i[p]);
+  }
+}
+
+
+/// 1D Herbie (see TestDriverInterface::herbie1D())
+inline Real herbie_1d(Real x)
+{
+  Real r1 = x-1.0, r2 = x+1.0;
+  return std::exp(-r1*r1) + std::exp(-0.8*(r2*r2))
+    - 0.05*std::sin(8.0*(x+0.1));
+}
+
+
+/// 1D smooth Herbie (see TestDriverInterface::smooth_herbie1D())
+inline Real smooth_herbie_1d(Real x)
+{
+  Real r1 = x-1.0, r2 = x+1.0;
+  return std::exp(-r1*r1) + std::exp(-0.8*(r2*r2));
+}
+
+
+/// 1D Shubert (see TestDriverInterface::shubert1D())
+inline Real shubert_1d(Real x)
+{
+  Real w = 0.0;
+  for (size_t k=1; k<=5; ++k) {
+    Real k_real = static_cast<Real>(k);
+    w += k_real*std::cos(x*(k_real+1.0)+k_real);
+  }
+  return w;
+}
+
+
+/// Sobol rational function: f = (x2 + 0.5)^4 / (x1 + 0.5)^2
+void sobol_rational(size_t num_pts, const Real* x, Real* f)
+{
+  const Real* x1 = row(x, 0, num_pts);
+  const Real* x2 = row(x, 1, num_pts);
+  for (size_t p=0; p<num_pts; ++p)
+    f[p] = std::pow((x2[p] + 0.5), 4.) / std::pow((x1[p] + 0.5), 2.);
+}
+
+
+/// Sobol g-function
+void sobol_g_function(size_t num_vars, size_t num_pts, const Real* x, Real* f)
+{
+  const int a[] = {0,1,2,4,8,99,99,99,99,99};
+  std::fill(f, f + num_pts, 2.);
+  for (size_t i=0; i<num_vars; ++i) {
+    const Real* x_i = row(x, i, num_pts);
+    for (size_t p=0; p<num_pts; ++p)
+      f[p] *= ( std::abs(4.*x_i[p] - 2.) + a[i] ) / ( 1. + a[i] );
+  }
+}
+
+
+/// Ishigami function (labeled variables x1, x2, x3)
+void sobol_ishigami(size_t num_pts, const Real* x, Real* f)
+{
+  const Real pi = 3.14159265358979324;
+  const Real* x1 = row(x, 0, num_pts);
+  const Real* x2 = row(x, 1, num_pts);
+  const Real* x3 = row(x, 2, num_pts);
+  for (size_t p=0; p<num_pts; ++p)
+    f[p] = ( 1. + 0.1 * std::pow(2.*pi*x3[p] - pi, 4.0) ) *
+      std::sin(2.*pi*x1[p] - pi)
+      + 7. * std::pow(std::sin(2*pi*x2[p] - pi), 2.0);
+}
+
+} // anonymous namespace
+
+
+namespace TestDriverBatch {
+
+bool supported(driver_t driver, size_t num_vars, size_t num_fns)
+{
+  switch (driver) {
+#ifndef TB_EXPENSIVE
+  case TEXT_BOOK:
+    return (num_vars >= 1 && num_fns >= 1 && num_fns <= 3);
+#endif // TB_EXPENSIVE
+  case ROSENBROCK:
+    return (num_vars == 2 && (num_fns == 1 || num_fns == 2));
+  case GENERALIZED_ROSENBROCK:
+    return (num_vars >= 2 && (num_fns == 1 || num_fns == 2*(num_vars-1)));
+  case EXTENDED_ROSENBROCK:
+    return (num_vars >= 2 && num_vars % 2 == 0 &&
+	    (num_fns == 1 || num_fns == num_vars));
+  case HERBIE: case SMOOTH_HERBIE: case SHUBERT:
+    return (num_vars >= 1 && num_fns == 1);
+  case SOBOL_RATIONAL:
+    return (num_vars == 2 && num_fns == 1);
+  case SOBOL_G_FUNCTION:
+    return (num_vars >= 1 && num_vars <= 10 && num_fns == 1);
+  case SOBOL_ISHIGAMI:
+    return (num_vars == 3 && num_fns == 1);
+  default:
+    return false;
+  }
+}
+
+
+bool labeled_variables(driver_t driver)
+{ return (driver == ROSENBROCK || driver == SOBOL_ISHIGAMI); }
+
+
+void evaluate(driver_t driver, size_t num_vars, size_t num_pts,
+	      const Real* x, size_t num_fns, Real* f)
+{
+  switch (driver) {
+  case TEXT_BOOK:
+    text_book(num_vars, num_pts, x, num_fns, f);                     break;
+  case ROSENBROCK:
+    rosenbrock(num_pts, x, num_fns, f);                              break;
+  case GENERALIZED_ROSENBROCK:
+    rosenbrock_pairs(num_vars-1, 1, num_pts, x, num_fns, f);         break;
+  case EXTENDED_ROSENBROCK:
+    rosenbrock_pairs(num_vars/2, 2, num_pts, x, num_fns, f);         break;
+  case HERBIE:
+    separable_product(-1.0, num_vars, num_pts, x, f, herbie_1d);     break;
+  case SMOOTH_HERBIE:
+    separable_product(-1.0, num_vars, num_pts, x, f, smooth_herbie_1d);
+    break;
+  case SHUBERT:
+    separable_product(1.0, num_vars, num_pts, x, f, shubert_1d);     break;
+  case SOBOL_RATIONAL:
+    sobol_rational(num_pts, x, f);                                   break;
+  case SOBOL_G_FUNCTION:
+    sobol_g_function(num_vars, num_pts, x, f);                       break;
+  case SOBOL_ISHIGAMI:
+    sobol_ishigami(num_pts, x, f);                                   break;
+  default:
+    break;
+  }
+}
+
+} // namespace TestDriverBatch
+
+} // namespace Dakota
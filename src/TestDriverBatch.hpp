@@ -0,0 +1,50 @@
+/*  _______________________________________________________________________
+
+    Dakota: Explore and predict with confidence.
+    Copyright 2014-2023
+    National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Dakota directory.
+    _______________________________________________________________________ */
+
+#ifndef TEST_DRIVER_BATCH_H
+#define TEST_DRIVER_BATCH_H
+
+#include "DirectApplicInterface.hpp" // driver_t
+
+namespace Dakota {
+
+/// Vectorized value kernels for the algebraic test functions of
+/// TestDriverInterface
+
+/** Each kernel evaluates the response function values of a block of
+    num_pts points in structure-of-arrays layout: the points are
+    passed as x[v*num_pts + p] (one contiguous row per variable) and
+    the values returned as f[j*num_pts + p] (one contiguous row per
+    response function), such that the inner loops run over points
+    with unit stride.  Each kernel performs the floating point
+    operations of the corresponding TestDriverInterface driver in the
+    same order, so that the batch and per-evaluation paths agree.
+
+    Variables are ordered by position, except for the drivers that
+    TestDriverInterface resolves by label (rosenbrock and
+    sobol_ishigami), for which row v holds the variable labeled
+    x{v+1}. */
+namespace TestDriverBatch {
+
+/// whether driver has a batch kernel for the given problem dimensions
+bool supported(driver_t driver, size_t num_vars, size_t num_fns);
+
+/// whether the variables of driver are identified by label (x1, x2, ...)
+/// rather than by position
+bool labeled_variables(driver_t driver);
+
+/// evaluate the num_fns response values of driver at num_pts points
+void evaluate(driver_t driver, size_t num_vars, size_t num_pts,
+	      const Real* x, size_t num_fns, Real* f);
+
+} // namespace TestDriverBatch
+
+} // namespace Dakota
+
+#endif // TEST_DRIVER_BATCH_H
@@ -8,6 +8,7 @@
     _______________________________________________________________________ */
 
 #include "TestDriverInterface.hpp"
+#include "TestDriverBatch.hpp"
 #include "ParallelLibrary.hpp"
 #include "DataMethod.hpp"  // for output levels
 //#include <thread> // for sleep_for
@@ -368,6 +369,163 @@ int TestDriverInterface::derived_map_ac(const String& ac_name)
 }
 
 
+/** The reentrant drivers compute directly from the passed Variables
+    into the passed Response, bypassing set_local_data() and the
+    class-scope evaluation data shared by the other drivers. */
+bool TestDriverInterface::reentrant_map() const
+{
+  if (numAnalysisDrivers != 1 || iFilterType || oFilterType ||
+      multiProcAnalysisFlag)
+    return false;
+  switch (analysisDriverTypes[0]) {
+  case EXTENDED_ROSENBROCK: case GENERALIZED_ROSENBROCK: return true;
+  default:                                               return false;
+  }
+}
+
+
+/** Jobs requesting values only of a driver having a TestDriverBatch
+    kernel are packed into a structure-of-arrays block and evaluated
+    with one kernel call; remaining jobs (derivative requests, discrete
+    variables, unsupported drivers) use the per-evaluation path. */
+void TestDriverInterface::derived_map_batch(PRPQueue& prp_queue)
+{
+  if (prp_queue.empty())
+    return;
+  if (numAnalysisDrivers != 1 || iFilterType || oFilterType ||
+      multiProcAnalysisFlag) {
+    DirectApplicInterface::derived_map_batch(prp_queue);
+    return;
+  }
+
+  driver_t driver = analysisDriverTypes[0];
+  bool labeled = TestDriverBatch::labeled_variables(driver);
+  const Variables& vars0 = prp_queue.begin()->variables();
+  size_t i, p, num_v = (labeled) ? vars0.acv() : vars0.cv(),
+    num_fns = prp_queue.begin()->response().num_functions();
+  if (!TestDriverBatch::supported(driver, num_v, num_fns)) {
+    DirectApplicInterface::derived_map_batch(prp_queue);
+    return;
+  }
+
+  // rows of the labeled variables x1, x2, ... within the continuous array
+  SizetArray rows(num_v);
+  if (labeled) {
+    StringMultiArrayConstView acv_labels
+      = vars0.all_continuous_variable_labels();
+    std::map<String, var_t>::const_iterator v_iter;
+    for (i=0; i<num_v; ++i) {
+      v_iter = varTypeMap.find(acv_labels[i]);
+      if (v_iter == varTypeMap.end() || (size_t)v_iter->second >= num_v) {
+	DirectApplicInterface::derived_map_batch(prp_queue);
+	return;
+      }
+      rows[i] = v_iter->second;
+    }
+  }
+  else
+    for (i=0; i<num_v; ++i)
+      rows[i] = i;
+
+  // partition the queue into batchable and per-evaluation jobs
+  PRPQueue scalar_queue;
+  std::vector<const ParamResponsePair*> batch_prps;
+  batch_prps.reserve(prp_queue.size());
+  for (PRPQueueIter it=prp_queue.begin(); it!=prp_queue.end(); ++it) {
+    const Variables& vars = it->variables();
+    const ShortArray& asv = it->active_set().request_vector();
+    bool batch = (vars.adiv() + vars.adsv() + vars.adrv() == 0 &&
+		  ((labeled) ? vars.acv() : vars.cv()) == num_v &&
+		  asv.size() == num_fns);
+    for (i=0; batch && i<num_fns; ++i)
+      if (asv[i] & 6)
+	batch = false;
+    if (batch)
+      batch_prps.push_back(&(*it));
+    else
+      scalar_queue.insert(*it);
+  }
+
+  size_t num_pts = batch_prps.size();
+  if (num_pts) {
+    RealArray x(num_v*num_pts), f(num_fns*num_pts, 0.);
+    for (p=0; p<num_pts; ++p) {
+      const Variables& vars = batch_prps[p]->variables();
+      const RealVector& c_vars = (labeled) ? vars.all_continuous_variables()
+	: vars.continuous_variables();
+      for (i=0; i<num_v; ++i)
+	x[rows[i]*num_pts + p] = c_vars[i];
+    }
+
+    TestDriverBatch::evaluate(driver, num_v, num_pts, &x[0], num_fns, &f[0]);
+
+    for (p=0; p<num_pts; ++p) {
+      Response response = batch_prps[p]->response(); // shallow copy
+      const ShortArray& asv = response.active_set_request_vector();
+      RealVector fn_vals = response.function_values_view();
+      for (i=0; i<num_fns; ++i)
+	if (asv[i] & 1)
+	  fn_vals[i] = f[i*num_pts + p];
+    }
+  }
+
+  if (!scalar_queue.empty())
+    DirectApplicInterface::derived_map_batch(scalar_queue);
+}
+
+
+void TestDriverInterface::
+derived_map_reentrant(const Variables& vars, const ActiveSet& set,
+		      Response& response, int fn_eval_id)
+{
+  const RealVector& x = vars.continuous_variables();
+  const ShortArray& asv = set.request_vector();
+  const SizetArray& dvv = set.derivative_vector();
+  size_t i, num_v = x.length(), num_fns = asv.size();
+  bool deriv_flag = false, full_dvv = (dvv.size() == num_v);
+  for (i=0; i<num_fns; ++i)
+    if (asv[i] & 6)
+      deriv_flag = true;
+  SizetMultiArrayConstView cv_ids = vars.continuous_variable_ids();
+  for (i=0; full_dvv && i<num_v; ++i)
+    if (dvv[i] != cv_ids[i])
+      full_dvv = false;
+
+  driver_t driver = analysisDriverTypes[0];
+  const char* name = (driver == EXTENDED_ROSENBROCK) ?
+    "extended_rosenbrock" : "generalized_rosenbrock";
+  if (vars.discrete_int_variables().length() ||
+      vars.discrete_real_variables().length())
+    throw std::runtime_error(String("discrete variables not supported in ")
+			     + name + " direct fn.");
+  if (deriv_flag && !full_dvv)
+    throw std::runtime_error(String("DVV subsets not supported in ") + name
+			     + " direct fn.");
+  if ( (driver == EXTENDED_ROSENBROCK && (num_v % 2 || (num_fns != 1 &&
+	num_fns != num_v))) ||
+       (driver == GENERALIZED_ROSENBROCK && num_fns != 1 &&
+	num_fns != 2*(num_v-1)) )
+    throw std::runtime_error(String("Bad number of variables or functions in ")
+			     + name + " direct fn.");
+
+  // zero the requested data, since the kernel only defines non-zeros
+  bool least_sq_flag = (num_fns > 1);
+  RealVector fn_vals = response.function_values_view();
+  RealMatrix fn_grads = response.function_gradients_view();
+  RealSymMatrixArray fn_hessians = response.function_hessians_view();
+  for (i=0; i<num_fns; ++i) {
+    if (!least_sq_flag && (asv[i] & 1))
+      fn_vals[i] = 0.;
+    if (asv[i] & 2)
+      { RealVector grad = response.function_gradient_view(i); grad = 0.; }
+    if (asv[i] & 4)
+      fn_hessians[i] = 0.;
+  }
+  rosenbrock_overlay(driver == GENERALIZED_ROSENBROCK, x, asv, fn_vals,
+		     fn_grads, fn_hessians);
+}
+
+
 // -----------------------------------------
 // Begin direct interfaces to test functions
 // -----------------------------------------
@@ -1221,71 +1379,10 @@ int TestDriverInterface::generalized_rosenbrock()
     abort_handler(INTERFACE_ERROR);
   }
 
-  bool least_sq_flag = (numFns > 1);
-
   // This multidimensional extension results from the overlay of numVars-1
   // coupled 2D Rosenbrock problems.  When defining as a NLS problem,
   // residuals are paired and # residuals == 2 * (# vars - 1)
-
-  for (size_t i=1; i<numVars; ++i) {
-    size_t index_ip1 = i, index_i = i-1; // offset by 1
-    const Real& x_ip1 = xC[index_ip1];
-    const Real& x_i   = xC[index_i];
-    Real f1 = x_ip1 - x_i*x_i, f2 = 1. - x_i;
-
-    if (least_sq_flag) {
-      size_t rindex_2i = 2*i-1, rindex_2im1 = 2*i-2;
-
-      // **** R_2im1:
-      if (directFnASV[rindex_2im1] & 1)
-	fnVals[rindex_2im1] = 10.*f1;
-      // **** R_2i:
-      if (directFnASV[rindex_2i] & 1)
-	fnVals[rindex_2i] = f2;
-
-      // *** dR_2im1/dx:
-      if (directFnASV[rindex_2im1] & 2) { // define non-zeros (set_local_data)
-	Real* grad = fnGrads[rindex_2im1];
-	grad[index_i]   = -20.*x_i;
-	grad[index_ip1] =  10.;
-      }
-      // **** dR_2i/dx:
-      if (directFnASV[rindex_2i] & 2) { // define non-zeros (set_local_data)
-	Real* grad = fnGrads[rindex_2i];
-	grad[index_i]     = -1.;
-	//grad[index_ip1] =  0.;
-      }
-
-      // **** d^2R_2im1/dx^2:
-      if (directFnASV[rindex_2im1] & 4) // define non-zeros (set_local_data)
-	fnHessians[rindex_2im1](index_i,index_i) = -20.;
-      // **** d^2R_2i/dx^2:
-      if (directFnASV[rindex_2i] & 4)
-	fnHessians[rindex_2i] = 0.;
-
-    }
-    else {
-
-      // **** f:
-      if (directFnASV[0] & 1)
-	fnVals[0] += 100.*f1*f1 + f2*f2;
-
-      // **** df/dx:
-      if (directFnASV[0] & 2) {
-	fnGrads[0][index_i]   += -400.*f1*x_i - 2.*f2;
-	fnGrads[0][index_ip1] +=  200.*f1;
-      }
-
-      // **** d^2f/dx^2:
-      if (directFnASV[0] & 4) {
-	Real fx = x_ip1 - 3.*x_i*x_i;
-	fnHessians[0](index_i,index_i)     += -400.*fx + 2.0;
-	fnHessians[0](index_i,index_ip1)   += -400.*x_i;
-	fnHessians[0](index_ip1,index_i)   += -400.*x_i;
-	fnHessians[0](index_ip1,index_ip1) +=  200.;
-      }
-    }
-  }
+  rosenbrock_overlay(true, xC, directFnASV, fnVals, fnGrads, fnHessians);
 
   return 0; // no failure
 }
@@ -1322,68 +1419,82 @@ int TestDriverInterface::extended_rosenbrock()
   // This multidimensional extension results from the sum of numVars/2
   // uncoupled 2D Rosenbrock problems.  When defining as a NLS problem,
   // residuals are paired and # residuals == # vars
+  rosenbrock_overlay(false, xC, directFnASV, fnVals, fnGrads, fnHessians);
 
-  bool least_sq_flag = (numFns > 1);
-  Real alpha = 100., sqrt_alpha = 10.;
-  for (size_t i=1; i<=numVars/2; ++i) {
-    size_t index_2i = 2*i-1, index_2im1 = 2*i-2; // offset by 1
-    const Real& x_2i   = xC[index_2i];
-    const Real& x_2im1 = xC[index_2im1];
-    Real f1 = x_2i - x_2im1*x_2im1, f2 = 1. - x_2im1;
+  return 0; // no failure
+}
+
+
+void TestDriverInterface::
+rosenbrock_overlay(bool coupled, const RealVector& x, const ShortArray& asv,
+		   RealVector& fn_vals, RealMatrix& fn_grads,
+		   RealSymMatrixArray& fn_hessians)
+{
+  // 2D problems are defined in variable pairs (a, a+1) for a = 0,...,n-2
+  // (coupled) or a = 0,2,...,n-2 (uncoupled); in NLS form, pair k defines
+  // residuals 2k and 2k+1
+  size_t num_v = x.length(), stride = (coupled) ? 1 : 2,
+    num_pairs = (coupled) ? num_v - 1 : num_v / 2;
+  bool least_sq_flag = (asv.size() > 1);
+  for (size_t k=0; k<num_pairs; ++k) {
+    size_t a = k*stride, b = a+1;
+    const Real& x_a = x[a];
+    const Real& x_b = x[b];
+    Real f1 = x_b - x_a*x_a, f2 = 1. - x_a;
 
     if (least_sq_flag) {
+      size_t r1 = 2*k, r2 = 2*k+1;
 
-      // **** Residual R_2im1:
-      if (directFnASV[index_2im1] & 1)
-	fnVals[index_2im1] = sqrt_alpha*f1;
-      // **** Residual R_2i:
-      if (directFnASV[index_2i] & 1)
-	fnVals[index_2i] = f2;
+      // **** R_2im1:
+      if (asv[r1] & 1)
+	fn_vals[r1] = 10.*f1;
+      // **** R_2i:
+      if (asv[r2] & 1)
+	fn_vals[r2] = f2;
 
       // *** dR_2im1/dx:
-      if (directFnASV[index_2im1] & 2) { // define non-zeros (set_local_data)
-	Real* grad = fnGrads[index_2im1];
-	grad[index_2im1] = -2.*sqrt_alpha*x_2im1;
-	grad[index_2i]   =     sqrt_alpha;
+      if (asv[r1] & 2) { // define non-zeros
+	Real* grad = fn_grads[r1];
+	grad[a] = -20.*x_a;
+	grad[b] =  10.;
       }
       // **** dR_2i/dx:
-      if (directFnASV[index_2i] & 2) { // define non-zeros (set_local_data)
-	Real* grad = fnGrads[index_2i];
-	grad[index_2im1] = -1.;
-	//grad[index_2i] =  0.;
+      if (asv[r2] & 2) { // define non-zeros
+	Real* grad = fn_grads[r2];
+	grad[a] = -1.;
+	//grad[b] =  0.;
       }
 
       // **** d^2R_2im1/dx^2:
-      if (directFnASV[index_2im1] & 4) // define non-zeros (set_local_data)
-	fnHessians[index_2im1](index_2im1,index_2im1) = -2.*sqrt_alpha;
+      if (asv[r1] & 4) // define non-zeros
+	fn_hessians[r1](a,a) = -20.;
       // **** d^2R_2i/dx^2:
-      if (directFnASV[index_2i] & 4)
-	fnHessians[index_2i] = 0.;
+      if (asv[r2] & 4)
+	fn_hessians[r2] = 0.;
 
     }
     else {
+
       // **** f:
-      if (directFnASV[0] & 1)
-	fnVals[0] += alpha*f1*f1 + f2*f2;
+      if (asv[0] & 1)
+	fn_vals[0] += 100.*f1*f1 + f2*f2;
 
       // **** df/dx:
-      if (directFnASV[0] & 2) {
-	fnGrads[0][index_2im1] += -4.*alpha*f1*x_2im1 - 2.*f2;
-	fnGrads[0][index_2i]   +=  2.*alpha*f1;
+      if (asv[0] & 2) {
+	fn_grads[0][a] += -400.*f1*x_a - 2.*f2;
+	fn_grads[0][b] +=  200.*f1;
       }
 
       // **** d^2f/dx^2:
-      if (directFnASV[0] & 4) {
-	Real fx = x_2i - 3.*x_2im1*x_2im1;
-	fnHessians[0](index_2im1,index_2im1) += -4.*alpha*fx + 2.0;
-	fnHessians[0](index_2im1,index_2i)   += -4.*alpha*x_2im1;
-	fnHessians[0](index_2i,index_2im1)   += -4.*alpha*x_2im1;
-	fnHessians[0](index_2i,index_2i)     +=  2.*alpha;
+      if (asv[0] & 4) {
+	Real fx = x_b - 3.*x_a*x_a;
+	fn_hessians[0](a,a) += -400.*fx + 2.0;
+	fn_hessians[0](a,b) += -400.*x_a;
+	fn_hessians[0](b,a) += -400.*x_a;
+	fn_hessians[0](b,b) +=  200.;
       }
     }
   }
-
-  return 0; // no failure
 }
 
 
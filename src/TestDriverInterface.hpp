@@ -39,6 +39,15 @@ protected:
   /// execute an analysis code portion of a direct evaluation invocation
   virtual int derived_map_ac(const Dakota::String& ac_name);
 
+  /// true for the analysis drivers supporting derived_map_reentrant()
+  bool reentrant_map() const;
+  /// thread-safe evaluation of the scalable Rosenbrock drivers
+  void derived_map_reentrant(const Variables& vars, const ActiveSet& set,
+			     Response& response, int fn_eval_id);
+  /// evaluate value-only jobs of the algebraic drivers using the
+  /// vectorized TestDriverBatch kernels
+  void derived_map_batch(PRPQueue& prp_queue);
+
 private:
 
   //
@@ -67,6 +76,13 @@ private:
   /// term so that function can not be exactly approximated by a low degree polynomial
   int generalized_rosenbrock(); ///< n-dimensional Rosenbrock (Schittkowski)
   int extended_rosenbrock();    ///< n-dimensional Rosenbrock (Nocedal/Wright)
+  /// kernel shared by generalized_rosenbrock(), extended_rosenbrock(), and
+  /// derived_map_reentrant(): overlays coupled or uncoupled 2D Rosenbrock
+  /// problems, accumulating into fn data zeroed by the caller
+  static void rosenbrock_overlay(bool coupled, const RealVector& x,
+				 const ShortArray& asv, RealVector& fn_vals,
+				 RealMatrix& fn_grads,
+				 RealSymMatrixArray& fn_hessians);
   int lf_rosenbrock(); ///< a low fidelity version of the Rosenbrock function
   int extra_lf_rosenbrock(); ///< an extra low fidelity version of the Rosenbrock function
   int mf_rosenbrock(); ///< alternate Rosenbrock formulations for
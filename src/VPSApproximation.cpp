@@ -33,6 +33,8 @@ namespace Dakota
     /// default constructor
     VPSApproximation* VPSApproximation::VPSinstance(NULL);
 
+    bool VPSApproximation::bruteForceDefault(false);
+
     
     /// standard constructor (to call VPS from an input deck)
     
@@ -41,7 +43,8 @@ namespace Dakota
                                        const String& approx_label):
                                        Approximation(BaseConstructor(), problem_db, shared_data, approx_label),
                                        _disc_min_jump(problem_db.get_real("model.surrogate.discont_jump_thresh")),
-                                       _disc_min_grad(problem_db.get_real("model.surrogate.discont_grad_thresh"))
+                                       _disc_min_grad(problem_db.get_real("model.surrogate.discont_grad_thresh")),
+                                       _brute_force_queries(bruteForceDefault)
     {
 
         const String& surrogate_type = problem_db.get_string("model.surrogate.type");
@@ -81,7 +84,8 @@ namespace Dakota
     /// Alternate constructor (to call VPS from another method like POF-darts)
     
     VPSApproximation::VPSApproximation(const SharedApproxData& shared_data):
-                                       Approximation(NoDBBaseConstructor(), shared_data)
+                                       Approximation(NoDBBaseConstructor(), shared_data),
+                                       _brute_force_queries(bruteForceDefault)
     {
       std::shared_ptr<SharedSurfpackApproxData> dat =
 	std::static_pointer_cast<SharedSurfpackApproxData>(shared_data.data_rep());
@@ -593,6 +597,15 @@ namespace Dakota
         
         #endif
         
+        // index the scaled sample points (balanced, since data may arrive sorted)
+        RealArray index_points(_num_inserted_points * _n_dim);
+        for (size_t ipoint = 0; ipoint < _num_inserted_points; ipoint++)
+        {
+            for (size_t idim = 0; idim < _n_dim; idim++) index_points[ipoint * _n_dim + idim] = _sample_points[ipoint][idim];
+        }
+        _point_index.reset(_n_dim);
+        if (_num_inserted_points > 0) _point_index.build(&index_points[0], _num_inserted_points);
+        
         
         if (_vps_subsurrogate == LS)
         {
@@ -692,7 +705,8 @@ namespace Dakota
             
             // trim spoke using Voronoi faces
             size_t ineighbor(ipoint);
-            for (size_t jpoint = 0; jpoint < _num_inserted_points; jpoint++)
+            if (!_brute_force_queries) ineighbor = _point_index.trim_to_voronoi_cell(ipoint, tmp_pnt);
+            else for (size_t jpoint = 0; jpoint < _num_inserted_points; jpoint++)
             {
                 if (jpoint == ipoint) continue;
                 
@@ -1905,6 +1919,12 @@ namespace Dakota
     
     size_t VPSApproximation::retrieve_closest_cell(double* x)
     {
+        if (!_brute_force_queries && _point_index.size() == _num_inserted_points)
+        {
+            double dmin;
+            return _point_index.nearest(x, dmin);
+        }
+        
         size_t iclosest = _num_inserted_points;
         double dmin = DBL_MAX;
         for (size_t ipoint = 0; ipoint < _num_inserted_points; ipoint++)
@@ -15,6 +15,7 @@
 #include "DakotaApproximation.hpp"
 #include "SharedSurfpackApproxData.hpp"
 #include "pecos_data_types.hpp" // to identify SDVArrays and SDRArrays
+#include "SpatialIndex.hpp"
 
 namespace Dakota
 {
@@ -48,6 +49,11 @@ namespace Dakota
         /// destructor
         ~VPSApproximation();
 
+        /// scan all sample points instead of querying the spatial index in
+        /// subsequently constructed instances (validation of the index, e.g. in tests)
+        static void brute_force_queries(bool flag)
+        { bruteForceDefault = flag; }
+
 
     
         //////////////////////////////////////////////////////////////
@@ -243,6 +249,10 @@ private:
         
         double _f_min, _f_max; //minimum and maximum function values;
         
+        SpatialIndex _point_index; // k-d tree over the (scaled) sample points
+        bool _brute_force_queries; // scan all points instead of querying _point_index (validation)
+        static bool bruteForceDefault; // initial _brute_force_queries for new instances
+        
 
         ////////////////////////////////////////////////////////////////////////////////
         // Sub surrogate variables
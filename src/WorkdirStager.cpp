@@ -0,0 +1,375 @@
+/*  _______________________________________________________________________
+
+    Dakota: Explore and predict with confidence.
+    Copyright 2014-2023
+    National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Dakota directory.
+    _______________________________________________________________________ */
+
+#include "WorkdirStager.hpp"
+#include "dakota_global_defs.hpp"
+
+#include <cerrno>
+#include <chrono>
+#include <set>
+
+#if !defined(_WIN32) && !defined(_WIN64)
+  #include <fcntl.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+  #if defined(__linux__)
+    #include <sys/ioctl.h>
+    #include <linux/fs.h>            // for FICLONE
+  #elif defined(__APPLE__)
+    #include <sys/clonefile.h>
+  #endif
+#endif
+
+namespace Dakota {
+
+/// wall clock time in seconds, for timing staging operations
+static Real staging_time()
+{
+  typedef std::chrono::duration<Real> seconds;
+  return seconds(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+
+#if !defined(_WIN32) && !defined(_WIN64)
+#if defined(__APPLE__)
+  #define DAKOTA_STAT_ATIME st_atimespec
+  #define DAKOTA_STAT_MTIME st_mtimespec
+#else
+  #define DAKOTA_STAT_ATIME st_atim
+  #define DAKOTA_STAT_MTIME st_mtim
+#endif
+
+/// give dest the access and modification times of src, to the
+/// nanosecond (bfs::last_write_time() truncates to seconds, missing
+/// a change within the second a file was staged)
+static void copy_file_times(const bfs::path& src, const bfs::path& dest)
+{
+  struct stat src_stat;
+  struct timespec times[2];
+  bool copied = (stat(src.c_str(), &src_stat) == 0);
+  if (copied) {
+    times[0] = src_stat.DAKOTA_STAT_ATIME;
+    times[1] = src_stat.DAKOTA_STAT_MTIME;
+    copied = (utimensat(AT_FDCWD, dest.c_str(), times, 0) == 0);
+  }
+  if (!copied)
+    throw bfs::filesystem_error("cannot copy file times", src, dest,
+      boost::system::error_code(errno, boost::system::system_category()));
+}
+
+
+/** As WorkdirHelper::recursive_copy(), but the copies of regular
+    files carry the times of the template files, so that the staged
+    copies of the snapshot can be compared against it. */
+static bool snapshot_copy(const bfs::path& src_path, const bfs::path& dest_dir,
+			  bool overwrite)
+{
+  try {
+    bfs::path dest_path = dest_dir / src_path.filename();
+    if (bfs::exists(bfs::symlink_status(dest_path)))
+      return false;
+
+    bfs::file_status src_status = bfs::symlink_status(src_path);
+    if (bfs::is_symlink(src_status))
+      bfs::copy_symlink(src_path, dest_path);
+    else if (bfs::is_directory(src_status)) {
+      bfs::create_directory(dest_path);
+      bfs::directory_iterator dir_it(src_path), dir_end;
+      for ( ; dir_it != dir_end; ++dir_it)
+	snapshot_copy(dir_it->path(), dest_path, overwrite);
+    }
+    else {
+      bfs::copy_file(src_path, dest_path);
+      copy_file_times(src_path, dest_path);
+    }
+  }
+  catch (const bfs::filesystem_error& e) {
+    Cerr << "\nError: could not copy " << src_path << " into work directory "
+	 << "snapshot " << dest_dir << ";\n       " << e.what() << std::endl;
+    abort_handler(IO_ERROR);
+  }
+  return false;
+}
+
+
+/// remove the write permissions of the regular files below dir_path
+static void make_read_only(const bfs::path& dir_path)
+{
+  bfs::recursive_directory_iterator dir_it(dir_path), dir_end;
+  for ( ; dir_it != dir_end; ++dir_it)
+    if (bfs::is_regular_file(dir_it->symlink_status()))
+      bfs::permissions(dir_it->path(), bfs::remove_perms | bfs::owner_write |
+		       bfs::group_write | bfs::others_write);
+}
+#endif // !_WIN32 and !_WIN64
+
+
+WorkdirStager::
+WorkdirStager(const StringArray& link_files, const StringArray& copy_files,
+	      bool hardlinks, size_t pool_size):
+  linkFiles(link_files), copyFiles(copy_files), hardLinks(hardlinks),
+  tryClone(!hardlinks), poolSize(pool_size), poolCounter(0), snapshotTime(0.), lastStageTime(0.),
+  lastStageReused(false), totalStageTime(0.), totalRecycleTime(0.),
+  numStaged(0), numReused(0), numRecycled(0), numLinked(0), numCloned(0),
+  numCopied(0), numKept(0)
+{ }
+
+
+bool WorkdirStager::stage(const bfs::path& dest_dir, bool replace)
+{
+#if defined(_WIN32) || defined(_WIN64)
+  Real start = staging_time();
+  bool created = WorkdirHelper::create_directory(dest_dir, DIR_PERSIST);
+  WorkdirHelper::copy_items(copyFiles, dest_dir, replace);
+  WorkdirHelper::link_items(linkFiles, dest_dir, replace);
+  lastStageReused = false;
+#else
+  if (stagingRoot.empty()) {
+    Real start = staging_time();
+    prepare_snapshot(bfs::absolute(dest_dir).parent_path());
+    snapshotTime = staging_time() - start;
+  }
+
+  Real start = staging_time();
+  bool created = false;
+  lastStageReused = false;
+  try {
+    if (!bfs::exists(dest_dir) && !dirPool.empty()) {
+      bfs::path pooled_dir = dirPool.back();
+      dirPool.pop_back();
+      boost::system::error_code ec;
+      bfs::rename(pooled_dir, dest_dir, ec);
+      if (ec) // e.g., dest_dir on another file system: stage a new one
+	WorkdirHelper::recursive_remove(pooled_dir, FILEOP_WARN);
+      else {
+	refresh(snapshotDir, dest_dir, true, true);
+	created = lastStageReused = true;
+	++numReused;
+      }
+    }
+    if (!lastStageReused) {
+      created = WorkdirHelper::create_directory(dest_dir, DIR_PERSIST);
+      refresh(snapshotDir, dest_dir, replace, false);
+    }
+  }
+  catch (const bfs::filesystem_error& e) {
+    Cerr << "\nError: could not stage work directory " << dest_dir
+	 << ";\n       " << e.what() << std::endl;
+    abort_handler(IO_ERROR);
+  }
+#endif
+
+  lastStageTime = staging_time() - start;
+  totalStageTime += lastStageTime;
+  ++numStaged;
+  return created;
+}
+
+
+void WorkdirStager::recycle(const bfs::path& work_dir)
+{
+  Real start = staging_time();
+  bool pooled = false;
+#if !defined(_WIN32) && !defined(_WIN64)
+  if (dirPool.size() < poolSize && !stagingRoot.empty()) {
+    bfs::path pool_dir
+      = stagingRoot / ("pool." + std::to_string(++poolCounter));
+    boost::system::error_code ec;
+    bfs::rename(work_dir, pool_dir, ec);
+    if (!ec) {
+      dirPool.push_back(pool_dir);
+      ++numRecycled;
+      pooled = true;
+    }
+  }
+#endif
+  if (!pooled)
+    WorkdirHelper::recursive_remove(work_dir, FILEOP_ERROR);
+  totalRecycleTime += staging_time() - start;
+}
+
+
+void WorkdirStager::remove_staging_area()
+{
+  if (!stagingRoot.empty())
+    WorkdirHelper::recursive_remove(stagingRoot, FILEOP_SILENT);
+  stagingRoot.clear();
+  snapshotDir.clear();
+  dirPool.clear();
+}
+
+
+void WorkdirStager::print_summary(std::ostream& s) const
+{
+  if (!numStaged)
+    return;
+  s << "  Work directory staging: " << numStaged << " directories staged ("
+    << numReused << " from pool) in " << totalStageTime << " s, "
+    << totalStageTime / numStaged << " s per directory\n"
+    << "                          snapshot prepared in " << snapshotTime
+    << " s, " << numRecycled << " directories recycled in "
+    << totalRecycleTime << " s\n"
+    << "                          files: " << numLinked << " hardlinked, "
+    << numCloned << " cloned, " << numCopied << " copied, " << numKept
+    << " kept\n";
+}
+
+
+#if !defined(_WIN32) && !defined(_WIN64)
+void WorkdirStager::prepare_snapshot(const bfs::path& parent_dir)
+{
+  stagingRoot = parent_dir / WorkdirHelper::system_tmp_file("dakota_staging");
+  snapshotDir = stagingRoot / "snapshot";
+  WorkdirHelper::create_directory(snapshotDir, DIR_ERROR);
+
+  WorkdirHelper::file_op_items(&snapshot_copy, copyFiles, snapshotDir, false);
+  WorkdirHelper::link_items(linkFiles, snapshotDir, false);
+
+  if (hardLinks) {
+    try { make_read_only(snapshotDir); }
+    catch (const bfs::filesystem_error& e) {
+      Cerr << "\nError: could not protect work directory snapshot "
+	   << snapshotDir << ";\n       " << e.what() << std::endl;
+      abort_handler(IO_ERROR);
+    }
+  }
+}
+
+
+void WorkdirStager::instantiate(const bfs::path& src, const bfs::path& dest)
+{
+  bfs::file_status src_status = bfs::symlink_status(src);
+  if (bfs::is_symlink(src_status))
+    bfs::create_symlink(bfs::read_symlink(src), dest);
+  else if (bfs::is_directory(src_status)) {
+    bfs::create_directory(dest);
+    refresh(src, dest, false, false);
+  }
+  else
+    stage_file(src, dest);
+}
+
+
+void WorkdirStager::
+refresh(const bfs::path& src_dir, const bfs::path& dest_dir, bool replace,
+	bool remove_extra)
+{
+  std::set<bfs::path> src_names;
+  bfs::directory_iterator dir_it(src_dir), dir_end;
+  for ( ; dir_it != dir_end; ++dir_it) {
+    const bfs::path& src = dir_it->path();
+    bfs::path dest = dest_dir / src.filename();
+    if (remove_extra)
+      src_names.insert(src.filename());
+
+    bfs::file_status dest_status = bfs::symlink_status(dest);
+    if (!bfs::exists(dest_status))
+      instantiate(src, dest);
+    else if (bfs::is_directory(dest_status) &&
+	     bfs::is_directory(dir_it->symlink_status()))
+      refresh(src, dest, replace, remove_extra);
+    else if (!replace)
+      continue;
+    else if (unchanged(src, dest))
+      ++numKept;
+    else {
+      bfs::remove_all(dest);
+      instantiate(src, dest);
+    }
+  }
+
+  if (remove_extra) {
+    std::vector<bfs::path> extra_paths;
+    bfs::directory_iterator dest_it(dest_dir);
+    for ( ; dest_it != dir_end; ++dest_it)
+      if (!src_names.count(dest_it->path().filename()))
+	extra_paths.push_back(dest_it->path());
+    for (const bfs::path& extra : extra_paths)
+      bfs::remove_all(extra);
+  }
+}
+
+
+bool WorkdirStager::unchanged(const bfs::path& src, const bfs::path& dest) const
+{
+  bfs::file_status src_status = bfs::symlink_status(src),
+    dest_status = bfs::symlink_status(dest);
+  if (bfs::is_symlink(src_status))
+    return bfs::is_symlink(dest_status) &&
+      bfs::read_symlink(src) == bfs::read_symlink(dest);
+  else if (bfs::is_directory(src_status))
+    return bfs::is_directory(dest_status);
+  else if (!bfs::is_regular_file(dest_status))
+    return false;
+
+  struct stat src_stat, dest_stat;
+  if (stat(src.c_str(), &src_stat) != 0 || stat(dest.c_str(), &dest_stat) != 0)
+    return false;
+  if (hardLinks && src_stat.st_dev == dest_stat.st_dev &&
+      src_stat.st_ino == dest_stat.st_ino)
+    return true;
+  return src_stat.st_size == dest_stat.st_size &&
+    src_stat.st_mode == dest_stat.st_mode &&
+    src_stat.DAKOTA_STAT_MTIME.tv_sec  == dest_stat.DAKOTA_STAT_MTIME.tv_sec &&
+    src_stat.DAKOTA_STAT_MTIME.tv_nsec == dest_stat.DAKOTA_STAT_MTIME.tv_nsec;
+}
+
+
+/** Hardlinks or clones fall back to a copy when not supported, e.g.,
+    across file systems.  Copies carry the times and permissions of
+    the snapshot file, such that unchanged() recognizes them. */
+void WorkdirStager::stage_file(const bfs::path& src, const bfs::path& dest)
+{
+  if (hardLinks) {
+    boost::system::error_code ec;
+    bfs::create_hard_link(src, dest, ec);
+    if (!ec)
+      { ++numLinked; return; }
+  }
+
+  bool cloned = false;
+#if defined(__linux__) && defined(FICLONE)
+  if (tryClone) {
+    int src_fd = open(src.c_str(), O_RDONLY);
+    if (src_fd >= 0) {
+      int dest_fd = open(dest.c_str(), O_WRONLY | O_CREAT | O_EXCL, S_IRWXU);
+      if (dest_fd >= 0) {
+	cloned = (ioctl(dest_fd, FICLONE, src_fd) == 0);
+	if (!cloned && (errno == EOPNOTSUPP || errno == ENOTTY ||
+			errno == EINVAL || errno == EXDEV))
+	  tryClone = false;
+	close(dest_fd);
+	if (!cloned)
+	  unlink(dest.c_str());
+      }
+      close(src_fd);
+    }
+  }
+#elif defined(__APPLE__)
+  if (tryClone) {
+    cloned = (clonefile(src.c_str(), dest.c_str(), 0) == 0);
+    if (!cloned && (errno == ENOTSUP || errno == EXDEV))
+      tryClone = false;
+  }
+#else
+  tryClone = false;
+#endif
+
+  if (cloned)
+    ++numCloned;
+  else {
+    bfs::copy_file(src, dest);
+    ++numCopied;
+  }
+  bfs::permissions(dest, bfs::status(src).permissions());
+  copy_file_times(src, dest);
+}
+#endif // !_WIN32 and !_WIN64
+
+} // namespace Dakota
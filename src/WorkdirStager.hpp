@@ -0,0 +1,154 @@
+/*  _______________________________________________________________________
+
+    Dakota: Explore and predict with confidence.
+    Copyright 2014-2023
+    National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Dakota directory.
+    _______________________________________________________________________ */
+
+#ifndef WORKDIR_STAGER_H
+#define WORKDIR_STAGER_H
+
+#include "WorkdirHelper.hpp"
+
+#include <iostream>
+
+namespace Dakota {
+
+/// Staging of work directories from a snapshot of their template files
+
+/** Copies the copy_files and links the link_files of a work_directory
+    specification once, into a snapshot directory next to the work
+    directories, and instantiates each work directory from the
+    snapshot: subdirectories and symlinks are recreated, and files are
+    cloned (reflinked, copy-on-write where the filesystem supports it,
+    otherwise copied) or, with hardlinks, linked to the snapshot.
+    Snapshot files are made read-only in the hardlink case, so that a
+    driver modifying a staged file in place fails instead of altering
+    the snapshot for all evaluations.
+
+    Removed work directories are recycled into a pool rather than
+    deleted.  A directory taken from the pool is refreshed against the
+    snapshot: entries the evaluation added are removed and entries it
+    changed are staged again, while the unchanged remainder of the
+    template is kept.  A file counts as unchanged if it is the
+    snapshot's hardlink, or if its size, modification time and
+    permissions are those of the snapshot (staged copies carry the
+    snapshot's times, and the snapshot those of the template).
+
+    On Windows, work directories are copied and linked as without
+    staging, and removed rather than recycled. */
+class WorkdirStager
+{
+public:
+
+  //
+  //- Heading: Constructors and destructor
+  //
+
+  /// constructor; pool_size bounds the number of recycled directories
+  WorkdirStager(const StringArray& link_files, const StringArray& copy_files,
+		bool hardlinks, size_t pool_size);
+  /// destructor: removes the snapshot and the pool
+  ~WorkdirStager();
+
+  //
+  //- Heading: Member functions
+  //
+
+  /// create work directory dest_dir from the snapshot, preparing the
+  /// snapshot on first use; an existing dest_dir receives missing
+  /// template entries, and changed ones too if replace.  Returns true
+  /// if dest_dir was created.
+  bool stage(const bfs::path& dest_dir, bool replace);
+  /// return a work directory that is no longer needed to the pool, or
+  /// remove it if the pool is full
+  void recycle(const bfs::path& work_dir);
+  /// remove the snapshot and the pool
+  void remove_staging_area();
+
+  /// wall time in seconds of the last stage()
+  Real last_stage_time() const;
+  /// whether the last stage() reused a pooled directory
+  bool last_stage_reused() const;
+
+  /// print staging counts and times for the evaluation summary
+  void print_summary(std::ostream& s) const;
+
+private:
+
+  //
+  //- Heading: Convenience functions
+  //
+
+  /// copy the template items into a new snapshot within parent_dir
+  void prepare_snapshot(const bfs::path& parent_dir);
+  /// create dest as a staged copy of snapshot entry src
+  void instantiate(const bfs::path& src, const bfs::path& dest);
+  /// stage the entries of snapshot directory src_dir into dest_dir that
+  /// are missing or, if replace, changed; if remove_extra, remove entries
+  /// not in the snapshot
+  void refresh(const bfs::path& src_dir, const bfs::path& dest_dir,
+	       bool replace, bool remove_extra);
+  /// whether dest is an unchanged staged copy of snapshot entry src
+  /// (directories are compared by type only)
+  bool unchanged(const bfs::path& src, const bfs::path& dest) const;
+  /// stage regular file src as dest
+  void stage_file(const bfs::path& src, const bfs::path& dest);
+
+  //
+  //- Heading: Data
+  //
+
+  /// files to link into work directories
+  StringArray linkFiles;
+  /// files to copy into work directories
+  StringArray copyFiles;
+  /// whether staged files are hardlinks to the snapshot (else clones)
+  bool hardLinks;
+  /// whether to attempt clones; cleared once the file system refuses one
+  bool tryClone;
+  /// maximum number of directories held in the pool
+  size_t poolSize;
+
+  /// directory holding the snapshot and the pool (empty until prepared)
+  bfs::path stagingRoot;
+  /// snapshot of the template items
+  bfs::path snapshotDir;
+  /// recycled work directories, moved into stagingRoot
+  std::vector<bfs::path> dirPool;
+  /// counter naming pooled directories
+  size_t poolCounter;
+
+  /// wall time of preparing the snapshot
+  Real snapshotTime;
+  /// wall time and pool reuse of the last stage()
+  Real lastStageTime;
+  bool lastStageReused;
+  /// total wall times of stage() and recycle()
+  Real totalStageTime, totalRecycleTime;
+  /// number of directories staged and of these taken from the pool
+  size_t numStaged, numReused;
+  /// number of directories recycled into the pool
+  size_t numRecycled;
+  /// number of files hardlinked, cloned, copied (including fallbacks
+  /// from failed links and clones) and kept unchanged from the pool
+  size_t numLinked, numCloned, numCopied, numKept;
+};
+
+
+inline WorkdirStager::~WorkdirStager()
+{ remove_staging_area(); }
+
+
+inline Real WorkdirStager::last_stage_time() const
+{ return lastStageTime; }
+
+
+inline bool WorkdirStager::last_stage_reused() const
+{ return lastStageReused; }
+
+} // namespace Dakota
+
+#endif // WORKDIR_STAGER_H
@@ -10,6 +10,7 @@
 #include "DakotaUtils.hpp"
 #include "DartSerialDirectApplicInterface.hpp"
 #include "PRPMultiIndex.hpp"
+#include "PRPShardedCache.hpp"
 
 using namespace Dakota;
 
@@ -30,8 +31,10 @@ void DART::connect_plugin(Dakota::ProblemDescDB *problem_db, DART::DakotaFunctor
 namespace Dakota {
 
   extern PRPCache data_pairs;
+  extern PRPShardedCache sharded_data_pairs;
 };
 
 void DART::clear_prp_cache() {
   data_pairs.clear();
+  sharded_data_pairs.clear();
 }
@@ -0,0 +1,513 @@
+/*  _______________________________________________________________________
+
+    Dakota: Explore and predict with confidence.
+    Copyright 2014-2023
+    National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Dakota directory.
+    _______________________________________________________________________ */
+
+/** \file dakota_binary_files.h
+    Header-only C/C++ reader and writer for the binary parameters and
+    results files exchanged with analysis drivers by the system and fork
+    interfaces (interface keyword "binary").
+
+    Both files are sequences of self-contained records, one per
+    evaluation (a batch file holds several).  All integers are unsigned
+    little-endian, reals are little-endian IEEE-754 binary64, and a
+    string is a u64 byte count followed by the bytes (not NUL-terminated).
+
+    Parameters record:
+      char[4] "DKBP", u32 version, u32 flags (reserved, 0)
+      u64 num_cv, num_div, num_dsv, num_drv
+      string labels[num_cv + num_div + num_dsv + num_drv]
+      f64 cv[num_cv], i64 div[num_div], string dsv[num_dsv], f64 drv[num_drv]
+      u64 num_fns, string fn_labels[num_fns], u8 asv[num_fns]
+      u64 num_deriv_vars, u64 dvv[num_deriv_vars]
+        (1-based positions within cv; 0 if not a continuous variable)
+      u64 num_an_comps, string an_comps[num_an_comps]
+      string eval_id   (colon-separated, as in the text formats)
+      u64 num_metadata, string metadata_labels[num_metadata]
+
+    Results record:
+      char[4] "DKBR", u32 version, u32 flags (bit 0: evaluation failed, in
+        which case the record ends here)
+      u64 num_fns, num_deriv_vars, num_metadata
+      u8 contents[num_fns]   (ASV bits 1/2/4 of the data provided)
+      f64 values for each function whose contents include 1
+      f64[num_deriv_vars] gradient for each function whose contents include 2
+      f64[num_deriv_vars^2] Hessian, row-major, for each whose contents
+        include 4
+      f64 metadata[num_metadata]
+
+    Example analysis driver (error handling omitted):
+
+      dakota_bin_params p;
+      dakota_bin_read_params_file(argv[1], &p);
+      ... evaluate p.cv ..., fill values/gradients/hessians per p.asv
+      dakota_bin_results r = { p.num_fns, p.num_deriv_vars, p.num_metadata,
+                               p.asv, values, gradients, hessians, metadata };
+      FILE* f = fopen(argv[2], "wb");
+      dakota_bin_write_results(f, &r);
+      fclose(f);
+      dakota_bin_free_params(&p);
+*/
+
+#ifndef DAKOTA_BINARY_FILES_H
+#define DAKOTA_BINARY_FILES_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define DAKOTA_BIN_PARAMS_MAGIC  "DKBP"
+#define DAKOTA_BIN_RESULTS_MAGIC "DKBR"
+#define DAKOTA_BIN_VERSION 1u
+/** results flag: the evaluation failed (cf. "FAIL" in text results) */
+#define DAKOTA_BIN_FAILED 1u
+/** size of the magic, version and flags common to both records */
+#define DAKOTA_BIN_HEADER_SIZE 12u
+
+
+/* ---------------------------------------------------------------------
+   Byte order
+   --------------------------------------------------------------------- */
+
+/** whether the host stores integers and reals little-endian, in which case
+    arrays are transferred without conversion */
+static inline int dakota_bin_host_little_endian(void)
+{
+  const uint32_t one = 1;
+  unsigned char b;
+  memcpy(&b, &one, 1);
+  return b == 1;
+}
+
+static inline void dakota_bin_store_u32(unsigned char* dst, uint32_t v)
+{
+  dst[0] = (unsigned char)v;         dst[1] = (unsigned char)(v >> 8);
+  dst[2] = (unsigned char)(v >> 16); dst[3] = (unsigned char)(v >> 24);
+}
+
+static inline void dakota_bin_store_u64(unsigned char* dst, uint64_t v)
+{
+  dakota_bin_store_u32(dst, (uint32_t)v);
+  dakota_bin_store_u32(dst + 4, (uint32_t)(v >> 32));
+}
+
+static inline uint32_t dakota_bin_load_u32(const unsigned char* src)
+{
+  return (uint32_t)src[0] | ((uint32_t)src[1] << 8) |
+    ((uint32_t)src[2] << 16) | ((uint32_t)src[3] << 24);
+}
+
+static inline uint64_t dakota_bin_load_u64(const unsigned char* src)
+{
+  return (uint64_t)dakota_bin_load_u32(src) |
+    ((uint64_t)dakota_bin_load_u32(src + 4) << 32);
+}
+
+static inline double dakota_bin_load_f64(const unsigned char* src)
+{
+  uint64_t bits = dakota_bin_load_u64(src);
+  double v;
+  memcpy(&v, &bits, sizeof(v));
+  return v;
+}
+
+
+/* ---------------------------------------------------------------------
+   Writing (to a stdio stream)
+   --------------------------------------------------------------------- */
+
+/** write a record header; returns 0 on success */
+static inline int dakota_bin_write_header(FILE* f, const char* magic,
+					  uint32_t flags)
+{
+  unsigned char h[DAKOTA_BIN_HEADER_SIZE];
+  memcpy(h, magic, 4);
+  dakota_bin_store_u32(h + 4, DAKOTA_BIN_VERSION);
+  dakota_bin_store_u32(h + 8, flags);
+  return fwrite(h, 1, sizeof(h), f) == sizeof(h) ? 0 : -1;
+}
+
+static inline int dakota_bin_write_u64(FILE* f, uint64_t v)
+{
+  unsigned char b[8];
+  dakota_bin_store_u64(b, v);
+  return fwrite(b, 1, 8, f) == 8 ? 0 : -1;
+}
+
+/** write n reals; a single fwrite on little-endian hosts */
+static inline int dakota_bin_write_f64_array(FILE* f, const double* v,
+					     size_t n)
+{
+  unsigned char chunk[512];
+  size_t i, j, m;
+  if (dakota_bin_host_little_endian())
+    return fwrite(v, sizeof(double), n, f) == n ? 0 : -1;
+  for (i = 0; i < n; i += m) {
+    m = (n - i < 64) ? n - i : 64;
+    for (j = 0; j < m; ++j) {
+      uint64_t bits;
+      memcpy(&bits, v + i + j, 8);
+      dakota_bin_store_u64(chunk + 8*j, bits);
+    }
+    if (fwrite(chunk, 8, m, f) != m)
+      return -1;
+  }
+  return 0;
+}
+
+/** write n signed integers as i64 */
+static inline int dakota_bin_write_i64_array(FILE* f, const int64_t* v,
+					     size_t n)
+{
+  size_t i;
+  for (i = 0; i < n; ++i)
+    if (dakota_bin_write_u64(f, (uint64_t)v[i]))
+      return -1;
+  return 0;
+}
+
+static inline int dakota_bin_write_string(FILE* f, const char* s, size_t len)
+{
+  if (dakota_bin_write_u64(f, (uint64_t)len))
+    return -1;
+  return (len == 0 || fwrite(s, 1, len, f) == len) ? 0 : -1;
+}
+
+
+/** Response data for one results record.  values, gradients and hessians
+    are indexed by function (values[i], gradients + i*num_deriv_vars,
+    hessians + i*num_deriv_vars*num_deriv_vars); only the entries selected
+    by contents are written, and unused arrays may be NULL. */
+typedef struct {
+  uint64_t num_fns;
+  uint64_t num_deriv_vars;
+  uint64_t num_metadata;
+  const unsigned char* contents;
+  const double* values;
+  const double* gradients;
+  const double* hessians;
+  const double* metadata;
+} dakota_bin_results;
+
+/** write a complete results record; returns 0 on success */
+static inline int dakota_bin_write_results(FILE* f,
+					   const dakota_bin_results* r)
+{
+  uint64_t i, nd = r->num_deriv_vars;
+  if (dakota_bin_write_header(f, DAKOTA_BIN_RESULTS_MAGIC, 0) ||
+      dakota_bin_write_u64(f, r->num_fns) || dakota_bin_write_u64(f, nd) ||
+      dakota_bin_write_u64(f, r->num_metadata))
+    return -1;
+  if (r->num_fns &&
+      fwrite(r->contents, 1, (size_t)r->num_fns, f) != (size_t)r->num_fns)
+    return -1;
+  for (i = 0; i < r->num_fns; ++i)
+    if ((r->contents[i] & 1) &&
+	dakota_bin_write_f64_array(f, r->values + i, 1))
+      return -1;
+  for (i = 0; i < r->num_fns; ++i)
+    if ((r->contents[i] & 2) &&
+	dakota_bin_write_f64_array(f, r->gradients + i*nd, (size_t)nd))
+      return -1;
+  for (i = 0; i < r->num_fns; ++i)
+    if ((r->contents[i] & 4) &&
+	dakota_bin_write_f64_array(f, r->hessians + i*nd*nd, (size_t)(nd*nd)))
+      return -1;
+  return dakota_bin_write_f64_array(f, r->metadata, (size_t)r->num_metadata);
+}
+
+/** write a results record reporting a failed evaluation */
+static inline int dakota_bin_write_failure(FILE* f)
+{ return dakota_bin_write_header(f, DAKOTA_BIN_RESULTS_MAGIC,
+				 DAKOTA_BIN_FAILED); }
+
+
+/* ---------------------------------------------------------------------
+   Reading (from memory)
+   --------------------------------------------------------------------- */
+
+/** bounds-checked cursor over a buffer; error is set (and stays set) when
+    a read would pass the end */
+typedef struct {
+  const unsigned char* pos;
+  const unsigned char* end;
+  int error;
+} dakota_bin_reader;
+
+static inline void dakota_bin_reader_init(dakota_bin_reader* r,
+					  const void* data, size_t len)
+{
+  r->pos = (const unsigned char*)data;
+  r->end = r->pos + len;
+  r->error = 0;
+}
+
+/** claim n bytes; returns their start or NULL if unavailable */
+static inline const unsigned char* dakota_bin_take(dakota_bin_reader* r,
+						   uint64_t n)
+{
+  const unsigned char* p = r->pos;
+  if (r->error || n > (uint64_t)(r->end - r->pos))
+    { r->error = 1; return NULL; }
+  r->pos += n;
+  return p;
+}
+
+static inline uint64_t dakota_bin_read_u64(dakota_bin_reader* r)
+{
+  const unsigned char* p = dakota_bin_take(r, 8);
+  return p ? dakota_bin_load_u64(p) : 0;
+}
+
+static inline double dakota_bin_read_f64(dakota_bin_reader* r)
+{
+  const unsigned char* p = dakota_bin_take(r, 8);
+  return p ? dakota_bin_load_f64(p) : 0.;
+}
+
+/** read n reals into dst (which may be NULL to skip them) */
+static inline void dakota_bin_read_f64_array(dakota_bin_reader* r,
+					     double* dst, uint64_t n)
+{
+  const unsigned char* p;
+  uint64_t i;
+  if (n > (uint64_t)(r->end - r->pos) / 8)
+    { r->error = 1; return; }
+  p = dakota_bin_take(r, 8*n);
+  if (!p || !dst)
+    return;
+  if (dakota_bin_host_little_endian())
+    memcpy(dst, p, (size_t)(8*n));
+  else
+    for (i = 0; i < n; ++i)
+      dst[i] = dakota_bin_load_f64(p + 8*i);
+}
+
+/** read a string; returns a pointer into the buffer and sets *len */
+static inline const char* dakota_bin_read_string(dakota_bin_reader* r,
+						  size_t* len)
+{
+  uint64_t n = dakota_bin_read_u64(r);
+  const unsigned char* p = dakota_bin_take(r, n);
+  *len = p ? (size_t)n : 0;
+  return (const char*)p;
+}
+
+/** read and validate a record header: returns 0 on success, -1 for a
+    wrong signature or truncation, and -2 for an unsupported version */
+static inline int dakota_bin_read_header(dakota_bin_reader* r,
+					 const char* magic, uint32_t* flags)
+{
+  const unsigned char* h = dakota_bin_take(r, DAKOTA_BIN_HEADER_SIZE);
+  if (!h || memcmp(h, magic, 4) != 0)
+    return -1;
+  if (dakota_bin_load_u32(h + 4) != DAKOTA_BIN_VERSION)
+    return -2;
+  *flags = dakota_bin_load_u32(h + 8);
+  return 0;
+}
+
+/** size in bytes of the results record starting at data, or 0 if the
+    bytes available do not hold a complete record */
+static inline size_t dakota_bin_results_record_size(const void* data,
+						    size_t len)
+{
+  dakota_bin_reader r;
+  uint32_t flags;
+  uint64_t i, nf, nd, nm, num_reals = 0;
+  const unsigned char* contents;
+  dakota_bin_reader_init(&r, data, len);
+  if (dakota_bin_read_header(&r, DAKOTA_BIN_RESULTS_MAGIC, &flags))
+    return 0;
+  if (flags & DAKOTA_BIN_FAILED)
+    return DAKOTA_BIN_HEADER_SIZE;
+  nf = dakota_bin_read_u64(&r);
+  nd = dakota_bin_read_u64(&r);
+  nm = dakota_bin_read_u64(&r);
+  contents = dakota_bin_take(&r, nf);
+  if (!contents)
+    return 0;
+  for (i = 0; i < nf; ++i)
+    num_reals += ((contents[i] & 1) ? 1 : 0) + ((contents[i] & 2) ? nd : 0)
+      + ((contents[i] & 4) ? nd*nd : 0);
+  num_reals += nm;
+  if (num_reals > (uint64_t)(r.end - r.pos) / 8)
+    return 0;
+  return (size_t)(r.pos - (const unsigned char*)data) + (size_t)(8*num_reals);
+}
+
+
+/* ---------------------------------------------------------------------
+   Parameters for analysis drivers
+   --------------------------------------------------------------------- */
+
+/** Contents of one parameters record, with NUL-terminated copies of all
+    strings.  Variable labels are ordered cv, div, dsv, drv. */
+typedef struct {
+  uint64_t num_cv, num_div, num_dsv, num_drv;
+  char** labels;
+  double* cv;
+  int64_t* div;
+  char** dsv;
+  double* drv;
+  uint64_t num_fns;
+  char** fn_labels;
+  unsigned char* asv;
+  uint64_t num_deriv_vars;
+  uint64_t* dvv;
+  uint64_t num_an_comps;
+  char** an_comps;
+  char* eval_id;
+  uint64_t num_metadata;
+  char** metadata_labels;
+} dakota_bin_params;
+
+/** release the storage of a parameters record */
+static inline void dakota_bin_free_params(dakota_bin_params* p)
+{
+  uint64_t i, nv = p->num_cv + p->num_div + p->num_dsv + p->num_drv;
+  if (p->labels)
+    for (i = 0; i < nv; ++i) free(p->labels[i]);
+  if (p->dsv)
+    for (i = 0; i < p->num_dsv; ++i) free(p->dsv[i]);
+  if (p->fn_labels)
+    for (i = 0; i < p->num_fns; ++i) free(p->fn_labels[i]);
+  if (p->an_comps)
+    for (i = 0; i < p->num_an_comps; ++i) free(p->an_comps[i]);
+  if (p->metadata_labels)
+    for (i = 0; i < p->num_metadata; ++i) free(p->metadata_labels[i]);
+  free(p->labels); free(p->cv); free(p->div); free(p->dsv); free(p->drv);
+  free(p->fn_labels); free(p->asv); free(p->dvv); free(p->an_comps);
+  free(p->eval_id); free(p->metadata_labels);
+  memset(p, 0, sizeof(*p));
+}
+
+/** NUL-terminated copy of the next string, or NULL on error */
+static inline char* dakota_bin_dup_string(dakota_bin_reader* r)
+{
+  size_t len;
+  const char* s = dakota_bin_read_string(r, &len);
+  char* c;
+  if (r->error || !(c = (char*)malloc(len + 1)))
+    { r->error = 1; return NULL; }
+  if (len)
+    memcpy(c, s, len);
+  c[len] = '\0';
+  return c;
+}
+
+/** read n strings into a new array (zero-filled, for safe release) */
+static inline char** dakota_bin_dup_strings(dakota_bin_reader* r, uint64_t n)
+{
+  uint64_t i;
+  char** a;
+  if (n > (uint64_t)(r->end - r->pos) / 8) /* each needs its length */
+    { r->error = 1; return NULL; }
+  a = (char**)calloc((size_t)n + 1, sizeof(char*));
+  if (!a)
+    { r->error = 1; return NULL; }
+  for (i = 0; i < n && !r->error; ++i)
+    a[i] = dakota_bin_dup_string(r);
+  return a;
+}
+
+/** parse one parameters record; returns the number of bytes consumed, or
+    0 on error (in which case p holds nothing to release) */
+static inline size_t dakota_bin_parse_params(const void* data, size_t len,
+					     dakota_bin_params* p)
+{
+  dakota_bin_reader r;
+  uint32_t flags;
+  uint64_t i, nv;
+  memset(p, 0, sizeof(*p));
+  dakota_bin_reader_init(&r, data, len);
+  if (dakota_bin_read_header(&r, DAKOTA_BIN_PARAMS_MAGIC, &flags))
+    return 0;
+  p->num_cv  = dakota_bin_read_u64(&r);
+  p->num_div = dakota_bin_read_u64(&r);
+  p->num_dsv = dakota_bin_read_u64(&r);
+  p->num_drv = dakota_bin_read_u64(&r);
+  nv = p->num_cv + p->num_div + p->num_dsv + p->num_drv;
+  if (r.error || nv > (uint64_t)(r.end - r.pos) / 8)
+    return 0;
+  p->labels = dakota_bin_dup_strings(&r, nv);
+  if (!r.error && p->num_cv <= (uint64_t)(r.end - r.pos) / 8) {
+    p->cv = (double*)malloc((size_t)(8*p->num_cv) + 1);
+    dakota_bin_read_f64_array(&r, p->cv, p->num_cv);
+  }
+  else r.error = 1;
+  if (!r.error && p->num_div <= (uint64_t)(r.end - r.pos) / 8) {
+    p->div = (int64_t*)malloc((size_t)(8*p->num_div) + 1);
+    for (i = 0; i < p->num_div; ++i)
+      p->div[i] = (int64_t)dakota_bin_read_u64(&r);
+  }
+  else r.error = 1;
+  if (!r.error)
+    p->dsv = dakota_bin_dup_strings(&r, p->num_dsv);
+  if (!r.error && p->num_drv <= (uint64_t)(r.end - r.pos) / 8) {
+    p->drv = (double*)malloc((size_t)(8*p->num_drv) + 1);
+    dakota_bin_read_f64_array(&r, p->drv, p->num_drv);
+  }
+  else r.error = 1;
+
+  p->num_fns = dakota_bin_read_u64(&r);
+  if (!r.error)
+    p->fn_labels = dakota_bin_dup_strings(&r, p->num_fns);
+  if (!r.error) {
+    const unsigned char* asv = dakota_bin_take(&r, p->num_fns);
+    if (asv) {
+      p->asv = (unsigned char*)malloc((size_t)p->num_fns + 1);
+      memcpy(p->asv, asv, (size_t)p->num_fns);
+    }
+  }
+  p->num_deriv_vars = dakota_bin_read_u64(&r);
+  if (!r.error && p->num_deriv_vars <= (uint64_t)(r.end - r.pos) / 8) {
+    p->dvv = (uint64_t*)malloc((size_t)(8*p->num_deriv_vars) + 1);
+    for (i = 0; i < p->num_deriv_vars; ++i)
+      p->dvv[i] = dakota_bin_read_u64(&r);
+  }
+  else r.error = 1;
+  p->num_an_comps = dakota_bin_read_u64(&r);
+  if (!r.error)
+    p->an_comps = dakota_bin_dup_strings(&r, p->num_an_comps);
+  if (!r.error)
+    p->eval_id = dakota_bin_dup_string(&r);
+  p->num_metadata = dakota_bin_read_u64(&r);
+  if (!r.error)
+    p->metadata_labels = dakota_bin_dup_strings(&r, p->num_metadata);
+
+  if (r.error) {
+    /* counts not yet read are zero, so release matches allocation */
+    dakota_bin_free_params(p);
+    return 0;
+  }
+  return (size_t)(r.pos - (const unsigned char*)data);
+}
+
+/** read the first parameters record of a file; returns 0 on success */
+static inline int dakota_bin_read_params_file(const char* path,
+					      dakota_bin_params* p)
+{
+  FILE* f = fopen(path, "rb");
+  long len;
+  void* data;
+  size_t used = 0;
+  memset(p, 0, sizeof(*p));
+  if (!f)
+    return -1;
+  if (fseek(f, 0, SEEK_END) == 0 && (len = ftell(f)) > 0 &&
+      fseek(f, 0, SEEK_SET) == 0 && (data = malloc((size_t)len)) != NULL) {
+    if (fread(data, 1, (size_t)len, f) == (size_t)len)
+      used = dakota_bin_parse_params(data, (size_t)len, p);
+    free(data);
+  }
+  fclose(f);
+  return used ? 0 : -1;
+}
+
+#endif /* DAKOTA_BINARY_FILES_H */
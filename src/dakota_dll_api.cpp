@@ -16,6 +16,7 @@
 #include "LibraryEnvironment.hpp"
 #include "ProblemDescDB.hpp"
 #include "PRPMultiIndex.hpp"
+#include "PRPShardedCache.hpp"
 #include "DakotaModel.hpp"
 #include "DakotaInterface.hpp"
 #include "PluginSerialDirectApplicInterface.hpp"
@@ -30,6 +31,7 @@
 
 namespace Dakota {
   extern PRPCache data_pairs;
+  extern PRPShardedCache sharded_data_pairs;
 }
 
 using namespace Dakota;
@@ -224,6 +226,7 @@ void DakotaRunner::start()
     // Ideally, we'd manage this with interface IDs from the caller
     // instead of this aggressive clear.
     data_pairs.clear();
+    sharded_data_pairs.clear();
 
     dakotaEnv->execute();
 
@@ -12,6 +12,7 @@
 #include "dakota_global_defs.hpp"
 #include "ParamResponsePair.hpp"
 #include "PRPMultiIndex.hpp"
+#include "PRPShardedCache.hpp"
 #include "DakotaGraphics.hpp"
 #include "DakotaInterface.hpp"
 #include "ParallelLibrary.hpp"
@@ -56,6 +57,8 @@ std::ostream* dakota_cerr = &std::cerr; ///< DAKOTA stderr initially points to
   ///< std::cerr, but may be redirected to a tagged ofstream if there are
   ///< concurrent iterators.
 PRPCache data_pairs;          ///< contains all parameter/response pairs.
+PRPShardedCache sharded_data_pairs; ///< thread-safe alternative to data_pairs
+                              ///< for interfaces using a sharded cache.
 
 /// Global results database for iterator results
 ResultsManager iterator_results_db;
@@ -98,6 +101,7 @@ void abort_handler(int code)
   // Clean up
   Cout << std::flush; // flush cout or ofstream redirection
   Cerr << std::flush; // flush cerr or ofstream redirection
+  evaluation_store_db.flush(); // commit buffered HDF5 evaluations
   iterator_results_db.close(); // flush output files/databases 
 
   if (Dak_pddb) {
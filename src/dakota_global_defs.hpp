@@ -141,8 +141,12 @@ enum { TABULAR_NONE = 0, TABULAR_HEADER = 1,
 /// Results output format
 enum { RESULTS_OUTPUT_TEXT = 1, RESULTS_OUTPUT_HDF5 = 2};
 
+/// policies for committing restart records to disk
+enum { RESTART_COMMIT_EVERY_EVAL = 0, RESTART_COMMIT_EVALS,
+       RESTART_COMMIT_SECONDS, RESTART_COMMIT_CHECKPOINT };
+
 /// options for results file format
-enum {FLEXIBLE_RESULTS, LABELED_RESULTS};
+enum {FLEXIBLE_RESULTS, LABELED_RESULTS, BINARY_RESULTS};
 
 /// define special values for surrogateExportFormats
 enum { NO_MODEL_FORMAT=0, TEXT_ARCHIVE=1, BINARY_ARCHIVE=2, ALGEBRAIC_FILE=4,
@@ -18,6 +18,10 @@
 #include "ParamResponsePair.hpp"
 #include "PRPMultiIndex.hpp"
 #include "RestartVersion.hpp"
+#include "IndexedRestart.hpp"
+#include "OutputManager.hpp"
+#include <chrono>
+#include <memory>
 #ifdef HAVE_PDB_H
 #include <pdb.h>
 #endif
@@ -46,6 +50,97 @@ void read_neutral(StringArray pos_args);
 void repair_restart(StringArray pos_args, String identifier_type);
 /// concatenate multiple restart files
 void concatenate_restart(StringArray pos_args);
+/// convert a restart file between the sequential and indexed formats
+void convert_restart(StringArray pos_args, bool to_indexed);
+
+
+/// Sequential access to the records of a restart file in either format
+
+/** Encapsulates the version check and the format-specific reading of
+    the records, which are returned in file order. */
+class RestartFileReader
+{
+public:
+
+  /// open read_restart_filename, checking its version and format
+  RestartFileReader(const String& read_restart_filename);
+
+  /// read the next record into prp; returns false if none remain
+  bool read(ParamResponsePair& prp);
+
+  /// non-null if the file is in the indexed format
+  IndexedRestartReader* indexed_reader();
+
+  /// version information read from the file
+  const RestartVersion& version() const;
+
+private:
+
+  /// version information read from the file
+  RestartVersion restartVersion;
+
+  /// input stream for a sequential restart file
+  std::ifstream restartInputFS;
+  /// input archive for a sequential restart file
+  std::unique_ptr<boost::archive::binary_iarchive> restartInputArchive;
+  /// random-access reader for an indexed restart file
+  std::unique_ptr<IndexedRestartReader> indexedReader;
+  /// position of the next record within an indexed restart file
+  size_t nextRecord;
+};
+
+
+RestartFileReader::RestartFileReader(const String& read_restart_filename):
+  nextRecord(0)
+{
+  restartVersion = RestartVersion::check_restart_version(read_restart_filename);
+
+  if (restartVersion.indexed_format()) {
+    indexedReader.reset(new IndexedRestartReader(read_restart_filename));
+    return;
+  }
+
+  restartInputFS.open(read_restart_filename.c_str(), std::ios::binary);
+  if (!restartInputFS.good()) {
+    Cerr << "\nError: could not open restart file '"
+	 << read_restart_filename << "' for reading."<< std::endl;
+    exit(-1);
+  }
+  restartInputArchive.reset
+    (new boost::archive::binary_iarchive(restartInputFS));
+
+  // re-read the full, correct version info from the new stream
+  if (RestartVersion::restartFirstVersionNumber <= restartVersion.restartVersion)
+    *restartInputArchive & restartVersion;
+
+  restartInputFS.peek();  // peek to force EOF if no records in restart file
+}
+
+
+bool RestartFileReader::read(ParamResponsePair& prp)
+{
+  if (indexedReader) {
+    if (nextRecord >= indexedReader->num_records())
+      return false;
+    indexedReader->read_record(nextRecord++, prp);
+    return true;
+  }
+
+  if (!restartInputFS.good() || restartInputFS.eof())
+    return false;
+  *restartInputArchive & prp;
+  // peek to force EOF if the last restart record was read
+  restartInputFS.peek();
+  return true;
+}
+
+
+IndexedRestartReader* RestartFileReader::indexed_reader()
+{ return indexedReader.get(); }
+
+
+const RestartVersion& RestartFileReader::version() const
+{ return restartVersion; }
 
 } // namespace Dakota
 
@@ -54,7 +149,8 @@ void concatenate_restart(StringArray pos_args);
 
 /** Parse command line inputs and invoke the appropriate utility
     function (print_restart(), print_restart_tabular(),
-    read_neutral(), repair_restart(), or concatenate_restart()). */
+    read_neutral(), repair_restart(), concatenate_restart(), or
+    convert_restart()). */
 
 int main(int argc, char* argv[])
 {
@@ -165,6 +261,10 @@ int main(int argc, char* argv[])
     repair_restart(pos_args, "by_id");
   else if (util_command == "cat")
     concatenate_restart(pos_args);
+  else if (util_command == "to_indexed")
+    convert_restart(pos_args, true);
+  else if (util_command == "to_sequential")
+    convert_restart(pos_args, false);
   else {
     Cerr << "Error: command '" << util_command << "' not supported." << endl;
     print_usage(Cerr);
@@ -189,7 +289,9 @@ void print_usage(std::ostream& s)
     << "    dakota_restart_util to_tabular <restart_file> <text_file> [--custom_annotated [header] [eval_id] [interface_id]] [--output_precision <int>]\n"
     << "    dakota_restart_util remove <double> <old_restart_file> <new_restart_file>\n"
     << "    dakota_restart_util remove_ids <int_1> ... <int_n> <old_restart_file> <new_restart_file>\n"
-    << "    dakota_restart_util cat <restart_file_1> ... <restart_file_n> <new_restart_file>" 
+    << "    dakota_restart_util cat <restart_file_1> ... <restart_file_n> <new_restart_file>\n"
+    << "    dakota_restart_util to_indexed <restart_file> <indexed_restart_file>\n"
+    << "    dakota_restart_util to_sequential <indexed_restart_file> <restart_file>"
     << endl;
 }
 
@@ -222,21 +324,7 @@ void print_restart(StringArray pos_args, String print_dest)
 
   try {
 
-    RestartVersion rst_ver =
-      RestartVersion::check_restart_version(read_restart_filename);
-
-    std::ifstream restart_input_fs(read_restart_filename.c_str(),
-				   std::ios::binary);
-    if (!restart_input_fs.good()) {
-      Cerr << "\nError: could not open restart file '"
-	   << read_restart_filename << "' for reading."<< std::endl;
-      exit(-1);
-    }
-    boost::archive::binary_iarchive restart_input_archive(restart_input_fs);
-
-    // re-read the full, correct version info from the new stream
-    if (RestartVersion::restartFirstVersionNumber <= rst_ver.restartVersion)
-      restart_input_archive & rst_ver;
+    RestartFileReader rst_reader(read_restart_filename);
 
     cout << "Reading restart file '" << read_restart_filename << "'."
 	 << std::endl;
@@ -251,12 +339,12 @@ void print_restart(StringArray pos_args, String print_dest)
     write_precision = 16;
 
     int cntr = 0;
-    restart_input_fs.peek();  // peek to force EOF if no records in restart file
-    while (restart_input_fs.good() && !restart_input_fs.eof()) {
+    for (;;) {
 
       ParamResponsePair current_pair;
       try { 
-	restart_input_archive & current_pair; 
+	if (!rst_reader.read(current_pair))
+	  break;
       }
       catch(const boost::archive::archive_exception& e) {
 	// No current way a user can recover from this with remove_ids
@@ -276,9 +364,6 @@ void print_restart(StringArray pos_args, String print_dest)
 	     << current_pair;
       else if (print_dest == "neutral_file")
 	current_pair.write_annotated(neutral_file_stream);
-
-      // peek to force EOF if the last restart record was read
-      restart_input_fs.peek();
     }
     if (print_dest == "neutral_file")
       neutral_file_stream.close();
@@ -476,21 +561,7 @@ void print_restart_tabular(StringArray pos_args, String print_dest,
 
   try {
 
-    RestartVersion rst_ver =
-      RestartVersion::check_restart_version(read_restart_filename);
-
-    std::ifstream restart_input_fs(read_restart_filename.c_str(),
-				   std::ios::binary);
-    if (!restart_input_fs.good()) {
-      Cerr << "\nError: could not open restart file '"
-	   << read_restart_filename << "' for reading."<< std::endl;
-      exit(-1);
-    }
-    boost::archive::binary_iarchive restart_input_archive(restart_input_fs);
-
-    // re-read the full, correct version info from the new stream
-    if (RestartVersion::restartFirstVersionNumber <= rst_ver.restartVersion)
-      restart_input_archive & rst_ver;
+    RestartFileReader rst_reader(read_restart_filename);
 
     cout << "Reading restart file '" << read_restart_filename << "'."
 	 << std::endl;
@@ -513,12 +584,12 @@ void print_restart_tabular(StringArray pos_args, String print_dest,
     int wp_save = write_precision;  // later restore since this is global data
     write_precision = tabular_precision;
 
-    restart_input_fs.peek();  // peek to force EOF if no records in restart file
-    while (restart_input_fs.good() && !restart_input_fs.eof()) {
+    for (;;) {
 
       ParamResponsePair current_pair;
       try {
-	restart_input_archive & current_pair;
+	if (!rst_reader.read(current_pair))
+	  break;
       }
       catch(const boost::archive::archive_exception& e) {
 	// No current way a user can recover from this with remove_ids
@@ -557,9 +628,6 @@ void print_restart_tabular(StringArray pos_args, String print_dest,
       }
       current_pair.write_tabular(tabular_text, tabular_format);  // also writes IDs
       ++num_evals;
-
-      // peek to force EOF if the last restart record was read
-      restart_input_fs.peek();
     }
 
     cout << "Restart file processing completed: " << num_evals
@@ -713,21 +781,9 @@ void repair_restart(StringArray pos_args, String identifier_type)
 
   try {
 
-    RestartVersion rst_ver =
-      RestartVersion::check_restart_version(read_restart_filename);
-
-    std::ifstream restart_input_fs(read_restart_filename.c_str(),
-				   std::ios::binary);
-    if (!restart_input_fs.good()) {
-      Cerr << "\nError: could not open restart file '"
-	   << read_restart_filename << "' for reading."<< std::endl;
-      abort_handler(IO_ERROR);
-    }
-    boost::archive::binary_iarchive restart_input_archive(restart_input_fs);
-
-    // re-read the full, correct version info from the new stream
-    if (RestartVersion::restartFirstVersionNumber <= rst_ver.restartVersion)
-      restart_input_archive & rst_ver;
+    RestartFileReader rst_reader(read_restart_filename);
+    // the new restart file retains the format of the old
+    IndexedRestartReader* indexed_reader = rst_reader.indexed_reader();
 
     std::ofstream restart_output_fs(write_restart_filename.c_str(),
 				    std::ios::binary);
@@ -738,15 +794,40 @@ void repair_restart(StringArray pos_args, String identifier_type)
     }
     boost::archive::binary_oarchive restart_output_archive(restart_output_fs);
 
+    std::vector<RestartIndexEntry> new_index;
+    UInt64 data_offset = 0;
+    if (indexed_reader) {
+      RestartVersion rst_ver(indexed_reader->version());
+      restart_output_archive & rst_ver;
+      restart_output_fs.flush();
+      data_offset = static_cast<UInt64>(restart_output_fs.tellp());
+    }
+
     cout << "Writing new restart file " << write_restart_filename << '\n';
 
     int cntr = 0, good_cntr = 0;
-    restart_input_fs.peek();  // peek to force EOF if no records in restart file
-    while (restart_input_fs.good() && !restart_input_fs.eof()) {
+    if (indexed_reader && !by_value) {
+      // removal by id requires only the index: retained records are copied
+      // verbatim without deserialization
+      size_t num_recs = indexed_reader->num_records();
+      for (size_t i=0; i<num_recs; ++i, ++cntr) {
+	RestartIndexEntry entry = indexed_reader->entry(i);
+	if (contains(bad_ids, entry.evalId))
+	  continue;
+	const char* record = indexed_reader->record_data(i);
+	entry.offset = static_cast<UInt64>(restart_output_fs.tellp());
+	restart_output_fs.write(record,
+				sizeof(RestartRecordHeader) + entry.length);
+	new_index.push_back(entry);
+	good_cntr++;
+      }
+    }
+    else for (;;) {
 
       ParamResponsePair current_pair;
       try {
-	restart_input_archive & current_pair;
+	if (!rst_reader.read(current_pair))
+	  break;
       }
       catch(const boost::archive::archive_exception& e) {
 	Cerr << "\nError reading restart file '" << read_restart_filename
@@ -775,13 +856,16 @@ void repair_restart(StringArray pos_args, String identifier_type)
 
       // if current_pair is bad, omit it from the new restart file
       if (!bad_flag) {
-	restart_output_archive & current_pair;
+	if (indexed_reader)
+	  new_index.push_back
+	    (IndexedRestart::write_record(restart_output_fs, current_pair));
+	else
+	  restart_output_archive & current_pair;
 	good_cntr++;
       }
-
-      // peek to force EOF if the last restart record was read
-      restart_input_fs.peek();
     }
+    if (indexed_reader)
+      IndexedRestart::write_index(restart_output_fs, new_index, data_offset);
     cout << "Restart repair completed: " << cntr << " evaluations retrieved"
 	 << ", " << cntr-good_cntr << " removed, " << good_cntr << " saved.\n";
     restart_output_fs.close();
@@ -830,28 +914,15 @@ void concatenate_restart(StringArray pos_args)
 
     for(const String& rst_file : pos_args) {
 
-      RestartVersion rst_ver =
-	RestartVersion::check_restart_version(rst_file);
-
-      std::ifstream restart_input_fs(rst_file.c_str(), std::ios::binary);
-      if (!restart_input_fs.good()) {
-	Cerr << "\nError: could not open restart file '"
-	     << rst_file << "' for reading."<< std::endl;
-	exit(-1);
-      }
-      boost::archive::binary_iarchive restart_input_archive(restart_input_fs);
-
-      // re-read the full, correct version info from the new stream
-      if (RestartVersion::restartFirstVersionNumber <= rst_ver.restartVersion)
-	restart_input_archive & rst_ver;
+      RestartFileReader rst_reader(rst_file);
 
       int cntr = 0;
-      restart_input_fs.peek();  // peek to force EOF if no records in restart file
-      while (restart_input_fs.good() && !restart_input_fs.eof()) {
+      for (;;) {
 
 	ParamResponsePair current_pair;
 	try {
-	  restart_input_archive & current_pair;
+	  if (!rst_reader.read(current_pair))
+	    break;
 	}
 	catch(const boost::archive::archive_exception& e) {
 	  Cerr << "\nError reading restart file '" << rst_file
@@ -862,9 +933,6 @@ void concatenate_restart(StringArray pos_args)
 	// serialization functions no longer throw strings
 	restart_output_archive & current_pair;
 	cntr++;
- 
-	// peek to force EOF if the last restart record was read
-	restart_input_fs.peek();
       }
 
       cout << rst_file << " processing completed: " << cntr
@@ -888,4 +956,78 @@ void concatenate_restart(StringArray pos_args)
 
 }
 
+
+/** \b Usage: "dakota_restart_util to_indexed dakota.rst dakota_idx.rst"\n
+              "dakota_restart_util to_sequential dakota_idx.rst dakota.rst"
+
+    Converts a restart file of either format to the indexed or the
+    sequential format, retaining the version information of the
+    original file.  Records of an indexed file are deserialized
+    concurrently. */
+void convert_restart(StringArray pos_args, bool to_indexed)
+{
+  if (pos_args.size() != 2) {
+    Cerr << "Usage: dakota_restart_util "
+	 << ((to_indexed) ? "to_indexed" : "to_sequential")
+	 << " <restart_file> <new_restart_file>." << endl;
+    exit(-1);
+  }
+
+  const String& read_restart_filename  = pos_args[0];
+  const String& write_restart_filename = pos_args[1];
+  if (read_restart_filename == write_restart_filename) {
+    Cerr << "Error: old and new restart filenames must differ." << endl;
+    exit(-1);
+  }
+
+  try {
+
+    typedef std::chrono::steady_clock clock;
+    clock::time_point read_start = clock::now();
+
+    RestartFileReader rst_reader(read_restart_filename);
+    const RestartVersion& rst_ver = rst_reader.version();
+    PRPArray rst_prps;
+    if (IndexedRestartReader* indexed_reader = rst_reader.indexed_reader())
+      indexed_reader->read_records(indexed_reader->num_records(), rst_prps);
+    else {
+      ParamResponsePair current_pair;
+      while (rst_reader.read(current_pair)) {
+	rst_prps.push_back(current_pair);
+	current_pair = ParamResponsePair(); // fresh reps for the next record
+      }
+    }
+    std::chrono::duration<double> read_time = clock::now() - read_start;
+    cout << "Read " << rst_prps.size() << " evaluations from '"
+	 << read_restart_filename << "' in " << read_time.count()
+	 << " seconds.\n";
+
+    // retain the release info of the original; files predating restart
+    // versioning are attributed to an unknown release
+    RestartVersion new_ver(rst_ver.dakotaRelease, rst_ver.dakotaSHA1,
+			   (to_indexed) ?
+			   RestartVersion::indexedRestartVersionDelta :
+			   RestartVersion::sequentialRestartVersionDelta);
+    {
+      RestartWriter rst_writer(write_restart_filename, new_ver);
+      for (size_t i=0; i<rst_prps.size(); ++i)
+	rst_writer.append_prp(rst_prps[i]);
+    } // indexed file is completed by the RestartWriter dtor
+    cout << "Writing " << ((to_indexed) ? "indexed" : "sequential")
+	 << " restart file " << write_restart_filename << " completed: "
+	 << rst_prps.size() << " evaluations converted.\n";
+
+  }
+  catch (const boost::archive::archive_exception& e) {
+    Cerr << "\nError converting restart file '" << read_restart_filename
+	 << "'.\nDetails (Boost archive exception): " << e.what() << std::endl;
+    abort_handler(IO_ERROR);
+  }
+  catch (const std::exception& e) {
+    Cerr << "Unknown error converting restart file '" << read_restart_filename
+	 << "'.\nDetails: " << e.what() << '\n';
+    abort_handler(IO_ERROR);
+  }
+}
+
 } // namespace Dakota
@@ -33,9 +33,12 @@ class GP_Objective : public ROL::Objective<double> {
   /**
    *  \brief Constructor for GP_Objective.
    *  \param[in] gp_model Reference to the GaussianProcess surrogate.
+   *  \param[in] workspace Workspace of the optimization run, holding
+   *  the parameters and Gram matrices evaluated by this objective.
    *
    */
-  GP_Objective(GaussianProcess& gp_model);
+  GP_Objective(const GaussianProcess& gp_model,
+               GaussianProcess::MLEWorkspace& workspace);
   ~GP_Objective();
 
   // ------------------------------------------------------------
@@ -94,7 +97,9 @@ class GP_Objective : public ROL::Objective<double> {
   // Private member variables
 
   /// Pointer to the GaussianProcess surrogate.
-  GaussianProcess& gp;
+  const GaussianProcess& gp;
+  /// Workspace of the optimization run.
+  GaussianProcess::MLEWorkspace& ws;
   /// Number of optimization variables.
   int nopt;
   /// Previously computed value of the objective function.
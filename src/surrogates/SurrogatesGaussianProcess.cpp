@@ -14,8 +14,12 @@
 #include "ROL_LineSearchStep.hpp"
 #include "SurrogatesGPObjective.hpp"
 #include "Teuchos_oblackholestream.hpp"
+#include "WorkStealingThreadPool.hpp"
 #include "util_math_tools.hpp"
 
+#include <atomic>
+#include <limits>
+
 namespace dakota {
 namespace surrogates {
 
@@ -99,7 +103,6 @@ void GaussianProcess::build(const MatrixXd& samples, const MatrixXd& response) {
   VectorXd sigma_bounds(2), nugget_bounds(2);
   MatrixXd length_scale_bounds;
   setup_hyperparameter_bounds(sigma_bounds, length_scale_bounds, nugget_bounds);
-  const int num_restarts = configOptions.get<int>("num restarts");
 
   /* Scale the data and compute build squared distances */
   dataScaler =
@@ -109,7 +112,6 @@ void GaussianProcess::build(const MatrixXd& samples, const MatrixXd& response) {
   dataScaler.scale_samples(samples, scaledBuildPoints);
   compute_build_dists();
 
-  MatrixXd beta_bounds;
   estimateTrend = configOptions.sublist("Trend").get<bool>("estimate trend");
   if (estimateTrend) {
     polyRegression = std::make_shared<PolynomialRegression>(
@@ -117,9 +119,6 @@ void GaussianProcess::build(const MatrixXd& samples, const MatrixXd& response) {
         configOptions.sublist("Trend").sublist("Options"));
     numPolyTerms = polyRegression->get_num_terms();
     polyRegression->compute_basis_matrix(scaledBuildPoints, basisMatrix);
-    beta_bounds = MatrixXd::Ones(numPolyTerms, 2);
-    beta_bounds.col(0) *= -betaBound;
-    beta_bounds.col(1) *= betaBound;
   }
 
   /* size of thetaValues for squared exponential kernel and one QoI */
@@ -127,18 +126,89 @@ void GaussianProcess::build(const MatrixXd& samples, const MatrixXd& response) {
   bestThetaValues.resize(numVariables + 1);
   betaValues.resize(numPolyTerms);
   bestBetaValues.resize(numPolyTerms);
-  /* set the size of the GramMatrix and its derivatives */
+  /* set the size of the GramMatrix (optimization runs size their own) */
   GramMatrix.resize(numSamples, numSamples);
-  GramMatrixDerivs.resize(numVariables + 1);
-  for (int k = 0; k < numVariables + 1; k++) {
-    GramMatrixDerivs[k].resize(numSamples, numSamples);
-  }
 
   /* DTS: if the nugget is being estimated, should the fixed value be set to
    * zero? */
   fixedNuggetValue =
       configOptions.sublist("Nugget").get<double>("fixed nugget");
 
+  numFrozenUpdates = 0;
+  fit_hyperparameters(false);
+}
+
+void GaussianProcess::append(const MatrixXd& samples,
+                             const MatrixXd& response) {
+  if (!kernel)
+    throw(std::runtime_error(
+        "GaussianProcess::append() requires a built Gaussian Process."));
+  if (samples.cols() != numVariables || response.rows() != samples.rows())
+    throw(std::runtime_error(
+        "Gaussian Process append inputs are not consistent with the build "
+        "data."));
+  const int num_new = samples.rows();
+  if (num_new == 0) return;
+  const int num_old = numSamples;
+
+  /* e.g., after a load, factor the current Gram matrix first */
+  if (!hasBestCholFact) {
+    compute_gram(cwiseDists2, true, GramMatrix);
+    CholFact.compute(GramMatrix);
+    hasBestCholFact = true;
+  }
+
+  /* The data and response scalings of the build are retained */
+  MatrixXd scaled_new;
+  dataScaler.scale_samples(samples, scaled_new);
+  scaledBuildPoints.conservativeResize(num_old + num_new, Eigen::NoChange);
+  scaledBuildPoints.bottomRows(num_new) = scaled_new;
+  targetValues.conservativeResize(num_old + num_new, Eigen::NoChange);
+  targetValues.bottomRows(num_new) =
+      (response.array() - responseOffset) / responseScaleFactor;
+  if (estimateTrend) {
+    MatrixXd new_basis;
+    polyRegression->compute_basis_matrix(scaled_new, new_basis);
+    basisMatrix.conservativeResize(num_old + num_new, Eigen::NoChange);
+    basisMatrix.bottomRows(num_new) = new_basis;
+  }
+  numSamples = num_old + num_new;
+  eyeMatrix = MatrixXd::Identity(numSamples, numSamples);
+  extend_build_dists(num_old);
+
+  const int frozen_updates =
+      configOptions.sublist("Append").get<int>("frozen updates");
+  if (++numFrozenUpdates > frozen_updates) {
+    numFrozenUpdates = 0;
+    fit_hyperparameters(
+        configOptions.sublist("Append").get<bool>("warm start"));
+  } else
+    update_factorization(num_old);
+}
+
+void GaussianProcess::update() {
+  if (!kernel)
+    throw(std::runtime_error(
+        "GaussianProcess::update() requires a built Gaussian Process."));
+  numFrozenUpdates = 0;
+  fit_hyperparameters(configOptions.sublist("Append").get<bool>("warm start"));
+}
+
+void GaussianProcess::fit_hyperparameters(bool warm_start) {
+  VectorXd sigma_bounds(2), nugget_bounds(2);
+  MatrixXd length_scale_bounds;
+  setup_hyperparameter_bounds(sigma_bounds, length_scale_bounds, nugget_bounds);
+  const int num_restarts = configOptions.get<int>("num restarts");
+  hasBestCholFact = false;
+  incrementalFactor = false;
+
+  MatrixXd beta_bounds;
+  if (estimateTrend) {
+    beta_bounds = MatrixXd::Ones(numPolyTerms, 2);
+    beta_bounds.col(0) *= -betaBound;
+    beta_bounds.col(1) *= betaBound;
+  }
+
   /* set up the initial guesses */
   // srand(configOptions.get<int>("gp seed"));
   MatrixXd initial_guesses;
@@ -146,14 +216,6 @@ void GaussianProcess::build(const MatrixXd& samples, const MatrixXd& response) {
                            num_restarts, configOptions.get<int>("gp seed"),
                            initial_guesses);
 
-  ROL::Ptr<std::ostream> outStream;
-  Teuchos::oblackholestream bhs;
-  outStream = ROL::makePtrFromRef(bhs);
-
-  /* Uncomment if you'd like to print ROL's output to screen.
-   * Useful for debugging */
-  // outStream = ROL::makePtrFromRef(std::cout);
-
   /* No more reading in rol_params from an xml file
    * Set defaults in here instead */
   /*
@@ -166,96 +228,93 @@ void GaussianProcess::build(const MatrixXd& samples, const MatrixXd& response) {
       Teuchos::rcp(new ParameterList("GP_MLE_Optimization"));
   setup_default_optimization_params(gp_mle_rol_params);
 
-  auto gp_objective = std::make_shared<GP_Objective>(*this);
   int dim = numVariables + 1 + numPolyTerms + numNuggetTerms;
 
-  // Define algorithm
-  ROL::Ptr<ROL::Step<double>> step =
-      ROL::makePtr<ROL::LineSearchStep<double>>(*gp_mle_rol_params);
-  ROL::Ptr<ROL::StatusTest<double>> status =
-      ROL::makePtr<ROL::StatusTest<double>>(*gp_mle_rol_params);
-  ROL::Algorithm<double> algo(step, status, false);
+  /* a warm start replaces the first initial guess with the current
+   * hyperparameters */
+  if (warm_start && thetaValues.size() == numVariables + 1) {
+    initial_guesses.row(0).head(numVariables + 1) = thetaValues;
+    if (estimateTrend)
+      initial_guesses.row(0).segment(numVariables + 1, numPolyTerms) =
+          betaValues;
+    if (estimateNugget) initial_guesses(0, dim - 1) = estimatedNuggetValue;
+  }
 
-  /* set up parameter vectors and bounds */
-  ROL::Ptr<std::vector<double>> x_ptr =
-      ROL::makePtr<std::vector<double>>(dim, 0.0);
-  ROL::StdVector<double> x(x_ptr);
-  ROL::Ptr<ROL::Bounds<double>> bound;
-  ROL::Ptr<std::vector<double>> lo_ptr =
-      ROL::makePtr<std::vector<double>>(dim, 0.0);
-  ROL::Ptr<std::vector<double>> hi_ptr =
-      ROL::makePtr<std::vector<double>>(dim, 0.0);
+  /* set up parameter bounds */
+  std::vector<double> lo(dim, 0.0), hi(dim, 0.0);
   /* sigma bounds */
-  (*lo_ptr)[0] = log(sigma_bounds(0));
-  (*hi_ptr)[0] = log(sigma_bounds(1));
+  lo[0] = log(sigma_bounds(0));
+  hi[0] = log(sigma_bounds(1));
   /* length scale bounds */
   for (int i = 0; i < numVariables; i++) {
     if (length_scale_bounds.rows() > 1) {
-      (*lo_ptr)[i + 1] = log(length_scale_bounds(i, 0));
-      (*hi_ptr)[i + 1] = log(length_scale_bounds(i, 1));
+      lo[i + 1] = log(length_scale_bounds(i, 0));
+      hi[i + 1] = log(length_scale_bounds(i, 1));
     } else {
-      (*lo_ptr)[i + 1] = log(length_scale_bounds(0, 0));
-      (*hi_ptr)[i + 1] = log(length_scale_bounds(0, 1));
+      lo[i + 1] = log(length_scale_bounds(0, 0));
+      hi[i + 1] = log(length_scale_bounds(0, 1));
     }
   }
   if (estimateTrend) {
     for (int i = 0; i < numPolyTerms; i++) {
-      (*lo_ptr)[numVariables + 1 + i] = beta_bounds(i, 0);
-      (*hi_ptr)[numVariables + 1 + i] = beta_bounds(i, 1);
+      lo[numVariables + 1 + i] = beta_bounds(i, 0);
+      hi[numVariables + 1 + i] = beta_bounds(i, 1);
     }
   }
   if (estimateNugget) {
-    (*lo_ptr)[dim - 1] = log(nugget_bounds(0));
-    (*hi_ptr)[dim - 1] = log(nugget_bounds(1));
+    lo[dim - 1] = log(nugget_bounds(0));
+    hi[dim - 1] = log(nugget_bounds(1));
   }
 
-  ROL::Ptr<ROL::Vector<double>> lop =
-      ROL::makePtr<ROL::StdVector<double>>(lo_ptr);
-  ROL::Ptr<ROL::Vector<double>> hip =
-      ROL::makePtr<ROL::StdVector<double>>(hi_ptr);
-  bound = ROL::makePtr<ROL::Bounds<double>>(lop, hip);
-
-  std::vector<std::string> output;
-
   objectiveFunctionHistory.resize(num_restarts);
   objectiveGradientHistory.resize(num_restarts, dim);
   thetaHistory.resize(num_restarts, dim);
+  std::vector<MLEWorkspace> final_params(num_restarts);
+
+  /* Optimization runs are independent: each uses its own objective,
+   * workspace, and ROL algorithm, and stores its results by restart
+   * index, so the outcome does not depend on the number of threads. */
+  const int num_threads = this->num_threads(num_restarts);
+
+  /* ROL may augment its options, so each thread gets a copy */
+  std::vector<ParameterList> thread_rol_params(num_threads,
+                                               *gp_mle_rol_params);
+  std::atomic<int> next_restart(0);
+  auto run_restarts = [&](size_t t) {
+    VectorXd final_obj_gradient(dim);
+    std::vector<double> initial_guess(dim);
+    for (int i = next_restart++; i < num_restarts; i = next_restart++) {
+      for (int j = 0; j < dim; ++j) initial_guess[j] = initial_guesses(i, j);
+      MLEWorkspace& ws = final_params[i];
+      optimize_hyperparameters(initial_guess, lo, hi, thread_rol_params[t],
+                               ws, objectiveFunctionHistory(i),
+                               final_obj_gradient);
+      objectiveGradientHistory.row(i) = final_obj_gradient;
+      thetaHistory.row(i).head(numVariables + 1) = ws.thetaValues;
+      if (estimateTrend)
+        thetaHistory.row(i).segment(numVariables + 1, numPolyTerms) =
+            ws.betaValues;
+      if (estimateNugget)
+        thetaHistory.row(i).tail(1)(0) = ws.estimatedNuggetValue;
+      /* only the parameters are retained */
+      ws.kernel.reset();
+      ws.GramMatrix.resize(0, 0);
+      ws.GramMatrixDerivs.clear();
+      ws.CholFact = Eigen::LDLT<MatrixXd>();
+    }
+  };
+  util::WorkStealingThreadPool::parallel_for(num_threads, run_restarts);
 
-  double final_obj_value;
-  VectorXd final_obj_gradient(dim);
-
+  /* select the first of the best runs, as for a serial loop */
+  bestObjFunValue = std::numeric_limits<double>::max();
   for (int i = 0; i < num_restarts; i++) {
-    for (int j = 0; j < dim; ++j) {
-      (*x_ptr)[j] = initial_guesses(i, j);
-    }
-    output = algo.run(x, *gp_objective, *bound, true, *outStream);
-    for (int j = 0; j < thetaValues.size(); ++j) {
-      (thetaValues)(j) = (*x_ptr)[j];
+    if (objectiveFunctionHistory(i) < bestObjFunValue) {
+      bestObjFunValue = objectiveFunctionHistory(i);
+      bestThetaValues = final_params[i].thetaValues;
+      if (estimateTrend) bestBetaValues = final_params[i].betaValues;
+      if (estimateNugget)
+        bestEstimatedNuggetValue = final_params[i].estimatedNuggetValue;
     }
-    if (estimateTrend) {
-      for (int j = 0; j < numPolyTerms; ++j) {
-        betaValues(j) = (*x_ptr)[numVariables + 1 + j];
-      }
-    }
-    if (estimateNugget) {
-      estimatedNuggetValue = (*x_ptr)[numVariables + 1 + numPolyTerms];
-    }
-    /* get the final objective function value and gradient */
-    negative_marginal_log_likelihood(true, true, final_obj_value,
-                                     final_obj_gradient);
-    if (final_obj_value < bestObjFunValue) {
-      bestObjFunValue = final_obj_value;
-      bestThetaValues = thetaValues;
-      if (estimateTrend) bestBetaValues = betaValues;
-      if (estimateNugget) bestEstimatedNuggetValue = estimatedNuggetValue;
-    }
-    objectiveFunctionHistory(i) = final_obj_value;
-    objectiveGradientHistory.row(i) = final_obj_gradient;
-    thetaHistory.row(i).head(numVariables + 1) = thetaValues;
-    if (estimateTrend)
-      thetaHistory.row(i).segment(numVariables + 1, numPolyTerms) = betaValues;
-    if (estimateNugget) thetaHistory.row(i).tail(1)(0) = estimatedNuggetValue;
-    algo.reset();
   }
 
   thetaValues = bestThetaValues;
@@ -267,7 +326,7 @@ void GaussianProcess::build(const MatrixXd& samples, const MatrixXd& response) {
   if (estimateNugget) estimatedNuggetValue = bestEstimatedNuggetValue;
 
   /* compute and store best Cholesky factorization */
-  compute_gram(cwiseDists2, true, false, GramMatrix);
+  compute_gram(cwiseDists2, true, GramMatrix);
   CholFact.compute(GramMatrix);
   hasBestCholFact = true;
 
@@ -295,32 +354,40 @@ VectorXd GaussianProcess::value(const MatrixXd& eval_points, const int qoi) {
                            "point and Gaussian Process do not match"));
   }
 
-  VectorXd approx_values;
+  const int num_pred_pts = eval_points.rows();
+  VectorXd approx_values(num_pred_pts);
 
   /* scale the eval_points (prediction points) */
   const MatrixXd& scaled_pred_points = dataScaler.scale_samples(eval_points);
-  compute_pred_dists(scaled_pred_points);
 
   /* compute the Gram matrix and its Cholesky factorization */
   if (!hasBestCholFact) {
-    compute_gram(cwiseDists2, true, false, GramMatrix);
+    compute_gram(cwiseDists2, true, GramMatrix);
     CholFact.compute(GramMatrix);
   }
 
   VectorXd resid, chol_solve_resid;
-  compute_gram(cwiseMixedDists2, false, false, predMixedGramMatrix);
-
   if (estimateTrend) {
     resid = targetValues - basisMatrix * betaValues;
   } else
     resid = targetValues;
 
-  chol_solve_resid = CholFact.solve(resid);
-  approx_values = predMixedGramMatrix * chol_solve_resid;
+  chol_solve_resid = solve_gram(resid);
+
+  /* prediction/build Gram matrix tiles are formed block by block */
+  for_each_pred_block(
+      num_pred_pts, [&](int start, int num_pts, Kernel& block_kernel) {
+        std::vector<MatrixXd> mixed_dists2;
+        MatrixXd mixed_gram;
+        compute_block_mixed_dists(scaled_pred_points, start, num_pts,
+                                  mixed_dists2);
+        block_kernel.compute_gram(mixed_dists2, thetaValues, mixed_gram);
+        approx_values.segment(start, num_pts).noalias() =
+            mixed_gram * chol_solve_resid;
+      });
 
   if (estimateTrend) {
     polyRegression->compute_basis_matrix(scaled_pred_points, predBasisMatrix);
-    MatrixXd z = CholFact.solve(basisMatrix);
     approx_values += predBasisMatrix * betaValues;
   }
   return responseScaleFactor * approx_values.array() + responseOffset;
@@ -345,26 +412,32 @@ MatrixXd GaussianProcess::gradient(const MatrixXd& eval_points, const int qoi) {
   /* scale the eval_points (prediction points) */
   MatrixXd scaled_pred_pts;
   dataScaler.scale_samples(eval_points, scaled_pred_pts);
-  compute_pred_dists(scaled_pred_pts);
 
   /* compute the Gram matrix and its Cholesky factorization */
   if (!hasBestCholFact) {
-    compute_gram(cwiseDists2, true, false, GramMatrix);
+    compute_gram(cwiseDists2, true, GramMatrix);
     CholFact.compute(GramMatrix);
   }
 
-  MatrixXd chol_solve_resid, first_deriv_pred_gram, grad_components, resid;
-  compute_gram(cwiseMixedDists2, false, false, predMixedGramMatrix);
+  MatrixXd chol_solve_resid, resid;
   resid = targetValues;
   if (estimateTrend) resid -= basisMatrix * betaValues;
-  chol_solve_resid = CholFact.solve(resid);
-
-  for (int i = 0; i < numVariables; i++) {
-    first_deriv_pred_gram = kernel->compute_first_deriv_pred_gram(
-        predMixedGramMatrix, cwiseMixedDists, thetaValues, i);
-    grad_components = first_deriv_pred_gram * chol_solve_resid;
-    gradient.col(i) = grad_components.col(0);
-  }
+  chol_solve_resid = solve_gram(resid);
+
+  for_each_pred_block(
+      numPredictionPts, [&](int start, int num_pts, Kernel& block_kernel) {
+        std::vector<MatrixXd> mixed_dists, mixed_dists2;
+        MatrixXd mixed_gram, first_deriv_pred_gram;
+        compute_block_mixed_dists(scaled_pred_pts, start, num_pts,
+                                  mixed_dists2, &mixed_dists);
+        block_kernel.compute_gram(mixed_dists2, thetaValues, mixed_gram);
+        for (int i = 0; i < numVariables; i++) {
+          first_deriv_pred_gram = block_kernel.compute_first_deriv_pred_gram(
+              mixed_gram, mixed_dists, thetaValues, i);
+          gradient.block(start, i, num_pts, 1).noalias() =
+              first_deriv_pred_gram * chol_solve_resid;
+        }
+      });
 
   /* extra terms for GP with a trend */
   if (estimateTrend) {
@@ -394,15 +467,15 @@ MatrixXd GaussianProcess::hessian(const MatrixXd& eval_point, const int qoi) {
 
   /* compute the Gram matrix and its Cholesky factorization */
   if (!hasBestCholFact) {
-    compute_gram(cwiseDists2, true, false, GramMatrix);
+    compute_gram(cwiseDists2, true, GramMatrix);
     CholFact.compute(GramMatrix);
   }
 
   MatrixXd chol_solve_resid, second_deriv_pred_gram, resid;
-  compute_gram(cwiseMixedDists2, false, false, predMixedGramMatrix);
+  compute_gram(cwiseMixedDists2, false, predMixedGramMatrix);
   resid = targetValues;
   if (estimateTrend) resid -= basisMatrix * betaValues;
-  chol_solve_resid = CholFact.solve(resid);
+  chol_solve_resid = solve_gram(resid);
 
   /* Hessian */
   for (int i = 0; i < numVariables; i++) {
@@ -442,28 +515,28 @@ MatrixXd GaussianProcess::covariance(const MatrixXd& eval_points,
 
   /* compute the Gram matrix and its Cholesky factorization */
   if (!hasBestCholFact) {
-    compute_gram(cwiseDists2, true, false, GramMatrix);
+    compute_gram(cwiseDists2, true, GramMatrix);
     CholFact.compute(GramMatrix);
   }
 
   VectorXd resid;
   MatrixXd chol_solve_pred_mat;
-  compute_gram(cwiseMixedDists2, false, false, predMixedGramMatrix);
+  compute_gram(cwiseMixedDists2, false, predMixedGramMatrix);
 
   if (estimateTrend)
     resid = targetValues - basisMatrix * betaValues;
   else
     resid = targetValues;
 
-  chol_solve_pred_mat = CholFact.solve(predMixedGramMatrix.transpose());
+  chol_solve_pred_mat = solve_gram(predMixedGramMatrix.transpose());
 
-  compute_gram(cwisePredDists2, true, false, predGramMatrix);
+  compute_gram(cwisePredDists2, true, predGramMatrix);
   predCovariance = predGramMatrix - predMixedGramMatrix * chol_solve_pred_mat;
 
   if (estimateTrend) {
-    MatrixXd chol_solve_resid = CholFact.solve(resid);
+    MatrixXd chol_solve_resid = solve_gram(resid);
     polyRegression->compute_basis_matrix(scaled_pred_points, predBasisMatrix);
-    MatrixXd z = CholFact.solve(basisMatrix);
+    MatrixXd z = solve_gram(basisMatrix);
     MatrixXd R_mat = predBasisMatrix - predMixedGramMatrix * (z);
     MatrixXd h_mat = basisMatrix.transpose() * z;
     predCovariance += R_mat * (h_mat.ldlt().solve(R_mat.transpose()));
@@ -477,7 +550,65 @@ VectorXd GaussianProcess::variance(const MatrixXd& eval_points, const int qoi) {
   silence_unused_args(qoi);
   assert(qoi == 0);
 
-  VectorXd variance = covariance(eval_points).diagonal();
+  if (eval_points.cols() != numVariables) {
+    throw(std::runtime_error(
+        "Gaussian Process variance input has wrong dimension."
+        " Dimension of the feature space for the evaluation point and Gaussian "
+        "Process do not match"));
+  }
+
+  /* The diagonal of covariance(), without forming the prediction Gram
+   * matrix: var_i = k(x_i, x_i) - k_i^T K^{-1} k_i (+ trend terms) */
+  const int num_pred_pts = eval_points.rows();
+  VectorXd variance(num_pred_pts);
+  const MatrixXd& scaled_pred_points = dataScaler.scale_samples(eval_points);
+
+  /* compute the Gram matrix and its Cholesky factorization */
+  if (!hasBestCholFact) {
+    compute_gram(cwiseDists2, true, GramMatrix);
+    CholFact.compute(GramMatrix);
+  }
+
+  /* the stationary kernels have a constant diagonal, including nuggets */
+  std::vector<MatrixXd> zero_dists2(numVariables, MatrixXd::Zero(1, 1));
+  MatrixXd self_gram;
+  compute_gram(zero_dists2, true, self_gram);
+  const double prior_variance = self_gram(0, 0);
+
+  MatrixXd z;
+  Eigen::LDLT<MatrixXd> h_mat_fact;
+  if (estimateTrend) {
+    polyRegression->compute_basis_matrix(scaled_pred_points, predBasisMatrix);
+    z = solve_gram(basisMatrix);
+    h_mat_fact.compute(basisMatrix.transpose() * z);
+  }
+
+  for_each_pred_block(
+      num_pred_pts, [&](int start, int num_pts, Kernel& block_kernel) {
+        std::vector<MatrixXd> mixed_dists2;
+        MatrixXd mixed_gram;
+        compute_block_mixed_dists(scaled_pred_points, start, num_pts,
+                                  mixed_dists2);
+        block_kernel.compute_gram(mixed_dists2, thetaValues, mixed_gram);
+        const MatrixXd chol_solve_pred_mat =
+            solve_gram(mixed_gram.transpose());
+        variance.segment(start, num_pts) =
+            prior_variance - mixed_gram.cwiseProduct(
+                                 chol_solve_pred_mat.transpose())
+                                 .rowwise()
+                                 .sum()
+                                 .array();
+        if (estimateTrend) {
+          const MatrixXd R_mat =
+              predBasisMatrix.middleRows(start, num_pts) - mixed_gram * z;
+          variance.segment(start, num_pts) +=
+              R_mat.cwiseProduct(h_mat_fact.solve(R_mat.transpose())
+                                     .transpose())
+                  .rowwise()
+                  .sum();
+        }
+      });
+  variance *= pow(responseScaleFactor, 2);
 
   for (int i = 0; i < variance.size(); i++) {
     if (variance(i) < 0.0 || std::isnan(variance(i))) {
@@ -492,40 +623,107 @@ void GaussianProcess::negative_marginal_log_likelihood(bool compute_grad,
                                                        bool form_gram,
                                                        double& obj_value,
                                                        VectorXd& obj_gradient) {
+  silence_unused_args(form_gram);
+  MLEWorkspace ws;
+  initialize_workspace(ws);
+  ws.thetaValues = thetaValues;
+  ws.betaValues = betaValues;
+  ws.estimatedNuggetValue = estimatedNuggetValue;
+  negative_marginal_log_likelihood(ws, compute_grad, true, obj_value,
+                                   obj_gradient);
+}
+
+void GaussianProcess::negative_marginal_log_likelihood(
+    MLEWorkspace& ws, bool compute_grad, bool form_gram, double& obj_value,
+    VectorXd& obj_gradient) const {
   if (form_gram) {
-    compute_gram(cwiseDists2, true, true, GramMatrix);
-    CholFact.compute(GramMatrix);
-    trendTargetResidual = targetValues;
-    if (estimateTrend) trendTargetResidual -= basisMatrix * betaValues;
-    GramResidualSolution = CholFact.solve(trendTargetResidual);
+    compute_gram(cwiseDists2, true, ws);
+    ws.CholFact.compute(ws.GramMatrix);
+    ws.trendTargetResidual = targetValues;
+    if (estimateTrend) ws.trendTargetResidual -= basisMatrix * ws.betaValues;
+    ws.GramResidualSolution = ws.CholFact.solve(ws.trendTargetResidual);
   }
 
   obj_value =
-      0.5 * log(CholFact.vectorD().array()).matrix().sum() +
-      0.5 * (trendTargetResidual.transpose() * GramResidualSolution)(0, 0) +
+      0.5 * log(ws.CholFact.vectorD().array()).matrix().sum() +
+      0.5 * (ws.trendTargetResidual.transpose() * ws.GramResidualSolution)(0,
+                                                                           0) +
       static_cast<double>(numSamples) / 2.0 * log(2.0 * PI);
 
   if (compute_grad) {
     /* DTS: This Cholesky solve is much more expensive than the factorization!
      */
     MatrixXd Q =
-        -0.5 * (GramResidualSolution * GramResidualSolution.transpose() -
-                CholFact.solve(eyeMatrix));
+        -0.5 * (ws.GramResidualSolution * ws.GramResidualSolution.transpose() -
+                ws.CholFact.solve(eyeMatrix));
     if (estimateTrend) {
       obj_gradient.segment(numVariables + 1, numPolyTerms) =
-          -basisMatrix.transpose() * GramResidualSolution;
+          -basisMatrix.transpose() * ws.GramResidualSolution;
     }
 
     for (int k = 0; k < numVariables + 1; k++)
-      obj_gradient(k) = (GramMatrixDerivs[k].cwiseProduct(Q)).sum();
+      obj_gradient(k) = (ws.GramMatrixDerivs[k].cwiseProduct(Q)).sum();
 
     if (estimateNugget) {
       obj_gradient(numVariables + 1 + numPolyTerms) =
-          2.0 * exp(2.0 * estimatedNuggetValue) * Q.trace();
+          2.0 * exp(2.0 * ws.estimatedNuggetValue) * Q.trace();
     }
   }
 }
 
+void GaussianProcess::initialize_workspace(MLEWorkspace& ws) const {
+  ws.thetaValues.resize(numVariables + 1);
+  ws.betaValues.resize(numPolyTerms);
+  ws.estimatedNuggetValue = 0.0;
+  ws.kernel = kernel_factory(kernel_type);
+  ws.GramMatrix.resize(numSamples, numSamples);
+  ws.GramMatrixDerivs.resize(numVariables + 1);
+  for (int k = 0; k < numVariables + 1; k++)
+    ws.GramMatrixDerivs[k].resize(numSamples, numSamples);
+}
+
+void GaussianProcess::optimize_hyperparameters(
+    const std::vector<double>& initial_guess,
+    const std::vector<double>& lower_bounds,
+    const std::vector<double>& upper_bounds, ParameterList& rol_params,
+    MLEWorkspace& ws, double& obj_value, VectorXd& obj_gradient) const {
+  initialize_workspace(ws);
+
+  ROL::Ptr<std::ostream> outStream;
+  Teuchos::oblackholestream bhs;
+  outStream = ROL::makePtrFromRef(bhs);
+
+  /* Uncomment if you'd like to print ROL's output to screen.
+   * Useful for debugging */
+  // outStream = ROL::makePtrFromRef(std::cout);
+
+  auto gp_objective = std::make_shared<GP_Objective>(*this, ws);
+
+  // Define algorithm
+  ROL::Ptr<ROL::Step<double>> step =
+      ROL::makePtr<ROL::LineSearchStep<double>>(rol_params);
+  ROL::Ptr<ROL::StatusTest<double>> status =
+      ROL::makePtr<ROL::StatusTest<double>>(rol_params);
+  ROL::Algorithm<double> algo(step, status, false);
+
+  /* set up parameter vectors and bounds */
+  ROL::Ptr<std::vector<double>> x_ptr =
+      ROL::makePtr<std::vector<double>>(initial_guess);
+  ROL::StdVector<double> x(x_ptr);
+  ROL::Ptr<ROL::Vector<double>> lop = ROL::makePtr<ROL::StdVector<double>>(
+      ROL::makePtr<std::vector<double>>(lower_bounds));
+  ROL::Ptr<ROL::Vector<double>> hip = ROL::makePtr<ROL::StdVector<double>>(
+      ROL::makePtr<std::vector<double>>(upper_bounds));
+  ROL::Ptr<ROL::Bounds<double>> bound =
+      ROL::makePtr<ROL::Bounds<double>>(lop, hip);
+
+  algo.run(x, *gp_objective, *bound, true, *outStream);
+  set_opt_params(*x_ptr, ws);
+
+  /* get the final objective function value and gradient */
+  negative_marginal_log_likelihood(ws, true, true, obj_value, obj_gradient);
+}
+
 void GaussianProcess::setup_hyperparameter_bounds(VectorXd& sigma_bounds,
                                                   MatrixXd& length_scale_bounds,
                                                   VectorXd& nugget_bounds) {
@@ -558,7 +756,7 @@ void GaussianProcess::setup_hyperparameter_bounds(VectorXd& sigma_bounds,
   }
 }
 
-int GaussianProcess::get_num_opt_variables() {
+int GaussianProcess::get_num_opt_variables() const {
   return numVariables + 1 + numPolyTerms + numNuggetTerms;
 }
 
@@ -576,6 +774,19 @@ void GaussianProcess::set_opt_params(const std::vector<double>& opt_params) {
     estimatedNuggetValue = opt_params[numVariables + 1 + numPolyTerms];
 }
 
+void GaussianProcess::set_opt_params(const std::vector<double>& opt_params,
+                                     MLEWorkspace& ws) const {
+  for (int i = 0; i < numVariables + 1; i++) ws.thetaValues(i) = opt_params[i];
+
+  if (estimateTrend) {
+    for (int i = 0; i < numPolyTerms; i++)
+      ws.betaValues(i) = opt_params[numVariables + 1 + i];
+  }
+
+  if (estimateNugget)
+    ws.estimatedNuggetValue = opt_params[numVariables + 1 + numPolyTerms];
+}
+
 void GaussianProcess::default_options() {
   // Scalar values for bound used by default. Advanced users can specify
   // ansiotropic legnth-scale bounds with an Eigen matrix in C++ or
@@ -623,6 +834,16 @@ void GaussianProcess::default_options() {
                            "scaler for variables");
   defaultConfigOptions.set("num restarts", 10,
                            "local optimizer number of initial iterates");
+  defaultConfigOptions.set("prediction block size", 128,
+                           "prediction points per Gram matrix tile");
+  /* Appending data: the hyperparameters may be frozen for a number of
+     appends, during which the factorization is updated incrementally */
+  defaultConfigOptions.sublist("Append").set(
+      "frozen updates", 0,
+      "appends with frozen hyperparameters before re-optimization");
+  defaultConfigOptions.sublist("Append").set(
+      "warm start", true,
+      "start re-optimization from the current hyperparameters");
   defaultConfigOptions.set("gp seed", 42,
                            "random seed for initial iterate generation");
   defaultConfigOptions.set("standardize response", true,
@@ -673,6 +894,82 @@ void GaussianProcess::compute_build_dists() {
   }
 }
 
+void GaussianProcess::extend_build_dists(const int num_old) {
+  for (int k = 0; k < numVariables; k++) {
+    MatrixXd& dists2 = cwiseDists2[k];
+    dists2.conservativeResize(numSamples, numSamples);
+    for (int j = num_old; j < numSamples; j++) {
+      dists2.col(j) =
+          (scaledBuildPoints.col(k).array() - scaledBuildPoints(j, k))
+              .square();
+      dists2.row(j).head(num_old) = dists2.col(j).head(num_old).transpose();
+    }
+  }
+}
+
+void GaussianProcess::update_factorization(const int num_old) {
+  const int num_new = numSamples - num_old;
+
+  /* Gram matrix columns of the new points, including nugget terms */
+  std::vector<MatrixXd> new_dists2(numVariables);
+  for (int k = 0; k < numVariables; k++)
+    new_dists2[k] = cwiseDists2[k].rightCols(num_new);
+  MatrixXd new_cols;
+  kernel->compute_gram(new_dists2, thetaValues, new_cols);
+  new_cols.bottomRows(num_new).diagonal().array() += fixedNuggetValue;
+  if (estimateNugget)
+    new_cols.bottomRows(num_new).diagonal().array() +=
+        exp(2.0 * estimatedNuggetValue);
+
+  GramMatrix.conservativeResize(numSamples, numSamples);
+  GramMatrix.rightCols(num_new) = new_cols;
+  GramMatrix.bottomLeftCorner(num_new, num_old) =
+      new_cols.topRows(num_old).transpose();
+
+  /* The pivoted LDLT of a full build cannot be extended, so the first
+   * update after it factors the previous Gram matrix without pivoting */
+  if (!incrementalFactor) {
+    Eigen::LLT<MatrixXd> llt(GramMatrix.topLeftCorner(num_old, num_old));
+    if (llt.info() != Eigen::Success) {
+      CholFact.compute(GramMatrix);
+      hasBestCholFact = true;
+      return;
+    }
+    gramFactorL = llt.matrixL();
+  }
+
+  /* Block Cholesky: [L 0; S^T L22] with S = L^{-1} B and
+   * L22 L22^T = C - S^T S, costing O(N^2 k) rather than O(N^3) */
+  MatrixXd S = gramFactorL.triangularView<Eigen::Lower>().solve(
+      new_cols.topRows(num_old));
+  MatrixXd schur = new_cols.bottomRows(num_new);
+  schur.noalias() -= S.transpose() * S;
+  Eigen::LLT<MatrixXd> schur_llt(schur);
+  if (schur_llt.info() != Eigen::Success) {
+    /* loss of positive definiteness: refactor with pivoting */
+    incrementalFactor = false;
+    gramFactorL.resize(0, 0);
+    CholFact.compute(GramMatrix);
+    hasBestCholFact = true;
+    return;
+  }
+  gramFactorL.conservativeResize(numSamples, numSamples);
+  gramFactorL.topRightCorner(num_old, num_new).setZero();
+  gramFactorL.bottomLeftCorner(num_new, num_old) = S.transpose();
+  gramFactorL.bottomRightCorner(num_new, num_new) = schur_llt.matrixL();
+  incrementalFactor = true;
+  hasBestCholFact = true;
+  /* the pivoted factorization is superseded */
+  CholFact = Eigen::LDLT<MatrixXd>();
+}
+
+MatrixXd GaussianProcess::solve_gram(const MatrixXd& rhs) const {
+  if (incrementalFactor)
+    return gramFactorL.transpose().triangularView<Eigen::Upper>().solve(
+        gramFactorL.triangularView<Eigen::Lower>().solve(rhs));
+  return CholFact.solve(rhs);
+}
+
 void GaussianProcess::compute_pred_dists(const MatrixXd& scaled_pred_pts) {
   const int num_pred_pts = scaled_pred_pts.rows();
   cwiseMixedDists.resize(numVariables);
@@ -697,17 +994,59 @@ void GaussianProcess::compute_pred_dists(const MatrixXd& scaled_pred_pts) {
   }
 }
 
+void GaussianProcess::compute_block_mixed_dists(
+    const MatrixXd& scaled_pred_pts, const int start, const int num_pts,
+    std::vector<MatrixXd>& mixed_dists2,
+    std::vector<MatrixXd>* mixed_dists) const {
+  mixed_dists2.resize(numVariables);
+  if (mixed_dists) mixed_dists->resize(numVariables);
+
+  for (int k = 0; k < numVariables; k++) {
+    MatrixXd& dists2 = mixed_dists2[k];
+    dists2 = scaled_pred_pts.col(k).segment(start, num_pts).replicate(
+        1, numSamples);
+    dists2.rowwise() -= scaledBuildPoints.col(k).transpose();
+    if (mixed_dists) (*mixed_dists)[k] = dists2;
+    dists2 = dists2.array().square();
+  }
+}
+
+void GaussianProcess::for_each_pred_block(
+    const int num_pred_pts,
+    const std::function<void(int, int, Kernel&)>& block_fn) const {
+  int block_size = defaultConfigOptions.get<int>("prediction block size");
+  if (configOptions.isParameter("prediction block size"))
+    block_size = configOptions.get<int>("prediction block size");
+  block_size = std::max(1, block_size);
+  const int num_blocks = (num_pred_pts + block_size - 1) / block_size;
+  const int num_threads = this->num_threads(num_blocks);
+
+  std::atomic<int> next_block(0);
+  auto run_blocks = [&](size_t) {
+    /* kernels hold intermediate data, so each thread has its own */
+    std::shared_ptr<Kernel> block_kernel = kernel_factory(kernel_type);
+    for (int b = next_block++; b < num_blocks; b = next_block++) {
+      const int start = b * block_size;
+      block_fn(start, std::min(block_size, num_pred_pts - start),
+               *block_kernel);
+    }
+  };
+  util::WorkStealingThreadPool::parallel_for(num_threads, run_blocks);
+}
+
+int GaussianProcess::num_threads(const int num_tasks) const {
+  const int num_threads =
+      util::WorkStealingThreadPool::kernel_concurrency();
+  return std::max(1, std::min(num_threads, num_tasks));
+}
+
 void GaussianProcess::compute_gram(const std::vector<MatrixXd>& dists2,
-                                   bool add_nugget, bool compute_derivs,
-                                   MatrixXd& gram) {
+                                   bool add_nugget, MatrixXd& gram) {
   const int num_rows = dists2[0].rows();
   const int num_cols = dists2[0].cols();
   gram.resize(num_rows, num_cols);
   kernel->compute_gram(dists2, thetaValues, gram);
 
-  if (compute_derivs)
-    kernel->compute_gram_derivs(gram, dists2, thetaValues, GramMatrixDerivs);
-
   if (add_nugget) {
     /* add in the fixed nugget */
     gram.diagonal().array() += fixedNuggetValue;
@@ -717,6 +1056,25 @@ void GaussianProcess::compute_gram(const std::vector<MatrixXd>& dists2,
   }
 }
 
+void GaussianProcess::compute_gram(const std::vector<MatrixXd>& dists2,
+                                   bool compute_derivs,
+                                   MLEWorkspace& ws) const {
+  const int num_rows = dists2[0].rows();
+  const int num_cols = dists2[0].cols();
+  ws.GramMatrix.resize(num_rows, num_cols);
+  ws.kernel->compute_gram(dists2, ws.thetaValues, ws.GramMatrix);
+
+  if (compute_derivs)
+    ws.kernel->compute_gram_derivs(ws.GramMatrix, dists2, ws.thetaValues,
+                                   ws.GramMatrixDerivs);
+
+  /* add in the fixed nugget */
+  ws.GramMatrix.diagonal().array() += fixedNuggetValue;
+  /* add in the estimated nugget */
+  if (estimateNugget)
+    ws.GramMatrix.diagonal().array() += exp(2.0 * ws.estimatedNuggetValue);
+}
+
 void GaussianProcess::generate_initial_guesses(
     const VectorXd& sigma_bounds, const MatrixXd& length_scale_bounds,
     const VectorXd& nugget_bounds, const int num_restarts, const int seed,
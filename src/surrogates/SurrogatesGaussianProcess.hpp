@@ -18,6 +18,7 @@
 
 #include <boost/serialization/base_object.hpp>
 #include <boost/serialization/vector.hpp>
+#include <functional>
 
 namespace dakota {
 
@@ -40,7 +41,11 @@ namespace surrogates {
  *  marginal log-likelihood function. ROL's implementation of
  *  L-BFGS-B is used to solve the optimization problem, and the
  *  algorithm may be run from multiple random initial guesses
- *  to increase the chance of finding the global minimum.
+ *  to increase the chance of finding the global minimum. The
+ *  runs may be performed concurrently on the threads shared by
+ *  Dakota's numerical kernels (serial by default), each with its
+ *  own objective and workspace, and the best run is selected
+ *  independently of the number of threads.
  *
  *  Once the GP is constructed its mean, variance,
  *  and covariance matrix can be computed for a set of prediction
@@ -48,6 +53,32 @@ namespace surrogates {
  */
 class GaussianProcess : public Surrogate {
  public:
+  /**
+   *  \brief State of the negative marginal log-likelihood for one
+   *  hyperparameter optimization run, such that runs may proceed
+   *  concurrently without sharing the model's Gram matrices.
+   */
+  struct MLEWorkspace {
+    /// Vector of log-space hyperparameters.
+    VectorXd thetaValues;
+    /// Vector of polynomial coefficients.
+    VectorXd betaValues;
+    /// Estimated nugget term.
+    double estimatedNuggetValue = 0.0;
+    /// Kernel instance (kernels hold intermediate data).
+    std::shared_ptr<Kernel> kernel;
+    /// Gram matrix for the build points.
+    MatrixXd GramMatrix;
+    /// Derivatives of the Gram matrix w.r.t. the hyperparameters.
+    std::vector<MatrixXd> GramMatrixDerivs;
+    /// Pivoted Cholesky factorization of GramMatrix.
+    Eigen::LDLT<MatrixXd> CholFact;
+    /// Difference between target values and trend predictions.
+    VectorXd trendTargetResidual;
+    /// Cholesky solve for Gram matrix with trendTargetResidual rhs.
+    VectorXd GramResidualSolution;
+  };
+
   /* Constructors and destructors */
 
   /// Constructor that uses defaultConfigOptions and does not build.
@@ -109,6 +140,25 @@ class GaussianProcess : public Surrogate {
    */
   void build(const MatrixXd& eval_points, const MatrixXd& response) override;
 
+  /**
+   * \brief Append build data to the GP. Distances to the new points are
+   * added to the existing ones and, while the hyperparameters are frozen
+   * (see the "Append" options), the Cholesky factorization is extended
+   * by a block update in O(N^2 k) rather than refactored. Otherwise the
+   * hyperparameters are re-optimized, optionally warm-started from the
+   * current values. The data and response scalings of build() are kept.
+   * \param[in] samples Matrix of new build points - (num_new by
+   * num_features).
+   * \param[in] response Matrix of new targets - (num_new by num_qoi = 1).
+   */
+  void append(const MatrixXd& samples, const MatrixXd& response);
+
+  /**
+   * \brief Re-optimize the hyperparameters for the current build data,
+   * e.g., after a series of append() calls with frozen hyperparameters.
+   */
+  void update();
+
   /**
    *  \brief Evaluate the Gaussian Process at a set of prediction points for a
    * single qoi. \param[in] eval_points Matrix for prediction points -
@@ -205,9 +255,11 @@ class GaussianProcess : public Surrogate {
 
   /**
    *  \brief Evaluate the negative marginal loglikelihood and its
-   *  gradient.
+   *  gradient at the current parameters of the model.
    *  \param[in] compute_grad Flag for computation of gradient.
-   *  \param[in] compute_gram Flag for various Gram matrix calculations.
+   *  \param[in] compute_gram Flag for various Gram matrix calculations
+   *  (the Gram matrix is always formed, as the evaluation uses a
+   *  temporary workspace).
    *  \param[out] obj_value Value of the objection function.
    *  \param[out] obj_gradient Gradient of the objective function.
    */
@@ -215,6 +267,26 @@ class GaussianProcess : public Surrogate {
                                         double& obj_value,
                                         VectorXd& obj_gradient);
 
+  /**
+   *  \brief Evaluate the negative marginal loglikelihood and its
+   *  gradient at the parameters of a workspace.
+   *  \param[in,out] ws Workspace holding the parameters and Gram matrices.
+   *  \param[in] compute_grad Flag for computation of gradient.
+   *  \param[in] compute_gram Flag for various Gram matrix calculations.
+   *  \param[out] obj_value Value of the objection function.
+   *  \param[out] obj_gradient Gradient of the objective function.
+   */
+  void negative_marginal_log_likelihood(MLEWorkspace& ws, bool compute_grad,
+                                        bool compute_gram, double& obj_value,
+                                        VectorXd& obj_gradient) const;
+
+  /**
+   *  \brief Size a workspace for the current build data and give it
+   *  its own kernel instance.
+   *  \param[out] ws Workspace to initialize.
+   */
+  void initialize_workspace(MLEWorkspace& ws) const;
+
   /**
    *  \brief Initialize the hyperparameter bounds for MLE from
    *  values in configOptions.
@@ -235,7 +307,7 @@ class GaussianProcess : public Surrogate {
    *  \returns Number of total optimization variables (hyperparameters + trend
    * coefficients + nugget)
    */
-  int get_num_opt_variables();
+  int get_num_opt_variables() const;
 
   /**
    *  \brief Get the dimension of the feature space.
@@ -265,12 +337,26 @@ class GaussianProcess : public Surrogate {
    */
   MatrixXd get_theta_history() { return thetaHistory; }
 
+  /**
+   * \brief Get the number of build points, including appended points.
+   * \returns numSamples Number of build points.
+   */
+  int get_num_samples() const { return numSamples; }
+
   /**
    *  \brief Update the vector of optimization parameters.
    *  \param[in] opt_params Vector of optimization parameter values.
    */
   void set_opt_params(const std::vector<double>& opt_params);
 
+  /**
+   *  \brief Update the vector of optimization parameters of a workspace.
+   *  \param[in] opt_params Vector of optimization parameter values.
+   *  \param[out] ws Workspace to update.
+   */
+  void set_opt_params(const std::vector<double>& opt_params,
+                      MLEWorkspace& ws) const;
+
   std::shared_ptr<Surrogate> clone() const override {
     return std::make_shared<GaussianProcess>(configOptions);
   }
@@ -284,24 +370,119 @@ class GaussianProcess : public Surrogate {
   /// Compute squared distances between the scaled build points.
   void compute_build_dists();
 
+  /**
+   *  \brief Extend the squared distances between the scaled build points
+   *  to points appended after the first num_old.
+   *  \param[in] num_old Number of build points with computed distances.
+   */
+  void extend_build_dists(const int num_old);
+
+  /**
+   *  \brief Optimize the hyperparameters over the build data and factor
+   *  the resulting Gram matrix.
+   *  \param[in] warm_start Whether to start one optimization run from the
+   *  current hyperparameters.
+   */
+  void fit_hyperparameters(bool warm_start);
+
+  /**
+   *  \brief Extend the Gram matrix and its Cholesky factorization to
+   *  build points appended after the first num_old, for fixed
+   *  hyperparameters.
+   *  \param[in] num_old Number of previously factored build points.
+   */
+  void update_factorization(const int num_old);
+
+  /**
+   *  \brief Solve with the factored Gram matrix of the build points.
+   *  \param[in] rhs Right-hand side(s).
+   *  \returns Solution(s).
+   */
+  MatrixXd solve_gram(const MatrixXd& rhs) const;
+
   /**
    *  \brief Compute distances between build and prediction points. This
-   * includes build-prediction and prediction-prediction distance matrices.
+   * includes build-prediction and prediction-prediction distance matrices,
+   * so it is reserved for covariance and Hessian evaluations.
    *  \param[in] scaled_pred_pts Matrix of scaled prediction points.
    */
   void compute_pred_dists(const MatrixXd& scaled_pred_pts);
 
+  /**
+   *  \brief Compute component-wise distances between a block of
+   *  prediction points and the build points.
+   *  \param[in] scaled_pred_pts Matrix of scaled prediction points.
+   *  \param[in] start Index of the first prediction point of the block.
+   *  \param[in] num_pts Number of prediction points in the block.
+   *  \param[out] mixed_dists2 Squared component-wise distances.
+   *  \param[out] mixed_dists Signed component-wise distances (if non-null).
+   */
+  void compute_block_mixed_dists(const MatrixXd& scaled_pred_pts,
+                                 const int start, const int num_pts,
+                                 std::vector<MatrixXd>& mixed_dists2,
+                                 std::vector<MatrixXd>* mixed_dists =
+                                     nullptr) const;
+
+  /**
+   *  \brief Apply a function to consecutive blocks of prediction points,
+   *  possibly concurrently. Tiles of the prediction Gram matrix are formed
+   *  per block, so scratch memory scales with the block size rather than
+   *  the number of prediction points.
+   *  \param[in] num_pred_pts Number of prediction points.
+   *  \param[in] block_fn Function of the block start, block size, and a
+   *  kernel instance owned by the calling thread.
+   */
+  void for_each_pred_block(
+      const int num_pred_pts,
+      const std::function<void(int, int, Kernel&)>& block_fn) const;
+
+  /**
+   *  \brief Number of threads to use for a number of independent tasks,
+   *  from the kernel concurrency shared by Dakota's threaded kernels.
+   *  \param[in] num_tasks Number of tasks.
+   *  \returns Number of threads, between 1 and num_tasks.
+   */
+  int num_threads(const int num_tasks) const;
+
   /**
    *  \brief Compute a Gram matrix given a vector of squared distances and
-   *  optionally compute its derivatives and/or adds nugget terms.
+   *  optionally add nugget terms.
    *  \param[in] dists2 Vector of squared distance matrices.
    *  \param[in] add_nugget Bool for whether or add nugget terms.
-   *  \param[in] compute_derivs Bool for whether or not to compute the
-   *  derivatives of the Gram matrix.
    *  \param[out] gram Gram matrix.
    */
   void compute_gram(const std::vector<MatrixXd>& dists2, bool add_nugget,
-                    bool compute_derivs, MatrixXd& gram);
+                    MatrixXd& gram);
+
+  /**
+   *  \brief Compute a Gram matrix and optionally its derivatives for the
+   *  parameters of a workspace, adding the nugget terms.
+   *  \param[in] dists2 Vector of squared distance matrices.
+   *  \param[in] compute_derivs Bool for whether or not to compute the
+   *  derivatives of the Gram matrix.
+   *  \param[in,out] ws Workspace providing the parameters and kernel and
+   *  receiving the Gram matrix (and derivatives).
+   */
+  void compute_gram(const std::vector<MatrixXd>& dists2, bool compute_derivs,
+                    MLEWorkspace& ws) const;
+
+  /**
+   *  \brief Run one hyperparameter optimization from an initial guess.
+   *  \param[in] initial_guess Initial optimization parameters.
+   *  \param[in] lower_bounds Lower bounds for the optimization parameters.
+   *  \param[in] upper_bounds Upper bounds for the optimization parameters.
+   *  \param[in,out] rol_params ROL options (per thread, as ROL may add
+   *  defaults).
+   *  \param[out] ws Workspace holding the final parameters.
+   *  \param[out] obj_value Final objective function value.
+   *  \param[out] obj_gradient Final objective function gradient.
+   */
+  void optimize_hyperparameters(const std::vector<double>& initial_guess,
+                                const std::vector<double>& lower_bounds,
+                                const std::vector<double>& upper_bounds,
+                                ParameterList& rol_params, MLEWorkspace& ws,
+                                double& obj_value,
+                                VectorXd& obj_gradient) const;
 
   /**
    *  \brief Randomly generate initial guesses for the optimization routine.
@@ -374,15 +555,6 @@ class GaussianProcess : public Surrogate {
   /// Gram matrix for the build points
   MatrixXd GramMatrix;
 
-  /// Difference between target values and trend predictions.
-  VectorXd trendTargetResidual;
-
-  /// Cholesky solve for Gram matrix with trendTargetResidual rhs.
-  VectorXd GramResidualSolution;
-
-  /// Derivatives of the Gram matrix w.r.t. the hyperparameters.
-  std::vector<MatrixXd> GramMatrixDerivs;
-
   /// Squared component-wise distances between points in the surrogate dataset.
   std::vector<MatrixXd> cwiseDists2;
 
@@ -401,6 +573,16 @@ class GaussianProcess : public Surrogate {
   /// Flag for recomputation of the best Cholesky factorization.
   bool hasBestCholFact;
 
+  /// Unpivoted lower Cholesky factor extended by append() (in use when
+  /// incrementalFactor is true, superseding CholFact).
+  MatrixXd gramFactorL;
+
+  /// Flag for use of the incrementally updated gramFactorL.
+  bool incrementalFactor = false;
+
+  /// Number of append() calls since hyperparameter optimization.
+  int numFrozenUpdates = 0;
+
   /// Gram matrix for the prediction points.
   MatrixXd predGramMatrix;
 
@@ -491,6 +673,7 @@ void GaussianProcess::serialize(Archive& archive, const unsigned int version) {
 
   // DTS: Set false so that the Cholesky factorization is recomputed after load
   hasBestCholFact = false;
+  incrementalFactor = false;
   archive& hasBestCholFact;
   if (Archive::is_saving::value)
     writeParameterListToYamlFile(configOptions, "GaussianProcess.yaml");
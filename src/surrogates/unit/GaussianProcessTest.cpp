@@ -11,6 +11,8 @@
 #include "surrogates_tools.hpp"
 #include "util_common.hpp"
 #include "util_data_types.hpp"
+#include "util_math_tools.hpp"
+#include "WorkStealingThreadPool.hpp"
 
 #define BOOST_TEST_MODULE surrogates_GaussianProcessTest
 #include <boost/test/included/unit_test.hpp>
@@ -19,6 +21,7 @@
 #include <boost/archive/text_iarchive.hpp>
 #include <boost/archive/text_oarchive.hpp>
 #include <boost/filesystem.hpp>
+#include <cmath>
 #include <fstream>
 
 // BMA TODO: Review with team for best practice
@@ -905,4 +908,123 @@ BOOST_AUTO_TEST_CASE(test_surrogates_gp_read_from_parameterlist) {
                 "SVD");
 }
 
+BOOST_AUTO_TEST_CASE(test_surrogates_gp_concurrent_restarts) {
+  MatrixXd samples, length_scale_bounds, eval_pts;
+  VectorXd response, sigma_bounds;
+
+  get_2D_gp_test_data(samples, response, eval_pts);
+  get_gp_hyperparameter_bounds(2, sigma_bounds, length_scale_bounds);
+  ParameterList param_list =
+      get_gp_config_options(sigma_bounds, length_scale_bounds);
+  param_list.set("num restarts", 8);
+  param_list.set("verbosity", 0);
+
+  /* the optimization runs and the selected best run do not depend on
+   * the number of threads */
+  GaussianProcess gp_serial(param_list);
+  gp_serial.build(samples, response);
+  util::WorkStealingThreadPool::kernel_concurrency(4);
+  GaussianProcess gp_threaded(param_list);
+  gp_threaded.build(samples, response);
+  util::WorkStealingThreadPool::kernel_concurrency(1);
+
+  BOOST_CHECK(gp_serial.get_objective_function_history() ==
+              gp_threaded.get_objective_function_history());
+  BOOST_CHECK(gp_serial.get_theta_history() ==
+              gp_threaded.get_theta_history());
+  BOOST_CHECK(gp_serial.get_objective_gradient_history() ==
+              gp_threaded.get_objective_gradient_history());
+  BOOST_CHECK(gp_serial.value(eval_pts) == gp_threaded.value(eval_pts));
+}
+
+BOOST_AUTO_TEST_CASE(test_surrogates_gp_blocked_prediction) {
+  MatrixXd samples, length_scale_bounds, eval_pts;
+  VectorXd response, sigma_bounds;
+
+  get_2D_gp_test_data(samples, response, eval_pts);
+  get_gp_hyperparameter_bounds(2, sigma_bounds, length_scale_bounds);
+  ParameterList param_list =
+      get_gp_config_options(sigma_bounds, length_scale_bounds);
+  param_list.set("verbosity", 0);
+  param_list.sublist("Trend").set("estimate trend", true);
+
+  GaussianProcess gp(param_list);
+  gp.build(samples, response);
+  MatrixXd pred_pts =
+      create_uniform_random_double_matrix(37, 2, 11, true, -1.0, 1.0);
+
+  /* variance is the diagonal of the covariance, without forming it */
+  VectorXd cov_diag = gp.covariance(pred_pts).diagonal();
+  VectorXd var = gp.variance(pred_pts);
+  BOOST_CHECK(relative_allclose(var, cov_diag, 1.0e-8));
+
+  /* results do not depend on the block size or number of threads */
+  VectorXd mean = gp.value(pred_pts);
+  MatrixXd grad = gp.gradient(pred_pts);
+  ParameterList opts;
+  gp.get_options(opts);
+  opts.set("prediction block size", 5);
+  gp.set_options(opts);
+  util::WorkStealingThreadPool::kernel_concurrency(3);
+  BOOST_CHECK(relative_allclose(gp.value(pred_pts), mean, 1.0e-12));
+  BOOST_CHECK(relative_allclose(gp.variance(pred_pts), var, 1.0e-12));
+  BOOST_CHECK(relative_allclose(gp.gradient(pred_pts), grad, 1.0e-12));
+  util::WorkStealingThreadPool::kernel_concurrency(1);
+}
+
+BOOST_AUTO_TEST_CASE(test_surrogates_gp_append) {
+  const int num_vars = 2, num_initial = 20, num_appends = 12;
+  MatrixXd all_samples = create_uniform_random_double_matrix(
+      num_initial + num_appends, num_vars, 13, true, -1.0, 1.0);
+  MatrixXd all_response(all_samples.rows(), 1);
+  for (int i = 0; i < all_samples.rows(); ++i)
+    all_response(i, 0) = std::sin(3.0 * all_samples(i, 0)) +
+                         all_samples(i, 1) * all_samples(i, 1);
+
+  MatrixXd length_scale_bounds;
+  VectorXd sigma_bounds;
+  get_gp_hyperparameter_bounds(num_vars, sigma_bounds, length_scale_bounds);
+  ParameterList param_list =
+      get_gp_config_options(sigma_bounds, length_scale_bounds);
+  param_list.set("verbosity", 0);
+  param_list.set("num restarts", 5);
+  param_list.sublist("Nugget").set("fixed nugget", 1.0e-8);
+  param_list.sublist("Append").set("frozen updates", num_appends);
+
+  /* frozen appends give the same predictions as a full factorization with
+   * the same hyperparameters and scaling */
+  GaussianProcess gp(param_list);
+  gp.build(all_samples.topRows(num_initial), all_response.topRows(num_initial));
+  MatrixXd theta = gp.get_theta_history();
+  for (int i = 0; i < num_appends; ++i)
+    gp.append(all_samples.row(num_initial + i),
+              all_response.row(num_initial + i));
+  BOOST_CHECK_EQUAL(gp.get_num_samples(), num_initial + num_appends);
+  BOOST_CHECK(gp.get_theta_history() == theta);
+
+  MatrixXd pred_pts =
+      create_uniform_random_double_matrix(15, num_vars, 17, true, -1.0, 1.0);
+  VectorXd appended_mean = gp.value(pred_pts);
+  VectorXd appended_var = gp.variance(pred_pts);
+  /* the appended points are (nearly) interpolated */
+  VectorXd appended_fit = gp.value(all_samples.bottomRows(num_appends));
+  BOOST_CHECK(relative_allclose(appended_fit,
+                                all_response.bottomRows(num_appends), 1.0e-4));
+
+  /* a save/load recomputes the factorization from the full Gram matrix */
+  std::string filename("gp_append_test.surr");
+  boost::filesystem::remove(filename);
+  Surrogate::save(gp, filename, true);
+  GaussianProcess gp_loaded;
+  Surrogate::load(filename, true, gp_loaded);
+  BOOST_CHECK(relative_allclose(gp_loaded.value(pred_pts), appended_mean,
+                                1.0e-6));
+  BOOST_CHECK(relative_allclose(gp_loaded.variance(pred_pts), appended_var,
+                                1.0e-4));
+
+  /* re-optimization after the frozen updates */
+  gp.update();
+  BOOST_CHECK_EQUAL(gp.get_theta_history().rows(), 5);
+}
+
 }  // namespace
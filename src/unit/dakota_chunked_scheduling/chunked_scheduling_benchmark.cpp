@@ -0,0 +1,137 @@
+/*  _______________________________________________________________________
+
+    Dakota: Explore and predict with confidence.
+    Copyright 2014-2023
+    National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Dakota directory.
+    _______________________________________________________________________ */
+
+#include "opt_tpl_test.hpp"
+
+#include <chrono>
+#include <iostream>
+
+#define BOOST_TEST_MODULE dakota_chunked_scheduling_benchmark
+#include <boost/test/included/unit_test.hpp>
+
+using namespace Dakota;
+
+namespace {
+
+/// initializes MPI when the test is run under mpirun
+struct MPIFixture
+{
+  MPIFixture(): initialized(false)
+  {
+#ifdef DAKOTA_HAVE_MPI
+    int flag = 0;
+    MPI_Initialized(&flag);
+    if (!flag) {
+      int argc = boost::unit_test::framework::master_test_suite().argc;
+      char** argv = boost::unit_test::framework::master_test_suite().argv;
+      MPI_Init(&argc, &argv);
+      initialized = true;
+    }
+#endif
+  }
+
+  ~MPIFixture()
+  {
+#ifdef DAKOTA_HAVE_MPI
+    if (initialized)
+      MPI_Finalize();
+#endif
+  }
+
+  /// whether MPI was initialized by this fixture
+  bool initialized;
+};
+
+/// number of processors in MPI_COMM_WORLD
+int world_size()
+{
+  int size = 1;
+#ifdef DAKOTA_HAVE_MPI
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+#endif
+  return size;
+}
+
+/// rank in MPI_COMM_WORLD
+int world_rank()
+{
+  int rank = 0;
+#ifdef DAKOTA_HAVE_MPI
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+#endif
+  return rank;
+}
+
+/// Monte Carlo study of the inexpensive 20-D generalized Rosenbrock
+/// function, scheduled by a dedicated master
+String sampling_input(int num_samples, bool chunked)
+{
+  String input =
+    "environment \n"
+    "method \n"
+    "  sampling \n"
+    "    sample_type random \n"
+    "    samples " + std::to_string(num_samples) + " \n"
+    "    seed 1234 \n"
+    "    output silent \n"
+    "variables \n"
+    "  uniform_uncertain 20 \n"
+    "    lower_bounds 20*-2.0 \n"
+    "    upper_bounds 20*2.0 \n"
+    "interface \n"
+    "  direct \n"
+    "    analysis_drivers = 'generalized_rosenbrock' \n"
+    "  deactivate evaluation_cache restart_file \n"
+    "  evaluation_scheduling \n"
+    "    master \n";
+  if (chunked)
+    input += "      chunk_evaluations \n";
+  input +=
+    "responses \n"
+    "  response_functions = 1 \n"
+    "  no_gradients \n"
+    "  no_hessians \n";
+  return input;
+}
+
+/// execute the study, reporting its evaluation throughput
+void run_study(const String& input, const String& label, int num_evals)
+{
+  typedef std::chrono::steady_clock clock;
+  typedef std::chrono::duration<double> seconds;
+  std::shared_ptr<LibraryEnvironment> env(Opt_TPL_Test::create_env(input));
+  clock::time_point t0 = clock::now();
+  env->execute();
+  double elapsed = seconds(clock::now() - t0).count();
+  if (world_rank() == 0)
+    std::cout << label << ": " << num_evals << " evaluations in " << elapsed
+	      << " s, " << num_evals / elapsed << " evaluations/s" << std::endl;
+}
+
+}
+
+BOOST_GLOBAL_FIXTURE(MPIFixture);
+
+
+/** Evaluation throughput of one evaluation per message and of chunked
+    evaluations, under mpirun with a master and at least two servers */
+BOOST_AUTO_TEST_CASE(test_chunked_scheduling_throughput)
+{
+  if (world_size() < 3) {
+    BOOST_TEST_MESSAGE("chunked scheduling benchmark requires mpirun with "
+		       "at least 3 processors; skipped");
+    return;
+  }
+
+  const int num_samples = 20000;
+  run_study(sampling_input(num_samples, false), "one evaluation per message",
+	    num_samples);
+  run_study(sampling_input(num_samples, true), "chunked evaluations",
+	    num_samples);
+}
@@ -0,0 +1,163 @@
+/*  _______________________________________________________________________
+
+    Dakota: Explore and predict with confidence.
+    Copyright 2014-2023
+    National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Dakota directory.
+    _______________________________________________________________________ */
+
+#include "opt_tpl_test.hpp"
+#include "ApplicationInterface.hpp"
+
+#define BOOST_TEST_MODULE dakota_chunked_scheduling_test
+#include <boost/test/included/unit_test.hpp>
+
+using namespace Dakota;
+
+namespace {
+
+/// initializes MPI when the test is run under mpirun
+struct MPIFixture
+{
+  MPIFixture(): initialized(false)
+  {
+#ifdef DAKOTA_HAVE_MPI
+    int flag = 0;
+    MPI_Initialized(&flag);
+    if (!flag) {
+      int argc = boost::unit_test::framework::master_test_suite().argc;
+      char** argv = boost::unit_test::framework::master_test_suite().argv;
+      MPI_Init(&argc, &argv);
+      initialized = true;
+    }
+#endif
+  }
+
+  ~MPIFixture()
+  {
+#ifdef DAKOTA_HAVE_MPI
+    if (initialized)
+      MPI_Finalize();
+#endif
+  }
+
+  /// whether MPI was initialized by this fixture
+  bool initialized;
+};
+
+/// number of processors in MPI_COMM_WORLD
+int world_size()
+{
+  int size = 1;
+#ifdef DAKOTA_HAVE_MPI
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+#endif
+  return size;
+}
+
+/// rank in MPI_COMM_WORLD
+int world_rank()
+{
+  int rank = 0;
+#ifdef DAKOTA_HAVE_MPI
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+#endif
+  return rank;
+}
+
+/// Monte Carlo study of the inexpensive 20-D generalized Rosenbrock
+/// function, scheduled by a dedicated master
+String sampling_input(int num_samples, bool chunked)
+{
+  String input =
+    "environment \n"
+    "method \n"
+    "  sampling \n"
+    "    sample_type random \n"
+    "    samples " + std::to_string(num_samples) + " \n"
+    "    seed 1234 \n"
+    "    output silent \n"
+    "variables \n"
+    "  uniform_uncertain 20 \n"
+    "    lower_bounds 20*-2.0 \n"
+    "    upper_bounds 20*2.0 \n"
+    "interface \n"
+    "  direct \n"
+    "    analysis_drivers = 'generalized_rosenbrock' \n"
+    "  deactivate evaluation_cache restart_file \n"
+    "  evaluation_scheduling \n"
+    "    master \n";
+  if (chunked)
+    input += "      chunk_evaluations \n";
+  input +=
+    "responses \n"
+    "  response_functions = 1 \n"
+    "  no_gradients \n"
+    "  no_hessians \n";
+  return input;
+}
+
+/// execute the study
+std::shared_ptr<LibraryEnvironment> run_study(const String& input)
+{
+  std::shared_ptr<LibraryEnvironment> env(Opt_TPL_Test::create_env(input));
+  env->execute();
+  return env;
+}
+
+}
+
+BOOST_GLOBAL_FIXTURE(MPIFixture);
+
+
+/** Chunks start at one evaluation, grow toward 10 ms of observed
+    evaluation time and are bounded by the guided share of the
+    remaining jobs and the maximum size */
+BOOST_AUTO_TEST_CASE(test_chunked_scheduling_chunk_size)
+{
+  // no evaluation time observed yet
+  BOOST_CHECK_EQUAL(ApplicationInterface::evaluation_chunk_size(1000, 4, 64,
+    0.), 1u);
+  // 4 ms evaluations: 3 per chunk
+  BOOST_CHECK_EQUAL(ApplicationInterface::evaluation_chunk_size(1000, 4, 64,
+    4.e-3), 3u);
+  // 1 us evaluations: limited by the maximum size
+  BOOST_CHECK_EQUAL(ApplicationInterface::evaluation_chunk_size(100000, 4, 64,
+    1.e-6), 64u);
+  // few remaining jobs: half of an even share
+  BOOST_CHECK_EQUAL(ApplicationInterface::evaluation_chunk_size(40, 4, 64,
+    1.e-6), 5u);
+  BOOST_CHECK_EQUAL(ApplicationInterface::evaluation_chunk_size(3, 4, 64,
+    1.e-6), 1u);
+  // expensive evaluations are sent singly
+  BOOST_CHECK_EQUAL(ApplicationInterface::evaluation_chunk_size(1000, 4, 64,
+    1.), 1u);
+}
+
+
+/** Under mpirun with a master and at least two servers, a chunked
+    study returns the same statistics as one evaluation per message */
+BOOST_AUTO_TEST_CASE(test_chunked_scheduling_matches_unchunked)
+{
+  if (world_size() < 3) {
+    BOOST_TEST_MESSAGE("chunked scheduling comparison requires mpirun with "
+		       "at least 3 processors; skipped");
+    return;
+  }
+
+  const int num_samples = 500;
+  std::shared_ptr<LibraryEnvironment>
+    single_env = run_study(sampling_input(num_samples, false)),
+    chunked_env = run_study(sampling_input(num_samples, true));
+
+  if (world_rank() == 0) {
+    const RealVector& single_stats
+      = single_env->response_results().function_values();
+    const RealVector& chunked_stats
+      = chunked_env->response_results().function_values();
+    BOOST_REQUIRE_EQUAL(single_stats.length(), chunked_stats.length());
+    for (int i=0; i<single_stats.length(); ++i)
+      BOOST_CHECK_EQUAL(single_stats[i], chunked_stats[i]);
+  }
+}
@@ -0,0 +1,218 @@
+/*  _______________________________________________________________________
+
+    Dakota: Explore and predict with confidence.
+    Copyright 2014-2023
+    National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Dakota directory.
+    _______________________________________________________________________ */
+
+#include "EvaluationRuntimePredictor.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <numeric>
+#include <queue>
+
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_real_distribution.hpp>
+
+#define BOOST_TEST_MODULE dakota_cost_aware_scheduling_test
+#include <boost/test/included/unit_test.hpp>
+
+using namespace Dakota;
+
+namespace {
+
+/// a job of a synthetic study: discrete key, continuous variables and
+/// true evaluation time
+struct Job
+{
+  RealArray key;
+  RealVector cVars;
+  Real cost;
+};
+
+/// synthetic cost of an evaluation
+typedef std::function<Real(const RealArray&, const RealVector&)> CostFunction;
+
+/// parameter-dependent cost with a heavy tail in the first variable
+Real exponential_cost(const RealArray& key, const RealVector& c_vars)
+{ return std::exp(3. * c_vars[0] - 0.5 * c_vars[1]); }
+
+/// mixed-fidelity cost: key 1 is the high-fidelity model, 50 times as
+/// expensive, and both fidelities vary mildly with the variables
+Real fidelity_cost(const RealArray& key, const RealVector& c_vars)
+{ return ((key[0] > 0.) ? 50. : 1.) * (1. + 0.5 * c_vars[2]); }
+
+/// a batch of num_jobs jobs with 3 variables uniform on [0,1], a tenth
+/// of them at the high-fidelity key
+std::vector<Job> make_batch(size_t num_jobs, const CostFunction& cost,
+			    boost::mt19937& rng)
+{
+  boost::random::uniform_real_distribution<> uniform(0., 1.);
+  std::vector<Job> batch(num_jobs);
+  for (size_t j=0; j<num_jobs; ++j) {
+    batch[j].key.assign(1, (uniform(rng) < 0.1) ? 1. : 0.);
+    batch[j].cVars.size(3);
+    for (int i=0; i<3; ++i)
+      batch[j].cVars[i] = uniform(rng);
+    batch[j].cost = cost(batch[j].key, batch[j].cVars);
+  }
+  return batch;
+}
+
+/// simulate dynamic list scheduling of the batch on num_servers
+/// servers, each job in order going to the first server to become
+/// free; returns the makespan
+Real simulate_dynamic(const std::vector<Job>& batch, const SizetArray& order,
+		      size_t num_servers)
+{
+  std::priority_queue<Real, RealArray, std::greater<Real> > free_times;
+  for (size_t s=0; s<num_servers; ++s)
+    free_times.push(0.);
+  Real makespan = 0.;
+  for (size_t i=0; i<order.size(); ++i) {
+    Real finish = free_times.top() + batch[order[i]].cost;
+    free_times.pop();  free_times.push(finish);
+    makespan = std::max(makespan, finish);
+  }
+  return makespan;
+}
+
+/// makespan of a static assignment of the batch to servers
+Real simulate_static(const std::vector<Job>& batch,
+		     const SizetArray& assignment, size_t num_servers)
+{
+  RealArray loads(num_servers, 0.);
+  for (size_t j=0; j<batch.size(); ++j)
+    loads[assignment[j]] += batch[j].cost;
+  return *std::max_element(loads.begin(), loads.end());
+}
+
+/// lower bound on the makespan: the larger of the evenly spread total
+/// cost and the longest job
+Real ideal_makespan(const std::vector<Job>& batch, size_t num_servers)
+{
+  Real total = 0., longest = 0.;
+  for (size_t j=0; j<batch.size(); ++j)
+    { total += batch[j].cost; longest = std::max(longest, batch[j].cost); }
+  return std::max(total / num_servers, longest);
+}
+
+}
+
+
+/** Log-linear runtimes are recovered per key, unseen keys fall back to
+    the pooled fit, and nothing is predicted before any observation */
+BOOST_AUTO_TEST_CASE(test_cost_aware_scheduling_predictor)
+{
+  EvaluationRuntimePredictor predictor;
+  RealArray key0(1, 0.), key1(1, 1.), key2(1, 2.);
+  RealVector x(3);
+  BOOST_CHECK_EQUAL(predictor.predict(key0, x), 0.);
+
+  boost::mt19937 rng(3);
+  boost::random::uniform_real_distribution<> uniform(0., 1.);
+  for (size_t j=0; j<400; ++j) {
+    for (int i=0; i<3; ++i)
+      x[i] = uniform(rng);
+    Real base = 0.01 * std::exp(2. * x[0] - x[1]);
+    predictor.update((j % 2) ? key1 : key0, x, (j % 2) ? 10. * base : base);
+  }
+  BOOST_CHECK_EQUAL(predictor.num_observations(), 400u);
+
+  for (size_t j=0; j<50; ++j) {
+    for (int i=0; i<3; ++i)
+      x[i] = 0.1 + 0.8 * uniform(rng);
+    Real base = 0.01 * std::exp(2. * x[0] - x[1]);
+    BOOST_CHECK_CLOSE(predictor.predict(key0, x), base, 5.);
+    BOOST_CHECK_CLOSE(predictor.predict(key1, x), 10. * base, 5.);
+    // pooled over both keys: between the two fidelities
+    Real pooled = predictor.predict(key2, x);
+    BOOST_CHECK(pooled > base && pooled < 10. * base);
+  }
+}
+
+
+/** Longest-first ordering is stable and the static balance follows the
+    longest-processing-time rule */
+BOOST_AUTO_TEST_CASE(test_cost_aware_scheduling_ordering)
+{
+  const Real times[] = { 2., 5., 1., 5., 3. };
+  RealArray predicted(times, times + 5);
+  SizetArray order;
+  EvaluationRuntimePredictor::longest_first(predicted, order);
+  const size_t expected[] = { 1, 3, 4, 0, 2 };
+  BOOST_CHECK_EQUAL_COLLECTIONS(order.begin(), order.end(), expected,
+				expected + 5);
+
+  const Real loads[] = { 1., 2., 3., 4., 5., 6. };
+  SizetArray assignment;
+  Real makespan = EvaluationRuntimePredictor::
+    balance_static(RealArray(loads, loads + 6), 3, assignment);
+  BOOST_CHECK_EQUAL(makespan, 7.);
+  RealArray server_loads(3, 0.);
+  for (size_t j=0; j<6; ++j)
+    server_loads[assignment[j]] += loads[j];
+  for (size_t s=0; s<3; ++s)
+    BOOST_CHECK_EQUAL(server_loads[s], 7.);
+}
+
+
+/** Simulated batches on 8 servers for synthetic cost functions: after
+    a first batch in queue order trains the predictor, longest-
+    predicted-first dispatch shortens the makespan toward the ideal for
+    both dynamic and static schedules.  Efficiencies are reported. */
+BOOST_AUTO_TEST_CASE(test_cost_aware_scheduling_simulation)
+{
+  const size_t num_servers = 8, num_batches = 5, num_jobs = 400;
+  const CostFunction costs[] = { exponential_cost, fidelity_cost };
+  const char* labels[] = { "parameter-dependent", "mixed-fidelity" };
+  for (size_t c=0; c<2; ++c) {
+    boost::mt19937 rng(17);
+    boost::random::uniform_real_distribution<> noise(0.9, 1.1);
+    EvaluationRuntimePredictor predictor;
+    Real ideal = 0., fifo_dynamic = 0., lpt_dynamic = 0., fifo_static = 0.,
+      lpt_static = 0.;
+    for (size_t b=0; b<num_batches; ++b) {
+      std::vector<Job> batch = make_batch(num_jobs, costs[c], rng);
+      SizetArray fifo(num_jobs), round_robin(num_jobs), order, assignment;
+      std::iota(fifo.begin(), fifo.end(), 0);
+      for (size_t j=0; j<num_jobs; ++j)
+	round_robin[j] = j % num_servers;
+      Real batch_fifo_dynamic = simulate_dynamic(batch, fifo, num_servers),
+	batch_fifo_static = simulate_static(batch, round_robin, num_servers);
+
+      if (predictor.num_observations()) {
+	RealArray predicted(num_jobs);
+	for (size_t j=0; j<num_jobs; ++j)
+	  predicted[j] = predictor.predict(batch[j].key, batch[j].cVars);
+	EvaluationRuntimePredictor::longest_first(predicted, order);
+	EvaluationRuntimePredictor::
+	  balance_static(predicted, num_servers, assignment);
+	Real batch_ideal = ideal_makespan(batch, num_servers);
+	ideal        += batch_ideal;
+	fifo_dynamic += batch_fifo_dynamic;
+	fifo_static  += batch_fifo_static;
+	lpt_dynamic  += simulate_dynamic(batch, order, num_servers);
+	lpt_static   += simulate_static(batch, assignment, num_servers);
+      }
+      // observed wall times carry 10% noise
+      for (size_t j=0; j<num_jobs; ++j)
+	predictor.update(batch[j].key, batch[j].cVars,
+			 batch[j].cost * noise(rng));
+    }
+
+    BOOST_CHECK(lpt_dynamic < fifo_dynamic);
+    BOOST_CHECK(lpt_static < fifo_static);
+    BOOST_CHECK(ideal / lpt_dynamic > 0.98);
+    BOOST_CHECK(ideal / lpt_static > 0.95);
+    BOOST_TEST_MESSAGE(labels[c] << " costs, " << num_servers
+      << " servers: dynamic efficiency " << ideal / fifo_dynamic
+      << " in queue order, " << ideal / lpt_dynamic
+      << " longest-predicted-first; static efficiency " << ideal / fifo_static
+      << " round robin, " << ideal / lpt_static << " balanced");
+  }
+}
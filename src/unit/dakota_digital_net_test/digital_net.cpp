@@ -10,10 +10,13 @@
 #include <exception>
 
 #include "DigitalNet.hpp"
+#include "dakota_bit_utils.hpp"
+#include "low_discrepancy_data.hpp"
 
 #include <fstream>
 #include <cmath>
 #include <ciso646>
+#include <cstring>
 #include "opt_tpl_test.hpp"
 
 #define BOOST_TEST_MODULE dakota_digital_net_test
@@ -632,6 +635,102 @@ BOOST_AUTO_TEST_CASE(digital_net_check_annulus)
   BOOST_CHECK_CLOSE(4*integrand, 0.65*std::atan(1), 1e-1);
 }
 
+// +-------------------------------------------------------------------------+
+// |              Compare digital net points with scalar recursion           |
+// +-------------------------------------------------------------------------+
+BOOST_AUTO_TEST_CASE(digital_net_check_bitwise_equal_to_scalar_recursion)
+{
+  // Generating matrices
+  Dakota::UInt64Matrix C(
+    Teuchos::View, &Dakota::joe_kuo_d1024_t32_m32[0][0], 1024, 1024, 32
+  );
+
+  // Create digital net without randomization
+  Dakota::DigitalNet digital_net(
+    C,
+    32,
+    32,
+    32,
+    false,
+    false,
+    0,
+    Dakota::DIGITAL_NET_GRAY_CODE_ORDERING,
+    false,
+    Dakota::SILENT_OUTPUT
+  );
+
+  // Get digital net points, enough to be generated on several threads
+  size_t numPoints = 1 << 14;
+  size_t dimension = 24;
+  Dakota::RealMatrix points(dimension, numPoints);
+  digital_net.get_points(points);
+
+  // Compute the points one after the other using the Antonov & Saleev
+  // recursion on the bitreversed generating matrices
+  std::vector<Dakota::UInt64> x(dimension, 0);
+  double oneOnPow2t = 1 / Dakota::Real(Dakota::UInt64(1) << 63) / 2;
+  size_t numDifferent = 0;
+  for ( size_t k = 0; k < numPoints; k++ )
+  {
+    if ( k > 0 )
+    {
+      auto n = Dakota::count_consecutive_trailing_zero_bits(k);
+      for ( size_t j = 0; j < dimension; j++ )
+      {
+        x[j] ^= Dakota::bitreverse(C(j, n));
+      }
+    }
+    for ( size_t j = 0; j < dimension; j++ )
+    {
+      double exact = x[j] * oneOnPow2t;
+      if ( std::memcmp(&points[k][j], &exact, sizeof(double)) != 0 )
+      {
+        numDifferent++;
+      }
+    }
+  }
+  BOOST_CHECK(numDifferent == 0);
+}
+
+// +-------------------------------------------------------------------------+
+// |                  Check digital net points in sub-ranges                 |
+// +-------------------------------------------------------------------------+
+BOOST_AUTO_TEST_CASE(digital_net_check_sub_ranges)
+{
+  // Get randomized digital net with a fixed seed
+  Dakota::DigitalNet digital_net(23);
+
+  // Get all points at once
+  size_t numPoints = 1 << 15;
+  size_t dimension = 8;
+  Dakota::RealMatrix points(dimension, numPoints);
+  digital_net.get_points(points);
+
+  // Get the same points on several threads
+  dakota::util::WorkStealingThreadPool::kernel_concurrency(4);
+  Dakota::RealMatrix threaded_points(dimension, numPoints);
+  digital_net.get_points(threaded_points);
+  dakota::util::WorkStealingThreadPool::kernel_concurrency(1);
+  BOOST_CHECK(threaded_points == points);
+
+  // Get the same points in sub-ranges that start at arbitrary indices
+  size_t bounds[] = { 0, 1, 7, 1000, 12345, 20000, numPoints };
+  for ( size_t r = 0; r + 1 < sizeof(bounds)/sizeof(bounds[0]); r++ )
+  {
+    size_t nMin = bounds[r];
+    size_t nMax = bounds[r + 1];
+    Dakota::RealMatrix sub_points(dimension, nMax - nMin);
+    digital_net.get_points(nMin, nMax, sub_points);
+    for ( size_t k = nMin; k < nMax; k++ )
+    {
+      for ( size_t j = 0; j < dimension; j++ )
+      {
+        BOOST_CHECK_EQUAL(sub_points[k - nMin][j], points[k][j]);
+      }
+    }
+  }
+}
+
 } // end namespace TestDigitalNet
 
 } // end namespace TestLowDiscrepancy
@@ -0,0 +1,77 @@
+/*  _______________________________________________________________________
+
+    Dakota: Explore and predict with confidence.
+    Copyright 2014-2023
+    National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Dakota directory.
+    _______________________________________________________________________ */
+
+#include "opt_tpl_test.hpp"
+
+#define BOOST_TEST_MODULE dakota_ego_batch_selection_test
+#include <boost/test/included/unit_test.hpp>
+
+using namespace Dakota;
+
+namespace {
+
+/// batch EGO on 2-D Rosenbrock, evaluated asynchronously in batches of 4
+String ego_input(const String& batch_selection)
+{
+  return
+    "environment \n"
+    "method \n"
+    "  efficient_global \n"
+    "    seed = 123456 \n"
+    "    batch_size = 4 \n"
+    "      batch_selection " + batch_selection + " \n"
+    "  output silent \n"
+    "variables \n"
+    "  continuous_design = 2 \n"
+    "    lower_bounds -2.0 -2.0 \n"
+    "    upper_bounds  2.0  2.0 \n"
+    "interface \n"
+    "  direct \n"
+    "    analysis_drivers = 'generalized_rosenbrock' \n"
+    "  asynchronous evaluation_concurrency 4 \n"
+    "  deactivate restart_file \n"
+    "responses \n"
+    "  objective_functions = 1 \n"
+    "  no_gradients \n"
+    "  no_hessians \n";
+}
+
+/// the batch study converges to the Rosenbrock minimum at (1,1)
+void check_ego_batch(const String& batch_selection)
+{
+  std::shared_ptr<LibraryEnvironment> env(Opt_TPL_Test::create_env(
+    ego_input(batch_selection)));
+  env->execute();
+
+  const RealVector& best_x = env->variables_results().continuous_variables();
+  BOOST_REQUIRE_EQUAL(best_x.length(), 2);
+  for (int i=0; i<2; ++i)
+    BOOST_CHECK_SMALL(best_x[i] - 1., 0.25);
+  BOOST_CHECK_SMALL(env->response_results().function_value(0), 1.e-2);
+}
+
+}
+
+
+BOOST_AUTO_TEST_CASE(test_ego_batch_selection_kriging_believer)
+{
+  check_ego_batch("kriging_believer");
+}
+
+
+BOOST_AUTO_TEST_CASE(test_ego_batch_selection_constant_liar)
+{
+  check_ego_batch("constant_liar");
+}
+
+
+BOOST_AUTO_TEST_CASE(test_ego_batch_selection_local_penalization)
+{
+  check_ego_batch("local_penalization");
+}
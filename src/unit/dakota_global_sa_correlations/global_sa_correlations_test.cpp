@@ -0,0 +1,264 @@
+/*  _______________________________________________________________________
+
+    Dakota: Explore and predict with confidence.
+    Copyright 2014-2023
+    National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Dakota directory.
+    _______________________________________________________________________ */
+
+#include "SensAnalysisGlobal.hpp"
+#include "DakotaResponse.hpp"
+#include "dakota_linear_algebra.hpp"
+#include "WorkStealingThreadPool.hpp"
+
+#include <cmath>
+#include <limits>
+
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/normal_distribution.hpp>
+
+#define BOOST_TEST_MODULE dakota_global_sa_correlations_test
+#include <boost/test/included/unit_test.hpp>
+
+using namespace Dakota;
+
+namespace {
+
+/// samples of num_in correlated inputs (one sample per column), every
+/// third input rounded to a coarse grid so that ranks have ties
+RealMatrix input_samples(int num_in, int num_obs, unsigned int seed)
+{
+  boost::mt19937 rng(seed);
+  boost::random::normal_distribution<> normal(0., 1.);
+  RealMatrix samples(num_in, num_obs);
+  for (int j=0; j<num_obs; ++j)
+    for (int i=0; i<num_in; ++i) {
+      samples(i, j) = normal(rng);
+      if (i % 5 == 4)
+	samples(i, j) += 0.6 * samples(i-1, j);
+      if (i % 3 == 2)
+	samples(i, j) = std::floor(4. * samples(i, j)) / 4.;
+    }
+  return samples;
+}
+
+/// responses mixing the inputs linearly and nonlinearly, plus noise
+RealMatrix response_samples(const RealMatrix& inputs, int num_out,
+			    Real noise, unsigned int seed)
+{
+  boost::mt19937 rng(seed);
+  boost::random::normal_distribution<> normal(0., 1.);
+  int num_in = inputs.numRows(), num_obs = inputs.numCols();
+  RealMatrix coeffs(num_in, num_out);
+  for (int k=0; k<num_out; ++k)
+    for (int i=0; i<num_in; ++i)
+      coeffs(i, k) = normal(rng);
+  RealMatrix responses(num_out, num_obs);
+  for (int j=0; j<num_obs; ++j)
+    for (int k=0; k<num_out; ++k) {
+      Real f = noise * normal(rng);
+      for (int i=0; i<num_in; ++i)
+	f += coeffs(i, k) * inputs(i, j);
+      if (k % 2)
+	f += std::exp(0.5 * inputs(k % num_in, j));
+      responses(k, j) = f;
+    }
+  return responses;
+}
+
+IntResponseMap response_map(const RealMatrix& responses)
+{
+  int num_out = responses.numRows();
+  ActiveSet set(num_out, 0);
+  SharedResponseData srd(set);
+  IntResponseMap resp_samples;
+  for (int j=0; j<responses.numCols(); ++j) {
+    Response resp(srd);
+    for (int k=0; k<num_out; ++k)
+      resp.function_value_view(k) = responses(k, j);
+    resp_samples.insert(std::make_pair(j+1, resp));
+  }
+  return resp_samples;
+}
+
+/// inputs stacked over responses, one sample per column
+RealMatrix stacked_data(const RealMatrix& inputs, const RealMatrix& responses)
+{
+  int num_in = inputs.numRows(), num_out = responses.numRows();
+  RealMatrix data(num_in + num_out, inputs.numCols());
+  for (int j=0; j<inputs.numCols(); ++j) {
+    for (int i=0; i<num_in; ++i)
+      data(i, j) = inputs(i, j);
+    for (int k=0; k<num_out; ++k)
+      data(num_in + k, j) = responses(k, j);
+  }
+  return data;
+}
+
+/// ranks by ordered insertion, averaging over ties
+void reference_ranks(RealMatrix& data)
+{
+  for (int i=0; i<data.numRows(); ++i) {
+    RealIntMultiMap vals_inds;
+    for (int j=0; j<data.numCols(); ++j)
+      vals_inds.insert(std::make_pair(data(i, j), j));
+    int rank = 0;
+    for (RealIntMultiMap::const_iterator it = vals_inds.begin();
+	 it != vals_inds.end(); ) {
+      std::pair<RealIntMultiMap::const_iterator,
+		RealIntMultiMap::const_iterator> ties
+	= vals_inds.equal_range(it->first);
+      int num_ties = std::distance(ties.first, ties.second);
+      for ( ; ties.first != ties.second; ++ties.first)
+	data(i, ties.first->second) = (rank + rank + num_ties - 1) / 2.;
+      it = ties.second;
+      rank += num_ties;
+    }
+  }
+}
+
+/// all-to-all correlations of the rows of data by a single product
+RealMatrix reference_simple(RealMatrix data)
+{
+  int num_corr = data.numRows(), num_obs = data.numCols();
+  for (int i=0; i<num_corr; ++i) {
+    Real mean = 0., sumsq = 0.;
+    for (int j=0; j<num_obs; ++j)
+      mean += data(i, j);
+    mean /= num_obs;
+    for (int j=0; j<num_obs; ++j)
+      { data(i, j) -= mean; sumsq += data(i, j) * data(i, j); }
+    for (int j=0; j<num_obs; ++j)
+      data(i, j) /= std::sqrt(sumsq);
+  }
+  RealMatrix corr(num_corr, num_corr);
+  corr.multiply(Teuchos::NO_TRANS, Teuchos::TRANS, 1., data, data, 0.);
+  for (int i=0; i<num_corr; ++i)
+    corr(i, i) = 1.;
+  return corr;
+}
+
+/// partial correlations by regression of each input and the responses
+/// on the remaining inputs, one SVD per input
+RealMatrix reference_partial(RealMatrix data, int num_in)
+{
+  int num_obs = data.numCols(), num_out = data.numRows() - num_in;
+  for (int i=0; i<data.numRows(); ++i) {
+    Real mean = 0.;
+    for (int j=0; j<num_obs; ++j)
+      mean += data(i, j);
+    mean /= num_obs;
+    for (int j=0; j<num_obs; ++j)
+      data(i, j) -= mean;
+  }
+  RealMatrix partial(num_in, num_out);
+  for (int i=0; i<num_in; ++i) {
+    RealMatrix X(num_obs, 1 + num_out), Z(num_obs, num_in - 1);
+    for (int j=0; j<num_obs; ++j) {
+      X(j, 0) = data(i, j);
+      for (int k=0; k<num_out; ++k)
+	X(j, 1+k) = data(num_in + k, j);
+      for (int c=0, v=0; v<num_in; ++v)
+	if (v != i)
+	  Z(j, c++) = data(v, j);
+    }
+    RealMatrix cov(1 + num_out, 1 + num_out), Zt_X(num_in - 1, 1 + num_out);
+    cov.multiply(Teuchos::TRANS, Teuchos::NO_TRANS, 1., X, X, 0.);
+    Zt_X.multiply(Teuchos::TRANS, Teuchos::NO_TRANS, 1., Z, X, 0.);
+    RealVector sing_vals;  RealMatrix v_trans;
+    svd(Z, sing_vals, v_trans);
+    RealMatrix proj(num_in - 1, 1 + num_out);
+    proj.multiply(Teuchos::NO_TRANS, Teuchos::NO_TRANS, 1., v_trans, Zt_X, 0.);
+    for (int r=0; r<num_in - 1; ++r)
+      for (int k=0; k<1 + num_out; ++k)
+	proj(r, k) /= sing_vals[r];
+    cov.multiply(Teuchos::TRANS, Teuchos::NO_TRANS, -1., proj, proj, 1.);
+    for (int k=0; k<num_out; ++k)
+      partial(i, k) = cov(0, k+1) / std::sqrt(cov(0, 0) * cov(k+1, k+1));
+  }
+  return partial;
+}
+
+void check_close(const RealMatrix& computed, const RealMatrix& expected,
+		 Real tol)
+{
+  BOOST_REQUIRE_EQUAL(computed.numRows(), expected.numRows());
+  BOOST_REQUIRE_EQUAL(computed.numCols(), expected.numCols());
+  Real max_diff = 0.;
+  for (int j=0; j<computed.numCols(); ++j)
+    for (int i=0; i<computed.numRows(); ++i)
+      max_diff = std::max(max_diff, std::abs(computed(i, j) - expected(i, j)));
+  BOOST_CHECK_SMALL(max_diff, tol);
+}
+
+/// compare the four correlation matrices to the reference calculations
+void check_correlations(const RealMatrix& inputs, const RealMatrix& responses,
+			Real tol)
+{
+  int num_in = inputs.numRows();
+  SensAnalysisGlobal gsa;
+  gsa.compute_correlations(inputs, response_map(responses));
+  BOOST_REQUIRE(gsa.correlations_computed());
+
+  RealMatrix data = stacked_data(inputs, responses);
+  check_close(gsa.simple_correlations(), reference_simple(data), tol);
+  check_close(gsa.partial_correlations(), reference_partial(data, num_in), tol);
+  BOOST_CHECK(!gsa.partial_correlation_issues());
+  reference_ranks(data);
+  check_close(gsa.simple_correlations(true), reference_simple(data), tol);
+  check_close(gsa.partial_correlations(true), reference_partial(data, num_in), tol);
+  BOOST_CHECK(!gsa.partial_correlation_issues(true));
+}
+
+}
+
+
+/** Correlations small enough for single products and the factored
+    partial correlations match the per-input regressions */
+BOOST_AUTO_TEST_CASE(test_global_sa_correlations_small)
+{
+  RealMatrix inputs = input_samples(6, 200, 1);
+  check_correlations(inputs, response_samples(inputs, 3, 0.5, 2), 1.e-12);
+}
+
+
+/** Correlations computed by parallel tiles (more factors than a tile,
+    more observations than an observation block) match a single product */
+BOOST_AUTO_TEST_CASE(test_global_sa_correlations_blocked)
+{
+  RealMatrix inputs = input_samples(40, 1500, 3);
+  RealMatrix responses = response_samples(inputs, 260, 2., 4);
+  check_correlations(inputs, responses, 1.e-10);
+  // tiles computed on several kernel threads
+  dakota::util::WorkStealingThreadPool::kernel_concurrency(4);
+  check_correlations(inputs, responses, 1.e-10);
+  dakota::util::WorkStealingThreadPool::kernel_concurrency(1);
+}
+
+
+/** Fewer samples than inputs, and a response exactly linear in the
+    inputs, fall back to the per-input regressions */
+BOOST_AUTO_TEST_CASE(test_global_sa_correlations_fallback)
+{
+  RealMatrix inputs = input_samples(12, 10, 5);
+  RealMatrix responses = response_samples(inputs, 2, 0.1, 6);
+  SensAnalysisGlobal gsa;
+  gsa.compute_correlations(inputs, response_map(responses));
+  RealMatrix data = stacked_data(inputs, responses);
+  check_close(gsa.simple_correlations(), reference_simple(data), 1.e-12);
+  BOOST_CHECK_EQUAL(gsa.partial_correlations().numRows(), 12);
+  BOOST_CHECK_EQUAL(gsa.partial_correlations().numCols(), 2);
+
+  inputs = input_samples(5, 100, 7);
+  responses.shape(1, 100);
+  for (int j=0; j<100; ++j)
+    for (int i=0; i<5; ++i)
+      responses(0, j) += (i + 1.) * inputs(i, j);
+  gsa.compute_correlations(inputs, response_map(responses));
+  // controlling for the other inputs, the response is proportional to
+  // each input (with a positive coefficient)
+  BOOST_CHECK(!gsa.partial_correlation_issues());
+  for (int i=0; i<5; ++i)
+    BOOST_CHECK_SMALL(gsa.partial_correlations()(i, 0) - 1., 1.e-8);
+}
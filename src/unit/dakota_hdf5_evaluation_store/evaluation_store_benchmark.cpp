@@ -0,0 +1,87 @@
+/*  _______________________________________________________________________
+
+    Dakota: Explore and predict with confidence.
+    Copyright 2014-2023
+    National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Dakota directory.
+    _______________________________________________________________________ */
+
+
+#ifdef DAKOTA_HAVE_HDF5
+
+#include "opt_tpl_test.hpp"
+
+#include <chrono>
+#include <iostream>
+
+#define BOOST_TEST_MODULE dakota_hdf5_evaluation_store_benchmark
+#include <boost/test/included/unit_test.hpp>
+
+using namespace Dakota;
+
+namespace {
+
+const int NUM_SAMPLES = 5000;
+const int NUM_VARS = 10;
+
+/// sampling study on the generalized Rosenbrock direct driver; hdf5_opts
+/// is empty to disable results output, else it follows the hdf5 keyword
+String sampling_input(const String& file_base, const String& hdf5_opts)
+{
+  String input = "environment \n";
+  if (!hdf5_opts.empty())
+    input += "  results_output \n"
+      "    results_output_file '" + file_base + "' \n"
+      "    hdf5 " + hdf5_opts + " \n";
+  input +=
+    "method \n"
+    "  sampling \n"
+    "    samples " + std::to_string(NUM_SAMPLES) + " \n"
+    "    seed 1234 \n"
+    "    output silent \n"
+    "variables \n"
+    "  uniform_uncertain " + std::to_string(NUM_VARS) + " \n"
+    "    lower_bounds " + std::to_string(NUM_VARS) + "*-2.0 \n"
+    "    upper_bounds " + std::to_string(NUM_VARS) + "*2.0 \n"
+    "interface \n"
+    "  direct \n"
+    "    analysis_drivers = 'generalized_rosenbrock' \n"
+    "responses \n"
+    "  response_functions = 1 \n"
+    "  no_gradients \n"
+    "  no_hessians \n";
+  return input;
+}
+
+/// execute the study and return its evaluation rate
+double run_study(const String& input)
+{
+  typedef std::chrono::steady_clock clock;
+  typedef std::chrono::duration<double> seconds;
+  std::shared_ptr<LibraryEnvironment> env(Opt_TPL_Test::create_env(input));
+  clock::time_point t0 = clock::now();
+  env->execute();
+  clock::time_point t1 = clock::now();
+  return NUM_SAMPLES / seconds(t1 - t0).count();
+}
+
+}
+
+
+/** Evaluation throughput without results output and with buffered and
+    write-through HDF5 evaluation storage */
+BOOST_AUTO_TEST_CASE(test_hdf5_evaluation_store_throughput)
+{
+  double rate_none = run_study(sampling_input("", ""));
+  double rate_buffered
+    = run_study(sampling_input("evals_buffered", "compression_level 1"));
+  double rate_unbuffered
+    = run_study(sampling_input("evals_unbuffered", "buffer_size 1"));
+
+  std::cout << "evals/s without results output: " << rate_none
+	    << ", buffered hdf5: " << rate_buffered
+	    << ", write-through hdf5: " << rate_unbuffered << std::endl;
+}
+
+#endif
@@ -0,0 +1,105 @@
+/*  _______________________________________________________________________
+
+    Dakota: Explore and predict with confidence.
+    Copyright 2014-2023
+    National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Dakota directory.
+    _______________________________________________________________________ */
+
+
+#ifdef DAKOTA_HAVE_HDF5
+
+#include "HDF5_IO.hpp"
+#include "opt_tpl_test.hpp"
+
+#include <cmath>
+
+#define BOOST_TEST_MODULE dakota_hdf5_evaluation_store
+#include <boost/test/included/unit_test.hpp>
+
+using namespace Dakota;
+
+namespace {
+
+const int NUM_SAMPLES = 500;
+const int NUM_VARS = 10;
+
+/// sampling study on the generalized Rosenbrock direct driver; hdf5_opts
+/// is empty to disable results output, else it follows the hdf5 keyword
+String sampling_input(const String& file_base, const String& hdf5_opts)
+{
+  String input = "environment \n";
+  if (!hdf5_opts.empty())
+    input += "  results_output \n"
+      "    results_output_file '" + file_base + "' \n"
+      "    hdf5 " + hdf5_opts + " \n";
+  input +=
+    "method \n"
+    "  sampling \n"
+    "    samples " + std::to_string(NUM_SAMPLES) + " \n"
+    "    seed 1234 \n"
+    "    output silent \n"
+    "variables \n"
+    "  uniform_uncertain " + std::to_string(NUM_VARS) + " \n"
+    "    lower_bounds " + std::to_string(NUM_VARS) + "*-2.0 \n"
+    "    upper_bounds " + std::to_string(NUM_VARS) + "*2.0 \n"
+    "interface \n"
+    "  direct \n"
+    "    analysis_drivers = 'generalized_rosenbrock' \n"
+    "responses \n"
+    "  response_functions = 1 \n"
+    "  no_gradients \n"
+    "  no_hessians \n";
+  return input;
+}
+
+/// execute the study
+void run_study(const String& input)
+{
+  std::shared_ptr<LibraryEnvironment> env(Opt_TPL_Test::create_env(input));
+  env->execute();
+}
+
+}
+
+
+/** Buffered (several full buffers and a partial one) and write-through
+    (buffer_size 1) evaluation storage produce the same datasets */
+BOOST_AUTO_TEST_CASE(test_hdf5_evaluation_store_buffering)
+{
+  run_study(sampling_input("evals_buffered",
+			   "buffer_size 64 compression_level 1"));
+  run_study(sampling_input("evals_unbuffered", "buffer_size 1"));
+
+  const std::string evals("/interfaces/NO_ID/NO_MODEL_ID/"),
+    ids("/_scales/interfaces/NO_ID/NO_MODEL_ID/evaluation_ids");
+  HDF5IOHelper buffered("evals_buffered.h5"),
+    unbuffered("evals_unbuffered.h5");
+
+  IntVector buffered_ids, unbuffered_ids;
+  buffered.read_vector(ids, buffered_ids);
+  unbuffered.read_vector(ids, unbuffered_ids);
+  BOOST_REQUIRE_EQUAL(buffered_ids.length(), NUM_SAMPLES);
+  BOOST_REQUIRE_EQUAL(unbuffered_ids.length(), NUM_SAMPLES);
+  for (int i=0; i<NUM_SAMPLES; ++i) {
+    BOOST_CHECK_EQUAL(buffered_ids[i], i+1);
+    BOOST_CHECK_EQUAL(unbuffered_ids[i], i+1);
+  }
+
+  RealMatrix buffered_vars, unbuffered_vars, buffered_fns, unbuffered_fns;
+  buffered.read_matrix(evals + "variables/continuous", buffered_vars);
+  unbuffered.read_matrix(evals + "variables/continuous", unbuffered_vars);
+  buffered.read_matrix(evals + "responses/functions", buffered_fns);
+  unbuffered.read_matrix(evals + "responses/functions", unbuffered_fns);
+  BOOST_REQUIRE_EQUAL(buffered_vars.numRows(), NUM_SAMPLES);
+  BOOST_REQUIRE_EQUAL(buffered_vars.numCols(), NUM_VARS);
+  BOOST_REQUIRE_EQUAL(buffered_fns.numRows(), NUM_SAMPLES);
+  BOOST_REQUIRE_EQUAL(buffered_fns.numCols(), 1);
+  BOOST_CHECK(buffered_vars == unbuffered_vars);
+  BOOST_CHECK(buffered_fns == unbuffered_fns);
+  for (int i=0; i<NUM_SAMPLES; ++i)
+    BOOST_CHECK(std::isfinite(buffered_fns(i,0)));
+}
+
+#endif
@@ -427,6 +427,47 @@ BOOST_AUTO_TEST_CASE(test_hdf5_cpp_matrix_append)
    
 }
 
+BOOST_AUTO_TEST_CASE(test_hdf5_cpp_layers_append)
+{
+  const std::string file_name("hdf5_layers_append.h5");
+  const std::string ds_name("/unlimited_layers");
+  const int num_layers = 10;
+
+  // ****  Append matrices in blocks of 4 layers  ****
+  RealMatrix rmat(num_layers, MAT_ROWS*MAT_COLS);
+  rmat.random();
+  // row-major layers
+  std::vector<Real> layers(num_layers*MAT_ROWS*MAT_COLS);
+  for(int l = 0; l < num_layers; ++l)
+    for(int k = 0; k < MAT_ROWS*MAT_COLS; ++k)
+      layers[l*MAT_ROWS*MAT_COLS + k] = rmat(l, k);
+
+  // Write data in chunks of 4 layers, compressed
+  {
+    HDF5IOHelper h5_io(file_name, /* overwrite */ true);
+    std::vector<int> dims = {0, MAT_ROWS, MAT_COLS};
+    h5_io.create_empty_dataset(ds_name, dims, Dakota::ResultsOutputType::REAL,
+                               0, NULL, 4 /* chunk_rows */, 6 /* deflate */);
+    for(int l = 0; l < num_layers; l += 4)
+      h5_io.append_layers(ds_name, &layers[l*MAT_ROWS*MAT_COLS],
+                          std::min(4, num_layers - l));
+  }
+
+  // Read data
+  for(int l = 0; l < num_layers; ++l) {
+    RealMatrix test_mat;
+    {
+      HDF5IOHelper h5_io(file_name);
+      h5_io.get_matrix(ds_name, test_mat, l);
+    }
+    BOOST_REQUIRE(test_mat.numRows() == MAT_ROWS);
+    BOOST_REQUIRE(test_mat.numCols() == MAT_COLS);
+    for(int i = 0; i < MAT_ROWS; ++i)
+      for(int j = 0; j < MAT_COLS; ++j)
+        BOOST_CHECK( test_mat(i,j) == rmat(l, i*MAT_COLS + j) );
+  }
+}
+
 BOOST_AUTO_TEST_CASE(test_hdf5_cpp_file_modes)
 {
   const std::string file_name("hdf5_file_modes.h5");
@@ -0,0 +1,84 @@
+/*  _______________________________________________________________________
+
+    Dakota: Explore and predict with confidence.
+    Copyright 2014-2023
+    National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Dakota directory.
+    _______________________________________________________________________ */
+
+#include "ProcessLauncher.hpp"
+
+#include <chrono>
+#include <iostream>
+#include <vector>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#define BOOST_TEST_MODULE dakota_process_launcher_benchmark
+#include <boost/test/included/unit_test.hpp>
+
+using namespace Dakota;
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+typedef std::chrono::duration<double> Seconds;
+
+/// mean seconds per launch-and-wait of the program "true" over
+/// num_launches, with fork or vfork and execvp as in ForkApplicInterface
+double fork_latency(size_t num_launches, bool use_vfork)
+{
+  const char* argv[] = { "true", NULL };
+  Clock::time_point t0 = Clock::now();
+  for (size_t i=0; i<num_launches; ++i) {
+    pid_t pid = (use_vfork) ? vfork() : fork();
+    if (pid == 0) {
+      execvp(argv[0], (char* const*)argv);
+      _exit(-1);
+    }
+    int status = -1;
+    waitpid(pid, &status, 0);
+    BOOST_REQUIRE(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+  }
+  return Seconds(Clock::now() - t0).count() / num_launches;
+}
+
+/// mean seconds per launch-and-wait of "true" through the launcher
+double launcher_latency(ProcessLauncher& launcher, size_t num_launches)
+{
+  StringArray argv(1, "true");
+  Clock::time_point t0 = Clock::now();
+  for (size_t i=0; i<num_launches; ++i) {
+    pid_t pid = launcher.launch(argv);
+    BOOST_REQUIRE(pid > 0);
+    int status = launcher.wait(pid);
+    BOOST_REQUIRE(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+  }
+  return Seconds(Clock::now() - t0).count() / num_launches;
+}
+
+}
+
+
+/** Launch latency of a trivial program from a process with a large
+    resident footprint: fork and vfork as used by ForkApplicInterface
+    versus the launcher started while the process was small. */
+BOOST_AUTO_TEST_CASE(test_process_launcher_latency)
+{
+  ProcessLauncher launcher;
+  BOOST_REQUIRE(launcher.start());
+
+  const size_t num_launches = 200, ballast_bytes = size_t(512) << 20;
+  std::vector<char> ballast(ballast_bytes);
+  for (size_t i=0; i<ballast_bytes; i+=4096)
+    ballast[i] = 1; // touch every page
+
+  double fork_time = fork_latency(num_launches, false),
+    vfork_time = fork_latency(num_launches, true),
+    launcher_time = launcher_latency(launcher, num_launches);
+  std::cout << "launch and wait of 'true' with " << (ballast_bytes >> 20)
+    << " MB resident: fork " << 1.e6 * fork_time << " us, vfork "
+    << 1.e6 * vfork_time << " us, launcher " << 1.e6 * launcher_time
+    << " us" << std::endl;
+}
@@ -0,0 +1,198 @@
+/*  _______________________________________________________________________
+
+    Dakota: Explore and predict with confidence.
+    Copyright 2014-2023
+    National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Dakota directory.
+    _______________________________________________________________________ */
+
+#include "ProcessLauncher.hpp"
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#define BOOST_TEST_MODULE dakota_process_launcher_test
+#include <boost/test/included/unit_test.hpp>
+
+using namespace Dakota;
+
+namespace {
+
+/// command line running script in the shell
+StringArray shell_command(const String& script)
+{
+  StringArray argv(3);
+  argv[0] = "sh";  argv[1] = "-c";  argv[2] = script;
+  return argv;
+}
+
+/// contents of a file, whitespace separated tokens joined by spaces
+String file_tokens(const String& file_name)
+{
+  std::ifstream file(file_name.c_str());
+  String token, tokens;
+  while (file >> token)
+    tokens += (tokens.empty()) ? token : ' ' + token;
+  return tokens;
+}
+
+/// temporary directory that is the working directory while in scope
+struct ScratchDirectory
+{
+  ScratchDirectory()
+  {
+    char templ[] = "/tmp/dakota_launcher_XXXXXX";
+    BOOST_REQUIRE(mkdtemp(templ));
+    path = templ;
+    BOOST_REQUIRE(getcwd(startDir, sizeof(startDir)));
+    BOOST_REQUIRE_EQUAL(chdir(path.c_str()), 0);
+  }
+
+  ~ScratchDirectory()
+  {
+    int rc = chdir(startDir);
+    (void)rc;
+    rc = std::system(("rm -rf " + path).c_str());
+  }
+
+  String path;
+  char startDir[4096];
+};
+
+}
+
+
+/** Exit statuses and signals are reported as waitpid() reports them and
+    a missing program fails the launch */
+BOOST_AUTO_TEST_CASE(test_process_launcher_status)
+{
+  ProcessLauncher launcher;
+  BOOST_REQUIRE(launcher.start());
+  BOOST_CHECK(launcher.active());
+
+  int status = launcher.wait(launcher.launch(shell_command("exit 3")));
+  BOOST_CHECK(WIFEXITED(status) && WEXITSTATUS(status) == 3);
+  status = launcher.wait(launcher.launch(StringArray(1, "true")));
+  BOOST_CHECK(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+  status = launcher.wait(launcher.launch(shell_command("kill -9 $$")));
+  BOOST_CHECK(WIFSIGNALED(status) && WTERMSIG(status) == 9);
+
+  BOOST_CHECK_EQUAL(launcher.launch(StringArray(1, "no_such_dakota_driver")),
+		    -1);
+  BOOST_CHECK_EQUAL(errno, ENOENT);
+
+  launcher.stop();
+  BOOST_CHECK(!launcher.active());
+}
+
+
+/** Programs start from the caller's working directory with its
+    environment, including PATH changes made after the launcher started */
+BOOST_AUTO_TEST_CASE(test_process_launcher_environment)
+{
+  ProcessLauncher launcher;
+  BOOST_REQUIRE(launcher.start());
+  ScratchDirectory scratch;
+
+  {
+    std::ofstream probe("launcher_probe");
+    probe << "#!/bin/sh\necho \"$DAKOTA_LAUNCHER_TEST\" > env.out\n"
+	  << "pwd > pwd.out\n";
+  }
+  BOOST_REQUIRE_EQUAL(chmod("launcher_probe", 0755), 0);
+  String path = std::getenv("PATH") ? std::getenv("PATH") : "";
+  setenv("PATH", (scratch.path + ':' + path).c_str(), 1);
+  setenv("DAKOTA_LAUNCHER_TEST", "launched", 1);
+
+  int status = launcher.wait(launcher.launch(StringArray(1, "launcher_probe")));
+  BOOST_CHECK(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+  BOOST_CHECK_EQUAL(file_tokens("env.out"), "launched");
+  char cwd[4096];
+  BOOST_REQUIRE(getcwd(cwd, sizeof(cwd)));
+  BOOST_CHECK_EQUAL(file_tokens("pwd.out"), String(cwd));
+
+  setenv("PATH", path.c_str(), 1);
+  unsetenv("DAKOTA_LAUNCHER_TEST");
+}
+
+
+/** A sequence runs in order through nonzero statuses and ends at the
+    first status of -1, which is its own status */
+BOOST_AUTO_TEST_CASE(test_process_launcher_sequence)
+{
+  ProcessLauncher launcher;
+  BOOST_REQUIRE(launcher.start());
+  ScratchDirectory scratch;
+
+  std::vector<StringArray> commands;
+  commands.push_back(shell_command("echo 1 >> seq.out"));
+  commands.push_back(shell_command("echo 2 >> seq.out; exit 5"));
+  commands.push_back(shell_command("echo 3 >> seq.out"));
+  int status = launcher.wait(launcher.launch(commands));
+  BOOST_CHECK(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+  BOOST_CHECK_EQUAL(file_tokens("seq.out"), "1 2 3");
+
+  commands[0] = shell_command("echo 1 >> fail.out");
+  commands[1] = shell_command("echo 2 >> fail.out; exit 255");
+  commands[2] = shell_command("echo 3 >> fail.out");
+  status = launcher.wait(launcher.launch(commands));
+  BOOST_CHECK(WIFEXITED(status) && (signed char)WEXITSTATUS(status) == -1);
+  BOOST_CHECK_EQUAL(file_tokens("fail.out"), "1 2");
+}
+
+
+/** Nonblocking launches run concurrently: every job starts before any
+    is allowed to finish; completions are tested without blocking and
+    collected in any order */
+BOOST_AUTO_TEST_CASE(test_process_launcher_concurrent)
+{
+  ScratchDirectory scratch;
+  ProcessLauncher launcher;
+  BOOST_REQUIRE(launcher.start());
+
+  const int num_jobs = 4;
+  std::map<pid_t, int> process_id_map;
+  for (int i=0; i<num_jobs; ++i) {
+    std::ostringstream script;
+    script << "touch started." << i
+	   << "; while [ ! -e release ]; do sleep 0.01; done";
+    process_id_map[launcher.launch(shell_command(script.str()))] = i;
+  }
+  pid_t quick = launcher.launch(StringArray(1, "true"));
+  int status;
+  BOOST_CHECK_EQUAL(launcher.wait(process_id_map, false, status), 0);
+
+  // serial launches would never start the second job; the limit only
+  // bounds the test should they not
+  int num_started = 0;
+  for (int tries=0; tries<6000 && num_started<num_jobs; ++tries) {
+    num_started = 0;
+    for (int i=0; i<num_jobs; ++i) {
+      struct stat buf;
+      if (stat(("started." + std::to_string(i)).c_str(), &buf) == 0)
+	++num_started;
+    }
+    if (num_started < num_jobs)
+      usleep(10000);
+  }
+  BOOST_CHECK_EQUAL(num_started, num_jobs);
+  BOOST_CHECK_EQUAL(launcher.wait(process_id_map, false, status), 0);
+  std::ofstream("release").close();
+
+  // the quick completion is retained while waiting on the others
+  while (!process_id_map.empty()) {
+    pid_t pid = launcher.wait(process_id_map, true, status);
+    BOOST_REQUIRE(process_id_map.count(pid));
+    BOOST_CHECK(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+    process_id_map.erase(pid);
+  }
+  status = launcher.wait(quick);
+  BOOST_CHECK(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+}
@@ -0,0 +1,109 @@
+/*  _______________________________________________________________________
+
+    Dakota: Explore and predict with confidence.
+    Copyright 2014-2023
+    National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Dakota directory.
+    _______________________________________________________________________ */
+
+#include "PRPMultiIndex.hpp"
+#include "PRPShardedCache.hpp"
+#include "SimulationResponse.hpp"
+
+#include <chrono>
+#include <iostream>
+
+#define BOOST_TEST_MODULE dakota_prp_cache_benchmark
+#include <boost/test/included/unit_test.hpp>
+
+using namespace Dakota;
+
+namespace {
+
+/// generate num_evals PRPs over num_vars continuous variables with
+/// values and gradients active
+PRPArray generate_prps(const int num_evals, const size_t num_vars,
+		       const String& iface_id, const int first_id = 1)
+{
+  SizetArray vc_totals(NUM_VC_TOTALS);
+  vc_totals[0] = num_vars;
+  std::pair<short, short> view(MIXED_ALL, EMPTY_VIEW);
+  SharedVariablesData svd(view, vc_totals);
+  Variables vars(svd);
+
+  ActiveSet as(1, num_vars);
+  as.request_values(3);
+  Response resp(SIMULATION_RESPONSE, as);
+
+  PRPArray prps;
+  for (int i=0; i<num_evals; ++i) {
+    for (size_t j=0; j<num_vars; ++j)
+      vars.continuous_variable(1.e-3 * (Real)i + (Real)j, j);
+    resp.function_value((Real)i, 0);
+    // deep copy of vars/resp, as for cache/restart records
+    prps.push_back(ParamResponsePair(vars, iface_id, resp, first_id + i));
+  }
+  return prps;
+}
+
+ActiveSet value_set(size_t num_vars)
+{
+  ActiveSet as(1, num_vars);
+  as.request_values(1);
+  return as;
+}
+
+}
+
+
+/** Insert/lookup throughput and index memory per entry for PRPCache
+    and PRPShardedCache (timings reported, not checked) */
+BOOST_AUTO_TEST_CASE(test_prp_cache_throughput)
+{
+  typedef std::chrono::steady_clock clock;
+  const size_t num_vars = 10;
+  const int num_evals = 20000;
+  PRPArray prps = generate_prps(num_evals, num_vars, "IFACE");
+  ActiveSet set = value_set(num_vars);
+
+  PRPCache multi_index;
+  clock::time_point t0 = clock::now();
+  for (int i=0; i<num_evals; ++i)
+    multi_index.insert(prps[i]);
+  clock::time_point t1 = clock::now();
+  size_t mi_hits = 0;
+  for (int i=0; i<num_evals; ++i)
+    if (lookup_by_val(multi_index, "IFACE", prps[i].variables(), set) !=
+	multi_index.get<hashed>().end())
+      ++mi_hits;
+  clock::time_point t2 = clock::now();
+
+  PRPShardedCache sharded;
+  ParamResponsePair found;
+  clock::time_point t3 = clock::now();
+  for (int i=0; i<num_evals; ++i)
+    sharded.insert(prps[i]);
+  clock::time_point t4 = clock::now();
+  size_t sh_hits = 0;
+  for (int i=0; i<num_evals; ++i)
+    if (sharded.lookup_by_val("IFACE", prps[i].variables(), set, found))
+      ++sh_hits;
+  clock::time_point t5 = clock::now();
+
+  BOOST_CHECK_EQUAL(mi_hits, num_evals);
+  BOOST_CHECK_EQUAL(sh_hits, num_evals);
+
+  typedef std::chrono::duration<double> seconds;
+  // multi_index node: PRP plus ordered (3 pointers + color) and hashed
+  // (1 pointer) index links, plus one bucket pointer per entry
+  size_t mi_bytes_per = sizeof(ParamResponsePair) + 5*sizeof(void*);
+  std::cout << "PRPCache insert/s: "
+    << num_evals / seconds(t1 - t0).count() << ", lookup/s: "
+    << num_evals / seconds(t2 - t1).count() << ", index bytes/entry: ~"
+    << mi_bytes_per << std::endl;
+  std::cout << "PRPShardedCache insert/s: "
+    << num_evals / seconds(t4 - t3).count() << ", lookup/s: "
+    << num_evals / seconds(t5 - t4).count() << ", index bytes/entry: ~"
+    << sharded.index_bytes() / num_evals << std::endl;
+}
@@ -0,0 +1,298 @@
+/*  _______________________________________________________________________
+
+    Dakota: Explore and predict with confidence.
+    Copyright 2014-2023
+    National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Dakota directory.
+    _______________________________________________________________________ */
+
+#include "PRPMultiIndex.hpp"
+#include "PRPShardedCache.hpp"
+#include "SimulationResponse.hpp"
+
+#include <sstream>
+#include <thread>
+
+#define BOOST_TEST_MODULE dakota_prp_cache_test
+#include <boost/test/included/unit_test.hpp>
+
+using namespace Dakota;
+
+namespace Dakota {
+extern PRPCache data_pairs;
+extern PRPShardedCache sharded_data_pairs;
+}
+
+namespace {
+
+/// generate num_evals PRPs over num_vars continuous variables with
+/// values and gradients active
+PRPArray generate_prps(const int num_evals, const size_t num_vars,
+		       const String& iface_id, const int first_id = 1)
+{
+  SizetArray vc_totals(NUM_VC_TOTALS);
+  vc_totals[0] = num_vars;
+  std::pair<short, short> view(MIXED_ALL, EMPTY_VIEW);
+  SharedVariablesData svd(view, vc_totals);
+  Variables vars(svd);
+
+  ActiveSet as(1, num_vars);
+  as.request_values(3);
+  Response resp(SIMULATION_RESPONSE, as);
+
+  PRPArray prps;
+  for (int i=0; i<num_evals; ++i) {
+    for (size_t j=0; j<num_vars; ++j)
+      vars.continuous_variable(1.e-3 * (Real)i + (Real)j, j);
+    resp.function_value((Real)i, 0);
+    // deep copy of vars/resp, as for cache/restart records
+    prps.push_back(ParamResponsePair(vars, iface_id, resp, first_id + i));
+  }
+  return prps;
+}
+
+ActiveSet value_set(size_t num_vars)
+{
+  ActiveSet as(1, num_vars);
+  as.request_values(1);
+  return as;
+}
+
+}
+
+
+/** Lookup semantics (exact id/vars, ActiveSet subset) match PRPCache */
+BOOST_AUTO_TEST_CASE(test_prp_cache_lookup_equivalence)
+{
+  const size_t num_vars = 4;
+  PRPArray prps = generate_prps(100, num_vars, "IFACE");
+
+  PRPCache multi_index;
+  PRPShardedCache sharded(8);
+  for (size_t i=0; i<prps.size(); ++i)
+    { multi_index.insert(prps[i]); sharded.insert(prps[i]); }
+  BOOST_CHECK_EQUAL(sharded.size(), multi_index.size());
+  BOOST_CHECK_EQUAL(sharded.num_shards(), 8);
+
+  ParamResponsePair found;
+  ActiveSet sub_set = value_set(num_vars), full_set = prps[0].active_set();
+  ActiveSet super_set(full_set); super_set.request_values(7);
+  for (size_t i=0; i<prps.size(); ++i) {
+    const Variables& vars = prps[i].variables();
+    // subset and equal ASV are hits, superset is a miss
+    BOOST_CHECK(sharded.lookup_by_val("IFACE", vars, sub_set, found));
+    BOOST_CHECK_EQUAL(found.eval_id(), prps[i].eval_id());
+    BOOST_CHECK(sharded.lookup_by_val("IFACE", vars, full_set, found));
+    BOOST_CHECK(!sharded.lookup_by_val("IFACE", vars, super_set, found));
+    BOOST_CHECK(lookup_by_val(multi_index, "IFACE", vars, super_set) ==
+		multi_index.get<hashed>().end());
+    // a different interface never matches
+    BOOST_CHECK(!sharded.lookup_by_val("OTHER", vars, sub_set, found));
+  }
+
+  // shallow copies share the cached representations
+  BOOST_CHECK(sharded.lookup_by_val("IFACE", prps[7].variables(), sub_set,
+				    found));
+  BOOST_CHECK(found == prps[7]);
+}
+
+
+/** Restart ids are promoted in place */
+BOOST_AUTO_TEST_CASE(test_prp_cache_promotion)
+{
+  const size_t num_vars = 2;
+  PRPArray prps = generate_prps(10, num_vars, "IFACE", -10);
+  PRPShardedCache sharded(1);
+  for (size_t i=0; i<prps.size(); ++i)
+    sharded.insert(prps[i]);
+
+  ParamResponsePair found;
+  ActiveSet set = value_set(num_vars);
+  BOOST_CHECK(sharded.lookup_and_promote("IFACE", prps[3].variables(), set,
+					 42, found));
+  BOOST_CHECK_EQUAL(found.eval_id(), 42);
+  // positive ids are not promoted again
+  BOOST_CHECK(sharded.lookup_and_promote("IFACE", prps[3].variables(), set,
+					 43, found));
+  BOOST_CHECK_EQUAL(found.eval_id(), 42);
+  BOOST_CHECK_EQUAL(sharded.size(), 10);
+
+  sharded.clear();
+  BOOST_CHECK(sharded.empty());
+  sharded.num_shards(5); // permitted when empty; rounds up to power of 2
+  BOOST_CHECK_EQUAL(sharded.num_shards(), 8);
+}
+
+
+/** A miss satisfied by a restart record outside the cache is a hit */
+BOOST_AUTO_TEST_CASE(test_prp_cache_restart_hits)
+{
+  const size_t num_vars = 2;
+  PRPArray prps = generate_prps(2, num_vars, "IFACE", -2);
+  PRPShardedCache sharded(1);
+
+  ParamResponsePair found;
+  ActiveSet set = value_set(num_vars);
+  BOOST_CHECK(!sharded.lookup_and_promote("IFACE", prps[0].variables(), set,
+					  1, found));
+  BOOST_CHECK_EQUAL(sharded.misses(), 1);
+  // as in duplicate detection: found among restart records, then migrated
+  sharded.count_restart_hit();
+  prps[0].eval_id(1);
+  sharded.insert(prps[0]);
+  BOOST_CHECK_EQUAL(sharded.misses(), 0);
+  BOOST_CHECK_EQUAL(sharded.restart_hits(), 1);
+
+  BOOST_CHECK(sharded.lookup_by_val("IFACE", prps[0].variables(), set, found));
+  BOOST_CHECK(!sharded.lookup_by_val("IFACE", prps[1].variables(), set, found));
+  std::ostringstream stats;
+  sharded.print_statistics(stats);
+  BOOST_CHECK(stats.str().find("3 lookups: 1 hits, 0 spill hits, "
+			       "1 restart hits, 1 misses") != std::string::npos);
+}
+
+
+/** Concurrent inserts and lookups from several threads */
+BOOST_AUTO_TEST_CASE(test_prp_cache_concurrent)
+{
+  const size_t num_vars = 3, num_threads = 4;
+  const int evals_per_thread = 500;
+  std::vector<PRPArray> thread_prps(num_threads);
+  for (size_t t=0; t<num_threads; ++t)
+    thread_prps[t] = generate_prps(evals_per_thread, num_vars,
+				   "IFACE_" + std::to_string(t));
+
+  PRPShardedCache sharded;
+  std::vector<int> thread_hits(num_threads, 0);
+  std::vector<std::thread> threads;
+  for (size_t t=0; t<num_threads; ++t)
+    threads.push_back(std::thread([&, t]() {
+      ActiveSet set = value_set(num_vars);
+      ParamResponsePair found;
+      const PRPArray& prps = thread_prps[t];
+      for (size_t i=0; i<prps.size(); ++i) {
+	sharded.insert(prps[i]);
+	if (sharded.lookup_by_val(prps[i].interface_id(), prps[i].variables(),
+				  set, found))
+	  ++thread_hits[t];
+      }
+    }));
+  for (size_t t=0; t<num_threads; ++t)
+    threads[t].join();
+
+  BOOST_CHECK_EQUAL(sharded.size(), num_threads * evals_per_thread);
+  for (size_t t=0; t<num_threads; ++t)
+    BOOST_CHECK_EQUAL(thread_hits[t], evals_per_thread);
+}
+
+
+/** Bounded cache evicts least recently used records and counts them */
+BOOST_AUTO_TEST_CASE(test_prp_cache_lru_eviction)
+{
+  const size_t num_vars = 2;
+  PRPArray prps = generate_prps(10, num_vars, "IFACE");
+  PRPShardedCache sharded(1);
+  sharded.capacity(4, 0);
+
+  ParamResponsePair found;
+  ActiveSet set = value_set(num_vars);
+  for (size_t i=0; i<4; ++i)
+    sharded.insert(prps[i]);
+  // touch the oldest record so that the second is evicted next
+  BOOST_CHECK(sharded.lookup_by_val("IFACE", prps[0].variables(), set, found));
+  sharded.insert(prps[4]);
+
+  BOOST_CHECK_EQUAL(sharded.size(), 4);
+  BOOST_CHECK_EQUAL(sharded.evictions(), 1);
+  BOOST_CHECK(sharded.lookup_by_val("IFACE", prps[0].variables(), set, found));
+  BOOST_CHECK(!sharded.lookup_by_val("IFACE", prps[1].variables(), set, found));
+  BOOST_CHECK_EQUAL(sharded.hits(), 2);
+  BOOST_CHECK_EQUAL(sharded.misses(), 1);
+
+  // a byte budget admits roughly that many records
+  sharded.clear();
+  size_t rec_bytes = PRPShardedCache::payload_bytes(prps[0]);
+  sharded.capacity(0, 3 * rec_bytes);
+  for (size_t i=0; i<prps.size(); ++i)
+    sharded.insert(prps[i]);
+  BOOST_CHECK_EQUAL(sharded.size(), 3);
+  BOOST_CHECK(sharded.resident_bytes() <= 3 * rec_bytes);
+  BOOST_CHECK_EQUAL(sharded.evictions(), prps.size() - 3);
+}
+
+
+/** Evicted records are spilled to file and reloaded on a hit */
+BOOST_AUTO_TEST_CASE(test_prp_cache_spill)
+{
+  const size_t num_vars = 3;
+  PRPArray prps = generate_prps(50, num_vars, "IFACE");
+  PRPShardedCache sharded(2);
+  sharded.capacity(8, 0, "prp_cache_test.spill");
+  for (size_t i=0; i<prps.size(); ++i)
+    sharded.insert(prps[i]);
+  BOOST_CHECK_EQUAL(sharded.size() + sharded.spilled(), prps.size());
+
+  ParamResponsePair found;
+  ActiveSet set = value_set(num_vars);
+  for (size_t i=0; i<prps.size(); ++i) {
+    BOOST_CHECK(sharded.lookup_by_val("IFACE", prps[i].variables(), set,
+				      found));
+    BOOST_CHECK_EQUAL(found.eval_id(), prps[i].eval_id());
+    BOOST_CHECK_EQUAL(found.response().function_value(0),
+		      prps[i].response().function_value(0));
+  }
+  BOOST_CHECK(sharded.spill_hits() > 0);
+  BOOST_CHECK_EQUAL(sharded.hits() + sharded.spill_hits(), prps.size());
+  BOOST_CHECK_EQUAL(sharded.misses(), 0);
+  BOOST_CHECK_EQUAL(sharded.size() + sharded.spilled(), prps.size());
+
+  std::ostringstream stats;
+  sharded.print_statistics(stats);
+  BOOST_CHECK(stats.str().find("0 misses") != std::string::npos);
+}
+
+
+/** Cache-agnostic accessors see records in data_pairs and the shards */
+BOOST_AUTO_TEST_CASE(test_prp_cache_global_accessors)
+{
+  const size_t num_vars = 2;
+  // restart records in data_pairs; current evaluations in the shards
+  PRPArray restart_prps = generate_prps(5, num_vars, "IFACE", -5),
+    shard_prps = generate_prps(10, num_vars, "IFACE", 1);
+  for (size_t i=0; i<restart_prps.size(); ++i)
+    data_pairs.insert(restart_prps[i]);
+  for (size_t i=5; i<shard_prps.size(); ++i)
+    sharded_data_pairs.insert(shard_prps[i]);
+
+  ParamResponsePair found;
+  ActiveSet set = value_set(num_vars);
+  BOOST_CHECK(lookup_evaluation("IFACE", restart_prps[2].variables(), set,
+				found));
+  BOOST_CHECK_EQUAL(found.eval_id(), -3);
+  BOOST_CHECK(lookup_evaluation(shard_prps[7], found));
+  BOOST_CHECK_EQUAL(found.eval_id(), 8);
+  BOOST_CHECK(!lookup_evaluation("OTHER", shard_prps[7].variables(), set,
+				 found));
+  // the accessors do not count as cache lookups
+  BOOST_CHECK_EQUAL(sharded_data_pairs.hits() + sharded_data_pairs.misses(), 0);
+
+  // partial matches ignore the ActiveSet
+  ActiveSet super_set(set); super_set.request_values(7);
+  BOOST_CHECK(!lookup_evaluation("IFACE", shard_prps[7].variables(), super_set,
+				 found));
+  PRPArray partial;
+  lookup_evaluations("IFACE", shard_prps[7].variables(), partial);
+  BOOST_REQUIRE_EQUAL(partial.size(), 1);
+  BOOST_CHECK_EQUAL(partial[0].eval_id(), 8);
+
+  // all records, ordered by evaluation id as for data_pairs
+  PRPArray all;
+  evaluation_records(all);
+  BOOST_REQUIRE_EQUAL(all.size(), 10);
+  for (size_t i=1; i<all.size(); ++i)
+    BOOST_CHECK(all[i-1].eval_id() < all[i].eval_id());
+
+  data_pairs.clear();
+  sharded_data_pairs.clear();
+}
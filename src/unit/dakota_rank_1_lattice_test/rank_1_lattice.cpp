@@ -12,10 +12,12 @@
 #include <ciso646>
 
 #include "Rank1Lattice.hpp"
+#include "dakota_bit_utils.hpp"
 #include "low_discrepancy_data.hpp"
 
 #include <fstream>
 #include <cmath>
+#include <cstring>
 
 #include "opt_tpl_test.hpp"
 
@@ -599,6 +601,86 @@ BOOST_AUTO_TEST_CASE(lattice_check_lattice_negative_seed)
   );
 }
 
+// +-------------------------------------------------------------------------+
+// |               Compare lattice points with scalar evaluation             |
+// +-------------------------------------------------------------------------+
+BOOST_AUTO_TEST_CASE(lattice_check_bitwise_equal_to_scalar_evaluation)
+{
+  // Get rank-1 lattice rule without random shift
+  Dakota::UInt32Vector z(Teuchos::View, &Dakota::kuo_d3600_m20[0], 3600);
+  Dakota::Rank1Lattice lattice(
+    z,
+    20,
+    false,
+    0,
+    Dakota::RANK_1_LATTICE_RADICAL_INVERSE_ORDERING,
+    Dakota::SILENT_OUTPUT
+  );
+
+  // Generate points of lattice rule, enough to be generated on several
+  // threads
+  size_t numPoints = 1 << 14;
+  size_t dimension = 24;
+  Dakota::RealMatrix points(dimension, numPoints);
+  lattice.get_points(points);
+
+  // Evaluate the lattice points one after the other
+  size_t numDifferent = 0;
+  for ( Dakota::UInt32 k = 0; k < numPoints; k++ )
+  {
+    Dakota::Real phik = Dakota::bitreverse(k) * (1 / Dakota::Real(4294967296L));
+    for ( size_t j = 0; j < dimension; j++ )
+    {
+      Dakota::Real point = phik * z[j];
+      double exact = point - std::floor(point);
+      if ( std::memcmp(&points[k][j], &exact, sizeof(double)) != 0 )
+      {
+        numDifferent++;
+      }
+    }
+  }
+  BOOST_CHECK(numDifferent == 0);
+}
+
+// +-------------------------------------------------------------------------+
+// |                    Check lattice points in sub-ranges                   |
+// +-------------------------------------------------------------------------+
+BOOST_AUTO_TEST_CASE(lattice_check_sub_ranges)
+{
+  // Get randomly-shifted rank-1 lattice rule with a fixed seed
+  Dakota::Rank1Lattice lattice(23);
+
+  // Get all points at once
+  size_t numPoints = 1 << 15;
+  size_t dimension = 8;
+  Dakota::RealMatrix points(dimension, numPoints);
+  lattice.get_points(points);
+
+  // Get the same points on several threads
+  dakota::util::WorkStealingThreadPool::kernel_concurrency(4);
+  Dakota::RealMatrix threaded_points(dimension, numPoints);
+  lattice.get_points(threaded_points);
+  dakota::util::WorkStealingThreadPool::kernel_concurrency(1);
+  BOOST_CHECK(threaded_points == points);
+
+  // Get the same points in sub-ranges that start at arbitrary indices
+  size_t bounds[] = { 0, 1, 7, 1000, 12345, 20000, numPoints };
+  for ( size_t r = 0; r + 1 < sizeof(bounds)/sizeof(bounds[0]); r++ )
+  {
+    size_t nMin = bounds[r];
+    size_t nMax = bounds[r + 1];
+    Dakota::RealMatrix sub_points(dimension, nMax - nMin);
+    lattice.get_points(nMin, nMax, sub_points);
+    for ( size_t k = nMin; k < nMax; k++ )
+    {
+      for ( size_t j = 0; j < dimension; j++ )
+      {
+        BOOST_CHECK_EQUAL(sub_points[k - nMin][j], points[k][j]);
+      }
+    }
+  }
+}
+
 } // end namespace TestRank1Lattice
 
 } // end namespace TestLowDiscrepancy
@@ -12,6 +12,12 @@
 
 #include "DakotaActiveSet.hpp"
 #include "DakotaResponse.hpp"
+#include "ResultsFileTokenizer.hpp"
+#include "dakota_binary_files.h"
+#include "dakota_data_util.hpp"
+
+#include <cstdio>
+#include <cstring>
 
 #define BOOST_TEST_MODULE dakota_response_io
 #include <boost/test/included/unit_test.hpp>
@@ -482,3 +488,239 @@ BOOST_AUTO_TEST_CASE(test_response_read_grads_metadata)
   check_matrix(gradients, resp.function_gradients());
   check_vector(metadata, resp.metadata());
 }
+
+
+// tokens spanning the floating point syntax of results files
+std::vector<std::string> float_syntax_tokens =
+  { "3", "-3", "+3.", ".5", "-.5e-3", "1.5E+02", "2.0d3", "1.2.3", ".5.", "1e",
+    "1+5", "nan", "NaN", "-inf", "+Infinity", "..5", ".", "-", "e5", "1e5.2",
+    "nanx", "infin", "39855432.34H+02", "f3", "[", "" };
+
+
+// the allocation-free float check agrees with the regular expression
+BOOST_AUTO_TEST_CASE(test_response_read_float_syntax)
+{
+  for (const auto& token : float_syntax_tokens) {
+    BOOST_TEST_CHECKPOINT(token);
+    Dakota::ResultsToken view(token.data(), token.size());
+    BOOST_CHECK_EQUAL(Dakota::ResultsFileTokenizer::is_float(view),
+		      isfloat(token));
+  }
+
+  Dakota::Response resp = get_fn_only_response();
+  for (const std::string failed : {"FAIL", "  fail\n", "Failed 1.0 f1"})
+    BOOST_CHECK_THROW(read_response(failed, Dakota::FLEXIBLE_RESULTS, resp),
+		      Dakota::FunctionEvalFailure);
+}
+
+
+Dakota::Response get_field_response(size_t num_fns, size_t num_derivs,
+				     short asv_val)
+{
+  Dakota::ActiveSet as(num_fns, num_derivs);
+  as.request_values(asv_val);
+  Dakota::SharedResponseData srd(as);
+  return Dakota::Response(srd, as);
+}
+
+
+// results file with num_fns labeled values and optional gradients;
+// value i is i + 0.25 and gradient entry (i,j) is i - 0.5 j
+std::string field_results_file(size_t num_fns, size_t num_derivs,
+			       bool gradients)
+{
+  std::ostringstream s;
+  s.precision(17);
+  for (size_t i=0; i<num_fns; ++i)
+    s << i + 0.25 << " f" << i+1 << '\n';
+  if (gradients)
+    for (size_t i=0; i<num_fns; ++i) {
+      s << "[ ";
+      for (size_t j=0; j<num_derivs; ++j)
+	s << i - 0.5*j << ' ';
+      s << "]\n";
+    }
+  return s.str();
+}
+
+
+/** Field responses are read exactly in both text formats, with and
+    without gradients */
+BOOST_AUTO_TEST_CASE(test_response_read_field_values)
+{
+  const size_t num_fns = 1000, num_derivs = 10;
+
+  for (bool gradients : {false, true}) {
+    Dakota::Response resp =
+      get_field_response(num_fns, num_derivs, gradients ? 3 : 1);
+    std::string results = field_results_file(num_fns, num_derivs, gradients);
+
+    for (const auto format : {Dakota::FLEXIBLE_RESULTS,
+			      Dakota::LABELED_RESULTS}) {
+      read_response(results, format, resp);
+
+      const auto& fn_vals = resp.function_values();
+      const auto& fn_grads = resp.function_gradients();
+      size_t num_mismatch = 0;
+      for (size_t i=0; i<num_fns; ++i) {
+	if (fn_vals[i] != i + 0.25)
+	  ++num_mismatch;
+	if (gradients)
+	  for (size_t j=0; j<num_derivs; ++j)
+	    if (fn_grads(j,i) != i - 0.5*j)
+	      ++num_mismatch;
+      }
+      BOOST_CHECK_EQUAL(num_mismatch, 0);
+    }
+  }
+}
+
+
+// binary results record as written by an analysis driver through
+// dakota_binary_files.h
+std::string binary_results_file(const std::vector<unsigned char>& contents,
+				size_t num_derivs,
+				const std::vector<double>& values,
+				const std::vector<double>& grads,
+				const std::vector<double>& hessians,
+				const std::vector<double>& metadata)
+{
+  dakota_bin_results r;
+  r.num_fns = contents.size();
+  r.num_deriv_vars = num_derivs;
+  r.num_metadata = metadata.size();
+  r.contents = contents.data();
+  r.values = values.data();
+  r.gradients = grads.data();
+  r.hessians = hessians.data();
+  r.metadata = metadata.data();
+
+  FILE* f = std::tmpfile();
+  BOOST_REQUIRE(f);
+  BOOST_REQUIRE_EQUAL(dakota_bin_write_results(f, &r), 0);
+  std::string record(static_cast<size_t>(std::ftell(f)), '\0');
+  std::rewind(f);
+  BOOST_REQUIRE_EQUAL(std::fread(&record[0], 1, record.size(), f),
+		      record.size());
+  std::fclose(f);
+  return record;
+}
+
+
+/// Binary results are read bit-for-bit, including values that do not
+/// survive a text round trip at default precision
+BOOST_AUTO_TEST_CASE(test_response_read_binary)
+{
+  Dakota::ActiveSet as(3, 2);
+  Dakota::ShortArray asv = {7, 3, 1};
+  as.request_vector(asv);
+  Dakota::SharedResponseData srd(as);
+  Dakota::Response resp(srd, as);
+  resp.reshape_metadata(1);
+
+  const double third = 1./3., tiny = 1.0189673084127668E-266;
+  std::vector<unsigned char> contents = {7, 3, 1};
+  std::vector<double> values = {third, -2.5e300, 3.},
+    grads = {tiny, -1., 4., 5., 0., 0.},
+    hessians = {2., -1., -1., 2.},
+    metadata = {42.};
+  std::string record =
+    binary_results_file(contents, 2, values, grads, hessians, metadata);
+  resp.read(record, Dakota::BINARY_RESULTS);
+
+  BOOST_CHECK_EQUAL(resp.function_value(0), third);
+  BOOST_CHECK_EQUAL(resp.function_value(1), -2.5e300);
+  BOOST_CHECK_EQUAL(resp.function_value(2), 3.);
+  BOOST_CHECK_EQUAL(resp.function_gradients()(0,0), tiny);
+  BOOST_CHECK_EQUAL(resp.function_gradients()(1,1), 5.);
+  check_matrix(hessian_F3, resp.function_hessian(0));
+  BOOST_CHECK_EQUAL(resp.metadata()[0], 42.);
+
+  // the stream interface reads the same record
+  read_response(record, Dakota::BINARY_RESULTS, resp);
+  BOOST_CHECK_EQUAL(resp.function_value(0), third);
+
+  // data not matching the ASV, truncated and trailing data
+  contents[1] = 1;
+  BOOST_CHECK_THROW(resp.read(binary_results_file(contents, 2, values, grads,
+    hessians, metadata), Dakota::BINARY_RESULTS), Dakota::ResultsFileError);
+  BOOST_CHECK_THROW(resp.read(binary_results_file({7, 3}, 2, values, grads,
+    hessians, metadata), Dakota::BINARY_RESULTS), Dakota::ResultsFileError);
+  BOOST_CHECK_THROW(resp.read(record.substr(0, record.size()-1),
+    Dakota::BINARY_RESULTS), Dakota::ResultsFileError);
+  BOOST_CHECK_THROW(resp.read(record + record, Dakota::BINARY_RESULTS),
+		    Dakota::ResultsFileError);
+  BOOST_CHECK_THROW(resp.read(valid_functions_file, Dakota::BINARY_RESULTS),
+		    Dakota::ResultsFileError);
+
+  // failure record
+  FILE* f = std::tmpfile();
+  BOOST_REQUIRE(f);
+  BOOST_REQUIRE_EQUAL(dakota_bin_write_failure(f), 0);
+  std::string failed(DAKOTA_BIN_HEADER_SIZE, '\0');
+  std::rewind(f);
+  BOOST_REQUIRE_EQUAL(std::fread(&failed[0], 1, failed.size(), f),
+		      failed.size());
+  std::fclose(f);
+  BOOST_CHECK_EQUAL(dakota_bin_results_record_size(failed.data(),
+						   failed.size()),
+		    failed.size());
+  BOOST_CHECK_THROW(resp.read(failed, Dakota::BINARY_RESULTS),
+		    Dakota::FunctionEvalFailure);
+}
+
+
+/// Parameters records written by Dakota are parsed by the driver-side
+/// reader in dakota_binary_files.h
+BOOST_AUTO_TEST_CASE(test_binary_params_parse)
+{
+  FILE* f = std::tmpfile();
+  BOOST_REQUIRE(f);
+  const double cv[] = {0.25, -1.5e-300};
+  const int64_t div[] = {-3};
+  const char* labels[] = {"x1", "x2", "n", "s"};
+  BOOST_REQUIRE_EQUAL(dakota_bin_write_header(f, DAKOTA_BIN_PARAMS_MAGIC, 0),
+		      0);
+  for (uint64_t n : {2, 1, 1, 0})
+    dakota_bin_write_u64(f, n);
+  for (const char* l : labels)
+    dakota_bin_write_string(f, l, std::strlen(l));
+  dakota_bin_write_f64_array(f, cv, 2);
+  dakota_bin_write_i64_array(f, div, 1);
+  dakota_bin_write_string(f, "foo bar", 7);
+  dakota_bin_write_u64(f, 1);
+  dakota_bin_write_string(f, "obj", 3);
+  std::fputc(3, f);
+  dakota_bin_write_u64(f, 2);
+  dakota_bin_write_u64(f, 1);
+  dakota_bin_write_u64(f, 2);
+  dakota_bin_write_u64(f, 0);
+  dakota_bin_write_string(f, "1", 1);
+  dakota_bin_write_u64(f, 0);
+
+  std::string record(static_cast<size_t>(std::ftell(f)), '\0');
+  std::rewind(f);
+  BOOST_REQUIRE_EQUAL(std::fread(&record[0], 1, record.size(), f),
+		      record.size());
+  std::fclose(f);
+
+  dakota_bin_params p;
+  BOOST_REQUIRE_EQUAL(dakota_bin_parse_params(record.data(), record.size(),
+					      &p), record.size());
+  BOOST_CHECK_EQUAL(p.num_cv, 2);
+  BOOST_CHECK_EQUAL(std::string(p.labels[3]), "s");
+  BOOST_CHECK_EQUAL(p.cv[1], -1.5e-300);
+  BOOST_CHECK_EQUAL(p.div[0], -3);
+  BOOST_CHECK_EQUAL(std::string(p.dsv[0]), "foo bar");
+  BOOST_CHECK_EQUAL(p.asv[0], 3);
+  BOOST_CHECK_EQUAL(p.dvv[1], 2);
+  BOOST_CHECK_EQUAL(std::string(p.eval_id), "1");
+  dakota_bin_free_params(&p);
+
+  // truncation is detected at every length
+  size_t num_accepted = 0;
+  for (size_t len=0; len<record.size(); ++len)
+    if (dakota_bin_parse_params(record.data(), len, &p))
+      { ++num_accepted; dakota_bin_free_params(&p); }
+  BOOST_CHECK_EQUAL(num_accepted, 0);
+}
@@ -0,0 +1,177 @@
+/*  _______________________________________________________________________
+
+    Dakota: Explore and predict with confidence.
+    Copyright 2014-2023
+    National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Dakota directory.
+    _______________________________________________________________________ */
+
+
+/** \file response_io_benchmark.cpp Time Response reads from results
+    files. */
+
+#include "DakotaActiveSet.hpp"
+#include "DakotaResponse.hpp"
+#include "dakota_binary_files.h"
+
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <sstream>
+
+#define BOOST_TEST_MODULE dakota_response_io_benchmark
+#include <boost/test/included/unit_test.hpp>
+
+
+void read_response(const std::string& results_string,
+		   const unsigned short format, Dakota::Response& resp)
+{
+  std::istringstream results_stream(results_string);
+  resp.read(results_stream, format);
+}
+
+
+Dakota::Response get_field_response(size_t num_fns, size_t num_derivs,
+				     short asv_val)
+{
+  Dakota::ActiveSet as(num_fns, num_derivs);
+  as.request_values(asv_val);
+  Dakota::SharedResponseData srd(as);
+  return Dakota::Response(srd, as);
+}
+
+
+// results file with num_fns labeled values and optional gradients;
+// value i is i + 0.25 and gradient entry (i,j) is i - 0.5 j
+std::string field_results_file(size_t num_fns, size_t num_derivs,
+			       bool gradients)
+{
+  std::ostringstream s;
+  s.precision(17);
+  for (size_t i=0; i<num_fns; ++i)
+    s << i + 0.25 << " f" << i+1 << '\n';
+  if (gradients)
+    for (size_t i=0; i<num_fns; ++i) {
+      s << "[ ";
+      for (size_t j=0; j<num_derivs; ++j)
+	s << i - 0.5*j << ' ';
+      s << "]\n";
+    }
+  return s.str();
+}
+
+
+/** Parsing throughput of field responses for increasing file sizes */
+BOOST_AUTO_TEST_CASE(test_response_read_field_throughput)
+{
+  typedef std::chrono::steady_clock clock;
+  typedef std::chrono::duration<double> seconds;
+  const size_t num_derivs = 10;
+
+  for (size_t num_fns : {1000, 10000, 100000}) {
+    for (bool gradients : {false, true}) {
+      Dakota::Response resp =
+	get_field_response(num_fns, num_derivs, gradients ? 3 : 1);
+      std::string results = field_results_file(num_fns, num_derivs, gradients);
+
+      for (const auto format : {Dakota::FLEXIBLE_RESULTS,
+				Dakota::LABELED_RESULTS}) {
+	clock::time_point t0 = clock::now();
+	read_response(results, format, resp);
+	double elapsed = seconds(clock::now() - t0).count();
+
+	const auto& fn_vals = resp.function_values();
+	const auto& fn_grads = resp.function_gradients();
+	size_t num_mismatch = 0;
+	for (size_t i=0; i<num_fns; ++i) {
+	  if (fn_vals[i] != i + 0.25)
+	    ++num_mismatch;
+	  if (gradients)
+	    for (size_t j=0; j<num_derivs; ++j)
+	      if (fn_grads(j,i) != i - 0.5*j)
+		++num_mismatch;
+	}
+	BOOST_CHECK_EQUAL(num_mismatch, 0);
+
+	size_t num_values = num_fns * (gradients ? num_derivs+1 : 1);
+	std::cout << (format == Dakota::FLEXIBLE_RESULTS ?
+		      "flexible" : "labeled") << " results, "
+	  << num_values << " values, " << results.size() << " bytes: "
+	  << results.size() / elapsed / 1.e6 << " MB/s, "
+	  << num_values / elapsed << " values/s" << std::endl;
+      }
+    }
+  }
+}
+
+
+// binary results record as written by an analysis driver through
+// dakota_binary_files.h
+std::string binary_results_file(const std::vector<unsigned char>& contents,
+				size_t num_derivs,
+				const std::vector<double>& values,
+				const std::vector<double>& grads,
+				const std::vector<double>& hessians,
+				const std::vector<double>& metadata)
+{
+  dakota_bin_results r;
+  r.num_fns = contents.size();
+  r.num_deriv_vars = num_derivs;
+  r.num_metadata = metadata.size();
+  r.contents = contents.data();
+  r.values = values.data();
+  r.gradients = grads.data();
+  r.hessians = hessians.data();
+  r.metadata = metadata.data();
+
+  FILE* f = std::tmpfile();
+  BOOST_REQUIRE(f);
+  BOOST_REQUIRE_EQUAL(dakota_bin_write_results(f, &r), 0);
+  std::string record(static_cast<size_t>(std::ftell(f)), '\0');
+  std::rewind(f);
+  BOOST_REQUIRE_EQUAL(std::fread(&record[0], 1, record.size(), f),
+		      record.size());
+  std::fclose(f);
+  return record;
+}
+
+
+/// Field results are transferred as raw doubles: report the write+read
+/// cost per evaluation of the binary and text formats
+BOOST_AUTO_TEST_CASE(test_response_binary_throughput)
+{
+  typedef std::chrono::steady_clock clock;
+  typedef std::chrono::duration<double> seconds;
+  const size_t num_derivs = 10, num_evals = 10;
+
+  for (size_t num_fns : {1000, 10000, 100000}) {
+    Dakota::Response resp = get_field_response(num_fns, num_derivs, 1);
+    std::vector<unsigned char> contents(num_fns, 1);
+    std::vector<double> values(num_fns);
+    for (size_t i=0; i<num_fns; ++i)
+      values[i] = i + 0.25;
+    std::vector<double> none;
+
+    clock::time_point t0 = clock::now();
+    for (size_t e=0; e<num_evals; ++e)
+      resp.read(binary_results_file(contents, num_derivs, values, none, none,
+				    none), Dakota::BINARY_RESULTS);
+    double binary_time = seconds(clock::now() - t0).count() / num_evals;
+    size_t num_mismatch = 0;
+    for (size_t i=0; i<num_fns; ++i)
+      if (resp.function_value(i) != values[i])
+	++num_mismatch;
+    BOOST_CHECK_EQUAL(num_mismatch, 0);
+
+    t0 = clock::now();
+    for (size_t e=0; e<num_evals; ++e)
+      read_response(field_results_file(num_fns, num_derivs, false),
+		    Dakota::FLEXIBLE_RESULTS, resp);
+    double text_time = seconds(clock::now() - t0).count() / num_evals;
+
+    std::cout << num_fns << " values per evaluation: binary "
+	      << binary_time*1.e3 << " ms, text " << text_time*1.e3 << " ms ("
+	      << text_time / binary_time << "x)" << std::endl;
+  }
+}
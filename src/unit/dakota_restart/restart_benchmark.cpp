@@ -0,0 +1,123 @@
+/*  _______________________________________________________________________
+
+    Dakota: Explore and predict with confidence.
+    Copyright 2014-2023
+    National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Dakota directory.
+    _______________________________________________________________________ */
+
+#include "IndexedRestart.hpp"
+#include "OutputManager.hpp"
+#include "ParamResponsePair.hpp"
+#include "RestartVersion.hpp"
+#include "SimulationResponse.hpp"
+#include "WorkStealingThreadPool.hpp"
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+
+#define BOOST_TEST_MODULE dakota_restart_benchmark
+#include <boost/test/included/unit_test.hpp>
+#include <boost/filesystem/operations.hpp>
+
+using namespace Dakota;
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+typedef std::chrono::duration<double> Seconds;
+
+/// write num_evals records over num_vars continuous variables with values
+/// and gradients active, as a Dakota study would
+void write_prps(const int num_evals, const size_t num_vars,
+		RestartWriter& rst_writer)
+{
+  SizetArray vc_totals(NUM_VC_TOTALS);
+  vc_totals[0] = num_vars;
+  std::pair<short, short> view(MIXED_ALL, EMPTY_VIEW);
+  SharedVariablesData svd(view, vc_totals);
+  Variables vars(svd);
+
+  ActiveSet as(1, num_vars);
+  as.request_values(3);
+  Response resp(SIMULATION_RESPONSE, as);
+
+  for (int i=0; i<num_evals; ++i) {
+    for (size_t j=0; j<num_vars; ++j)
+      vars.continuous_variable(1.e-3 * (Real)i + (Real)j, j);
+    resp.function_value((Real)i, 0);
+    rst_writer.append_prp(ParamResponsePair(vars, "IFACE", resp, i+1));
+  }
+}
+
+}
+
+
+/** Startup cost of a large restart file: a sequential archive is
+    deserialized in full, while an indexed one is opened by reading its
+    index and then bulk loaded or queried by key */
+BOOST_AUTO_TEST_CASE(test_restart_startup_time)
+{
+  const std::string seq_filename("benchmark_sequential.rst"),
+    idx_filename("benchmark_indexed.rst");
+  const int num_evals = 200000;
+  const size_t num_vars = 10, num_finds = 1000;
+  {
+    RestartWriter seq_writer(seq_filename);
+    write_prps(num_evals, num_vars, seq_writer);
+    RestartWriter idx_writer(idx_filename,
+      RestartVersion("6.16.0+", "a1b2c3d4e5f6",
+		     RestartVersion::indexedRestartVersionDelta));
+    write_prps(num_evals, num_vars, idx_writer);
+  }
+
+  Clock::time_point t0 = Clock::now();
+  PRPArray seq_prps;
+  {
+    std::ifstream restart_input_fs(seq_filename, std::ios::binary);
+    boost::archive::binary_iarchive restart_input_archive(restart_input_fs);
+    RestartVersion rst_ver;
+    restart_input_archive & rst_ver;
+    seq_prps.resize(num_evals);
+    for (int i=0; i<num_evals; ++i)
+      restart_input_archive & seq_prps[i];
+  }
+  double seq_time = Seconds(Clock::now() - t0).count();
+
+  t0 = Clock::now();
+  IndexedRestartReader rst_reader(idx_filename);
+  double open_time = Seconds(Clock::now() - t0).count();
+  BOOST_REQUIRE_EQUAL(rst_reader.num_records(), num_evals);
+
+  t0 = Clock::now();
+  ParamResponsePair found;
+  for (size_t i=0; i<num_finds; ++i) {
+    const ParamResponsePair& prp = seq_prps[(i * 7919) % num_evals];
+    BOOST_REQUIRE(rst_reader.find(prp.interface_id(), prp.variables(), found));
+  }
+  double find_time = Seconds(Clock::now() - t0).count();
+
+  const size_t num_threads[2] = { 1, 4 };
+  double load_time[2];
+  for (size_t t=0; t<2; ++t) {
+    dakota::util::WorkStealingThreadPool::kernel_concurrency(num_threads[t]);
+    PRPArray idx_prps;
+    t0 = Clock::now();
+    rst_reader.read_records(rst_reader.num_records(), idx_prps);
+    load_time[t] = Seconds(Clock::now() - t0).count();
+    BOOST_CHECK(idx_prps.size() == seq_prps.size());
+  }
+  dakota::util::WorkStealingThreadPool::kernel_concurrency(1);
+
+  std::cout << num_evals << " restart records: sequential read " << seq_time
+	    << " s; indexed open " << open_time << " s, " << num_finds
+	    << " lookups " << find_time << " s (including key index build), "
+	    << "bulk load " << load_time[0] << " s on " << num_threads[0]
+	    << " thread, " << load_time[1] << " s on " << num_threads[1]
+	    << " threads" << std::endl;
+
+  boost::filesystem::remove(seq_filename);
+  boost::filesystem::remove(idx_filename);
+}
@@ -7,10 +7,12 @@
     For more information, see the README file in the top Dakota directory.
     _______________________________________________________________________ */
 
+#include "IndexedRestart.hpp"
 #include "OutputManager.hpp"
 #include "ParamResponsePair.hpp"
 #include "RestartVersion.hpp"
 #include "SimulationResponse.hpp"
+#include "WorkStealingThreadPool.hpp"
 
 #ifdef _WIN32
 #include "util_windows.hpp"
@@ -336,3 +338,230 @@ BOOST_AUTO_TEST_CASE(test_io_restart_read_newfile)
 
   boost::filesystem::remove(rst_filename);
 }
+
+
+/** Indexed format: random access by position, eval id, and variables */
+BOOST_AUTO_TEST_CASE(test_io_restart_indexed)
+{
+  std::string rst_filename("indexed.rst");
+  boost::filesystem::remove(rst_filename);
+
+  const int num_evals = 10;
+  PRPArray prps_out, prps_in;
+  {
+    RestartVersion rst_ver("6.16.0+", "a1b2c3d4e5f6",
+			   RestartVersion::indexedRestartVersionDelta);
+    RestartWriter rst_writer(rst_filename, rst_ver);
+    BOOST_CHECK(rst_writer.indexed_format());
+    prps_out = generate_and_write_prps(num_evals, rst_writer);
+  }
+
+  // the version header is common to both formats
+  RestartVersion rst_ver = RestartVersion::check_restart_version(rst_filename);
+  BOOST_CHECK(rst_ver.indexed_format());
+  BOOST_CHECK(rst_ver.dakotaRelease == "6.16.0+");
+
+  {
+    IndexedRestartReader rst_reader(rst_filename);
+    BOOST_CHECK(!rst_reader.index_recovered());
+    BOOST_CHECK_EQUAL(rst_reader.num_records(), num_evals);
+    rst_reader.read_records(num_evals, prps_in);
+    BOOST_CHECK(prps_in == prps_out);
+
+    ParamResponsePair found;
+    BOOST_CHECK(rst_reader.find_eval_id(7, found));
+    BOOST_CHECK(found == prps_out[6]);
+    BOOST_CHECK(!rst_reader.find_eval_id(num_evals + 1, found));
+    BOOST_CHECK(rst_reader.find("RST_IFACE", prps_out[3].variables(), found));
+    BOOST_CHECK_EQUAL(found.eval_id(), 4);
+    BOOST_CHECK(!rst_reader.find("OTHER", prps_out[3].variables(), found));
+  }
+
+  boost::filesystem::remove(rst_filename);
+}
+
+
+/** Indexed format: records preceding a truncation (e.g., abort before
+    the index is written) are recovered by scanning */
+BOOST_AUTO_TEST_CASE(test_io_restart_indexed_recover)
+{
+  std::string rst_filename("indexed_truncated.rst");
+  boost::filesystem::remove(rst_filename);
+
+  const int num_evals = 5;
+  PRPArray prps_out, prps_in;
+  {
+    RestartVersion rst_ver("6.16.0+", "a1b2c3d4e5f6",
+			   RestartVersion::indexedRestartVersionDelta);
+    RestartWriter rst_writer(rst_filename, rst_ver);
+    prps_out = generate_and_write_prps(num_evals, rst_writer);
+  }
+
+  // drop the index and part of the last record
+  UInt64 last_offset;
+  {
+    IndexedRestartReader rst_reader(rst_filename);
+    last_offset = rst_reader.entry(num_evals - 1).offset;
+  }
+  boost::filesystem::resize_file(rst_filename, last_offset + 10);
+
+  {
+    IndexedRestartReader rst_reader(rst_filename);
+    BOOST_CHECK(rst_reader.index_recovered());
+    BOOST_CHECK_EQUAL(rst_reader.num_records(), num_evals - 1);
+    rst_reader.read_records(rst_reader.num_records(), prps_in);
+    prps_out.pop_back();
+    BOOST_CHECK(prps_in == prps_out);
+  }
+
+  boost::filesystem::remove(rst_filename);
+}
+
+
+/** Indexed format: the stored record keys are independent of the build
+    (a fixed value for fixed data) and of the variables view, which
+    Variables operator== ignores */
+BOOST_AUTO_TEST_CASE(test_io_restart_indexed_record_key)
+{
+  std::string rst_filename("indexed_keys.rst");
+  const int num_evals = 3;
+  PRPArray prps_out;
+  {
+    RestartWriter rst_writer(rst_filename,
+      RestartVersion("6.16.0+", "a1b2c3d4e5f6",
+		     RestartVersion::indexedRestartVersionDelta));
+    prps_out = generate_minimal_prps(num_evals, rst_writer);
+  }
+
+  IndexedRestartReader rst_reader(rst_filename);
+  BOOST_REQUIRE_EQUAL(rst_reader.num_records(), num_evals);
+  // "RST_IFACE" with the single continuous variable M_LOG2E
+  BOOST_CHECK_EQUAL(rst_reader.entry(0).varsKey, 0x27a3ca5e9105dcc4ULL);
+  for (int i=0; i<num_evals; ++i)
+    BOOST_CHECK_EQUAL(rst_reader.entry(i).varsKey,
+      IndexedRestart::record_key("RST_IFACE", prps_out[i].variables()));
+
+  SizetArray vc_totals(NUM_VC_TOTALS);
+  vc_totals[0] = 1;
+  std::pair<short, short> design_view(MIXED_DESIGN, EMPTY_VIEW);
+  SharedVariablesData svd(design_view, vc_totals);
+  Variables other_view(svd);
+  other_view.continuous_variable(M_LOG2E, 0);
+  BOOST_CHECK_EQUAL(IndexedRestart::record_key("RST_IFACE", other_view),
+		    0x27a3ca5e9105dcc4ULL);
+  ParamResponsePair found;
+  BOOST_CHECK(rst_reader.find("RST_IFACE", other_view, found));
+  BOOST_CHECK_EQUAL(found.eval_id(), 1);
+
+  boost::filesystem::remove(rst_filename);
+}
+
+
+/** A concurrent bulk load of an indexed restart file reproduces the
+    records of a sequential one, in file order */
+BOOST_AUTO_TEST_CASE(test_io_restart_indexed_bulk_load)
+{
+  std::string seq_filename("bulk_sequential.rst"),
+    idx_filename("bulk_indexed.rst");
+  const int num_evals = 1000;
+
+  PRPArray prps_out, seq_prps, idx_prps;
+  {
+    RestartWriter seq_writer(seq_filename);
+    prps_out = generate_and_write_prps(num_evals, seq_writer);
+    RestartWriter idx_writer(idx_filename,
+      RestartVersion("6.16.0+", "a1b2c3d4e5f6",
+		     RestartVersion::indexedRestartVersionDelta));
+    for (size_t i=0; i<prps_out.size(); ++i)
+      idx_writer.append_prp(prps_out[i]);
+  }
+
+  {
+    std::ifstream restart_input_fs(seq_filename, std::ios::binary);
+    boost::archive::binary_iarchive restart_input_archive(restart_input_fs);
+    RestartVersion rst_ver;
+    restart_input_archive & rst_ver;
+    seq_prps = read_prps(num_evals, restart_input_archive);
+  }
+  dakota::util::WorkStealingThreadPool::kernel_concurrency(4);
+  {
+    IndexedRestartReader rst_reader(idx_filename);
+    rst_reader.read_records(rst_reader.num_records(), idx_prps);
+  }
+  dakota::util::WorkStealingThreadPool::kernel_concurrency(1);
+
+  BOOST_CHECK(seq_prps == prps_out);
+  BOOST_CHECK(idx_prps == prps_out);
+
+  boost::filesystem::remove(seq_filename);
+  boost::filesystem::remove(idx_filename);
+}
+
+
+/** Group-committed writes on a background thread produce the same
+    file contents under each commit policy */
+BOOST_AUTO_TEST_CASE(test_io_restart_commit_policies)
+{
+  std::string rst_filename("commit_policy.rst");
+  const int num_evals = 50;
+  const unsigned short policies[] = { RESTART_COMMIT_EVALS,
+    RESTART_COMMIT_SECONDS, RESTART_COMMIT_CHECKPOINT };
+
+  for (size_t p=0; p<3; ++p) {
+    boost::filesystem::remove(rst_filename);
+    PRPArray prps_out, prps_in;
+    {
+      RestartWriter rst_writer(rst_filename);
+      // the checkpoint policy also synchronizes each commit to disk
+      rst_writer.commit_policy(policies[p], 7,
+			       policies[p] == RESTART_COMMIT_CHECKPOINT);
+      BOOST_CHECK_EQUAL(rst_writer.commit_policy(), policies[p]);
+      prps_out = generate_minimal_prps(num_evals, rst_writer);
+      rst_writer.checkpoint();
+      // all queued records are committed by flush
+      rst_writer.flush();
+      BOOST_CHECK_EQUAL(rst_writer.records_written(), num_evals);
+      BOOST_CHECK(rst_writer.io_time() >= 0.);
+
+      std::ifstream restart_input_fs(rst_filename, std::ios::binary);
+      boost::archive::binary_iarchive restart_input_archive(restart_input_fs);
+      RestartVersion rst_ver;
+      restart_input_archive & rst_ver;
+      prps_in = read_prps(num_evals, restart_input_archive);
+    }
+    BOOST_CHECK(prps_in == prps_out);
+  }
+
+  boost::filesystem::remove(rst_filename);
+}
+
+
+/** abort() with a background writer returns without waiting on it,
+    leaves the committed records readable and makes later writes and
+    flushes return at once */
+BOOST_AUTO_TEST_CASE(test_io_restart_abort)
+{
+  std::string rst_filename("abort.rst");
+  boost::filesystem::remove(rst_filename);
+  const int num_evals = 20;
+  PRPArray prps_out, prps_in;
+  {
+    RestartWriter rst_writer(rst_filename);
+    rst_writer.commit_policy(RESTART_COMMIT_CHECKPOINT);
+    prps_out = generate_minimal_prps(num_evals, rst_writer);
+    rst_writer.flush();
+    rst_writer.abort();
+    rst_writer.append_prp(prps_out[0]); // discarded
+    rst_writer.flush();
+    BOOST_CHECK_EQUAL(rst_writer.records_written(), num_evals);
+
+    std::ifstream restart_input_fs(rst_filename, std::ios::binary);
+    boost::archive::binary_iarchive restart_input_archive(restart_input_fs);
+    RestartVersion rst_ver;
+    restart_input_archive & rst_ver;
+    prps_in = read_prps(num_evals, restart_input_archive);
+  } // close() joins the stopped writer
+  BOOST_CHECK(prps_in == prps_out);
+
+  boost::filesystem::remove(rst_filename);
+}
@@ -0,0 +1,108 @@
+/*  _______________________________________________________________________
+
+    Dakota: Explore and predict with confidence.
+    Copyright 2014-2023
+    National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Dakota directory.
+    _______________________________________________________________________ */
+
+#include "SpatialIndex.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_real_distribution.hpp>
+
+#define BOOST_TEST_MODULE dakota_spatial_index_benchmark
+#include <boost/test/included/unit_test.hpp>
+
+using namespace Dakota;
+
+namespace {
+
+/// num_pts uniform points on the unit hypercube, stored contiguously
+RealArray uniform_points(size_t num_pts, size_t num_dim, unsigned int seed)
+{
+  boost::mt19937 rng(seed);
+  boost::random::uniform_real_distribution<> uniform(0., 1.);
+  RealArray points(num_pts*num_dim);
+  for (size_t i=0; i<points.size(); ++i)
+    points[i] = uniform(rng);
+  return points;
+}
+
+Real brute_distance_sq(const Real* x, const Real* y, size_t num_dim,
+		       size_t excluded_dim = SpatialIndex::npos)
+{
+  Real dist_sq = 0.;
+  for (size_t d=0; d<num_dim; ++d)
+    if (d != excluded_dim)
+      { Real dx = x[d] - y[d]; dist_sq += dx*dx; }
+  return dist_sq;
+}
+
+}
+
+
+/** Scaling from 10^3 to 10^6 points in 2 to 20 dimensions: insertion,
+    nearest neighbor and coverage queries against a scan over all
+    points.  Timings are reported. */
+BOOST_AUTO_TEST_CASE(test_spatial_index_scaling)
+{
+  typedef std::chrono::steady_clock clock;
+  typedef std::chrono::duration<double> seconds;
+  const size_t dims[] = { 2, 5, 10, 20 }, num_queries = 100;
+  for (size_t t=0; t<4; ++t) {
+    size_t num_dim = dims[t];
+    RealArray queries = uniform_points(num_queries, num_dim, 3);
+    for (size_t num_pts=1000; num_pts<=1000000; num_pts*=10) {
+      RealArray points = uniform_points(num_pts, num_dim, 4);
+      // radii leaving most of the domain uncovered, as in late dart games
+      Real r = 0.25 * std::pow((Real)num_pts, -1. / (Real)num_dim);
+
+      clock::time_point t0 = clock::now();
+      SpatialIndex index(num_dim);
+      index.reserve(num_pts);
+      for (size_t i=0; i<num_pts; ++i)
+	index.insert(&points[i*num_dim], r*r);
+      clock::time_point t1 = clock::now();
+
+      size_t q, i, num_mismatch = 0;
+      SizetArray tree_nearest(num_queries);
+      std::vector<bool> tree_covered(num_queries);
+      for (q=0; q<num_queries; ++q) {
+	Real dist_sq;
+	tree_nearest[q] = index.nearest(&queries[q*num_dim], dist_sq);
+	tree_covered[q] = index.covered(&queries[q*num_dim]);
+      }
+      clock::time_point t2 = clock::now();
+
+      for (q=0; q<num_queries; ++q) {
+	const Real* x = &queries[q*num_dim];
+	size_t ref_nearest = 0;
+	Real min_dist_sq = brute_distance_sq(x, &points[0], num_dim);
+	bool ref_covered = false;
+	for (i=0; i<num_pts; ++i) {
+	  Real dist_sq = brute_distance_sq(x, &points[i*num_dim], num_dim);
+	  if (dist_sq < min_dist_sq)
+	    { min_dist_sq = dist_sq; ref_nearest = i; }
+	  if (dist_sq < r*r)
+	    ref_covered = true;
+	}
+	if (ref_nearest != tree_nearest[q] || ref_covered != tree_covered[q])
+	  ++num_mismatch;
+      }
+      clock::time_point t3 = clock::now();
+
+      BOOST_CHECK_EQUAL(num_mismatch, 0);
+      std::cout << "spatial index: " << num_pts << " points in "
+	<< num_dim << "d: insert " << seconds(t1 - t0).count() << " s, "
+	<< num_queries << " queries " << seconds(t2 - t1).count()
+	<< " s indexed, " << seconds(t3 - t2).count() << " s brute force"
+	<< std::endl;
+    }
+  }
+}
@@ -0,0 +1,347 @@
+/*  _______________________________________________________________________
+
+    Dakota: Explore and predict with confidence.
+    Copyright 2014-2023
+    National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Dakota directory.
+    _______________________________________________________________________ */
+
+#include "opt_tpl_test.hpp"
+#include "NonDPOFDarts.hpp"
+#include "VPSApproximation.hpp"
+#include "SpatialIndex.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_real_distribution.hpp>
+
+#define BOOST_TEST_MODULE dakota_spatial_index_test
+#include <boost/test/included/unit_test.hpp>
+
+using namespace Dakota;
+
+namespace {
+
+/// num_pts uniform points on the unit hypercube, stored contiguously
+RealArray uniform_points(size_t num_pts, size_t num_dim, unsigned int seed)
+{
+  boost::mt19937 rng(seed);
+  boost::random::uniform_real_distribution<> uniform(0., 1.);
+  RealArray points(num_pts*num_dim);
+  for (size_t i=0; i<points.size(); ++i)
+    points[i] = uniform(rng);
+  return points;
+}
+
+Real brute_distance_sq(const Real* x, const Real* y, size_t num_dim,
+		       size_t excluded_dim = SpatialIndex::npos)
+{
+  Real dist_sq = 0.;
+  for (size_t d=0; d<num_dim; ++d)
+    if (d != excluded_dim)
+      { Real dx = x[d] - y[d]; dist_sq += dx*dx; }
+  return dist_sq;
+}
+
+/// sequential trimming of the spoke from x_i to end by every bisector,
+/// as in the darts spoke loops
+size_t brute_trim(const RealArray& points, size_t num_dim, size_t i,
+		  Real* end)
+{
+  const Real* x_i = &points[i*num_dim];
+  size_t j, d, num_pts = points.size() / num_dim, neighbor = i;
+  for (j=0; j<num_pts; ++j) {
+    if (j == i) continue;
+    const Real* x_j = &points[j*num_dim];
+    Real dotv = 0., dote = 0., norm = 0.;
+    for (d=0; d<num_dim; ++d)
+      norm += (x_j[d] - x_i[d]) * (x_j[d] - x_i[d]);
+    norm = 1. / std::sqrt(norm);
+    for (d=0; d<num_dim; ++d) {
+      Real n_d = (x_j[d] - x_i[d]) * norm;
+      dotv += 0.5 * (x_j[d] - x_i[d]) * n_d;
+      dote += (end[d] - x_i[d]) * n_d;
+    }
+    if (std::fabs(dote) < 1.e-10 || std::fabs(dote) < std::fabs(dotv))
+      continue;
+    Real u = dotv / dote;
+    if (u > 0. && u < 1.) {
+      for (d=0; d<num_dim; ++d)
+	end[d] = x_i[d] + u * (end[d] - x_i[d]);
+      neighbor = j;
+    }
+  }
+  return neighbor;
+}
+
+}
+
+
+/** Nearest neighbor, k-nearest and ball queries match a scan over all
+    points, including incremental insertion between queries */
+BOOST_AUTO_TEST_CASE(test_spatial_index_neighbors)
+{
+  const size_t num_pts = 2000, num_queries = 200, k = 7;
+  const size_t dims[] = { 1, 2, 5, 12 };
+  for (size_t t=0; t<4; ++t) {
+    size_t num_dim = dims[t];
+    RealArray points = uniform_points(num_pts, num_dim, 11 + t),
+      queries = uniform_points(num_queries, num_dim, 97 + t);
+    SpatialIndex index(num_dim);
+    for (size_t q=0; q<num_queries; ++q) {
+      // grow the index between queries
+      size_t num_inserted = (q + 1) * num_pts / num_queries;
+      while (index.size() < num_inserted)
+	index.insert(&points[index.size()*num_dim]);
+      const Real* x = &queries[q*num_dim];
+
+      RealArray ref_dists(num_inserted);
+      size_t i, ref_nearest = 0;
+      for (i=0; i<num_inserted; ++i) {
+	ref_dists[i] = brute_distance_sq(x, &points[i*num_dim], num_dim);
+	if (ref_dists[i] < ref_dists[ref_nearest])
+	  ref_nearest = i;
+      }
+
+      Real dist_sq;
+      BOOST_CHECK_EQUAL(index.nearest(x, dist_sq), ref_nearest);
+      BOOST_CHECK_EQUAL(dist_sq, ref_dists[ref_nearest]);
+
+      SizetArray knn;  RealArray knn_dists;
+      index.nearest(x, k, knn, knn_dists);
+      RealArray sorted_dists(ref_dists);
+      std::sort(sorted_dists.begin(), sorted_dists.end());
+      BOOST_REQUIRE_EQUAL(knn.size(), k);
+      for (i=0; i<k; ++i) {
+	BOOST_CHECK_EQUAL(knn_dists[i], sorted_dists[i]);
+	BOOST_CHECK_EQUAL(ref_dists[knn[i]], knn_dists[i]);
+      }
+
+      Real r = 0.3;
+      SizetArray ball, ref_ball;
+      index.within(x, r, ball);
+      for (i=0; i<num_inserted; ++i)
+	if (ref_dists[i] < r*r)
+	  ref_ball.push_back(i);
+      BOOST_CHECK(ball == ref_ball);
+    }
+  }
+}
+
+
+/** A balanced build over points on a grid (sorted, with many tied
+    coordinates) answers queries as a scan does, and later incremental
+    insertions extend it */
+BOOST_AUTO_TEST_CASE(test_spatial_index_build)
+{
+  const size_t n_1d = 40, num_dim = 3, num_queries = 200;
+  RealArray grid;
+  for (size_t i=0; i<n_1d; ++i)
+    for (size_t j=0; j<n_1d; ++j)
+      for (size_t k=0; k<n_1d; ++k) {
+	grid.push_back((Real)i / n_1d);
+	grid.push_back((Real)j / n_1d);
+	grid.push_back((Real)k / n_1d);
+      }
+  RealArray extra = uniform_points(500, num_dim, 17),
+    queries = uniform_points(num_queries, num_dim, 18);
+  size_t num_grid = grid.size() / num_dim;
+
+  SpatialIndex index(num_dim);
+  index.build(&grid[0], num_grid);
+  BOOST_REQUIRE_EQUAL(index.size(), num_grid);
+  for (size_t i=0; i<500; ++i)
+    BOOST_CHECK_EQUAL(index.insert(&extra[i*num_dim]), num_grid + i);
+  grid.insert(grid.end(), extra.begin(), extra.end());
+
+  for (size_t q=0; q<num_queries; ++q) {
+    const Real* x = &queries[q*num_dim];
+    size_t i, ref_nearest = 0;
+    SizetArray ball, ref_ball;
+    RealArray ref_dists(index.size());
+    for (i=0; i<index.size(); ++i) {
+      ref_dists[i] = brute_distance_sq(x, &grid[i*num_dim], num_dim);
+      if (ref_dists[i] < ref_dists[ref_nearest])
+	ref_nearest = i;
+      if (ref_dists[i] < 0.01)
+	ref_ball.push_back(i);
+    }
+    Real dist_sq;
+    BOOST_CHECK_EQUAL(index.nearest(x, dist_sq), ref_nearest);
+    index.within(x, 0.1, ball);
+    BOOST_CHECK(ball == ref_ball);
+  }
+}
+
+
+/** Sphere coverage (in full and with one dimension excluded) and
+    sphere overlap match a scan over all points as radii grow and
+    shrink */
+BOOST_AUTO_TEST_CASE(test_spatial_index_spheres)
+{
+  const size_t num_pts = 3000, num_queries = 300, num_dim = 4;
+  RealArray points = uniform_points(num_pts, num_dim, 5),
+    queries = uniform_points(num_queries, num_dim, 6),
+    radii = uniform_points(2*num_pts, 1, 7);
+  SpatialIndex index(num_dim);
+  for (size_t i=0; i<num_pts; ++i) {
+    Real r = 0.05 * radii[i];
+    index.insert(&points[i*num_dim], r*r);
+  }
+
+  for (size_t pass=0; pass<2; ++pass) {
+    if (pass) // grow some spheres, shrink others
+      for (size_t i=0; i<num_pts; ++i) {
+	Real r = 0.1 * radii[num_pts + i];
+	index.radius_sq(i, r*r);
+      }
+
+    for (size_t q=0; q<num_queries; ++q) {
+      const Real* x = &queries[q*num_dim];
+      size_t excluded_dim = q % num_dim;
+      SizetArray ref_cover, ref_line, ref_overlap, found;
+      Real r = 0.02;
+      for (size_t i=0; i<num_pts; ++i) {
+	const Real* x_i = &points[i*num_dim];
+	Real r_sq = index.radius_sq(i);
+	if (brute_distance_sq(x, x_i, num_dim) < r_sq)
+	  ref_cover.push_back(i);
+	if (brute_distance_sq(x, x_i, num_dim, excluded_dim) < r_sq)
+	  ref_line.push_back(i);
+	if (r + std::sqrt(r_sq) > std::sqrt(brute_distance_sq(x, x_i, num_dim)))
+	  ref_overlap.push_back(i);
+      }
+
+      BOOST_CHECK_EQUAL(index.covered(x), !ref_cover.empty());
+      index.covering(x, found);
+      BOOST_CHECK(found == ref_cover);
+      BOOST_CHECK_EQUAL(index.covered(x, excluded_dim), !ref_line.empty());
+      index.covering(x, found, excluded_dim);
+      BOOST_CHECK(found == ref_line);
+      index.overlapping(x, r, found);
+      BOOST_CHECK(found == ref_overlap);
+    }
+  }
+}
+
+
+/** Trimming a spoke to the Voronoi cell of its origin matches trimming
+    against every bisector in turn */
+BOOST_AUTO_TEST_CASE(test_spatial_index_voronoi_trim)
+{
+  const size_t num_pts = 1500, num_spokes = 400;
+  const size_t dims[] = { 2, 3, 6 };
+  for (size_t t=0; t<3; ++t) {
+    size_t num_dim = dims[t];
+    RealArray points = uniform_points(num_pts, num_dim, 21 + t),
+      ends = uniform_points(num_spokes, num_dim, 31 + t);
+    SpatialIndex index(num_dim);
+    for (size_t i=0; i<num_pts; ++i)
+      index.insert(&points[i*num_dim]);
+
+    size_t num_trimmed = 0;
+    for (size_t s=0; s<num_spokes; ++s) {
+      size_t i = (s * 7919) % num_pts;
+      RealArray ref_end(&ends[s*num_dim], &ends[(s+1)*num_dim]),
+	end(ref_end);
+      size_t ref_neighbor = brute_trim(points, num_dim, i, &ref_end[0]),
+	neighbor = index.trim_to_voronoi_cell(i, &end[0]);
+      BOOST_CHECK_EQUAL(neighbor, ref_neighbor);
+      for (size_t d=0; d<num_dim; ++d)
+	BOOST_CHECK_SMALL(end[d] - ref_end[d], 1.e-12);
+      if (neighbor != i)
+	++num_trimmed;
+    }
+    BOOST_CHECK_GT(num_trimmed, num_spokes / 2);
+  }
+}
+
+
+namespace {
+
+/// POF darts on a Voronoi piecewise surrogate of smooth_herbie
+String pof_darts_input()
+{
+  return
+    "method \n"
+    "  pof_darts \n"
+    "    model_pointer 'SURR' \n"
+    "    build_samples 50 \n"
+    "    samples_on_emulator 1000 \n"
+    "    seed 8493 \n"
+    "    response_levels = -0.9 -0.8 -0.5 \n"
+    "  output silent \n"
+    "model \n"
+    "  id_model 'SURR' \n"
+    "  surrogate global \n"
+    "    truth_model_pointer 'TRUTH' \n"
+    "    polynomial linear \n"
+    "    domain_decomposition \n"
+    "model \n"
+    "  id_model 'TRUTH' \n"
+    "  single \n"
+    "variables \n"
+    "  uniform_uncertain 2 \n"
+    "    lower_bounds -2.0 -2.0 \n"
+    "    upper_bounds  2.0  2.0 \n"
+    "interface \n"
+    "  direct \n"
+    "    analysis_drivers = 'smooth_herbie' \n"
+    "  deactivate evaluation_cache restart_file \n"
+    "responses \n"
+    "  objective_functions = 1 \n"
+    "  no_gradients \n"
+    "  no_hessians \n";
+}
+
+/// run the POF darts study, returning the number of truth evaluations and
+/// the resulting surrogate values at num_pts fixed points
+void run_pof_darts(bool brute_force, int& num_truth_evals, RealVector& vals)
+{
+  const int num_pts = 200;
+
+  NonDPOFDarts::brute_force_queries(brute_force);
+  VPSApproximation::brute_force_queries(brute_force);
+  std::shared_ptr<LibraryEnvironment> env(Opt_TPL_Test::create_env(
+    pof_darts_input()));
+  env->execute();
+  NonDPOFDarts::brute_force_queries(false);
+  VPSApproximation::brute_force_queries(false);
+
+  ModelList models = env->filtered_model_list("surrogate", "", "");
+  BOOST_REQUIRE_EQUAL(models.size(), 1);
+  Model& model = models.front();
+  num_truth_evals = model.truth_model().evaluation_id();
+
+  RealArray points = uniform_points(num_pts, 2, 42);
+  model.surrogate_response_mode(UNCORRECTED_SURROGATE);
+  vals.sizeUninitialized(num_pts);
+  for (int j=0; j<num_pts; ++j) {
+    for (size_t i=0; i<2; ++i)
+      model.continuous_variable(4.*points[2*j+i] - 2., i);
+    model.evaluate();
+    vals[j] = model.current_response().function_value(0);
+  }
+}
+
+}
+
+/// a POF darts study gives the same samples and surrogate whether the
+/// darts and VPS neighbor queries use the spatial index or scan all points
+BOOST_AUTO_TEST_CASE(test_spatial_index_pof_darts_brute_force)
+{
+  int indexed_evals, brute_evals;
+  RealVector indexed_vals, brute_vals;
+  run_pof_darts(false, indexed_evals, indexed_vals);
+  run_pof_darts(true,  brute_evals,   brute_vals);
+
+  BOOST_CHECK(indexed_evals > 0);
+  BOOST_CHECK_EQUAL(indexed_evals, brute_evals);
+  BOOST_REQUIRE_EQUAL(indexed_vals.length(), brute_vals.length());
+  for (int j=0; j<indexed_vals.length(); ++j)
+    BOOST_CHECK_SMALL(indexed_vals[j] - brute_vals[j],
+		      1.e-12 * (1. + std::abs(brute_vals[j])));
+}
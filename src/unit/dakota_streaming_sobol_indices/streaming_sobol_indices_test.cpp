@@ -0,0 +1,220 @@
+/*  _______________________________________________________________________
+
+    Dakota: Explore and predict with confidence.
+    Copyright 2014-2023
+    National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Dakota directory.
+    _______________________________________________________________________ */
+
+#include "StreamingSobolIndices.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_real_distribution.hpp>
+
+#define BOOST_TEST_MODULE dakota_streaming_sobol_indices_test
+#include <boost/test/included/unit_test.hpp>
+
+using namespace Dakota;
+
+namespace {
+
+const Real PI = 3.14159265358979323846;
+
+/// Ishigami function values (a = 7, b = 0.1) for the first three
+/// inputs; any further inputs are inert.  Function k is offset by
+/// k * offset.
+void ishigami(const Real* x, size_t num_fns, Real offset, Real* f)
+{
+  Real val = std::sin(x[0]) + 7. * std::sin(x[1]) * std::sin(x[1])
+    + 0.1 * std::pow(x[2], 4) * std::sin(x[0]);
+  for (size_t k=0; k<num_fns; ++k)
+    f[k] = (k % 2) ? k * offset - 2. * val : k * offset + val;
+}
+
+/// function values of a pick-and-freeze design on [-pi, pi]^num_vars,
+/// num_fns per evaluation, in the order of
+/// Analyzer::get_vbd_parameter_sets(): A, B, then B with input i from A
+RealArray pick_freeze_values(size_t num_vars, size_t num_samples,
+			     size_t num_fns, Real offset, unsigned int seed)
+{
+  boost::mt19937 rng(seed);
+  boost::random::uniform_real_distribution<> uniform(-PI, PI);
+  RealArray A(num_samples * num_vars), B(num_samples * num_vars),
+    x(num_vars), vals((num_vars + 2) * num_samples * num_fns);
+  for (size_t j=0; j<num_samples * num_vars; ++j)
+    A[j] = uniform(rng);
+  for (size_t j=0; j<num_samples * num_vars; ++j)
+    B[j] = uniform(rng);
+  for (size_t r=0; r<num_vars + 2; ++r)
+    for (size_t j=0; j<num_samples; ++j) {
+      const Real* base = (r == 0) ? &A[j * num_vars] : &B[j * num_vars];
+      std::copy(base, base + num_vars, x.begin());
+      if (r >= 2)
+	x[r-2] = A[j * num_vars + r-2];
+      ishigami(&x[0], num_fns, offset,
+	       &vals[(r * num_samples + j) * num_fns]);
+    }
+  return vals;
+}
+
+/// the estimators as previously computed by SensAnalysisGlobal, from
+/// all function values held at once
+void reference_indices(const RealArray& vals, size_t num_vars,
+		       size_t num_samples, size_t num_fns,
+		       RealVectorArray& main, RealVectorArray& total)
+{
+  main.assign(num_fns, RealVector(num_vars));
+  total.assign(num_fns, RealVector(num_vars));
+  Real ns = (Real)num_samples;
+  for (size_t k=0; k<num_fns; ++k) {
+    RealArray y((num_vars + 2) * num_samples);
+    for (size_t e=0; e<y.size(); ++e)
+      y[e] = vals[e * num_fns + k];
+    const Real *ya = &y[0], *yb = &y[num_samples];
+    Real mean_A = 0., mean_B = 0., overall_mean = 0., var = 0.;
+    for (size_t j=0; j<num_samples; ++j)
+      { mean_A += ya[j]; mean_B += yb[j]; }
+    for (size_t e=0; e<y.size(); ++e)
+      overall_mean += y[e];
+    overall_mean /= (Real)y.size();
+    Real mean_C = (mean_A / ns + mean_B / ns) / 2.;
+    for (size_t j=0; j<num_samples; ++j)
+      var += ya[j] * ya[j] + yb[j] * yb[j];
+    var = var / (2. * ns) - mean_C * mean_C;
+    for (size_t i=0; i<num_vars; ++i) {
+      const Real* yab = &y[(i + 2) * num_samples];
+      Real sum_S = 0., sum_T = 0.;
+      for (size_t j=0; j<num_samples; ++j) {
+	Real diff = yab[j] - yb[j];
+	sum_S += (ya[j] - overall_mean) * diff;
+	sum_T += diff * diff;
+      }
+      main[k][i]  = (sum_S / ns) / var;
+      total[k][i] = (sum_T / (2. * ns)) / var;
+    }
+  }
+}
+
+/// accumulate vals in chunks of chunk_evals evaluations (one at a time
+/// through update(const Real*) when chunk_evals is 1)
+void accumulate(StreamingSobolIndices& sobol, const RealArray& vals,
+		size_t num_evals, size_t chunk_evals)
+{
+  size_t num_fns = sobol.num_functions();
+  for (size_t e=0; e<num_evals; e+=chunk_evals) {
+    if (chunk_evals == 1)
+      sobol.update(&vals[e * num_fns]);
+    else
+      sobol.update(&vals[e * num_fns], std::min(chunk_evals, num_evals - e));
+  }
+}
+
+Real max_difference(const RealVectorArray& a, const RealVectorArray& b)
+{
+  Real max_diff = 0.;
+  for (size_t k=0; k<a.size(); ++k)
+    for (int i=0; i<a[k].length(); ++i)
+      max_diff = std::max(max_diff, std::abs(a[k][i] - b[k][i]));
+  return max_diff;
+}
+
+}
+
+
+/** Indices accumulated one evaluation at a time, in uneven chunks and
+    in whole replicates all match the estimators of the stored-sample
+    computation */
+BOOST_AUTO_TEST_CASE(test_streaming_sobol_matches_reference)
+{
+  size_t num_vars = 4, num_samples = 5000, num_fns = 3,
+    num_evals = (num_vars + 2) * num_samples;
+  RealArray vals = pick_freeze_values(num_vars, num_samples, num_fns, 3., 11);
+  RealVectorArray ref_main, ref_total;
+  reference_indices(vals, num_vars, num_samples, num_fns, ref_main, ref_total);
+
+  const size_t chunks[] = { 1, 37, num_samples, num_evals };
+  for (size_t c=0; c<4; ++c) {
+    StreamingSobolIndices sobol;
+    sobol.initialize(num_fns, num_vars, num_samples);
+    accumulate(sobol, vals, num_evals, chunks[c]);
+    BOOST_CHECK(sobol.complete());
+    RealVectorArray main, total;
+    sobol.indices(main, total);
+    BOOST_CHECK_SMALL(max_difference(main, ref_main), 1.e-11);
+    BOOST_CHECK_SMALL(max_difference(total, ref_total), 1.e-11);
+  }
+
+  // Ishigami: S = (0.3139, 0.4424, 0, 0), T = (0.5576, 0.4424, 0.2437, 0)
+  BOOST_CHECK_SMALL(ref_main[0][0] - 0.3139, 0.05);
+  BOOST_CHECK_SMALL(ref_main[0][1] - 0.4424, 0.05);
+  BOOST_CHECK_SMALL(ref_total[0][2] - 0.2437, 0.05);
+  BOOST_CHECK_SMALL(ref_total[0][3], 1.e-14);
+}
+
+
+/** Sums about a shift retain the indices of responses far from the
+    origin, which are unchanged by the offset */
+BOOST_AUTO_TEST_CASE(test_streaming_sobol_offset)
+{
+  size_t num_vars = 3, num_samples = 2000, num_fns = 2,
+    num_evals = (num_vars + 2) * num_samples;
+  RealArray vals = pick_freeze_values(num_vars, num_samples, num_fns, 0., 5),
+    offset_vals = vals;
+  for (size_t e=0; e<num_evals * num_fns; ++e)
+    offset_vals[e] += 1.e7;
+
+  RealVectorArray ref_main, ref_total, main, total;
+  reference_indices(vals, num_vars, num_samples, num_fns, ref_main, ref_total);
+  StreamingSobolIndices sobol;
+  sobol.initialize(num_fns, num_vars, num_samples);
+  accumulate(sobol, offset_vals, num_evals, 1);
+  sobol.indices(main, total);
+  BOOST_CHECK_SMALL(max_difference(main, ref_main), 1.e-7);
+  BOOST_CHECK_SMALL(max_difference(total, ref_total), 1.e-7);
+}
+
+
+/** Bootstrap intervals are reproducible, independent of how the
+    evaluations are chunked, bracket the estimates and narrow as the
+    number of samples grows */
+BOOST_AUTO_TEST_CASE(test_streaming_sobol_bootstrap)
+{
+  size_t num_vars = 3, num_fns = 2, num_bootstrap = 200;
+  Real width[2] = { 0., 0. };
+  const size_t sizes[] = { 1000, 4000 };
+  for (size_t s=0; s<2; ++s) {
+    size_t num_samples = sizes[s], num_evals = (num_vars + 2) * num_samples;
+    RealArray vals = pick_freeze_values(num_vars, num_samples, num_fns, 1., 7);
+
+    RealVectorArray main, total, lower[2][2], upper[2][2];
+    for (size_t run=0; run<2; ++run) {
+      StreamingSobolIndices sobol;
+      sobol.initialize(num_fns, num_vars, num_samples, num_bootstrap, 17);
+      accumulate(sobol, vals, num_evals, (run) ? 1 : num_samples);
+      sobol.indices(main, total);
+      sobol.confidence_intervals(0.95, lower[run][0], upper[run][0],
+				 lower[run][1], upper[run][1]);
+    }
+    for (size_t m=0; m<2; ++m) {
+      BOOST_CHECK_SMALL(max_difference(lower[0][m], lower[1][m]), 1.e-12);
+      BOOST_CHECK_SMALL(max_difference(upper[0][m], upper[1][m]), 1.e-12);
+    }
+    for (size_t k=0; k<num_fns; ++k)
+      for (size_t i=0; i<num_vars; ++i) {
+	BOOST_CHECK(lower[0][0][k][i] <= main[k][i]);
+	BOOST_CHECK(main[k][i] <= upper[0][0][k][i]);
+	BOOST_CHECK(lower[0][1][k][i] <= total[k][i]);
+	BOOST_CHECK(total[k][i] <= upper[0][1][k][i]);
+	width[s] += upper[0][0][k][i] - lower[0][0][k][i]
+	  + upper[0][1][k][i] - lower[0][1][k][i];
+      }
+  }
+  // the widths scale as 1/sqrt(num_samples)
+  BOOST_CHECK(width[1] < 0.75 * width[0]);
+  BOOST_CHECK(width[1] > 0.25 * width[0]);
+}
+
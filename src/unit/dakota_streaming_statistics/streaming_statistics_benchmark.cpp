@@ -0,0 +1,74 @@
+/*  _______________________________________________________________________
+
+    Dakota: Explore and predict with confidence.
+    Copyright 2014-2023
+    National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Dakota directory.
+    _______________________________________________________________________ */
+
+#include "opt_tpl_test.hpp"
+
+#include <chrono>
+#include <iostream>
+
+#define BOOST_TEST_MODULE dakota_streaming_statistics_benchmark
+#include <boost/test/included/unit_test.hpp>
+
+using namespace Dakota;
+
+namespace {
+
+/// sampling study on rosenbrock with level mappings, optionally streamed
+String sampling_input(int num_samples, const String& streaming)
+{
+  return
+    "environment \n"
+    "method \n"
+    "  sampling \n"
+    "    samples " + std::to_string(num_samples) + " \n"
+    "    seed 1234 \n"
+    "    response_levels = 1. 10. 100. 1000. \n"
+    "    probability_levels = 0.05 0.25 0.5 0.75 0.95 \n"
+    "    " + streaming + " \n"
+    "    output silent \n"
+    "variables \n"
+    "  uniform_uncertain 2 \n"
+    "    lower_bounds -2.0 -2.0 \n"
+    "    upper_bounds  2.0  2.0 \n"
+    "interface \n"
+    "  direct \n"
+    "    analysis_drivers = 'rosenbrock' \n"
+    "  deactivate evaluation_cache restart_file \n"
+    "responses \n"
+    "  response_functions = 1 \n"
+    "  no_gradients \n"
+    "  no_hessians \n";
+}
+
+}
+
+
+/** Sampling statistics stored, streamed with a sketch retaining every
+    sample, and streamed with the default sketch */
+BOOST_AUTO_TEST_CASE(test_streaming_statistics_sampling_time)
+{
+  typedef std::chrono::steady_clock clock;
+  typedef std::chrono::duration<double> seconds;
+  const int num_samples = 100000;
+  const char* streaming[3] = { "",
+    "streaming_statistics sketch_size 131072", "streaming_statistics" };
+  const char* label[3] = { "stored", "streamed",
+    "streamed with default sketch" };
+
+  std::cout << "sampling statistics for " << num_samples << " samples:";
+  for (size_t s=0; s<3; ++s) {
+    std::shared_ptr<LibraryEnvironment> env(Opt_TPL_Test::create_env(
+      sampling_input(num_samples, streaming[s])));
+    clock::time_point t0 = clock::now();
+    env->execute();
+    std::cout << ((s) ? ", " : " ") << label[s] << ' '
+	      << seconds(clock::now() - t0).count() << " s";
+  }
+  std::cout << std::endl;
+}
@@ -0,0 +1,244 @@
+/*  _______________________________________________________________________
+
+    Dakota: Explore and predict with confidence.
+    Copyright 2014-2023
+    National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Dakota directory.
+    _______________________________________________________________________ */
+
+#include "StreamingStatistics.hpp"
+#include "opt_tpl_test.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include <boost/random/lognormal_distribution.hpp>
+#include <boost/random/variate_generator.hpp>
+
+#define BOOST_TEST_MODULE dakota_streaming_statistics_test
+#include <boost/test/included/unit_test.hpp>
+
+using namespace Dakota;
+
+namespace {
+
+/// lognormal samples shifted far from the origin, which defeats naive
+/// accumulation of raw power sums
+RealArray lognormal_samples(size_t num_samples, Real shift, unsigned int seed)
+{
+  boost::mt19937 rng(seed);
+  boost::lognormal_distribution<> lognormal(1., 0.75);
+  boost::variate_generator<boost::mt19937&, boost::lognormal_distribution<> >
+    sampler(rng, lognormal);
+  RealArray samples(num_samples);
+  for (size_t i=0; i<num_samples; ++i)
+    samples[i] = shift + sampler();
+  return samples;
+}
+
+/// two-pass reference: mean, std deviation, skewness, excess kurtosis
+void two_pass_moments(const RealArray& x, Real* moments)
+{
+  Real ns = (Real)x.size(), mean = 0., s2 = 0., s3 = 0., s4 = 0.;
+  for (size_t i=0; i<x.size(); ++i)
+    mean += x[i];
+  mean /= ns;
+  for (size_t i=0; i<x.size(); ++i) {
+    Real d = x[i] - mean, d2 = d*d;
+    s2 += d2; s3 += d2*d; s4 += d2*d2;
+  }
+  moments[0] = mean;
+  moments[1] = std::sqrt(s2/(ns-1.));
+  moments[2] = s3/ns/std::pow(s2/ns, 1.5) * std::sqrt(ns*(ns-1.))/(ns-2.);
+  moments[3] = (ns-1.)/((ns-2.)*(ns-3.)) * ((ns+1.)*ns*s4/(s2*s2) - 3.*(ns-1.));
+}
+
+/// smallest and largest ranks (1-based) at which value appears in sorted
+void rank_range(const RealArray& sorted, Real value, size_t& lo, size_t& hi)
+{
+  lo = std::lower_bound(sorted.begin(), sorted.end(), value)
+     - sorted.begin() + 1;
+  hi = std::upper_bound(sorted.begin(), sorted.end(), value) - sorted.begin();
+}
+
+/// sampling study on rosenbrock with level mappings, optionally streamed
+String sampling_input(int num_samples, const String& streaming)
+{
+  return
+    "environment \n"
+    "method \n"
+    "  sampling \n"
+    "    samples " + std::to_string(num_samples) + " \n"
+    "    seed 1234 \n"
+    "    response_levels = 1. 10. 100. 1000. \n"
+    "    probability_levels = 0.05 0.25 0.5 0.75 0.95 \n"
+    "    " + streaming + " \n"
+    "    output silent \n"
+    "variables \n"
+    "  uniform_uncertain 2 \n"
+    "    lower_bounds -2.0 -2.0 \n"
+    "    upper_bounds  2.0  2.0 \n"
+    "interface \n"
+    "  direct \n"
+    "    analysis_drivers = 'rosenbrock' \n"
+    "  deactivate evaluation_cache restart_file \n"
+    "responses \n"
+    "  response_functions = 1 \n"
+    "  no_gradients \n"
+    "  no_hessians \n";
+}
+
+}
+
+
+/** Single-pass moments match a two-pass computation */
+BOOST_AUTO_TEST_CASE(test_streaming_statistics_moments)
+{
+  RealArray x = lognormal_samples(200000, 1.e6, 1234);
+  RealVectorArray no_bins(1);
+  BoolDeque no_sketch(1, false);
+  StreamingStatistics stats;
+  stats.initialize(1, no_bins, no_sketch);
+  for (size_t i=0; i<x.size(); ++i)
+    stats.update(&x[i]);
+
+  Real ref[4], streamed[4];
+  two_pass_moments(x, ref);
+  stats.moments(0, false, streamed);
+  BOOST_CHECK_EQUAL(stats.count(0), x.size());
+  for (size_t j=0; j<4; ++j)
+    BOOST_CHECK_CLOSE(streamed[j], ref[j], 1.e-6);
+
+  // central moments are consistent with the standardized moments
+  Real central[4];
+  stats.moments(0, true, central);
+  BOOST_CHECK_CLOSE(central[0], ref[0], 1.e-10);
+  BOOST_CHECK_CLOSE(central[1], ref[1]*ref[1], 1.e-6);
+
+  BOOST_CHECK_EQUAL(stats.minimum(0), *std::min_element(x.begin(), x.end()));
+  BOOST_CHECK_EQUAL(stats.maximum(0), *std::max_element(x.begin(), x.end()));
+}
+
+
+/** Merging partial accumulations reproduces the single stream, and
+    non-finite values are omitted as failures */
+BOOST_AUTO_TEST_CASE(test_streaming_statistics_merge_and_bins)
+{
+  const size_t num_samples = 50000, num_parts = 4;
+  RealArray x = lognormal_samples(num_samples, 0., 99);
+  x[17] = std::numeric_limits<Real>::quiet_NaN();
+  x[4242] = std::numeric_limits<Real>::infinity();
+
+  RealVectorArray levels(1, RealVector(3));
+  levels[0][0] = 1.; levels[0][1] = 3.; levels[0][2] = 10.;
+  BoolDeque sketch(1, true);
+
+  StreamingStatistics whole, parts[num_parts];
+  whole.initialize(1, levels, sketch, 1024);
+  for (size_t p=0; p<num_parts; ++p)
+    parts[p].initialize(1, levels, sketch, 1024, p+2);
+  for (size_t i=0; i<num_samples; ++i) {
+    whole.update(&x[i]);
+    parts[i % num_parts].update(&x[i]);
+  }
+  for (size_t p=1; p<num_parts; ++p)
+    parts[0].merge(parts[p]);
+
+  BOOST_CHECK_EQUAL(whole.num_observations(), num_samples);
+  BOOST_CHECK_EQUAL(whole.count(0), num_samples - 2);
+  BOOST_CHECK_EQUAL(parts[0].count(0), whole.count(0));
+
+  Real whole_mom[4], merged_mom[4];
+  whole.moments(0, false, whole_mom);
+  parts[0].moments(0, false, merged_mom);
+  for (size_t j=0; j<4; ++j)
+    BOOST_CHECK_CLOSE(merged_mom[j], whole_mom[j], 1.e-9);
+
+  // bins are exact: first level at or above each finite sample
+  SizetArray ref_bins(4, 0);
+  for (size_t i=0; i<num_samples; ++i)
+    if (std::isfinite(x[i]))
+      ++ref_bins[(x[i] <= 1.) ? 0 : (x[i] <= 3.) ? 1 : (x[i] <= 10.) ? 2 : 3];
+  BOOST_CHECK(whole.bins(0) == ref_bins);
+  BOOST_CHECK(parts[0].bins(0) == ref_bins);
+
+  // both sketches honor their rank error bounds
+  RealArray sorted;
+  for (size_t i=0; i<num_samples; ++i)
+    if (std::isfinite(x[i]))
+      sorted.push_back(x[i]);
+  std::sort(sorted.begin(), sorted.end());
+  const StreamingStatistics* sketched[2] = { &whole, &parts[0] };
+  for (size_t s=0; s<2; ++s)
+    for (size_t r=1; r<=sorted.size(); r+=101) {
+      size_t lo, hi, bound = sketched[s]->rank_error_bound(0);
+      rank_range(sorted, sketched[s]->order_statistic(0, r), lo, hi);
+      BOOST_CHECK(r + bound >= lo && r <= hi + bound);
+    }
+}
+
+
+/** The sketch is exact below capacity and otherwise bounded, with
+    memory growing logarithmically in the number of samples */
+BOOST_AUTO_TEST_CASE(test_quantile_sketch_accuracy)
+{
+  RealArray x = lognormal_samples(1000000, 0., 7);
+
+  QuantileSketch small(4096);
+  for (size_t i=0; i<4000; ++i)
+    small.insert(x[i]);
+  RealArray sorted(x.begin(), x.begin() + 4000);
+  std::sort(sorted.begin(), sorted.end());
+  BOOST_CHECK(small.exact());
+  for (size_t r=1; r<=sorted.size(); ++r)
+    BOOST_CHECK_EQUAL(small.order_statistic(r), sorted[r-1]);
+
+  QuantileSketch large(4096);
+  for (size_t i=0; i<x.size(); ++i)
+    large.insert(x[i]);
+  sorted = x;
+  std::sort(sorted.begin(), sorted.end());
+
+  size_t r, lo, hi, bound = large.rank_error_bound(), max_error = 0;
+  for (r=1; r<=sorted.size(); r+=997) {
+    rank_range(sorted, large.order_statistic(r), lo, hi);
+    BOOST_CHECK(r + bound >= lo && r <= hi + bound);
+    max_error = std::max(max_error, (r < lo) ? lo - r : (r > hi) ? r - hi : 0);
+  }
+  // guaranteed probability error for the default sketch size
+  BOOST_CHECK_LT((Real)bound / (Real)x.size(), 0.005);
+  BOOST_CHECK_LT(large.num_retained(), 20*4096);
+  BOOST_TEST_MESSAGE("quantile sketch: " << large.num_retained()
+    << " items retained for " << x.size() << " samples; rank error "
+    << max_error << " observed, " << bound << " guaranteed");
+}
+
+
+/** Streamed sampling statistics reproduce the stored-sample path */
+BOOST_AUTO_TEST_CASE(test_streaming_statistics_sampling)
+{
+  const int num_samples = 2000;
+
+  std::shared_ptr<LibraryEnvironment> exact_env(Opt_TPL_Test::create_env(
+    sampling_input(num_samples, "")));
+  exact_env->execute();
+
+  // a sketch larger than the sample retains every sample: exact quantiles
+  std::shared_ptr<LibraryEnvironment> stream_env(Opt_TPL_Test::create_env(
+    sampling_input(num_samples, "streaming_statistics sketch_size 4096")));
+  stream_env->execute();
+
+  // mean, std deviation, 4 probabilities, 5 response levels
+  const RealVector& exact_stats
+    = exact_env->response_results().function_values();
+  const RealVector& stream_stats
+    = stream_env->response_results().function_values();
+  BOOST_REQUIRE_EQUAL(exact_stats.length(), 11);
+  BOOST_REQUIRE_EQUAL(stream_stats.length(), exact_stats.length());
+  for (int i=0; i<2; ++i)
+    BOOST_CHECK_CLOSE(stream_stats[i], exact_stats[i], 1.e-8);
+  for (int i=2; i<exact_stats.length(); ++i)
+    BOOST_CHECK_EQUAL(stream_stats[i], exact_stats[i]);
+}
@@ -0,0 +1,135 @@
+/*  _______________________________________________________________________
+
+    Dakota: Explore and predict with confidence.
+    Copyright 2014-2023
+    National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Dakota directory.
+    _______________________________________________________________________ */
+
+#include "opt_tpl_test.hpp"
+
+#include <chrono>
+#include <iostream>
+
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_real_distribution.hpp>
+
+#define BOOST_TEST_MODULE dakota_surr_batch_eval_benchmark
+#include <boost/test/included/unit_test.hpp>
+
+using namespace Dakota;
+
+namespace {
+
+/// sampling on a surrogate of rosenbrock built from an LHS design;
+/// export_option disables the batch path when non-empty
+String surrogate_input(const String& surrogate, const String& export_option)
+{
+  return
+    "environment \n"
+    "  method_pointer 'SampleSurrogate' \n"
+    "method \n"
+    "  id_method 'SampleSurrogate' \n"
+    "  model_pointer 'SurrogateModel' \n"
+    "  sampling \n"
+    "    samples 5000 \n"
+    "    seed 1234 \n"
+    "    response_levels = 1. 10. 100. \n"
+    "  output silent \n"
+    "model \n"
+    "  id_model 'SurrogateModel' \n"
+    "  surrogate \n"
+    "    global \n"
+    "      truth_model_pointer 'SimulationModel' \n"
+    "      dace_method_pointer 'BuildDesign' \n"
+    "      " + surrogate + " \n"
+    "      " + export_option + " \n"
+    "method \n"
+    "  id_method 'BuildDesign' \n"
+    "  model_pointer 'SimulationModel' \n"
+    "  sampling \n"
+    "    samples 60 \n"
+    "    seed 5678 \n"
+    "  output silent \n"
+    "model \n"
+    "  id_model 'SimulationModel' \n"
+    "  single \n"
+    "variables \n"
+    "  uniform_uncertain 2 \n"
+    "    lower_bounds -2.0 -2.0 \n"
+    "    upper_bounds  2.0  2.0 \n"
+    "interface \n"
+    "  direct \n"
+    "    analysis_drivers = 'rosenbrock' \n"
+    "  deactivate evaluation_cache restart_file \n"
+    "responses \n"
+    "  response_functions = 1 \n"
+    "  analytic_gradients \n"
+    "  no_hessians \n";
+}
+
+/// uniform points on [-2,2]^2, one per column
+RealMatrix uniform_points(int num_pts, unsigned int seed)
+{
+  boost::mt19937 rng(seed);
+  boost::random::uniform_real_distribution<> uniform(-2., 2.);
+  RealMatrix points(2, num_pts);
+  for (int j=0; j<num_pts; ++j)
+    for (int i=0; i<2; ++i)
+      points(i, j) = uniform(rng);
+  return points;
+}
+
+/// samples/second evaluating values and gradients per point and batched
+void time_batch_evaluation(const String& surrogate)
+{
+  typedef std::chrono::steady_clock clock;
+  typedef std::chrono::duration<double> seconds;
+  const int num_pts = 20000;
+
+  std::shared_ptr<LibraryEnvironment> env(Opt_TPL_Test::create_env(
+    surrogate_input(surrogate, "")));
+  env->execute(); // builds the surrogate
+  ModelList models = env->filtered_model_list("surrogate", "", "");
+  BOOST_REQUIRE_EQUAL(models.size(), 1);
+  Model& model = models.front();
+
+  ActiveSet set = model.current_response().active_set();
+  set.request_values(3);
+  BOOST_REQUIRE(model.batch_evaluation_available(set));
+
+  RealMatrix points = uniform_points(num_pts, 42);
+  clock::time_point t0 = clock::now();
+  for (int j=0; j<num_pts; ++j) {
+    model.continuous_variables(
+      Teuchos::getCol(Teuchos::View, points, j));
+    model.evaluate(set);
+  }
+  clock::time_point t1 = clock::now();
+
+  RealMatrix batch_vals;  RealMatrixArray batch_grads;
+  clock::time_point t2 = clock::now();
+  model.evaluate_batch(points, set, batch_vals, batch_grads);
+  clock::time_point t3 = clock::now();
+
+  double point_time = seconds(t1 - t0).count(),
+    batch_time = seconds(t3 - t2).count();
+  std::cout << surrogate << ": " << num_pts / point_time
+	    << " samples/s per point, " << num_pts / batch_time
+	    << " samples/s batched (values and gradients)" << std::endl;
+}
+
+}
+
+
+BOOST_AUTO_TEST_CASE(test_surr_batch_eval_gauss_proc_throughput)
+{
+  time_batch_evaluation("experimental_gaussian_process trend constant");
+}
+
+
+BOOST_AUTO_TEST_CASE(test_surr_batch_eval_polynomial_throughput)
+{
+  time_batch_evaluation("experimental_polynomial basis_order 3");
+}
@@ -0,0 +1,177 @@
+/*  _______________________________________________________________________
+
+    Dakota: Explore and predict with confidence.
+    Copyright 2014-2023
+    National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Dakota directory.
+    _______________________________________________________________________ */
+
+#include "opt_tpl_test.hpp"
+
+#include <cmath>
+
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_real_distribution.hpp>
+
+#define BOOST_TEST_MODULE dakota_surr_batch_eval_test
+#include <boost/test/included/unit_test.hpp>
+
+using namespace Dakota;
+
+namespace {
+
+/// sampling on a surrogate of rosenbrock built from an LHS design;
+/// export_option disables the batch path when non-empty
+String surrogate_input(const String& surrogate, const String& export_option)
+{
+  return
+    "environment \n"
+    "  method_pointer 'SampleSurrogate' \n"
+    "method \n"
+    "  id_method 'SampleSurrogate' \n"
+    "  model_pointer 'SurrogateModel' \n"
+    "  sampling \n"
+    "    samples 5000 \n"
+    "    seed 1234 \n"
+    "    response_levels = 1. 10. 100. \n"
+    "  output silent \n"
+    "model \n"
+    "  id_model 'SurrogateModel' \n"
+    "  surrogate \n"
+    "    global \n"
+    "      truth_model_pointer 'SimulationModel' \n"
+    "      dace_method_pointer 'BuildDesign' \n"
+    "      " + surrogate + " \n"
+    "      " + export_option + " \n"
+    "method \n"
+    "  id_method 'BuildDesign' \n"
+    "  model_pointer 'SimulationModel' \n"
+    "  sampling \n"
+    "    samples 60 \n"
+    "    seed 5678 \n"
+    "  output silent \n"
+    "model \n"
+    "  id_model 'SimulationModel' \n"
+    "  single \n"
+    "variables \n"
+    "  uniform_uncertain 2 \n"
+    "    lower_bounds -2.0 -2.0 \n"
+    "    upper_bounds  2.0  2.0 \n"
+    "interface \n"
+    "  direct \n"
+    "    analysis_drivers = 'rosenbrock' \n"
+    "  deactivate evaluation_cache restart_file \n"
+    "responses \n"
+    "  response_functions = 1 \n"
+    "  analytic_gradients \n"
+    "  no_hessians \n";
+}
+
+/// uniform points on [-2,2]^2, one per column
+RealMatrix uniform_points(int num_pts, unsigned int seed)
+{
+  boost::mt19937 rng(seed);
+  boost::random::uniform_real_distribution<> uniform(-2., 2.);
+  RealMatrix points(2, num_pts);
+  for (int j=0; j<num_pts; ++j)
+    for (int i=0; i<2; ++i)
+      points(i, j) = uniform(rng);
+  return points;
+}
+
+/// batch evaluation of values and gradients reproduces evaluate() per
+/// point and advances the evaluation counter by the batch size
+void check_batch_evaluation(const String& surrogate)
+{
+  const int num_pts = 500;
+
+  std::shared_ptr<LibraryEnvironment> env(Opt_TPL_Test::create_env(
+    surrogate_input(surrogate, "")));
+  env->execute(); // builds the surrogate
+  ModelList models = env->filtered_model_list("surrogate", "", "");
+  BOOST_REQUIRE_EQUAL(models.size(), 1);
+  Model& model = models.front();
+
+  ActiveSet set = model.current_response().active_set();
+  set.request_values(3);
+  BOOST_REQUIRE(model.batch_evaluation_available(set));
+
+  RealMatrix points = uniform_points(num_pts, 42);
+  RealVector point_vals(num_pts);
+  RealMatrix point_grads(2, num_pts);
+  for (int j=0; j<num_pts; ++j) {
+    model.continuous_variables(
+      Teuchos::getCol(Teuchos::View, points, j));
+    model.evaluate(set);
+    const Response& resp = model.current_response();
+    point_vals[j] = resp.function_value(0);
+    for (int i=0; i<2; ++i)
+      point_grads(i, j) = resp.function_gradient_view(0)[i];
+  }
+
+  int eval_id = model.evaluation_id();
+  RealMatrix batch_vals;  RealMatrixArray batch_grads;
+  model.evaluate_batch(points, set, batch_vals, batch_grads);
+
+  BOOST_CHECK_EQUAL(model.evaluation_id(), eval_id + num_pts);
+  BOOST_REQUIRE_EQUAL(batch_vals.numRows(), 1);
+  BOOST_REQUIRE_EQUAL(batch_vals.numCols(), num_pts);
+  BOOST_REQUIRE_EQUAL(batch_grads.size(), 1);
+  for (int j=0; j<num_pts; ++j) {
+    BOOST_CHECK_SMALL(batch_vals(0, j) - point_vals[j],
+		      1.e-10 * (1. + std::abs(point_vals[j])));
+    for (int i=0; i<2; ++i)
+      BOOST_CHECK_SMALL(batch_grads[0](i, j) - point_grads(i, j),
+			1.e-10 * (1. + std::abs(point_grads(i, j))));
+  }
+  // model state reflects the last point, as after per-point evaluation
+  BOOST_CHECK_EQUAL(model.continuous_variable(0), points(0, num_pts-1));
+  BOOST_CHECK_EQUAL(model.current_response().function_value(0),
+		    batch_vals(0, num_pts-1));
+
+  // bulk evaluation of values uses the batch path
+  RealMatrix resp_matrix;
+  Model::evaluate(points, model, resp_matrix);
+  BOOST_CHECK_EQUAL(model.evaluation_id(), eval_id + 2*num_pts);
+  for (int j=0; j<num_pts; ++j)
+    BOOST_CHECK_SMALL(resp_matrix(0, j) - point_vals[j],
+		      1.e-10 * (1. + std::abs(point_vals[j])));
+}
+
+}
+
+
+BOOST_AUTO_TEST_CASE(test_surr_batch_eval_gauss_proc)
+{
+  check_batch_evaluation("experimental_gaussian_process trend constant");
+}
+
+
+BOOST_AUTO_TEST_CASE(test_surr_batch_eval_polynomial)
+{
+  check_batch_evaluation("experimental_polynomial basis_order 3");
+}
+
+
+/** Sampling statistics on a surrogate are unchanged by the batch path;
+    exporting the surrogate evaluations forces per-point evaluation */
+BOOST_AUTO_TEST_CASE(test_surr_batch_eval_sampling)
+{
+  std::shared_ptr<LibraryEnvironment> batch_env(Opt_TPL_Test::create_env(
+    surrogate_input("experimental_polynomial basis_order 3", "")));
+  batch_env->execute();
+
+  std::shared_ptr<LibraryEnvironment> point_env(Opt_TPL_Test::create_env(
+    surrogate_input("experimental_polynomial basis_order 3",
+		    "export_approx_points_file 'surr_batch_eval_points.dat'")));
+  point_env->execute();
+
+  const RealVector& batch_stats
+    = batch_env->response_results().function_values();
+  const RealVector& point_stats
+    = point_env->response_results().function_values();
+  BOOST_REQUIRE_EQUAL(batch_stats.length(), point_stats.length());
+  for (int i=0; i<point_stats.length(); ++i)
+    BOOST_CHECK_CLOSE(batch_stats[i], point_stats[i], 1.e-8);
+}
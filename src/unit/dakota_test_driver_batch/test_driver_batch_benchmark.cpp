@@ -0,0 +1,93 @@
+/*  _______________________________________________________________________
+
+    Dakota: Explore and predict with confidence.
+    Copyright 2014-2023
+    National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Dakota directory.
+    _______________________________________________________________________ */
+
+#include "opt_tpl_test.hpp"
+
+#include <chrono>
+#include <iostream>
+
+#define BOOST_TEST_MODULE dakota_test_driver_batch_benchmark
+#include <boost/test/included/unit_test.hpp>
+
+using namespace Dakota;
+
+namespace {
+
+/// sampling study on a direct test driver, optionally in batch mode
+String sampling_input(const String& driver, size_t num_vars, size_t num_fns,
+		      int num_samples, int batch_size)
+{
+  String input =
+    "environment \n"
+    "method \n"
+    "  sampling \n"
+    "    samples " + std::to_string(num_samples) + " \n"
+    "    seed 5678 \n"
+    "    output silent \n"
+    "variables \n"
+    "  uniform_uncertain " + std::to_string(num_vars) + " \n"
+    "    lower_bounds " + std::to_string(num_vars) + "*-2.0 \n"
+    "    upper_bounds " + std::to_string(num_vars) + "*2.0 \n"
+    "interface \n"
+    "  direct \n"
+    "    analysis_drivers = '" + driver + "' \n";
+  if (batch_size > 1)
+    input += "  batch size " + std::to_string(batch_size) + " \n";
+  input +=
+    "responses \n"
+    "  response_functions = " + std::to_string(num_fns) + " \n"
+    "  no_gradients \n"
+    "  no_hessians \n";
+  return input;
+}
+
+}
+
+
+/** Batched direct evaluations reproduce the per-evaluation study;
+    throughput is reported */
+BOOST_AUTO_TEST_CASE(test_test_driver_batch_throughput)
+{
+  typedef std::chrono::steady_clock clock;
+  typedef std::chrono::duration<double> seconds;
+  const int num_samples = 20000;
+
+  struct Case { const char* driver; size_t num_vars, num_fns; };
+  const Case cases[] = { { "text_book",              2,  3 },
+			 { "generalized_rosenbrock", 20, 1 },
+			 { "extended_rosenbrock",    10, 10 },
+			 { "herbie",                 4,  1 } };
+
+  for (const Case& c : cases) {
+    std::shared_ptr<LibraryEnvironment> serial_env(Opt_TPL_Test::create_env(
+      sampling_input(c.driver, c.num_vars, c.num_fns, num_samples, 1)));
+    clock::time_point t0 = clock::now();
+    serial_env->execute();
+    clock::time_point t1 = clock::now();
+
+    std::shared_ptr<LibraryEnvironment> batch_env(Opt_TPL_Test::create_env(
+      sampling_input(c.driver, c.num_vars, c.num_fns, num_samples,
+		     1000)));
+    clock::time_point t2 = clock::now();
+    batch_env->execute();
+    clock::time_point t3 = clock::now();
+
+    const RealVector& serial_stats
+      = serial_env->response_results().function_values();
+    const RealVector& batch_stats
+      = batch_env->response_results().function_values();
+    BOOST_REQUIRE_EQUAL(serial_stats.length(), batch_stats.length());
+    for (int i=0; i<serial_stats.length(); ++i)
+      BOOST_CHECK_CLOSE(serial_stats[i], batch_stats[i], 1.e-10);
+
+    std::cout << c.driver << ": per-evaluation evals/s: "
+	      << num_samples / seconds(t1 - t0).count() << ", batch evals/s: "
+	      << num_samples / seconds(t3 - t2).count() << std::endl;
+  }
+}
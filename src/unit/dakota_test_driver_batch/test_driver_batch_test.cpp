@@ -0,0 +1,108 @@
+/*  _______________________________________________________________________
+
+    Dakota: Explore and predict with confidence.
+    Copyright 2014-2023
+    National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Dakota directory.
+    _______________________________________________________________________ */
+
+#include "TestDriverBatch.hpp"
+#include "opt_tpl_test.hpp"
+
+#define BOOST_TEST_MODULE dakota_test_driver_batch_test
+#include <boost/test/included/unit_test.hpp>
+
+using namespace Dakota;
+
+namespace {
+
+/// sampling study on a direct test driver, optionally in batch mode
+String sampling_input(const String& driver, size_t num_vars, size_t num_fns,
+		      int num_samples, int batch_size)
+{
+  String input =
+    "environment \n"
+    "method \n"
+    "  sampling \n"
+    "    samples " + std::to_string(num_samples) + " \n"
+    "    seed 5678 \n"
+    "    output silent \n"
+    "variables \n"
+    "  uniform_uncertain " + std::to_string(num_vars) + " \n"
+    "    lower_bounds " + std::to_string(num_vars) + "*-2.0 \n"
+    "    upper_bounds " + std::to_string(num_vars) + "*2.0 \n"
+    "interface \n"
+    "  direct \n"
+    "    analysis_drivers = '" + driver + "' \n";
+  if (batch_size > 1)
+    input += "  batch size " + std::to_string(batch_size) + " \n";
+  input +=
+    "responses \n"
+    "  response_functions = " + std::to_string(num_fns) + " \n"
+    "  no_gradients \n"
+    "  no_hessians \n";
+  return input;
+}
+
+}
+
+
+/** Kernels reproduce known values in structure-of-arrays layout */
+BOOST_AUTO_TEST_CASE(test_test_driver_batch_kernels)
+{
+  // two points: (1,1) and (0,2), stored by variable row
+  RealArray x = { 1., 0.,   1., 2. }, f(6);
+
+  BOOST_CHECK(TestDriverBatch::supported(GENERALIZED_ROSENBROCK, 2, 1));
+  BOOST_CHECK(!TestDriverBatch::supported(EXTENDED_ROSENBROCK, 3, 1));
+  BOOST_CHECK(!TestDriverBatch::supported(SOBOL_ISHIGAMI, 2, 1));
+
+  TestDriverBatch::evaluate(GENERALIZED_ROSENBROCK, 2, 2, &x[0], 1, &f[0]);
+  BOOST_CHECK_EQUAL(f[0], 0.);
+  BOOST_CHECK_EQUAL(f[1], 401.); // 100*(2-0)^2 + (1-0)^2
+
+  // least squares residuals: 10*(x2-x1^2), 1-x1
+  TestDriverBatch::evaluate(GENERALIZED_ROSENBROCK, 2, 2, &x[0], 2, &f[0]);
+  BOOST_CHECK_EQUAL(f[0], 0.);  BOOST_CHECK_EQUAL(f[1], 20.);
+  BOOST_CHECK_EQUAL(f[2], 0.);  BOOST_CHECK_EQUAL(f[3], 1.);
+
+  // text_book: f = sum (x_i-1)^4, c1 = x1^2 - x2/2, c2 = x2^2 - x1/2
+  TestDriverBatch::evaluate(TEXT_BOOK, 2, 2, &x[0], 3, &f[0]);
+  BOOST_CHECK_EQUAL(f[0], 0.);   BOOST_CHECK_EQUAL(f[1], 2.);
+  BOOST_CHECK_EQUAL(f[2], 0.5);  BOOST_CHECK_EQUAL(f[3], -1.);
+  BOOST_CHECK_EQUAL(f[4], 0.5);  BOOST_CHECK_EQUAL(f[5], 4.);
+}
+
+
+/** Batched direct evaluations reproduce the per-evaluation study,
+    including a final partial batch */
+BOOST_AUTO_TEST_CASE(test_test_driver_batch_sampling)
+{
+  const int num_samples = 200, batch_size = 64;
+
+  struct Case { const char* driver; size_t num_vars, num_fns; };
+  const Case cases[] = { { "text_book",              2,  3 },
+			 { "generalized_rosenbrock", 20, 1 },
+			 { "extended_rosenbrock",    10, 10 },
+			 { "herbie",                 4,  1 } };
+
+  for (const Case& c : cases) {
+    std::shared_ptr<LibraryEnvironment> serial_env(Opt_TPL_Test::create_env(
+      sampling_input(c.driver, c.num_vars, c.num_fns, num_samples, 1)));
+    serial_env->execute();
+
+    std::shared_ptr<LibraryEnvironment> batch_env(Opt_TPL_Test::create_env(
+      sampling_input(c.driver, c.num_vars, c.num_fns, num_samples,
+		     batch_size)));
+    batch_env->execute();
+
+    const RealVector& serial_stats
+      = serial_env->response_results().function_values();
+    const RealVector& batch_stats
+      = batch_env->response_results().function_values();
+    BOOST_REQUIRE_EQUAL(serial_stats.length(), batch_stats.length());
+    for (int i=0; i<serial_stats.length(); ++i)
+      BOOST_CHECK_CLOSE(serial_stats[i], batch_stats[i], 1.e-10);
+  }
+}
@@ -0,0 +1,86 @@
+/*  _______________________________________________________________________
+
+    Dakota: Explore and predict with confidence.
+    Copyright 2014-2023
+    National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Dakota directory.
+    _______________________________________________________________________ */
+
+#include "opt_tpl_test.hpp"
+
+#include <chrono>
+#include <iostream>
+
+#define BOOST_TEST_MODULE dakota_thread_pool_benchmark
+#include <boost/test/included/unit_test.hpp>
+
+using namespace Dakota;
+
+namespace {
+
+/// sampling study on the 20-D generalized Rosenbrock direct driver,
+/// optionally with threaded asynchronous local evaluations
+String sampling_input(int concurrency)
+{
+  String input =
+    "environment \n"
+    "method \n"
+    "  sampling \n"
+    "    samples 20000 \n"
+    "    seed 1234 \n"
+    "    output silent \n"
+    "variables \n"
+    "  uniform_uncertain 20 \n"
+    "    lower_bounds 20*-2.0 \n"
+    "    upper_bounds 20*2.0 \n"
+    "interface \n"
+    "  direct \n"
+    "    analysis_drivers = 'generalized_rosenbrock' \n";
+  if (concurrency > 1)
+    input += "  asynchronous evaluation_concurrency "
+      + std::to_string(concurrency) + " \n";
+  input +=
+    "responses \n"
+    "  response_functions = 1 \n"
+    "  no_gradients \n"
+    "  no_hessians \n";
+  return input;
+}
+
+}
+
+
+/** Threaded asynchronous direct evaluations reproduce the synchronous
+    study and their throughput is reported */
+BOOST_AUTO_TEST_CASE(test_thread_pool_direct_throughput)
+{
+  typedef std::chrono::steady_clock clock;
+  typedef std::chrono::duration<double> seconds;
+  const int num_samples = 20000;
+
+  std::shared_ptr<LibraryEnvironment>
+    serial_env(Opt_TPL_Test::create_env(sampling_input(1)));
+  clock::time_point t0 = clock::now();
+  serial_env->execute();
+  clock::time_point t1 = clock::now();
+
+  std::shared_ptr<LibraryEnvironment>
+    threaded_env(Opt_TPL_Test::create_env(sampling_input(4)));
+  clock::time_point t2 = clock::now();
+  threaded_env->execute();
+  clock::time_point t3 = clock::now();
+
+  const RealVector& serial_stats
+    = serial_env->response_results().function_values();
+  const RealVector& threaded_stats
+    = threaded_env->response_results().function_values();
+  BOOST_REQUIRE_EQUAL(serial_stats.length(), threaded_stats.length());
+  for (int i=0; i<serial_stats.length(); ++i)
+    BOOST_CHECK_EQUAL(serial_stats[i], threaded_stats[i]);
+
+  std::cout << "synchronous evals/s: "
+	    << num_samples / seconds(t1 - t0).count()
+	    << ", threaded (4) evals/s: "
+	    << num_samples / seconds(t3 - t2).count() << std::endl;
+}
@@ -0,0 +1,115 @@
+/*  _______________________________________________________________________
+
+    Dakota: Explore and predict with confidence.
+    Copyright 2014-2023
+    National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Dakota directory.
+    _______________________________________________________________________ */
+
+#include "WorkStealingThreadPool.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#define BOOST_TEST_MODULE dakota_thread_pool_test
+#include <boost/test/included/unit_test.hpp>
+
+using dakota::util::WorkStealingThreadPool;
+
+
+/** Every task runs exactly once, including tasks submitted by tasks */
+BOOST_AUTO_TEST_CASE(test_thread_pool_completion)
+{
+  const size_t num_tasks = 1000;
+  std::vector<std::atomic<int>> runs(2*num_tasks);
+  for (size_t i=0; i<runs.size(); ++i)
+    runs[i] = 0;
+
+  WorkStealingThreadPool pool(4);
+  BOOST_CHECK_EQUAL(pool.num_threads(), 4);
+  for (size_t i=0; i<num_tasks; ++i)
+    pool.submit([&, i]() {
+      ++runs[i];
+      // nested submission lands on the submitting worker's deque
+      pool.submit([&, i]() { ++runs[num_tasks + i]; });
+    });
+  pool.wait_idle();
+
+  BOOST_CHECK_EQUAL(pool.pending(), 0);
+  for (size_t i=0; i<runs.size(); ++i)
+    BOOST_CHECK_EQUAL(runs[i].load(), 1);
+}
+
+
+/** Uneven task costs are balanced by stealing */
+BOOST_AUTO_TEST_CASE(test_thread_pool_stealing)
+{
+  WorkStealingThreadPool pool(4);
+  std::atomic<int> done(0);
+  // round-robin places all long tasks on the first worker's deque
+  for (size_t i=0; i<16; ++i)
+    pool.submit([&, i]() {
+      if (i % 4 == 0)
+	std::this_thread::sleep_for(std::chrono::milliseconds(20));
+      ++done;
+    });
+  pool.wait_idle();
+  BOOST_CHECK_EQUAL(done.load(), 16);
+  BOOST_TEST_MESSAGE("stolen tasks: " << pool.steals());
+
+  // destruction completes queued work
+  std::atomic<int> drained(0);
+  {
+    WorkStealingThreadPool short_lived(2);
+    for (size_t i=0; i<100; ++i)
+      short_lived.submit([&]() { ++drained; });
+  }
+  BOOST_CHECK_EQUAL(drained.load(), 100);
+}
+
+
+/** Kernel loops are serial by default; an opt-in concurrency runs each
+    task once, rethrows failures, and keeps nested loops serial */
+BOOST_AUTO_TEST_CASE(test_thread_pool_parallel_for)
+{
+  BOOST_CHECK_EQUAL(WorkStealingThreadPool::kernel_concurrency(), 1);
+  std::thread::id caller = std::this_thread::get_id();
+  bool all_on_caller = true;
+  WorkStealingThreadPool::parallel_for(64, [&](size_t t) {
+    if (std::this_thread::get_id() != caller)
+      all_on_caller = false;
+  });
+  BOOST_CHECK(all_on_caller);
+
+  WorkStealingThreadPool::kernel_concurrency(4);
+  BOOST_CHECK_EQUAL(WorkStealingThreadPool::kernel_concurrency(), 4);
+  const size_t num_tasks = 1000;
+  std::vector<std::atomic<int>> runs(num_tasks);
+  for (size_t i=0; i<num_tasks; ++i)
+    runs[i] = 0;
+  std::atomic<bool> nested_serial(true);
+  WorkStealingThreadPool::parallel_for(num_tasks, [&](size_t t) {
+    ++runs[t];
+    // nested loops run on the thread executing the outer task
+    std::thread::id outer = std::this_thread::get_id();
+    WorkStealingThreadPool::parallel_for(4, [&](size_t) {
+      if (std::this_thread::get_id() != outer)
+	nested_serial = false;
+    });
+  });
+  for (size_t i=0; i<num_tasks; ++i)
+    BOOST_CHECK_EQUAL(runs[i].load(), 1);
+  BOOST_CHECK(nested_serial.load());
+
+  BOOST_CHECK_THROW(WorkStealingThreadPool::parallel_for(100, [](size_t t) {
+	if (t == 37) throw std::runtime_error("task failure");
+      }), std::runtime_error);
+
+  WorkStealingThreadPool::kernel_concurrency(0);
+  BOOST_CHECK_EQUAL(WorkStealingThreadPool::kernel_concurrency(), 1);
+}
+
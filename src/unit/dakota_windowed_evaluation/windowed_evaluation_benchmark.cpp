@@ -0,0 +1,161 @@
+/*  _______________________________________________________________________
+
+    Dakota: Explore and predict with confidence.
+    Copyright 2014-2023
+    National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Dakota directory.
+    _______________________________________________________________________ */
+
+#include "opt_tpl_test.hpp"
+
+#include <chrono>
+#include <iostream>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+#define BOOST_TEST_MODULE dakota_windowed_evaluation_benchmark
+#include <boost/test/included/unit_test.hpp>
+
+using namespace Dakota;
+
+namespace {
+
+/// asynchronous local evaluation concurrency
+const int CONCURRENCY = 4;
+/// evaluation window of the windowed runs
+const int WINDOW = 256;
+
+/// interface to the 20-D generalized Rosenbrock direct driver, optionally
+/// with threaded asynchronous local evaluations
+String interface_input(int concurrency)
+{
+  String input =
+    "interface \n"
+    "  direct \n"
+    "    analysis_drivers = 'generalized_rosenbrock' \n"
+    "  deactivate evaluation_cache restart_file \n";
+  if (concurrency > 1)
+    input += "  asynchronous evaluation_concurrency "
+      + std::to_string(concurrency) + " \n";
+  return input;
+}
+
+/// method controls bounding the asynchronous evaluations in flight
+String window_input(int window)
+{
+  return (window) ?
+    "  evaluation_window " + std::to_string(window) + " \n" : "";
+}
+
+/// streamed low-discrepancy sampling study, whose samples are generated
+/// on demand
+String sampling_input(int num_samples, int concurrency, int window)
+{
+  return
+    "environment \n"
+    "method \n"
+    "  sampling \n"
+    "    sample_type \n"
+    "      low_discrepancy \n"
+    "        rank_1_lattice \n"
+    "    samples " + std::to_string(num_samples) + " \n"
+    "    seed 1234 \n"
+    "    response_levels = 100. 1000. 10000. \n"
+    "    streaming_statistics \n"
+    "    output silent \n"
+    + window_input(window) +
+    "variables \n"
+    "  uniform_uncertain 20 \n"
+    "    lower_bounds 20*-2.0 \n"
+    "    upper_bounds 20*2.0 \n"
+    + interface_input(concurrency) +
+    "responses \n"
+    "  response_functions = 1 \n"
+    "  no_gradients \n"
+    "  no_hessians \n";
+}
+
+/// vector parameter study tracking the best objective, whose steps are
+/// generated on demand
+String vector_input(int num_steps, int concurrency, int window)
+{
+  return
+    "environment \n"
+    "method \n"
+    "  vector_parameter_study \n"
+    "    final_point 20*1.5 \n"
+    "    num_steps " + std::to_string(num_steps) + " \n"
+    "    output silent \n"
+    + window_input(window) +
+    "variables \n"
+    "  continuous_design 20 \n"
+    "    initial_point 20*-2.0 \n"
+    + interface_input(concurrency) +
+    "responses \n"
+    "  objective_functions = 1 \n"
+    "  no_gradients \n"
+    "  no_hessians \n";
+}
+
+/// peak resident set size of the process in MB (0 if unavailable)
+double peak_rss_mb()
+{
+#if defined(__unix__) || defined(__APPLE__)
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+  return usage.ru_maxrss / (1024. * 1024.); // bytes
+#else
+  return usage.ru_maxrss / 1024.;           // kilobytes
+#endif
+#else
+  return 0.;
+#endif
+}
+
+/// execute the study, reporting its throughput and the peak RSS so far
+void run_study(const String& input, const String& label, int num_evals)
+{
+  typedef std::chrono::steady_clock clock;
+  typedef std::chrono::duration<double> seconds;
+  std::shared_ptr<LibraryEnvironment> env(Opt_TPL_Test::create_env(input));
+  clock::time_point t0 = clock::now();
+  env->execute();
+  double elapsed = seconds(clock::now() - t0).count();
+  std::cout << label << ": " << num_evals << " evaluations in " << elapsed
+	    << " s, " << num_evals / elapsed << " evaluations/s, peak RSS "
+	    << peak_rss_mb() << " MB" << std::endl;
+}
+
+}
+
+
+/** The peak RSS of the process never decreases, so the studies run in
+    order of their expected footprint: windowed, synchronous (parameter
+    sets generated in blocks), then asynchronous with every parameter
+    set and response held at once */
+BOOST_AUTO_TEST_CASE(test_windowed_evaluation_sampling_throughput)
+{
+  const int num_samples = 200000;
+  run_study(sampling_input(num_samples, CONCURRENCY, WINDOW),
+	    "windowed sampling", num_samples);
+  run_study(sampling_input(num_samples, 1, 0),
+	    "synchronous sampling", num_samples);
+  run_study(sampling_input(num_samples, CONCURRENCY, 0),
+	    "unbounded asynchronous sampling", num_samples);
+}
+
+
+BOOST_AUTO_TEST_CASE(test_windowed_evaluation_vector_study_throughput)
+{
+  const int num_steps = 200000;
+  run_study(vector_input(num_steps, CONCURRENCY, WINDOW),
+	    "windowed vector study", num_steps + 1);
+  run_study(vector_input(num_steps, 1, 0),
+	    "synchronous vector study", num_steps + 1);
+  run_study(vector_input(num_steps, CONCURRENCY, 0),
+	    "unbounded asynchronous vector study", num_steps + 1);
+}
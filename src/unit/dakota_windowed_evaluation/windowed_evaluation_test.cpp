@@ -0,0 +1,150 @@
+/*  _______________________________________________________________________
+
+    Dakota: Explore and predict with confidence.
+    Copyright 2014-2023
+    National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Dakota directory.
+    _______________________________________________________________________ */
+
+#include "opt_tpl_test.hpp"
+
+#define BOOST_TEST_MODULE dakota_windowed_evaluation_test
+#include <boost/test/included/unit_test.hpp>
+
+using namespace Dakota;
+
+namespace {
+
+/// asynchronous local evaluation concurrency of the windowed runs
+const int CONCURRENCY = 4;
+/// evaluation window of the windowed runs
+const int WINDOW = 256;
+
+/// method controls bounding the asynchronous evaluations in flight
+String window_input(int concurrency)
+{
+  return (concurrency > 1) ?
+    "  evaluation_window " + std::to_string(WINDOW) + " \n" : "";
+}
+
+/// interface to the 20-D generalized Rosenbrock direct driver, optionally
+/// with threaded asynchronous local evaluations
+String interface_input(int concurrency)
+{
+  String input =
+    "interface \n"
+    "  direct \n"
+    "    analysis_drivers = 'generalized_rosenbrock' \n"
+    "  deactivate evaluation_cache restart_file \n";
+  if (concurrency > 1)
+    input += "  asynchronous evaluation_concurrency "
+      + std::to_string(concurrency) + " \n";
+  return input;
+}
+
+/// streamed low-discrepancy sampling study, whose samples are generated
+/// on demand
+String sampling_input(int num_samples, int concurrency)
+{
+  return
+    "environment \n"
+    "method \n"
+    "  sampling \n"
+    "    sample_type \n"
+    "      low_discrepancy \n"
+    "        rank_1_lattice \n"
+    "    samples " + std::to_string(num_samples) + " \n"
+    "    seed 1234 \n"
+    "    response_levels = 100. 1000. 10000. \n"
+    "    streaming_statistics \n"
+    "    output silent \n"
+    + window_input(concurrency) +
+    "variables \n"
+    "  uniform_uncertain 20 \n"
+    "    lower_bounds 20*-2.0 \n"
+    "    upper_bounds 20*2.0 \n"
+    + interface_input(concurrency) +
+    "responses \n"
+    "  response_functions = 1 \n"
+    "  no_gradients \n"
+    "  no_hessians \n";
+}
+
+/// vector parameter study tracking the best objective, whose steps are
+/// generated on demand
+String vector_input(int num_steps, int concurrency)
+{
+  return
+    "environment \n"
+    "method \n"
+    "  vector_parameter_study \n"
+    "    final_point 20*1.5 \n"
+    "    num_steps " + std::to_string(num_steps) + " \n"
+    "    output silent \n"
+    + window_input(concurrency) +
+    "variables \n"
+    "  continuous_design 20 \n"
+    "    initial_point 20*-2.0 \n"
+    + interface_input(concurrency) +
+    "responses \n"
+    "  objective_functions = 1 \n"
+    "  no_gradients \n"
+    "  no_hessians \n";
+}
+
+/// execute the study
+std::shared_ptr<LibraryEnvironment> run_study(const String& input)
+{
+  std::shared_ptr<LibraryEnvironment> env(Opt_TPL_Test::create_env(input));
+  env->execute();
+  return env;
+}
+
+}
+
+
+/** Streamed statistics from a bounded window of asynchronous
+    evaluations, processed in submission order, match the synchronous
+    study exactly */
+BOOST_AUTO_TEST_CASE(test_windowed_evaluation_sampling)
+{
+  const int num_samples = 5000;
+  std::shared_ptr<LibraryEnvironment>
+    serial_env = run_study(sampling_input(num_samples, 1)),
+    windowed_env = run_study(sampling_input(num_samples, CONCURRENCY));
+
+  const RealVector& serial_stats
+    = serial_env->response_results().function_values();
+  const RealVector& windowed_stats
+    = windowed_env->response_results().function_values();
+  BOOST_REQUIRE_EQUAL(serial_stats.length(), windowed_stats.length());
+  for (int i=0; i<serial_stats.length(); ++i)
+    BOOST_CHECK_EQUAL(serial_stats[i], windowed_stats[i]);
+}
+
+
+/** The best point of a windowed vector study matches the synchronous
+    study, including across the blocks of generated steps */
+BOOST_AUTO_TEST_CASE(test_windowed_evaluation_vector_study)
+{
+  const int num_steps = 3000;
+  std::shared_ptr<LibraryEnvironment>
+    serial_env = run_study(vector_input(num_steps, 1)),
+    windowed_env = run_study(vector_input(num_steps, CONCURRENCY));
+
+  const RealVector& serial_x
+    = serial_env->variables_results().continuous_variables();
+  const RealVector& windowed_x
+    = windowed_env->variables_results().continuous_variables();
+  BOOST_REQUIRE_EQUAL(serial_x.length(), windowed_x.length());
+  for (int i=0; i<serial_x.length(); ++i)
+    BOOST_CHECK_EQUAL(serial_x[i], windowed_x[i]);
+  BOOST_CHECK_EQUAL(serial_env->response_results().function_value(0),
+		    windowed_env->response_results().function_value(0));
+
+  // the best point lies on the vector from -2 to 1.5 nearest the
+  // minimum of Rosenbrock at 1
+  for (int i=0; i<serial_x.length(); ++i)
+    BOOST_CHECK_SMALL(serial_x[i] - 1., 1.e-3);
+}
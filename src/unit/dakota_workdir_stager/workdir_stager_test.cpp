@@ -0,0 +1,201 @@
+/*  _______________________________________________________________________
+
+    Dakota: Explore and predict with confidence.
+    Copyright 2014-2023
+    National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Dakota directory.
+    _______________________________________________________________________ */
+
+#include "WorkdirStager.hpp"
+
+#include <boost/filesystem/fstream.hpp>
+#include <sstream>
+
+#define BOOST_TEST_MODULE dakota_workdir_stager_test
+#include <boost/test/included/unit_test.hpp>
+
+using namespace Dakota;
+
+namespace {
+
+/// contents of a file
+String file_contents(const bfs::path& file_path)
+{
+  bfs::ifstream file(file_path);
+  std::ostringstream contents;
+  contents << file.rdbuf();
+  return contents.str();
+}
+
+/// write contents to a new or truncated file
+void write_file(const bfs::path& file_path, const String& contents)
+{
+  bfs::ofstream file(file_path);
+  file << contents;
+}
+
+/// temporary directory holding a template tree, the working directory
+/// while in scope:
+///   mesh.dat, inputs/solver.in, inputs/tables/table.dat, library/lib.txt
+struct TemplateTree
+{
+  TemplateTree():
+    startDir(bfs::current_path()),
+    path(bfs::temp_directory_path() /
+	 bfs::unique_path("dakota_stager_%%%%%%%%"))
+  {
+    bfs::create_directories(path / "templ" / "inputs" / "tables");
+    bfs::create_directory(path / "templ" / "library");
+    bfs::current_path(path);
+    write_file("templ/mesh.dat", "mesh data\n");
+    write_file("templ/inputs/solver.in", "tolerance = 1.e-6\n");
+    write_file("templ/inputs/tables/table.dat", "1 2 3\n");
+    write_file("templ/library/lib.txt", "shared\n");
+    copyFiles.push_back("templ/mesh.dat");
+    copyFiles.push_back("templ/inputs");
+    linkFiles.push_back("templ/library");
+  }
+
+  ~TemplateTree()
+  {
+    bfs::current_path(startDir);
+    bfs::remove_all(path);
+  }
+
+  /// staging areas created next to the work directories
+  size_t num_staging_areas() const
+  {
+    size_t num_areas = 0;
+    bfs::directory_iterator dir_it(path), dir_end;
+    for ( ; dir_it != dir_end; ++dir_it)
+      if (dir_it->path().filename().string().find("dakota_staging_") == 0)
+	++num_areas;
+    return num_areas;
+  }
+
+  bfs::path startDir, path;
+  StringArray copyFiles, linkFiles;
+};
+
+/// verify that work_dir holds the template contents
+void check_template_contents(const bfs::path& work_dir)
+{
+  BOOST_CHECK_EQUAL(file_contents(work_dir / "mesh.dat"), "mesh data\n");
+  BOOST_CHECK_EQUAL(file_contents(work_dir / "inputs" / "solver.in"),
+		    "tolerance = 1.e-6\n");
+  BOOST_CHECK_EQUAL(file_contents(work_dir / "inputs" / "tables" /
+				  "table.dat"), "1 2 3\n");
+  BOOST_CHECK(bfs::is_symlink(work_dir / "library"));
+  BOOST_CHECK_EQUAL(file_contents(work_dir / "library" / "lib.txt"),
+		    "shared\n");
+}
+
+}
+
+
+/** Staged copies are independent of the template and of each other */
+BOOST_AUTO_TEST_CASE(test_workdir_stager_copies)
+{
+  TemplateTree tree;
+  WorkdirStager stager(tree.linkFiles, tree.copyFiles, false, 0);
+
+  BOOST_CHECK(stager.stage("workdir.1", false));
+  BOOST_CHECK(stager.stage("workdir.2", false));
+  BOOST_CHECK_EQUAL(tree.num_staging_areas(), 1);
+  check_template_contents("workdir.1");
+  check_template_contents("workdir.2");
+  BOOST_CHECK(!bfs::equivalent("workdir.1/mesh.dat", "templ/mesh.dat"));
+  BOOST_CHECK(bfs::last_write_time("workdir.1/mesh.dat") ==
+	      bfs::last_write_time("templ/mesh.dat"));
+
+  write_file("workdir.1/mesh.dat", "modified\n");
+  BOOST_CHECK_EQUAL(file_contents("templ/mesh.dat"), "mesh data\n");
+  BOOST_CHECK_EQUAL(file_contents("workdir.2/mesh.dat"), "mesh data\n");
+
+  // an existing directory receives the missing entries, and the changed
+  // ones too with replace
+  bfs::remove("workdir.1/inputs/solver.in");
+  BOOST_CHECK(!stager.stage("workdir.1", false));
+  BOOST_CHECK_EQUAL(file_contents("workdir.1/mesh.dat"), "modified\n");
+  BOOST_CHECK(bfs::exists("workdir.1/inputs/solver.in"));
+  BOOST_CHECK(!stager.stage("workdir.1", true));
+  check_template_contents("workdir.1");
+
+  // without a pool, recycled directories are removed
+  stager.recycle("workdir.1");
+  BOOST_CHECK(!bfs::exists("workdir.1"));
+
+  stager.remove_staging_area();
+  BOOST_CHECK_EQUAL(tree.num_staging_areas(), 0);
+  check_template_contents("workdir.2");
+}
+
+
+/** Directories taken from the pool are refreshed: added entries are
+    removed and changed ones staged again */
+BOOST_AUTO_TEST_CASE(test_workdir_stager_pool)
+{
+  TemplateTree tree;
+  WorkdirStager stager(tree.linkFiles, tree.copyFiles, false, 1);
+
+  BOOST_CHECK(stager.stage("workdir.1", false));
+  BOOST_CHECK(!stager.last_stage_reused());
+  write_file("workdir.1/params.in", "x 1\n");
+  write_file("workdir.1/inputs/solver.in", "tolerance = 1.e-3\n");
+  bfs::create_directory("workdir.1/output");
+  bfs::remove("workdir.1/library");
+  stager.recycle("workdir.1");
+  BOOST_CHECK(!bfs::exists("workdir.1"));
+
+  BOOST_CHECK(stager.stage("workdir.2", false));
+  BOOST_CHECK(stager.last_stage_reused());
+  check_template_contents("workdir.2");
+  BOOST_CHECK(!bfs::exists("workdir.2/params.in"));
+  BOOST_CHECK(!bfs::exists("workdir.2/output"));
+
+  // the pool is empty again
+  BOOST_CHECK(stager.stage("workdir.3", false));
+  BOOST_CHECK(!stager.last_stage_reused());
+
+  // the pool holds a single directory
+  stager.recycle("workdir.2");
+  stager.recycle("workdir.3");
+  BOOST_CHECK(!bfs::exists("workdir.2") && !bfs::exists("workdir.3"));
+
+  std::ostringstream summary;
+  stager.print_summary(summary);
+  BOOST_CHECK(summary.str().find("3 directories staged (1 from pool)") !=
+	      std::string::npos);
+}
+
+
+/** With hardlinks, staged files share the read-only snapshot files,
+    which are kept when unchanged */
+BOOST_AUTO_TEST_CASE(test_workdir_stager_hardlinks)
+{
+  TemplateTree tree;
+  WorkdirStager stager(tree.linkFiles, tree.copyFiles, true, 2);
+
+  stager.stage("workdir.1", false);
+  stager.stage("workdir.2", false);
+  check_template_contents("workdir.1");
+  BOOST_CHECK(bfs::equivalent("workdir.1/mesh.dat", "workdir.2/mesh.dat"));
+  BOOST_CHECK(!bfs::equivalent("workdir.1/mesh.dat", "templ/mesh.dat"));
+  BOOST_CHECK(!(bfs::status("workdir.1/mesh.dat").permissions() &
+		bfs::owner_write));
+
+  // a driver replacing a staged file does not alter the snapshot
+  bfs::remove("workdir.1/mesh.dat");
+  write_file("workdir.1/mesh.dat", "modified\n");
+  stager.recycle("workdir.1");
+  stager.stage("workdir.3", false);
+  BOOST_CHECK(stager.last_stage_reused());
+  check_template_contents("workdir.3");
+  BOOST_CHECK(bfs::equivalent("workdir.2/mesh.dat", "workdir.3/mesh.dat"));
+
+  stager.recycle("workdir.2");
+  stager.recycle("workdir.3");
+  stager.remove_staging_area();
+  BOOST_CHECK_EQUAL(tree.num_staging_areas(), 0);
+}
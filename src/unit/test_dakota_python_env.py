@@ -16,7 +16,8 @@ import sys
 # when this import is commented out
 
 
-# Optionally append a path to the python library, passed as argv[1]
+# Optionally append a path to the python library, passed as argv[1];
+# --benchmark following it runs only the batch convention benchmark
 if len(sys.argv) > 1:
     dakpy_lib_path = sys.argv[1]
     sys.path.append(dakpy_lib_path)
@@ -182,12 +183,90 @@ def test_lib():
             assert(abs((hvars[1] - target)/target) < max_tol)
             assert(abs((hvars[2] - target)/target) < max_tol)
 
+# Batch Rosenbrock drivers for the two batch calling conventions; each
+# records the function values it returns, in evaluation order
+def rosenbrock_value(x1, x2):
+    return 100.*(x2 - x1*x1)**2 + (1. - x1)**2
+
+list_batch_values = []
+def rosenbrock_list_batch(list_of_params):
+    retvals = []
+    for params in list_of_params:
+        x = params['cv']
+        f = rosenbrock_value(x[0], x[1])
+        list_batch_values.append(f)
+        retvals.append({'fns': [f]})
+    return retvals
+
+columnar_batch_values = []
+def rosenbrock_columnar_batch(batch):
+    x = batch['cv']
+    f = 100.*(x[:,1] - x[:,0]**2)**2 + (1. - x[:,0])**2
+    columnar_batch_values.extend(f.tolist())
+    return {'fns': f.reshape(-1, 1)}
+
+def test_columnar_batch(num_samples=200, report_rates=False):
+    """Compare the list-of-dicts and columnar (NumPy) batch conventions:
+    both must return identical values; with report_rates,
+    evaluations/second are also printed"""
+    if not hasattr(dakenv, "get_variable_values_np"):
+        print("Dakota built without NumPy. Skipping columnar batch test.\n")
+        return
+    import time
+
+    batch_input = """
+        method,
+          output silent
+          sampling
+            sample_type lhs
+            samples = %d
+            seed = 5347
+        variables,
+          uniform_uncertain = 2
+            lower_bounds  -2.0 -2.0
+            upper_bounds   2.0  2.0
+            descriptors   'x1' 'x2'
+        interface,
+          python
+            analysis_driver = 'rosenbrock'
+            %s
+          batch
+          deactivate evaluation_cache restart_file
+        responses,
+          response_functions = 1
+          no_gradients
+          no_hessians
+"""
+    del list_batch_values[:]
+    del columnar_batch_values[:]
+    rates = {}
+    for option, callback in [("", rosenbrock_list_batch),
+                             ("columnar", rosenbrock_columnar_batch)]:
+        daklib = dakenv.study(callback=callback,
+                              input_string=batch_input % (num_samples, option))
+        start = time.time()
+        daklib.execute()
+        rates[option or "list"] = num_samples / (time.time() - start)
+
+    assert(len(columnar_batch_values) == num_samples)
+    assert(list_batch_values == columnar_batch_values)
+    if report_rates:
+        for convention, rate in rates.items():
+            print("\t%s batch: %.0f evaluations/s" % (convention, rate))
+    print("\n+++ Done columnar batch.\n")
+
 if __name__ == "__main__":
 
     print("\n+++ Dakota version:\n")
     dakenv.version()
 
+    # the rate comparison of the batch conventions is a benchmark
+    if "--benchmark" in sys.argv[2:]:
+        test_columnar_batch(num_samples=10000, report_rates=True)
+        sys.exit(0)
+
     # TODO: these encapsulate the objects so timing info is printed
     # with each test case; better manage destructors.
     test_cmd()
     test_lib()
+    test_columnar_batch()
@@ -0,0 +1,227 @@
+/*  _______________________________________________________________________
+
+    Dakota: Explore and predict with confidence.
+    Copyright 2014-2023
+    National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Dakota directory.
+    _______________________________________________________________________ */
+
+#include "WorkStealingThreadPool.hpp"
+
+#include <algorithm>
+#include <exception>
+
+
+namespace dakota {
+namespace util {
+
+namespace {
+
+/// pool owning the calling thread, if the caller is a worker
+thread_local const WorkStealingThreadPool* currentPool = NULL;
+/// worker index of the calling thread within currentPool
+thread_local size_t currentWorker = 0;
+/// whether the calling thread is executing tasks of a parallel_for()
+thread_local bool inParallelFor = false;
+
+/// protects kernelThreads and kernelPool
+std::mutex kernelMutex;
+/// threads applied by parallel_for(), including the calling thread
+size_t kernelThreads = 1;
+/// pool shared by parallel_for(), with kernelThreads - 1 workers;
+/// started on first use
+std::shared_ptr<WorkStealingThreadPool> kernelPool;
+
+/// the shared kernel pool, or an empty pointer when kernels are serial
+std::shared_ptr<WorkStealingThreadPool> kernel_pool()
+{
+  std::lock_guard<std::mutex> lock(kernelMutex);
+  if (kernelThreads > 1 && !kernelPool)
+    kernelPool = std::make_shared<WorkStealingThreadPool>(kernelThreads - 1);
+  return kernelPool;
+}
+
+} // anonymous namespace
+
+
+WorkStealingThreadPool::WorkStealingThreadPool(size_t num_threads):
+  queuedTasks(0), pendingTasks(0), stolenTasks(0), nextQueue(0),
+  shutdownFlag(false)
+{
+  num_threads = std::max<size_t>(1, num_threads);
+
+  workerQueues.reserve(num_threads);
+  for (size_t w=0; w<num_threads; ++w)
+    workerQueues.push_back(std::unique_ptr<WorkerQueue>(new WorkerQueue()));
+  // start workers only once all deques exist, since any may be stolen from
+  workers.reserve(num_threads);
+  for (size_t w=0; w<num_threads; ++w)
+    workers.push_back(std::thread(&WorkStealingThreadPool::worker_loop,
+				  this, w));
+}
+
+
+WorkStealingThreadPool::~WorkStealingThreadPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(stateMutex);
+    shutdownFlag = true;
+  }
+  workCond.notify_all();
+  for (size_t w=0; w<workers.size(); ++w)
+    workers[w].join();
+}
+
+
+void WorkStealingThreadPool::submit(Task task)
+{
+  // keep nested submissions local to the submitting worker
+  size_t q = (currentPool == this) ? currentWorker :
+    nextQueue.fetch_add(1) % workerQueues.size();
+  ++pendingTasks;
+  {
+    // count before queuing so that queuedTasks never undercounts the deques,
+    // and under stateMutex so that a worker evaluating its wait predicate
+    // cannot miss the notification
+    std::lock_guard<std::mutex> lock(stateMutex);
+    ++queuedTasks;
+  }
+  {
+    std::lock_guard<std::mutex> lock(workerQueues[q]->queueMutex);
+    workerQueues[q]->tasks.push_back(std::move(task));
+  }
+  workCond.notify_one();
+}
+
+
+void WorkStealingThreadPool::wait_idle()
+{
+  std::unique_lock<std::mutex> lock(stateMutex);
+  idleCond.wait(lock, [this]() { return pendingTasks.load() == 0; });
+}
+
+
+void WorkStealingThreadPool::worker_loop(size_t w)
+{
+  currentPool = this;  currentWorker = w;
+  Task task;
+  for (;;) {
+    if (pop_local(w, task) || steal(w, task)) {
+      --queuedTasks;
+      task();
+      task = nullptr; // release captured state before signaling completion
+      if (--pendingTasks == 0) {
+	std::lock_guard<std::mutex> lock(stateMutex);
+	idleCond.notify_all();
+      }
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lock(stateMutex);
+    workCond.wait(lock, [this]()
+		  { return queuedTasks.load() > 0 || shutdownFlag; });
+    // drain queued work before exiting
+    if (shutdownFlag && queuedTasks.load() == 0)
+      return;
+  }
+}
+
+
+bool WorkStealingThreadPool::pop_local(size_t w, Task& task)
+{
+  WorkerQueue& queue = *workerQueues[w];
+  std::lock_guard<std::mutex> lock(queue.queueMutex);
+  if (queue.tasks.empty())
+    return false;
+  task = std::move(queue.tasks.back());
+  queue.tasks.pop_back();
+  return true;
+}
+
+
+bool WorkStealingThreadPool::steal(size_t w, Task& task)
+{
+  size_t num_queues = workerQueues.size();
+  for (size_t i=1; i<num_queues; ++i) {
+    WorkerQueue& victim = *workerQueues[(w + i) % num_queues];
+    std::lock_guard<std::mutex> lock(victim.queueMutex);
+    if (!victim.tasks.empty()) {
+      task = std::move(victim.tasks.front());
+      victim.tasks.pop_front();
+      ++stolenTasks;
+      return true;
+    }
+  }
+  return false;
+}
+
+size_t WorkStealingThreadPool::kernel_concurrency()
+{
+  std::lock_guard<std::mutex> lock(kernelMutex);
+  return kernelThreads;
+}
+
+
+void WorkStealingThreadPool::kernel_concurrency(size_t num_threads)
+{
+  num_threads = std::max<size_t>(1, num_threads);
+  std::lock_guard<std::mutex> lock(kernelMutex);
+  if (num_threads != kernelThreads) {
+    kernelThreads = num_threads;
+    // calls in progress retain the previous pool until they complete
+    kernelPool.reset();
+  }
+}
+
+
+void WorkStealingThreadPool::
+parallel_for(size_t num_tasks, const std::function<void(size_t)>& body)
+{
+  std::shared_ptr<WorkStealingThreadPool> pool;
+  if (num_tasks > 1 && currentPool == NULL && !inParallelFor)
+    pool = kernel_pool();
+  if (!pool) {
+    for (size_t t=0; t<num_tasks; ++t)
+      body(t);
+    return;
+  }
+
+  // helpers may start only after the caller has drained the tasks, and the
+  // pool may be shared with other callers, so completion is tracked per call
+  // rather than by wait_idle()
+  std::atomic<size_t> next_task(0);
+  std::mutex call_mutex;
+  std::condition_variable done_cond;
+  std::exception_ptr error;
+  size_t active = std::min(pool->num_threads(), num_tasks - 1);
+  auto run_tasks = [&]() {
+    for (size_t t=next_task++; t<num_tasks; t=next_task++) {
+      try { body(t); }
+      catch (...) {
+	std::lock_guard<std::mutex> lock(call_mutex);
+	if (!error)
+	  error = std::current_exception();
+	next_task = num_tasks; // skip the tasks not yet started
+      }
+    }
+  };
+  for (size_t h=0, num_helpers=active; h<num_helpers; ++h)
+    pool->submit([&]() {
+      run_tasks();
+      std::lock_guard<std::mutex> lock(call_mutex);
+      if (--active == 0)
+	done_cond.notify_one();
+    });
+  inParallelFor = true;
+  run_tasks(); // exceptions thrown by body are captured within
+  inParallelFor = false;
+
+  std::unique_lock<std::mutex> lock(call_mutex);
+  done_cond.wait(lock, [&]() { return active == 0; });
+  if (error)
+    std::rethrow_exception(error);
+}
+
+}  // namespace util
+}  // namespace dakota
@@ -0,0 +1,155 @@
+/*  _______________________________________________________________________
+
+    Dakota: Explore and predict with confidence.
+    Copyright 2014-2023
+    National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Dakota directory.
+    _______________________________________________________________________ */
+
+#ifndef WORK_STEALING_THREAD_POOL_H
+#define WORK_STEALING_THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace dakota {
+namespace util {
+
+/// Fixed-size pool of worker threads with per-worker task deques
+
+/** Each worker owns a deque of tasks.  Tasks submitted from outside
+    the pool are distributed round-robin over the deques; tasks
+    submitted by a running task are pushed onto the deque of its own
+    worker.  A worker pops its own deque from the back (most recent
+    first, for locality) and, when it is empty, steals from the front
+    of the other deques (oldest first), such that uneven task costs
+    are balanced without a single contended queue.  Idle workers
+    sleep until new work is submitted.
+
+    Tasks must not throw: callers needing to propagate failures
+    capture them within the task (e.g., as a std::exception_ptr).
+
+    Dakota's threaded numerical kernels share a single pool through
+    parallel_for(), sized by kernel_concurrency().  The kernel
+    concurrency defaults to one, in which case the kernels run serially
+    on the calling thread and no worker threads are started. */
+class WorkStealingThreadPool
+{
+public:
+
+  /// unit of work executed by the pool
+  typedef std::function<void()> Task;
+
+  //
+  //- Heading: Constructors and destructor
+  //
+
+  /// constructor; starts max(num_threads, 1) workers
+  WorkStealingThreadPool(size_t num_threads);
+  /// destructor; completes queued tasks and joins the workers
+  ~WorkStealingThreadPool();
+
+  //
+  //- Heading: Member functions
+  //
+
+  /// number of worker threads
+  size_t num_threads() const;
+
+  /// queue a task for execution
+  void submit(Task task);
+
+  /// block until all submitted tasks have completed
+  void wait_idle();
+
+  /// number of tasks submitted but not yet completed
+  size_t pending() const;
+  /// number of tasks executed by a worker other than the one queuing them
+  size_t steals() const;
+
+  /// number of threads (including the caller) applied by parallel_for()
+  static size_t kernel_concurrency();
+  /// set the number of threads applied by parallel_for(); values < 1 are
+  /// treated as 1 (serial)
+  static void kernel_concurrency(size_t num_threads);
+
+  /// apply body(t) for t in [0, num_tasks), returning once all calls
+  /// have completed; the calling thread and the workers of the shared
+  /// kernel pool draw tasks in order.  Runs serially when the kernel
+  /// concurrency is one or when called from within a pool worker (no
+  /// nested parallelism).  The first exception thrown by body is
+  /// rethrown once all started tasks have completed.
+  static void parallel_for(size_t num_tasks,
+			   const std::function<void(size_t)>& body);
+
+private:
+
+  //
+  //- Heading: Convenience functions
+  //
+
+  /// task loop of worker w
+  void worker_loop(size_t w);
+  /// pop the most recent task of worker w's deque
+  bool pop_local(size_t w, Task& task);
+  /// steal the oldest task from another worker's deque
+  bool steal(size_t w, Task& task);
+
+  //
+  //- Heading: Data
+  //
+
+  /// task deque owned by a single worker (but accessible to thieves)
+  struct WorkerQueue
+  {
+    std::mutex queueMutex;
+    std::deque<Task> tasks;
+  };
+
+  /// one deque per worker
+  std::vector<std::unique_ptr<WorkerQueue>> workerQueues;
+  /// worker threads
+  std::vector<std::thread> workers;
+
+  /// protects sleeping/waking of workers and of wait_idle()
+  std::mutex stateMutex;
+  /// signaled when tasks are queued or the pool shuts down
+  std::condition_variable workCond;
+  /// signaled when the last pending task completes
+  std::condition_variable idleCond;
+
+  /// tasks queued in (or about to enter) the deques
+  std::atomic<size_t> queuedTasks;
+  /// tasks queued or running
+  std::atomic<size_t> pendingTasks;
+  /// count of stolen tasks
+  std::atomic<size_t> stolenTasks;
+  /// round-robin counter for external submissions
+  std::atomic<size_t> nextQueue;
+  /// set by the destructor to release the workers
+  bool shutdownFlag;
+};
+
+
+inline size_t WorkStealingThreadPool::num_threads() const
+{ return workers.size(); }
+
+
+inline size_t WorkStealingThreadPool::pending() const
+{ return pendingTasks.load(); }
+
+
+inline size_t WorkStealingThreadPool::steals() const
+{ return stolenTasks.load(); }
+
+}  // namespace util
+}  // namespace dakota
+
+#endif // WORK_STEALING_THREAD_POOL_H